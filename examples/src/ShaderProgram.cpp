@@ -3,6 +3,19 @@
 #include "utils.h"
 #include <string>
 #include <iostream>
+#include <algorithm>
+
+namespace
+{
+    using Utility::fnv1a;
+
+    // Compile time ids in the order they were first used
+    std::vector<uint32_t>& uniform_slots()
+    {
+        static std::vector<uint32_t> slots;
+        return slots;
+    }
+}
 
 ShaderProgram::ShaderProgram(const char* vertexShaderFile, const char* fragmentShaderFile)
 {
@@ -20,6 +33,12 @@ ShaderProgram::ShaderProgram(const char* vertexShaderSource, ShaderSourceType ve
     GenerateProgram(vertexShader, fragmentShader);
 }
 
+ShaderProgram::ShaderProgram(const char* computeShaderFile)
+{
+    auto computeShader = GenerateShader(computeShaderFile, ShaderType::Compute);
+    GenerateProgram(computeShader);
+}
+
 GLuint ShaderProgram::GenerateShader(const char* shaderSource, ShaderType type, 
     ShaderSourceType sourceType)
 {
@@ -44,6 +63,9 @@ GLuint ShaderProgram::GenerateShader(const char* shaderSource, ShaderType type,
     case ShaderType::Fragment:
         sh = glCreateShader(GL_FRAGMENT_SHADER);
         break;
+    case ShaderType::Compute:
+        sh = glCreateShader(GL_COMPUTE_SHADER);
+        break;
     default:
         break;
     }
@@ -88,6 +110,30 @@ void ShaderProgram::GenerateProgram(GLuint vertexShader, GLuint fragmentShader)
     glDeleteShader(fragmentShader);
 
     program_ =  shader_programme;
+    ReflectUniforms();
+}
+
+void ShaderProgram::GenerateProgram(GLuint computeShader)
+{
+    GLuint shader_programme = glCreateProgram();
+    glAttachShader(shader_programme, computeShader);
+
+    glLinkProgram(shader_programme);
+
+    int success = -1;
+    glGetProgramiv(shader_programme, GL_LINK_STATUS, &success);
+    if (GL_TRUE != success)
+    {
+        char infoLog[512];
+        glGetProgramInfoLog(shader_programme, 512, NULL, infoLog);
+        std::cerr << "ERROR: Shader programme linking failed: " << infoLog << std::endl;
+        return;
+    }
+
+    glDeleteShader(computeShader);
+
+    program_ =  shader_programme;
+    ReflectUniforms();
 }
 
 ShaderProgram::~ShaderProgram()
@@ -95,64 +141,132 @@ ShaderProgram::~ShaderProgram()
     glDeleteProgram(program_);
 }
 
-void ShaderProgram::setBool(std::string name, bool value) const
+int ShaderProgram::Location(std::string_view name) const
 {
-    glUniform1i(glGetUniformLocation(program_, name.c_str()), (int)value);
+    return Location(UniformId(name));
 }
 
-void ShaderProgram::setInt(std::string name, int value) const
+int ShaderProgram::Location(UniformId id) const
 {
-    glUniform1i(glGetUniformLocation(program_, name.c_str()), value);
+    auto it = std::lower_bound(uniforms_.begin(), uniforms_.end(), id.hash,
+        [](const Uniform& uniform, uint32_t hash) { return uniform.hash < hash; });
+    return it != uniforms_.end() && it->hash == id.hash ? it->location : -1;
 }
 
-void ShaderProgram::setFloat(std::string name, float value) const
+int ShaderProgram::AttributeLocation(UniformId id) const
 {
-    glUniform1f(glGetUniformLocation(program_, name.c_str()), value);
+    for (const Uniform& attribute : attributes_)
+    {
+        if (attribute.hash == id.hash)
+            return attribute.location;
+    }
+    return -1;
+}
+
+void ShaderProgram::setBool(std::string_view name, bool value) const
+{
+    setBool(UniformId(name), value);
+}
+
+void ShaderProgram::setInt(std::string_view name, int value) const
+{
+    setInt(UniformId(name), value);
+}
+
+void ShaderProgram::setFloat(std::string_view name, float value) const
+{
+    setFloat(UniformId(name), value);
 }
 
 // ------------------------------------------------------------------------
 
-void ShaderProgram::setVec2(const std::string& name, const glm::vec2& value) const
+void ShaderProgram::setVec2(std::string_view name, const glm::vec2& value) const
 {
-    glUniform2fv(glGetUniformLocation(program_, name.c_str()), 1, &value[0]);
+    setVec2(UniformId(name), value);
 }
-void ShaderProgram::setVec2(const std::string& name, float x, float y) const
+void ShaderProgram::setVec2(std::string_view name, float x, float y) const
 {
-    glUniform2f(glGetUniformLocation(program_, name.c_str()), x, y);
+    glUniform2f(Location(name), x, y);
 }
 // ------------------------------------------------------------------------
-void ShaderProgram::setVec3(const std::string& name, const glm::vec3& value) const
+void ShaderProgram::setVec3(std::string_view name, const glm::vec3& value) const
 {
-    glUniform3fv(glGetUniformLocation(program_, name.c_str()), 1, &value[0]);
+    setVec3(UniformId(name), value);
 }
-void ShaderProgram::setVec3(const std::string& name, float x, float y, float z) const
+void ShaderProgram::setVec3(std::string_view name, float x, float y, float z) const
 {
-    glUniform3f(glGetUniformLocation(program_, name.c_str()), x, y, z);
+    glUniform3f(Location(name), x, y, z);
 }
 // ------------------------------------------------------------------------
-void ShaderProgram::setVec4(const std::string& name, const glm::vec4& value) const
+void ShaderProgram::setVec4(std::string_view name, const glm::vec4& value) const
 {
-    glUniform4fv(glGetUniformLocation(program_, name.c_str()), 1, &value[0]);
+    setVec4(UniformId(name), value);
 }
-void ShaderProgram::setVec4(const std::string& name, float x, float y, float z, float w) const
+void ShaderProgram::setVec4(std::string_view name, float x, float y, float z, float w) const
 {
-    glUniform4f(glGetUniformLocation(program_, name.c_str()), x, y, z, w);
+    glUniform4f(Location(name), x, y, z, w);
 }
 
 // ------------------------------------------------------------------------
-void ShaderProgram::setMat2(const std::string& name, const glm::mat2& mat) const
+void ShaderProgram::setMat2(std::string_view name, const glm::mat2& mat) const
+{
+    setMat2(UniformId(name), mat);
+}
+
+void ShaderProgram::setMat3(std::string_view name, const glm::mat3& mat) const
+{
+    setMat3(UniformId(name), mat);
+}
+
+void ShaderProgram::setMat4(std::string_view name, const glm::mat4& mat) const
+{
+    setMat4(UniformId(name), mat);
+}
+
+// ------------------------------------------------------------------------
+void ShaderProgram::setBool(UniformId id, bool value) const
+{
+    glUniform1i(Location(id), (int)value);
+}
+
+void ShaderProgram::setInt(UniformId id, int value) const
+{
+    glUniform1i(Location(id), value);
+}
+
+void ShaderProgram::setFloat(UniformId id, float value) const
+{
+    glUniform1f(Location(id), value);
+}
+
+void ShaderProgram::setVec2(UniformId id, const glm::vec2& value) const
+{
+    glUniform2fv(Location(id), 1, &value[0]);
+}
+
+void ShaderProgram::setVec3(UniformId id, const glm::vec3& value) const
 {
-    glUniformMatrix2fv(glGetUniformLocation(program_, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+    glUniform3fv(Location(id), 1, &value[0]);
 }
 
-void ShaderProgram::setMat3(const std::string& name, const glm::mat3& mat) const
+void ShaderProgram::setVec4(UniformId id, const glm::vec4& value) const
 {
-    glUniformMatrix3fv(glGetUniformLocation(program_, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+    glUniform4fv(Location(id), 1, &value[0]);
 }
 
-void ShaderProgram::setMat4(const std::string& name, const glm::mat4& mat) const
+void ShaderProgram::setMat2(UniformId id, const glm::mat2& mat) const
 {
-    glUniformMatrix4fv(glGetUniformLocation(program_, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+    glUniformMatrix2fv(Location(id), 1, GL_FALSE, &mat[0][0]);
+}
+
+void ShaderProgram::setMat3(UniformId id, const glm::mat3& mat) const
+{
+    glUniformMatrix3fv(Location(id), 1, GL_FALSE, &mat[0][0]);
+}
+
+void ShaderProgram::setMat4(UniformId id, const glm::mat4& mat) const
+{
+    glUniformMatrix4fv(Location(id), 1, GL_FALSE, &mat[0][0]);
 }
 
 void ShaderProgram::use()
@@ -163,4 +277,137 @@ void ShaderProgram::use()
 GLuint ShaderProgram::Id() const
 {
     return program_;
-}
\ No newline at end of file
+}
+
+void ShaderProgram::ReflectUniforms()
+{
+    GLint count = 0, max_length = 0;
+    glGetProgramiv(program_, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program_, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+    std::string name(max_length + 16, '\0');
+
+    uniforms_.clear();
+    for (GLint i = 0; i < count; ++i)
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program_, (GLuint)i, (GLsizei)name.size(), &length, &size, &type, &name[0]);
+        GLint location = glGetUniformLocation(program_, name.c_str());
+        if (location < 0)
+            continue; // member of a uniform block
+
+        // Arrays are reported once as "name[0]"; every element gets an entry, the bare name too
+        std::string_view base(name.c_str(), length);
+        if (base.size() > 3 && base.substr(base.size() - 3) == "[0]")
+        {
+            base = base.substr(0, base.size() - 3);
+            uniforms_.push_back({ fnv1a(base), location });
+            for (GLint element = 0; element < size; ++element)
+            {
+                std::string element_name = std::string(base) + "[" + std::to_string(element) + "]";
+                uniforms_.push_back({ fnv1a(element_name), glGetUniformLocation(program_, element_name.c_str()) });
+            }
+        }
+        else
+        {
+            uniforms_.push_back({ fnv1a(base), location });
+        }
+    }
+
+    std::sort(uniforms_.begin(), uniforms_.end(), [](const Uniform& a, const Uniform& b) { return a.hash < b.hash; });
+    // Two names with one hash cannot be told apart, so neither resolves rather than whichever
+    // lower_bound happens to land on
+    for (size_t i = 1; i < uniforms_.size(); ++i)
+    {
+        if (uniforms_[i].hash == uniforms_[i - 1].hash)
+        {
+            if (uniforms_[i - 1].location != -1)
+                std::cerr << "ERROR::SHADER_PROGRAM::UNIFORM_HASH_COLLISION " << uniforms_[i].hash << std::endl;
+            uniforms_[i - 1].location = -1;
+            uniforms_[i].location = -1;
+        }
+    }
+
+    // Every id already used by some program resolves now, the later ones on first use
+    slot_locations_.assign(uniform_slots().size(), kUnresolvedLocation);
+    for (size_t slot = 0; slot < slot_locations_.size(); ++slot)
+        slot_locations_[slot] = Location(UniformId::FromHash(uniform_slots()[slot]));
+
+    GLint attribute_count = 0, max_attribute_length = 0;
+    glGetProgramiv(program_, GL_ACTIVE_ATTRIBUTES, &attribute_count);
+    glGetProgramiv(program_, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &max_attribute_length);
+    name.assign(max_attribute_length + 1, '\0');
+    attributes_.clear();
+    for (GLint i = 0; i < attribute_count; ++i)
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveAttrib(program_, (GLuint)i, (GLsizei)name.size(), &length, &size, &type, &name[0]);
+        attributes_.push_back({ fnv1a(std::string_view(name.c_str(), length)), glGetAttribLocation(program_, name.c_str()) });
+    }
+}
+
+uint32_t ShaderProgram::UniformSlot(uint32_t hash)
+{
+    std::vector<uint32_t>& slots = uniform_slots();
+    auto it = std::find(slots.begin(), slots.end(), hash);
+    if (it != slots.end())
+        return (uint32_t)(it - slots.begin());
+    slots.push_back(hash);
+    return (uint32_t)slots.size() - 1;
+}
+
+int ShaderProgram::ResolveSlot(uint32_t slot, uint32_t hash) const
+{
+    if (slot >= slot_locations_.size())
+        slot_locations_.resize(slot + 1, kUnresolvedLocation);
+    slot_locations_[slot] = Location(UniformId::FromHash(hash));
+    return slot_locations_[slot];
+}
+
+void ShaderProgram::Upload(int location, bool value)
+{
+    glUniform1i(location, (int)value);
+}
+
+void ShaderProgram::Upload(int location, int value)
+{
+    glUniform1i(location, value);
+}
+
+void ShaderProgram::Upload(int location, float value)
+{
+    glUniform1f(location, value);
+}
+
+void ShaderProgram::Upload(int location, const glm::vec2& value)
+{
+    glUniform2fv(location, 1, &value[0]);
+}
+
+void ShaderProgram::Upload(int location, const glm::vec3& value)
+{
+    glUniform3fv(location, 1, &value[0]);
+}
+
+void ShaderProgram::Upload(int location, const glm::vec4& value)
+{
+    glUniform4fv(location, 1, &value[0]);
+}
+
+void ShaderProgram::Upload(int location, const glm::mat2& value)
+{
+    glUniformMatrix2fv(location, 1, GL_FALSE, &value[0][0]);
+}
+
+void ShaderProgram::Upload(int location, const glm::mat3& value)
+{
+    glUniformMatrix3fv(location, 1, GL_FALSE, &value[0][0]);
+}
+
+void ShaderProgram::Upload(int location, const glm::mat4& value)
+{
+    glUniformMatrix4fv(location, 1, GL_FALSE, &value[0][0]);
+}
@@ -1,47 +1,119 @@
 #ifndef _SHADER_PROGRAM_H
 #define _SHADER_PROGRAM_H
 
-#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
 #include <glm/glm.hpp>
 #include "ShaderType.h"
+#include "string_id.h"
 
 typedef unsigned int GLuint;
 
+// Hash of a uniform name; "name"_id (Utility::literals) computes it at compile time
+typedef Utility::StringId UniformId;
+
 class ShaderProgram
 {
 public:
 	ShaderProgram(const char* vertexShaderFile, const char* fragmentShaderFile);
 	ShaderProgram(const char* vertexShaderSource, ShaderSourceType vertShaderSourceType,
 		const char* fragmentShaderSource, ShaderSourceType fragShaderSourceType);
+	// Compute program (GL 4.3 / ARB_compute_shader)
+	explicit ShaderProgram(const char* computeShaderFile);
 	~ShaderProgram();
 
-    void setBool(std::string name, bool value) const;
-    void setInt(std::string name, int value) const;
-	void setFloat(std::string name, float value) const;
+	// Names are looked up in the table of active uniforms read after linking, so setting a uniform
+	// never allocates nor asks the driver; unknown names give -1 like glGetUniformLocation, and so
+	// do names whose hash collides with another uniform of the program
+	int Location(std::string_view name) const;
+	int Location(UniformId id) const;
+
+    void setBool(std::string_view name, bool value) const;
+    void setInt(std::string_view name, int value) const;
+	void setFloat(std::string_view name, float value) const;
 
-    void setVec2(const std::string& name, const glm::vec2& value) const;
-    void setVec2(const std::string& name, float x, float y) const;
+    void setVec2(std::string_view name, const glm::vec2& value) const;
+    void setVec2(std::string_view name, float x, float y) const;
     // ------------------------------------------------------------------------
-    void setVec3(const std::string& name, const glm::vec3& value) const;
-    void setVec3(const std::string& name, float x, float y, float z) const;
+    void setVec3(std::string_view name, const glm::vec3& value) const;
+    void setVec3(std::string_view name, float x, float y, float z) const;
     // ------------------------------------------------------------------------
-    void setVec4(const std::string& name, const glm::vec4& value) const;
-	void setVec4(const std::string& name, float x, float y, float z, float w) const;
+    void setVec4(std::string_view name, const glm::vec4& value) const;
+	void setVec4(std::string_view name, float x, float y, float z, float w) const;
 	// ------------------------------------------------------------------------
-	void setMat2(const std::string& name, const glm::mat2& mat) const;
-	void setMat3(const std::string& name, const glm::mat3& mat) const;
-	void setMat4(const std::string& name, const glm::mat4& mat) const;
+	void setMat2(std::string_view name, const glm::mat2& mat) const;
+	void setMat3(std::string_view name, const glm::mat3& mat) const;
+	void setMat4(std::string_view name, const glm::mat4& mat) const;
+
+	// Uniform keyed by a compile time id: shader.set<"model_matrix"_id>(model). Every id used in
+	// the program gets a slot the first time it is set, and each program keeps the location per
+	// slot, so after the first call the lookup is a direct index.
+	template <uint32_t Id, typename T>
+	void set(const T& value) const
+	{
+		static const uint32_t slot = UniformSlot(Id);
+		Upload(SlotLocation(slot, Id), value);
+	}
+
+	// Same setters keyed by pre-hashed names
+	void setBool(UniformId id, bool value) const;
+	void setInt(UniformId id, int value) const;
+	void setFloat(UniformId id, float value) const;
+	void setVec2(UniformId id, const glm::vec2& value) const;
+	void setVec3(UniformId id, const glm::vec3& value) const;
+	void setVec4(UniformId id, const glm::vec4& value) const;
+	void setMat2(UniformId id, const glm::mat2& mat) const;
+	void setMat3(UniformId id, const glm::mat3& mat) const;
+	void setMat4(UniformId id, const glm::mat4& mat) const;
+
+	// Vertex input location, -1 when the program has no such active attribute
+	int AttributeLocation(UniformId id) const;
 
 	void use();
 	GLuint Id() const;
 private:
+	// constexpr, so inline: resize() and assign() bind it by reference without an out of class definition
+	static constexpr int kUnresolvedLocation = -2;
+
+	// Dense index of a compile time id, shared by every program
+	static uint32_t UniformSlot(uint32_t hash);
+	int SlotLocation(uint32_t slot, uint32_t hash) const
+	{
+		if (slot < slot_locations_.size() && slot_locations_[slot] != kUnresolvedLocation)
+			return slot_locations_[slot];
+		return ResolveSlot(slot, hash);
+	}
+	int ResolveSlot(uint32_t slot, uint32_t hash) const;
+
+	static void Upload(int location, bool value);
+	static void Upload(int location, int value);
+	static void Upload(int location, float value);
+	static void Upload(int location, const glm::vec2& value);
+	static void Upload(int location, const glm::vec3& value);
+	static void Upload(int location, const glm::vec4& value);
+	static void Upload(int location, const glm::mat2& value);
+	static void Upload(int location, const glm::mat3& value);
+	static void Upload(int location, const glm::mat4& value);
 
 	GLuint GenerateShader(const char* shaderSource, ShaderType type, ShaderSourceType sourceType = ShaderSourceType::File);
 	void GenerateProgram(GLuint vertexShader, GLuint fragmentShader);
+	void GenerateProgram(GLuint computeShader);
+	// Fills uniforms_ and attributes_ from the linked program
+	void ReflectUniforms();
 
 private:
+	struct Uniform
+	{
+		uint32_t hash;
+		int location;
+	};
+
 	GLuint program_ = -1;
+	std::vector<Uniform> uniforms_;  // sorted by hash, array elements listed one by one
+	std::vector<Uniform> attributes_;
+	mutable std::vector<int> slot_locations_;  // by UniformSlot, kUnresolvedLocation until first used
 
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -2,7 +2,8 @@
 enum class ShaderType
 {
 	Vertex,
-	Fragment
+	Fragment,
+	Compute
 };
 
 enum class ShaderSourceType
@@ -0,0 +1,50 @@
+#ifndef _ALIGNED_ALLOCATOR_H
+#define _ALIGNED_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+namespace Utility
+{
+    // std::allocator replacement for SIMD friendly arrays
+    template <typename T, size_t Alignment>
+    struct AlignedAllocator
+    {
+        typedef T value_type;
+        template <typename U> struct rebind { typedef AlignedAllocator<U, Alignment> other; };
+
+        AlignedAllocator() = default;
+        template <typename U> AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+        T* allocate(size_t count)
+        {
+            size_t bytes = (count * sizeof(T) + Alignment - 1) / Alignment * Alignment;
+#if defined(_MSC_VER)
+            void* memory = _aligned_malloc(bytes, Alignment);
+#else
+            void* memory = std::aligned_alloc(Alignment, bytes);
+#endif
+            if (!memory)
+                throw std::bad_alloc();
+            return static_cast<T*>(memory);
+        }
+
+        void deallocate(T* memory, size_t)
+        {
+#if defined(_MSC_VER)
+            _aligned_free(memory);
+#else
+            std::free(memory);
+#endif
+        }
+
+        template <typename U> bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+        template <typename U> bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+    };
+}
+
+#endif // !_ALIGNED_ALLOCATOR_H
@@ -0,0 +1,51 @@
+#include "allocation_counter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifndef NDEBUG
+namespace
+{
+    std::atomic<unsigned long long> allocations{ 0 };
+}
+
+// The array and nothrow forms forward to these by default
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+#endif
+
+namespace Utility::debug
+{
+    bool allocations_counted()
+    {
+#ifndef NDEBUG
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    unsigned long long allocation_count()
+    {
+#ifndef NDEBUG
+        return allocations.load(std::memory_order_relaxed);
+#else
+        return 0;
+#endif
+    }
+}
@@ -0,0 +1,14 @@
+#ifndef _ALLOCATION_COUNTER_H
+#define _ALLOCATION_COUNTER_H
+
+namespace Utility::debug
+{
+    // Debug builds (NDEBUG not defined) replace the global operator new and delete with versions
+    // that count every heap allocation, to check that a loop allocates nothing in steady state:
+    // read the count before and after and compare. Over-aligned allocations are not counted.
+    // Release builds keep the standard operators and always report 0.
+    bool allocations_counted();
+    unsigned long long allocation_count();
+}
+
+#endif // !_ALLOCATION_COUNTER_H
@@ -0,0 +1,389 @@
+#include "buffer_arena.h"
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Utility
+{
+    namespace
+    {
+        // index of the highest / lowest set bit, v must not be 0
+        uint32_t highest_bit(uint32_t v)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanReverse(&index, v);
+            return (uint32_t)index;
+#else
+            return 31u - (uint32_t)__builtin_clz(v);
+#endif
+        }
+
+        uint32_t lowest_bit(uint32_t v)
+        {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, v);
+            return (uint32_t)index;
+#else
+            return (uint32_t)__builtin_ctz(v);
+#endif
+        }
+    }
+
+    // ====================
+    //      TLSF
+    // ====================
+    TlsfAllocator::TlsfAllocator(uint32_t capacity)
+    {
+        Reset(capacity);
+    }
+
+    void TlsfAllocator::Reset(uint32_t capacity)
+    {
+        capacity_ = capacity;
+        used_ = 0;
+        free_blocks_ = 0;
+        allocations_ = 0;
+        first_level_bitmap_ = 0;
+        for (uint32_t first = 0; first < kFirstLevelCount; ++first)
+        {
+            second_level_bitmap_[first] = 0;
+            for (uint32_t second = 0; second < kSecondLevelCount; ++second)
+                heads_[first][second] = kInvalid;
+        }
+        nodes_.clear();
+        unused_nodes_.clear();
+
+        if (capacity == 0)
+            return;
+        uint32_t node = NewNode();
+        nodes_[node].size = capacity;
+        InsertFree(node);
+    }
+
+    TlsfAllocator::Allocation TlsfAllocator::Allocate(uint32_t size, uint32_t alignment)
+    {
+        Allocation allocation;
+        alignment = std::max(alignment, 1u);
+        uint64_t request = (uint64_t)size + alignment - 1;
+        if (size == 0 || request > capacity_)
+            return allocation;
+
+        uint32_t node = FindFree((uint32_t)request);
+        if (node == kInvalid)
+            return allocation;
+        RemoveFree(node);
+
+        // Leading padding goes back to the free lists as its own block
+        uint32_t offset = nodes_[node].offset;
+        uint32_t padding = (alignment - offset % alignment) % alignment;
+        if (padding)
+        {
+            uint32_t aligned = Split(node, padding);
+            InsertFree(node);
+            node = aligned;
+        }
+        if (nodes_[node].size > size)
+            InsertFree(Split(node, size));
+
+        used_ += size;
+        ++allocations_;
+        allocation.offset = nodes_[node].offset;
+        allocation.size = size;
+        allocation.node = node;
+        return allocation;
+    }
+
+    void TlsfAllocator::Free(const Allocation& allocation)
+    {
+        if (!allocation.Valid() || allocation.node >= nodes_.size() || nodes_[allocation.node].free)
+            return;
+
+        uint32_t node = allocation.node;
+        used_ -= nodes_[node].size;
+        --allocations_;
+
+        // Merge with the free neighbours so free space never stays split at a boundary
+        uint32_t prev = nodes_[node].prev_physical;
+        if (prev != kInvalid && nodes_[prev].free)
+        {
+            RemoveFree(prev);
+            nodes_[prev].size += nodes_[node].size;
+            nodes_[prev].next_physical = nodes_[node].next_physical;
+            if (nodes_[node].next_physical != kInvalid)
+                nodes_[nodes_[node].next_physical].prev_physical = prev;
+            unused_nodes_.push_back(node);
+            node = prev;
+        }
+        uint32_t next = nodes_[node].next_physical;
+        if (next != kInvalid && nodes_[next].free)
+        {
+            RemoveFree(next);
+            nodes_[node].size += nodes_[next].size;
+            nodes_[node].next_physical = nodes_[next].next_physical;
+            if (nodes_[next].next_physical != kInvalid)
+                nodes_[nodes_[next].next_physical].prev_physical = node;
+            unused_nodes_.push_back(next);
+        }
+        InsertFree(node);
+    }
+
+    uint32_t TlsfAllocator::LargestFreeBlock() const
+    {
+        if (!first_level_bitmap_)
+            return 0;
+        uint32_t first = highest_bit(first_level_bitmap_);
+        uint32_t second = highest_bit(second_level_bitmap_[first]);
+
+        // a size class spans a range of sizes, so the largest block is somewhere in its list
+        uint32_t largest = 0;
+        for (uint32_t node = heads_[first][second]; node != kInvalid; node = nodes_[node].next_free)
+            largest = std::max(largest, nodes_[node].size);
+        return largest;
+    }
+
+    // ===============
+    // PRIVATE
+    // ===============
+    void TlsfAllocator::Mapping(uint32_t size, uint32_t& first, uint32_t& second)
+    {
+        if (size < kSecondLevelCount)
+        {
+            first = 0;
+            second = size;
+            return;
+        }
+        uint32_t bit = highest_bit(size);
+        first = bit - kSecondLevelBits + 1;
+        second = (size >> (bit - kSecondLevelBits)) - kSecondLevelCount;
+    }
+
+    uint32_t TlsfAllocator::FindFree(uint32_t size) const
+    {
+        // Round up to the next size class so any block found there is large enough
+        uint64_t rounded = size;
+        if (size >= kSecondLevelCount)
+            rounded += (1u << (highest_bit(size) - kSecondLevelBits)) - 1;
+
+        uint32_t first, second;
+        if (rounded <= 0xffffffffu)
+        {
+            Mapping((uint32_t)rounded, first, second);
+            uint32_t second_map = second_level_bitmap_[first] & (~0u << second);
+            uint32_t first_map = first + 1 < 32 ? first_level_bitmap_ & (~0u << (first + 1)) : 0;
+            if (second_map)
+                return heads_[first][lowest_bit(second_map)];
+            if (first_map)
+            {
+                first = lowest_bit(first_map);
+                return heads_[first][lowest_bit(second_level_bitmap_[first])];
+            }
+        }
+
+        // Nothing in the larger classes; a block of the request's own class may still be big enough
+        // (e.g. a buffer sized exactly for one mesh)
+        Mapping(size, first, second);
+        for (uint32_t node = heads_[first][second]; node != kInvalid; node = nodes_[node].next_free)
+        {
+            if (nodes_[node].size >= size)
+                return node;
+        }
+        return kInvalid;
+    }
+
+    uint32_t TlsfAllocator::NewNode()
+    {
+        if (!unused_nodes_.empty())
+        {
+            uint32_t node = unused_nodes_.back();
+            unused_nodes_.pop_back();
+            nodes_[node] = Node();
+            return node;
+        }
+        nodes_.emplace_back();
+        return (uint32_t)nodes_.size() - 1;
+    }
+
+    void TlsfAllocator::InsertFree(uint32_t node)
+    {
+        uint32_t first, second;
+        Mapping(nodes_[node].size, first, second);
+
+        Node& block = nodes_[node];
+        block.free = true;
+        block.prev_free = kInvalid;
+        block.next_free = heads_[first][second];
+        if (block.next_free != kInvalid)
+            nodes_[block.next_free].prev_free = node;
+        heads_[first][second] = node;
+
+        first_level_bitmap_ |= 1u << first;
+        second_level_bitmap_[first] |= 1u << second;
+        ++free_blocks_;
+    }
+
+    void TlsfAllocator::RemoveFree(uint32_t node)
+    {
+        uint32_t first, second;
+        Mapping(nodes_[node].size, first, second);
+
+        Node& block = nodes_[node];
+        if (block.prev_free != kInvalid)
+            nodes_[block.prev_free].next_free = block.next_free;
+        else
+            heads_[first][second] = block.next_free;
+        if (block.next_free != kInvalid)
+            nodes_[block.next_free].prev_free = block.prev_free;
+        block.free = false;
+        block.prev_free = block.next_free = kInvalid;
+
+        if (heads_[first][second] == kInvalid)
+        {
+            second_level_bitmap_[first] &= ~(1u << second);
+            if (!second_level_bitmap_[first])
+                first_level_bitmap_ &= ~(1u << first);
+        }
+        --free_blocks_;
+    }
+
+    uint32_t TlsfAllocator::Split(uint32_t node, uint32_t size)
+    {
+        // NewNode may grow nodes_, so no references are held across it
+        uint32_t tail = NewNode();
+        nodes_[tail].offset = nodes_[node].offset + size;
+        nodes_[tail].size = nodes_[node].size - size;
+        nodes_[tail].prev_physical = node;
+        nodes_[tail].next_physical = nodes_[node].next_physical;
+        if (nodes_[node].next_physical != kInvalid)
+            nodes_[nodes_[node].next_physical].prev_physical = tail;
+        nodes_[node].next_physical = tail;
+        nodes_[node].size = size;
+        return tail;
+    }
+
+    // ====================
+    //      REPORT
+    // ====================
+    double ArenaReport::Utilization() const
+    {
+        return capacity ? (double)used / capacity : 0.0;
+    }
+
+    double ArenaReport::Fragmentation() const
+    {
+        size_t free = capacity - used;
+        return free ? 1.0 - (double)largest_free / free : 0.0;
+    }
+
+    ArenaReport& ArenaReport::operator+=(const ArenaReport& other)
+    {
+        buffers += other.buffers;
+        capacity += other.capacity;
+        used += other.used;
+        largest_free = std::max(largest_free, other.largest_free);
+        free_blocks += other.free_blocks;
+        allocations += other.allocations;
+        return *this;
+    }
+
+    std::ostream& operator<<(std::ostream& os, const ArenaReport& report)
+    {
+        os << report.allocations << " allocations in " << report.buffers << " buffer(s), "
+           << report.used / 1024.0 << "/" << report.capacity / 1024.0 << " KB used (" << 100.0 * report.Utilization() << "%), "
+           << report.free_blocks << " free blocks, largest " << report.largest_free / 1024.0 << " KB, fragmentation "
+           << 100.0 * report.Fragmentation() << "%";
+        return os;
+    }
+
+    // ====================
+    //      ARENA
+    // ====================
+    BufferArena::~BufferArena()
+    {
+        Release();
+    }
+
+    BufferArena::BufferArena(BufferArena&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    BufferArena& BufferArena::operator=(BufferArena&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Release();
+            buffer_ = other.buffer_;
+            target_ = other.target_;
+            immutable_ = other.immutable_;
+            allocator_ = std::move(other.allocator_);
+            other.buffer_ = 0;
+            other.allocator_.Reset(0);
+        }
+        return *this;
+    }
+
+    bool BufferArena::Create(GLenum target, size_t capacity)
+    {
+        Release();
+        if (capacity == 0 || capacity > 0xffffffffu)
+            return false;
+
+        target_ = target;
+        glGenBuffers(1, &buffer_);
+        glBindBuffer(target_, buffer_);
+        immutable_ = GLEW_ARB_buffer_storage;
+        if (immutable_)
+            glBufferStorage(target_, capacity, nullptr, GL_DYNAMIC_STORAGE_BIT);
+        else
+            glBufferData(target_, capacity, nullptr, GL_STATIC_DRAW);
+
+        allocator_.Reset((uint32_t)capacity);
+        return true;
+    }
+
+    void BufferArena::Release()
+    {
+        if (buffer_)
+            glDeleteBuffers(1, &buffer_);
+        buffer_ = 0;
+        allocator_.Reset(0);
+    }
+
+    TlsfAllocator::Allocation BufferArena::Allocate(size_t bytes, size_t alignment)
+    {
+        if (bytes > 0xffffffffu || alignment > 0xffffffffu)
+            return TlsfAllocator::Allocation();
+        return allocator_.Allocate((uint32_t)bytes, (uint32_t)alignment);
+    }
+
+    void BufferArena::Free(const TlsfAllocator::Allocation& allocation)
+    {
+        allocator_.Free(allocation);
+    }
+
+    void BufferArena::Upload(const TlsfAllocator::Allocation& allocation, const void* data, size_t bytes, size_t offset) const
+    {
+        if (!allocation.Valid() || offset + bytes > allocation.size)
+            return;
+        glBindBuffer(target_, buffer_);
+        glBufferSubData(target_, allocation.offset + offset, bytes, data);
+    }
+
+    ArenaReport BufferArena::Report() const
+    {
+        ArenaReport report;
+        if (!buffer_)
+            return report;
+        report.buffers = 1;
+        report.capacity = allocator_.Capacity();
+        report.used = allocator_.UsedBytes();
+        report.largest_free = allocator_.LargestFreeBlock();
+        report.free_blocks = allocator_.FreeBlockCount();
+        report.allocations = allocator_.AllocationCount();
+        return report;
+    }
+}
@@ -0,0 +1,136 @@
+#ifndef _BUFFER_ARENA_H
+#define _BUFFER_ARENA_H
+
+#include <GL/glew.h>
+#include <vector>
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
+
+namespace Utility
+{
+    // Two level segregated fit allocator (Masmano et al.) over an abstract range [0, capacity).
+    // It only hands out offsets, so it can manage GPU memory it never touches. Allocation and free
+    // are O(1): free blocks sit in size class lists found through two bitmaps, and freed blocks are
+    // merged with their free neighbours right away.
+    class TlsfAllocator
+    {
+    public:
+        static const uint32_t kInvalid = 0xffffffffu;
+
+        struct Allocation
+        {
+            uint32_t offset = kInvalid;
+            uint32_t size = 0;
+            uint32_t node = kInvalid;
+
+            bool Valid() const { return offset != kInvalid; }
+        };
+
+        explicit TlsfAllocator(uint32_t capacity = 0);
+
+        void Reset(uint32_t capacity);
+        // Any alignment works, not only powers of two (e.g. a vertex stride). Invalid when nothing fits.
+        Allocation Allocate(uint32_t size, uint32_t alignment = 1);
+        void Free(const Allocation& allocation);
+
+        uint32_t Capacity() const { return capacity_; }
+        uint32_t UsedBytes() const { return used_; }
+        uint32_t FreeBytes() const { return capacity_ - used_; }
+        uint32_t LargestFreeBlock() const;
+        uint32_t FreeBlockCount() const { return free_blocks_; }
+        uint32_t AllocationCount() const { return allocations_; }
+
+    private:
+        static const uint32_t kSecondLevelBits = 4;
+        static const uint32_t kSecondLevelCount = 1u << kSecondLevelBits;
+        static const uint32_t kFirstLevelCount = 32 - kSecondLevelBits + 1;
+
+        struct Node
+        {
+            uint32_t offset = 0;
+            uint32_t size = 0;
+            uint32_t prev_physical = kInvalid;
+            uint32_t next_physical = kInvalid;
+            uint32_t prev_free = kInvalid;
+            uint32_t next_free = kInvalid;
+            bool free = false;
+        };
+
+        static void Mapping(uint32_t size, uint32_t& first, uint32_t& second);
+        uint32_t FindFree(uint32_t size) const;
+        uint32_t NewNode();
+        void InsertFree(uint32_t node);
+        void RemoveFree(uint32_t node);
+        uint32_t Split(uint32_t node, uint32_t size);
+
+    private:
+        uint32_t capacity_ = 0;
+        uint32_t used_ = 0;
+        uint32_t free_blocks_ = 0;
+        uint32_t allocations_ = 0;
+        uint32_t first_level_bitmap_ = 0;
+        uint32_t second_level_bitmap_[kFirstLevelCount] = {};
+        uint32_t heads_[kFirstLevelCount][kSecondLevelCount];
+        std::vector<Node> nodes_;
+        std::vector<uint32_t> unused_nodes_;
+    };
+
+    struct ArenaReport
+    {
+        size_t buffers = 0;
+        size_t capacity = 0;          // bytes reserved on the GPU
+        size_t used = 0;              // bytes handed out
+        size_t largest_free = 0;
+        size_t free_blocks = 0;
+        size_t allocations = 0;
+
+        // used / capacity
+        double Utilization() const;
+        // 0 when all free space is one block, towards 1 as it breaks up into small holes
+        double Fragmentation() const;
+
+        ArenaReport& operator+=(const ArenaReport& other);
+    };
+
+    std::ostream& operator<<(std::ostream& os, const ArenaReport& report);
+
+    // One GL buffer of fixed size with TLSF sub-allocation. The storage is immutable
+    // (glBufferStorage) where ARB_buffer_storage is available and a single glBufferData otherwise;
+    // either way it is never re-specified, so ranges are filled with glBufferSubData.
+    // Needs a current GL context for its whole lifetime.
+    class BufferArena
+    {
+    public:
+        BufferArena() = default;
+        ~BufferArena();
+
+        BufferArena(const BufferArena&) = delete;
+        BufferArena& operator=(const BufferArena&) = delete;
+        BufferArena(BufferArena&& other) noexcept;
+        BufferArena& operator=(BufferArena&& other) noexcept;
+
+        // target is where the buffer is bound for uploads (GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER...)
+        bool Create(GLenum target, size_t capacity);
+        void Release();
+
+        TlsfAllocator::Allocation Allocate(size_t bytes, size_t alignment = 1);
+        void Free(const TlsfAllocator::Allocation& allocation);
+        // Copies into the allocation starting at offset bytes. Leaves the buffer bound to the target,
+        // which for GL_ELEMENT_ARRAY_BUFFER is the currently bound VAO's binding.
+        void Upload(const TlsfAllocator::Allocation& allocation, const void* data, size_t bytes, size_t offset = 0) const;
+
+        GLuint Buffer() const { return buffer_; }
+        GLenum Target() const { return target_; }
+        bool Immutable() const { return immutable_; }
+        ArenaReport Report() const;
+
+    private:
+        GLuint buffer_ = 0;
+        GLenum target_ = GL_ARRAY_BUFFER;
+        bool immutable_ = false;
+        TlsfAllocator allocator_;
+    };
+}
+
+#endif // !_BUFFER_ARENA_H
@@ -0,0 +1,260 @@
+#include "clustered_lighting.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Utility::render
+{
+    using namespace Utility::literals;
+
+    std::ostream& operator<<(std::ostream& os, const ClusterStats& stats)
+    {
+        os << stats.visible_lights << "/" << stats.lights << " lights visible, " << stats.references << " references in "
+           << stats.occupied_clusters << " clusters, ";
+        if (stats.occupied_clusters)
+            os << (double)stats.references / stats.occupied_clusters << " lights per occupied cluster, ";
+        os << stats.max_cluster_lights << " max";
+        if (stats.dropped)
+            os << ", " << stats.dropped << " dropped";
+        return os;
+    }
+
+    // ====================
+    //      GRID
+    // ====================
+    ClusterGrid::ClusterGrid(const ClusterGridOptions& options)
+        : options_(options)
+    {
+        options_.tiles_x = std::max(options_.tiles_x, 1u);
+        options_.tiles_y = std::max(options_.tiles_y, 1u);
+        options_.slices = std::max(options_.slices, 1u);
+        ranges_.assign(ClusterCount(), Range{ 0, 0 });
+    }
+
+    void ClusterGrid::SetProjection(float fov_y, float aspect, float near_plane, float far_plane)
+    {
+        near_ = near_plane;
+        far_ = far_plane;
+        float tan_half_fov = std::tan(fov_y * 0.5f);
+        projection_scale_ = glm::vec2(1.0f / (tan_half_fov * aspect), 1.0f / tan_half_fov);
+
+        float depth_ratio = std::log(far_ / near_);
+        slice_scale_ = options_.slices / depth_ratio;
+        slice_bias_ = -(float)options_.slices * std::log(near_) / depth_ratio;
+
+        // A cluster is the part of its tile's frustum between two slice depths; its box spans the
+        // tile corners at both depths
+        boxes_.resize(ClusterCount());
+        for (unsigned int slice = 0; slice < options_.slices; ++slice)
+        {
+            float depth_near = near_ * std::pow(far_ / near_, (float)slice / options_.slices);
+            float depth_far = near_ * std::pow(far_ / near_, (float)(slice + 1) / options_.slices);
+            for (unsigned int y = 0; y < options_.tiles_y; ++y)
+            {
+                float ndc_y0 = -1.0f + 2.0f * y / options_.tiles_y;
+                float ndc_y1 = -1.0f + 2.0f * (y + 1) / options_.tiles_y;
+                for (unsigned int x = 0; x < options_.tiles_x; ++x)
+                {
+                    float ndc_x0 = -1.0f + 2.0f * x / options_.tiles_x;
+                    float ndc_x1 = -1.0f + 2.0f * (x + 1) / options_.tiles_x;
+                    Box& box = boxes_[x + options_.tiles_x * (y + options_.tiles_y * slice)];
+                    box.min_corner = glm::vec3(
+                        std::min(ndc_x0 * depth_near, ndc_x0 * depth_far) / projection_scale_.x,
+                        std::min(ndc_y0 * depth_near, ndc_y0 * depth_far) / projection_scale_.y,
+                        -depth_far);
+                    box.max_corner = glm::vec3(
+                        std::max(ndc_x1 * depth_near, ndc_x1 * depth_far) / projection_scale_.x,
+                        std::max(ndc_y1 * depth_near, ndc_y1 * depth_far) / projection_scale_.y,
+                        -depth_near);
+                }
+            }
+        }
+    }
+
+    int ClusterGrid::Slice(float view_depth) const
+    {
+        int slice = (int)std::floor(std::log(std::max(view_depth, near_)) * slice_scale_ + slice_bias_);
+        return std::min(std::max(slice, 0), (int)options_.slices - 1);
+    }
+
+    void ClusterGrid::Assign(const GpuPointLight* lights, size_t count, const glm::mat4& view_matrix)
+    {
+        stats_ = ClusterStats();
+        stats_.lights = count;
+        references_.clear();
+        cursors_.assign(ClusterCount(), 0);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            glm::vec3 center = glm::vec3(view_matrix * glm::vec4(lights[i].position, 1.0f));
+            float radius = lights[i].radius;
+            float depth_min = -center.z - radius;
+            float depth_max = -center.z + radius;
+            if (depth_max < near_ || depth_min > far_)
+                continue;
+
+            unsigned int slice_begin = (unsigned int)Slice(depth_min);
+            unsigned int slice_end = (unsigned int)Slice(depth_max) + 1;
+
+            // Screen extent of the sphere's view space box; a box crossing the near plane covers the
+            // whole screen. x / depth is extreme at one of the two depths for either side.
+            unsigned int x_begin = 0, x_end = options_.tiles_x;
+            unsigned int y_begin = 0, y_end = options_.tiles_y;
+            if (depth_min > near_)
+            {
+                auto tile_range = [](float low, float high, float scale, unsigned int tiles, unsigned int& begin, unsigned int& end) {
+                    float ndc_low = scale * low;
+                    float ndc_high = scale * high;
+                    begin = (unsigned int)std::min(std::max((int)std::floor((ndc_low * 0.5f + 0.5f) * tiles), 0), (int)tiles);
+                    end = (unsigned int)std::min(std::max((int)std::floor((ndc_high * 0.5f + 0.5f) * tiles) + 1, 0), (int)tiles);
+                };
+                float x_low = std::min((center.x - radius) / depth_min, (center.x - radius) / depth_max);
+                float x_high = std::max((center.x + radius) / depth_min, (center.x + radius) / depth_max);
+                float y_low = std::min((center.y - radius) / depth_min, (center.y - radius) / depth_max);
+                float y_high = std::max((center.y + radius) / depth_min, (center.y + radius) / depth_max);
+                tile_range(x_low, x_high, projection_scale_.x, options_.tiles_x, x_begin, x_end);
+                tile_range(y_low, y_high, projection_scale_.y, options_.tiles_y, y_begin, y_end);
+            }
+
+            bool visible = false;
+            float radius_squared = radius * radius;
+            for (unsigned int slice = slice_begin; slice < slice_end; ++slice)
+            {
+                for (unsigned int y = y_begin; y < y_end; ++y)
+                {
+                    uint32_t row = options_.tiles_x * (y + options_.tiles_y * slice);
+                    for (unsigned int x = x_begin; x < x_end; ++x)
+                    {
+                        const Box& box = boxes_[row + x];
+                        glm::vec3 closest = glm::clamp(center, box.min_corner, box.max_corner);
+                        glm::vec3 offset = center - closest;
+                        if (glm::dot(offset, offset) > radius_squared)
+                            continue;
+                        references_.push_back({ row + x, (uint32_t)i });
+                        ++cursors_[row + x];
+                        visible = true;
+                    }
+                }
+            }
+            stats_.visible_lights += visible;
+        }
+
+        // Counts to offsets, then the references are scattered in light order
+        uint32_t offset = 0;
+        for (size_t cluster = 0; cluster < ranges_.size(); ++cluster)
+        {
+            uint32_t lights_in_cluster = cursors_[cluster];
+            uint32_t kept = std::min(lights_in_cluster, options_.max_lights_per_cluster);
+            ranges_[cluster] = Range{ offset, kept };
+            offset += kept;
+            cursors_[cluster] = 0;
+
+            stats_.occupied_clusters += lights_in_cluster > 0;
+            stats_.max_cluster_lights = std::max<size_t>(stats_.max_cluster_lights, lights_in_cluster);
+            stats_.dropped += lights_in_cluster - kept;
+        }
+        indices_.resize(offset);
+        for (const Reference& reference : references_)
+        {
+            const Range& range = ranges_[reference.cluster];
+            uint32_t& cursor = cursors_[reference.cluster];
+            if (cursor < range.count)
+                indices_[range.offset + cursor++] = reference.light;
+        }
+        stats_.references = indices_.size();
+    }
+
+    // ====================
+    //      GPU
+    // ====================
+    const GLuint ClusteredLighting::kLightBinding;
+    const GLuint ClusteredLighting::kClusterBinding;
+    const GLuint ClusteredLighting::kIndexBinding;
+    const GLuint ClusteredLighting::kLightUnit;
+    const GLuint ClusteredLighting::kClusterUnit;
+    const GLuint ClusteredLighting::kIndexUnit;
+
+    ClusteredLighting::ClusteredLighting()
+    {
+        storage_buffers_ = StorageBuffersSupported();
+        glGenBuffers(3, buffers_);
+        if (!storage_buffers_)
+            glGenTextures(3, textures_);
+    }
+
+    ClusteredLighting::~ClusteredLighting()
+    {
+        glDeleteBuffers(3, buffers_);
+        if (!storage_buffers_)
+            glDeleteTextures(3, textures_);
+    }
+
+    bool ClusteredLighting::StorageBuffersSupported()
+    {
+        return GLEW_ARB_shader_storage_buffer_object;
+    }
+
+    void ClusteredLighting::Upload(const ClusterGrid& grid, const GpuPointLight* lights, size_t count)
+    {
+        GLenum target = storage_buffers_ ? GL_SHADER_STORAGE_BUFFER : GL_TEXTURE_BUFFER;
+        Write(buffers_[0], target, lights, count * sizeof(GpuPointLight), capacities_[0]);
+        Write(buffers_[1], target, grid.Ranges().data(), grid.Ranges().size() * sizeof(ClusterGrid::Range), capacities_[1]);
+        Write(buffers_[2], target, grid.LightIndices().data(), grid.LightIndices().size() * sizeof(uint32_t), capacities_[2]);
+
+        if (!storage_buffers_)
+        {
+            // Two RGBA32F texels per light, one RG32UI texel per cluster, one R32UI texel per index
+            const GLenum formats[3] = { GL_RGBA32F, GL_RG32UI, GL_R32UI };
+            for (int i = 0; i < 3; ++i)
+            {
+                glBindTexture(GL_TEXTURE_BUFFER, textures_[i]);
+                glTexBuffer(GL_TEXTURE_BUFFER, formats[i], buffers_[i]);
+            }
+            glBindTexture(GL_TEXTURE_BUFFER, 0);
+        }
+    }
+
+    void ClusteredLighting::Apply(const ShaderProgram& shader, const ClusterGrid& grid, int viewport_width, int viewport_height) const
+    {
+        const ClusterGridOptions& options = grid.Options();
+        if (storage_buffers_)
+        {
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kLightBinding, buffers_[0]);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kClusterBinding, buffers_[1]);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kIndexBinding, buffers_[2]);
+        }
+        else
+        {
+            const GLuint units[3] = { kLightUnit, kClusterUnit, kIndexUnit };
+            for (int i = 0; i < 3; ++i)
+            {
+                glActiveTexture(GL_TEXTURE0 + units[i]);
+                glBindTexture(GL_TEXTURE_BUFFER, textures_[i]);
+            }
+            glActiveTexture(GL_TEXTURE0);
+            shader.setInt("light_data"_id, kLightUnit);
+            shader.setInt("cluster_data"_id, kClusterUnit);
+            shader.setInt("light_index_data"_id, kIndexUnit);
+        }
+
+        glUniform3ui(shader.Location("cluster_grid"_id), options.tiles_x, options.tiles_y, options.slices);
+        shader.setVec2("cluster_tile_pixels"_id, glm::vec2((float)viewport_width / options.tiles_x, (float)viewport_height / options.tiles_y));
+        shader.setFloat("cluster_slice_scale"_id, grid.SliceScale());
+        shader.setFloat("cluster_slice_bias"_id, grid.SliceBias());
+    }
+
+    // ===============
+    // PRIVATE
+    // ===============
+    void ClusteredLighting::Write(GLuint buffer, GLenum target, const void* data, size_t bytes, size_t& capacity)
+    {
+        if (bytes > capacity || capacity == 0)
+            capacity = std::max<size_t>(std::max(bytes, capacity * 2), 256);
+
+        // Orphaned every frame, the previous frame's draws may still read the old storage
+        glBindBuffer(target, buffer);
+        glBufferData(target, capacity, nullptr, GL_STREAM_DRAW);
+        if (bytes)
+            glBufferSubData(target, 0, bytes, data);
+        glBindBuffer(target, 0);
+    }
+}
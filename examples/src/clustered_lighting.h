@@ -0,0 +1,154 @@
+#ifndef _CLUSTERED_LIGHTING_H
+#define _CLUSTERED_LIGHTING_H
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "ShaderProgram.h"
+#include <ostream>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace Utility::render
+{
+    // Light record shared with the clustered shaders (std430, 32 bytes)
+    struct GpuPointLight
+    {
+        glm::vec3 position;         // world space
+        float radius = 10.0f;       // no contribution beyond this distance
+        glm::vec3 color;            // already scaled by the intensity
+        float padding = 0.0f;
+    };
+
+    struct ClusterGridOptions
+    {
+        unsigned int tiles_x = 16;
+        unsigned int tiles_y = 9;
+        unsigned int slices = 24;                   // exponential in view depth, so near clusters stay small
+        unsigned int max_lights_per_cluster = 256;  // more lights than this in a cluster are dropped
+    };
+
+    struct ClusterStats
+    {
+        size_t lights = 0;
+        size_t visible_lights = 0;      // touching at least one cluster
+        size_t references = 0;          // entries of the light index list
+        size_t occupied_clusters = 0;
+        size_t max_cluster_lights = 0;
+        size_t dropped = 0;             // over max_lights_per_cluster
+    };
+
+    std::ostream& operator<<(std::ostream& os, const ClusterStats& stats);
+
+    // Froxel grid over the view frustum: tiles_x * tiles_y screen tiles, each cut into slices along
+    // the view depth. Assign() tests every light's bounding sphere against the view space boxes of
+    // the clusters its screen and depth extent covers and builds, per cluster, a range into one
+    // compact light index list, so the fragment shader loops only over the lights of its cluster.
+    // Plain CPU work, no GL calls.
+    class ClusterGrid
+    {
+    public:
+        // Offset into LightIndices() and number of lights of one cluster
+        struct Range
+        {
+            uint32_t offset;
+            uint32_t count;
+        };
+
+        explicit ClusterGrid(const ClusterGridOptions& options = ClusterGridOptions());
+
+        // Rebuilds the cluster boxes; has to match the projection used to draw
+        void SetProjection(float fov_y, float aspect, float near_plane, float far_plane);
+
+        void Assign(const GpuPointLight* lights, size_t count, const glm::mat4& view_matrix);
+        void Assign(const std::vector<GpuPointLight>& lights, const glm::mat4& view_matrix)
+        {
+            Assign(lights.data(), lights.size(), view_matrix);
+        }
+
+        // x + tiles_x * (y + tiles_y * slice), tile y counted from the bottom of the screen like gl_FragCoord
+        const std::vector<Range>& Ranges() const { return ranges_; }
+        const std::vector<uint32_t>& LightIndices() const { return indices_; }
+        const ClusterStats& Stats() const { return stats_; }
+
+        const ClusterGridOptions& Options() const { return options_; }
+        size_t ClusterCount() const { return (size_t)options_.tiles_x * options_.tiles_y * options_.slices; }
+        // slice = log(view_depth) * SliceScale() + SliceBias()
+        float SliceScale() const { return slice_scale_; }
+        float SliceBias() const { return slice_bias_; }
+        int Slice(float view_depth) const;
+
+    private:
+        struct Box
+        {
+            glm::vec3 min_corner;
+            glm::vec3 max_corner;
+        };
+
+        struct Reference
+        {
+            uint32_t cluster;
+            uint32_t light;
+        };
+
+    private:
+        ClusterGridOptions options_;
+        float near_ = 0.1f;
+        float far_ = 100.0f;
+        glm::vec2 projection_scale_ = glm::vec2(1.0f);  // view x, y over depth to NDC
+        float slice_scale_ = 0.0f;
+        float slice_bias_ = 0.0f;
+
+        std::vector<Box> boxes_;            // view space, by cluster
+        std::vector<Range> ranges_;
+        std::vector<uint32_t> indices_;
+        std::vector<Reference> references_; // scratch, in light order
+        std::vector<uint32_t> cursors_;     // scratch, by cluster
+        ClusterStats stats_;
+    };
+
+    // GPU side of the grid: the lights, the cluster ranges and the light index list in shader
+    // storage buffers at kLightBinding, kClusterBinding and kIndexBinding (GL 4.3 /
+    // ARB_shader_storage_buffer_object). Without storage buffers the same data goes to texture
+    // buffers on units kLightUnit, kClusterUnit and kIndexUnit, read by clustered_forward_tbo_fs.glsl.
+    class ClusteredLighting
+    {
+    public:
+        static const GLuint kLightBinding = 2;
+        static const GLuint kClusterBinding = 3;
+        static const GLuint kIndexBinding = 4;
+        static const GLuint kLightUnit = 4;
+        static const GLuint kClusterUnit = 5;
+        static const GLuint kIndexUnit = 6;
+
+        ClusteredLighting();
+        ~ClusteredLighting();
+
+        ClusteredLighting(const ClusteredLighting&) = delete;
+        ClusteredLighting& operator=(const ClusteredLighting&) = delete;
+
+        static bool StorageBuffersSupported();
+        bool UsesStorageBuffers() const { return storage_buffers_; }
+
+        void Upload(const ClusterGrid& grid, const GpuPointLight* lights, size_t count);
+        void Upload(const ClusterGrid& grid, const std::vector<GpuPointLight>& lights)
+        {
+            Upload(grid, lights.data(), lights.size());
+        }
+
+        // Binds the buffers and sets the cluster uniforms of the program in use; viewport in pixels
+        void Apply(const ShaderProgram& shader, const ClusterGrid& grid, int viewport_width, int viewport_height) const;
+
+    private:
+        // Orphans the buffer storage, growing it when needed, then writes the data
+        static void Write(GLuint buffer, GLenum target, const void* data, size_t bytes, size_t& capacity);
+
+    private:
+        bool storage_buffers_ = false;
+        GLuint buffers_[3] = {};            // lights, cluster ranges, light indices
+        GLuint textures_[3] = {};           // texture buffer views of the same, without storage buffers
+        size_t capacities_[3] = {};
+    };
+}
+
+#endif // !_CLUSTERED_LIGHTING_H
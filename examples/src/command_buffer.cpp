@@ -0,0 +1,248 @@
+#include "command_buffer.h"
+#include <GL/glew.h>
+#include <iostream>
+
+namespace Utility::render
+{
+    namespace
+    {
+        const size_t kCommandAlignment = 8;
+
+        size_t align_up(size_t value, size_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    }
+
+    size_t uniform_bytes(UniformType type, size_t count)
+    {
+        switch (type)
+        {
+        case UniformType::Int:   return sizeof(int32_t) * count;
+        case UniformType::Float: return sizeof(float) * count;
+        case UniformType::Vec2:  return sizeof(float) * 2 * count;
+        case UniformType::Vec3:  return sizeof(float) * 3 * count;
+        case UniformType::Vec4:  return sizeof(float) * 4 * count;
+        case UniformType::Mat4:  return sizeof(float) * 16 * count;
+        }
+        return 0;
+    }
+
+    // ====================
+    //   COMMAND BUFFER
+    // ====================
+    void CommandBuffer::Reset()
+    {
+        for (Block& block : blocks_)
+            block.used = 0;
+        current_ = 0;
+        commands_ = 0;
+        bytes_ = 0;
+    }
+
+    void CommandBuffer::UseProgram(uint32_t program)
+    {
+        Append(CommandType::UseProgram, UseProgramCommand{ program });
+    }
+
+    void CommandBuffer::BindVertexArray(uint32_t vertex_array)
+    {
+        Append(CommandType::BindVertexArray, BindVertexArrayCommand{ vertex_array });
+    }
+
+    void CommandBuffer::BindTexture(uint32_t unit, uint32_t target, uint32_t texture)
+    {
+        Append(CommandType::BindTexture, BindTextureCommand{ unit, target, texture });
+    }
+
+    void CommandBuffer::BindBufferRange(uint32_t target, uint32_t binding, uint32_t buffer, size_t offset, size_t size)
+    {
+        Append(CommandType::BindBufferRange, BindBufferRangeCommand{ target, binding, buffer, (uint32_t)offset, (uint32_t)size });
+    }
+
+    void CommandBuffer::SetUniform(int32_t location, UniformType type, const void* values, uint16_t count)
+    {
+        size_t value_bytes = uniform_bytes(type, count);
+        uint8_t* payload = (uint8_t*)Append(CommandType::SetUniform, sizeof(SetUniformCommand) + value_bytes);
+        if (!payload)
+            return;
+        SetUniformCommand command{ location, type, count };
+        std::memcpy(payload, &command, sizeof(command));
+        std::memcpy(payload + sizeof(command), values, value_bytes);
+    }
+
+    void CommandBuffer::DrawElements(uint32_t mode, uint32_t count, uint32_t index_type, size_t index_offset, int32_t base_vertex, uint32_t instance_count)
+    {
+        Append(CommandType::DrawElements, DrawElementsCommand{ mode, count, index_type, (uint32_t)index_offset, base_vertex, instance_count });
+    }
+
+    void CommandBuffer::Clear(uint32_t mask, const glm::vec4& color)
+    {
+        Append(CommandType::Clear, ClearCommand{ color, mask });
+    }
+
+    void CommandBuffer::Viewport(int32_t x, int32_t y, int32_t width, int32_t height)
+    {
+        Append(CommandType::Viewport, ViewportCommand{ x, y, width, height });
+    }
+
+    // ===============
+    // PRIVATE
+    // ===============
+    void* CommandBuffer::Append(CommandType type, size_t payload_bytes)
+    {
+        size_t size = align_up(sizeof(CommandHeader) + payload_bytes, kCommandAlignment);
+        if (size > 0xffff || size > kBlockBytes)
+        {
+            std::cerr << "ERROR::COMMAND_BUFFER::COMMAND_TOO_LARGE" << std::endl;
+            return nullptr;
+        }
+
+        // Commands never straddle blocks, a full block is left with its unused tail
+        if (blocks_.empty() || blocks_[current_].used + size > kBlockBytes)
+        {
+            if (!blocks_.empty())
+                ++current_;
+            if (current_ == blocks_.size())
+            {
+                blocks_.emplace_back();
+                blocks_.back().data.reset(new uint8_t[kBlockBytes]);
+            }
+        }
+
+        Block& block = blocks_[current_];
+        uint8_t* at = block.data.get() + block.used;
+        CommandHeader header{ type, (uint16_t)size };
+        std::memcpy(at, &header, sizeof(header));
+        block.used += size;
+        ++commands_;
+        bytes_ += size;
+        return at + sizeof(CommandHeader);
+    }
+
+    // ====================
+    //     GL BACKEND
+    // ====================
+    void GLCommandExecutor::Invalidate()
+    {
+        program_ = 0xffffffffu;
+        vertex_array_ = 0xffffffffu;
+        for (auto& unit : textures_)
+            for (uint32_t& texture : unit)
+                texture = 0xffffffffu;
+    }
+
+    int GLCommandExecutor::TargetSlot(uint32_t target)
+    {
+        switch (target)
+        {
+        case GL_TEXTURE_2D:       return 0;
+        case GL_TEXTURE_CUBE_MAP: return 1;
+        case GL_TEXTURE_2D_ARRAY: return 2;
+        case GL_TEXTURE_3D:       return 3;
+        default:                  return -1;
+        }
+    }
+
+    void GLCommandExecutor::Execute(const CommandBuffer& commands)
+    {
+        bool unit_changed = false;
+        commands.ForEach([this, &unit_changed](const CommandHeader& header, const void* payload) {
+            ++stats_.commands;
+            switch (header.type)
+            {
+            case CommandType::UseProgram:
+            {
+                const UseProgramCommand& command = *(const UseProgramCommand*)payload;
+                if (command.program == program_)
+                {
+                    ++stats_.redundant;
+                    break;
+                }
+                glUseProgram(command.program);
+                program_ = command.program;
+                break;
+            }
+            case CommandType::BindVertexArray:
+            {
+                const BindVertexArrayCommand& command = *(const BindVertexArrayCommand*)payload;
+                if (command.vertex_array == vertex_array_)
+                {
+                    ++stats_.redundant;
+                    break;
+                }
+                glBindVertexArray(command.vertex_array);
+                vertex_array_ = command.vertex_array;
+                break;
+            }
+            case CommandType::BindTexture:
+            {
+                const BindTextureCommand& command = *(const BindTextureCommand*)payload;
+                // Each target of a unit is a binding of its own
+                int slot = TargetSlot(command.target);
+                uint32_t* tracked = command.unit < kTrackedUnits && slot >= 0 ? &textures_[command.unit][slot] : nullptr;
+                if (tracked && *tracked == command.texture)
+                {
+                    ++stats_.redundant;
+                    break;
+                }
+                glActiveTexture(GL_TEXTURE0 + command.unit);
+                glBindTexture(command.target, command.texture);
+                unit_changed = true;
+                if (tracked)
+                    *tracked = command.texture;
+                break;
+            }
+            case CommandType::BindBufferRange:
+            {
+                const BindBufferRangeCommand& command = *(const BindBufferRangeCommand*)payload;
+                glBindBufferRange(command.target, command.binding, command.buffer, command.offset, command.size);
+                break;
+            }
+            case CommandType::SetUniform:
+            {
+                const SetUniformCommand& command = *(const SetUniformCommand*)payload;
+                const void* values = (const uint8_t*)payload + sizeof(SetUniformCommand);
+                switch (command.type)
+                {
+                case UniformType::Int:   glUniform1iv(command.location, command.count, (const GLint*)values); break;
+                case UniformType::Float: glUniform1fv(command.location, command.count, (const GLfloat*)values); break;
+                case UniformType::Vec2:  glUniform2fv(command.location, command.count, (const GLfloat*)values); break;
+                case UniformType::Vec3:  glUniform3fv(command.location, command.count, (const GLfloat*)values); break;
+                case UniformType::Vec4:  glUniform4fv(command.location, command.count, (const GLfloat*)values); break;
+                case UniformType::Mat4:  glUniformMatrix4fv(command.location, command.count, GL_FALSE, (const GLfloat*)values); break;
+                }
+                break;
+            }
+            case CommandType::DrawElements:
+            {
+                const DrawElementsCommand& command = *(const DrawElementsCommand*)payload;
+                if (command.instance_count == 1)
+                    glDrawElementsBaseVertex(command.mode, command.count, command.index_type, (GLvoid*)(size_t)command.index_offset, command.base_vertex);
+                else
+                    glDrawElementsInstancedBaseVertex(command.mode, command.count, command.index_type, (GLvoid*)(size_t)command.index_offset,
+                        command.instance_count, command.base_vertex);
+                ++stats_.draws;
+                break;
+            }
+            case CommandType::Clear:
+            {
+                const ClearCommand& command = *(const ClearCommand*)payload;
+                glClearColor(command.color.x, command.color.y, command.color.z, command.color.w);
+                glClear(command.mask);
+                break;
+            }
+            case CommandType::Viewport:
+            {
+                const ViewportCommand& command = *(const ViewportCommand*)payload;
+                glViewport(command.x, command.y, command.width, command.height);
+                break;
+            }
+            }
+        });
+
+        // Code after the replay binds textures without selecting a unit, leave the default one active
+        if (unit_changed)
+            glActiveTexture(GL_TEXTURE0);
+    }
+}
@@ -0,0 +1,216 @@
+#ifndef _COMMAND_BUFFER_H
+#define _COMMAND_BUFFER_H
+
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Utility::render
+{
+    // ====================
+    //      COMMANDS
+    // ====================
+    // Plain data with API neutral values; handles, enums and uniform locations are the backend's
+    // numbers, resolved on the render thread before recording starts.
+    enum class CommandType : uint16_t
+    {
+        UseProgram,
+        BindVertexArray,
+        BindTexture,
+        BindBufferRange,
+        SetUniform,
+        DrawElements,
+        Clear,
+        Viewport
+    };
+
+    enum class UniformType : uint16_t
+    {
+        Int,
+        Float,
+        Vec2,
+        Vec3,
+        Vec4,
+        Mat4
+    };
+
+    struct CommandHeader
+    {
+        CommandType type;
+        uint16_t size;            // bytes of header and payload, the next command starts after it
+    };
+
+    struct UseProgramCommand
+    {
+        uint32_t program;
+    };
+
+    struct BindVertexArrayCommand
+    {
+        uint32_t vertex_array;
+    };
+
+    struct BindTextureCommand
+    {
+        uint32_t unit;
+        uint32_t target;
+        uint32_t texture;
+    };
+
+    struct BindBufferRangeCommand
+    {
+        uint32_t target;          // uniform or shader storage buffer
+        uint32_t binding;
+        uint32_t buffer;
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    // count values of type follow the command
+    struct SetUniformCommand
+    {
+        int32_t location;
+        UniformType type;
+        uint16_t count;
+    };
+
+    struct DrawElementsCommand
+    {
+        uint32_t mode;
+        uint32_t count;
+        uint32_t index_type;
+        uint32_t index_offset;    // bytes
+        int32_t base_vertex;
+        uint32_t instance_count;
+    };
+
+    struct ClearCommand
+    {
+        glm::vec4 color;
+        uint32_t mask;
+    };
+
+    struct ViewportCommand
+    {
+        int32_t x, y, width, height;
+    };
+
+    // ====================
+    //   COMMAND BUFFER
+    // ====================
+    // Commands appended to a linear arena of fixed size blocks; Reset rewinds it and keeps the blocks,
+    // so a buffer that is recorded every frame stops allocating after the first one. A buffer is
+    // recorded by one thread at a time and read by the backend once recording is done; several
+    // buffers recorded on different threads are replayed in the order the render thread chooses.
+    class CommandBuffer
+    {
+    public:
+        static const size_t kBlockBytes = 64 * 1024;
+
+        void Reset();
+
+        void UseProgram(uint32_t program);
+        void BindVertexArray(uint32_t vertex_array);
+        void BindTexture(uint32_t unit, uint32_t target, uint32_t texture);
+        void BindBufferRange(uint32_t target, uint32_t binding, uint32_t buffer, size_t offset, size_t size);
+        void SetUniform(int32_t location, UniformType type, const void* values, uint16_t count = 1);
+        void SetUniform(int32_t location, int value) { SetUniform(location, UniformType::Int, &value); }
+        void SetUniform(int32_t location, float value) { SetUniform(location, UniformType::Float, &value); }
+        void SetUniform(int32_t location, const glm::vec2& value) { SetUniform(location, UniformType::Vec2, &value); }
+        void SetUniform(int32_t location, const glm::vec3& value) { SetUniform(location, UniformType::Vec3, &value); }
+        void SetUniform(int32_t location, const glm::vec4& value) { SetUniform(location, UniformType::Vec4, &value); }
+        void SetUniform(int32_t location, const glm::mat4& value) { SetUniform(location, UniformType::Mat4, &value); }
+        void DrawElements(uint32_t mode, uint32_t count, uint32_t index_type, size_t index_offset, int32_t base_vertex = 0, uint32_t instance_count = 1);
+        void Clear(uint32_t mask, const glm::vec4& color);
+        void Viewport(int32_t x, int32_t y, int32_t width, int32_t height);
+
+        size_t CommandCount() const { return commands_; }
+        // Bytes recorded, headers included
+        size_t Bytes() const { return bytes_; }
+        // Bytes reserved by the arena
+        size_t Capacity() const { return blocks_.size() * kBlockBytes; }
+
+        // Visits the commands in recording order: fn(const CommandHeader&, const void* payload)
+        template <typename Fn> void ForEach(Fn&& fn) const
+        {
+            for (size_t b = 0; b <= current_ && b < blocks_.size(); ++b)
+            {
+                const uint8_t* cursor = blocks_[b].data.get();
+                const uint8_t* end = cursor + blocks_[b].used;
+                while (cursor < end)
+                {
+                    const CommandHeader* header = reinterpret_cast<const CommandHeader*>(cursor);
+                    fn(*header, cursor + sizeof(CommandHeader));
+                    cursor += header->size;
+                }
+            }
+        }
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<uint8_t[]> data;
+            size_t used = 0;
+        };
+
+        // Room for the header and payload_bytes in the current block, 8 byte aligned
+        void* Append(CommandType type, size_t payload_bytes);
+
+        template <typename T> void Append(CommandType type, const T& payload)
+        {
+            std::memcpy(Append(type, sizeof(T)), &payload, sizeof(T));
+        }
+
+    private:
+        std::vector<Block> blocks_;
+        size_t current_ = 0;
+        size_t commands_ = 0;
+        size_t bytes_ = 0;
+    };
+
+    // Size of count values of a uniform type
+    size_t uniform_bytes(UniformType type, size_t count);
+
+    // ====================
+    //     GL BACKEND
+    // ====================
+    struct ReplayStats
+    {
+        size_t commands = 0;
+        size_t draws = 0;
+        size_t redundant = 0;     // program, vertex array and texture binds skipped as already bound
+    };
+
+    // Executes command buffers on the thread that owns the GL context. Program, vertex array and
+    // texture bindings are tracked to drop redundant binds across buffers recorded independently;
+    // textures per unit and target. The active texture unit is back on GL_TEXTURE0 after Execute.
+    class GLCommandExecutor
+    {
+    public:
+        GLCommandExecutor() { Invalidate(); }
+
+        // Forgets the tracked state; call when GL state was changed outside the executor
+        void Invalidate();
+        void Execute(const CommandBuffer& commands);
+
+        const ReplayStats& Stats() const { return stats_; }
+        void ResetStats() { stats_ = ReplayStats(); }
+
+    private:
+        static const uint32_t kTrackedUnits = 16;
+        static const int kTrackedTargets = 4;
+
+        // Column of textures_ for the target, -1 for targets that are not tracked
+        static int TargetSlot(uint32_t target);
+
+        uint32_t program_ = 0xffffffffu;
+        uint32_t vertex_array_ = 0xffffffffu;
+        uint32_t textures_[kTrackedUnits][kTrackedTargets];
+        ReplayStats stats_;
+    };
+}
+
+#endif // !_COMMAND_BUFFER_H
@@ -0,0 +1,325 @@
+#include "deferred_shading.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace Utility::render
+{
+    using namespace Utility::literals;
+
+    namespace
+    {
+        // The unit sphere of the mesh library has radius 0.5 and 32 x 16 segments; its faces come
+        // as close as radius * cos(pi / 32) * cos(pi / 16) to the center, so volumes are scaled up
+        // to still enclose the light's radius
+        float light_volume_scale()
+        {
+            const float pi = 3.14159265f;
+            return 2.0f / (std::cos(pi / 32.0f) * std::cos(pi / 16.0f));
+        }
+
+        GLuint create_target(GLenum internal_format, GLenum format, GLenum type, int width, int height)
+        {
+            GLuint texture;
+            glGenTextures(1, &texture);
+            glBindTexture(GL_TEXTURE_2D, texture);
+            glTexImage2D(GL_TEXTURE_2D, 0, internal_format, width, height, 0, format, type, nullptr);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glBindTexture(GL_TEXTURE_2D, 0);
+            return texture;
+        }
+    }
+
+    std::ostream& operator<<(std::ostream& os, const GBufferFootprint& footprint)
+    {
+        double pixels = (double)footprint.width * footprint.height;
+        os << footprint.width << "x" << footprint.height << ": " << footprint.bytes_per_pixel << " B/pixel, "
+           << footprint.target_bytes / (1024.0 * 1024.0) << " MB of targets";
+        if (footprint.geometry_fragments || footprint.lighting_fragments)
+        {
+            os << ", geometry " << footprint.geometry_fragments / pixels << " fragments/pixel (" << footprint.GeometryBytes() / (1024.0 * 1024.0)
+               << " MB written), lighting " << footprint.lighting_fragments / pixels << " fragments/pixel ("
+               << footprint.LightingBytes() / (1024.0 * 1024.0) << " MB read)";
+        }
+        return os;
+    }
+
+    // ====================
+    //      G-BUFFER
+    // ====================
+    const size_t GBuffer::kBytesPerPixel;
+    const size_t GBuffer::kWideBytesPerPixel;
+    const float GBuffer::kMaxShininess = 256.0f;
+
+    GBuffer::~GBuffer()
+    {
+        Release();
+    }
+
+    bool GBuffer::Create(int width, int height)
+    {
+        Release();
+        width_ = std::max(width, 1);
+        height_ = std::max(height, 1);
+
+        albedo_ = create_target(GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, width_, height_);
+        normal_ = create_target(GL_RGB10_A2, GL_RGBA, GL_UNSIGNED_INT_2_10_10_10_REV, width_, height_);
+        depth_ = create_target(GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, width_, height_);
+
+        glGenFramebuffers(1, &framebuffer_);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, albedo_, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, normal_, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, depth_, 0);
+        const GLenum draw_buffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+        glDrawBuffers(2, draw_buffers);
+        bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        if (!complete)
+        {
+            std::cerr << "ERROR::GBUFFER::FRAMEBUFFER_INCOMPLETE" << std::endl;
+            Release();
+        }
+        return complete;
+    }
+
+    void GBuffer::Release()
+    {
+        if (framebuffer_)
+            glDeleteFramebuffers(1, &framebuffer_);
+        GLuint textures[3] = { albedo_, normal_, depth_ };
+        for (GLuint texture : textures)
+        {
+            if (texture)
+                glDeleteTextures(1, &texture);
+        }
+        framebuffer_ = albedo_ = normal_ = depth_ = 0;
+    }
+
+    void GBuffer::Bind() const
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+        glViewport(0, 0, width_, height_);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    }
+
+    GBufferFootprint GBuffer::Footprint(int width, int height, size_t bytes_per_pixel)
+    {
+        GBufferFootprint footprint;
+        footprint.width = width;
+        footprint.height = height;
+        footprint.bytes_per_pixel = bytes_per_pixel;
+        footprint.target_bytes = (size_t)width * height * bytes_per_pixel;
+        return footprint;
+    }
+
+    // ====================
+    //      RENDERER
+    // ====================
+    DeferredRenderer::DeferredRenderer()
+        : ambient_shader_("tutorials\\shaders\\fullscreen_vs.glsl", "tutorials\\shaders\\deferred_ambient_fs.glsl"),
+          light_shader_("tutorials\\shaders\\deferred_light_vs.glsl", "tutorials\\shaders\\deferred_light_fs.glsl"),
+          present_shader_("tutorials\\shaders\\fullscreen_vs.glsl", "tutorials\\shaders\\fullscreen_texture_fs.glsl")
+    {
+        sphere_ = volumes_.Get(Utility::mesh::Primitive::Sphere, Utility::mesh::Position);
+
+        // The lights are instanced attributes of the sphere: position and radius, then color
+        glGenBuffers(1, &light_buffer_);
+        glBindVertexArray(sphere_.vao);
+        glBindBuffer(GL_ARRAY_BUFFER, light_buffer_);
+        glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(GpuPointLight), (GLvoid*)0);
+        glVertexAttribDivisor(3, 1);
+        glEnableVertexAttribArray(3);
+        glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(GpuPointLight), (GLvoid*)(4 * sizeof(float)));
+        glVertexAttribDivisor(4, 1);
+        glEnableVertexAttribArray(4);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindVertexArray(0);
+
+        glGenVertexArrays(1, &screen_vao_);
+        glGenQueries(4, &queries_[0][0]);
+    }
+
+    DeferredRenderer::~DeferredRenderer()
+    {
+        Release();
+        glDeleteBuffers(1, &light_buffer_);
+        glDeleteVertexArrays(1, &screen_vao_);
+        glDeleteQueries(4, &queries_[0][0]);
+    }
+
+    bool DeferredRenderer::Create(int width, int height)
+    {
+        Release();
+        if (!gbuffer_.Create(width, height))
+            return false;
+
+        light_color_ = create_target(GL_RGBA16F, GL_RGBA, GL_FLOAT, gbuffer_.Width(), gbuffer_.Height());
+        glGenRenderbuffers(1, &light_depth_);
+        glBindRenderbuffer(GL_RENDERBUFFER, light_depth_);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, gbuffer_.Width(), gbuffer_.Height());
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        glGenFramebuffers(1, &light_framebuffer_);
+        glBindFramebuffer(GL_FRAMEBUFFER, light_framebuffer_);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, light_color_, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, light_depth_);
+        bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        if (!complete)
+        {
+            std::cerr << "ERROR::DEFERRED_RENDERER::FRAMEBUFFER_INCOMPLETE" << std::endl;
+            Release();
+        }
+        return complete;
+    }
+
+    void DeferredRenderer::Release()
+    {
+        gbuffer_.Release();
+        if (light_framebuffer_)
+            glDeleteFramebuffers(1, &light_framebuffer_);
+        if (light_color_)
+            glDeleteTextures(1, &light_color_);
+        if (light_depth_)
+            glDeleteRenderbuffers(1, &light_depth_);
+        light_framebuffer_ = light_color_ = light_depth_ = 0;
+    }
+
+    void DeferredRenderer::BeginGeometry()
+    {
+        ReadQueries();
+        gbuffer_.Bind();
+        glEnable(GL_DEPTH_TEST);
+        glBeginQuery(GL_SAMPLES_PASSED, queries_[frame_ % 2][0]);
+    }
+
+    void DeferredRenderer::EndGeometry()
+    {
+        glEndQuery(GL_SAMPLES_PASSED);
+    }
+
+    void DeferredRenderer::Light(const GpuPointLight* lights, size_t count, const glm::mat4& view_matrix, const glm::mat4& projection_matrix,
+        const glm::vec3& camera_position, const glm::vec3& ambient_color)
+    {
+        int width = gbuffer_.Width(), height = gbuffer_.Height();
+
+        // The volumes are depth tested against the scene, which cannot be sampled and attached at
+        // the same time: the lighting target gets a copy of the depth
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, gbuffer_.Framebuffer());
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, light_framebuffer_);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_FRAMEBUFFER, light_framebuffer_);
+        glViewport(0, 0, width, height);
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, gbuffer_.AlbedoTexture());
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, gbuffer_.NormalTexture());
+        glActiveTexture(GL_TEXTURE2);
+        glBindTexture(GL_TEXTURE_2D, gbuffer_.DepthTexture());
+        glActiveTexture(GL_TEXTURE0);
+
+        // Ambient term over the whole screen
+        glDisable(GL_DEPTH_TEST);
+        glDepthMask(GL_FALSE);
+        ambient_shader_.use();
+        ambient_shader_.setInt("albedo_map"_id, 0);
+        ambient_shader_.setVec3("ambient_color"_id, ambient_color);
+        glBindVertexArray(screen_vao_);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+
+        // Light volumes, added on top
+        glBindBuffer(GL_ARRAY_BUFFER, light_buffer_);
+        if (count * sizeof(GpuPointLight) > light_capacity_)
+            light_capacity_ = std::max(count * sizeof(GpuPointLight), light_capacity_ * 2);
+        glBufferData(GL_ARRAY_BUFFER, std::max<size_t>(light_capacity_, sizeof(GpuPointLight)), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(GpuPointLight), lights);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        glEnable(GL_DEPTH_TEST);
+        glDepthFunc(GL_GEQUAL);
+        glEnable(GL_CULL_FACE);
+        glCullFace(GL_FRONT);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ONE);
+
+        glm::mat4 view_projection = projection_matrix * view_matrix;
+        light_shader_.use();
+        light_shader_.setMat4("view_projection"_id, view_projection);
+        light_shader_.setMat4("inverse_view_projection"_id, glm::inverse(view_projection));
+        light_shader_.setVec3("camera_position"_id, camera_position);
+        light_shader_.setVec2("screen_size"_id, glm::vec2((float)width, (float)height));
+        light_shader_.setFloat("volume_scale"_id, light_volume_scale());
+        light_shader_.setFloat("max_shininess"_id, GBuffer::kMaxShininess);
+        light_shader_.setInt("albedo_map"_id, 0);
+        light_shader_.setInt("normal_map"_id, 1);
+        light_shader_.setInt("depth_map"_id, 2);
+        glBeginQuery(GL_SAMPLES_PASSED, queries_[frame_ % 2][1]);
+        if (count)
+            volumes_.DrawInstanced(sphere_, (GLsizei)count);
+        glEndQuery(GL_SAMPLES_PASSED);
+        query_pending_[frame_ % 2] = true;
+        ++frame_;
+
+        glDisable(GL_BLEND);
+        glDisable(GL_CULL_FACE);
+        glCullFace(GL_BACK);
+        glDepthFunc(GL_LESS);
+        glDepthMask(GL_TRUE);
+        glBindVertexArray(0);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    void DeferredRenderer::Present(int framebuffer_width, int framebuffer_height)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(0, 0, framebuffer_width, framebuffer_height);
+        glDisable(GL_DEPTH_TEST);
+        present_shader_.use();
+        present_shader_.setInt("screen_texture"_id, 0);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, light_color_);
+        glBindVertexArray(screen_vao_);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glBindVertexArray(0);
+        glEnable(GL_DEPTH_TEST);
+    }
+
+    GBufferFootprint DeferredRenderer::Footprint() const
+    {
+        GBufferFootprint footprint = GBuffer::Footprint(gbuffer_.Width(), gbuffer_.Height());
+        footprint.geometry_fragments = geometry_fragments_;
+        footprint.lighting_fragments = lighting_fragments_;
+        return footprint;
+    }
+
+    // ===============
+    // PRIVATE
+    // ===============
+    void DeferredRenderer::ReadQueries()
+    {
+        // The queries of this slot were issued two frames ago; if the GPU is still behind the
+        // result is skipped rather than waited for
+        unsigned int slot = frame_ % 2;
+        if (!query_pending_[slot])
+            return;
+        query_pending_[slot] = false;
+
+        GLuint available = 0;
+        glGetQueryObjectuiv(queries_[slot][1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            return;
+        GLuint geometry = 0, lighting = 0;
+        glGetQueryObjectuiv(queries_[slot][0], GL_QUERY_RESULT, &geometry);
+        glGetQueryObjectuiv(queries_[slot][1], GL_QUERY_RESULT, &lighting);
+        geometry_fragments_ = geometry;
+        lighting_fragments_ = lighting;
+    }
+}
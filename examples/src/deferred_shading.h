@@ -0,0 +1,131 @@
+#ifndef _DEFERRED_SHADING_H
+#define _DEFERRED_SHADING_H
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "ShaderProgram.h"
+#include "mesh_library.h"
+#include "clustered_lighting.h"
+#include <ostream>
+#include <cstddef>
+
+namespace Utility::render
+{
+    // Size of a G-buffer and the traffic of one frame through it
+    struct GBufferFootprint
+    {
+        int width = 0;
+        int height = 0;
+        size_t bytes_per_pixel = 0;         // written by the geometry pass, read back per lit fragment
+        size_t target_bytes = 0;            // every target at this resolution
+        size_t geometry_fragments = 0;      // measured, overdraw included
+        size_t lighting_fragments = 0;      // measured, one per light volume fragment that passed the depth test
+
+        double GeometryBytes() const { return (double)geometry_fragments * bytes_per_pixel; }
+        double LightingBytes() const { return (double)lighting_fragments * bytes_per_pixel; }
+    };
+
+    std::ostream& operator<<(std::ostream& os, const GBufferFootprint& footprint);
+
+    // Targets of the deferred path, 12 bytes per pixel:
+    //   0: RGBA8    albedo, specular intensity
+    //   1: RGB10_A2 octahedral normal (xy), shininess / kMaxShininess (z)
+    //   depth: DEPTH24_STENCIL8, the position is reconstructed from it
+    // The usual layout with an RGBA16F position and RGBA16F normal next to the same albedo and
+    // depth takes kWideBytesPerPixel.
+    class GBuffer
+    {
+    public:
+        static const size_t kBytesPerPixel = 12;
+        static const size_t kWideBytesPerPixel = 24;
+        static const float kMaxShininess;
+
+        GBuffer() = default;
+        ~GBuffer();
+
+        GBuffer(const GBuffer&) = delete;
+        GBuffer& operator=(const GBuffer&) = delete;
+
+        bool Create(int width, int height);
+        void Release();
+
+        // Binds the framebuffer with both color targets, sets the viewport and clears
+        void Bind() const;
+
+        static GBufferFootprint Footprint(int width, int height, size_t bytes_per_pixel = kBytesPerPixel);
+
+        GLuint Framebuffer() const { return framebuffer_; }
+        GLuint AlbedoTexture() const { return albedo_; }
+        GLuint NormalTexture() const { return normal_; }
+        GLuint DepthTexture() const { return depth_; }
+        int Width() const { return width_; }
+        int Height() const { return height_; }
+
+    private:
+        GLuint framebuffer_ = 0;
+        GLuint albedo_ = 0;
+        GLuint normal_ = 0;
+        GLuint depth_ = 0;
+        int width_ = 0;
+        int height_ = 0;
+    };
+
+    // Deferred shading on top of a GBuffer. The scene fills the G-buffer between BeginGeometry and
+    // EndGeometry with a shader that writes its layout (deferred_geometry_fs.glsl). Light() then
+    // adds an ambient full screen pass and draws every point light as an instanced sphere around
+    // its radius: back faces with a greater-or-equal depth test against the scene depth, so only
+    // pixels in front of the volume's far side run the lighting shader, with additive blending into
+    // an RGBA16F target. Lighting cost follows the lit pixels times the lights covering them, not
+    // the objects times the lights. Present() copies the result to the default framebuffer.
+    //
+    // Fragments of both passes are counted with GL_SAMPLES_PASSED queries that are read a frame
+    // late, so Footprint() never stalls.
+    class DeferredRenderer
+    {
+    public:
+        DeferredRenderer();
+        ~DeferredRenderer();
+
+        DeferredRenderer(const DeferredRenderer&) = delete;
+        DeferredRenderer& operator=(const DeferredRenderer&) = delete;
+
+        bool Create(int width, int height);
+        void Release();
+
+        void BeginGeometry();
+        void EndGeometry();
+        void Light(const GpuPointLight* lights, size_t count, const glm::mat4& view_matrix, const glm::mat4& projection_matrix,
+            const glm::vec3& camera_position, const glm::vec3& ambient_color);
+        void Present(int framebuffer_width, int framebuffer_height);
+
+        const GBuffer& Targets() const { return gbuffer_; }
+        // Target sizes with the fragment counts of the latest frame whose queries finished
+        GBufferFootprint Footprint() const;
+
+    private:
+        void ReadQueries();
+
+    private:
+        ShaderProgram ambient_shader_;
+        ShaderProgram light_shader_;
+        ShaderProgram present_shader_;
+        Utility::mesh::MeshLibrary volumes_;
+        Utility::mesh::MeshHandle sphere_;
+
+        GBuffer gbuffer_;
+        GLuint light_framebuffer_ = 0;
+        GLuint light_color_ = 0;
+        GLuint light_depth_ = 0;            // copy of the scene depth the volumes are tested against
+        GLuint light_buffer_ = 0;           // GpuPointLight per instance
+        size_t light_capacity_ = 0;
+        GLuint screen_vao_ = 0;
+
+        GLuint queries_[2][2] = {};         // [frame % 2][geometry, lighting]
+        bool query_pending_[2] = {};
+        unsigned int frame_ = 0;
+        size_t geometry_fragments_ = 0;
+        size_t lighting_fragments_ = 0;
+    };
+}
+
+#endif // !_DEFERRED_SHADING_H
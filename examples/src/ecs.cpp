@@ -0,0 +1,394 @@
+#include "ecs.h"
+#include "job_system.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <thread>
+
+namespace Utility::ecs
+{
+    namespace
+    {
+        struct ComponentType
+        {
+            size_t size;
+            void (*construct)(void* memory);
+        };
+
+        template <typename T>
+        void construct(void* memory)
+        {
+            new (memory) T();
+        }
+
+        // In ComponentIndex order
+        const ComponentType kComponentTypes[kComponentCount] = {
+            { sizeof(Transform), construct<Transform> },
+            { sizeof(MeshRef), construct<MeshRef> },
+            { sizeof(MaterialRef), construct<MaterialRef> },
+            { sizeof(Bounds), construct<Bounds> },
+            { sizeof(Light), construct<Light> }
+        };
+
+        size_t align16(size_t offset)
+        {
+            return (offset + 15) & ~size_t(15);
+        }
+
+        // Largest entity count whose 16 byte aligned arrays fit in a chunk
+        void layout(Archetype& archetype)
+        {
+            size_t row_bytes = sizeof(Entity);
+            for (unsigned int c = 0; c < kComponentCount; ++c)
+            {
+                if (archetype.mask & (1u << c))
+                    row_bytes += kComponentTypes[c].size;
+            }
+
+            for (size_t capacity = Chunk::kBytes / row_bytes; capacity > 0; --capacity)
+            {
+                size_t offset = align16(capacity * sizeof(Entity));
+                for (unsigned int c = 0; c < kComponentCount; ++c)
+                {
+                    archetype.offsets[c] = 0;
+                    if (archetype.mask & (1u << c))
+                    {
+                        archetype.offsets[c] = (uint32_t)offset;
+                        offset = align16(offset + capacity * kComponentTypes[c].size);
+                    }
+                }
+                if (offset <= Chunk::kBytes)
+                {
+                    archetype.capacity = (uint32_t)capacity;
+                    return;
+                }
+            }
+        }
+
+        unsigned int resolve_threads(unsigned int threads)
+        {
+            return threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        void update_chunk_transforms(Chunk& chunk)
+        {
+            Transform* transforms = chunk.Get<Transform>();
+            for (size_t i = 0; i < chunk.Size(); ++i)
+            {
+                Transform& t = transforms[i];
+                glm::mat4 m = glm::mat4_cast(t.rotation);
+                m[0] *= t.scale.x;
+                m[1] *= t.scale.y;
+                m[2] *= t.scale.z;
+                m[3] = glm::vec4(t.position, 1.0f);
+                t.world = m;
+            }
+        }
+
+        void extract_chunk_draws(const Chunk& chunk, const Frustum& frustum, std::vector<DrawItem>& items)
+        {
+            const Transform* transforms = chunk.Get<Transform>();
+            const MeshRef* meshes = chunk.Get<MeshRef>();
+            const MaterialRef* materials = chunk.Get<MaterialRef>();
+            const Bounds* bounds = chunk.Get<Bounds>();
+
+            for (size_t i = 0; i < chunk.Size(); ++i)
+            {
+                const glm::mat4& model = transforms[i].world;
+                if (bounds)
+                {
+                    glm::vec3 center = glm::vec3(model * glm::vec4(bounds[i].center, 1.0f));
+                    float scale = std::max(glm::length(glm::vec3(model[0])), std::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+                    if (!frustum.IntersectsSphere(center, bounds[i].radius * scale))
+                        continue;
+                }
+                items.push_back({ model, meshes[i].mesh, materials[i].material });
+            }
+        }
+
+        void prepare_draw_list(DrawList& list, unsigned int workers)
+        {
+            if (list.workers.size() < workers)
+                list.workers.resize(workers);
+            for (std::vector<DrawItem>& items : list.workers)
+                items.clear();
+        }
+
+        // Workers took contiguous runs of chunks, so appending in worker order keeps the chunk order
+        size_t merge_draw_list(DrawList& list)
+        {
+            list.items.clear();
+            for (const std::vector<DrawItem>& items : list.workers)
+                list.items.insert(list.items.end(), items.begin(), items.end());
+            return list.items.size();
+        }
+    }
+
+    // ====================
+    //      CHUNK
+    // ====================
+    size_t Chunk::Capacity() const
+    {
+        return archetype_->capacity;
+    }
+
+    ComponentMask Chunk::Components() const
+    {
+        return archetype_->mask;
+    }
+
+    void* Chunk::Array(unsigned int component)
+    {
+        uint32_t offset = archetype_->offsets[component];
+        return offset ? memory_.data() + offset : nullptr;
+    }
+
+    // ====================
+    //      WORLD
+    // ====================
+    Entity World::Create(ComponentMask components)
+    {
+        Entity entity;
+        if (!free_.empty())
+        {
+            entity.index = free_.back();
+            free_.pop_back();
+        }
+        else
+        {
+            entity.index = (uint32_t)records_.size();
+            records_.emplace_back();
+        }
+        entity.generation = records_[entity.index].generation;
+
+        Place(GetArchetype(components), entity);
+        ++size_;
+        return entity;
+    }
+
+    void World::Destroy(Entity entity)
+    {
+        if (!Alive(entity))
+            return;
+
+        Record& record = records_[entity.index];
+        RemoveRow(*record.chunk, record.row);
+        record.chunk = nullptr;
+        ++record.generation;
+        free_.push_back(entity.index);
+        --size_;
+    }
+
+    bool World::Alive(Entity entity) const
+    {
+        return entity.index < records_.size() && records_[entity.index].chunk && records_[entity.index].generation == entity.generation;
+    }
+
+    void World::Clear()
+    {
+        archetypes_.clear();
+
+        // Every index goes back on the free list with its generation bumped, so handles from
+        // before the clear stay dead instead of naming the entities created after it
+        free_.clear();
+        for (size_t index = records_.size(); index-- > 0;)
+        {
+            Record& record = records_[index];
+            if (record.chunk)
+            {
+                record.chunk = nullptr;
+                ++record.generation;
+            }
+            free_.push_back((uint32_t)index);
+        }
+        size_ = 0;
+    }
+
+    void World::Add(Entity entity, ComponentMask components)
+    {
+        if (Alive(entity))
+            Move(entity, Components(entity) | components);
+    }
+
+    void World::Remove(Entity entity, ComponentMask components)
+    {
+        if (Alive(entity))
+            Move(entity, Components(entity) & ~components);
+    }
+
+    ComponentMask World::Components(Entity entity) const
+    {
+        return Alive(entity) ? records_[entity.index].chunk->Components() : 0;
+    }
+
+    size_t World::ChunkCount() const
+    {
+        size_t count = 0;
+        for (const std::unique_ptr<Archetype>& archetype : archetypes_)
+            count += archetype->chunks.size();
+        return count;
+    }
+
+    void World::ForEachChunkParallel(ComponentMask required, const std::function<void(Chunk&, unsigned int)>& fn, unsigned int threads)
+    {
+        query_.clear();
+        ForEachChunk(required, [this](Chunk& chunk) { query_.push_back(&chunk); });
+
+        // Chunks are close to full, so equal chunk counts are close to equal work
+        threads = (unsigned int)std::max<size_t>(1, std::min<size_t>(resolve_threads(threads), query_.size()));
+        auto work = [this, &fn, threads](unsigned int t) {
+            size_t begin = query_.size() * t / threads, end = query_.size() * (t + 1) / threads;
+            for (size_t c = begin; c < end; ++c)
+                fn(*query_[c], t);
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned int t = 1; t < threads; ++t)
+            workers.emplace_back(work, t);
+        work(0);
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+
+    void World::ForEachChunkParallel(ComponentMask required, const std::function<void(Chunk&, unsigned int)>& fn, JobSystem& jobs)
+    {
+        query_.clear();
+        ForEachChunk(required, [this](Chunk& chunk) { query_.push_back(&chunk); });
+        jobs.ParallelFor(query_.size(), 0, [this, &fn, &jobs](size_t begin, size_t end) {
+            for (size_t c = begin; c < end; ++c)
+                fn(*query_[c], jobs.WorkerIndex());
+        });
+    }
+
+    // ===============
+    // PRIVATE
+    // ===============
+    Archetype& World::GetArchetype(ComponentMask mask)
+    {
+        for (const std::unique_ptr<Archetype>& archetype : archetypes_)
+        {
+            if (archetype->mask == mask)
+                return *archetype;
+        }
+
+        archetypes_.emplace_back(new Archetype());
+        Archetype& archetype = *archetypes_.back();
+        archetype.mask = mask;
+        layout(archetype);
+        return archetype;
+    }
+
+    void World::Place(Archetype& archetype, Entity entity)
+    {
+        if (archetype.chunks.empty() || archetype.chunks.back()->count_ == archetype.capacity)
+        {
+            archetype.chunks.emplace_back(new Chunk());
+            archetype.chunks.back()->archetype_ = &archetype;
+            archetype.chunks.back()->memory_.resize(Chunk::kBytes);
+        }
+
+        Chunk& chunk = *archetype.chunks.back();
+        uint32_t row = chunk.count_++;
+        reinterpret_cast<Entity*>(chunk.memory_.data())[row] = entity;
+        for (unsigned int c = 0; c < kComponentCount; ++c)
+        {
+            if (archetype.mask & (1u << c))
+                kComponentTypes[c].construct(static_cast<uint8_t*>(chunk.Array(c)) + row * kComponentTypes[c].size);
+        }
+
+        records_[entity.index].chunk = &chunk;
+        records_[entity.index].row = row;
+    }
+
+    void World::RemoveRow(Chunk& chunk, uint32_t row)
+    {
+        Archetype& archetype = *chunk.archetype_;
+        Chunk& last = *archetype.chunks.back();
+        uint32_t last_row = last.count_ - 1;
+
+        if (&last != &chunk || last_row != row)
+        {
+            Entity moved = last.Entities()[last_row];
+            reinterpret_cast<Entity*>(chunk.memory_.data())[row] = moved;
+            for (unsigned int c = 0; c < kComponentCount; ++c)
+            {
+                if (archetype.mask & (1u << c))
+                {
+                    size_t size = kComponentTypes[c].size;
+                    std::memcpy(static_cast<uint8_t*>(chunk.Array(c)) + row * size, static_cast<uint8_t*>(last.Array(c)) + last_row * size, size);
+                }
+            }
+            records_[moved.index].chunk = &chunk;
+            records_[moved.index].row = row;
+        }
+
+        if (--last.count_ == 0)
+            archetype.chunks.pop_back();
+    }
+
+    void World::Move(Entity entity, ComponentMask components)
+    {
+        Chunk* from = records_[entity.index].chunk;
+        uint32_t from_row = records_[entity.index].row;
+        ComponentMask shared = from->Components() & components;
+        if (from->Components() == components)
+            return;
+
+        Place(GetArchetype(components), entity);
+        Chunk* to = records_[entity.index].chunk;
+        uint32_t to_row = records_[entity.index].row;
+        for (unsigned int c = 0; c < kComponentCount; ++c)
+        {
+            if (shared & (1u << c))
+            {
+                size_t size = kComponentTypes[c].size;
+                std::memcpy(static_cast<uint8_t*>(to->Array(c)) + to_row * size, static_cast<uint8_t*>(from->Array(c)) + from_row * size, size);
+            }
+        }
+        RemoveRow(*from, from_row);
+    }
+
+    // ====================
+    //      SYSTEMS
+    // ====================
+    void update_world_transforms(World& world, unsigned int threads)
+    {
+        world.ForEachChunkParallel(TransformComponent, [](Chunk& chunk, unsigned int) { update_chunk_transforms(chunk); }, threads);
+    }
+
+    void update_world_transforms(World& world, JobSystem& jobs)
+    {
+        world.ForEachChunkParallel(TransformComponent, [](Chunk& chunk, unsigned int) { update_chunk_transforms(chunk); }, jobs);
+    }
+
+    size_t extract_draws(World& world, const Frustum& frustum, DrawList& list, unsigned int threads)
+    {
+        threads = resolve_threads(threads);
+        prepare_draw_list(list, threads);
+        world.ForEachChunkParallel(TransformComponent | MeshComponent | MaterialComponent, [&frustum, &list](Chunk& chunk, unsigned int worker) {
+            extract_chunk_draws(chunk, frustum, list.workers[worker]);
+        }, threads);
+        return merge_draw_list(list);
+    }
+
+    size_t extract_draws(World& world, const Frustum& frustum, DrawList& list, JobSystem& jobs)
+    {
+        // Stolen ranges run out of order: the items end up grouped per worker instead of in chunk order
+        prepare_draw_list(list, jobs.ThreadCount());
+        world.ForEachChunkParallel(TransformComponent | MeshComponent | MaterialComponent, [&frustum, &list](Chunk& chunk, unsigned int worker) {
+            extract_chunk_draws(chunk, frustum, list.workers[worker]);
+        }, jobs);
+        return merge_draw_list(list);
+    }
+
+    void collect_lights(World& world, std::vector<LightInstance>& lights)
+    {
+        lights.clear();
+        world.ForEachChunk(TransformComponent | LightComponent, [&lights](Chunk& chunk) {
+            const Transform* transforms = chunk.Get<Transform>();
+            const Light* sources = chunk.Get<Light>();
+            for (size_t i = 0; i < chunk.Size(); ++i)
+                lights.push_back({ glm::vec3(transforms[i].world[3]), sources[i] });
+        });
+    }
+}
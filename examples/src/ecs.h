@@ -0,0 +1,235 @@
+#ifndef _ECS_H
+#define _ECS_H
+
+#include "aligned_allocator.h"
+#include "frustum.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+namespace Utility
+{
+    class JobSystem;
+}
+
+namespace Utility::ecs
+{
+    // ====================
+    //      COMPONENTS
+    // ====================
+    // Plain data, copied with memcpy when an entity changes archetype
+    struct Transform
+    {
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::quat rotation = glm::quat();
+        glm::vec3 scale = glm::vec3(1.0f);
+        glm::mat4 world = glm::mat4(1.0f);     // written by update_world_transforms
+    };
+
+    struct MeshRef
+    {
+        uint32_t mesh = 0;                      // index into the application's mesh table
+    };
+
+    struct MaterialRef
+    {
+        uint32_t material = 0;
+    };
+
+    // Object space bounding sphere
+    struct Bounds
+    {
+        glm::vec3 center = glm::vec3(0.0f);
+        float radius = 0.0f;
+    };
+
+    struct Light
+    {
+        glm::vec3 color = glm::vec3(1.0f);
+        float intensity = 1.0f;
+        float radius = 10.0f;                   // no contribution beyond this distance
+    };
+
+    enum Component : unsigned int
+    {
+        TransformComponent = 1 << 0,
+        MeshComponent      = 1 << 1,
+        MaterialComponent  = 1 << 2,
+        BoundsComponent    = 1 << 3,
+        LightComponent     = 1 << 4
+    };
+    const unsigned int kComponentCount = 5;
+    typedef unsigned int ComponentMask;
+
+    template <typename T> struct ComponentIndex;
+    template <> struct ComponentIndex<Transform> { static const unsigned int value = 0; };
+    template <> struct ComponentIndex<MeshRef> { static const unsigned int value = 1; };
+    template <> struct ComponentIndex<MaterialRef> { static const unsigned int value = 2; };
+    template <> struct ComponentIndex<Bounds> { static const unsigned int value = 3; };
+    template <> struct ComponentIndex<Light> { static const unsigned int value = 4; };
+
+    struct Entity
+    {
+        uint32_t index = 0xffffffffu;
+        uint32_t generation = 0;                // bumped when the index is reused
+
+        bool Valid() const { return index != 0xffffffffu; }
+        bool operator==(const Entity& other) const { return index == other.index && generation == other.generation; }
+        bool operator!=(const Entity& other) const { return !(*this == other); }
+    };
+
+    // ====================
+    //      STORAGE
+    // ====================
+    struct Archetype;
+
+    // Fixed size block holding up to Capacity() entities of one archetype, with one packed array per
+    // component so a system streams through exactly the components it reads
+    class Chunk
+    {
+    public:
+        static const size_t kBytes = 16 * 1024;
+
+        size_t Size() const { return count_; }
+        size_t Capacity() const;
+        ComponentMask Components() const;
+        const Entity* Entities() const { return reinterpret_cast<const Entity*>(memory_.data()); }
+
+        // nullptr when the archetype does not have the component
+        template <typename T> T* Get() { return static_cast<T*>(Array(ComponentIndex<T>::value)); }
+        template <typename T> const T* Get() const { return static_cast<const T*>(const_cast<Chunk*>(this)->Array(ComponentIndex<T>::value)); }
+
+    private:
+        friend class World;
+
+        void* Array(unsigned int component);
+
+    private:
+        Archetype* archetype_ = nullptr;
+        std::vector<uint8_t, AlignedAllocator<uint8_t, 64>> memory_;
+        uint32_t count_ = 0;
+    };
+
+    struct Archetype
+    {
+        ComponentMask mask = 0;
+        uint32_t capacity = 0;                  // entities per chunk
+        uint32_t offsets[kComponentCount] = {}; // array offsets inside a chunk, 0 when absent (the entity ids come first)
+        std::vector<std::unique_ptr<Chunk>> chunks;  // all full but the last
+    };
+
+    // Entities grouped by their exact component set (archetype). Every archetype keeps its entities
+    // densely packed in chunks, removal moves the last entity into the hole, and changing an entity's
+    // components moves it to the matching archetype. Queries visit the chunks of every archetype that
+    // has the required components, optionally split across threads.
+    class World
+    {
+    public:
+        Entity Create(ComponentMask components);
+        void Destroy(Entity entity);
+        bool Alive(Entity entity) const;
+        void Clear();
+
+        // Moves the entity to the archetype with the components added or removed, new ones are default constructed
+        void Add(Entity entity, ComponentMask components);
+        void Remove(Entity entity, ComponentMask components);
+        ComponentMask Components(Entity entity) const;
+
+        // nullptr when the entity does not have the component; invalidated by structural changes
+        template <typename T> T* Get(Entity entity)
+        {
+            if (!Alive(entity))
+                return nullptr;
+            const Record& record = records_[entity.index];
+            T* array = record.chunk->Get<T>();
+            return array ? array + record.row : nullptr;
+        }
+
+        size_t Size() const { return size_; }
+        size_t ArchetypeCount() const { return archetypes_.size(); }
+        size_t ChunkCount() const;
+
+        // Visits every chunk whose archetype has all the required components
+        template <typename Fn> void ForEachChunk(ComponentMask required, Fn&& fn)
+        {
+            for (const std::unique_ptr<Archetype>& archetype : archetypes_)
+            {
+                if ((archetype->mask & required) != required)
+                    continue;
+                for (const std::unique_ptr<Chunk>& chunk : archetype->chunks)
+                {
+                    if (chunk->Size())
+                        fn(*chunk);
+                }
+            }
+        }
+
+        // Same, with the chunks split into contiguous runs over threads (0 uses every hardware thread).
+        // fn gets the worker index for per thread output; it must not change the world's structure.
+        void ForEachChunkParallel(ComponentMask required, const std::function<void(Chunk&, unsigned int)>& fn, unsigned int threads = 0);
+        // Same, as jobs: the worker index is JobSystem::WorkerIndex()
+        void ForEachChunkParallel(ComponentMask required, const std::function<void(Chunk&, unsigned int)>& fn, JobSystem& jobs);
+
+    private:
+        struct Record
+        {
+            Chunk* chunk = nullptr;
+            uint32_t row = 0;
+            uint32_t generation = 0;
+        };
+
+        Archetype& GetArchetype(ComponentMask mask);
+        // Appends a row for entity, its components default constructed
+        void Place(Archetype& archetype, Entity entity);
+        // Fills the row with the last entity of the archetype
+        void RemoveRow(Chunk& chunk, uint32_t row);
+        void Move(Entity entity, ComponentMask components);
+
+    private:
+        std::vector<std::unique_ptr<Archetype>> archetypes_;
+        std::vector<Record> records_;
+        std::vector<uint32_t> free_;
+        std::vector<Chunk*> query_;             // scratch for ForEachChunkParallel
+        size_t size_ = 0;
+    };
+
+    // ====================
+    //      SYSTEMS
+    // ====================
+    // world = translate * rotate * scale for every Transform
+    void update_world_transforms(World& world, unsigned int threads = 0);
+    void update_world_transforms(World& world, JobSystem& jobs);
+
+    struct DrawItem
+    {
+        glm::mat4 model;
+        uint32_t mesh;
+        uint32_t material;
+    };
+
+    // Per worker lists are reused from frame to frame, items holds the merged result
+    struct DrawList
+    {
+        std::vector<DrawItem> items;
+        std::vector<std::vector<DrawItem>> workers;
+    };
+
+    // Every entity with a Transform, MeshRef and MaterialRef whose Bounds (if it has any) intersect the
+    // frustum, in chunk order (grouped per worker with the job system). Returns the number of items.
+    size_t extract_draws(World& world, const Frustum& frustum, DrawList& list, unsigned int threads = 0);
+    size_t extract_draws(World& world, const Frustum& frustum, DrawList& list, JobSystem& jobs);
+
+    struct LightInstance
+    {
+        glm::vec3 position;
+        Light light;
+    };
+
+    // World space position of every entity with a Transform and a Light
+    void collect_lights(World& world, std::vector<LightInstance>& lights);
+}
+
+#endif // !_ECS_H
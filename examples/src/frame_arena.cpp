@@ -0,0 +1,145 @@
+#include "frame_arena.h"
+#include <algorithm>
+
+namespace Utility
+{
+    namespace
+    {
+        // Generations are unique across arenas, so a slab cached for an arena that was destroyed
+        // never matches a new one created at the same address
+        std::atomic<uint64_t> next_generation{ 1 };
+
+        struct ThreadSlab
+        {
+            const FrameArena* arena = nullptr;
+            uint64_t generation = 0;
+            uint8_t* cursor = nullptr;
+            uint8_t* end = nullptr;
+        };
+
+        const unsigned int kThreadSlabs = 4;
+        thread_local ThreadSlab thread_slabs[kThreadSlabs];
+        thread_local unsigned int next_thread_slab = 0;
+
+        uint8_t* align_pointer(uint8_t* pointer, size_t alignment)
+        {
+            return (uint8_t*)(((uintptr_t)pointer + alignment - 1) & ~(uintptr_t)(alignment - 1));
+        }
+    }
+
+    FrameArena::FrameArena(size_t slab_bytes)
+        : slab_bytes_(std::max<size_t>(slab_bytes, 4096))
+        , generation_(next_generation.fetch_add(1))
+    {
+    }
+
+    FrameArena::~FrameArena() = default;
+
+    void* FrameArena::Allocate(size_t bytes, size_t alignment)
+    {
+        uint64_t generation = generation_.load(std::memory_order_acquire);
+        ThreadSlab* slab = nullptr;
+        for (ThreadSlab& candidate : thread_slabs)
+        {
+            if (candidate.arena == this && candidate.generation == generation)
+            {
+                slab = &candidate;
+                break;
+            }
+        }
+
+        if (slab)
+        {
+            uint8_t* at = align_pointer(slab->cursor, alignment);
+            if (at + bytes <= slab->end)
+            {
+                slab->cursor = at + bytes;
+                return at;
+            }
+        }
+
+        // Large requests get a slab to themselves and leave the thread's slab alone. Their sizes are
+        // rounded up to a power of two so the slabs fit again next frame when the sizes vary a bit.
+        size_t needed = bytes + alignment;
+        if (needed > slab_bytes_ / 4)
+        {
+            size_t rounded = slab_bytes_;
+            while (rounded < needed)
+                rounded *= 2;
+            size_t slab_bytes = 0;
+            return align_pointer(AcquireSlab(rounded, slab_bytes), alignment);
+        }
+
+        if (!slab)
+        {
+            slab = &thread_slabs[next_thread_slab];
+            next_thread_slab = (next_thread_slab + 1) % kThreadSlabs;
+        }
+        size_t slab_bytes = 0;
+        uint8_t* memory = AcquireSlab(slab_bytes_, slab_bytes);
+        slab->arena = this;
+        slab->generation = generation;
+        slab->end = memory + slab_bytes;
+
+        uint8_t* at = align_pointer(memory, alignment);
+        slab->cursor = at + bytes;
+        return at;
+    }
+
+    void FrameArena::Reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation_.store(next_generation.fetch_add(1), std::memory_order_release);
+        in_use_ = 0;
+        in_use_bytes_ = 0;
+    }
+
+    size_t FrameArena::BytesInUse() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return in_use_bytes_;
+    }
+
+    size_t FrameArena::Capacity() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t bytes = 0;
+        for (const Slab& slab : slabs_)
+            bytes += slab.bytes;
+        return bytes;
+    }
+
+    size_t FrameArena::SlabCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return slabs_.size();
+    }
+
+    // ===============
+    // PRIVATE
+    // ===============
+    uint8_t* FrameArena::AcquireSlab(size_t bytes, size_t& slab_bytes)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // The smallest free slab that fits, so large ones stay available for large requests
+        size_t best = slabs_.size();
+        for (size_t i = in_use_; i < slabs_.size(); ++i)
+        {
+            if (slabs_[i].bytes >= bytes && (best == slabs_.size() || slabs_[i].bytes < slabs_[best].bytes))
+                best = i;
+        }
+        if (best == slabs_.size())
+        {
+            slabs_.emplace_back();
+            slabs_.back().memory.reset(new uint8_t[bytes]);
+            slabs_.back().bytes = bytes;
+        }
+
+        std::swap(slabs_[best], slabs_[in_use_]);
+        Slab& slab = slabs_[in_use_++];
+        in_use_bytes_ += slab.bytes;
+        slab_bytes = slab.bytes;
+        return slab.memory.get();
+    }
+}
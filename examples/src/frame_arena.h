@@ -0,0 +1,91 @@
+#ifndef _FRAME_ARENA_H
+#define _FRAME_ARENA_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace Utility
+{
+    // Bump allocator for data that lives for one frame (draw lists, sort keys, scratch copies).
+    // Every thread bumps through a slab of its own, so allocating is a pointer increment with no
+    // lock and no sharing; the arena lock is only taken to hand out the next slab. Reset rewinds
+    // everything at once and keeps the slabs, so after the first frames nothing reaches the heap.
+    // Nothing is freed individually and no destructors run: meant for trivially destructible data
+    // or containers whose destruction is a no-op, like FrameVector.
+    //
+    // A thread keeps the slabs of its last few arenas; using more arenas than that in turn on one
+    // thread still works but wastes the rest of a slab on every switch.
+    class FrameArena
+    {
+    public:
+        static const size_t kDefaultSlabBytes = 256 * 1024;
+
+        explicit FrameArena(size_t slab_bytes = kDefaultSlabBytes);
+        ~FrameArena();
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        // Thread safe; alignment is a power of two
+        void* Allocate(size_t bytes, size_t alignment = 16);
+        template <typename T> T* Allocate(size_t count)
+        {
+            return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        // Ends the frame: every allocation is invalid afterwards. No thread may be allocating.
+        void Reset();
+
+        // Slab bytes handed to threads since the last Reset
+        size_t BytesInUse() const;
+        // Slab bytes owned, in use or not
+        size_t Capacity() const;
+        size_t SlabCount() const;
+
+    private:
+        struct Slab
+        {
+            std::unique_ptr<uint8_t[]> memory;
+            size_t bytes = 0;
+        };
+
+        // A slab of at least bytes that no thread uses this frame
+        uint8_t* AcquireSlab(size_t bytes, size_t& slab_bytes);
+
+    private:
+        size_t slab_bytes_;
+        std::atomic<uint64_t> generation_;  // changes on Reset, which invalidates the threads' slabs
+
+        mutable std::mutex mutex_;
+        std::vector<Slab> slabs_;           // [0, in_use_) handed out this frame
+        size_t in_use_ = 0;
+        size_t in_use_bytes_ = 0;
+    };
+
+    // Standard allocator over a frame arena; deallocate does nothing
+    template <typename T>
+    struct FrameAllocator
+    {
+        typedef T value_type;
+
+        FrameArena* arena;
+
+        FrameAllocator(FrameArena& frame_arena) : arena(&frame_arena) {}
+        template <typename U> FrameAllocator(const FrameAllocator<U>& other) : arena(other.arena) {}
+
+        T* allocate(size_t count) { return arena->Allocate<T>(count); }
+        void deallocate(T*, size_t) {}
+
+        template <typename U> bool operator==(const FrameAllocator<U>& other) const { return arena == other.arena; }
+        template <typename U> bool operator!=(const FrameAllocator<U>& other) const { return arena != other.arena; }
+    };
+
+    template <typename T>
+    using FrameVector = std::vector<T, FrameAllocator<T>>;
+}
+
+#endif // !_FRAME_ARENA_H
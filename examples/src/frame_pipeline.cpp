@@ -0,0 +1,205 @@
+#include "frame_pipeline.h"
+#include <GL/glew.h>
+#include <algorithm>
+
+namespace Utility
+{
+    std::ostream& operator<<(std::ostream& os, const FrameLatencyReport& report)
+    {
+        os << report.frames << " frames, " << report.frame_ms << " ms per frame (max " << report.max_frame_ms << " ms), simulation "
+           << report.simulation_ms << " ms, render " << report.render_ms << " ms, waits: simulation " << report.simulation_wait_ms << " ms, render " << report.render_wait_ms
+           << " ms, GPU " << report.gpu_wait_ms << " ms, simulation to GPU done " << report.simulation_to_gpu_ms << " ms (max " << report.max_simulation_to_gpu_ms << " ms)";
+        return os;
+    }
+
+    FramePipeline::FramePipeline(const FramePipelineOptions& options)
+        : options_(options)
+    {
+        options_.snapshots = std::max(options_.snapshots, 1u);
+        options_.max_frames_in_flight = std::max(options_.max_frames_in_flight, 1u);
+        slots_.resize(options_.snapshots);
+        simulated_.resize(options_.snapshots);
+        in_flight_.resize(options_.max_frames_in_flight);
+    }
+
+    FramePipeline::~FramePipeline()
+    {
+        Stop();
+        for (size_t i = 0; i < in_flight_count_; ++i)
+            glDeleteSync((GLsync)in_flight_[(in_flight_head_ + i) % in_flight_.size()].fence);
+    }
+
+    int FramePipeline::BeginSimulation()
+    {
+        auto start = Clock::now();
+        std::unique_lock<std::mutex> lock(mutex_);
+        int snapshot = -1;
+        changed_.wait(lock, [this, &snapshot] {
+            if (stopped_)
+                return true;
+            for (size_t i = 0; i < slots_.size(); ++i)
+            {
+                if (slots_[i].state == SlotState::Free)
+                {
+                    snapshot = (int)i;
+                    return true;
+                }
+            }
+            return false;
+        });
+        if (stopped_)
+            return -1;
+
+        Slot& slot = slots_[snapshot];
+        slot.state = SlotState::Simulating;
+        slot.frame = next_frame_++;
+        slot.simulation_begin = Clock::now();
+        simulation_start_ = slot.simulation_begin;
+        totals_.simulation_wait_ms += Milliseconds(start, slot.simulation_begin);
+        return snapshot;
+    }
+
+    void FramePipeline::EndSimulation(int snapshot)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            slots_[snapshot].state = SlotState::Simulated;
+            simulated_[(simulated_head_ + simulated_count_++) % simulated_.size()] = snapshot;
+            totals_.simulation_ms += Milliseconds(simulation_start_, Clock::now());
+        }
+        changed_.notify_all();
+    }
+
+    int FramePipeline::BeginRender()
+    {
+        // The GPU stage first: at most max_frames_in_flight frames queued behind this one
+        auto gpu_start = Clock::now();
+        RetireFrames(false);
+        while (options_.gpu_fences && in_flight_count_ >= options_.max_frames_in_flight)
+            RetireFrames(true);
+        auto start = Clock::now();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        totals_.gpu_wait_ms += Milliseconds(gpu_start, start);
+        changed_.wait(lock, [this] { return stopped_ || simulated_count_ > 0; });
+        if (stopped_)
+            return -1;
+
+        int snapshot = simulated_[simulated_head_];
+        simulated_head_ = (simulated_head_ + 1) % simulated_.size();
+        --simulated_count_;
+        slots_[snapshot].state = SlotState::Rendering;
+        render_start_ = Clock::now();
+        totals_.render_wait_ms += Milliseconds(start, render_start_);
+        return snapshot;
+    }
+
+    void FramePipeline::EndRender(int snapshot)
+    {
+        Clock::time_point simulation_begin = slots_[snapshot].simulation_begin;
+        if (options_.gpu_fences)
+            in_flight_[(in_flight_head_ + in_flight_count_++) % in_flight_.size()] = { glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), simulation_begin };
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            slots_[snapshot].state = SlotState::Free;
+            totals_.render_ms += Milliseconds(render_start_, Clock::now());
+        }
+        changed_.notify_all();
+
+        if (!options_.gpu_fences)
+            FrameFinished(simulation_begin, Clock::now());
+    }
+
+    void FramePipeline::Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopped_ = true;
+        }
+        changed_.notify_all();
+    }
+
+    bool FramePipeline::Stopped() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stopped_;
+    }
+
+    FrameLatencyReport FramePipeline::Report() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        FrameLatencyReport report = totals_;
+        if (report.frames)
+        {
+            double frames = (double)report.frames;
+            report.frame_ms /= frames;
+            report.simulation_ms /= frames;
+            report.render_ms /= frames;
+            report.simulation_wait_ms /= frames;
+            report.render_wait_ms /= frames;
+            report.gpu_wait_ms /= frames;
+            report.simulation_to_gpu_ms /= frames;
+        }
+        return report;
+    }
+
+    void FramePipeline::ResetReport()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        totals_ = FrameLatencyReport();
+    }
+
+    // ===============
+    // PRIVATE
+    // ===============
+    void FramePipeline::RetireFrames(bool wait)
+    {
+        while (in_flight_count_ > 0)
+        {
+            InFlight& oldest = in_flight_[in_flight_head_];
+            GLsync fence = (GLsync)oldest.fence;
+            GLenum status = glClientWaitSync(fence, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+            {
+                if (!wait)
+                    return;
+                // Flushed once so the fence is guaranteed to reach the GPU
+                GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+                do
+                {
+                    status = glClientWaitSync(fence, flags, 1000000);
+                    flags = 0;
+                } while (status == GL_TIMEOUT_EXPIRED);
+                wait = false;
+            }
+
+            FrameFinished(oldest.simulation_begin, Clock::now());
+            glDeleteSync(fence);
+            in_flight_head_ = (in_flight_head_ + 1) % in_flight_.size();
+            --in_flight_count_;
+        }
+    }
+
+    void FramePipeline::FrameFinished(Clock::time_point simulation_begin, Clock::time_point finished)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        double latency = Milliseconds(simulation_begin, finished);
+        ++totals_.frames;
+        totals_.simulation_to_gpu_ms += latency;
+        totals_.max_simulation_to_gpu_ms = std::max(totals_.max_simulation_to_gpu_ms, latency);
+        if (has_finished_)
+        {
+            double frame = Milliseconds(last_finished_, finished);
+            totals_.frame_ms += frame;
+            totals_.max_frame_ms = std::max(totals_.max_frame_ms, frame);
+        }
+        last_finished_ = finished;
+        has_finished_ = true;
+    }
+
+    double FramePipeline::Milliseconds(Clock::time_point from, Clock::time_point to)
+    {
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    }
+}
@@ -0,0 +1,133 @@
+#ifndef _FRAME_PIPELINE_H
+#define _FRAME_PIPELINE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace Utility
+{
+    struct FramePipelineOptions
+    {
+        unsigned int snapshots = 2;             // scene copies shared by the stages, 3 lets the simulation run a whole frame ahead
+        unsigned int max_frames_in_flight = 2;  // frames submitted and not finished by the GPU before rendering blocks
+        bool gpu_fences = true;                 // false without a GL context: frames end when their submission does
+    };
+
+    // Averages per frame since the last ResetReport
+    struct FrameLatencyReport
+    {
+        unsigned long long frames = 0;
+        double frame_ms = 0.0;            // between consecutive frames leaving the pipeline
+        double max_frame_ms = 0.0;        // the worst hitch
+        double simulation_ms = 0.0;
+        double render_ms = 0.0;           // submission on the render thread
+        double simulation_wait_ms = 0.0;  // simulation blocked on a free snapshot
+        double render_wait_ms = 0.0;      // render blocked on a finished snapshot
+        double gpu_wait_ms = 0.0;         // render blocked on the frames in flight
+        double simulation_to_gpu_ms = 0.0;  // BeginSimulation returning to the GPU finishing the frame
+        double max_simulation_to_gpu_ms = 0.0;
+    };
+
+    std::ostream& operator<<(std::ostream& os, const FrameLatencyReport& report);
+
+    // Hand off between a simulation stage, a render submission stage and the GPU. The simulation
+    // writes frame N+1 into one snapshot while the render thread submits frame N from another, and
+    // the GPU works on up to max_frames_in_flight older frames, each guarded by a fence. Every stage
+    // blocks when the next one falls behind, so the distance between the start of a frame's
+    // simulation and its pixels stays bounded by snapshots + max_frames_in_flight frames.
+    //
+    // The pipeline only hands out snapshot indices; the snapshots themselves are owned by the
+    // caller, typically a std::vector of SnapshotCount() scene copies. Frames are rendered in the
+    // order they were simulated. With gpu_fences the render side calls must come from the thread
+    // owning the GL context; both sides may also run on the same thread, one after the other.
+    class FramePipeline
+    {
+    public:
+        explicit FramePipeline(const FramePipelineOptions& options = FramePipelineOptions());
+        ~FramePipeline();
+
+        FramePipeline(const FramePipeline&) = delete;
+        FramePipeline& operator=(const FramePipeline&) = delete;
+
+        size_t SnapshotCount() const { return slots_.size(); }
+
+        // Snapshot to write the next frame into, -1 once stopped
+        int BeginSimulation();
+        // Publishes the snapshot to the render stage
+        void EndSimulation(int snapshot);
+
+        // Oldest simulated snapshot once the GPU has room for another frame, -1 once stopped
+        int BeginRender();
+        // Fences the frame's GL commands and hands the snapshot back to the simulation
+        void EndRender(int snapshot);
+
+        // Simulation frame number written into the snapshot
+        unsigned long long FrameIndex(int snapshot) const { return slots_[snapshot].frame; }
+
+        // Releases both sides; every Begin call returns -1 from now on
+        void Stop();
+        bool Stopped() const;
+
+        FrameLatencyReport Report() const;
+        void ResetReport();
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        enum class SlotState
+        {
+            Free,
+            Simulating,
+            Simulated,
+            Rendering
+        };
+
+        struct Slot
+        {
+            SlotState state = SlotState::Free;
+            unsigned long long frame = 0;
+            Clock::time_point simulation_begin;
+        };
+
+        // Submitted frame the GPU may still be working on
+        struct InFlight
+        {
+            void* fence = nullptr;      // GLsync
+            Clock::time_point simulation_begin;
+        };
+
+        // Finishes the frames the GPU is done with; blocks for the oldest one when wait is set
+        void RetireFrames(bool wait);
+        void FrameFinished(Clock::time_point simulation_begin, Clock::time_point finished);
+
+        static double Milliseconds(Clock::time_point from, Clock::time_point to);
+
+    private:
+        FramePipelineOptions options_;
+        std::vector<Slot> slots_;
+        // Fixed rings rather than deques, which allocate as they cycle
+        std::vector<int> simulated_;          // snapshots waiting for the render stage, oldest first
+        size_t simulated_head_ = 0;
+        size_t simulated_count_ = 0;
+        std::vector<InFlight> in_flight_;     // render thread only
+        size_t in_flight_head_ = 0;
+        size_t in_flight_count_ = 0;
+        unsigned long long next_frame_ = 0;
+        bool stopped_ = false;
+
+        mutable std::mutex mutex_;
+        std::condition_variable changed_;
+
+        // Sums behind the report, under mutex_
+        FrameLatencyReport totals_;
+        Clock::time_point last_finished_;
+        bool has_finished_ = false;
+        Clock::time_point simulation_start_;
+        Clock::time_point render_start_;
+    };
+}
+
+#endif // !_FRAME_PIPELINE_H
@@ -0,0 +1,52 @@
+#include "frustum.h"
+#include <cmath>
+
+namespace Utility
+{
+    Frustum Frustum::FromMatrix(const glm::mat4& m)
+    {
+        // Gribb & Hartmann: planes are sums and differences of the matrix rows
+        glm::vec4 row[4];
+        for (int i = 0; i < 4; ++i)
+            row[i] = glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]);
+
+        Frustum frustum;
+        frustum.planes[Left] = row[3] + row[0];
+        frustum.planes[Right] = row[3] - row[0];
+        frustum.planes[Bottom] = row[3] + row[1];
+        frustum.planes[Top] = row[3] - row[1];
+        frustum.planes[Near] = row[3] + row[2];
+        frustum.planes[Far] = row[3] - row[2];
+
+        for (glm::vec4& plane : frustum.planes)
+        {
+            float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+            plane = plane / length;
+        }
+        return frustum;
+    }
+
+    bool Frustum::IntersectsSphere(const glm::vec3& center, float radius) const
+    {
+        for (const glm::vec4& plane : planes)
+        {
+            if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius)
+                return false;
+        }
+        return true;
+    }
+
+    bool Frustum::IntersectsBox(const glm::vec3& min_corner, const glm::vec3& max_corner) const
+    {
+        for (const glm::vec4& plane : planes)
+        {
+            // corner furthest along the plane normal
+            glm::vec3 p(plane.x >= 0.0f ? max_corner.x : min_corner.x,
+                        plane.y >= 0.0f ? max_corner.y : min_corner.y,
+                        plane.z >= 0.0f ? max_corner.z : min_corner.z);
+            if (plane.x * p.x + plane.y * p.y + plane.z * p.z + plane.w < 0.0f)
+                return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,22 @@
+#ifndef _FRUSTUM_H
+#define _FRUSTUM_H
+
+#include <glm/glm.hpp>
+
+namespace Utility
+{
+    // View frustum as six inward facing planes (xyz normal, w distance), in the space of the matrix it
+    // was built from: projection * view gives world space planes, projection * view * model object space.
+    struct Frustum
+    {
+        enum Plane { Left, Right, Bottom, Top, Near, Far };
+        glm::vec4 planes[6];
+
+        static Frustum FromMatrix(const glm::mat4& view_projection);
+
+        bool IntersectsSphere(const glm::vec3& center, float radius) const;
+        bool IntersectsBox(const glm::vec3& min_corner, const glm::vec3& max_corner) const;
+    };
+}
+
+#endif // !_FRUSTUM_H
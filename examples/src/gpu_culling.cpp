@@ -0,0 +1,247 @@
+#include "gpu_culling.h"
+#include <algorithm>
+#include <iostream>
+
+namespace Utility::mesh
+{
+    // ====================
+    //      HI-Z
+    // ====================
+    HiZPyramid::HiZPyramid()
+        : copy_shader_("tutorials\\shaders\\hiz_copy_cs.glsl"),
+          downsample_shader_("tutorials\\shaders\\hiz_downsample_cs.glsl")
+    {
+    }
+
+    HiZPyramid::~HiZPyramid()
+    {
+        Release();
+    }
+
+    void HiZPyramid::Create(int width, int height)
+    {
+        Release();
+        width_ = std::max(width, 1);
+        height_ = std::max(height, 1);
+        levels_ = 1;
+        while ((width_ >> levels_) > 0 || (height_ >> levels_) > 0)
+            ++levels_;
+
+        glGenTextures(1, &texture_);
+        glBindTexture(GL_TEXTURE_2D, texture_);
+        glTexStorage2D(GL_TEXTURE_2D, levels_, GL_R32F, width_, height_);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    void HiZPyramid::Release()
+    {
+        if (texture_)
+            glDeleteTextures(1, &texture_);
+        texture_ = 0;
+        levels_ = 0;
+    }
+
+    void HiZPyramid::Build(GLuint depth_texture)
+    {
+        if (!texture_)
+            return;
+
+        // Depth formats cannot be bound as images, so level 0 is copied into the R32F pyramid first
+        copy_shader_.use();
+        copy_shader_.setInt("depth", 0);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, depth_texture);
+        glBindImageTexture(0, texture_, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        glDispatchCompute((width_ + 7) / 8, (height_ + 7) / 8, 1);
+
+        downsample_shader_.use();
+        for (int level = 1; level < levels_; ++level)
+        {
+            glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+            int width = std::max(width_ >> level, 1);
+            int height = std::max(height_ >> level, 1);
+            glBindImageTexture(0, texture_, level - 1, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+            glBindImageTexture(1, texture_, level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+            glDispatchCompute((width + 7) / 8, (height + 7) / 8, 1);
+        }
+        glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    // ====================
+    //      CULLING
+    // ====================
+    GpuCulling::GpuCulling()
+        : cull_shader_("tutorials\\shaders\\gpu_cull_cs.glsl")
+    {
+        // The six planes go in one call from the location of the array's first element
+        frustum_planes_location_ = cull_shader_.Location("frustum_planes");
+    }
+
+    GpuCulling::~GpuCulling()
+    {
+        Release();
+    }
+
+    bool GpuCulling::Supported()
+    {
+        return GLEW_ARB_compute_shader && GLEW_ARB_shader_storage_buffer_object && GLEW_ARB_multi_draw_indirect;
+    }
+
+    bool GpuCulling::Create(const std::vector<MeshHandle>& meshes)
+    {
+        Release();
+        if (meshes.empty())
+            return false;
+        for (const MeshHandle& mesh : meshes)
+        {
+            if (mesh.vao != meshes[0].vao || mesh.index_type != meshes[0].index_type)
+            {
+                std::cerr << "ERROR::GPU_CULLING::MESHES_DO_NOT_SHARE_A_BLOCK" << std::endl;
+                return false;
+            }
+        }
+
+        meshes_ = meshes;
+        size_t index_size = meshes[0].index_type == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+        for (const MeshHandle& mesh : meshes)
+            commands_.push_back({ (GLuint)mesh.index_count, 0, (GLuint)(mesh.index_offset / index_size), mesh.base_vertex, 0 });
+
+        glGenBuffers(1, &instance_buffer_);
+        glGenBuffers(1, &command_buffer_);
+        glGenBuffers(1, &visible_buffer_);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, command_buffer_);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, commands_.size() * sizeof(DrawElementsIndirectCommand), commands_.data(), GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        return true;
+    }
+
+    void GpuCulling::Release()
+    {
+        if (instance_buffer_)
+            glDeleteBuffers(1, &instance_buffer_);
+        if (command_buffer_)
+            glDeleteBuffers(1, &command_buffer_);
+        if (visible_buffer_)
+            glDeleteBuffers(1, &visible_buffer_);
+        instance_buffer_ = command_buffer_ = visible_buffer_ = 0;
+        meshes_.clear();
+        commands_.clear();
+        instance_count_ = 0;
+    }
+
+    void GpuCulling::SetInstances(const std::vector<GpuInstance>& instances)
+    {
+        // Every mesh gets a slice of the visible list as large as its instance count,
+        // its command's base_instance points at the start of the slice
+        std::vector<GLuint> per_mesh(commands_.size(), 0);
+        for (const GpuInstance& instance : instances)
+        {
+            if (instance.mesh < per_mesh.size())
+                ++per_mesh[instance.mesh];
+        }
+        GLuint first = 0;
+        for (size_t mesh = 0; mesh < commands_.size(); ++mesh)
+        {
+            commands_[mesh].base_instance = first;
+            first += per_mesh[mesh];
+        }
+
+        instance_count_ = instances.size();
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, instance_buffer_);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<size_t>(instances.size(), 1) * sizeof(GpuInstance), instances.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, visible_buffer_);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<size_t>(instances.size(), 1) * sizeof(GLuint), nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+
+    void GpuCulling::Cull(const glm::mat4& view_projection, const glm::mat4& previous_view_projection, const HiZPyramid* hiz,
+        const GpuCullingOptions& options)
+    {
+        if (!instance_count_)
+            return;
+
+        // Reset the counters: the commands go back in with instance_count 0
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, command_buffer_);
+        glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, commands_.size() * sizeof(DrawElementsIndirectCommand), commands_.data());
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+        Frustum frustum = Frustum::FromMatrix(view_projection);
+        bool occlusion = options.occlusion && hiz && hiz->Texture();
+
+        cull_shader_.use();
+        cull_shader_.setInt("instance_count", (int)instance_count_);
+        cull_shader_.setBool("use_frustum", options.frustum);
+        glUniform4fv(frustum_planes_location_, 6, &frustum.planes[0][0]);
+        cull_shader_.setBool("use_hiz", occlusion);
+        if (occlusion)
+        {
+            cull_shader_.setMat4("previous_view_projection", previous_view_projection);
+            cull_shader_.setVec2("hiz_size", hiz->Size());
+            cull_shader_.setInt("hiz_levels", hiz->Levels());
+            cull_shader_.setInt("hiz", 0);
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, hiz->Texture());
+        }
+
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, instance_buffer_);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, command_buffer_);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, visible_buffer_);
+        glDispatchCompute((GLuint)((instance_count_ + 63) / 64), 1, 1);
+
+        // The commands are consumed as indirect arguments, the visible list as a vertex attribute
+        glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+        if (occlusion)
+            glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    void GpuCulling::Draw()
+    {
+        if (!instance_count_)
+            return;
+
+        glBindVertexArray(meshes_[0].vao);
+        glBindBuffer(GL_ARRAY_BUFFER, visible_buffer_);
+        glVertexAttribIPointer(kInstanceIdLocation, 1, GL_UNSIGNED_INT, sizeof(GLuint), (GLvoid*)0);
+        glVertexAttribDivisor(kInstanceIdLocation, 1);
+        glEnableVertexAttribArray(kInstanceIdLocation);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kInstanceBinding, instance_buffer_);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, command_buffer_);
+        glMultiDrawElementsIndirect(GL_TRIANGLES, meshes_[0].index_type, (GLvoid*)0, (GLsizei)commands_.size(), 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    }
+
+    size_t GpuCulling::ReadVisibleCount() const
+    {
+        std::vector<DrawElementsIndirectCommand> commands(commands_.size());
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, command_buffer_);
+        glGetBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, commands.size() * sizeof(DrawElementsIndirectCommand), commands.data());
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+        size_t visible = 0;
+        for (const DrawElementsIndirectCommand& command : commands)
+            visible += command.instance_count;
+        return visible;
+    }
+
+    size_t count_visible_instances(const std::vector<GpuInstance>& instances, const Frustum& frustum)
+    {
+        // Same sphere transform as gpu_cull_cs.glsl
+        size_t visible = 0;
+        for (const GpuInstance& instance : instances)
+        {
+            glm::vec3 center = glm::vec3(instance.model * glm::vec4(glm::vec3(instance.bounds), 1.0f));
+            float scale = std::max(glm::length(glm::vec3(instance.model[0])),
+                std::max(glm::length(glm::vec3(instance.model[1])), glm::length(glm::vec3(instance.model[2]))));
+            if (frustum.IntersectsSphere(center, instance.bounds.w * scale))
+                ++visible;
+        }
+        return visible;
+    }
+}
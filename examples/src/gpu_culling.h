@@ -0,0 +1,109 @@
+#ifndef _GPU_CULLING_H
+#define _GPU_CULLING_H
+
+#include "mesh_library.h"
+#include "indirect_draw.h"
+#include "frustum.h"
+#include "ShaderProgram.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Utility::mesh
+{
+    // Instance record shared with the culling and drawing shaders (std430, 96 bytes)
+    struct GpuInstance
+    {
+        glm::mat4 model;
+        glm::vec4 bounds;         // object space bounding sphere: center, radius
+        GLuint mesh = 0;          // index into the meshes given to GpuCulling::Create
+        GLuint material = 0;
+        GLuint padding[2] = {};
+    };
+
+    // Max depth pyramid of a depth texture, built with compute shaders. Level 0 has the size of the
+    // depth texture; every texel of level N holds the farthest depth of the texels it covers in N-1.
+    class HiZPyramid
+    {
+    public:
+        HiZPyramid();
+        ~HiZPyramid();
+
+        HiZPyramid(const HiZPyramid&) = delete;
+        HiZPyramid& operator=(const HiZPyramid&) = delete;
+
+        void Create(int width, int height);
+        void Release();
+        // depth_texture is a GL_DEPTH_COMPONENT texture of the same size
+        void Build(GLuint depth_texture);
+
+        GLuint Texture() const { return texture_; }
+        int Levels() const { return levels_; }
+        glm::vec2 Size() const { return glm::vec2((float)width_, (float)height_); }
+
+    private:
+        ShaderProgram copy_shader_;
+        ShaderProgram downsample_shader_;
+        GLuint texture_ = 0;
+        int width_ = 0;
+        int height_ = 0;
+        int levels_ = 0;
+    };
+
+    struct GpuCullingOptions
+    {
+        bool frustum = true;
+        bool occlusion = true;              // against the previous frame's Hi-Z pyramid
+    };
+
+    // GPU driven culling: a compute pass tests every instance's bounding sphere against the frustum
+    // and the Hi-Z pyramid of the previous frame, then appends the survivors to the instance list of
+    // their mesh with an atomic counter that is the instance_count of the mesh's indirect command.
+    // One glMultiDrawElementsIndirect then draws everything. The draw shader finds its instance
+    // through an instanced attribute at kInstanceIdLocation reading the compacted list from the
+    // command's base_instance. All meshes have to come from one MeshLibrary block (same VAO and
+    // index type). Needs GL 4.3 (compute shaders, shader storage buffers, multi draw indirect).
+    class GpuCulling
+    {
+    public:
+        static const GLuint kInstanceIdLocation = 7;
+        static const GLuint kInstanceBinding = 0;
+
+        GpuCulling();
+        ~GpuCulling();
+
+        GpuCulling(const GpuCulling&) = delete;
+        GpuCulling& operator=(const GpuCulling&) = delete;
+
+        // True when the context has everything the pass needs
+        static bool Supported();
+
+        bool Create(const std::vector<MeshHandle>& meshes);
+        void Release();
+
+        void SetInstances(const std::vector<GpuInstance>& instances);
+        // view_projection of the frame being drawn, previous_view_projection of the frame the pyramid was built from
+        void Cull(const glm::mat4& view_projection, const glm::mat4& previous_view_projection, const HiZPyramid* hiz,
+            const GpuCullingOptions& options = GpuCullingOptions());
+        // Binds the instance buffer to kInstanceBinding and draws the survivors
+        void Draw();
+
+        size_t InstanceCount() const { return instance_count_; }
+        // Reads the instance counts back from the command buffer; stalls, meant for statistics
+        size_t ReadVisibleCount() const;
+
+    private:
+        ShaderProgram cull_shader_;
+        GLint frustum_planes_location_ = -1;
+        std::vector<MeshHandle> meshes_;
+        std::vector<DrawElementsIndirectCommand> commands_;  // with instance_count 0, copied in before every cull
+        GLuint instance_buffer_ = 0;
+        GLuint command_buffer_ = 0;
+        GLuint visible_buffer_ = 0;
+        size_t instance_count_ = 0;
+    };
+
+    // CPU reference for the frustum part of the pass, used to check the GPU result
+    size_t count_visible_instances(const std::vector<GpuInstance>& instances, const Frustum& frustum);
+}
+
+#endif // !_GPU_CULLING_H
@@ -0,0 +1,134 @@
+#include "gpu_profiler.h"
+#include "string_id.h"
+#include <algorithm>
+
+namespace Utility::debug
+{
+    std::ostream& operator<<(std::ostream& os, const std::vector<GpuSection>& sections)
+    {
+        for (size_t i = 0; i < sections.size(); ++i)
+        {
+            os << (i ? ", " : "") << sections[i].name << " " << sections[i].gpu_ms << " ms";
+            if (sections[i].max_gpu_ms > sections[i].gpu_ms)
+                os << " (max " << sections[i].max_gpu_ms << ")";
+        }
+        return os;
+    }
+
+    const unsigned int GpuProfiler::kFrames;
+
+    GpuProfiler::~GpuProfiler()
+    {
+        for (Frame& frame : frames_)
+        {
+            if (!frame.queries.empty())
+                glDeleteQueries((GLsizei)frame.queries.size(), frame.queries.data());
+        }
+    }
+
+    void GpuProfiler::BeginFrame()
+    {
+        ++frame_;
+        Frame& frame = frames_[frame_ % kFrames];
+        Collect(frame);
+        frame.samples.clear();
+        open_.clear();
+        recording_ = true;
+    }
+
+    void GpuProfiler::Begin(std::string_view name)
+    {
+        if (!recording_)
+            return;
+
+        Frame& frame = frames_[frame_ % kFrames];
+        size_t needed = 2 * (frame.samples.size() + 1);
+        if (frame.queries.size() < needed)
+        {
+            size_t first = frame.queries.size();
+            frame.queries.resize(std::max(needed, 2 * first));
+            glGenQueries((GLsizei)(frame.queries.size() - first), frame.queries.data() + first);
+        }
+
+        Sample sample;
+        sample.section = Section(name);
+        sample.begin = frame.queries[2 * frame.samples.size()];
+        sample.end = frame.queries[2 * frame.samples.size() + 1];
+        glQueryCounter(sample.begin, GL_TIMESTAMP);
+        open_.push_back((uint32_t)frame.samples.size());
+        frame.samples.push_back(sample);
+    }
+
+    void GpuProfiler::End()
+    {
+        if (!recording_ || open_.empty())
+            return;
+
+        Frame& frame = frames_[frame_ % kFrames];
+        glQueryCounter(frame.samples[open_.back()].end, GL_TIMESTAMP);
+        open_.pop_back();
+    }
+
+    void GpuProfiler::ResetReport()
+    {
+        for (GpuSection& section : sections_)
+        {
+            section.gpu_ms = 0.0;
+            section.max_gpu_ms = 0.0;
+            section.frames = 0;
+        }
+    }
+
+    // ===============
+    // PRIVATE
+    // ===============
+    uint32_t GpuProfiler::Section(std::string_view name)
+    {
+        uint32_t hash = fnv1a(name);
+        for (uint32_t i = 0; i < section_hashes_.size(); ++i)
+        {
+            if (section_hashes_[i] == hash)
+                return i;
+        }
+        section_hashes_.push_back(hash);
+        sections_.emplace_back();
+        sections_.back().name = std::string(name);
+        frame_ms_.push_back(0.0);
+        return (uint32_t)sections_.size() - 1;
+    }
+
+    void GpuProfiler::Collect(Frame& frame)
+    {
+        if (frame.samples.empty())
+            return;
+
+        // Queries finish in order, so the last end stamp being ready means all of them are
+        GLint available = 0;
+        glGetQueryObjectiv(frame.samples.back().end, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            return;
+
+        std::fill(frame_ms_.begin(), frame_ms_.end(), 0.0);
+        for (const Sample& sample : frame.samples)
+        {
+            GLuint64 begin = 0, end = 0;
+            glGetQueryObjectui64v(sample.begin, GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(sample.end, GL_QUERY_RESULT, &end);
+            frame_ms_[sample.section] += (double)(end - begin) / 1e6;
+        }
+
+        // Running average per section over the frames it ran in
+        std::vector<bool> ran(sections_.size(), false);
+        for (const Sample& sample : frame.samples)
+            ran[sample.section] = true;
+        for (size_t i = 0; i < sections_.size(); ++i)
+        {
+            if (!ran[i])
+                continue;
+            GpuSection& section = sections_[i];
+            ++section.frames;
+            section.gpu_ms += (frame_ms_[i] - section.gpu_ms) / (double)section.frames;
+            section.max_gpu_ms = std::max(section.max_gpu_ms, frame_ms_[i]);
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef _GPU_PROFILER_H
+#define _GPU_PROFILER_H
+
+#include <GL/glew.h>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+namespace Utility::debug
+{
+    struct GpuSection
+    {
+        std::string name;
+        double gpu_ms = 0.0;            // per frame, averaged since the last ResetReport
+        double max_gpu_ms = 0.0;
+        unsigned long long frames = 0;  // frames the section ran in
+    };
+
+    std::ostream& operator<<(std::ostream& os, const std::vector<GpuSection>& sections);
+
+    // GPU time of named sections of a frame, from GL_TIMESTAMP queries around them (GL 3.3 /
+    // ARB_timer_query). Results are read kFrames frames later so the CPU never waits for them; a
+    // frame whose queries are still pending by then is dropped from the averages. Sections may
+    // nest; a section that runs several times in a frame is summed.
+    //
+    //     profiler.BeginFrame();
+    //     profiler.Begin("shadows");  ...  profiler.End();
+    class GpuProfiler
+    {
+    public:
+        static const unsigned int kFrames = 4;
+
+        GpuProfiler() = default;
+        ~GpuProfiler();
+
+        GpuProfiler(const GpuProfiler&) = delete;
+        GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+        // Starts recording a frame and collects the one recorded kFrames frames ago
+        void BeginFrame();
+
+        void Begin(std::string_view name);
+        void End();
+
+        // Sections in the order they first ran
+        const std::vector<GpuSection>& Report() const { return sections_; }
+        void ResetReport();
+
+    private:
+        struct Sample
+        {
+            uint32_t section;
+            GLuint begin;
+            GLuint end;
+        };
+
+        struct Frame
+        {
+            std::vector<Sample> samples;
+            std::vector<GLuint> queries;    // pool, samples use [0, 2 * samples.size())
+        };
+
+        uint32_t Section(std::string_view name);
+        void Collect(Frame& frame);
+
+    private:
+        Frame frames_[kFrames];
+        unsigned int frame_ = 0;
+        bool recording_ = false;
+        std::vector<GpuSection> sections_;
+        std::vector<uint32_t> section_hashes_;  // by section
+        std::vector<double> frame_ms_;          // scratch, by section
+        std::vector<uint32_t> open_;            // samples begun and not ended
+    };
+}
+
+#endif // !_GPU_PROFILER_H
@@ -0,0 +1,178 @@
+#include "indirect_draw.h"
+#include <iostream>
+
+namespace Utility::mesh
+{
+    IndirectDrawBatch::~IndirectDrawBatch()
+    {
+        Release();
+    }
+
+    bool IndirectDrawBatch::Create(size_t max_draws)
+    {
+        Release();
+        if (max_draws == 0)
+            return false;
+
+        max_draws_ = max_draws;
+        multi_draw_ = GLEW_ARB_multi_draw_indirect;
+
+        glGenBuffers(1, &indirect_buffer_);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect_buffer_);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, max_draws * sizeof(DrawElementsIndirectCommand), nullptr, GL_STREAM_DRAW);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+        glGenBuffers(1, &draw_data_buffer_);
+        glBindBuffer(GL_TEXTURE_BUFFER, draw_data_buffer_);
+        glBufferData(GL_TEXTURE_BUFFER, max_draws * sizeof(DrawData), nullptr, GL_STREAM_DRAW);
+        glGenTextures(1, &draw_data_texture_);
+        glBindTexture(GL_TEXTURE_BUFFER, draw_data_texture_);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, draw_data_buffer_);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+        // 0, 1, 2... read once per instance, shifted by base_instance
+        std::vector<GLuint> ids(max_draws);
+        for (size_t i = 0; i < max_draws; ++i)
+            ids[i] = (GLuint)i;
+        glGenBuffers(1, &draw_id_buffer_);
+        glBindBuffer(GL_ARRAY_BUFFER, draw_id_buffer_);
+        glBufferData(GL_ARRAY_BUFFER, ids.size() * sizeof(GLuint), ids.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        draw_data_.reserve(max_draws);
+        upload_.reserve(max_draws);
+        return true;
+    }
+
+    void IndirectDrawBatch::Release()
+    {
+        if (indirect_buffer_)
+            glDeleteBuffers(1, &indirect_buffer_);
+        if (draw_data_buffer_)
+            glDeleteBuffers(1, &draw_data_buffer_);
+        if (draw_data_texture_)
+            glDeleteTextures(1, &draw_data_texture_);
+        if (draw_id_buffer_)
+            glDeleteBuffers(1, &draw_id_buffer_);
+        indirect_buffer_ = draw_data_buffer_ = draw_data_texture_ = draw_id_buffer_ = 0;
+        Clear();
+    }
+
+    void IndirectDrawBatch::Clear()
+    {
+        // Groups are kept so their vectors keep their capacity from frame to frame
+        for (Group& group : groups_)
+            group.commands.clear();
+        draw_data_.clear();
+    }
+
+    bool IndirectDrawBatch::Add(const MeshHandle& mesh, const glm::mat4& model, unsigned int material)
+    {
+        if (draw_data_.size() >= max_draws_ || !mesh.Valid())
+            return false;
+
+        size_t index_size = mesh.index_type == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+        DrawElementsIndirectCommand command;
+        command.count = (GLuint)mesh.index_count;
+        command.instance_count = 1;
+        command.first_index = (GLuint)(mesh.index_offset / index_size);
+        command.base_vertex = mesh.base_vertex;
+        command.base_instance = (GLuint)draw_data_.size();
+        GetGroup(mesh.vao, mesh.index_type).commands.push_back(command);
+
+        draw_data_.push_back({ model, glm::vec4((float)material, 0.0f, 0.0f, 0.0f) });
+        return true;
+    }
+
+    void IndirectDrawBatch::Upload()
+    {
+        upload_.clear();
+        for (Group& group : groups_)
+        {
+            group.buffer_offset = upload_.size() * sizeof(DrawElementsIndirectCommand);
+            upload_.insert(upload_.end(), group.commands.begin(), group.commands.end());
+        }
+
+        // Both buffers are rewritten every frame, orphaning keeps that from waiting on the previous frame
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect_buffer_);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, max_draws_ * sizeof(DrawElementsIndirectCommand), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, upload_.size() * sizeof(DrawElementsIndirectCommand), upload_.data());
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+        glBindBuffer(GL_TEXTURE_BUFFER, draw_data_buffer_);
+        glBufferData(GL_TEXTURE_BUFFER, max_draws_ * sizeof(DrawData), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, draw_data_.size() * sizeof(DrawData), draw_data_.data());
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    }
+
+    void IndirectDrawBatch::BindDrawData(GLuint texture_unit) const
+    {
+        glActiveTexture(GL_TEXTURE0 + texture_unit);
+        glBindTexture(GL_TEXTURE_BUFFER, draw_data_texture_);
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    void IndirectDrawBatch::Draw()
+    {
+        submitted_calls_ = 0;
+        if (multi_draw_)
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect_buffer_);
+
+        for (const Group& group : groups_)
+        {
+            if (group.commands.empty())
+                continue;
+
+            if (multi_draw_)
+            {
+                BindDrawId(group.vao, 0);
+                glMultiDrawElementsIndirect(GL_TRIANGLES, group.index_type, (GLvoid*)group.buffer_offset, (GLsizei)group.commands.size(), 0);
+                ++submitted_calls_;
+                continue;
+            }
+
+            // Fallback: one call per command, the draw id attribute is offset by hand instead of by base_instance
+            size_t index_size = group.index_type == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+            for (const DrawElementsIndirectCommand& command : group.commands)
+            {
+                BindDrawId(group.vao, command.base_instance);
+                glDrawElementsInstancedBaseVertex(GL_TRIANGLES, command.count, group.index_type,
+                    (GLvoid*)(command.first_index * index_size), command.instance_count, command.base_vertex);
+                ++submitted_calls_;
+            }
+        }
+
+        if (multi_draw_)
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    }
+
+    bool IndirectDrawBatch::ShaderDrawParametersSupported()
+    {
+        return GLEW_ARB_shader_draw_parameters;
+    }
+
+    // ===============
+    // PRIVATE
+    // ===============
+    IndirectDrawBatch::Group& IndirectDrawBatch::GetGroup(GLuint vao, GLenum index_type)
+    {
+        for (Group& group : groups_)
+        {
+            if (group.vao == vao && group.index_type == index_type)
+                return group;
+        }
+        groups_.push_back({ vao, index_type, {}, 0 });
+        return groups_.back();
+    }
+
+    void IndirectDrawBatch::BindDrawId(GLuint vao, GLuint first_draw) const
+    {
+        glBindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, draw_id_buffer_);
+        glVertexAttribIPointer(kDrawIdLocation, 1, GL_UNSIGNED_INT, sizeof(GLuint), (GLvoid*)(first_draw * sizeof(GLuint)));
+        glVertexAttribDivisor(kDrawIdLocation, 1);
+        glEnableVertexAttribArray(kDrawIdLocation);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef _INDIRECT_DRAW_H
+#define _INDIRECT_DRAW_H
+
+#include "mesh_library.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Utility::mesh
+{
+    // Layout read by glMultiDrawElementsIndirect
+    struct DrawElementsIndirectCommand
+    {
+        GLuint count;
+        GLuint instance_count;
+        GLuint first_index;
+        GLint base_vertex;
+        GLuint base_instance;
+    };
+
+    // Per draw data fetched by the shader, 5 RGBA32F texels per draw in a buffer texture
+    struct DrawData
+    {
+        glm::mat4 model;
+        glm::vec4 material;   // x: material index
+    };
+
+    // Collects the draws of a frame (meshes from a MeshLibrary with their per draw data) and submits
+    // them with one glMultiDrawElementsIndirect per VAO and index type.
+    // Every draw's base_instance is its index in the batch, which is how the shader finds its data:
+    // through gl_BaseInstanceARB where ARB_shader_draw_parameters is available, otherwise through
+    // an instanced integer attribute at kDrawIdLocation that reads 0, 1, 2... and so starts at
+    // base_instance. Without ARB_multi_draw_indirect (GL 4.1) the commands are replayed in a loop.
+    // Needs a current GL context for its whole lifetime.
+    class IndirectDrawBatch
+    {
+    public:
+        static const GLuint kDrawIdLocation = 7;
+
+        IndirectDrawBatch() = default;
+        ~IndirectDrawBatch();
+
+        IndirectDrawBatch(const IndirectDrawBatch&) = delete;
+        IndirectDrawBatch& operator=(const IndirectDrawBatch&) = delete;
+
+        bool Create(size_t max_draws);
+        void Release();
+
+        void Clear();
+        // One instance per draw: the draw id attribute advances per instance, so a second instance
+        // would read the next draw's data
+        bool Add(const MeshHandle& mesh, const glm::mat4& model, unsigned int material);
+        // Uploads the commands and the per draw data, once per frame after the last Add
+        void Upload();
+        // Binds the per draw data buffer texture to the given texture unit
+        void BindDrawData(GLuint texture_unit) const;
+        void Draw();
+
+        size_t DrawCount() const { return draw_data_.size(); }
+        // Number of GL draw calls the last Draw() issued
+        size_t SubmittedCalls() const { return submitted_calls_; }
+        bool MultiDrawSupported() const { return multi_draw_; }
+        // gl_BaseInstanceARB can be used in place of the draw id attribute
+        static bool ShaderDrawParametersSupported();
+
+    private:
+        struct Group
+        {
+            GLuint vao;
+            GLenum index_type;
+            std::vector<DrawElementsIndirectCommand> commands;
+            size_t buffer_offset = 0;   // in the indirect buffer, in bytes
+        };
+
+        Group& GetGroup(GLuint vao, GLenum index_type);
+        void BindDrawId(GLuint vao, GLuint first_draw) const;
+
+    private:
+        size_t max_draws_ = 0;
+        bool multi_draw_ = false;
+        GLuint indirect_buffer_ = 0;
+        GLuint draw_data_buffer_ = 0;
+        GLuint draw_data_texture_ = 0;
+        GLuint draw_id_buffer_ = 0;
+        std::vector<Group> groups_;
+        std::vector<DrawData> draw_data_;
+        std::vector<DrawElementsIndirectCommand> upload_;
+        size_t submitted_calls_ = 0;
+    };
+}
+
+#endif // !_INDIRECT_DRAW_H
@@ -0,0 +1,284 @@
+#include "job_system.h"
+#include <chrono>
+#include <iostream>
+
+namespace Utility
+{
+    namespace
+    {
+        const unsigned int kExternalThread = 0xffffffffu;
+
+        // Which system and worker the current thread belongs to
+        struct ThreadWorker
+        {
+            const JobSystem* system = nullptr;
+            unsigned int index = kExternalThread;
+        };
+        thread_local ThreadWorker current_worker;
+    }
+
+    // ====================
+    //      DEQUE
+    // ====================
+    WorkStealingDeque::WorkStealingDeque(size_t capacity)
+    {
+        size_t size = 1;
+        while (size < capacity)
+            size *= 2;
+        buffer_.reset(new std::atomic<Job*>[size]);
+        mask_ = (int64_t)size - 1;
+    }
+
+    bool WorkStealingDeque::Push(Job* job)
+    {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        int64_t top = top_.load(std::memory_order_acquire);
+        if (bottom - top > mask_)
+            return false;
+
+        buffer_[bottom & mask_].store(job, std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    Job* WorkStealingDeque::Pop()
+    {
+        // The bottom store and top load must not be reordered, or a thief could take the same job
+        int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(bottom, std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_seq_cst);
+
+        if (top > bottom)
+        {
+            // Empty
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Job* job = buffer_[bottom & mask_].load(std::memory_order_relaxed);
+        if (top == bottom)
+        {
+            // Last item: race the thieves for it
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                job = nullptr;
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    Job* WorkStealingDeque::Steal()
+    {
+        int64_t top = top_.load(std::memory_order_seq_cst);
+        int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+        if (top >= bottom)
+            return nullptr;
+
+        Job* job = buffer_[top & mask_].load(std::memory_order_relaxed);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+        return job;
+    }
+
+    // ====================
+    //      JOB SYSTEM
+    // ====================
+    JobSystem::JobSystem(unsigned int threads)
+    {
+        threads = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned int i = 0; i < threads; ++i)
+            workers_.emplace_back(new Worker());
+
+        current_worker.system = this;
+        current_worker.index = 0;
+        for (unsigned int i = 1; i < threads; ++i)
+            workers_[i]->thread = std::thread(&JobSystem::WorkerLoop, this, i);
+    }
+
+    JobSystem::~JobSystem()
+    {
+        quit_.store(true);
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            wake_.notify_all();
+        }
+        for (std::unique_ptr<Worker>& worker : workers_)
+        {
+            if (worker->thread.joinable())
+                worker->thread.join();
+        }
+        if (current_worker.system == this)
+            current_worker = ThreadWorker();
+    }
+
+    unsigned int JobSystem::WorkerIndex() const
+    {
+        return current_worker.system == this ? current_worker.index : 0;
+    }
+
+    void JobSystem::AddDependency(Job* job, Job* prerequisite)
+    {
+        int32_t slot = prerequisite->continuation_count.load(std::memory_order_relaxed);
+        if (slot >= Job::kMaxContinuations)
+        {
+            std::cerr << "ERROR::JOB_SYSTEM::TOO_MANY_CONTINUATIONS" << std::endl;
+            return;
+        }
+        prerequisite->continuations[slot] = job;
+        prerequisite->continuation_count.store(slot + 1, std::memory_order_release);
+        job->dependencies.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void JobSystem::Submit(Job* job)
+    {
+        if (job->dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            Push(job);
+    }
+
+    void JobSystem::Wait(const Job* job)
+    {
+        unsigned int worker = current_worker.system == this ? current_worker.index : kExternalThread;
+        while (!Finished(job))
+        {
+            // Outside threads help as well, with JobSystem(1) there may be nobody else to run the job
+            if (Job* next = Next(worker))
+                Execute(next);
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    // ===============
+    // PRIVATE
+    // ===============
+    Job* JobSystem::Allocate(Job* parent)
+    {
+        Job* job;
+        if (current_worker.system == this)
+        {
+            Worker& worker = *workers_[current_worker.index];
+            job = &worker.jobs[worker.next_job++ & (kJobsPerWorker - 1)];
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(external_mutex_);
+            job = &external_jobs_[next_external_job_++ & (kJobsPerWorker - 1)];
+        }
+
+        job->function = nullptr;
+        job->parent = parent;
+        job->unfinished.store(1, std::memory_order_relaxed);
+        job->dependencies.store(1, std::memory_order_relaxed);
+        job->continuation_count.store(0, std::memory_order_relaxed);
+        if (parent)
+            parent->unfinished.fetch_add(1, std::memory_order_relaxed);
+        return job;
+    }
+
+    void JobSystem::Push(Job* job)
+    {
+        if (current_worker.system == this)
+        {
+            // A full deque means plenty of queued work, running this one right away is fine
+            if (!workers_[current_worker.index]->deque.Push(job))
+            {
+                Execute(job);
+                return;
+            }
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(external_mutex_);
+            external_.push_back(job);
+            external_count_.fetch_add(1, std::memory_order_release);
+        }
+
+        if (sleeping_.load(std::memory_order_acquire) > 0)
+            wake_.notify_one();
+    }
+
+    Job* JobSystem::Next(unsigned int worker)
+    {
+        bool external = worker == kExternalThread;
+        if (!external)
+        {
+            if (Job* job = workers_[worker]->deque.Pop())
+                return job;
+        }
+
+        if (external_count_.load(std::memory_order_acquire) > 0)
+        {
+            std::lock_guard<std::mutex> lock(external_mutex_);
+            if (!external_.empty())
+            {
+                Job* job = external_.back();
+                external_.pop_back();
+                external_count_.fetch_sub(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+
+        // An outside thread has no deque of its own and steals from every worker
+        size_t first = external ? 0 : 1;
+        size_t base = external ? 0 : worker;
+        for (size_t i = first; i < workers_.size(); ++i)
+        {
+            if (Job* job = workers_[(base + i) % workers_.size()]->deque.Steal())
+                return job;
+        }
+        return nullptr;
+    }
+
+    void JobSystem::Execute(Job* job)
+    {
+        job->function(*job);
+        Finish(job);
+    }
+
+    void JobSystem::Finish(Job* job)
+    {
+        // Everything is read before the count drops: a finished job may be recycled right away
+        Job* parent = job->parent;
+        Job* continuations[Job::kMaxContinuations];
+        int32_t continuation_count = job->continuation_count.load(std::memory_order_acquire);
+        for (int32_t i = 0; i < continuation_count; ++i)
+            continuations[i] = job->continuations[i];
+
+        if (job->unfinished.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+
+        for (int32_t i = 0; i < continuation_count; ++i)
+            Submit(continuations[i]);
+        if (parent)
+            Finish(parent);
+    }
+
+    void JobSystem::WorkerLoop(unsigned int worker)
+    {
+        current_worker.system = this;
+        current_worker.index = worker;
+
+        int idle = 0;
+        while (!quit_.load(std::memory_order_acquire))
+        {
+            if (Job* job = Next(worker))
+            {
+                Execute(job);
+                idle = 0;
+                continue;
+            }
+
+            // Spin briefly for the next batch, then sleep; the timeout covers a wake up sent just
+            // before this worker registered as sleeping
+            if (++idle < 64)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            sleeping_.fetch_add(1, std::memory_order_acq_rel);
+            wake_.wait_for(lock, std::chrono::milliseconds(1));
+            sleeping_.fetch_sub(1, std::memory_order_acq_rel);
+            idle = 0;
+        }
+    }
+}
@@ -0,0 +1,165 @@
+#ifndef _JOB_SYSTEM_H
+#define _JOB_SYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace Utility
+{
+    // A unit of work with its callable stored inline. unfinished counts the job itself plus its
+    // running children; dependencies counts the prerequisites that still have to finish plus one
+    // for the pending Submit call.
+    struct alignas(64) Job
+    {
+        static const int kMaxContinuations = 6;
+        static const size_t kDataBytes = 64;
+
+        void (*function)(Job& job) = nullptr;
+        Job* parent = nullptr;
+        std::atomic<int32_t> unfinished{ 0 };
+        std::atomic<int32_t> dependencies{ 0 };
+        std::atomic<int32_t> continuation_count{ 0 };
+        Job* continuations[kMaxContinuations] = {};
+        alignas(16) unsigned char data[kDataBytes];
+    };
+
+    // Chase-Lev deque of fixed capacity: the owning worker pushes and pops at the bottom (LIFO, warm
+    // caches), other workers steal from the top (FIFO, the oldest and usually largest work).
+    class WorkStealingDeque
+    {
+    public:
+        explicit WorkStealingDeque(size_t capacity = 4096);
+
+        // Owner only; false when full
+        bool Push(Job* job);
+        // Owner only
+        Job* Pop();
+        // Any thread
+        Job* Steal();
+
+    private:
+        std::unique_ptr<std::atomic<Job*>[]> buffer_;
+        int64_t mask_;
+        alignas(64) std::atomic<int64_t> top_{ 0 };
+        alignas(64) std::atomic<int64_t> bottom_{ 0 };
+    };
+
+    // Work stealing scheduler. The thread that creates it is worker 0 and takes part in the work
+    // whenever it waits; the other workers are background threads with a deque each. An idle worker
+    // pops its own deque, then steals from the others, then sleeps until new work is submitted.
+    //
+    // Jobs come from a per worker ring of kJobsPerWorker, so a worker must not have more than that
+    // many jobs alive at once; they are recycled without any locking or allocation.
+    //
+    //     Job* root = jobs.CreateJob([] {});
+    //     Job* a = jobs.CreateJob([&] { ... }, root);     // child: root finishes after it
+    //     Job* b = jobs.CreateJob([&] { ... }, root);
+    //     jobs.AddDependency(b, a);                       // b starts once a has finished
+    //     jobs.Submit(a); jobs.Submit(b); jobs.Submit(root);
+    //     jobs.Wait(root);
+    class JobSystem
+    {
+    public:
+        static const size_t kJobsPerWorker = 4096;
+
+        // 0 uses every hardware thread
+        explicit JobSystem(unsigned int threads = 0);
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        unsigned int ThreadCount() const { return (unsigned int)workers_.size(); }
+        // Index of the calling worker in [0, ThreadCount()), for per worker output of jobs
+        unsigned int WorkerIndex() const;
+
+        // With a parent, the parent is not finished before this job is
+        template <typename F>
+        Job* CreateJob(F&& function, Job* parent = nullptr)
+        {
+            typedef typename std::decay<F>::type Callable;
+            static_assert(sizeof(Callable) <= Job::kDataBytes, "job callable is too large, capture by reference");
+            static_assert(alignof(Callable) <= 16, "job callable is over aligned");
+
+            Job* job = Allocate(parent);
+            new (job->data) Callable(std::forward<F>(function));
+            job->function = [](Job& self) {
+                Callable& callable = *reinterpret_cast<Callable*>(self.data);
+                callable();
+                callable.~Callable();
+            };
+            return job;
+        }
+
+        // job waits for prerequisite (and its children). Both must not be submitted yet.
+        void AddDependency(Job* job, Job* prerequisite);
+        // Queues the job, or leaves it to its last prerequisite when some are still pending
+        void Submit(Job* job);
+        // Runs other jobs until job and its children have finished. Threads outside the system can
+        // create, submit and wait too; they run queued and stolen jobs while they wait.
+        void Wait(const Job* job);
+        bool Finished(const Job* job) const { return job->unfinished.load(std::memory_order_acquire) == 0; }
+
+        // fn(begin, end) over [0, count) in ranges of about grain items (0 picks one), returns when all are done
+        template <typename F>
+        void ParallelFor(size_t count, size_t grain, F&& fn)
+        {
+            if (count == 0)
+                return;
+            if (grain == 0)
+                grain = count / (ThreadCount() * 8);
+            // Stay well inside the job ring
+            grain = std::max(grain, (count + kJobsPerWorker / 4 - 1) / (kJobsPerWorker / 4));
+
+            Job* root = CreateJob([] {});
+            for (size_t begin = 0; begin < count; begin += grain)
+            {
+                size_t end = std::min(begin + grain, count);
+                Submit(CreateJob([&fn, begin, end] { fn(begin, end); }, root));
+            }
+            Submit(root);
+            Wait(root);
+        }
+
+    private:
+        struct Worker
+        {
+            WorkStealingDeque deque;
+            std::unique_ptr<Job[]> jobs{ new Job[kJobsPerWorker] };
+            size_t next_job = 0;
+            std::thread thread;
+        };
+
+        Job* Allocate(Job* parent);
+        void Push(Job* job);
+        Job* Next(unsigned int worker);
+        void Execute(Job* job);
+        void Finish(Job* job);
+        void WorkerLoop(unsigned int worker);
+
+    private:
+        std::vector<std::unique_ptr<Worker>> workers_;
+        // Jobs created and submitted by threads outside the system
+        std::mutex external_mutex_;
+        std::unique_ptr<Job[]> external_jobs_{ new Job[kJobsPerWorker] };
+        size_t next_external_job_ = 0;
+        std::vector<Job*> external_;
+        std::atomic<size_t> external_count_{ 0 };
+        std::mutex sleep_mutex_;
+        std::condition_variable wake_;
+        std::atomic<int> sleeping_{ 0 };
+        std::atomic<bool> quit_{ false };
+    };
+}
+
+#endif // !_JOB_SYSTEM_H
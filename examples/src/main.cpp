@@ -1,5 +1,7 @@
 #include "tutorials/tutorials.h"
 #include "tutorials/lighting.h"
+#include "tutorials/benchmarks.h"
+#include "tutorials/rendering.h"
 
 //https://github.com/amhndu/fly
 //https://www.youtube.com/watch?v=qQJ7irgxZFQ&feature=youtu.be
@@ -11,6 +13,33 @@ int main()
 {
 	//return tutorials::cube::translation::Run();
 	//tutorials::getting_started::transformations::Scale();
+	//return tutorials::benchmarks::VertexCache();
+	//return tutorials::benchmarks::VertexFormats();
+	//return tutorials::benchmarks::MeshImport();
+	//return tutorials::benchmarks::CookedMeshLoad();
+	//return tutorials::benchmarks::Meshlets();
+	//return tutorials::benchmarks::BufferArena();
+	//return tutorials::benchmarks::TransformCompose();
+	//return tutorials::benchmarks::SceneGraphUpdate();
+	//return tutorials::benchmarks::EntityIteration();
+	//return tutorials::benchmarks::JobSystemThroughput();
+	//return tutorials::benchmarks::CommandRecording();
+	//return tutorials::benchmarks::FramePipelineLatency();
+	//return tutorials::benchmarks::FrameAllocations();
+	//return tutorials::benchmarks::ClusteredLightAssignment();
+	//return tutorials::benchmarks::GBufferBandwidth();
+	//return tutorials::rendering::LodField();
+	//return tutorials::rendering::MeshletCulling();
+	//return tutorials::rendering::StreamedCubes();
+	//return tutorials::rendering::SceneHierarchy();
+	//return tutorials::rendering::IndirectObjects();
+	//return tutorials::rendering::GpuCulledField();
+	//return tutorials::rendering::RecordedCommands();
+	//return tutorials::rendering::PipelinedFrames();
+	//return tutorials::rendering::MaterialObjects();
+	//return tutorials::rendering::ClusteredLights();
+	//return tutorials::lighting::deferred::DeferredShading();
+	//return tutorials::lighting::shadows::CascadedShadows();
 	return tutorials::lighting::lighting_maps::SpecularMap();
 }
 
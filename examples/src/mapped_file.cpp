@@ -0,0 +1,158 @@
+#include "mapped_file.h"
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Utility
+{
+    MappedFile::MappedFile(const char* path)
+    {
+        Open(path);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+    {
+        Steal(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Close();
+            Steal(other);
+        }
+        return *this;
+    }
+
+    void MappedFile::Steal(MappedFile& other)
+    {
+        data_ = other.data_;
+        size_ = other.size_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+#ifdef _WIN32
+        file_ = other.file_;
+        mapping_ = other.mapping_;
+        other.file_ = nullptr;
+        other.mapping_ = nullptr;
+#else
+        fd_ = other.fd_;
+        other.fd_ = -1;
+#endif
+    }
+
+#ifdef _WIN32
+    bool MappedFile::Open(const char* path)
+    {
+        Close();
+
+        HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            std::cerr << "Failed to open file: " << path << std::endl;
+            return false;
+        }
+        file_ = file;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+        {
+            std::cerr << "Failed to map empty file: " << path << std::endl;
+            Close();
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (!mapping)
+        {
+            std::cerr << "Failed to map file: " << path << std::endl;
+            Close();
+            return false;
+        }
+        mapping_ = mapping;
+
+        data_ = (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!data_)
+        {
+            std::cerr << "Failed to map file: " << path << std::endl;
+            Close();
+            return false;
+        }
+        size_ = (size_t)size.QuadPart;
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (data_)
+            UnmapViewOfFile(data_);
+        if (mapping_)
+            CloseHandle((HANDLE)mapping_);
+        if (file_)
+            CloseHandle((HANDLE)file_);
+        data_ = nullptr;
+        size_ = 0;
+        mapping_ = nullptr;
+        file_ = nullptr;
+    }
+#else
+    bool MappedFile::Open(const char* path)
+    {
+        Close();
+
+        fd_ = open(path, O_RDONLY);
+        if (fd_ < 0)
+        {
+            std::cerr << "Failed to open file: " << path << std::endl;
+            return false;
+        }
+
+        struct stat info;
+        if (fstat(fd_, &info) != 0 || info.st_size == 0)
+        {
+            std::cerr << "Failed to map empty file: " << path << std::endl;
+            Close();
+            return false;
+        }
+
+        void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (data == MAP_FAILED)
+        {
+            std::cerr << "Failed to map file: " << path << std::endl;
+            Close();
+            return false;
+        }
+        madvise(data, (size_t)info.st_size, MADV_SEQUENTIAL);
+
+        data_ = (const unsigned char*)data;
+        size_ = (size_t)info.st_size;
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (data_)
+            munmap((void*)data_, size_);
+        if (fd_ >= 0)
+            close(fd_);
+        data_ = nullptr;
+        size_ = 0;
+        fd_ = -1;
+    }
+#endif
+}
@@ -0,0 +1,44 @@
+#ifndef _MAPPED_FILE_H
+#define _MAPPED_FILE_H
+
+#include <cstddef>
+
+namespace Utility
+{
+    // Read-only view of a whole file mapped into the address space.
+    // Pages are faulted in on first access, so opening a large file is cheap.
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const char* path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        bool Open(const char* path);
+        void Close();
+
+        bool Valid() const { return data_ != nullptr; }
+        const unsigned char* Data() const { return data_; }
+        size_t Size() const { return size_; }
+
+    private:
+        void Steal(MappedFile& other);
+
+    private:
+        const unsigned char* data_ = nullptr;
+        size_t size_ = 0;
+#ifdef _WIN32
+        void* file_ = nullptr;
+        void* mapping_ = nullptr;
+#else
+        int fd_ = -1;
+#endif
+    };
+}
+
+#endif // !_MAPPED_FILE_H
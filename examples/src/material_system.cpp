@@ -0,0 +1,302 @@
+#include "material_system.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace Utility::render
+{
+    namespace
+    {
+        size_t align_up(size_t value, size_t alignment)
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        // Base alignment and size of a parameter; the same under std140 and std430 for these types
+        void type_layout(ParameterType type, size_t& alignment, size_t& size)
+        {
+            switch (type)
+            {
+            case ParameterType::Float:
+            case ParameterType::Int:  alignment = 4;  size = 4;  break;
+            case ParameterType::Vec2: alignment = 8;  size = 8;  break;
+            case ParameterType::Vec3: alignment = 16; size = 12; break;
+            case ParameterType::Vec4: alignment = 16; size = 16; break;
+            case ParameterType::Mat4: alignment = 16; size = 64; break;
+            }
+        }
+    }
+
+    // ====================
+    //      LAYOUT
+    // ====================
+    MaterialLayout::MaterialLayout(std::string_view block_name, GLuint binding, BlockPacking packing)
+        : block_name_(block_name)
+        , binding_(binding)
+        , packing_(packing)
+    {
+        // std140 pads blocks to a vec4, std430 only to the largest member
+        alignment_ = packing == BlockPacking::Std140 ? 16 : 4;
+    }
+
+    MaterialLayout& MaterialLayout::Add(std::string_view name, ParameterType type)
+    {
+        size_t alignment = 4, bytes = 4;
+        type_layout(type, alignment, bytes);
+        size_t offset = align_up(size_, alignment);
+        parameters_.push_back({ StringId(name), std::string(name), type, (uint32_t)offset });
+        size_ = offset + bytes;
+        alignment_ = std::max(alignment_, alignment);
+        return *this;
+    }
+
+    MaterialLayout& MaterialLayout::AddTexture(std::string_view sampler_name, uint32_t unit, GLenum target)
+    {
+        textures_.push_back({ StringId(sampler_name), std::string(sampler_name), unit, target });
+        return *this;
+    }
+
+    const MaterialParameter* MaterialLayout::Find(StringId id) const
+    {
+        for (const MaterialParameter& parameter : parameters_)
+        {
+            if (parameter.id == id)
+                return &parameter;
+        }
+        return nullptr;
+    }
+
+    const MaterialTexture* MaterialLayout::FindTexture(StringId id) const
+    {
+        for (const MaterialTexture& texture : textures_)
+        {
+            if (texture.id == id)
+                return &texture;
+        }
+        return nullptr;
+    }
+
+    size_t MaterialLayout::Size() const
+    {
+        return align_up(std::max<size_t>(size_, 4), alignment_);
+    }
+
+    bool MaterialLayout::Prepare(GLuint program) const
+    {
+        for (const MaterialTexture& texture : textures_)
+            glProgramUniform1i(program, glGetUniformLocation(program, texture.name.c_str()), (GLint)texture.unit);
+
+        if (packing_ == BlockPacking::Std430)
+        {
+            if (!GLEW_ARB_shader_storage_buffer_object)
+            {
+                std::cerr << "ERROR::MATERIAL_LAYOUT::STORAGE_BLOCKS_NOT_SUPPORTED" << std::endl;
+                return false;
+            }
+            GLuint block = glGetProgramResourceIndex(program, GL_SHADER_STORAGE_BLOCK, block_name_.c_str());
+            if (block == GL_INVALID_INDEX)
+            {
+                std::cerr << "ERROR::MATERIAL_LAYOUT::BLOCK_NOT_FOUND: " << block_name_ << std::endl;
+                return false;
+            }
+            glShaderStorageBlockBinding(program, block, binding_);
+            return true;
+        }
+
+        GLuint block = glGetUniformBlockIndex(program, block_name_.c_str());
+        if (block == GL_INVALID_INDEX)
+        {
+            std::cerr << "ERROR::MATERIAL_LAYOUT::BLOCK_NOT_FOUND: " << block_name_ << std::endl;
+            return false;
+        }
+        glUniformBlockBinding(program, block, binding_);
+
+        // Members of a block with an instance name are reflected as "Block.member". Members the
+        // compiler dropped as unused report no index and are skipped.
+        bool matches = true;
+        for (const MaterialParameter& parameter : parameters_)
+        {
+            std::string qualified = block_name_ + "." + parameter.name;
+            const GLchar* names[2] = { qualified.c_str(), parameter.name.c_str() };
+            GLuint indices[2] = { GL_INVALID_INDEX, GL_INVALID_INDEX };
+            glGetUniformIndices(program, 2, names, indices);
+            GLuint index = indices[0] != GL_INVALID_INDEX ? indices[0] : indices[1];
+            if (index == GL_INVALID_INDEX)
+                continue;
+            GLint offset = -1;
+            glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_OFFSET, &offset);
+            if (offset != (GLint)parameter.offset)
+            {
+                std::cerr << "ERROR::MATERIAL_LAYOUT::OFFSET_MISMATCH: " << block_name_ << "." << parameter.name << " is at " << offset
+                          << " in the program, " << parameter.offset << " in the layout" << std::endl;
+                matches = false;
+            }
+        }
+        return matches;
+    }
+
+    // ====================
+    //   MATERIAL SYSTEM
+    // ====================
+    MaterialSystem::~MaterialSystem()
+    {
+        if (buffer_)
+            glDeleteBuffers(1, &buffer_);
+    }
+
+    MaterialSystem::LayoutId MaterialSystem::AddLayout(const MaterialLayout& layout)
+    {
+        layouts_.push_back(layout);
+        return (LayoutId)layouts_.size() - 1;
+    }
+
+    MaterialSystem::MaterialId MaterialSystem::Create(LayoutId layout)
+    {
+        if (layout >= layouts_.size())
+        {
+            std::cerr << "ERROR::MATERIAL_SYSTEM::INVALID_LAYOUT" << std::endl;
+            return kInvalidMaterial;
+        }
+
+        // Records are aligned for glBindBufferRange, so binding one is a plain offset
+        Material material;
+        material.layout = layout;
+        material.offset = align_up(staging_.size(), RecordAlignment());
+        material.textures.assign(layouts_[layout].Textures().size(), 0);
+        staging_.resize(material.offset + layouts_[layout].Size(), 0);
+        materials_.push_back(material);
+
+        dirty_begin_ = std::min(dirty_begin_, material.offset);
+        dirty_end_ = staging_.size();
+        return (MaterialId)materials_.size() - 1;
+    }
+
+    bool MaterialSystem::Set(MaterialId material, StringId name, float value)
+    {
+        return Write(material, name, ParameterType::Float, &value, sizeof(value));
+    }
+
+    bool MaterialSystem::Set(MaterialId material, StringId name, int value)
+    {
+        return Write(material, name, ParameterType::Int, &value, sizeof(value));
+    }
+
+    bool MaterialSystem::Set(MaterialId material, StringId name, const glm::vec2& value)
+    {
+        return Write(material, name, ParameterType::Vec2, &value, sizeof(value));
+    }
+
+    bool MaterialSystem::Set(MaterialId material, StringId name, const glm::vec3& value)
+    {
+        return Write(material, name, ParameterType::Vec3, &value, sizeof(value));
+    }
+
+    bool MaterialSystem::Set(MaterialId material, StringId name, const glm::vec4& value)
+    {
+        return Write(material, name, ParameterType::Vec4, &value, sizeof(value));
+    }
+
+    bool MaterialSystem::Set(MaterialId material, StringId name, const glm::mat4& value)
+    {
+        return Write(material, name, ParameterType::Mat4, &value, sizeof(value));
+    }
+
+    bool MaterialSystem::SetTexture(MaterialId material, StringId sampler, GLuint texture)
+    {
+        const std::vector<MaterialTexture>& textures = layouts_[materials_[material].layout].Textures();
+        for (size_t i = 0; i < textures.size(); ++i)
+        {
+            if (textures[i].id == sampler)
+            {
+                materials_[material].textures[i] = texture;
+                return true;
+            }
+        }
+        std::cerr << "ERROR::MATERIAL_SYSTEM::UNKNOWN_TEXTURE" << std::endl;
+        return false;
+    }
+
+    void MaterialSystem::Upload()
+    {
+        if (dirty_begin_ >= dirty_end_)
+            return;
+
+        GLenum target = GL_UNIFORM_BUFFER;
+        if (!buffer_)
+            glGenBuffers(1, &buffer_);
+        glBindBuffer(target, buffer_);
+        if (buffer_bytes_ < staging_.size())
+        {
+            // Grown: the whole buffer is specified again, with room for more materials
+            buffer_bytes_ = std::max(staging_.size(), buffer_bytes_ * 2);
+            glBufferData(target, buffer_bytes_, nullptr, GL_STATIC_DRAW);
+            dirty_begin_ = 0;
+            dirty_end_ = staging_.size();
+        }
+        glBufferSubData(target, dirty_begin_, dirty_end_ - dirty_begin_, staging_.data() + dirty_begin_);
+        glBindBuffer(target, 0);
+
+        dirty_begin_ = staging_.size();
+        dirty_end_ = 0;
+    }
+
+    void MaterialSystem::Bind(MaterialId material) const
+    {
+        const Material& record = materials_[material];
+        const MaterialLayout& layout = layouts_[record.layout];
+        GLenum target = layout.Packing() == BlockPacking::Std140 ? GL_UNIFORM_BUFFER : GL_SHADER_STORAGE_BUFFER;
+        glBindBufferRange(target, layout.Binding(), buffer_, record.offset, layout.Size());
+
+        for (size_t i = 0; i < record.textures.size(); ++i)
+        {
+            glActiveTexture(GL_TEXTURE0 + layout.Textures()[i].unit);
+            glBindTexture(layout.Textures()[i].target, record.textures[i]);
+        }
+    }
+
+    // ===============
+    // PRIVATE
+    // ===============
+    bool MaterialSystem::Write(MaterialId material, StringId name, ParameterType type, const void* value, size_t bytes)
+    {
+        if (material >= materials_.size())
+        {
+            std::cerr << "ERROR::MATERIAL_SYSTEM::INVALID_MATERIAL" << std::endl;
+            return false;
+        }
+
+        const Material& record = materials_[material];
+        const MaterialParameter* parameter = layouts_[record.layout].Find(name);
+        if (!parameter)
+        {
+            std::cerr << "ERROR::MATERIAL_SYSTEM::UNKNOWN_PARAMETER" << std::endl;
+            return false;
+        }
+        if (parameter->type != type)
+        {
+            std::cerr << "ERROR::MATERIAL_SYSTEM::TYPE_MISMATCH: " << parameter->name << std::endl;
+            return false;
+        }
+
+        size_t offset = record.offset + parameter->offset;
+        std::memcpy(staging_.data() + offset, value, bytes);
+        dirty_begin_ = std::min(dirty_begin_, offset);
+        dirty_end_ = std::max(dirty_end_, offset + bytes);
+        return true;
+    }
+
+    size_t MaterialSystem::RecordAlignment() const
+    {
+        if (alignment_)
+            return alignment_;
+
+        GLint uniform_alignment = 256;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniform_alignment);
+        GLint storage_alignment = 0;
+        if (GLEW_ARB_shader_storage_buffer_object)
+            glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storage_alignment);
+        size_t alignment = (size_t)std::max(std::max(uniform_alignment, storage_alignment), 16);
+        const_cast<MaterialSystem*>(this)->alignment_ = alignment;
+        return alignment;
+    }
+}
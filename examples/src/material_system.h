@@ -0,0 +1,154 @@
+#ifndef _MATERIAL_SYSTEM_H
+#define _MATERIAL_SYSTEM_H
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "string_id.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace Utility::render
+{
+    enum class ParameterType : uint8_t
+    {
+        Float,
+        Int,
+        Vec2,
+        Vec3,
+        Vec4,
+        Mat4
+    };
+
+    enum class BlockPacking
+    {
+        Std140,     // uniform block
+        Std430      // shader storage block (GL 4.3 / ARB_shader_storage_buffer_object)
+    };
+
+    struct MaterialParameter
+    {
+        StringId id;
+        std::string name;
+        ParameterType type;
+        uint32_t offset;        // bytes from the start of the block
+    };
+
+    // Samplers cannot live in a block; a material binds its textures to these units instead
+    struct MaterialTexture
+    {
+        StringId id;
+        std::string name;       // sampler uniform
+        uint32_t unit;
+        GLenum target;
+    };
+
+    // Parameter block of one shader variant. Parameters are added in the order the block declares
+    // them and get their offsets from the packing rules, e.g. for
+    //     layout (std140) uniform Material { vec3 color; float shininess; };
+    // Add("color", Vec3) lands at 0 and Add("shininess", Float) at 12.
+    class MaterialLayout
+    {
+    public:
+        MaterialLayout(std::string_view block_name, GLuint binding, BlockPacking packing = BlockPacking::Std140);
+
+        MaterialLayout& Add(std::string_view name, ParameterType type);
+        MaterialLayout& AddTexture(std::string_view sampler_name, uint32_t unit, GLenum target = GL_TEXTURE_2D);
+
+        const MaterialParameter* Find(StringId id) const;
+        const MaterialTexture* FindTexture(StringId id) const;
+        // Bytes of one record, padded to the block's alignment
+        size_t Size() const;
+
+        const std::string& BlockName() const { return block_name_; }
+        GLuint Binding() const { return binding_; }
+        BlockPacking Packing() const { return packing_; }
+        const std::vector<MaterialParameter>& Parameters() const { return parameters_; }
+        const std::vector<MaterialTexture>& Textures() const { return textures_; }
+
+        // Points the program's block at the layout's binding and its samplers at their units, then
+        // checks the offsets the program was linked with (std140 blocks) against the layout
+        bool Prepare(GLuint program) const;
+
+    private:
+        std::string block_name_;
+        GLuint binding_;
+        BlockPacking packing_;
+        std::vector<MaterialParameter> parameters_;
+        std::vector<MaterialTexture> textures_;
+        size_t size_ = 0;
+        size_t alignment_ = 4;
+    };
+
+    // Every material instance of every layout packed into one GL buffer. A material is an index;
+    // binding it is one glBindBufferRange to its record (plus its textures, if the layout has any)
+    // instead of a glUniform call per parameter, and draws sorted by SortKey switch programs once
+    // per layout and records once per material. Parameters are typed: setting one with a type
+    // other than the layout's fails. Needs a current GL context for its whole lifetime.
+    class MaterialSystem
+    {
+    public:
+        typedef uint32_t LayoutId;
+        typedef uint32_t MaterialId;
+        static const MaterialId kInvalidMaterial = 0xffffffffu;
+
+        MaterialSystem() = default;
+        ~MaterialSystem();
+
+        MaterialSystem(const MaterialSystem&) = delete;
+        MaterialSystem& operator=(const MaterialSystem&) = delete;
+
+        LayoutId AddLayout(const MaterialLayout& layout);
+        const MaterialLayout& Layout(LayoutId layout) const { return layouts_[layout]; }
+
+        // New material with every parameter zeroed and no textures
+        MaterialId Create(LayoutId layout);
+        LayoutId LayoutOf(MaterialId material) const { return materials_[material].layout; }
+        size_t MaterialCount() const { return materials_.size(); }
+
+        bool Set(MaterialId material, StringId name, float value);
+        bool Set(MaterialId material, StringId name, int value);
+        bool Set(MaterialId material, StringId name, const glm::vec2& value);
+        bool Set(MaterialId material, StringId name, const glm::vec3& value);
+        bool Set(MaterialId material, StringId name, const glm::vec4& value);
+        bool Set(MaterialId material, StringId name, const glm::mat4& value);
+        bool SetTexture(MaterialId material, StringId sampler, GLuint texture);
+
+        // Sends the changed records to the GPU; the buffer is reallocated when materials were added
+        void Upload();
+        // Binds the material's record to its layout's binding point and its textures
+        void Bind(MaterialId material) const;
+
+        // Orders draws by layout first, then by material
+        uint64_t SortKey(MaterialId material) const { return ((uint64_t)materials_[material].layout << 32) | material; }
+
+        GLuint Buffer() const { return buffer_; }
+        size_t Offset(MaterialId material) const { return materials_[material].offset; }
+        size_t BufferBytes() const { return staging_.size(); }
+
+    private:
+        struct Material
+        {
+            LayoutId layout;
+            size_t offset;                  // of the record in the buffer and in staging_
+            std::vector<GLuint> textures;   // by the layout's texture order
+        };
+
+        bool Write(MaterialId material, StringId name, ParameterType type, const void* value, size_t bytes);
+        size_t RecordAlignment() const;
+
+    private:
+        std::vector<MaterialLayout> layouts_;
+        std::vector<Material> materials_;
+        std::vector<uint8_t> staging_;      // CPU copy of the buffer
+        size_t dirty_begin_ = 0;            // byte range of staging_ changed since the last Upload
+        size_t dirty_end_ = 0;
+        GLuint buffer_ = 0;
+        size_t buffer_bytes_ = 0;
+        size_t alignment_ = 0;              // record alignment for glBindBufferRange, queried once
+    };
+}
+
+#endif // !_MATERIAL_SYSTEM_H
@@ -0,0 +1,396 @@
+#include "mesh_cooked.h"
+#include "mesh_optimizer.h"
+#include "mesh_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace Utility::mesh
+{
+    static_assert(sizeof(CookedHeader) == 32, "cooked header layout changed");
+    static_assert(sizeof(CookedLod) == 16, "cooked lod layout changed");
+    static_assert(sizeof(CookedMeshDesc) % 8 == 0, "cooked mesh descriptors must stay 8 byte aligned");
+
+    namespace
+    {
+        uint64_t align_up(uint64_t value)
+        {
+            return (value + kCookedAlignment - 1) & ~(uint64_t)(kCookedAlignment - 1);
+        }
+
+        // Bytes one vertex attribute reads, 0 for layouts the writer never produces
+        uint32_t attribute_bytes(const CookedAttribute& attribute)
+        {
+            if (attribute.components < 1 || attribute.components > 4)
+                return 0;
+            switch (attribute.type)
+            {
+            case GL_FLOAT:
+                return 4 * attribute.components;
+            case GL_HALF_FLOAT:
+            case GL_SHORT:
+            case GL_UNSIGNED_SHORT:
+                return 2 * attribute.components;
+            case GL_BYTE:
+            case GL_UNSIGNED_BYTE:
+                return attribute.components;
+            case GL_INT_2_10_10_10_REV:
+            case GL_UNSIGNED_INT_2_10_10_10_REV:
+                return attribute.components == 4 ? 4 : 0;
+            default:
+                return 0;
+            }
+        }
+
+        // offset + bytes <= size without overflowing on crafted offsets
+        bool fits(uint64_t offset, uint64_t bytes, uint64_t size)
+        {
+            return offset <= size && bytes <= size - offset;
+        }
+
+        // Every index of the list addresses one of the vertex_count vertices
+        template <typename Index>
+        bool indices_below(const unsigned char* data, uint32_t count, uint32_t vertex_count)
+        {
+            const Index* indices = (const Index*)data;
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                if (indices[i] >= vertex_count)
+                    return false;
+            }
+            return true;
+        }
+
+        struct CookedBlobs
+        {
+            std::vector<unsigned char> vertices;
+            std::vector<IndexBuffer> lods;
+        };
+
+        void fill_bounds(const MeshData& mesh, CookedMeshDesc& desc)
+        {
+            unsigned int stride = vertex_stride(mesh.attributes);
+            size_t count = mesh.VertexCount();
+            glm::vec3 min_bound(0.0f), max_bound(0.0f);
+            for (size_t i = 0; i < count; ++i)
+            {
+                glm::vec3 p(mesh.vertices[i * stride], mesh.vertices[i * stride + 1], mesh.vertices[i * stride + 2]);
+                min_bound = i == 0 ? p : glm::min(min_bound, p);
+                max_bound = i == 0 ? p : glm::max(max_bound, p);
+            }
+
+            glm::vec3 center = (min_bound + max_bound) * 0.5f;
+            float radius = 0.0f;
+            for (size_t i = 0; i < count; ++i)
+            {
+                glm::vec3 p(mesh.vertices[i * stride], mesh.vertices[i * stride + 1], mesh.vertices[i * stride + 2]);
+                radius = std::max(radius, glm::length(p - center));
+            }
+
+            for (int c = 0; c < 3; ++c)
+            {
+                desc.bounds_min[c] = min_bound[c];
+                desc.bounds_max[c] = max_bound[c];
+                desc.center[c] = center[c];
+            }
+            desc.radius = radius;
+        }
+
+        IndexBuffer make_lod_indices(const std::vector<unsigned int>& indices, GLenum type)
+        {
+            IndexBuffer buffer;
+            buffer.type = type;
+            if (type == GL_UNSIGNED_SHORT)
+            {
+                buffer.data.resize(indices.size() * sizeof(unsigned short));
+                unsigned short* out = (unsigned short*)buffer.data.data();
+                for (size_t i = 0; i < indices.size(); ++i)
+                    out[i] = (unsigned short)indices[i];
+            }
+            else
+            {
+                buffer.data.resize(indices.size() * sizeof(unsigned int));
+                std::memcpy(buffer.data.data(), indices.data(), buffer.data.size());
+            }
+            return buffer;
+        }
+    }
+
+    bool write_cooked_meshes(const char* path, const std::vector<CookedMeshSource>& meshes, const CookOptions& options)
+    {
+        if (meshes.empty())
+        {
+            std::cerr << "Nothing to cook into " << path << std::endl;
+            return false;
+        }
+
+        VertexFormatOptions float_format;
+        float_format.quantize_positions = false;
+        float_format.normals = NormalEncoding::Float3;
+        float_format.half_uvs = false;
+        const VertexFormatOptions& format_options = options.packed ? options.format : float_format;
+
+        std::vector<CookedMeshDesc> descs(meshes.size());
+        std::vector<CookedBlobs> blobs(meshes.size());
+        uint64_t offset = align_up(sizeof(CookedHeader) + descs.size() * sizeof(CookedMeshDesc));
+
+        for (size_t m = 0; m < meshes.size(); ++m)
+        {
+            MeshData mesh = meshes[m].mesh;
+            std::vector<std::vector<unsigned int>> lods = meshes[m].lods;
+            if (lods.size() + 1 > kCookedMaxLods)
+                lods.resize(kCookedMaxLods - 1);
+
+            if (options.optimize)
+            {
+                // The LODs index the same vertex buffer, so their vertex order has to stay put
+                if (lods.empty())
+                    optimize(mesh);
+                else
+                {
+                    optimize_vertex_cache(mesh.indices, mesh.VertexCount());
+                    for (std::vector<unsigned int>& lod : lods)
+                        optimize_vertex_cache(lod, mesh.VertexCount());
+                }
+            }
+
+            PackedMesh packed = compile_vertex_format(mesh, format_options);
+            CookedMeshDesc& desc = descs[m];
+            std::memset(&desc, 0, sizeof(desc));
+            desc.attributes = mesh.attributes;
+            desc.vertex_count = (uint32_t)packed.VertexCount();
+            desc.vertex_stride = (uint32_t)packed.format.stride;
+            desc.attribute_count = (uint32_t)packed.format.layout.size();
+            for (size_t a = 0; a < packed.format.layout.size(); ++a)
+            {
+                const VertexAttributeLayout& attribute = packed.format.layout[a];
+                desc.layout[a] = { attribute.location, (uint32_t)attribute.components, attribute.type, attribute.normalized, attribute.offset };
+            }
+            for (int c = 0; c < 3; ++c)
+            {
+                desc.position_offset[c] = packed.format.position_offset[c];
+                desc.position_scale[c] = packed.format.position_scale[c];
+            }
+            fill_bounds(mesh, desc);
+
+            desc.vertex_offset = offset;
+            desc.vertex_bytes = packed.vertices.size();
+            offset = align_up(offset + desc.vertex_bytes);
+            blobs[m].vertices.swap(packed.vertices);
+
+            // every LOD shares the index type so one EBO holds them all
+            desc.index_type = desc.vertex_count <= 0xFFFF ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+            desc.lod_count = (uint32_t)(lods.size() + 1);
+            for (uint32_t l = 0; l < desc.lod_count; ++l)
+            {
+                const std::vector<unsigned int>& indices = l == 0 ? mesh.indices : lods[l - 1];
+                blobs[m].lods.push_back(make_lod_indices(indices, desc.index_type));
+                desc.lods[l].index_offset = offset;
+                desc.lods[l].index_count = (uint32_t)indices.size();
+                desc.lods[l].error = l == 0 || l - 1 >= meshes[m].lod_errors.size() ? 0.0f : meshes[m].lod_errors[l - 1];
+                offset = align_up(offset + blobs[m].lods.back().data.size());
+            }
+        }
+
+        CookedHeader header;
+        std::memset(&header, 0, sizeof(header));
+        header.magic = kCookedMagic;
+        header.version = kCookedVersion;
+        header.mesh_count = (uint32_t)descs.size();
+        header.header_size = sizeof(CookedHeader);
+        header.file_size = offset;
+        header.mesh_desc_size = sizeof(CookedMeshDesc);
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "Failed to create cooked mesh file: " << path << std::endl;
+            return false;
+        }
+
+        const char padding[kCookedAlignment] = {};
+        uint64_t written = 0;
+        auto write = [&](const void* data, uint64_t size, uint64_t at) {
+            file.write(padding, at - written);
+            file.write((const char*)data, size);
+            written = at + size;
+        };
+
+        write(&header, sizeof(header), 0);
+        write(descs.data(), descs.size() * sizeof(CookedMeshDesc), sizeof(header));
+        for (size_t m = 0; m < descs.size(); ++m)
+        {
+            write(blobs[m].vertices.data(), blobs[m].vertices.size(), descs[m].vertex_offset);
+            for (uint32_t l = 0; l < descs[m].lod_count; ++l)
+                write(blobs[m].lods[l].data.data(), blobs[m].lods[l].data.size(), descs[m].lods[l].index_offset);
+        }
+        file.write(padding, header.file_size - written);
+
+        if (!file)
+        {
+            std::cerr << "Failed to write cooked mesh file: " << path << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    void CookedMeshBuffers::Draw(unsigned int lod) const
+    {
+        if (lods.empty())
+            return;
+
+        const CookedLod& level = lods[std::min<size_t>(lod, lods.size() - 1)];
+        glBindVertexArray(vao);
+        glDrawElements(GL_TRIANGLES, level.index_count, index_type, (GLvoid*)(size_t)level.index_offset);
+    }
+
+    void CookedMeshBuffers::Release()
+    {
+        glDeleteVertexArrays(1, &vao);
+        glDeleteBuffers(1, &vbo);
+        glDeleteBuffers(1, &ebo);
+        vao = vbo = ebo = 0;
+        lods.clear();
+    }
+
+    CookedMeshFile::CookedMeshFile(const char* path)
+    {
+        Open(path);
+    }
+
+    bool CookedMeshFile::Open(const char* path)
+    {
+        meshes_ = nullptr;
+        mesh_count_ = 0;
+        if (!file_.Open(path))
+            return false;
+
+        const unsigned char* data = file_.Data();
+        uint64_t size = file_.Size();
+
+        CookedHeader header;
+        if (size < sizeof(header))
+        {
+            std::cerr << "Not a cooked mesh file: " << path << std::endl;
+            return false;
+        }
+        std::memcpy(&header, data, sizeof(header));
+        if (header.magic != kCookedMagic || header.version != kCookedVersion || header.file_size != size
+            || header.header_size < sizeof(CookedHeader) || header.header_size % 8 != 0 || header.mesh_desc_size != sizeof(CookedMeshDesc)
+            || header.header_size + (uint64_t)header.mesh_count * sizeof(CookedMeshDesc) > size)
+        {
+            std::cerr << "Unsupported or corrupt cooked mesh file: " << path << std::endl;
+            return false;
+        }
+
+        const CookedMeshDesc* meshes = (const CookedMeshDesc*)(data + header.header_size);
+        for (uint32_t m = 0; m < header.mesh_count; ++m)
+        {
+            const CookedMeshDesc& desc = meshes[m];
+            bool valid = desc.attribute_count >= 1 && desc.attribute_count <= kCookedMaxAttributes
+                && desc.lod_count >= 1 && desc.lod_count <= kCookedMaxLods
+                && (desc.index_type == GL_UNSIGNED_SHORT || desc.index_type == GL_UNSIGNED_INT)
+                && desc.vertex_offset % kCookedAlignment == 0 && fits(desc.vertex_offset, desc.vertex_bytes, size)
+                && (uint64_t)desc.vertex_count * desc.vertex_stride == desc.vertex_bytes;
+
+            // Every attribute has to be read from inside its vertex
+            for (uint32_t a = 0; valid && a < desc.attribute_count; ++a)
+            {
+                const CookedAttribute& attribute = desc.layout[a];
+                uint32_t bytes = attribute_bytes(attribute);
+                valid = bytes != 0 && attribute.location < 16 && fits(attribute.offset, bytes, desc.vertex_stride);
+            }
+
+            // The LODs follow the vertices back to back in one index block, which Upload copies as
+            // a whole and addresses relative to the first LOD
+            size_t index_size = desc.index_type == GL_UNSIGNED_SHORT ? 2 : 4;
+            uint64_t block_end = desc.vertex_offset + desc.vertex_bytes;
+            for (uint32_t l = 0; valid && l < desc.lod_count; ++l)
+            {
+                const CookedLod& lod = desc.lods[l];
+                uint64_t bytes = (uint64_t)lod.index_count * index_size;
+                valid = lod.index_offset % kCookedAlignment == 0 && lod.index_offset >= block_end && fits(lod.index_offset, bytes, size);
+                block_end = lod.index_offset + bytes;
+
+                // An index past the vertices would make the GPU fetch outside the VBO, so the
+                // payload is scanned once here instead of trusting the writer
+                if (valid)
+                    valid = desc.index_type == GL_UNSIGNED_SHORT ? indices_below<uint16_t>(data + lod.index_offset, lod.index_count, desc.vertex_count)
+                                                                 : indices_below<uint32_t>(data + lod.index_offset, lod.index_count, desc.vertex_count);
+            }
+
+            if (!valid)
+            {
+                std::cerr << "Corrupt mesh " << m << " in cooked mesh file: " << path << std::endl;
+                return false;
+            }
+        }
+
+        meshes_ = meshes;
+        mesh_count_ = header.mesh_count;
+        return true;
+    }
+
+    const CookedMeshDesc& CookedMeshFile::Mesh(size_t index) const
+    {
+        return meshes_[index];
+    }
+
+    const unsigned char* CookedMeshFile::VertexData(size_t index) const
+    {
+        return file_.Data() + meshes_[index].vertex_offset;
+    }
+
+    const unsigned char* CookedMeshFile::IndexData(size_t index, unsigned int lod) const
+    {
+        return file_.Data() + meshes_[index].lods[lod].index_offset;
+    }
+
+    bool CookedMeshFile::Upload(size_t index, CookedMeshBuffers& buffers) const
+    {
+        if (index >= mesh_count_)
+            return false;
+
+        const CookedMeshDesc& desc = meshes_[index];
+
+        buffers.index_type = desc.index_type;
+        buffers.format = PackedVertexFormat();
+        buffers.format.attributes = desc.attributes;
+        buffers.format.stride = (GLsizei)desc.vertex_stride;
+        for (uint32_t a = 0; a < desc.attribute_count; ++a)
+        {
+            const CookedAttribute& attribute = desc.layout[a];
+            buffers.format.layout.push_back({ attribute.location, (GLint)attribute.components, attribute.type, (GLboolean)attribute.normalized, attribute.offset });
+        }
+        buffers.format.position_offset = glm::vec3(desc.position_offset[0], desc.position_offset[1], desc.position_offset[2]);
+        buffers.format.position_scale = glm::vec3(desc.position_scale[0], desc.position_scale[1], desc.position_scale[2]);
+
+        // The LOD index blobs are laid out back to back, so one upload covers all of them
+        uint64_t first = desc.lods[0].index_offset;
+        uint64_t last = first;
+        size_t index_size = desc.index_type == GL_UNSIGNED_SHORT ? 2 : 4;
+        buffers.lods.assign(desc.lods, desc.lods + desc.lod_count);
+        for (CookedLod& lod : buffers.lods)
+        {
+            last = std::max<uint64_t>(last, lod.index_offset + (uint64_t)lod.index_count * index_size);
+            lod.index_offset -= first;
+        }
+
+        glGenVertexArrays(1, &buffers.vao);
+        glBindVertexArray(buffers.vao);
+
+        glGenBuffers(1, &buffers.vbo);
+        glBindBuffer(GL_ARRAY_BUFFER, buffers.vbo);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)desc.vertex_bytes, VertexData(index), GL_STATIC_DRAW);
+
+        glGenBuffers(1, &buffers.ebo);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers.ebo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)(last - first), file_.Data() + first, GL_STATIC_DRAW);
+
+        buffers.format.Apply();
+        glBindVertexArray(0);
+        return true;
+    }
+}
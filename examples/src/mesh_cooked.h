@@ -0,0 +1,134 @@
+#ifndef _MESH_COOKED_H
+#define _MESH_COOKED_H
+
+#include "mesh_library.h"
+#include "vertex_format.h"
+#include "mapped_file.h"
+
+namespace Utility::mesh
+{
+    // ====================
+    //     FILE LAYOUT
+    // ====================
+    // Little endian, every struct and blob starts on a kCookedAlignment boundary so the
+    // vertex and index data can be handed to glBufferData straight from the mapping.
+    //
+    //   CookedHeader
+    //   CookedMeshDesc[mesh_count]
+    //   vertex and index blobs
+    const uint32_t kCookedMagic = 0x4B4F4F43; // "COOK"
+    const uint32_t kCookedVersion = 1;
+    const uint32_t kCookedAlignment = 16;
+    const uint32_t kCookedMaxAttributes = 4;
+    const uint32_t kCookedMaxLods = 8;
+
+    struct CookedHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t mesh_count;
+        uint32_t header_size;     // sizeof(CookedHeader), lets readers skip fields added later
+        uint64_t file_size;
+        uint32_t mesh_desc_size;  // sizeof(CookedMeshDesc)
+        uint32_t reserved;
+    };
+
+    struct CookedAttribute
+    {
+        uint32_t location;
+        uint32_t components;
+        uint32_t type;
+        uint32_t normalized;
+        uint32_t offset;
+    };
+
+    struct CookedLod
+    {
+        uint64_t index_offset;    // from the start of the file
+        uint32_t index_count;
+        float error;              // object space simplification error, 0 for the full mesh
+    };
+
+    struct CookedMeshDesc
+    {
+        uint32_t attributes;      // Utility::mesh::Attribute mask
+        uint32_t vertex_count;
+        uint32_t vertex_stride;   // bytes
+        uint32_t attribute_count;
+        CookedAttribute layout[kCookedMaxAttributes];
+        float position_offset[3]; // decode for quantized positions, identity otherwise
+        float position_scale[3];
+        float bounds_min[3];
+        float bounds_max[3];
+        float center[3];
+        float radius;             // bounding sphere around center
+        uint64_t vertex_offset;   // from the start of the file
+        uint64_t vertex_bytes;
+        uint32_t index_type;      // GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, shared by all LODs
+        uint32_t lod_count;
+        CookedLod lods[kCookedMaxLods];
+    };
+
+    // ====================
+    //       COOKING
+    // ====================
+    struct CookedMeshSource
+    {
+        MeshData mesh;                                   // LOD 0 uses mesh.indices
+        std::vector<std::vector<unsigned int>> lods;     // coarser levels over the same vertices
+        std::vector<float> lod_errors;                   // one per entry in lods
+    };
+
+    struct CookOptions
+    {
+        bool optimize = true;          // vertex cache, overdraw and fetch order
+        bool packed = false;           // quantized vertex format instead of floats
+        VertexFormatOptions format;
+    };
+
+    bool write_cooked_meshes(const char* path, const std::vector<CookedMeshSource>& meshes, const CookOptions& options = CookOptions());
+
+    // ====================
+    //       LOADING
+    // ====================
+    // GL buffers of one cooked mesh
+    struct CookedMeshBuffers
+    {
+        GLuint vao = 0;
+        GLuint vbo = 0;
+        GLuint ebo = 0;
+        GLenum index_type = GL_UNSIGNED_INT;
+        PackedVertexFormat format;
+        std::vector<CookedLod> lods;     // index_offset relative to the start of the EBO
+
+        void Draw(unsigned int lod = 0) const;
+        void Release();
+    };
+
+    // Memory mapped cooked mesh file; the descriptors and blobs are read in place. Open rejects
+    // files whose ranges, layouts or indices would make a draw read outside them.
+    class CookedMeshFile
+    {
+    public:
+        CookedMeshFile() = default;
+        explicit CookedMeshFile(const char* path);
+
+        bool Open(const char* path);
+        bool Valid() const { return mesh_count_ != 0; }
+
+        size_t MeshCount() const { return mesh_count_; }
+        const CookedMeshDesc& Mesh(size_t index) const;
+        const unsigned char* VertexData(size_t index) const;
+        const unsigned char* IndexData(size_t index, unsigned int lod) const;
+
+        // Creates the VAO/VBO/EBO of a mesh, the GL copies are made directly from the mapping
+        bool Upload(size_t index, CookedMeshBuffers& buffers) const;
+
+    private:
+        MappedFile file_;
+        const CookedMeshDesc* meshes_ = nullptr;
+        size_t mesh_count_ = 0;
+    };
+}
+
+#endif // !_MESH_COOKED_H
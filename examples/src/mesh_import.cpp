@@ -0,0 +1,1143 @@
+#include "mesh_import.h"
+#include "mesh_utils.h"
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+namespace Utility::mesh
+{
+    namespace
+    {
+        typedef std::chrono::high_resolution_clock Clock;
+
+        double milliseconds_since(Clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+
+        bool is_space(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+
+        bool is_digit(char c)
+        {
+            return (unsigned)(c - '0') < 10;
+        }
+
+        const char* skip_spaces(const char* p, const char* end)
+        {
+            while (p < end && is_space(*p))
+                ++p;
+            return p;
+        }
+
+        bool parse_int(const char*& cursor, const char* end, long long& value)
+        {
+            const char* p = cursor;
+            bool negative = false;
+            if (p < end && (*p == '-' || *p == '+'))
+                negative = *p++ == '-';
+            if (p == end || !is_digit(*p))
+                return false;
+
+            long long result = 0;
+            while (p < end && is_digit(*p))
+                result = result * 10 + (*p++ - '0');
+
+            value = negative ? -result : result;
+            cursor = p;
+            return true;
+        }
+
+        void fill_import_report(ImportReport* report, size_t bytes, unsigned int threads, const MeshData* meshes, size_t mesh_count, Clock::time_point start)
+        {
+            if (!report)
+                return;
+
+            report->bytes = bytes;
+            report->threads = threads;
+            report->meshes = mesh_count;
+            report->vertices = 0;
+            report->triangles = 0;
+            for (size_t i = 0; i < mesh_count; ++i)
+            {
+                report->vertices += meshes[i].VertexCount();
+                report->triangles += meshes[i].indices.size() / 3;
+            }
+            report->milliseconds = milliseconds_since(start);
+        }
+
+        // ====================
+        //        OBJ
+        // ====================
+        const long long kNoIndex = -(1LL << 62);
+        // Negative OBJ indices are relative to the elements read so far, which a chunk only knows locally.
+        // They are stored as kRelative + local index and rebased once every chunk's element count is known.
+        const long long kRelative = -(1LL << 60);
+
+        struct ObjChunk
+        {
+            std::vector<float> positions;  // xyz
+            std::vector<float> texcoords;  // uv
+            std::vector<float> normals;    // xyz
+            std::vector<long long> corners; // position, texcoord, normal index per triangle corner
+            size_t bad_lines = 0;
+        };
+
+        long long encode_obj_index(long long index, size_t local_count)
+        {
+            if (index > 0)
+                return index - 1;
+            return kRelative + (long long)local_count + index;
+        }
+
+        bool parse_obj_corner(const char*& cursor, const char* end, const ObjChunk& chunk, long long corner[3])
+        {
+            const char* p = cursor;
+            long long value;
+            if (!parse_int(p, end, value) || value == 0)
+                return false;
+            corner[0] = encode_obj_index(value, chunk.positions.size() / 3);
+            corner[1] = kNoIndex;
+            corner[2] = kNoIndex;
+
+            if (p < end && *p == '/')
+            {
+                ++p;
+                if (p < end && *p != '/')
+                {
+                    if (!parse_int(p, end, value) || value == 0)
+                        return false;
+                    corner[1] = encode_obj_index(value, chunk.texcoords.size() / 2);
+                }
+                if (p < end && *p == '/')
+                {
+                    ++p;
+                    if (!parse_int(p, end, value) || value == 0)
+                        return false;
+                    corner[2] = encode_obj_index(value, chunk.normals.size() / 3);
+                }
+            }
+
+            cursor = p;
+            return true;
+        }
+
+        // The whole record is parsed before anything is appended, so a short line leaves no
+        // partial vertex behind to shift the ones after it
+        bool parse_obj_vec3(const char* p, const char* end, std::vector<float>& out)
+        {
+            float values[3];
+            for (float& value : values)
+            {
+                p = skip_spaces(p, end);
+                const char* start = p;
+                value = parse_float(p, end);
+                if (p == start)
+                    return false;
+            }
+            out.insert(out.end(), values, values + 3);
+            return true;
+        }
+
+        // u is required, a missing v defaults to 0
+        bool parse_obj_texcoord(const char* p, const char* end, std::vector<float>& out)
+        {
+            p = skip_spaces(p, end);
+            const char* start = p;
+            float u = parse_float(p, end);
+            if (p == start)
+                return false;
+
+            p = skip_spaces(p, end);
+            float v = parse_float(p, end);
+            out.push_back(u);
+            out.push_back(v);
+            return true;
+        }
+
+        void parse_obj_chunk(const char* begin, const char* end, ObjChunk& chunk)
+        {
+            std::vector<long long> polygon;
+            const char* p = begin;
+            while (p < end)
+            {
+                const char* line_end = (const char*)std::memchr(p, '\n', end - p);
+                if (!line_end)
+                    line_end = end;
+
+                p = skip_spaces(p, line_end);
+                if (line_end - p >= 2 && p[0] == 'v')
+                {
+                    bool ok = true;
+                    if (is_space(p[1]))
+                        ok = parse_obj_vec3(p + 1, line_end, chunk.positions);
+                    else if (p[1] == 't')
+                        ok = parse_obj_texcoord(p + 2, line_end, chunk.texcoords);
+                    else if (p[1] == 'n')
+                        ok = parse_obj_vec3(p + 2, line_end, chunk.normals);
+
+                    if (!ok)
+                        ++chunk.bad_lines;
+                }
+                else if (line_end - p >= 2 && p[0] == 'f' && is_space(p[1]))
+                {
+                    polygon.clear();
+                    const char* q = p + 1;
+                    bool ok = true;
+                    while (true)
+                    {
+                        q = skip_spaces(q, line_end);
+                        if (q == line_end || *q == '#')
+                            break;
+                        long long corner[3];
+                        if (!parse_obj_corner(q, line_end, chunk, corner))
+                        {
+                            ok = false;
+                            break;
+                        }
+                        polygon.insert(polygon.end(), corner, corner + 3);
+                    }
+
+                    size_t corners = polygon.size() / 3;
+                    if (!ok || corners < 3)
+                        ++chunk.bad_lines;
+                    else
+                    {
+                        for (size_t k = 1; k + 1 < corners; ++k)
+                        {
+                            chunk.corners.insert(chunk.corners.end(), polygon.begin(), polygon.begin() + 3);
+                            chunk.corners.insert(chunk.corners.end(), polygon.begin() + k * 3, polygon.begin() + k * 3 + 6);
+                        }
+                    }
+                }
+
+                p = line_end + 1;
+            }
+        }
+
+        long long resolve_obj_index(long long value, size_t base)
+        {
+            if (value == kNoIndex)
+                return -1;
+            if (value < kRelative / 2)
+                return (long long)base + (value - kRelative);
+            return value;
+        }
+
+        // Open addressing table from (position, texcoord, normal) index triples to output vertices
+        class CornerTable
+        {
+        public:
+            explicit CornerTable(size_t expected)
+            {
+                size_t capacity = 16;
+                while (capacity < expected * 2)
+                    capacity *= 2;
+                slots_.assign(capacity, ~0u);
+            }
+
+            // Returns the output vertex for the corner and whether it was just added
+            unsigned int Insert(const long long key[3], bool& added)
+            {
+                uint64_t hash = (uint64_t)key[0] * 0x9E3779B97F4A7C15ull ^ (uint64_t)key[1] * 0xC2B2AE3D27D4EB4Full ^ (uint64_t)key[2] * 0x165667B19E3779F9ull;
+                size_t mask = slots_.size() - 1;
+                size_t slot = (size_t)(hash ^ (hash >> 29)) & mask;
+                while (slots_[slot] != ~0u)
+                {
+                    const long long* other = &keys_[(size_t)slots_[slot] * 3];
+                    if (other[0] == key[0] && other[1] == key[1] && other[2] == key[2])
+                    {
+                        added = false;
+                        return slots_[slot];
+                    }
+                    slot = (slot + 1) & mask;
+                }
+
+                unsigned int index = (unsigned int)(keys_.size() / 3);
+                keys_.insert(keys_.end(), key, key + 3);
+                slots_[slot] = index;
+                added = true;
+                return index;
+            }
+
+        private:
+            std::vector<unsigned int> slots_;
+            std::vector<long long> keys_;
+        };
+
+        // ====================
+        //        JSON
+        // ====================
+        // Just enough JSON for glTF documents
+        struct Json
+        {
+            enum Type { Null, Bool, Number, String, Array, Object };
+
+            Type type = Null;
+            bool boolean = false;
+            double number = 0.0;
+            std::string string;
+            std::vector<Json> array;
+            std::vector<std::pair<std::string, Json>> object;
+
+            const Json* Find(const char* key) const
+            {
+                for (const auto& member : object)
+                {
+                    if (member.first == key)
+                        return &member.second;
+                }
+                return nullptr;
+            }
+
+            double NumberOr(const char* key, double fallback) const
+            {
+                const Json* value = Find(key);
+                return value && value->type == Number ? value->number : fallback;
+            }
+
+            const Json& At(size_t index) const
+            {
+                static const Json null;
+                return index < array.size() ? array[index] : null;
+            }
+        };
+
+        // Member that has to be a whole, non negative number fitting size_t (counts, offsets,
+        // indices); fallback when it is missing, false for anything else
+        bool get_size(const Json& object, const char* key, size_t fallback, size_t& value)
+        {
+            const Json* member = object.Find(key);
+            if (!member)
+            {
+                value = fallback;
+                return true;
+            }
+            double number = member->number;
+            if (member->type != Json::Number || !(number >= 0.0) || number != std::floor(number)
+                || number >= (double)std::numeric_limits<size_t>::max())
+                return false;
+            value = (size_t)number;
+            return true;
+        }
+
+        class JsonParser
+        {
+        public:
+            JsonParser(const char* begin, const char* end) : p_(begin), end_(end) {}
+
+            bool Parse(Json& value)
+            {
+                if (!ParseValue(value, 0))
+                    return false;
+                SkipSpaces();
+                return p_ == end_ || *p_ == '\0';
+            }
+
+        private:
+            void SkipSpaces()
+            {
+                while (p_ < end_ && (*p_ == ' ' || *p_ == '\t' || *p_ == '\r' || *p_ == '\n'))
+                    ++p_;
+            }
+
+            bool Literal(const char* text)
+            {
+                size_t length = std::strlen(text);
+                if ((size_t)(end_ - p_) < length || std::memcmp(p_, text, length) != 0)
+                    return false;
+                p_ += length;
+                return true;
+            }
+
+            bool ParseValue(Json& value, int depth)
+            {
+                if (depth > 64)
+                    return false;
+
+                SkipSpaces();
+                if (p_ == end_)
+                    return false;
+
+                switch (*p_)
+                {
+                case '{':
+                    return ParseObject(value, depth);
+                case '[':
+                    return ParseArray(value, depth);
+                case '"':
+                    value.type = Json::String;
+                    return ParseString(value.string);
+                case 't':
+                    value.type = Json::Bool;
+                    value.boolean = true;
+                    return Literal("true");
+                case 'f':
+                    value.type = Json::Bool;
+                    return Literal("false");
+                case 'n':
+                    return Literal("null");
+                default:
+                    value.type = Json::Number;
+                    return ParseNumber(value.number);
+                }
+            }
+
+            bool ParseObject(Json& value, int depth)
+            {
+                value.type = Json::Object;
+                ++p_;
+                SkipSpaces();
+                if (p_ < end_ && *p_ == '}')
+                {
+                    ++p_;
+                    return true;
+                }
+
+                while (true)
+                {
+                    SkipSpaces();
+                    std::string key;
+                    if (p_ == end_ || *p_ != '"' || !ParseString(key))
+                        return false;
+                    SkipSpaces();
+                    if (p_ == end_ || *p_++ != ':')
+                        return false;
+
+                    value.object.emplace_back(std::move(key), Json());
+                    if (!ParseValue(value.object.back().second, depth + 1))
+                        return false;
+
+                    SkipSpaces();
+                    if (p_ == end_)
+                        return false;
+                    char c = *p_++;
+                    if (c == '}')
+                        return true;
+                    if (c != ',')
+                        return false;
+                }
+            }
+
+            bool ParseArray(Json& value, int depth)
+            {
+                value.type = Json::Array;
+                ++p_;
+                SkipSpaces();
+                if (p_ < end_ && *p_ == ']')
+                {
+                    ++p_;
+                    return true;
+                }
+
+                while (true)
+                {
+                    value.array.emplace_back();
+                    if (!ParseValue(value.array.back(), depth + 1))
+                        return false;
+
+                    SkipSpaces();
+                    if (p_ == end_)
+                        return false;
+                    char c = *p_++;
+                    if (c == ']')
+                        return true;
+                    if (c != ',')
+                        return false;
+                }
+            }
+
+            bool ParseString(std::string& out)
+            {
+                ++p_;
+                while (p_ < end_ && *p_ != '"')
+                {
+                    char c = *p_++;
+                    if (c != '\\')
+                    {
+                        out.push_back(c);
+                        continue;
+                    }
+                    if (p_ == end_)
+                        return false;
+
+                    c = *p_++;
+                    switch (c)
+                    {
+                    case 'b': out.push_back('\b'); break;
+                    case 'f': out.push_back('\f'); break;
+                    case 'n': out.push_back('\n'); break;
+                    case 'r': out.push_back('\r'); break;
+                    case 't': out.push_back('\t'); break;
+                    case 'u':
+                    {
+                        if (end_ - p_ < 4)
+                            return false;
+                        unsigned int code = (unsigned int)std::strtoul(std::string(p_, 4).c_str(), nullptr, 16);
+                        p_ += 4;
+                        // UTF-8, surrogate pairs are not combined
+                        if (code < 0x80)
+                            out.push_back((char)code);
+                        else if (code < 0x800)
+                        {
+                            out.push_back((char)(0xC0 | (code >> 6)));
+                            out.push_back((char)(0x80 | (code & 0x3F)));
+                        }
+                        else
+                        {
+                            out.push_back((char)(0xE0 | (code >> 12)));
+                            out.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+                            out.push_back((char)(0x80 | (code & 0x3F)));
+                        }
+                        break;
+                    }
+                    default:
+                        out.push_back(c);
+                        break;
+                    }
+                }
+
+                if (p_ == end_)
+                    return false;
+                ++p_;
+                return true;
+            }
+
+            bool ParseNumber(double& number)
+            {
+                char buffer[64];
+                size_t length = 0;
+                while (p_ < end_ && length + 1 < sizeof(buffer) && (is_digit(*p_) || *p_ == '-' || *p_ == '+' || *p_ == '.' || *p_ == 'e' || *p_ == 'E'))
+                    buffer[length++] = *p_++;
+                buffer[length] = '\0';
+
+                char* parsed_end;
+                number = std::strtod(buffer, &parsed_end);
+                return length > 0 && parsed_end == buffer + length;
+            }
+
+        private:
+            const char* p_;
+            const char* end_;
+        };
+
+        // ====================
+        //        GLTF
+        // ====================
+        enum ComponentType
+        {
+            Byte = 5120,
+            UnsignedByte = 5121,
+            Short = 5122,
+            UnsignedShort = 5123,
+            UnsignedInt = 5125,
+            Float = 5126
+        };
+
+        size_t component_size(int type)
+        {
+            switch (type)
+            {
+            case Byte:
+            case UnsignedByte: return 1;
+            case Short:
+            case UnsignedShort: return 2;
+            case UnsignedInt:
+            case Float: return 4;
+            default: return 0;
+            }
+        }
+
+        int component_count(const std::string& type)
+        {
+            if (type == "SCALAR") return 1;
+            if (type == "VEC2") return 2;
+            if (type == "VEC3") return 3;
+            if (type == "VEC4") return 4;
+            return 0;
+        }
+
+        struct BufferRange
+        {
+            const unsigned char* data = nullptr;
+            size_t size = 0;
+        };
+
+        // Strided window into a mapped buffer; nothing is copied until the values are read
+        struct AccessorView
+        {
+            const unsigned char* data = nullptr;
+            size_t count = 0;
+            size_t stride = 0;
+            int component_type = 0;
+            int components = 0;
+            bool normalized = false;
+
+            float Component(size_t element, int component) const
+            {
+                const unsigned char* src = data + element * stride + component * component_size(component_type);
+                switch (component_type)
+                {
+                case Float: { float v; std::memcpy(&v, src, 4); return v; }
+                case UnsignedByte: return normalized ? *src / 255.0f : (float)*src;
+                case Byte: { signed char v = (signed char)*src; return normalized ? std::max(v / 127.0f, -1.0f) : (float)v; }
+                case UnsignedShort: { unsigned short v; std::memcpy(&v, src, 2); return normalized ? v / 65535.0f : (float)v; }
+                case Short: { short v; std::memcpy(&v, src, 2); return normalized ? std::max(v / 32767.0f, -1.0f) : (float)v; }
+                case UnsignedInt: { unsigned int v; std::memcpy(&v, src, 4); return (float)v; }
+                default: return 0.0f;
+                }
+            }
+
+            unsigned int Index(size_t element) const
+            {
+                const unsigned char* src = data + element * stride;
+                switch (component_type)
+                {
+                case UnsignedByte: return *src;
+                case UnsignedShort: { unsigned short v; std::memcpy(&v, src, 2); return v; }
+                case UnsignedInt: { unsigned int v; std::memcpy(&v, src, 4); return v; }
+                default: return 0;
+                }
+            }
+        };
+
+        struct GltfDocument
+        {
+            Json json;
+            std::vector<BufferRange> buffers;
+        };
+
+        bool get_accessor(const GltfDocument& document, const Json* index, AccessorView& view)
+        {
+            const Json* accessors = document.json.Find("accessors");
+            const Json* views = document.json.Find("bufferViews");
+            if (!index || index->type != Json::Number || !accessors || !views)
+                return false;
+            if (!(index->number >= 0.0) || index->number != std::floor(index->number) || index->number >= (double)accessors->array.size())
+                return false;
+
+            const Json& accessor = accessors->At((size_t)index->number);
+            if (accessor.Find("sparse"))
+                std::cerr << "glTF sparse accessors are not supported, using the dense values" << std::endl;
+
+            size_t component_type = 0, buffer_view_index = 0;
+            if (!get_size(accessor, "componentType", 0, component_type) || !get_size(accessor, "count", 0, view.count)
+                || !get_size(accessor, "bufferView", std::numeric_limits<size_t>::max(), buffer_view_index))
+                return false;
+
+            const Json* type = accessor.Find("type");
+            view.component_type = component_type <= 0xFFFF ? (int)component_type : 0;
+            view.components = type ? component_count(type->string) : 0;
+            const Json* normalized = accessor.Find("normalized");
+            view.normalized = normalized && normalized->boolean;
+
+            size_t element_size = component_size(view.component_type) * view.components;
+            if (element_size == 0 || buffer_view_index >= views->array.size())
+                return false;
+
+            const Json& buffer_view = views->At(buffer_view_index);
+            size_t buffer = 0, view_offset = 0, view_length = 0, offset = 0;
+            if (!get_size(buffer_view, "buffer", 0, buffer) || !get_size(buffer_view, "byteOffset", 0, view_offset)
+                || !get_size(buffer_view, "byteLength", 0, view_length) || !get_size(buffer_view, "byteStride", 0, view.stride)
+                || !get_size(accessor, "byteOffset", 0, offset))
+                return false;
+            if (buffer >= document.buffers.size())
+                return false;
+            if (view.stride == 0)
+                view.stride = element_size;
+
+            // offset + stride * (count - 1) + element_size <= length, in terms that cannot wrap
+            const BufferRange& range = document.buffers[buffer];
+            if (view_offset > range.size || view_length > range.size - view_offset)
+                return false;
+            if (view.count > 0)
+            {
+                if (offset > view_length || element_size > view_length - offset)
+                    return false;
+                if (view.count - 1 > (view_length - offset - element_size) / view.stride)
+                    return false;
+            }
+
+            view.data = range.data + view_offset + offset;
+            return true;
+        }
+
+        bool decode_base64(const std::string& text, size_t start, std::vector<unsigned char>& out)
+        {
+            auto value = [](char c) -> int {
+                if (c >= 'A' && c <= 'Z') return c - 'A';
+                if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+                if (c >= '0' && c <= '9') return c - '0' + 52;
+                if (c == '+' || c == '-') return 62;
+                if (c == '/' || c == '_') return 63;
+                return -1;
+            };
+
+            unsigned int bits = 0;
+            int count = 0;
+            for (size_t i = start; i < text.size() && text[i] != '='; ++i)
+            {
+                int v = value(text[i]);
+                if (v < 0)
+                    return false;
+                bits = (bits << 6) | (unsigned int)v;
+                count += 6;
+                if (count >= 8)
+                {
+                    count -= 8;
+                    out.push_back((unsigned char)((bits >> count) & 0xFF));
+                }
+            }
+            return true;
+        }
+
+        std::string directory_of(const std::string& path)
+        {
+            size_t slash = path.find_last_of("/\\");
+            return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+        }
+
+        bool convert_primitive(const GltfDocument& document, const Json& primitive, MeshData& mesh)
+        {
+            const Json* attributes = primitive.Find("attributes");
+            if (!attributes)
+                return false;
+
+            AccessorView positions, normals, texcoords;
+            if (!get_accessor(document, attributes->Find("POSITION"), positions) || positions.components != 3)
+                return false;
+            bool has_normals = get_accessor(document, attributes->Find("NORMAL"), normals) && normals.components == 3 && normals.count == positions.count;
+            bool has_texcoords = get_accessor(document, attributes->Find("TEXCOORD_0"), texcoords) && texcoords.components == 2 && texcoords.count == positions.count;
+
+            mesh.attributes = Position | (has_normals ? Normal : 0u) | (has_texcoords ? TexCoord : 0u);
+            unsigned int stride = vertex_stride(mesh.attributes);
+            mesh.vertices.resize(positions.count * stride);
+
+            // Interleave straight out of the mapped buffer views
+            float* out = mesh.vertices.data();
+            bool float_positions = positions.component_type == Float;
+            for (size_t i = 0; i < positions.count; ++i)
+            {
+                if (float_positions)
+                    std::memcpy(out, positions.data + i * positions.stride, 3 * sizeof(float));
+                else
+                {
+                    for (int c = 0; c < 3; ++c)
+                        out[c] = positions.Component(i, c);
+                }
+                out += 3;
+                if (has_normals)
+                {
+                    for (int c = 0; c < 3; ++c)
+                        *out++ = normals.Component(i, c);
+                }
+                if (has_texcoords)
+                {
+                    *out++ = texcoords.Component(i, 0);
+                    *out++ = texcoords.Component(i, 1);
+                }
+            }
+
+            AccessorView indices;
+            if (primitive.Find("indices"))
+            {
+                if (!get_accessor(document, primitive.Find("indices"), indices) || indices.components != 1)
+                    return false;
+                // glTF indices are unsigned integers; anything else would read as degenerate triangles
+                if (indices.component_type != UnsignedByte && indices.component_type != UnsignedShort && indices.component_type != UnsignedInt)
+                    return false;
+                mesh.indices.resize(indices.count - indices.count % 3);
+                if (indices.component_type == UnsignedInt && indices.stride == 4)
+                    std::memcpy(mesh.indices.data(), indices.data, mesh.indices.size() * sizeof(unsigned int));
+                else
+                {
+                    for (size_t i = 0; i < mesh.indices.size(); ++i)
+                        mesh.indices[i] = indices.Index(i);
+                }
+
+                for (unsigned int index : mesh.indices)
+                {
+                    if (index >= positions.count)
+                        return false;
+                }
+            }
+            else
+            {
+                mesh.indices.resize(positions.count - positions.count % 3);
+                for (size_t i = 0; i < mesh.indices.size(); ++i)
+                    mesh.indices[i] = (unsigned int)i;
+            }
+            return true;
+        }
+    }
+
+    double ImportReport::MegabytesPerSecond() const
+    {
+        return milliseconds > 0.0 ? bytes / (1024.0 * 1024.0) / (milliseconds / 1000.0) : 0.0;
+    }
+
+    std::ostream& operator<<(std::ostream& os, const ImportReport& report)
+    {
+        os << report.meshes << " meshes, " << report.vertices << " vertices, " << report.triangles << " triangles from "
+           << report.bytes / (1024.0 * 1024.0) << " MB in " << report.milliseconds << " ms on " << report.threads << " threads ("
+           << report.MegabytesPerSecond() << " MB/s)";
+        return os;
+    }
+
+    float parse_float(const char*& cursor, const char* end)
+    {
+        static const double powers[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        const char* p = cursor;
+        bool negative = false;
+        if (p < end && (*p == '-' || *p == '+'))
+            negative = *p++ == '-';
+
+        // up to 19 significant digits go into the mantissa, the rest only shift the exponent
+        uint64_t mantissa = 0;
+        int exponent = 0;
+        int digits = 0;
+        bool any = false;
+        while (p < end && is_digit(*p))
+        {
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + (*p - '0');
+                digits += mantissa != 0;
+            }
+            else
+                ++exponent;
+            ++p;
+            any = true;
+        }
+        if (p < end && *p == '.')
+        {
+            ++p;
+            while (p < end && is_digit(*p))
+            {
+                if (digits < 19)
+                {
+                    mantissa = mantissa * 10 + (*p - '0');
+                    digits += mantissa != 0;
+                    --exponent;
+                }
+                ++p;
+                any = true;
+            }
+        }
+        if (!any)
+            return 0.0f;
+
+        if (p < end && (*p == 'e' || *p == 'E'))
+        {
+            const char* q = p + 1;
+            long long value;
+            if (parse_int(q, end, value))
+            {
+                exponent += (int)std::max(std::min(value, 1000LL), -1000LL);
+                p = q;
+            }
+        }
+
+        double value = (double)mantissa;
+        if (exponent < 0)
+            value = exponent >= -22 ? value / powers[-exponent] : value * std::pow(10.0, exponent);
+        else if (exponent > 0)
+            value = exponent <= 22 ? value * powers[exponent] : value * std::pow(10.0, exponent);
+
+        cursor = p;
+        return (float)(negative ? -value : value);
+    }
+
+    bool load_obj(const char* path, MeshData& mesh, const ImportOptions& options, ImportReport* report)
+    {
+        Clock::time_point start = Clock::now();
+
+        MappedFile file(path);
+        if (!file.Valid())
+            return false;
+
+        const char* begin = (const char*)file.Data();
+        const char* end = begin + file.Size();
+
+        // Small files are not worth the thread start up
+        unsigned int threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+        threads = (unsigned int)std::max<size_t>(1, std::min<size_t>(threads, file.Size() / (256 * 1024)));
+
+        // Line aligned chunk boundaries
+        std::vector<const char*> bounds(threads + 1, end);
+        bounds[0] = begin;
+        for (unsigned int i = 1; i < threads; ++i)
+        {
+            const char* split = std::max(begin + file.Size() * i / threads, bounds[i - 1]);
+            const char* newline = (const char*)std::memchr(split, '\n', end - split);
+            bounds[i] = newline ? newline + 1 : end;
+        }
+
+        std::vector<ObjChunk> chunks(threads);
+        std::vector<std::thread> workers;
+        for (unsigned int i = 1; i < threads; ++i)
+            workers.emplace_back(parse_obj_chunk, bounds[i], bounds[i + 1], std::ref(chunks[i]));
+        parse_obj_chunk(bounds[0], bounds[1], chunks[0]);
+        for (std::thread& worker : workers)
+            worker.join();
+
+        // Global element offsets of every chunk
+        size_t position_count = 0, texcoord_count = 0, normal_count = 0, corner_count = 0, bad_lines = 0;
+        bool has_texcoords = false, has_normals = false;
+        std::vector<size_t> position_base(threads), texcoord_base(threads), normal_base(threads);
+        for (unsigned int i = 0; i < threads; ++i)
+        {
+            const ObjChunk& chunk = chunks[i];
+            position_base[i] = position_count;
+            texcoord_base[i] = texcoord_count;
+            normal_base[i] = normal_count;
+            position_count += chunk.positions.size() / 3;
+            texcoord_count += chunk.texcoords.size() / 2;
+            normal_count += chunk.normals.size() / 3;
+            corner_count += chunk.corners.size() / 3;
+            bad_lines += chunk.bad_lines;
+            for (size_t c = 0; c < chunk.corners.size() && !(has_texcoords && has_normals); c += 3)
+            {
+                has_texcoords |= chunk.corners[c + 1] != kNoIndex;
+                has_normals |= chunk.corners[c + 2] != kNoIndex;
+            }
+        }
+        if (bad_lines)
+            std::cerr << "Skipped " << bad_lines << " malformed lines in " << path << std::endl;
+
+        auto gather = [&](std::vector<float> ObjChunk::* member, size_t count, size_t width) {
+            std::vector<float> all;
+            all.reserve(count * width);
+            for (const ObjChunk& chunk : chunks)
+                all.insert(all.end(), (chunk.*member).begin(), (chunk.*member).end());
+            return all;
+        };
+        std::vector<float> positions = gather(&ObjChunk::positions, position_count, 3);
+        std::vector<float> texcoords = gather(&ObjChunk::texcoords, texcoord_count, 2);
+        std::vector<float> normals = gather(&ObjChunk::normals, normal_count, 3);
+
+        // One output vertex per distinct (position, texcoord, normal) triple
+        mesh = MeshData();
+        mesh.attributes = Position | (has_texcoords ? TexCoord : 0u) | (has_normals ? Normal : 0u);
+        unsigned int stride = vertex_stride(mesh.attributes);
+        mesh.indices.reserve(corner_count);
+        mesh.vertices.reserve(std::min(corner_count, position_count * 2) * stride);
+
+        CornerTable table(std::min(corner_count, position_count * 2));
+        for (unsigned int i = 0; i < threads; ++i)
+        {
+            const std::vector<long long>& corners = chunks[i].corners;
+            for (size_t c = 0; c < corners.size(); c += 3)
+            {
+                long long key[3] = {
+                    resolve_obj_index(corners[c], position_base[i]),
+                    resolve_obj_index(corners[c + 1], texcoord_base[i]),
+                    resolve_obj_index(corners[c + 2], normal_base[i])
+                };
+                if (key[0] < 0 || key[0] >= (long long)position_count || key[1] >= (long long)texcoord_count || key[2] >= (long long)normal_count
+                    || (key[1] < 0 && corners[c + 1] != kNoIndex) || (key[2] < 0 && corners[c + 2] != kNoIndex))
+                {
+                    std::cerr << "Face index out of range in " << path << std::endl;
+                    mesh = MeshData();
+                    return false;
+                }
+
+                bool added;
+                unsigned int vertex = table.Insert(key, added);
+                mesh.indices.push_back(vertex);
+                if (!added)
+                    continue;
+
+                mesh.vertices.insert(mesh.vertices.end(), &positions[key[0] * 3], &positions[key[0] * 3] + 3);
+                if (has_normals)
+                {
+                    if (key[2] >= 0)
+                        mesh.vertices.insert(mesh.vertices.end(), &normals[key[2] * 3], &normals[key[2] * 3] + 3);
+                    else
+                        mesh.vertices.insert(mesh.vertices.end(), 3, 0.0f);
+                }
+                if (has_texcoords)
+                {
+                    if (key[1] >= 0)
+                        mesh.vertices.insert(mesh.vertices.end(), &texcoords[key[1] * 2], &texcoords[key[1] * 2] + 2);
+                    else
+                        mesh.vertices.insert(mesh.vertices.end(), 2, 0.0f);
+                }
+            }
+        }
+
+        if (options.weld)
+            mesh = weld(mesh);
+
+        fill_import_report(report, file.Size(), threads, &mesh, 1, start);
+        return !mesh.indices.empty();
+    }
+
+    bool load_gltf(const char* path, std::vector<MeshData>& meshes, const ImportOptions& options, ImportReport* report)
+    {
+        Clock::time_point start = Clock::now();
+
+        MappedFile file(path);
+        if (!file.Valid())
+            return false;
+
+        const unsigned char* data = file.Data();
+        const char* json_begin = (const char*)data;
+        const char* json_end = json_begin + file.Size();
+        BufferRange glb_buffer;
+        size_t bytes = file.Size();
+
+        // Binary container: 12 byte header followed by a JSON chunk and an optional BIN chunk
+        uint32_t header[3] = { 0, 0, 0 };
+        if (file.Size() >= 12)
+            std::memcpy(header, data, sizeof(header));
+        if (header[0] == 0x46546C67) // "glTF"
+        {
+            if (header[1] != 2 || header[2] > file.Size())
+            {
+                std::cerr << "Unsupported glb container: " << path << std::endl;
+                return false;
+            }
+
+            json_begin = json_end = nullptr;
+            size_t offset = 12;
+            while (offset + 8 <= header[2])
+            {
+                uint32_t chunk[2];
+                std::memcpy(chunk, data + offset, sizeof(chunk));
+                offset += 8;
+                if (offset + chunk[0] > header[2])
+                    break;
+                if (chunk[1] == 0x4E4F534A && !json_begin) // "JSON"
+                {
+                    json_begin = (const char*)data + offset;
+                    json_end = json_begin + chunk[0];
+                }
+                else if (chunk[1] == 0x004E4942 && !glb_buffer.data) // "BIN"
+                {
+                    glb_buffer.data = data + offset;
+                    glb_buffer.size = chunk[0];
+                }
+                offset += (chunk[0] + 3) & ~3u;
+            }
+            if (!json_begin)
+            {
+                std::cerr << "glb file without a JSON chunk: " << path << std::endl;
+                return false;
+            }
+        }
+
+        GltfDocument document;
+        if (!JsonParser(json_begin, json_end).Parse(document.json) || document.json.type != Json::Object)
+        {
+            std::cerr << "Failed to parse glTF JSON: " << path << std::endl;
+            return false;
+        }
+
+        // External buffers stay mapped while the accessors are read
+        std::vector<MappedFile> external;
+        std::vector<std::vector<unsigned char>> embedded;
+        const Json* buffers = document.json.Find("buffers");
+        size_t buffer_count = buffers ? buffers->array.size() : 0;
+        external.reserve(buffer_count);
+        embedded.reserve(buffer_count);
+        for (size_t i = 0; i < buffer_count; ++i)
+        {
+            const Json& buffer = buffers->array[i];
+            const Json* uri = buffer.Find("uri");
+            BufferRange range;
+            if (!uri)
+                range = glb_buffer;
+            else if (uri->string.compare(0, 5, "data:") == 0)
+            {
+                size_t comma = uri->string.find(";base64,");
+                embedded.emplace_back();
+                if (comma == std::string::npos || !decode_base64(uri->string, comma + 8, embedded.back()))
+                {
+                    std::cerr << "Unsupported glTF data uri in " << path << std::endl;
+                    return false;
+                }
+                range.data = embedded.back().data();
+                range.size = embedded.back().size();
+            }
+            else
+            {
+                external.emplace_back((directory_of(path) + uri->string).c_str());
+                if (!external.back().Valid())
+                    return false;
+                range.data = external.back().Data();
+                range.size = external.back().Size();
+                bytes += range.size;
+            }
+
+            size_t declared = 0;
+            if (!get_size(buffer, "byteLength", range.size, declared))
+            {
+                std::cerr << "Invalid glTF buffer byteLength in " << path << std::endl;
+                return false;
+            }
+            range.size = std::min(range.size, declared);
+            document.buffers.push_back(range);
+        }
+
+        meshes.clear();
+        const Json* gltf_meshes = document.json.Find("meshes");
+        size_t skipped = 0;
+        for (size_t m = 0; gltf_meshes && m < gltf_meshes->array.size(); ++m)
+        {
+            const Json* primitives = gltf_meshes->array[m].Find("primitives");
+            for (size_t p = 0; primitives && p < primitives->array.size(); ++p)
+            {
+                const Json& primitive = primitives->array[p];
+                MeshData mesh;
+                if (primitive.NumberOr("mode", 4) != 4 || !convert_primitive(document, primitive, mesh))
+                {
+                    ++skipped;
+                    continue;
+                }
+                meshes.push_back(options.weld ? weld(mesh) : mesh);
+            }
+        }
+        if (skipped)
+            std::cerr << "Skipped " << skipped << " non triangle or invalid primitives in " << path << std::endl;
+
+        fill_import_report(report, bytes, 1, meshes.data(), meshes.size(), start);
+        return !meshes.empty();
+    }
+
+    bool load_mesh(const char* path, std::vector<MeshData>& meshes, const ImportOptions& options, ImportReport* report)
+    {
+        std::string extension = path;
+        size_t dot = extension.find_last_of('.');
+        extension = dot == std::string::npos ? std::string() : extension.substr(dot + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+
+        if (extension == "obj")
+        {
+            meshes.assign(1, MeshData());
+            if (load_obj(path, meshes[0], options, report))
+                return true;
+            meshes.clear();
+            return false;
+        }
+        if (extension == "gltf" || extension == "glb")
+            return load_gltf(path, meshes, options, report);
+
+        std::cerr << "Unknown mesh format: " << path << std::endl;
+        return false;
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef _MESH_IMPORT_H
+#define _MESH_IMPORT_H
+
+#include "mesh_library.h"
+#include <ostream>
+#include <string>
+
+namespace Utility::mesh
+{
+    struct ImportOptions
+    {
+        unsigned int threads = 0;  // OBJ parser threads, 0 uses every hardware thread
+        bool weld = true;          // merge vertices with identical contents after import
+    };
+
+    struct ImportReport
+    {
+        size_t bytes = 0;          // file bytes read, including external glTF buffers
+        double milliseconds = 0.0;
+        unsigned int threads = 1;
+        size_t meshes = 0;
+        size_t vertices = 0;
+        size_t triangles = 0;
+
+        double MegabytesPerSecond() const;
+    };
+
+    std::ostream& operator<<(std::ostream& os, const ImportReport& report);
+
+    // Wavefront OBJ. The file is memory mapped and split into line aligned chunks that are parsed on
+    // separate threads. v/vt/vn/f records are read (negative indices included, polygons are triangulated
+    // as fans), everything else is skipped and all faces end up in a single indexed mesh.
+    bool load_obj(const char* path, MeshData& mesh, const ImportOptions& options = ImportOptions(), ImportReport* report = nullptr);
+
+    // glTF 2.0, either .gltf with external or data: buffers, or binary .glb. Every triangle primitive
+    // becomes one mesh with its POSITION, NORMAL and TEXCOORD_0 attributes. Accessors are read in
+    // place from the mapped buffers, whose counts, offsets and strides are checked against them, and
+    // interleaved into the MeshData, which is the one copy made of the vertex data; node transforms,
+    // materials and sparse accessors are ignored.
+    bool load_gltf(const char* path, std::vector<MeshData>& meshes, const ImportOptions& options = ImportOptions(), ImportReport* report = nullptr);
+
+    // Picks the loader from the file extension (.obj, .gltf, .glb)
+    bool load_mesh(const char* path, std::vector<MeshData>& meshes, const ImportOptions& options = ImportOptions(), ImportReport* report = nullptr);
+
+    // Decimal float parser for the OBJ loader; advances cursor past the number, leaves it unchanged on failure
+    float parse_float(const char*& cursor, const char* end);
+}
+
+#endif // !_MESH_IMPORT_H
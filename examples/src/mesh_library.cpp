@@ -0,0 +1,624 @@
+#include "mesh_library.h"
+#include "mesh_utils.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include <iostream>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+namespace Utility::mesh
+{
+    namespace
+    {
+        void push_vertex(MeshData& mesh, glm::vec3 position, glm::vec3 normal, glm::vec2 uv)
+        {
+            if (mesh.attributes & Position)
+                mesh.vertices.insert(mesh.vertices.end(), { position.x, position.y, position.z });
+            if (mesh.attributes & Normal)
+                mesh.vertices.insert(mesh.vertices.end(), { normal.x, normal.y, normal.z });
+            if (mesh.attributes & TexCoord)
+                mesh.vertices.insert(mesh.vertices.end(), { uv.x, uv.y });
+        }
+
+        // FNV-1a over the raw bytes
+        uint64_t hash_bytes(const void* data, size_t size, uint64_t hash)
+        {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        uint64_t hash_mesh(const MeshData& mesh)
+        {
+            uint64_t hash = 14695981039346656037ull;
+            hash = hash_bytes(&mesh.attributes, sizeof(mesh.attributes), hash);
+            hash = hash_bytes(mesh.vertices.data(), mesh.vertices.size() * sizeof(float), hash);
+            hash = hash_bytes(mesh.indices.data(), mesh.indices.size() * sizeof(unsigned int), hash);
+            return hash;
+        }
+
+        // Points consecutive locations from 0 at the interleaved attributes of the bound GL_ARRAY_BUFFER
+        void set_vertex_attributes(unsigned int attributes)
+        {
+            GLsizei stride = vertex_stride(attributes) * sizeof(GLfloat);
+            GLuint location = 0;
+            size_t offset = 0;
+            if (attributes & Position)
+            {
+                glVertexAttribPointer(location, 3, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offset);
+                glEnableVertexAttribArray(location++);
+                offset += 3 * sizeof(GLfloat);
+            }
+            if (attributes & Normal)
+            {
+                glVertexAttribPointer(location, 3, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offset);
+                glEnableVertexAttribArray(location++);
+                offset += 3 * sizeof(GLfloat);
+            }
+            if (attributes & TexCoord)
+            {
+                glVertexAttribPointer(location, 2, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offset);
+                glEnableVertexAttribArray(location++);
+                offset += 2 * sizeof(GLfloat);
+            }
+        }
+    }
+
+    unsigned int vertex_stride(unsigned int attributes)
+    {
+        unsigned int stride = 0;
+        if (attributes & Position)
+            stride += 3;
+        if (attributes & Normal)
+            stride += 3;
+        if (attributes & TexCoord)
+            stride += 2;
+        return stride;
+    }
+
+    size_t MeshData::VertexCount() const
+    {
+        unsigned int stride = vertex_stride(attributes);
+        return stride ? vertices.size() / stride : 0;
+    }
+
+    // ====================
+    //      PRIMITIVES
+    // ====================
+    MeshData cube(unsigned int attributes, float edge_length)
+    {
+        // Same corner order and texture coordinates as the 36 vertex cube used by the tutorials
+        struct Face { glm::vec3 normal; glm::vec3 corners[4]; glm::vec2 uvs[4]; };
+        const Face faces[6] = {
+            { { 0.0f,  0.0f, -1.0f }, { {-0.5f, -0.5f, -0.5f}, { 0.5f, -0.5f, -0.5f}, { 0.5f,  0.5f, -0.5f}, {-0.5f,  0.5f, -0.5f} }, { {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f} } },
+            { { 0.0f,  0.0f,  1.0f }, { {-0.5f, -0.5f,  0.5f}, { 0.5f, -0.5f,  0.5f}, { 0.5f,  0.5f,  0.5f}, {-0.5f,  0.5f,  0.5f} }, { {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f} } },
+            { {-1.0f,  0.0f,  0.0f }, { {-0.5f,  0.5f,  0.5f}, {-0.5f,  0.5f, -0.5f}, {-0.5f, -0.5f, -0.5f}, {-0.5f, -0.5f,  0.5f} }, { {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}, {0.0f, 0.0f} } },
+            { { 1.0f,  0.0f,  0.0f }, { { 0.5f,  0.5f,  0.5f}, { 0.5f,  0.5f, -0.5f}, { 0.5f, -0.5f, -0.5f}, { 0.5f, -0.5f,  0.5f} }, { {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}, {0.0f, 0.0f} } },
+            { { 0.0f, -1.0f,  0.0f }, { {-0.5f, -0.5f, -0.5f}, { 0.5f, -0.5f, -0.5f}, { 0.5f, -0.5f,  0.5f}, {-0.5f, -0.5f,  0.5f} }, { {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f}, {0.0f, 0.0f} } },
+            { { 0.0f,  1.0f,  0.0f }, { {-0.5f,  0.5f, -0.5f}, { 0.5f,  0.5f, -0.5f}, { 0.5f,  0.5f,  0.5f}, {-0.5f,  0.5f,  0.5f} }, { {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f}, {0.0f, 0.0f} } }
+        };
+
+        MeshData mesh;
+        mesh.attributes = attributes | Position;
+        for (const Face& face : faces)
+        {
+            unsigned int first = (unsigned int)mesh.VertexCount();
+            for (int i = 0; i < 4; ++i)
+                push_vertex(mesh, face.corners[i] * edge_length, face.normal, face.uvs[i]);
+            mesh.indices.insert(mesh.indices.end(), { first, first + 1, first + 2, first + 2, first + 3, first });
+        }
+        return mesh;
+    }
+
+    MeshData plane(unsigned int attributes, float size, int subdivisions)
+    {
+        MeshData mesh;
+        mesh.attributes = attributes | Position;
+        if (subdivisions < 1)
+            subdivisions = 1;
+
+        for (int z = 0; z <= subdivisions; ++z)
+        {
+            for (int x = 0; x <= subdivisions; ++x)
+            {
+                float u = (float)x / subdivisions;
+                float v = (float)z / subdivisions;
+                push_vertex(mesh, glm::vec3((u - 0.5f) * size, 0.0f, (v - 0.5f) * size), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(u, 1.0f - v));
+            }
+        }
+
+        unsigned int row = subdivisions + 1;
+        for (int z = 0; z < subdivisions; ++z)
+        {
+            for (int x = 0; x < subdivisions; ++x)
+            {
+                unsigned int a = z * row + x;
+                unsigned int b = a + row;
+                mesh.indices.insert(mesh.indices.end(), { a, b, a + 1, a + 1, b, b + 1 });
+            }
+        }
+        return mesh;
+    }
+
+    MeshData sphere(unsigned int attributes, float radius, int slices, int stacks)
+    {
+        MeshData mesh;
+        mesh.attributes = attributes | Position;
+        if (slices < 3)
+            slices = 3;
+        if (stacks < 2)
+            stacks = 2;
+
+        for (int i = 0; i <= stacks; ++i)
+        {
+            float v = (float)i / stacks;
+            float phi = v * glm::pi<float>();
+            for (int j = 0; j <= slices; ++j)
+            {
+                float u = (float)j / slices;
+                float theta = u * glm::two_pi<float>();
+                glm::vec3 normal(std::sin(phi) * std::cos(theta), std::cos(phi), -std::sin(phi) * std::sin(theta));
+                push_vertex(mesh, normal * radius, normal, glm::vec2(u, 1.0f - v));
+            }
+        }
+
+        unsigned int row = slices + 1;
+        for (int i = 0; i < stacks; ++i)
+        {
+            for (int j = 0; j < slices; ++j)
+            {
+                unsigned int a = i * row + j;
+                unsigned int b = a + row;
+                // the first and the last stack collapse into the poles
+                if (i != 0)
+                    mesh.indices.insert(mesh.indices.end(), { a, b, a + 1 });
+                if (i != stacks - 1)
+                    mesh.indices.insert(mesh.indices.end(), { a + 1, b, b + 1 });
+            }
+        }
+        return mesh;
+    }
+
+    MeshData cylinder(unsigned int attributes, float radius, float height, int slices)
+    {
+        MeshData mesh;
+        mesh.attributes = attributes | Position;
+        if (slices < 3)
+            slices = 3;
+
+        float half = height * 0.5f;
+
+        // side
+        for (int j = 0; j <= slices; ++j)
+        {
+            float u = (float)j / slices;
+            float theta = u * glm::two_pi<float>();
+            glm::vec3 normal(std::cos(theta), 0.0f, -std::sin(theta));
+            push_vertex(mesh, glm::vec3(normal.x * radius, -half, normal.z * radius), normal, glm::vec2(u, 0.0f));
+            push_vertex(mesh, glm::vec3(normal.x * radius,  half, normal.z * radius), normal, glm::vec2(u, 1.0f));
+        }
+        for (int j = 0; j < slices; ++j)
+        {
+            unsigned int a = j * 2;
+            mesh.indices.insert(mesh.indices.end(), { a, a + 2, a + 1, a + 1, a + 2, a + 3 });
+        }
+
+        // caps
+        for (int side = 0; side < 2; ++side)
+        {
+            float y = side == 0 ? -half : half;
+            glm::vec3 normal(0.0f, side == 0 ? -1.0f : 1.0f, 0.0f);
+            unsigned int center = (unsigned int)mesh.VertexCount();
+            push_vertex(mesh, glm::vec3(0.0f, y, 0.0f), normal, glm::vec2(0.5f, 0.5f));
+            for (int j = 0; j <= slices; ++j)
+            {
+                float theta = (float)j / slices * glm::two_pi<float>();
+                float c = std::cos(theta), s = -std::sin(theta);
+                push_vertex(mesh, glm::vec3(c * radius, y, s * radius), normal, glm::vec2(c * 0.5f + 0.5f, s * 0.5f + 0.5f));
+            }
+            for (int j = 0; j < slices; ++j)
+            {
+                unsigned int a = center + 1 + j;
+                if (side == 0)
+                    mesh.indices.insert(mesh.indices.end(), { center, a + 1, a });
+                else
+                    mesh.indices.insert(mesh.indices.end(), { center, a, a + 1 });
+            }
+        }
+        return mesh;
+    }
+
+    MeshData quad(unsigned int attributes, float size)
+    {
+        MeshData mesh;
+        mesh.attributes = attributes | Position;
+        float h = size * 0.5f;
+        glm::vec3 normal(0.0f, 0.0f, 1.0f);
+        push_vertex(mesh, glm::vec3(-h, -h, 0.0f), normal, glm::vec2(0.0f, 0.0f));
+        push_vertex(mesh, glm::vec3( h, -h, 0.0f), normal, glm::vec2(1.0f, 0.0f));
+        push_vertex(mesh, glm::vec3( h,  h, 0.0f), normal, glm::vec2(1.0f, 1.0f));
+        push_vertex(mesh, glm::vec3(-h,  h, 0.0f), normal, glm::vec2(0.0f, 1.0f));
+        mesh.indices = { 0, 1, 2, 2, 3, 0 };
+        return mesh;
+    }
+
+    // ====================
+    //      LIBRARY
+    // ====================
+    MeshLibrary::MeshLibrary(size_t vertex_block_bytes, size_t index_block_bytes)
+        : vertex_block_bytes_(vertex_block_bytes), index_block_bytes_(index_block_bytes)
+    {
+    }
+
+    MeshLibrary::~MeshLibrary()
+    {
+        if (!instance_vaos_.empty())
+            glDeleteVertexArrays((GLsizei)instance_vaos_.size(), instance_vaos_.data());
+        for (auto& item : pools_)
+        {
+            for (Block& block : item.second.blocks)
+                glDeleteVertexArrays(1, &block.vao);
+        }
+    }
+
+    MeshHandle MeshLibrary::Get(Primitive primitive, unsigned int attributes)
+    {
+        attributes |= Position;
+        auto key = std::make_pair((int)primitive, attributes);
+        auto found = primitives_.find(key);
+        if (found != primitives_.end())
+        {
+            // Every Get is a user of the primitive, released by its own Remove like a repeated Add
+            if (Record* record = FindRecord(found->second))
+                ++record->users;
+            return found->second;
+        }
+
+        MeshData mesh;
+        switch (primitive)
+        {
+        case Primitive::Cube:
+            mesh = cube(attributes);
+            break;
+        case Primitive::Plane:
+            mesh = plane(attributes);
+            break;
+        case Primitive::Sphere:
+            mesh = sphere(attributes);
+            break;
+        case Primitive::Cylinder:
+            mesh = cylinder(attributes);
+            break;
+        case Primitive::Quad:
+            mesh = quad(attributes);
+            break;
+        }
+
+        MeshHandle handle = Add(mesh);
+        primitives_[key] = handle;
+        return handle;
+    }
+
+    MeshHandle MeshLibrary::Add(const MeshData& source, WeldReport* report)
+    {
+        WeldReport welded;
+        MeshData mesh = weld(source, &welded);
+        if (report)
+            *report = welded;
+
+        uint64_t hash = hash_mesh(mesh);
+        std::vector<Record>& bucket = by_hash_[hash];
+        for (Record& record : bucket)
+        {
+            if (Matches(record, mesh))
+            {
+                ++record.users;
+                return record.handle;
+            }
+        }
+
+        std::vector<MeshHandle> handles = Store(mesh, { mesh.indices });
+        if (handles.empty())
+            return MeshHandle();
+
+        // Only stored meshes count, a deduplicated Add uploads nothing
+        weld_totals_.input_vertices += welded.input_vertices;
+        weld_totals_.output_vertices += welded.output_vertices;
+        weld_totals_.index_count += welded.index_count;
+        weld_totals_.input_bytes += welded.input_bytes;
+        weld_totals_.output_bytes += welded.output_bytes;
+
+        Record record;
+        record.attributes = mesh.attributes;
+        record.handle = handles[0];
+        record.mesh = std::move(mesh);
+        bucket.push_back(std::move(record));
+        return handles[0];
+    }
+
+    std::vector<MeshHandle> MeshLibrary::AddLods(const MeshData& mesh, const std::vector<std::vector<unsigned int>>& lod_indices)
+    {
+        return Store(mesh, lod_indices);
+    }
+
+    void MeshLibrary::Remove(const MeshHandle& mesh)
+    {
+        auto index_range = index_ranges_.find(std::make_pair(mesh.vao, mesh.index_offset));
+        if (index_range == index_ranges_.end())
+            return;
+
+        for (auto bucket = by_hash_.begin(); bucket != by_hash_.end(); ++bucket)
+        {
+            auto record = std::find_if(bucket->second.begin(), bucket->second.end(), [&](const Record& r) { return SameMesh(r.handle, mesh); });
+            if (record == bucket->second.end())
+                continue;
+            if (--record->users > 0)
+                return;
+            bucket->second.erase(record);
+            if (bucket->second.empty())
+                by_hash_.erase(bucket);
+            break;
+        }
+        for (auto primitive = primitives_.begin(); primitive != primitives_.end(); ++primitive)
+        {
+            if (SameMesh(primitive->second, mesh))
+            {
+                primitives_.erase(primitive);
+                break;
+            }
+        }
+
+        IndexRange range = index_range->second;
+        index_ranges_.erase(index_range);
+        range.block->indices.Free(range.allocation);
+
+        auto vertex_range = vertex_ranges_.find(std::make_pair(mesh.vao, range.base_vertex));
+        if (vertex_range != vertex_ranges_.end() && --vertex_range->second.users == 0)
+        {
+            vertex_range->second.block->vertices.Free(vertex_range->second.allocation);
+            vertex_ranges_.erase(vertex_range);
+            --mesh_count_;
+        }
+    }
+
+    MeshHandle MeshLibrary::InstanceStream(const MeshHandle& mesh)
+    {
+        for (auto& item : pools_)
+        {
+            for (Block& block : item.second.blocks)
+            {
+                if (block.vao != mesh.vao)
+                    continue;
+
+                // Same buffers and per vertex attributes as the block, the element buffer binding included
+                MeshHandle handle = mesh;
+                glGenVertexArrays(1, &handle.vao);
+                glBindVertexArray(handle.vao);
+                glBindBuffer(GL_ARRAY_BUFFER, block.vertices.Buffer());
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, block.indices.Buffer());
+                set_vertex_attributes(item.first);
+                glBindVertexArray(0);
+                glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+                instance_vaos_.push_back(handle.vao);
+                return handle;
+            }
+        }
+        return MeshHandle();
+    }
+
+    MeshHandle MeshLibrary::UpdateIndices(const MeshHandle& range, const std::vector<unsigned int>& indices)
+    {
+        MeshHandle handle = range;
+        handle.index_count = (GLsizei)std::min(indices.size(), (size_t)range.index_count);
+
+        // keep the range's index type so the data lands where the handle points
+        const void* data = indices.data();
+        size_t bytes = handle.index_count * sizeof(unsigned int);
+        if (range.index_type == GL_UNSIGNED_SHORT)
+        {
+            narrow_indices_.assign(indices.begin(), indices.begin() + handle.index_count);
+            data = narrow_indices_.data();
+            bytes = handle.index_count * sizeof(unsigned short);
+        }
+
+        glBindVertexArray(range.vao);
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, range.index_offset, bytes, data);
+        glBindVertexArray(0);
+        return handle;
+    }
+
+    void MeshLibrary::Draw(const MeshHandle& mesh) const
+    {
+        glBindVertexArray(mesh.vao);
+        glDrawElementsBaseVertex(GL_TRIANGLES, mesh.index_count, mesh.index_type, (GLvoid*)mesh.index_offset, mesh.base_vertex);
+    }
+
+    void MeshLibrary::DrawInstanced(const MeshHandle& mesh, GLsizei instance_count) const
+    {
+        glBindVertexArray(mesh.vao);
+        glDrawElementsInstancedBaseVertex(GL_TRIANGLES, mesh.index_count, mesh.index_type, (GLvoid*)mesh.index_offset, instance_count, mesh.base_vertex);
+    }
+
+    size_t MeshLibrary::MeshCount() const
+    {
+        return mesh_count_;
+    }
+
+    size_t MeshLibrary::VertexBytes() const
+    {
+        return VertexReport().used;
+    }
+
+    size_t MeshLibrary::IndexBytes() const
+    {
+        return IndexReport().used;
+    }
+
+    ArenaReport MeshLibrary::VertexReport() const
+    {
+        ArenaReport report;
+        for (const auto& item : pools_)
+        {
+            for (const Block& block : item.second.blocks)
+                report += block.vertices.Report();
+        }
+        return report;
+    }
+
+    ArenaReport MeshLibrary::IndexReport() const
+    {
+        ArenaReport report;
+        for (const auto& item : pools_)
+        {
+            for (const Block& block : item.second.blocks)
+                report += block.indices.Report();
+        }
+        return report;
+    }
+
+    // ===============
+    // PRIVATE
+    // ===============
+    std::vector<MeshHandle> MeshLibrary::Store(const MeshData& mesh, const std::vector<std::vector<unsigned int>>& index_lists)
+    {
+        std::vector<IndexBuffer> index_buffers;
+        size_t index_bytes = 0;
+        for (const std::vector<unsigned int>& indices : index_lists)
+        {
+            index_buffers.push_back(make_index_buffer(indices));
+            index_bytes += index_buffers.back().data.size() + index_buffers.back().IndexSize();
+        }
+
+        // Vertex ranges start on a whole vertex so the range is addressed with a base vertex
+        size_t stride = vertex_stride(mesh.attributes) * sizeof(float);
+        size_t vertex_bytes = mesh.vertices.size() * sizeof(float);
+        if (vertex_bytes == 0 || index_lists.empty())
+            return {};
+
+        Pool& pool = GetPool(mesh.attributes);
+        TlsfAllocator::Allocation vertices;
+        std::vector<TlsfAllocator::Allocation> indices;
+        Block* block = nullptr;
+        for (Block& candidate : pool.blocks)
+        {
+            if (Allocate(candidate, vertex_bytes, stride, index_buffers, vertices, indices))
+            {
+                block = &candidate;
+                break;
+            }
+        }
+        if (!block)
+        {
+            block = &AddBlock(pool, mesh.attributes, vertex_bytes + stride, index_bytes);
+            if (!Allocate(*block, vertex_bytes, stride, index_buffers, vertices, indices))
+            {
+                std::cerr << "ERROR::MESH_LIBRARY::OUT_OF_BUFFER_SPACE" << std::endl;
+                return {};
+            }
+        }
+
+        glBindVertexArray(block->vao);
+        block->vertices.Upload(vertices, mesh.vertices.data(), vertex_bytes);
+
+        GLint base_vertex = (GLint)(vertices.offset / stride);
+        VertexRange& vertex_range = vertex_ranges_[std::make_pair(block->vao, base_vertex)];
+        vertex_range.block = block;
+        vertex_range.allocation = vertices;
+        vertex_range.users = (unsigned int)index_buffers.size();
+
+        std::vector<MeshHandle> handles;
+        for (size_t i = 0; i < index_buffers.size(); ++i)
+        {
+            block->indices.Upload(indices[i], index_buffers[i].data.data(), index_buffers[i].data.size());
+
+            // Indices are addressed relative to the base vertex so every mesh picks its own index size
+            MeshHandle handle;
+            handle.vao = block->vao;
+            handle.index_count = (GLsizei)index_lists[i].size();
+            handle.index_type = index_buffers[i].type;
+            handle.index_offset = indices[i].offset;
+            handle.base_vertex = base_vertex;
+            handle.vertex_count = (GLsizei)mesh.VertexCount();
+            handles.push_back(handle);
+
+            index_ranges_[std::make_pair(block->vao, handle.index_offset)] = { block, indices[i], base_vertex };
+        }
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        ++mesh_count_;
+        return handles;
+    }
+
+    bool MeshLibrary::Allocate(Block& block, size_t vertex_bytes, size_t vertex_alignment, const std::vector<IndexBuffer>& index_buffers,
+        TlsfAllocator::Allocation& vertices, std::vector<TlsfAllocator::Allocation>& indices)
+    {
+        // All or nothing, a partly placed mesh gives its ranges back
+        indices.clear();
+        vertices = block.vertices.Allocate(vertex_bytes, vertex_alignment);
+        if (!vertices.Valid())
+            return false;
+
+        for (const IndexBuffer& index_buffer : index_buffers)
+        {
+            // empty index lists still get a slot so every handle has an offset of its own
+            TlsfAllocator::Allocation range = block.indices.Allocate(std::max(index_buffer.data.size(), index_buffer.IndexSize()), index_buffer.IndexSize());
+            if (!range.Valid())
+            {
+                for (const TlsfAllocator::Allocation& allocated : indices)
+                    block.indices.Free(allocated);
+                block.vertices.Free(vertices);
+                indices.clear();
+                return false;
+            }
+            indices.push_back(range);
+        }
+        return true;
+    }
+
+    MeshLibrary::Block& MeshLibrary::AddBlock(Pool& pool, unsigned int attributes, size_t vertex_bytes, size_t index_bytes)
+    {
+        pool.blocks.emplace_back();
+        Block& block = pool.blocks.back();
+        glGenVertexArrays(1, &block.vao);
+
+        // The element buffer binding is VAO state, so the VAO is bound before the index buffer is created
+        glBindVertexArray(block.vao);
+        block.vertices.Create(GL_ARRAY_BUFFER, std::max(vertex_block_bytes_, vertex_bytes));
+        block.indices.Create(GL_ELEMENT_ARRAY_BUFFER, std::max(index_block_bytes_, index_bytes));
+        set_vertex_attributes(attributes);
+
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        return block;
+    }
+
+    MeshLibrary::Pool& MeshLibrary::GetPool(unsigned int attributes)
+    {
+        return pools_[attributes];
+    }
+
+    MeshLibrary::Record* MeshLibrary::FindRecord(const MeshHandle& mesh)
+    {
+        for (auto& bucket : by_hash_)
+        {
+            for (Record& record : bucket.second)
+            {
+                if (SameMesh(record.handle, mesh))
+                    return &record;
+            }
+        }
+        return nullptr;
+    }
+
+    bool MeshLibrary::Matches(const Record& record, const MeshData& mesh) const
+    {
+        return record.attributes == mesh.attributes && record.mesh.vertices == mesh.vertices && record.mesh.indices == mesh.indices;
+    }
+}
@@ -0,0 +1,204 @@
+#ifndef _MESH_LIBRARY_H
+#define _MESH_LIBRARY_H
+
+#include <GL/glew.h>
+#include "buffer_arena.h"
+#include <vector>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
+
+namespace Utility::mesh
+{
+    // Vertex attributes are interleaved in this order and bound to consecutive
+    // locations starting from 0 (e.g. Position | TexCoord -> location 0 and 1)
+    enum Attribute : unsigned int
+    {
+        Position = 1 << 0,
+        Normal   = 1 << 1,
+        TexCoord = 1 << 2
+    };
+
+    enum class Primitive
+    {
+        Cube,
+        Plane,
+        Sphere,
+        Cylinder,
+        Quad
+    };
+
+    // Number of floats per vertex for the given attribute mask
+    unsigned int vertex_stride(unsigned int attributes);
+
+    // CPU side triangle list with interleaved float vertices
+    struct MeshData
+    {
+        unsigned int attributes = Position;
+        std::vector<float> vertices;
+        std::vector<unsigned int> indices;
+
+        size_t VertexCount() const;
+    };
+
+    // Unit cube centered at the origin, 4 vertices per face
+    MeshData cube(unsigned int attributes, float edge_length = 1.0f);
+    // XZ plane facing +Y, centered at the origin
+    MeshData plane(unsigned int attributes, float size = 1.0f, int subdivisions = 1);
+    // UV sphere centered at the origin
+    MeshData sphere(unsigned int attributes, float radius = 0.5f, int slices = 32, int stacks = 16);
+    // Capped cylinder along the Y axis, centered at the origin
+    MeshData cylinder(unsigned int attributes, float radius = 0.5f, float height = 1.0f, int slices = 32);
+    // XY quad facing +Z, centered at the origin
+    MeshData quad(unsigned int attributes, float size = 1.0f);
+
+    // Location of a mesh inside the library's shared buffers
+    struct MeshHandle
+    {
+        GLuint vao = 0;
+        GLsizei index_count = 0;
+        GLenum index_type = GL_UNSIGNED_INT;
+        size_t index_offset = 0; // in bytes
+        GLint base_vertex = 0;
+        GLsizei vertex_count = 0;
+
+        bool Valid() const { return vao != 0; }
+    };
+
+    struct WeldReport
+    {
+        size_t input_vertices = 0;
+        size_t output_vertices = 0;
+        size_t index_count = 0;
+        size_t input_bytes = 0;   // vertex bytes before welding
+        size_t output_bytes = 0;  // vertex + index bytes after welding
+
+        // Fraction of vertices removed, 0 when nothing could be merged
+        float Reduction() const;
+    };
+
+    std::ostream& operator<<(std::ostream& os, const WeldReport& report);
+
+    struct IndexBuffer;
+
+    // Owns the GPU copies of all meshes used by a scene.
+    // Meshes with the same attribute layout share one VAO over a pair of large fixed size buffers
+    // (a block); every mesh is a TLSF sub-allocated range inside them drawn with a base vertex and an
+    // index offset, so nothing is re-specified when meshes come and go. A layout opens another block
+    // only when its current ones are full. Meshes are welded before upload and their indices are
+    // stored as 16-bit whenever they fit. Adding a mesh whose contents are identical to one
+    // already in the library returns the existing handle instead of uploading a second copy.
+    // Needs a current GL context for its whole lifetime.
+    class MeshLibrary
+    {
+    public:
+        static const size_t kDefaultVertexBlockBytes = 16u << 20;
+        static const size_t kDefaultIndexBlockBytes = 8u << 20;
+
+        // Block sizes are per attribute layout; a mesh larger than a block gets a block of its own
+        explicit MeshLibrary(size_t vertex_block_bytes = kDefaultVertexBlockBytes, size_t index_block_bytes = kDefaultIndexBlockBytes);
+        ~MeshLibrary();
+
+        MeshLibrary(const MeshLibrary&) = delete;
+        MeshLibrary& operator=(const MeshLibrary&) = delete;
+
+        // Built-in primitive with default dimensions, generated on first request. Every call counts as
+        // a user of the shared mesh, like Add of identical contents, and is released by one Remove.
+        MeshHandle Get(Primitive primitive, unsigned int attributes);
+        // Welds the mesh before upload; report, when given, gets this mesh's reduction
+        MeshHandle Add(const MeshData& mesh, WeldReport* report = nullptr);
+        // One shared vertex range with a handle per index list (e.g. the levels from generate_lods).
+        // The vertices are uploaded as given, without welding, so the index lists stay valid.
+        std::vector<MeshHandle> AddLods(const MeshData& mesh, const std::vector<std::vector<unsigned int>>& lod_indices);
+
+        // Releases the index range of a handle, and its vertex range once no handle uses it anymore.
+        // A mesh returned more than once by Add is released by its last Remove.
+        void Remove(const MeshHandle& mesh);
+
+        // Handle that draws the mesh through a vertex array of its own over the block's buffers, with
+        // the same per vertex attributes. Per instance attributes the caller adds to it (from the
+        // location after the mesh's last attribute) stay off the other meshes of the block. The
+        // library deletes the vertex array; Remove still takes the original handle.
+        MeshHandle InstanceStream(const MeshHandle& mesh);
+
+        // Overwrites the start of a mesh's index range with a new index list (at most range.index_count
+        // indices over the same vertices, e.g. the compacted output of meshlet culling) and returns the
+        // handle to draw it with. Only the GL copy changes.
+        MeshHandle UpdateIndices(const MeshHandle& range, const std::vector<unsigned int>& indices);
+
+        void Draw(const MeshHandle& mesh) const;
+        void DrawInstanced(const MeshHandle& mesh, GLsizei instance_count) const;
+
+        size_t MeshCount() const;
+        size_t VertexBytes() const;
+        size_t IndexBytes() const;
+        // Utilization and fragmentation of the vertex and index buffers of every block
+        ArenaReport VertexReport() const;
+        ArenaReport IndexReport() const;
+        // Vertices and bytes before and after welding, summed over the meshes Add stored
+        const WeldReport& WeldTotals() const { return weld_totals_; }
+
+    private:
+        struct Block
+        {
+            GLuint vao = 0;
+            BufferArena vertices;
+            BufferArena indices;
+        };
+
+        struct Pool
+        {
+            std::deque<Block> blocks; // a deque so ranges can keep pointers to their block
+        };
+
+        struct VertexRange
+        {
+            Block* block = nullptr;
+            TlsfAllocator::Allocation allocation;
+            unsigned int users = 0;  // index ranges drawing from these vertices
+        };
+
+        struct IndexRange
+        {
+            Block* block = nullptr;
+            TlsfAllocator::Allocation allocation;
+            GLint base_vertex = 0;
+        };
+
+        struct Record
+        {
+            unsigned int attributes;
+            MeshHandle handle;
+            MeshData mesh;           // welded contents, compared on a hash hit
+            unsigned int users = 1;
+        };
+
+        Pool& GetPool(unsigned int attributes);
+        Block& AddBlock(Pool& pool, unsigned int attributes, size_t vertex_bytes, size_t index_bytes);
+        bool Allocate(Block& block, size_t vertex_bytes, size_t vertex_alignment, const std::vector<IndexBuffer>& index_buffers,
+            TlsfAllocator::Allocation& vertices, std::vector<TlsfAllocator::Allocation>& indices);
+        std::vector<MeshHandle> Store(const MeshData& mesh, const std::vector<std::vector<unsigned int>>& index_lists);
+        Record* FindRecord(const MeshHandle& mesh);
+        bool Matches(const Record& record, const MeshData& mesh) const;
+        // Handles name the same stored mesh when they share the block and the index range
+        static bool SameMesh(const MeshHandle& a, const MeshHandle& b) { return a.vao == b.vao && a.index_offset == b.index_offset; }
+
+    private:
+        size_t vertex_block_bytes_;
+        size_t index_block_bytes_;
+        std::map<unsigned int, Pool> pools_;
+        std::map<std::pair<GLuint, GLint>, VertexRange> vertex_ranges_;  // by vao and base vertex
+        std::map<std::pair<GLuint, size_t>, IndexRange> index_ranges_;   // by vao and index offset
+        std::unordered_map<uint64_t, std::vector<Record>> by_hash_;
+        std::map<std::pair<int, unsigned int>, MeshHandle> primitives_;
+        size_t mesh_count_ = 0;
+        WeldReport weld_totals_;
+        std::vector<GLuint> instance_vaos_;  // from InstanceStream
+        std::vector<unsigned short> narrow_indices_;  // scratch for UpdateIndices, kept to avoid a per frame allocation
+    };
+}
+
+#endif // !_MESH_LIBRARY_H
@@ -0,0 +1,338 @@
+#include "mesh_lod.h"
+#include "mesh_optimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Utility::mesh
+{
+    namespace
+    {
+        // Symmetric 4x4 matrix a00 a01 a02 a03 a11 a12 a13 a22 a23 a33, weighted by triangle area
+        struct Quadric
+        {
+            double a[10] = {};
+            double weight = 0.0;
+
+            void AddPlane(double nx, double ny, double nz, double d, double w)
+            {
+                a[0] += w * nx * nx; a[1] += w * nx * ny; a[2] += w * nx * nz; a[3] += w * nx * d;
+                a[4] += w * ny * ny; a[5] += w * ny * nz; a[6] += w * ny * d;
+                a[7] += w * nz * nz; a[8] += w * nz * d;
+                a[9] += w * d * d;
+                weight += w;
+            }
+
+            void Add(const Quadric& other)
+            {
+                for (int i = 0; i < 10; ++i)
+                    a[i] += other.a[i];
+                weight += other.weight;
+            }
+        };
+
+        // Weighted mean squared distance of p to the planes of both quadrics
+        double collapse_cost(const Quadric& q0, const Quadric& q1, const float* p)
+        {
+            double a[10];
+            for (int i = 0; i < 10; ++i)
+                a[i] = q0.a[i] + q1.a[i];
+            double weight = q0.weight + q1.weight;
+
+            double x = p[0], y = p[1], z = p[2];
+            double error = a[0] * x * x + 2 * a[1] * x * y + 2 * a[2] * x * z + 2 * a[3] * x
+                         + a[4] * y * y + 2 * a[5] * y * z + 2 * a[6] * y
+                         + a[7] * z * z + 2 * a[8] * z
+                         + a[9];
+            return weight > 0.0 ? std::max(error / weight, 0.0) : 0.0;
+        }
+
+        glm::vec3 position(const MeshData& mesh, unsigned int stride, unsigned int vertex)
+        {
+            const float* p = &mesh.vertices[(size_t)vertex * stride];
+            return glm::vec3(p[0], p[1], p[2]);
+        }
+
+        // Vertices sharing a position get the id of the first of them
+        std::vector<unsigned int> position_groups(const MeshData& mesh, unsigned int stride)
+        {
+            size_t count = mesh.VertexCount();
+            std::vector<unsigned int> order(count);
+            for (size_t i = 0; i < count; ++i)
+                order[i] = (unsigned int)i;
+
+            auto less = [&](unsigned int l, unsigned int r) {
+                return std::memcmp(&mesh.vertices[(size_t)l * stride], &mesh.vertices[(size_t)r * stride], 3 * sizeof(float)) < 0;
+            };
+            std::sort(order.begin(), order.end(), less);
+
+            std::vector<unsigned int> group(count);
+            for (size_t i = 0; i < count; ++i)
+                group[order[i]] = i > 0 && !less(order[i - 1], order[i]) ? group[order[i - 1]] : order[i];
+            return group;
+        }
+
+        // Seams (one position, several vertices) and open borders must not move
+        std::vector<unsigned char> locked_vertices(const std::vector<unsigned int>& indices, const std::vector<unsigned int>& group)
+        {
+            size_t count = group.size();
+            std::vector<unsigned int> members(count, 0);
+            for (size_t i = 0; i < count; ++i)
+                ++members[group[i]];
+
+            // An edge used by a single triangle is a border
+            std::vector<uint64_t> edges;
+            edges.reserve(indices.size());
+            for (size_t i = 0; i < indices.size(); i += 3)
+            {
+                for (int e = 0; e < 3; ++e)
+                {
+                    uint64_t a = group[indices[i + e]], b = group[indices[i + (e + 1) % 3]];
+                    edges.push_back(a < b ? (a << 32 | b) : (b << 32 | a));
+                }
+            }
+            std::sort(edges.begin(), edges.end());
+
+            std::vector<unsigned char> locked_group(count, 0);
+            for (size_t i = 0; i < edges.size();)
+            {
+                size_t j = i;
+                while (j < edges.size() && edges[j] == edges[i])
+                    ++j;
+                if (j - i == 1)
+                {
+                    locked_group[edges[i] >> 32] = 1;
+                    locked_group[edges[i] & 0xFFFFFFFF] = 1;
+                }
+                i = j;
+            }
+
+            std::vector<unsigned char> locked(count, 0);
+            for (size_t i = 0; i < count; ++i)
+                locked[i] = members[group[i]] > 1 || locked_group[group[i]];
+            return locked;
+        }
+
+        struct Collapse
+        {
+            unsigned int from;
+            unsigned int to;
+            float cost;
+        };
+    }
+
+    std::vector<unsigned int> simplify(const MeshData& mesh, const std::vector<unsigned int>& indices, size_t target_index_count, float target_error, float* result_error)
+    {
+        unsigned int stride = vertex_stride(mesh.attributes);
+        size_t vertex_count = mesh.VertexCount();
+        std::vector<unsigned int> result = indices;
+        float max_cost = 0.0f;
+
+        std::vector<unsigned int> group = position_groups(mesh, stride);
+        std::vector<unsigned char> locked = locked_vertices(indices, group);
+
+        std::vector<Quadric> quadrics(vertex_count);
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            glm::vec3 p0 = position(mesh, stride, indices[i]);
+            glm::vec3 p1 = position(mesh, stride, indices[i + 1]);
+            glm::vec3 p2 = position(mesh, stride, indices[i + 2]);
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            float length = glm::length(normal);
+            if (length == 0.0f)
+                continue;
+            normal /= length;
+            float area = length * 0.5f;
+
+            Quadric plane;
+            plane.AddPlane(normal.x, normal.y, normal.z, -glm::dot(normal, p0), area);
+            for (int c = 0; c < 3; ++c)
+                quadrics[indices[i + c]].Add(plane);
+        }
+
+        float max_cost_allowed = target_error * target_error;
+        std::vector<unsigned int> adjacency_offsets, adjacency;
+        std::vector<unsigned char> touched;
+        std::vector<unsigned int> collapse_to(vertex_count);
+        std::vector<Collapse> candidates;
+
+        // Every pass collapses a set of independent edges cheapest first, then rebuilds the index list
+        while (result.size() > target_index_count)
+        {
+            // vertex -> triangle adjacency
+            adjacency_offsets.assign(vertex_count + 1, 0);
+            for (unsigned int index : result)
+                ++adjacency_offsets[index + 1];
+            for (size_t i = 0; i < vertex_count; ++i)
+                adjacency_offsets[i + 1] += adjacency_offsets[i];
+            adjacency.resize(result.size());
+            {
+                std::vector<unsigned int> fill(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+                for (size_t i = 0; i < result.size(); ++i)
+                    adjacency[fill[result[i]]++] = (unsigned int)(i / 3);
+            }
+
+            candidates.clear();
+            for (size_t i = 0; i < result.size(); i += 3)
+            {
+                for (int e = 0; e < 3; ++e)
+                {
+                    unsigned int a = result[i + e], b = result[i + (e + 1) % 3];
+                    if (!locked[a])
+                        candidates.push_back({ a, b, (float)collapse_cost(quadrics[a], quadrics[b], &mesh.vertices[(size_t)b * stride]) });
+                    if (!locked[b])
+                        candidates.push_back({ b, a, (float)collapse_cost(quadrics[a], quadrics[b], &mesh.vertices[(size_t)a * stride]) });
+                }
+            }
+            std::sort(candidates.begin(), candidates.end(), [](const Collapse& l, const Collapse& r) { return l.cost < r.cost; });
+
+            // An interior collapse removes two triangles
+            size_t goal = (result.size() - target_index_count) / 6 + 1;
+            size_t applied = 0;
+            touched.assign(vertex_count, 0);
+            for (size_t i = 0; i < vertex_count; ++i)
+                collapse_to[i] = (unsigned int)i;
+
+            for (const Collapse& collapse : candidates)
+            {
+                if (collapse.cost > max_cost_allowed || applied >= goal)
+                    break;
+                if (touched[collapse.from] || touched[collapse.to])
+                    continue;
+
+                // The one ring of the moving vertex must be untouched this pass and no triangle may flip
+                glm::vec3 target = position(mesh, stride, collapse.to);
+                bool valid = true;
+                for (unsigned int k = adjacency_offsets[collapse.from]; valid && k < adjacency_offsets[collapse.from + 1]; ++k)
+                {
+                    const unsigned int* triangle = &result[(size_t)adjacency[k] * 3];
+                    for (int c = 0; c < 3; ++c)
+                        valid = valid && !touched[triangle[c]];
+                    if (!valid || triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+                        continue;
+
+                    glm::vec3 p[3], moved[3];
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        p[c] = position(mesh, stride, triangle[c]);
+                        moved[c] = triangle[c] == collapse.from ? target : p[c];
+                    }
+                    glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+                    glm::vec3 after = glm::cross(moved[1] - moved[0], moved[2] - moved[0]);
+                    valid = glm::dot(before, after) > 0.0f;
+                }
+                if (!valid)
+                    continue;
+
+                collapse_to[collapse.from] = collapse.to;
+                quadrics[collapse.to].Add(quadrics[collapse.from]);
+                for (unsigned int k = adjacency_offsets[collapse.from]; k < adjacency_offsets[collapse.from + 1]; ++k)
+                {
+                    const unsigned int* triangle = &result[(size_t)adjacency[k] * 3];
+                    touched[triangle[0]] = touched[triangle[1]] = touched[triangle[2]] = 1;
+                }
+                touched[collapse.to] = 1;
+                max_cost = std::max(max_cost, collapse.cost);
+                ++applied;
+            }
+
+            if (applied == 0)
+                break;
+
+            size_t write = 0;
+            for (size_t i = 0; i < result.size(); i += 3)
+            {
+                unsigned int a = collapse_to[result[i]], b = collapse_to[result[i + 1]], c = collapse_to[result[i + 2]];
+                if (a == b || b == c || a == c)
+                    continue;
+                result[write++] = a;
+                result[write++] = b;
+                result[write++] = c;
+            }
+            result.resize(write);
+        }
+
+        if (result_error)
+            *result_error = std::sqrt(max_cost);
+        return result;
+    }
+
+    std::vector<MeshLod> generate_lods(const MeshData& mesh, unsigned int max_lods, float ratio)
+    {
+        std::vector<MeshLod> lods(1);
+        lods[0].indices = mesh.indices;
+
+        while (lods.size() < max_lods)
+        {
+            const MeshLod& previous = lods.back();
+            size_t target = (size_t)(previous.indices.size() / 3 * ratio) * 3;
+            if (target < 3 * 8)
+                break;
+
+            // Each level starts from the previous one, so the errors add up
+            float error = 0.0f;
+            MeshLod lod;
+            lod.indices = simplify(mesh, previous.indices, target, 1e30f, &error);
+            if (lod.indices.empty() || lod.indices.size() > previous.indices.size() * 9 / 10)
+                break;
+            lod.error = previous.error + error;
+
+            optimize_vertex_cache(lod.indices, mesh.VertexCount());
+            lods.push_back(std::move(lod));
+        }
+
+        return lods;
+    }
+
+    float LodSelector::ProjectedError(float error, float distance) const
+    {
+        float pixels_per_unit = viewport_height / (2.0f * std::tan(fov_y * 0.5f));
+        return error / std::max(distance, 1e-4f) * pixels_per_unit;
+    }
+
+    unsigned int LodSelector::Select(const std::vector<float>& errors, float scale, const glm::vec3& center, float radius, const glm::vec3& camera_position) const
+    {
+        // Closest point of the bounding sphere, the camera inside it gets full detail
+        float distance = glm::length(center - camera_position) - radius;
+        if (distance <= 0.0f)
+            return 0;
+
+        unsigned int lod = 0;
+        for (unsigned int i = 1; i < errors.size(); ++i)
+        {
+            if (ProjectedError(errors[i] * scale, distance) > threshold)
+                break;
+            lod = i;
+        }
+        return lod;
+    }
+
+    void LodStats::Add(unsigned int lod, size_t lod_triangles, size_t full_mesh_triangles)
+    {
+        if (instances_per_lod.size() <= lod)
+            instances_per_lod.resize(lod + 1, 0);
+        ++instances_per_lod[lod];
+        ++instances;
+        submitted_triangles += lod_triangles;
+        full_triangles += full_mesh_triangles;
+    }
+
+    void LodStats::Reset()
+    {
+        instances = 0;
+        full_triangles = 0;
+        submitted_triangles = 0;
+        instances_per_lod.clear();
+    }
+
+    std::ostream& operator<<(std::ostream& os, const LodStats& stats)
+    {
+        os << stats.instances << " instances, " << stats.submitted_triangles << " triangles with LOD, " << stats.full_triangles << " without";
+        if (stats.full_triangles)
+            os << " (" << 100.0 * stats.submitted_triangles / stats.full_triangles << "%)";
+        os << ", per level:";
+        for (size_t count : stats.instances_per_lod)
+            os << " " << count;
+        return os;
+    }
+}
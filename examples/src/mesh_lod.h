@@ -0,0 +1,58 @@
+#ifndef _MESH_LOD_H
+#define _MESH_LOD_H
+
+#include "mesh_library.h"
+#include <glm/glm.hpp>
+#include <ostream>
+
+namespace Utility::mesh
+{
+    // One level of detail: an index list over the vertices of the full mesh
+    struct MeshLod
+    {
+        std::vector<unsigned int> indices;
+        float error = 0.0f;   // object space deviation from the full mesh
+    };
+
+    // Quadric error metric (Garland & Heckbert) edge collapse simplification. Vertices collapse onto
+    // one of their neighbours so the result indexes the original vertex buffer; attribute seams and
+    // open borders are kept in place. Stops at target_index_count or once the next collapse would
+    // exceed target_error (object space distance). result_error receives the largest error reached.
+    std::vector<unsigned int> simplify(const MeshData& mesh, const std::vector<unsigned int>& indices, size_t target_index_count,
+        float target_error = 1e30f, float* result_error = nullptr);
+
+    // LOD 0 is the mesh itself, every further level keeps about ratio times the triangles of the previous one.
+    // Stops early when a level cannot be reduced any further. Each level is vertex cache optimised.
+    std::vector<MeshLod> generate_lods(const MeshData& mesh, unsigned int max_lods = 5, float ratio = 0.5f);
+
+    // Picks a level per instance from its projected screen space error
+    struct LodSelector
+    {
+        float viewport_height = 600.0f;  // pixels
+        float fov_y = 0.785398f;         // vertical field of view in radians
+        float threshold = 1.0f;          // largest acceptable error in pixels
+
+        // Size in pixels of an object space error seen from the given distance
+        float ProjectedError(float error, float distance) const;
+
+        // Coarsest level whose error stays under the threshold. errors are the per level object space
+        // errors in increasing order, the bounds are in world space (scale already applied to radius).
+        unsigned int Select(const std::vector<float>& errors, float scale, const glm::vec3& center, float radius, const glm::vec3& camera_position) const;
+    };
+
+    // Triangles submitted in a frame with the selected levels against everything at LOD 0
+    struct LodStats
+    {
+        size_t instances = 0;
+        size_t full_triangles = 0;
+        size_t submitted_triangles = 0;
+        std::vector<size_t> instances_per_lod;
+
+        void Add(unsigned int lod, size_t lod_triangles, size_t full_mesh_triangles);
+        void Reset();
+    };
+
+    std::ostream& operator<<(std::ostream& os, const LodStats& stats);
+}
+
+#endif // !_MESH_LOD_H
@@ -0,0 +1,425 @@
+#include "mesh_optimizer.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace Utility::mesh
+{
+    namespace
+    {
+        // Triangles adjacent to each vertex in compressed row form
+        struct Adjacency
+        {
+            std::vector<unsigned int> offsets;
+            std::vector<unsigned int> counts;
+            std::vector<unsigned int> triangles;
+
+            Adjacency(const std::vector<unsigned int>& indices, size_t vertex_count) :
+                offsets(vertex_count + 1, 0), counts(vertex_count, 0), triangles(indices.size())
+            {
+                for (unsigned int index : indices)
+                    ++counts[index];
+                for (size_t v = 0; v < vertex_count; ++v)
+                    offsets[v + 1] = offsets[v] + counts[v];
+
+                std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+                for (size_t i = 0; i < indices.size(); ++i)
+                    triangles[fill[indices[i]]++] = (unsigned int)(i / 3);
+            }
+        };
+
+        // Forsyth's scoring parameters
+        const int kForsythCacheSize = 32;
+
+        float forsyth_vertex_score(int cache_position, unsigned int remaining)
+        {
+            if (remaining == 0)
+                return -1.0f;
+
+            float score = 0.0f;
+            if (cache_position >= 0)
+            {
+                // the three vertices of the last triangle get a fixed score so that strips are not favoured over fans
+                if (cache_position < 3)
+                    score = 0.75f;
+                else
+                    score = std::pow(1.0f - (float)(cache_position - 3) / (kForsythCacheSize - 3), 1.5f);
+            }
+
+            // boost vertices with few triangles left so that lone triangles are not left behind
+            score += 2.0f * std::pow((float)remaining, -0.5f);
+            return score;
+        }
+
+        glm::vec3 position_of(const MeshData& mesh, unsigned int index)
+        {
+            const float* v = &mesh.vertices[(size_t)index * vertex_stride(mesh.attributes)];
+            return glm::vec3(v[0], v[1], v[2]);
+        }
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VertexCacheStats& stats)
+    {
+        os << "ACMR " << stats.acmr << ", ATVR " << stats.atvr
+           << " (" << stats.transformed << " vertex shader invocations for "
+           << stats.triangles << " triangles / " << stats.vertices << " vertices)";
+        return os;
+    }
+
+    VertexCacheStats analyze_vertex_cache(const std::vector<unsigned int>& indices, size_t vertex_count, unsigned int cache_size)
+    {
+        VertexCacheStats stats;
+        stats.triangles = indices.size() / 3;
+
+        // A vertex is in the FIFO while fewer than cache_size misses happened after it was inserted
+        std::vector<unsigned int> timestamps(vertex_count, 0);
+        std::vector<bool> referenced(vertex_count, false);
+        unsigned int time = cache_size + 1;
+        for (unsigned int index : indices)
+        {
+            if (time - timestamps[index] > cache_size)
+            {
+                timestamps[index] = time++;
+                ++stats.transformed;
+            }
+            if (!referenced[index])
+            {
+                referenced[index] = true;
+                ++stats.vertices;
+            }
+        }
+
+        stats.acmr = stats.triangles ? (float)stats.transformed / stats.triangles : 0.0f;
+        stats.atvr = stats.vertices ? (float)stats.transformed / stats.vertices : 0.0f;
+        return stats;
+    }
+
+    void optimize_vertex_cache(std::vector<unsigned int>& indices, size_t vertex_count)
+    {
+        size_t triangle_count = indices.size() / 3;
+        if (triangle_count == 0)
+            return;
+
+        Adjacency adjacency(indices, vertex_count);
+        // remaining[v] triangles of vertex v are kept at the front of its adjacency range
+        std::vector<unsigned int> remaining(adjacency.counts);
+        std::vector<int> cache_position(vertex_count, -1);
+        std::vector<float> vertex_score(vertex_count);
+        for (size_t v = 0; v < vertex_count; ++v)
+            vertex_score[v] = forsyth_vertex_score(-1, remaining[v]);
+
+        std::vector<float> triangle_score(triangle_count);
+        std::vector<bool> emitted(triangle_count, false);
+        for (size_t t = 0; t < triangle_count; ++t)
+            triangle_score[t] = vertex_score[indices[t * 3]] + vertex_score[indices[t * 3 + 1]] + vertex_score[indices[t * 3 + 2]];
+
+        std::vector<unsigned int> output;
+        output.reserve(indices.size());
+
+        std::vector<unsigned int> cache, next_cache;
+        cache.reserve(kForsythCacheSize + 3);
+        next_cache.reserve(kForsythCacheSize + 3);
+
+        int best = (int)(std::max_element(triangle_score.begin(), triangle_score.end()) - triangle_score.begin());
+        size_t cursor = 0;
+
+        for (size_t emitted_count = 0; emitted_count < triangle_count; ++emitted_count)
+        {
+            if (best < 0)
+            {
+                // nothing left around the cache, continue with the next triangle in input order
+                while (emitted[cursor])
+                    ++cursor;
+                best = (int)cursor;
+            }
+
+            const unsigned int* tri = &indices[(size_t)best * 3];
+            output.insert(output.end(), tri, tri + 3);
+            emitted[best] = true;
+
+            // detach the triangle from its vertices
+            for (int k = 0; k < 3; ++k)
+            {
+                unsigned int v = tri[k];
+                unsigned int* begin = &adjacency.triangles[adjacency.offsets[v]];
+                unsigned int* end = begin + remaining[v];
+                unsigned int* found = std::find(begin, end, (unsigned int)best);
+                if (found != end)
+                {
+                    std::swap(*found, *(end - 1));
+                    --remaining[v];
+                }
+            }
+
+            // move the triangle's vertices to the front of the LRU cache
+            next_cache.assign(tri, tri + 3);
+            for (unsigned int v : cache)
+            {
+                if (v != tri[0] && v != tri[1] && v != tri[2])
+                    next_cache.push_back(v);
+            }
+
+            for (size_t i = 0; i < next_cache.size(); ++i)
+            {
+                unsigned int v = next_cache[i];
+                cache_position[v] = i < (size_t)kForsythCacheSize ? (int)i : -1;
+                vertex_score[v] = forsyth_vertex_score(cache_position[v], remaining[v]);
+            }
+
+            // rescore the triangles around the cache and pick the best one
+            best = -1;
+            float best_score = -1.0f;
+            for (unsigned int v : next_cache)
+            {
+                for (unsigned int i = 0; i < remaining[v]; ++i)
+                {
+                    unsigned int t = adjacency.triangles[adjacency.offsets[v] + i];
+                    float score = vertex_score[indices[t * 3]] + vertex_score[indices[t * 3 + 1]] + vertex_score[indices[t * 3 + 2]];
+                    triangle_score[t] = score;
+                    if (score > best_score)
+                    {
+                        best_score = score;
+                        best = (int)t;
+                    }
+                }
+            }
+
+            if (next_cache.size() > (size_t)kForsythCacheSize)
+                next_cache.resize(kForsythCacheSize);
+            cache.swap(next_cache);
+        }
+
+        indices.swap(output);
+    }
+
+    void optimize_vertex_cache_tipsify(std::vector<unsigned int>& indices, size_t vertex_count, unsigned int cache_size)
+    {
+        size_t triangle_count = indices.size() / 3;
+        if (triangle_count == 0)
+            return;
+
+        Adjacency adjacency(indices, vertex_count);
+        std::vector<unsigned int> live(adjacency.counts);
+        std::vector<unsigned int> timestamps(vertex_count, 0);
+        std::vector<bool> emitted(triangle_count, false);
+        std::vector<unsigned int> dead_end;
+        std::vector<unsigned int> candidates;
+
+        std::vector<unsigned int> output;
+        output.reserve(indices.size());
+
+        int fanning = (int)indices[0];
+        unsigned int time = cache_size + 1;
+        size_t cursor = 0;
+
+        while (fanning >= 0)
+        {
+            candidates.clear();
+
+            // emit every remaining triangle around the fanning vertex
+            for (unsigned int i = adjacency.offsets[fanning]; i < adjacency.offsets[fanning + 1]; ++i)
+            {
+                unsigned int t = adjacency.triangles[i];
+                if (emitted[t])
+                    continue;
+
+                for (int k = 0; k < 3; ++k)
+                {
+                    unsigned int v = indices[t * 3 + k];
+                    output.push_back(v);
+                    dead_end.push_back(v);
+                    candidates.push_back(v);
+                    --live[v];
+                    if (time - timestamps[v] > cache_size)
+                        timestamps[v] = time++;
+                }
+                emitted[t] = true;
+            }
+
+            // next fanning vertex: the candidate that will still be in the cache after its own triangles are emitted
+            int next = -1;
+            int best_priority = -1;
+            for (unsigned int v : candidates)
+            {
+                if (live[v] == 0)
+                    continue;
+
+                int priority = 0;
+                if (time - timestamps[v] + 2 * live[v] <= cache_size)
+                    priority = (int)(time - timestamps[v]);
+                if (priority > best_priority)
+                {
+                    best_priority = priority;
+                    next = (int)v;
+                }
+            }
+
+            // dead end: backtrack through recently used vertices, then fall back to input order
+            while (next < 0 && !dead_end.empty())
+            {
+                unsigned int v = dead_end.back();
+                dead_end.pop_back();
+                if (live[v] > 0)
+                    next = (int)v;
+            }
+            while (next < 0 && cursor < vertex_count)
+            {
+                if (live[cursor] > 0)
+                    next = (int)cursor;
+                ++cursor;
+            }
+
+            fanning = next;
+        }
+
+        indices.swap(output);
+    }
+
+    void optimize_overdraw(std::vector<unsigned int>& indices, const MeshData& mesh, float threshold, unsigned int cache_size)
+    {
+        size_t triangle_count = indices.size() / 3;
+        if (triangle_count == 0)
+            return;
+
+        size_t vertex_count = mesh.VertexCount();
+
+        // 1. hard boundaries where the cache is effectively flushed (all three vertices of a triangle miss)
+        std::vector<size_t> hard;
+        {
+            std::vector<unsigned int> timestamps(vertex_count, 0);
+            unsigned int time = cache_size + 1;
+            for (size_t t = 0; t < triangle_count; ++t)
+            {
+                int misses = 0;
+                for (int k = 0; k < 3; ++k)
+                {
+                    unsigned int v = indices[t * 3 + k];
+                    if (time - timestamps[v] > cache_size)
+                    {
+                        timestamps[v] = time++;
+                        ++misses;
+                    }
+                }
+                if (t == 0 || misses == 3)
+                    hard.push_back(t);
+            }
+            hard.push_back(triangle_count);
+        }
+
+        // 2. soft boundaries inside each hard cluster once the running ACMR is within the threshold
+        std::vector<size_t> clusters;
+        {
+            std::vector<unsigned int> timestamps(vertex_count, 0);
+            unsigned int time = cache_size + 1;
+            for (size_t c = 0; c + 1 < hard.size(); ++c)
+            {
+                size_t begin = hard[c], end = hard[c + 1];
+
+                std::vector<unsigned int> range(indices.begin() + begin * 3, indices.begin() + end * 3);
+                float target = analyze_vertex_cache(range, vertex_count, cache_size).acmr * threshold;
+
+                time += cache_size + 1;
+                size_t misses = 0, triangles = 0;
+                clusters.push_back(begin);
+                for (size_t t = begin; t < end; ++t)
+                {
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        unsigned int v = indices[t * 3 + k];
+                        if (time - timestamps[v] > cache_size)
+                        {
+                            timestamps[v] = time++;
+                            ++misses;
+                        }
+                    }
+                    ++triangles;
+
+                    if (t + 1 < end && (float)misses / triangles <= target)
+                    {
+                        clusters.push_back(t + 1);
+                        time += cache_size + 1;
+                        misses = triangles = 0;
+                    }
+                }
+            }
+            clusters.push_back(triangle_count);
+        }
+
+        // 3. sort clusters by how far they face away from the mesh center, outermost first
+        glm::vec3 mesh_center(0.0f);
+        float mesh_area = 0.0f;
+        struct Cluster { size_t begin, end; float key; };
+        std::vector<Cluster> sorted;
+        std::vector<glm::vec3> cluster_centroid;
+        std::vector<glm::vec3> cluster_normal;
+
+        for (size_t c = 0; c + 1 < clusters.size(); ++c)
+        {
+            glm::vec3 centroid(0.0f), normal(0.0f);
+            float area = 0.0f;
+            for (size_t t = clusters[c]; t < clusters[c + 1]; ++t)
+            {
+                glm::vec3 p0 = position_of(mesh, indices[t * 3]);
+                glm::vec3 p1 = position_of(mesh, indices[t * 3 + 1]);
+                glm::vec3 p2 = position_of(mesh, indices[t * 3 + 2]);
+                glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+                float a = glm::length(n);
+                centroid += (p0 + p1 + p2) * (a / 3.0f);
+                normal += n;
+                area += a;
+            }
+
+            mesh_center += centroid;
+            mesh_area += area;
+            cluster_centroid.push_back(area > 0.0f ? centroid / area : centroid);
+            cluster_normal.push_back(normal);
+            sorted.push_back({ clusters[c], clusters[c + 1], 0.0f });
+        }
+
+        if (mesh_area > 0.0f)
+            mesh_center = mesh_center / mesh_area;
+
+        for (size_t c = 0; c < sorted.size(); ++c)
+        {
+            float length = glm::length(cluster_normal[c]);
+            sorted[c].key = length > 0.0f ? glm::dot(cluster_centroid[c] - mesh_center, cluster_normal[c] / length) : 0.0f;
+        }
+
+        std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster& a, const Cluster& b) { return a.key > b.key; });
+
+        std::vector<unsigned int> output;
+        output.reserve(indices.size());
+        for (const Cluster& cluster : sorted)
+            output.insert(output.end(), indices.begin() + cluster.begin * 3, indices.begin() + cluster.end * 3);
+        indices.swap(output);
+    }
+
+    void optimize_vertex_fetch(MeshData& mesh)
+    {
+        unsigned int stride = vertex_stride(mesh.attributes);
+        std::vector<unsigned int> remap(mesh.VertexCount(), ~0u);
+        std::vector<float> vertices;
+        vertices.reserve(mesh.vertices.size());
+
+        unsigned int next = 0;
+        for (unsigned int& index : mesh.indices)
+        {
+            if (remap[index] == ~0u)
+            {
+                remap[index] = next++;
+                const float* v = &mesh.vertices[(size_t)index * stride];
+                vertices.insert(vertices.end(), v, v + stride);
+            }
+            index = remap[index];
+        }
+
+        mesh.vertices.swap(vertices);
+    }
+
+    void optimize(MeshData& mesh, float overdraw_threshold)
+    {
+        optimize_vertex_cache(mesh.indices, mesh.VertexCount());
+        optimize_overdraw(mesh.indices, mesh, overdraw_threshold);
+        optimize_vertex_fetch(mesh);
+    }
+}
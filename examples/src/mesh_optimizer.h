@@ -0,0 +1,43 @@
+#ifndef _MESH_OPTIMIZER_H
+#define _MESH_OPTIMIZER_H
+
+#include "mesh_library.h"
+#include <ostream>
+
+namespace Utility::mesh
+{
+    // Post-transform cache efficiency of a triangle list, simulated with a FIFO cache
+    struct VertexCacheStats
+    {
+        size_t triangles = 0;
+        size_t vertices = 0;     // vertices referenced by the index buffer
+        size_t transformed = 0;  // cache misses, i.e. vertex shader invocations
+        float acmr = 0.0f;       // average cache miss ratio: transformed / triangles (0.5 is ideal on large grids)
+        float atvr = 0.0f;       // average transformed vertex ratio: transformed / vertices (1.0 is ideal)
+    };
+
+    std::ostream& operator<<(std::ostream& os, const VertexCacheStats& stats);
+
+    VertexCacheStats analyze_vertex_cache(const std::vector<unsigned int>& indices, size_t vertex_count, unsigned int cache_size = 16);
+
+    // Reorders triangles for the post-transform cache with Forsyth's linear-speed vertex cache optimisation
+    void optimize_vertex_cache(std::vector<unsigned int>& indices, size_t vertex_count);
+
+    // Reorders triangles with Tipsify (Sander et al. 2007) for a cache of the given size.
+    // Faster than Forsyth and tuned for an exact cache size.
+    void optimize_vertex_cache_tipsify(std::vector<unsigned int>& indices, size_t vertex_count, unsigned int cache_size = 16);
+
+    // Reorders clusters of a cache optimised triangle list so that outward facing clusters are drawn first.
+    // Clusters are split at cache flush points and wherever their ACMR stays within threshold times the original,
+    // so the vertex cache efficiency degrades by at most that factor.
+    void optimize_overdraw(std::vector<unsigned int>& indices, const MeshData& mesh, float threshold = 1.05f, unsigned int cache_size = 16);
+
+    // Reorders the vertices in the order the index buffer first references them and drops unused ones.
+    // Improves pre-transform (vertex fetch) cache locality; run it after the triangle order is final.
+    void optimize_vertex_fetch(MeshData& mesh);
+
+    // Vertex cache, overdraw and vertex fetch passes in the recommended order
+    void optimize(MeshData& mesh, float overdraw_threshold = 1.05f);
+}
+
+#endif // !_MESH_OPTIMIZER_H
@@ -0,0 +1,172 @@
+#include "mesh_utils.h"
+#include <cstring>
+
+namespace Utility::mesh
+{
+    namespace
+    {
+        uint32_t hash_vertex(const float* vertex, unsigned int stride)
+        {
+            // FNV-1a over the float bits, with -0.0 folded into 0.0 so both weld together
+            uint32_t hash = 2166136261u;
+            for (unsigned int i = 0; i < stride; ++i)
+            {
+                float value = vertex[i] == 0.0f ? 0.0f : vertex[i];
+                uint32_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                for (int b = 0; b < 4; ++b)
+                {
+                    hash ^= (bits >> (b * 8)) & 0xFF;
+                    hash *= 16777619u;
+                }
+            }
+            return hash;
+        }
+
+        bool equal_vertex(const float* a, const float* b, unsigned int stride)
+        {
+            for (unsigned int i = 0; i < stride; ++i)
+            {
+                if (a[i] != b[i])
+                    return false;
+            }
+            return true;
+        }
+
+        // Open addressing table of output vertex indices keyed by vertex contents
+        class VertexTable
+        {
+        public:
+            VertexTable(size_t expected, unsigned int stride) : stride_(stride)
+            {
+                size_t capacity = 16;
+                while (capacity < expected * 2)
+                    capacity *= 2;
+                slots_.assign(capacity, ~0u);
+            }
+
+            unsigned int Insert(const float* vertex, std::vector<float>& vertices)
+            {
+                size_t mask = slots_.size() - 1;
+                size_t slot = hash_vertex(vertex, stride_) & mask;
+                while (slots_[slot] != ~0u)
+                {
+                    if (equal_vertex(&vertices[(size_t)slots_[slot] * stride_], vertex, stride_))
+                        return slots_[slot];
+                    slot = (slot + 1) & mask;
+                }
+
+                unsigned int index = (unsigned int)(vertices.size() / stride_);
+                vertices.insert(vertices.end(), vertex, vertex + stride_);
+                slots_[slot] = index;
+                return index;
+            }
+
+        private:
+            unsigned int stride_;
+            std::vector<unsigned int> slots_;
+        };
+
+        void fill_report(WeldReport* report, size_t input_vertices, const MeshData& result)
+        {
+            if (!report)
+                return;
+
+            unsigned int stride = vertex_stride(result.attributes);
+            report->input_vertices = input_vertices;
+            report->output_vertices = result.VertexCount();
+            report->index_count = result.indices.size();
+            report->input_bytes = input_vertices * stride * sizeof(float);
+            report->output_bytes = result.vertices.size() * sizeof(float) + make_index_buffer(result.indices).data.size();
+        }
+    }
+
+    float WeldReport::Reduction() const
+    {
+        if (input_vertices == 0)
+            return 0.0f;
+        return 1.0f - (float)output_vertices / (float)input_vertices;
+    }
+
+    std::ostream& operator<<(std::ostream& os, const WeldReport& report)
+    {
+        os << "vertices " << report.input_vertices << " -> " << report.output_vertices
+           << " (" << report.Reduction() * 100.0f << "% fewer), "
+           << report.index_count << " indices, "
+           << report.input_bytes << " -> " << report.output_bytes << " bytes";
+        return os;
+    }
+
+    size_t IndexBuffer::IndexSize() const
+    {
+        return type == GL_UNSIGNED_SHORT ? sizeof(unsigned short) : sizeof(unsigned int);
+    }
+
+    size_t IndexBuffer::Count() const
+    {
+        return data.size() / IndexSize();
+    }
+
+    MeshData weld(const float* vertices, size_t vertex_count, unsigned int attributes, WeldReport* report)
+    {
+        unsigned int stride = vertex_stride(attributes);
+
+        MeshData result;
+        result.attributes = attributes;
+        result.indices.reserve(vertex_count);
+
+        VertexTable table(vertex_count, stride);
+        for (size_t i = 0; i < vertex_count; ++i)
+            result.indices.push_back(table.Insert(vertices + i * stride, result.vertices));
+
+        fill_report(report, vertex_count, result);
+        return result;
+    }
+
+    MeshData weld(const MeshData& mesh, WeldReport* report)
+    {
+        unsigned int stride = vertex_stride(mesh.attributes);
+        size_t vertex_count = mesh.VertexCount();
+
+        MeshData result;
+        result.attributes = mesh.attributes;
+
+        // Vertices are visited in index order so unreferenced ones are dropped as well
+        std::vector<unsigned int> remap(vertex_count, ~0u);
+        VertexTable table(vertex_count, stride);
+        result.indices.reserve(mesh.indices.size());
+        for (unsigned int index : mesh.indices)
+        {
+            if (remap[index] == ~0u)
+                remap[index] = table.Insert(&mesh.vertices[(size_t)index * stride], result.vertices);
+            result.indices.push_back(remap[index]);
+        }
+
+        fill_report(report, vertex_count, result);
+        return result;
+    }
+
+    IndexBuffer make_index_buffer(const std::vector<unsigned int>& indices)
+    {
+        unsigned int max_index = 0;
+        for (unsigned int index : indices)
+            max_index = index > max_index ? index : max_index;
+
+        IndexBuffer buffer;
+        if (max_index < 0xFFFF)
+        {
+            buffer.type = GL_UNSIGNED_SHORT;
+            buffer.data.resize(indices.size() * sizeof(unsigned short));
+            unsigned short* out = reinterpret_cast<unsigned short*>(buffer.data.data());
+            for (size_t i = 0; i < indices.size(); ++i)
+                out[i] = (unsigned short)indices[i];
+        }
+        else
+        {
+            buffer.type = GL_UNSIGNED_INT;
+            buffer.data.resize(indices.size() * sizeof(unsigned int));
+            std::memcpy(buffer.data.data(), indices.data(), buffer.data.size());
+        }
+        return buffer;
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef _MESH_UTILS_H
+#define _MESH_UTILS_H
+
+#include "mesh_library.h"
+#include <ostream>
+
+namespace Utility::mesh
+{
+    // Index data in the smallest type that can address every vertex
+    struct IndexBuffer
+    {
+        GLenum type = GL_UNSIGNED_INT;
+        std::vector<unsigned char> data;
+
+        size_t IndexSize() const;
+        size_t Count() const;
+    };
+
+    // Merges identical vertices of a non-indexed triangle list (3 vertices per triangle)
+    MeshData weld(const float* vertices, size_t vertex_count, unsigned int attributes, WeldReport* report = nullptr);
+
+    // Merges identical vertices of an indexed mesh and remaps its indices
+    MeshData weld(const MeshData& mesh, WeldReport* report = nullptr);
+
+    // 16-bit indices when every index fits (0xFFFF stays free for primitive restart), 32-bit otherwise
+    IndexBuffer make_index_buffer(const std::vector<unsigned int>& indices);
+}
+
+#endif // !_MESH_UTILS_H
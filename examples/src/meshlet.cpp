@@ -0,0 +1,252 @@
+#include "meshlet.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Utility::mesh
+{
+    namespace
+    {
+        glm::vec3 position(const MeshData& mesh, unsigned int stride, unsigned int vertex)
+        {
+            const float* p = &mesh.vertices[(size_t)vertex * stride];
+            return glm::vec3(p[0], p[1], p[2]);
+        }
+
+        void compute_bounds(const MeshData& mesh, unsigned int stride, const MeshletMesh& result, Meshlet& meshlet)
+        {
+            const unsigned int* vertices = &result.vertices[meshlet.vertex_offset];
+            const unsigned char* triangles = &result.triangles[meshlet.triangle_offset];
+
+            // Sphere around the AABB center
+            glm::vec3 min_bound = position(mesh, stride, vertices[0]), max_bound = min_bound;
+            for (unsigned int i = 1; i < meshlet.vertex_count; ++i)
+            {
+                glm::vec3 p = position(mesh, stride, vertices[i]);
+                min_bound = glm::min(min_bound, p);
+                max_bound = glm::max(max_bound, p);
+            }
+            meshlet.center = (min_bound + max_bound) * 0.5f;
+            meshlet.radius = 0.0f;
+            for (unsigned int i = 0; i < meshlet.vertex_count; ++i)
+                meshlet.radius = std::max(meshlet.radius, glm::length(position(mesh, stride, vertices[i]) - meshlet.center));
+
+            // Normal cone from the average triangle normal and the widest deviation from it
+            std::vector<glm::vec3> normals(meshlet.triangle_count);
+            glm::vec3 axis(0.0f);
+            for (unsigned int t = 0; t < meshlet.triangle_count; ++t)
+            {
+                glm::vec3 p0 = position(mesh, stride, vertices[triangles[t * 3]]);
+                glm::vec3 p1 = position(mesh, stride, vertices[triangles[t * 3 + 1]]);
+                glm::vec3 p2 = position(mesh, stride, vertices[triangles[t * 3 + 2]]);
+                glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+                float length = glm::length(normal);
+                normals[t] = length > 0.0f ? normal / length : glm::vec3(0.0f);
+                axis += normals[t];
+            }
+
+            meshlet.cone_apex = meshlet.center;
+            meshlet.cone_axis = glm::vec3(0.0f, 0.0f, 1.0f);
+            meshlet.cone_cutoff = 1.0f;
+
+            float axis_length = glm::length(axis);
+            if (axis_length == 0.0f)
+                return;
+            axis = axis / axis_length;
+
+            float min_dot = 1.0f;
+            for (const glm::vec3& normal : normals)
+            {
+                if (normal != glm::vec3(0.0f))
+                    min_dot = std::min(min_dot, glm::dot(normal, axis));
+            }
+            meshlet.cone_axis = axis;
+            if (min_dot <= 0.1f)
+                return; // a cone wider than ~84 degrees is never entirely back facing in practice
+
+            // Apex behind every triangle plane along the axis
+            float max_t = 0.0f;
+            for (unsigned int t = 0; t < meshlet.triangle_count; ++t)
+            {
+                if (normals[t] == glm::vec3(0.0f))
+                    continue;
+                glm::vec3 p0 = position(mesh, stride, vertices[triangles[t * 3]]);
+                float dc = glm::dot(meshlet.center - p0, normals[t]);
+                float dn = glm::dot(axis, normals[t]);
+                max_t = std::max(max_t, dc / dn);
+            }
+            meshlet.cone_apex = meshlet.center - axis * max_t;
+            meshlet.cone_cutoff = std::sqrt(1.0f - min_dot * min_dot);
+        }
+    }
+
+    size_t MeshletMesh::TriangleCount() const
+    {
+        return triangles.size() / 3;
+    }
+
+    std::ostream& operator<<(std::ostream& os, const MeshletCullStats& stats)
+    {
+        os << stats.visible << "/" << stats.meshlets << " meshlets visible (" << stats.backface_culled << " back facing, "
+           << stats.frustum_culled << " off screen), " << stats.visible_triangles << "/" << stats.triangles << " triangles";
+        if (stats.triangles)
+            os << " (" << 100.0 * stats.visible_triangles / stats.triangles << "%)";
+        return os;
+    }
+
+    MeshletMesh build_meshlets(const MeshData& mesh, unsigned int max_vertices, unsigned int max_triangles)
+    {
+        max_vertices = std::min(std::max(max_vertices, 3u), 256u);
+        max_triangles = std::max(max_triangles, 1u);
+
+        unsigned int stride = vertex_stride(mesh.attributes);
+        size_t vertex_count = mesh.VertexCount();
+        size_t triangle_count = mesh.indices.size() / 3;
+
+        // vertex -> triangle adjacency
+        std::vector<unsigned int> offsets(vertex_count + 1, 0), adjacency(triangle_count * 3);
+        for (size_t i = 0; i < triangle_count * 3; ++i)
+            ++offsets[mesh.indices[i] + 1];
+        for (size_t v = 0; v < vertex_count; ++v)
+            offsets[v + 1] += offsets[v];
+        {
+            std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+            for (size_t i = 0; i < triangle_count * 3; ++i)
+                adjacency[fill[mesh.indices[i]]++] = (unsigned int)(i / 3);
+        }
+
+        std::vector<unsigned char> emitted(triangle_count, 0);
+        std::vector<int> local(vertex_count, -1);  // local index of a vertex in the open meshlet
+
+        MeshletMesh result;
+        Meshlet current = {};
+        glm::vec3 centroid_sum(0.0f);
+        size_t seed = 0;
+
+        auto flush = [&]() {
+            if (current.triangle_count == 0)
+                return;
+            compute_bounds(mesh, stride, result, current);
+            result.meshlets.push_back(current);
+            for (unsigned int i = 0; i < current.vertex_count; ++i)
+                local[result.vertices[current.vertex_offset + i]] = -1;
+
+            current = {};
+            current.vertex_offset = (unsigned int)result.vertices.size();
+            current.triangle_offset = (unsigned int)result.triangles.size();
+            centroid_sum = glm::vec3(0.0f);
+        };
+
+        auto triangle_centroid = [&](size_t t) {
+            return (position(mesh, stride, mesh.indices[t * 3]) + position(mesh, stride, mesh.indices[t * 3 + 1])
+                + position(mesh, stride, mesh.indices[t * 3 + 2])) * (1.0f / 3.0f);
+        };
+
+        for (size_t added = 0; added < triangle_count; ++added)
+        {
+            // Best unemitted triangle touching the open meshlet
+            size_t best = triangle_count;
+            int best_new = 4;
+            float best_distance = 0.0f;
+            glm::vec3 center = current.triangle_count ? centroid_sum / (float)current.triangle_count : glm::vec3(0.0f);
+            for (unsigned int i = 0; i < current.vertex_count; ++i)
+            {
+                unsigned int v = result.vertices[current.vertex_offset + i];
+                for (unsigned int k = offsets[v]; k < offsets[v + 1]; ++k)
+                {
+                    unsigned int t = adjacency[k];
+                    if (emitted[t])
+                        continue;
+                    int extra = (local[mesh.indices[t * 3]] < 0) + (local[mesh.indices[t * 3 + 1]] < 0) + (local[mesh.indices[t * 3 + 2]] < 0);
+                    if (extra > best_new)
+                        continue;
+                    float distance = glm::length(triangle_centroid(t) - center);
+                    if (extra < best_new || distance < best_distance)
+                    {
+                        best = t;
+                        best_new = extra;
+                        best_distance = distance;
+                    }
+                }
+            }
+
+            if (best == triangle_count)
+            {
+                // Nothing adjacent is left: continue with the next triangle in index order, which is
+                // usually close by in a cache optimised mesh
+                while (emitted[seed])
+                    ++seed;
+                best = seed;
+                best_new = (local[mesh.indices[best * 3]] < 0) + (local[mesh.indices[best * 3 + 1]] < 0) + (local[mesh.indices[best * 3 + 2]] < 0);
+            }
+            if (current.vertex_count + best_new > max_vertices || current.triangle_count + 1 > max_triangles)
+            {
+                flush();
+                while (emitted[seed])
+                    ++seed;
+                best = seed;
+            }
+
+            emitted[best] = 1;
+            for (int c = 0; c < 3; ++c)
+            {
+                unsigned int v = mesh.indices[best * 3 + c];
+                if (local[v] < 0)
+                {
+                    local[v] = (int)current.vertex_count++;
+                    result.vertices.push_back(v);
+                }
+                result.triangles.push_back((unsigned char)local[v]);
+            }
+            ++current.triangle_count;
+            centroid_sum += triangle_centroid(best);
+        }
+        flush();
+
+        return result;
+    }
+
+    void cull_meshlets(const MeshletMesh& meshlets, const glm::mat4& model, const Frustum& frustum, const glm::vec3& camera_position,
+        std::vector<unsigned int>& indices, MeshletCullStats* stats)
+    {
+        // The cone test runs in object space, the frustum test in world space
+        glm::vec3 local_camera = glm::vec3(glm::inverse(model) * glm::vec4(camera_position, 1.0f));
+        float scale = std::max(glm::length(glm::vec3(model[0])), std::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+
+        MeshletCullStats local_stats;
+        for (const Meshlet& meshlet : meshlets.meshlets)
+        {
+            ++local_stats.meshlets;
+            local_stats.triangles += meshlet.triangle_count;
+
+            if (glm::dot(glm::normalize(meshlet.cone_apex - local_camera), meshlet.cone_axis) >= meshlet.cone_cutoff)
+            {
+                ++local_stats.backface_culled;
+                continue;
+            }
+
+            glm::vec3 world_center = glm::vec3(model * glm::vec4(meshlet.center, 1.0f));
+            if (!frustum.IntersectsSphere(world_center, meshlet.radius * scale))
+            {
+                ++local_stats.frustum_culled;
+                continue;
+            }
+
+            ++local_stats.visible;
+            local_stats.visible_triangles += meshlet.triangle_count;
+            const unsigned int* vertices = &meshlets.vertices[meshlet.vertex_offset];
+            const unsigned char* triangles = &meshlets.triangles[meshlet.triangle_offset];
+            for (unsigned int i = 0; i < meshlet.triangle_count * 3; ++i)
+                indices.push_back(vertices[triangles[i]]);
+        }
+
+        if (stats)
+        {
+            stats->meshlets += local_stats.meshlets;
+            stats->visible += local_stats.visible;
+            stats->backface_culled += local_stats.backface_culled;
+            stats->frustum_culled += local_stats.frustum_culled;
+            stats->triangles += local_stats.triangles;
+            stats->visible_triangles += local_stats.visible_triangles;
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef _MESHLET_H
+#define _MESHLET_H
+
+#include "mesh_library.h"
+#include "frustum.h"
+#include <glm/glm.hpp>
+#include <ostream>
+
+namespace Utility::mesh
+{
+    // A small cluster of triangles with its own culling bounds
+    struct Meshlet
+    {
+        unsigned int vertex_offset;    // into MeshletMesh::vertices
+        unsigned int triangle_offset;  // into MeshletMesh::triangles, 3 local indices per triangle
+        unsigned int vertex_count;
+        unsigned int triangle_count;
+
+        glm::vec3 center;              // bounding sphere
+        float radius;
+        glm::vec3 cone_apex;           // normal cone, the cluster is back facing for every viewer with
+        glm::vec3 cone_axis;           // dot(normalize(cone_apex - viewer), cone_axis) >= cone_cutoff
+        float cone_cutoff;             // 1 when the normals spread too far to ever cull
+    };
+
+    struct MeshletMesh
+    {
+        std::vector<Meshlet> meshlets;
+        std::vector<unsigned int> vertices;   // meshlet local vertex -> mesh vertex
+        std::vector<unsigned char> triangles; // meshlet local indices
+
+        size_t TriangleCount() const;
+    };
+
+    const unsigned int kMeshletMaxVertices = 64;
+    const unsigned int kMeshletMaxTriangles = 124;
+
+    // Greedily grows clusters over shared vertices, preferring triangles that add the fewest new
+    // vertices and then the ones closest to the cluster. Vertex cache optimised input gives better clusters.
+    MeshletMesh build_meshlets(const MeshData& mesh, unsigned int max_vertices = kMeshletMaxVertices, unsigned int max_triangles = kMeshletMaxTriangles);
+
+    struct MeshletCullStats
+    {
+        size_t meshlets = 0;
+        size_t visible = 0;
+        size_t backface_culled = 0;
+        size_t frustum_culled = 0;
+        size_t triangles = 0;
+        size_t visible_triangles = 0;
+    };
+
+    std::ostream& operator<<(std::ostream& os, const MeshletCullStats& stats);
+
+    // Rejects clusters outside the frustum (world space planes, model is the instance transform) and
+    // clusters facing away from the camera, then appends the surviving triangles to indices as mesh
+    // vertex indices. The normal cone test assumes a model matrix without non-uniform scale.
+    void cull_meshlets(const MeshletMesh& meshlets, const glm::mat4& model, const Frustum& frustum, const glm::vec3& camera_position,
+        std::vector<unsigned int>& indices, MeshletCullStats* stats = nullptr);
+}
+
+#endif // !_MESHLET_H
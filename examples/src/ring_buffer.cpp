@@ -0,0 +1,191 @@
+#include "ring_buffer.h"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+
+namespace Utility
+{
+    RingBuffer::~RingBuffer()
+    {
+        Release();
+    }
+
+    bool RingBuffer::Create(GLenum target, size_t frame_bytes, bool force_orphaning)
+    {
+        Release();
+        if (frame_bytes == 0)
+            return false;
+
+        target_ = target;
+        frame_bytes_ = frame_bytes;
+        mode_ = GLEW_ARB_buffer_storage && !force_orphaning ? Mode::Persistent : Mode::Orphaning;
+
+        glGenBuffers(1, &buffer_);
+        glBindBuffer(target_, buffer_);
+        if (mode_ == Mode::Persistent)
+        {
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glBufferStorage(target_, frame_bytes_ * kFrames, nullptr, flags);
+            mapped_ = static_cast<unsigned char*>(glMapBufferRange(target_, 0, frame_bytes_ * kFrames, flags));
+            if (!mapped_)
+            {
+                std::cerr << "ERROR::RING_BUFFER::PERSISTENT_MAP_FAILED, falling back to orphaning" << std::endl;
+                glDeleteBuffers(1, &buffer_);
+                glGenBuffers(1, &buffer_);
+                glBindBuffer(target_, buffer_);
+                mode_ = Mode::Orphaning;
+            }
+        }
+        if (mode_ == Mode::Orphaning)
+        {
+            // One region is enough, orphaning hands the driver a new block every frame
+            glBufferData(target_, frame_bytes_, nullptr, GL_STREAM_DRAW);
+            staging_.resize(frame_bytes_);
+        }
+        glBindBuffer(target_, 0);
+
+        region_ = kFrames - 1;
+        head_ = flushed_ = 0;
+        in_frame_ = false;
+        stats_ = Stats();
+        return true;
+    }
+
+    void RingBuffer::Release()
+    {
+        for (GLsync& fence : fences_)
+        {
+            if (fence)
+                glDeleteSync(fence);
+            fence = nullptr;
+        }
+        if (buffer_)
+        {
+            if (mapped_)
+            {
+                glBindBuffer(target_, buffer_);
+                glUnmapBuffer(target_);
+                glBindBuffer(target_, 0);
+            }
+            glDeleteBuffers(1, &buffer_);
+        }
+        buffer_ = 0;
+        mapped_ = nullptr;
+        staging_.clear();
+        staging_.shrink_to_fit();
+    }
+
+    void RingBuffer::BeginFrame()
+    {
+        if (in_frame_)
+            EndFrame();
+        region_ = (region_ + 1) % kFrames;
+        head_ = flushed_ = 0;
+        in_frame_ = true;
+        ++stats_.frames;
+
+        if (mode_ == Mode::Orphaning)
+        {
+            // Re-specifying with the same size lets the driver swap in fresh storage instead of
+            // waiting for the draws that still read the old contents
+            glBindBuffer(target_, buffer_);
+            glBufferData(target_, frame_bytes_, nullptr, GL_STREAM_DRAW);
+            glBindBuffer(target_, 0);
+            return;
+        }
+
+        GLsync& fence = fences_[region_];
+        if (!fence)
+            return;
+
+        // Poll first so a region that is already free does not count as a wait
+        GLenum status = glClientWaitSync(fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+        {
+            ++stats_.fence_waits;
+            auto start = std::chrono::steady_clock::now();
+            GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+            do
+            {
+                status = glClientWaitSync(fence, flags, 1000000); // 1 ms steps
+                flags = 0;
+            } while (status == GL_TIMEOUT_EXPIRED);
+            stats_.wait_milliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    RingBuffer::Allocation RingBuffer::Allocate(size_t bytes, size_t alignment)
+    {
+        Allocation allocation;
+        if (!in_frame_ || !buffer_)
+            return allocation;
+
+        // Offsets are aligned in buffer space, which is what glBindBufferRange checks
+        alignment = std::max<size_t>(alignment, 1);
+        size_t region = RegionOffset();
+        size_t start = (region + head_ + alignment - 1) / alignment * alignment - region;
+        if (start + bytes > frame_bytes_)
+        {
+            ++stats_.failed_allocations;
+            return allocation;
+        }
+
+        head_ = start + bytes;
+        stats_.peak_frame_bytes = std::max(stats_.peak_frame_bytes, head_);
+        allocation.offset = (GLintptr)(region + start);
+        allocation.size = (GLsizeiptr)bytes;
+        allocation.data = mode_ == Mode::Persistent ? mapped_ + region + start : staging_.data() + start;
+        return allocation;
+    }
+
+    RingBuffer::Allocation RingBuffer::Write(const void* data, size_t bytes, size_t alignment)
+    {
+        Allocation allocation = Allocate(bytes, alignment);
+        if (allocation.Valid())
+            std::memcpy(allocation.data, data, bytes);
+        return allocation;
+    }
+
+    void RingBuffer::Flush()
+    {
+        if (mode_ != Mode::Orphaning || head_ == flushed_)
+            return;
+        glBindBuffer(target_, buffer_);
+        glBufferSubData(target_, flushed_, head_ - flushed_, staging_.data() + flushed_);
+        glBindBuffer(target_, 0);
+        flushed_ = head_;
+    }
+
+    void RingBuffer::EndFrame()
+    {
+        if (!in_frame_)
+            return;
+        Flush();
+        if (mode_ == Mode::Persistent)
+            fences_[region_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        in_frame_ = false;
+    }
+
+    void RingBuffer::BindRange(GLenum target, GLuint index, const Allocation& allocation) const
+    {
+        glBindBufferRange(target, index, buffer_, allocation.offset, allocation.size);
+    }
+
+    size_t RingBuffer::UniformAlignment()
+    {
+        GLint alignment = 256;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        return alignment > 0 ? (size_t)alignment : 256;
+    }
+
+    // ===============
+    // PRIVATE
+    // ===============
+    size_t RingBuffer::RegionOffset() const
+    {
+        return mode_ == Mode::Persistent ? region_ * frame_bytes_ : 0;
+    }
+}
@@ -0,0 +1,100 @@
+#ifndef _RING_BUFFER_H
+#define _RING_BUFFER_H
+
+#include <GL/glew.h>
+#include <vector>
+#include <cstddef>
+
+namespace Utility
+{
+    // Per frame stream of dynamic data (transforms, instance attributes, uniform blocks) in one GL
+    // buffer split into kFrames regions. The CPU writes the region of frame N while the GPU still
+    // reads the ones of N-1 and N-2; a fence placed at the end of each frame guards its region
+    // before it is reused, so the driver never has to synchronise implicitly.
+    //
+    // Persistent mode (ARB_buffer_storage): the buffer stays mapped with
+    // GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT and Allocate() points straight into it.
+    // Orphaning mode (older drivers): Allocate() points into a CPU copy of the region and Flush()
+    // uploads it with glBufferSubData after the buffer storage was orphaned at BeginFrame.
+    class RingBuffer
+    {
+    public:
+        static const unsigned int kFrames = 3;
+
+        enum class Mode
+        {
+            Persistent,
+            Orphaning
+        };
+
+        struct Allocation
+        {
+            void* data = nullptr;   // write only
+            GLintptr offset = 0;    // from the start of Buffer(), for attribute pointers and glBindBufferRange
+            GLsizeiptr size = 0;
+
+            bool Valid() const { return data != nullptr; }
+        };
+
+        struct Stats
+        {
+            unsigned long long frames = 0;
+            unsigned long long fence_waits = 0;      // BeginFrame calls that found the GPU still reading the region
+            double wait_milliseconds = 0.0;
+            size_t peak_frame_bytes = 0;
+            unsigned long long failed_allocations = 0;
+        };
+
+        RingBuffer() = default;
+        ~RingBuffer();
+
+        RingBuffer(const RingBuffer&) = delete;
+        RingBuffer& operator=(const RingBuffer&) = delete;
+
+        // frame_bytes is the space available to one frame. force_orphaning picks the fallback path
+        // even where persistent mapping is supported.
+        bool Create(GLenum target, size_t frame_bytes, bool force_orphaning = false);
+        void Release();
+
+        // Waits for the GPU to finish with the next region and rewinds into it
+        void BeginFrame();
+        // Space in the current region; invalid when the frame has run out of space
+        Allocation Allocate(size_t bytes, size_t alignment = 16);
+        // Copies data into a fresh allocation
+        Allocation Write(const void* data, size_t bytes, size_t alignment = 16);
+        // Makes everything written since the last Flush visible to draws (a no-op when persistent)
+        void Flush();
+        // Flushes and fences the region of the frame
+        void EndFrame();
+
+        // glBindBufferRange for uniform / shader storage blocks
+        void BindRange(GLenum target, GLuint index, const Allocation& allocation) const;
+
+        GLuint Buffer() const { return buffer_; }
+        GLenum Target() const { return target_; }
+        Mode GetMode() const { return mode_; }
+        size_t FrameBytes() const { return frame_bytes_; }
+        const Stats& GetStats() const { return stats_; }
+        // GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, the alignment for allocations bound as uniform blocks
+        static size_t UniformAlignment();
+
+    private:
+        size_t RegionOffset() const;
+
+    private:
+        GLuint buffer_ = 0;
+        GLenum target_ = GL_ARRAY_BUFFER;
+        Mode mode_ = Mode::Persistent;
+        size_t frame_bytes_ = 0;
+        unsigned char* mapped_ = nullptr;
+        std::vector<unsigned char> staging_;   // orphaning mode only
+        GLsync fences_[kFrames] = {};
+        unsigned int region_ = 0;
+        size_t head_ = 0;
+        size_t flushed_ = 0;
+        bool in_frame_ = false;
+        Stats stats_;
+    };
+}
+
+#endif // !_RING_BUFFER_H
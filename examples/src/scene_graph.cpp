@@ -0,0 +1,330 @@
+#include "scene_graph.h"
+#include "job_system.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+namespace Utility
+{
+    const SceneGraph::NodeId SceneGraph::kInvalidNode;
+
+    std::ostream& operator<<(std::ostream& os, const SceneUpdateReport& report)
+    {
+        os << report.updated_nodes << " nodes in " << report.subtrees << " subtrees on " << report.threads << " threads, "
+           << report.milliseconds << " ms";
+        return os;
+    }
+
+    SceneGraph::NodeId SceneGraph::Create(NodeId parent, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale)
+    {
+        if (parent != kInvalidNode && !Valid(parent))
+        {
+            std::cerr << "ERROR::SCENE_GRAPH::INVALID_PARENT" << std::endl;
+            return kInvalidNode;
+        }
+
+        NodeId id;
+        if (!free_ids_.empty())
+        {
+            id = free_ids_.back();
+            free_ids_.pop_back();
+        }
+        else
+        {
+            id = (NodeId)index_.size();
+            index_.push_back(kInvalidNode);
+        }
+
+        // The new node goes to the end of its parent's subtree
+        uint32_t parent_index = parent == kInvalidNode ? kInvalidNode : index_[parent];
+        uint32_t at = parent == kInvalidNode ? (uint32_t)ids_.size() : parent_index + subtree_[parent_index];
+        locals_.insert(locals_.begin() + at, { position, rotation, scale });
+        world_.insert(world_.begin() + at, glm::mat4(1.0f));
+        parent_.insert(parent_.begin() + at, parent_index);
+        subtree_.insert(subtree_.begin() + at, 1);
+        dirty_.insert(dirty_.begin() + at, 0);
+        ids_.insert(ids_.begin() + at, id);
+        index_[id] = at;
+
+        GrowAncestors(parent_index, 1);
+        if (at + 1 != ids_.size())
+            RebuildLinks(at);
+        MarkDirty(at);
+        return id;
+    }
+
+    void SceneGraph::Destroy(NodeId node)
+    {
+        if (!Valid(node))
+            return;
+
+        uint32_t begin = index_[node];
+        uint32_t count = subtree_[begin];
+        GrowAncestors(parent_[begin], -(int32_t)count);
+        for (uint32_t i = begin; i < begin + count; ++i)
+        {
+            dirty_count_ -= dirty_[i];
+            index_[ids_[i]] = kInvalidNode;
+            free_ids_.push_back(ids_[i]);
+        }
+
+        locals_.erase(locals_.begin() + begin, locals_.begin() + begin + count);
+        world_.erase(world_.begin() + begin, world_.begin() + begin + count);
+        parent_.erase(parent_.begin() + begin, parent_.begin() + begin + count);
+        subtree_.erase(subtree_.begin() + begin, subtree_.begin() + begin + count);
+        dirty_.erase(dirty_.begin() + begin, dirty_.begin() + begin + count);
+        ids_.erase(ids_.begin() + begin, ids_.begin() + begin + count);
+        if (begin < ids_.size())
+            RebuildLinks(begin);
+    }
+
+    bool SceneGraph::SetParent(NodeId node, NodeId parent)
+    {
+        if (!Valid(node) || (parent != kInvalidNode && !Valid(parent)))
+            return false;
+
+        uint32_t begin = index_[node];
+        uint32_t count = subtree_[begin];
+        uint32_t parent_index = parent == kInvalidNode ? kInvalidNode : index_[parent];
+        if (parent_index != kInvalidNode && parent_index >= begin && parent_index < begin + count)
+        {
+            std::cerr << "ERROR::SCENE_GRAPH::PARENT_INSIDE_SUBTREE" << std::endl;
+            return false;
+        }
+
+        // Sizes are fixed with the current links, then the subtree is rotated to the end of the new
+        // parent's subtree and the links are rebuilt from the sizes
+        uint32_t to = parent_index == kInvalidNode ? (uint32_t)ids_.size() : parent_index + subtree_[parent_index];
+        GrowAncestors(parent_[begin], -(int32_t)count);
+        GrowAncestors(parent_index, (int32_t)count);
+        MoveRange(begin, count, to);
+        uint32_t moved = to > begin ? to - count : to;
+        RebuildLinks(std::min(begin, moved));
+        MarkDirty(moved);
+        return true;
+    }
+
+    void SceneGraph::Clear()
+    {
+        locals_.clear();
+        world_.clear();
+        parent_.clear();
+        subtree_.clear();
+        dirty_.clear();
+        ids_.clear();
+        index_.clear();
+        free_ids_.clear();
+        dirty_count_ = 0;
+    }
+
+    void SceneGraph::Reserve(size_t count)
+    {
+        locals_.reserve(count);
+        world_.reserve(count);
+        parent_.reserve(count);
+        subtree_.reserve(count);
+        dirty_.reserve(count);
+        ids_.reserve(count);
+        index_.reserve(count);
+    }
+
+    SceneGraph::NodeId SceneGraph::Parent(NodeId node) const
+    {
+        uint32_t parent = parent_[index_[node]];
+        return parent == kInvalidNode ? kInvalidNode : ids_[parent];
+    }
+
+    void SceneGraph::SetPosition(NodeId node, const glm::vec3& position)
+    {
+        locals_[index_[node]].position = position;
+        MarkDirty(index_[node]);
+    }
+
+    void SceneGraph::SetRotation(NodeId node, const glm::quat& rotation)
+    {
+        locals_[index_[node]].rotation = rotation;
+        MarkDirty(index_[node]);
+    }
+
+    void SceneGraph::SetScale(NodeId node, const glm::vec3& scale)
+    {
+        locals_[index_[node]].scale = scale;
+        MarkDirty(index_[node]);
+    }
+
+    SceneUpdateReport SceneGraph::Update(const SceneUpdateOptions& options)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        SceneUpdateReport report;
+        if (dirty_count_)
+        {
+            // Top most dirty nodes: their subtrees are recomputed, nothing else is touched
+            ranges_.clear();
+            size_t total = 0;
+            for (uint32_t i = 0; i < ids_.size();)
+            {
+                if (!dirty_[i])
+                {
+                    ++i;
+                    continue;
+                }
+                ranges_.push_back({ i, i + subtree_[i] });
+                total += subtree_[i];
+                i += subtree_[i];
+            }
+
+            unsigned int threads = options.jobs ? options.jobs->ThreadCount()
+                : options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+            threads = (unsigned int)std::max<size_t>(1, std::min<size_t>(threads, total / std::max<size_t>(options.min_nodes_per_thread, 1)));
+
+            if (threads > 1)
+            {
+                // Subtrees larger than a share are broken up at their root: the root is computed here,
+                // its children become independent subtrees
+                size_t grain = std::max<size_t>(total / (threads * 4), 1);
+                std::vector<Range> top;
+                top.swap(ranges_);
+                for (const Range& range : top)
+                    SplitRange(range.begin, range.end, grain, ranges_);
+
+                if (options.jobs)
+                {
+                    // Workers balance the subtrees between themselves by stealing
+                    options.jobs->ParallelFor(ranges_.size(), 0, [this](size_t begin, size_t end) {
+                        for (size_t r = begin; r < end; ++r)
+                            UpdateRange(ranges_[r]);
+                    });
+                }
+                else
+                {
+                    // Contiguous runs of subtrees with about the same node count per thread
+                    size_t remaining = 0;
+                    for (const Range& range : ranges_)
+                        remaining += range.end - range.begin;
+
+                    std::vector<size_t> first(threads + 1, ranges_.size());
+                    first[0] = 0;
+                    size_t assigned = 0, next = 0;
+                    for (unsigned int t = 1; t < threads; ++t)
+                    {
+                        for (; next < ranges_.size() && assigned < remaining * t / threads; ++next)
+                            assigned += ranges_[next].end - ranges_[next].begin;
+                        first[t] = next;
+                    }
+
+                    auto work = [this, &first](unsigned int t) {
+                        for (size_t r = first[t]; r < first[t + 1]; ++r)
+                            UpdateRange(ranges_[r]);
+                    };
+                    std::vector<std::thread> workers;
+                    for (unsigned int t = 1; t < threads; ++t)
+                        workers.emplace_back(work, t);
+                    work(0);
+                    for (std::thread& worker : workers)
+                        worker.join();
+                }
+            }
+            else
+            {
+                for (const Range& range : ranges_)
+                    UpdateRange(range);
+            }
+
+            dirty_count_ = 0;
+            report.updated_nodes = total;
+            report.subtrees = ranges_.size();
+            report.threads = threads;
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        report.milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+        return report;
+    }
+
+    // ===============
+    // PRIVATE
+    // ===============
+    void SceneGraph::MarkDirty(uint32_t index)
+    {
+        if (!dirty_[index])
+        {
+            dirty_[index] = 1;
+            ++dirty_count_;
+        }
+    }
+
+    void SceneGraph::GrowAncestors(uint32_t index, int32_t delta)
+    {
+        for (uint32_t p = index; p != kInvalidNode; p = parent_[p])
+            subtree_[p] += delta;
+    }
+
+    void SceneGraph::MoveRange(uint32_t begin, uint32_t count, uint32_t to)
+    {
+        auto move = [begin, count, to](auto& array) {
+            if (to > begin + count)
+                std::rotate(array.begin() + begin, array.begin() + begin + count, array.begin() + to);
+            else if (to < begin)
+                std::rotate(array.begin() + to, array.begin() + begin, array.begin() + begin + count);
+        };
+        move(locals_);
+        move(world_);
+        move(parent_);
+        move(subtree_);
+        move(dirty_);
+        move(ids_);
+    }
+
+    void SceneGraph::RebuildLinks(uint32_t from)
+    {
+        // Parents follow from the order and the subtree sizes: the parent of a node is the closest
+        // node before it whose subtree still covers it
+        std::vector<uint32_t> open;
+        for (uint32_t i = 0; i < ids_.size(); ++i)
+        {
+            while (!open.empty() && open.back() + subtree_[open.back()] <= i)
+                open.pop_back();
+            if (i >= from)
+            {
+                parent_[i] = open.empty() ? kInvalidNode : open.back();
+                index_[ids_[i]] = i;
+            }
+            if (subtree_[i] > 1)
+                open.push_back(i);
+        }
+    }
+
+    void SceneGraph::SplitRange(uint32_t begin, uint32_t end, size_t grain, std::vector<Range>& ranges)
+    {
+        if (end - begin <= grain || end - begin == 1)
+        {
+            ranges.push_back({ begin, end });
+            return;
+        }
+
+        UpdateNode(begin);
+        for (uint32_t child = begin + 1; child < end; child += subtree_[child])
+            SplitRange(child, child + subtree_[child], grain, ranges);
+    }
+
+    void SceneGraph::UpdateNode(uint32_t index)
+    {
+        const Local& local = locals_[index];
+        glm::mat4 m = glm::mat4_cast(local.rotation);
+        m[0] *= local.scale.x;
+        m[1] *= local.scale.y;
+        m[2] *= local.scale.z;
+        m[3] = glm::vec4(local.position, 1.0f);
+
+        uint32_t parent = parent_[index];
+        world_[index] = parent == kInvalidNode ? m : world_[parent] * m;
+        dirty_[index] = 0;
+    }
+
+    void SceneGraph::UpdateRange(Range range)
+    {
+        for (uint32_t i = range.begin; i < range.end; ++i)
+            UpdateNode(i);
+    }
+}
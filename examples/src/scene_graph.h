@@ -0,0 +1,118 @@
+#ifndef _SCENE_GRAPH_H
+#define _SCENE_GRAPH_H
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <ostream>
+#include <vector>
+#include <cstdint>
+
+namespace Utility
+{
+    class JobSystem;
+
+    struct SceneUpdateOptions
+    {
+        unsigned int threads = 0;             // 0 uses every hardware thread
+        size_t min_nodes_per_thread = 16384;  // smaller updates stay on the calling thread
+        JobSystem* jobs = nullptr;            // runs the subtrees as jobs instead of starting threads
+    };
+
+    struct SceneUpdateReport
+    {
+        size_t updated_nodes = 0;   // world matrices recomputed
+        size_t subtrees = 0;        // independent dirty subtrees the work was split into
+        unsigned int threads = 1;
+        double milliseconds = 0.0;
+    };
+
+    std::ostream& operator<<(std::ostream& os, const SceneUpdateReport& report);
+
+    // Transform hierarchy stored as flat arrays in depth first order: every node is followed by its
+    // whole subtree, so a parent always comes before its children and world matrices are computed in
+    // one linear pass. Setting a local transform only flags the node; Update recomputes the dirty
+    // subtrees and skips everything else, so static nodes cost nothing per frame. Dirty subtrees
+    // never overlap, which lets them (and the children of large ones) update on separate threads.
+    //
+    // Nodes are addressed by stable ids. Creating a child of the most recently built subtree appends
+    // to the arrays; anything else inserts in the middle and shifts the nodes behind it, so
+    // hierarchies are cheapest to build parents first in depth first order.
+    class SceneGraph
+    {
+    public:
+        typedef uint32_t NodeId;
+        static const NodeId kInvalidNode = 0xffffffffu;
+
+        NodeId Create(NodeId parent = kInvalidNode, const glm::vec3& position = glm::vec3(0.0f),
+            const glm::quat& rotation = glm::quat(), const glm::vec3& scale = glm::vec3(1.0f));
+        // Removes the node and its whole subtree
+        void Destroy(NodeId node);
+        // Moves the node's subtree under parent (kInvalidNode makes it a root); fails on cycles
+        bool SetParent(NodeId node, NodeId parent);
+        void Clear();
+        void Reserve(size_t count);
+
+        bool Valid(NodeId node) const { return node < index_.size() && index_[node] != kInvalidNode; }
+        size_t Size() const { return ids_.size(); }
+        NodeId Parent(NodeId node) const;
+        // Node count of the subtree, the node included
+        size_t SubtreeSize(NodeId node) const { return subtree_[index_[node]]; }
+
+        void SetPosition(NodeId node, const glm::vec3& position);
+        void SetRotation(NodeId node, const glm::quat& rotation);
+        void SetScale(NodeId node, const glm::vec3& scale);
+        const glm::vec3& Position(NodeId node) const { return locals_[index_[node]].position; }
+        const glm::quat& Rotation(NodeId node) const { return locals_[index_[node]].rotation; }
+        const glm::vec3& Scale(NodeId node) const { return locals_[index_[node]].scale; }
+
+        // Valid after Update
+        const glm::mat4& World(NodeId node) const { return world_[index_[node]]; }
+        glm::vec3 WorldPosition(NodeId node) const { return glm::vec3(World(node)[3]); }
+        bool Dirty() const { return dirty_count_ != 0; }
+
+        SceneUpdateReport Update(const SceneUpdateOptions& options = SceneUpdateOptions());
+
+        // Depth first order, for systems that walk every node: World matrices by position in the array
+        const std::vector<glm::mat4>& WorldMatrices() const { return world_; }
+        NodeId NodeAt(size_t position) const { return ids_[position]; }
+
+    private:
+        struct Local
+        {
+            glm::vec3 position;
+            glm::quat rotation;
+            glm::vec3 scale;
+        };
+
+        // [begin, end) of the depth first arrays
+        struct Range
+        {
+            uint32_t begin;
+            uint32_t end;
+        };
+
+        void MarkDirty(uint32_t index);
+        void GrowAncestors(uint32_t index, int32_t delta);
+        void MoveRange(uint32_t begin, uint32_t count, uint32_t to);
+        void RebuildLinks(uint32_t from);
+        void SplitRange(uint32_t begin, uint32_t end, size_t grain, std::vector<Range>& ranges);
+        void UpdateNode(uint32_t index);
+        void UpdateRange(Range range);
+
+    private:
+        // Depth first arrays, all of the same size
+        std::vector<Local> locals_;
+        std::vector<glm::mat4> world_;
+        std::vector<uint32_t> parent_;      // array position of the parent, kInvalidNode for roots
+        std::vector<uint32_t> subtree_;
+        std::vector<uint8_t> dirty_;
+        std::vector<NodeId> ids_;
+
+        std::vector<uint32_t> index_;       // NodeId -> array position
+        std::vector<NodeId> free_ids_;
+        size_t dirty_count_ = 0;
+        std::vector<Range> ranges_;         // scratch for Update
+    };
+}
+
+#endif // !_SCENE_GRAPH_H
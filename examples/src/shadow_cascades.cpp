@@ -0,0 +1,231 @@
+#include "shadow_cascades.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace Utility::render
+{
+    using namespace Utility::literals;
+
+    std::ostream& operator<<(std::ostream& os, const ShadowStats& stats)
+    {
+        os << stats.updates << " updates, renders per cascade";
+        for (unsigned int c = 0; c < CascadedShadowOptions::kMaxCascades; ++c)
+            os << (c ? " / " : " ") << stats.renders[c];
+        return os;
+    }
+
+    const unsigned int CascadedShadowOptions::kMaxCascades;
+
+    CascadedShadowMap::CascadedShadowMap(const CascadedShadowOptions& options)
+        : options_(options),
+          depth_shader_("tutorials\\shaders\\shadow_depth_vs.glsl", "tutorials\\shaders\\shadow_depth_fs.glsl")
+    {
+        options_.cascades = std::min(std::max(options_.cascades, 1u), CascadedShadowOptions::kMaxCascades);
+        options_.cached_cascades = std::min(options_.cached_cascades, options_.cascades);
+        for (unsigned int c = 0; c < options_.cascades; ++c)
+            cascades_[c].cached = c >= options_.cascades - options_.cached_cascades;
+    }
+
+    CascadedShadowMap::~CascadedShadowMap()
+    {
+        Release();
+    }
+
+    bool CascadedShadowMap::Create()
+    {
+        Release();
+
+        glGenTextures(1, &texture_);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture_);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT32F, options_.resolution, options_.resolution, options_.cascades, 0,
+            GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+        // Linear filtering of a comparison sampler blends the 2x2 nearest results, which smooths the PCF taps
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+        const float border[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        glTexParameterfv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BORDER_COLOR, border);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+        glGenFramebuffers(1, &framebuffer_);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, texture_, 0, 0);
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+        bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        if (!complete)
+        {
+            std::cerr << "ERROR::SHADOW_CASCADES::FRAMEBUFFER_INCOMPLETE" << std::endl;
+            Release();
+        }
+
+        static_dirty_ = true;
+        return complete;
+    }
+
+    void CascadedShadowMap::Release()
+    {
+        if (framebuffer_)
+            glDeleteFramebuffers(1, &framebuffer_);
+        if (texture_)
+            glDeleteTextures(1, &texture_);
+        framebuffer_ = texture_ = 0;
+    }
+
+    float CascadedShadowMap::SplitDistance(unsigned int cascade, unsigned int cascades, float near_plane, float far_plane, float lambda)
+    {
+        float fraction = (float)cascade / (float)cascades;
+        float logarithmic = near_plane * std::pow(far_plane / near_plane, fraction);
+        float uniform = near_plane + (far_plane - near_plane) * fraction;
+        return lambda * logarithmic + (1.0f - lambda) * uniform;
+    }
+
+    void CascadedShadowMap::Update(const glm::mat4& view_matrix, float fov_y, float aspect, float near_plane, float far_plane,
+        const glm::vec3& light_direction, const glm::vec3& scene_min, const glm::vec3& scene_max)
+    {
+        ++stats_.updates;
+
+        // The light's view is a rotation only, so snapping in light space is snapping in the world
+        glm::vec3 direction = glm::normalize(light_direction);
+        bool light_moved = glm::dot(direction, light_direction_) < 0.999999f;
+        if (light_moved)
+        {
+            light_direction_ = direction;
+            glm::vec3 up = std::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+            light_rotation_ = glm::mat3(glm::lookAt(glm::vec3(0.0f), direction, up));
+        }
+
+        glm::mat4 camera_matrix = glm::inverse(view_matrix);
+        glm::vec3 camera_position = glm::vec3(camera_matrix[3]);
+        glm::vec3 camera_forward = -glm::normalize(glm::vec3(camera_matrix[2]));
+
+        // Squared slope of the frustum's corner edges against the view axis
+        float tan_y = std::tan(fov_y * 0.5f);
+        float corner_slope = tan_y * tan_y * (1.0f + aspect * aspect);
+        float shadow_far = std::min(far_plane, options_.max_distance);
+
+        for (unsigned int c = 0; c < options_.cascades; ++c)
+        {
+            ShadowCascade& cascade = cascades_[c];
+            float split_near = SplitDistance(c, options_.cascades, near_plane, shadow_far, options_.split_lambda);
+            float split_far = SplitDistance(c + 1, options_.cascades, near_plane, shadow_far, options_.split_lambda);
+            cascade.split_near = split_near;
+            cascade.split_far = split_far;
+
+            // Smallest sphere around the slice: on the view axis, as far from the near corners as
+            // from the far ones, unless that is beyond the far plane. It only depends on the
+            // projection, so turning the camera does not resize the cascade.
+            float center_depth = std::min(0.5f * (split_near + split_far) * (1.0f + corner_slope), split_far);
+            float radius = std::sqrt((center_depth - split_near) * (center_depth - split_near) + split_near * split_near * corner_slope);
+            radius = std::max(radius, std::sqrt(split_far * split_far * corner_slope + (split_far - center_depth) * (split_far - center_depth)));
+            radius = std::ceil(radius * 16.0f) / 16.0f;
+            glm::vec3 center = camera_position + camera_forward * center_depth;
+
+            if (!cascade.cached)
+            {
+                Fit(c, center, radius, scene_min, scene_max);
+                cascade.dirty = true;
+            }
+            else
+            {
+                // Keep the cached map while the slice stays inside the sphere it covers
+                bool covered = glm::length(center - centers_[c]) + radius <= cascade.radius;
+                cascade.dirty = light_moved || static_dirty_ || !covered;
+                if (cascade.dirty)
+                    Fit(c, center, std::ceil(radius * (1.0f + options_.cache_margin)), scene_min, scene_max);
+            }
+
+            if (cascade.dirty)
+                ++stats_.renders[c];
+        }
+        static_dirty_ = false;
+    }
+
+    void CascadedShadowMap::BeginCascade(unsigned int cascade)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, texture_, 0, (GLint)cascade);
+        glViewport(0, 0, options_.resolution, options_.resolution);
+        glClear(GL_DEPTH_BUFFER_BIT);
+
+        // Slope scaled offset against acne on surfaces at a grazing angle to the light
+        glEnable(GL_POLYGON_OFFSET_FILL);
+        glPolygonOffset(2.0f, 4.0f);
+
+        depth_shader_.use();
+        depth_shader_.set<"light_view_projection"_id>(cascades_[cascade].view_projection);
+    }
+
+    void CascadedShadowMap::EndCascades(int framebuffer_width, int framebuffer_height)
+    {
+        glDisable(GL_POLYGON_OFFSET_FILL);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(0, 0, framebuffer_width, framebuffer_height);
+    }
+
+    void CascadedShadowMap::Bind(const ShaderProgram& shader, GLuint unit) const
+    {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture_);
+        glActiveTexture(GL_TEXTURE0);
+
+        glm::mat4 matrices[CascadedShadowOptions::kMaxCascades];
+        float splits[CascadedShadowOptions::kMaxCascades];
+        float texel_sizes[CascadedShadowOptions::kMaxCascades];
+        for (unsigned int c = 0; c < options_.cascades; ++c)
+        {
+            matrices[c] = cascades_[c].view_projection;
+            splits[c] = cascades_[c].split_far;
+            texel_sizes[c] = 2.0f * cascades_[c].radius / (float)options_.resolution;
+        }
+
+        GLsizei count = (GLsizei)options_.cascades;
+        shader.set<"shadow_map"_id>((int)unit);
+        shader.set<"cascade_count"_id>((int)count);
+        // Arrays go in one call each from the location of their first element
+        glUniformMatrix4fv(shader.Location("cascade_matrices"), count, GL_FALSE, &matrices[0][0][0]);
+        glUniform1fv(shader.Location("cascade_splits"), count, splits);
+        glUniform1fv(shader.Location("cascade_texel_sizes"), count, texel_sizes);
+    }
+
+    // ===============
+    // PRIVATE
+    // ===============
+    void CascadedShadowMap::Fit(unsigned int c, const glm::vec3& center, float radius, const glm::vec3& scene_min, const glm::vec3& scene_max)
+    {
+        ShadowCascade& cascade = cascades_[c];
+        cascade.radius = radius;
+
+        // Snap the center across the light to whole texels, so the texel grid keeps its place in
+        // the world while the camera moves
+        float texel = 2.0f * radius / (float)options_.resolution;
+        glm::vec3 light_center = light_rotation_ * center;
+        light_center.x = std::floor(light_center.x / texel) * texel;
+        light_center.y = std::floor(light_center.y / texel) * texel;
+        centers_[c] = glm::transpose(light_rotation_) * light_center;
+
+        // Depth range over the whole scene toward the light, so casters outside the slice still cast
+        float min_z = light_center.z - radius;
+        float max_z = light_center.z + radius;
+        for (int corner = 0; corner < 8; ++corner)
+        {
+            glm::vec3 point((corner & 1) ? scene_max.x : scene_min.x, (corner & 2) ? scene_max.y : scene_min.y,
+                (corner & 4) ? scene_max.z : scene_min.z);
+            float z = (light_rotation_ * point).z;
+            min_z = std::min(min_z, z);
+            max_z = std::max(max_z, z);
+        }
+
+        // The light looks down its -z axis
+        glm::mat4 projection = glm::ortho(light_center.x - radius, light_center.x + radius,
+            light_center.y - radius, light_center.y + radius, -max_z, -min_z);
+        cascade.view_projection = projection * glm::mat4(light_rotation_);
+        cascade.frustum = Frustum::FromMatrix(cascade.view_projection);
+    }
+}
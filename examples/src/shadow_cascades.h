@@ -0,0 +1,122 @@
+#ifndef _SHADOW_CASCADES_H
+#define _SHADOW_CASCADES_H
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "ShaderProgram.h"
+#include "frustum.h"
+#include <ostream>
+
+namespace Utility::render
+{
+    struct CascadedShadowOptions
+    {
+        static const unsigned int kMaxCascades = 4;
+
+        unsigned int cascades = 4;          // up to kMaxCascades
+        int resolution = 2048;              // per cascade, square
+        float split_lambda = 0.75f;         // 0 uniform splits, 1 logarithmic
+        float max_distance = 150.0f;        // shadows end here even when the camera sees further
+        unsigned int cached_cascades = 2;   // the farthest ones, re-rendered only when they have to
+        float cache_margin = 0.25f;         // extra radius a cached cascade covers so the camera can move inside it
+    };
+
+    struct ShadowCascade
+    {
+        glm::mat4 view_projection;  // world to the light's clip space, texel snapped
+        Frustum frustum;            // of view_projection, to cull the casters on the CPU
+        float split_near = 0.0f;    // view depth range of the camera this cascade shades
+        float split_far = 0.0f;
+        float radius = 0.0f;        // of the covered sphere, world units
+        bool cached = false;        // holds static casters only and keeps them across frames
+        bool dirty = true;          // has to be drawn this frame
+    };
+
+    struct ShadowStats
+    {
+        unsigned long long updates = 0;                                         // calls of Update
+        unsigned long long renders[CascadedShadowOptions::kMaxCascades] = {};   // times each cascade was dirty
+    };
+
+    std::ostream& operator<<(std::ostream& os, const ShadowStats& stats);
+
+    // Shadow maps for one directional light over the camera frustum cut in depth slices. The split
+    // distances mix logarithmic and uniform splits by split_lambda (the "practical" scheme), so
+    // near cascades stay sharp without the far ones getting too thin. Each slice is covered by an
+    // orthographic projection around its bounding sphere, whose size does not change as the camera
+    // turns, and its center is snapped to whole shadow texels, so shadow edges stay put while the
+    // camera moves instead of shimmering.
+    //
+    // The last cached_cascades cascades cover a sphere cache_margin larger than needed, and are
+    // only drawn again when the light turns, InvalidateStatic() is called, or the slice leaves the
+    // covered sphere. They hold the static casters alone; moving objects only cast into the near
+    // cascades, which are drawn every frame.
+    //
+    //     shadows.Update(view, fov, aspect, near, far, light_direction, scene_min, scene_max);
+    //     for (unsigned int c = 0; c < shadows.Count(); ++c)
+    //         if (shadows.Cascade(c).dirty)
+    //         {
+    //             shadows.BeginCascade(c);  ... draw casters surviving Cascade(c).frustum ...
+    //         }
+    //     shadows.EndCascades(width, height);
+    //     shadows.Bind(shader, unit);
+    class CascadedShadowMap
+    {
+    public:
+        explicit CascadedShadowMap(const CascadedShadowOptions& options = CascadedShadowOptions());
+        ~CascadedShadowMap();
+
+        CascadedShadowMap(const CascadedShadowMap&) = delete;
+        CascadedShadowMap& operator=(const CascadedShadowMap&) = delete;
+
+        bool Create();
+        void Release();
+
+        // Fits the cascades to the camera and marks the ones to draw. The scene bounds set the depth
+        // range of the light's projections, so casters outside the camera frustum still cast.
+        void Update(const glm::mat4& view_matrix, float fov_y, float aspect, float near_plane, float far_plane,
+            const glm::vec3& light_direction, const glm::vec3& scene_min, const glm::vec3& scene_max);
+
+        // Static geometry moved: every cached cascade is drawn again at the next Update
+        void InvalidateStatic() { static_dirty_ = true; }
+
+        // Binds the cascade's layer, clears it and leaves the depth program in use; the caller sets
+        // "model_matrix" on DepthShader() per caster and draws
+        void BeginCascade(unsigned int cascade);
+        // Restores the default framebuffer, viewport and rasterizer state
+        void EndCascades(int framebuffer_width, int framebuffer_height);
+
+        // Binds the shadow map to the texture unit and sets the receiver uniforms of the program in
+        // use: shadow_map, cascade_count, cascade_splits[] (far view depth of each), cascade_matrices[]
+        // and cascade_texel_sizes[] (world size of a shadow texel, for the normal offset)
+        void Bind(const ShaderProgram& shader, GLuint unit) const;
+
+        ShaderProgram& DepthShader() { return depth_shader_; }
+        unsigned int Count() const { return options_.cascades; }
+        const ShadowCascade& Cascade(unsigned int cascade) const { return cascades_[cascade]; }
+        const CascadedShadowOptions& Options() const { return options_; }
+        const ShadowStats& Stats() const { return stats_; }
+        GLuint Texture() const { return texture_; }
+
+        // View depth at which the cascade starts, 0 <= cascade <= cascades
+        static float SplitDistance(unsigned int cascade, unsigned int cascades, float near_plane, float far_plane, float lambda);
+
+    private:
+        void Fit(unsigned int cascade, const glm::vec3& center, float radius, const glm::vec3& scene_min, const glm::vec3& scene_max);
+
+    private:
+        CascadedShadowOptions options_;
+        ShaderProgram depth_shader_;
+        ShadowCascade cascades_[CascadedShadowOptions::kMaxCascades];
+        glm::vec3 centers_[CascadedShadowOptions::kMaxCascades];     // of the covered spheres, world space
+        glm::mat3 light_rotation_ = glm::mat3(1.0f);                // world to light space
+        glm::vec3 light_direction_ = glm::vec3(0.0f);
+        bool static_dirty_ = true;
+        ShadowStats stats_;
+
+        GLuint texture_ = 0;                // DEPTH_COMPONENT32F array, a layer per cascade
+        GLuint framebuffer_ = 0;
+    };
+}
+
+#endif // !_SHADOW_CASCADES_H
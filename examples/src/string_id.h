@@ -0,0 +1,51 @@
+#ifndef _STRING_ID_H
+#define _STRING_ID_H
+
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+namespace Utility
+{
+    // 32-bit FNV-1a, usable in constant expressions
+    constexpr uint32_t fnv1a(std::string_view text)
+    {
+        uint32_t hash = 2166136261u;
+        for (char c : text)
+        {
+            hash ^= (uint8_t)c;
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    // Hashed name (uniforms, attributes, any identifier looked up every frame). Built from a literal
+    // it is hashed by the compiler; the conversion to uint32_t lets it key templates and switches.
+    struct StringId
+    {
+        uint32_t hash = 0;
+
+        constexpr StringId() = default;
+        constexpr explicit StringId(std::string_view name) : hash(fnv1a(name)) {}
+
+        constexpr operator uint32_t() const { return hash; }
+
+        static constexpr StringId FromHash(uint32_t hash)
+        {
+            StringId id;
+            id.hash = hash;
+            return id;
+        }
+    };
+
+    namespace literals
+    {
+        // "light_source.position"_id
+        constexpr StringId operator""_id(const char* name, size_t length)
+        {
+            return StringId(std::string_view(name, length));
+        }
+    }
+}
+
+#endif // !_STRING_ID_H
@@ -0,0 +1,264 @@
+#include "texture_residency.h"
+#include <GL/glew.h> // Include this first
+#include "texture_utils.h"
+#include <iostream>
+#include <vector>
+
+#include "stb_image.h"
+
+namespace Utility::texture
+{
+    ResidencyManager::ResidencyManager(size_t budget_bytes, int max_dropped_levels) :
+        budget_(budget_bytes), max_dropped_levels_(max_dropped_levels)
+    {
+    }
+
+    ResidencyManager::~ResidencyManager()
+    {
+        for (auto& item : entries_)
+            glDeleteTextures(1, &item.first);
+    }
+
+    unsigned int ResidencyManager::Load(const std::string& texture_path)
+    {
+        auto found = by_path_.find(texture_path);
+        if (found != by_path_.end())
+        {
+            Use(found->second);
+            return found->second;
+        }
+
+        GLuint texture_obj;
+        glGenTextures(1, &texture_obj);
+        glBindTexture(GL_TEXTURE_2D, texture_obj);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        Entry& entry = entries_[texture_obj];
+        entry.path = texture_path;
+        entry.last_used_frame = frame_;
+        lru_.push_front(texture_obj);
+        entry.lru_position = lru_.begin();
+        by_path_[texture_path] = texture_obj;
+
+        if (!Stream(texture_obj, entry))
+            Evict(texture_obj, entry);
+
+        // Make room right away so that loading a large set up front does not overshoot the budget;
+        // when the textures loaded this frame alone exceed it they are trimmed too
+        Enforce();
+        return texture_obj;
+    }
+
+    void ResidencyManager::Use(unsigned int texture)
+    {
+        auto found = entries_.find(texture);
+        if (found == entries_.end())
+            return;
+
+        Entry& entry = found->second;
+        entry.last_used_frame = frame_;
+        lru_.splice(lru_.begin(), lru_, entry.lru_position);
+
+        // Trimmed textures still draw; EndFrame gives them their top mips back once they fit
+        if (entry.evicted)
+        {
+            if (Stream(texture, entry))
+                ++total_restreams_;
+        }
+    }
+
+    void ResidencyManager::EndFrame()
+    {
+        Restore();
+        Enforce();
+        ++frame_;
+    }
+
+    void ResidencyManager::SetBudget(size_t budget_bytes)
+    {
+        budget_ = budget_bytes;
+        Enforce();
+    }
+
+    size_t ResidencyManager::Budget() const
+    {
+        return budget_;
+    }
+
+    size_t ResidencyManager::ResidentBytes() const
+    {
+        return resident_;
+    }
+
+    unsigned long long ResidencyManager::Frame() const
+    {
+        return frame_;
+    }
+
+    ResidencyStats ResidencyManager::Stats() const
+    {
+        ResidencyStats stats;
+        stats.budget_bytes = budget_;
+        stats.resident_bytes = resident_;
+        stats.texture_count = entries_.size();
+        stats.total_evictions = total_evictions_;
+        stats.total_restreams = total_restreams_;
+        for (const auto& item : entries_)
+        {
+            if (item.second.evicted)
+                ++stats.evicted_count;
+            else if (item.second.dropped_levels > 0)
+                ++stats.trimmed_count;
+        }
+        return stats;
+    }
+
+    // ===============
+    // PRIVATE
+    // ===============
+    int ResidencyManager::BytesPerTexel(int channels)
+    {
+        // Drivers pad 3 component textures to 4 bytes per texel
+        return channels == 3 ? 4 : channels;
+    }
+
+    bool ResidencyManager::Stream(unsigned int texture, Entry& entry)
+    {
+        int width = 0, height = 0, channels = 0;
+        if (!stbi_info(entry.path.c_str(), &width, &height, &channels))
+        {
+            std::cerr << "Failed to load texture image: " << entry.path << std::endl;
+            return false;
+        }
+
+        GLenum format = pixel_format(entry.path, channels);
+        int components = format == GL_RGBA ? 4 : (format == GL_RED ? 1 : 3);
+
+        unsigned char* data = stbi_load(entry.path.c_str(), &width, &height, &channels, components);
+        if (!data)
+        {
+            std::cerr << "Failed to load texture image: " << entry.path << std::endl;
+            return false;
+        }
+
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mip_level_count(width, height) - 1);
+        glGenerateMipmap(GL_TEXTURE_2D);
+
+        stbi_image_free(data);
+
+        resident_ -= entry.bytes;
+        entry.width = width;
+        entry.height = height;
+        entry.channels = components;
+        entry.dropped_levels = 0;
+        entry.evicted = false;
+        entry.bytes = mip_chain_size(width, height, BytesPerTexel(components));
+        resident_ += entry.bytes;
+        return true;
+    }
+
+    void ResidencyManager::Evict(unsigned int texture, Entry& entry)
+    {
+        // Keep the texture name alive and shrink its storage to a single grey texel
+        const unsigned char placeholder[4] = { 128, 128, 128, 255 };
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholder);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+        resident_ -= entry.bytes;
+        entry.bytes = 4;
+        resident_ += entry.bytes;
+        entry.evicted = true;
+        ++total_evictions_;
+    }
+
+    bool ResidencyManager::DropLevel(unsigned int texture, Entry& entry)
+    {
+        int resident_width = entry.width >> entry.dropped_levels;
+        int resident_height = entry.height >> entry.dropped_levels;
+        if (entry.evicted || entry.dropped_levels >= max_dropped_levels_ || (resident_width <= 1 && resident_height <= 1))
+            return false;
+
+        // Read back the second level and make it the new top of the chain
+        int w = resident_width > 1 ? resident_width / 2 : 1;
+        int h = resident_height > 1 ? resident_height / 2 : 1;
+        GLenum format = entry.channels == 4 ? GL_RGBA : (entry.channels == 1 ? GL_RED : GL_RGB);
+        std::vector<unsigned char> level((size_t)w * h * entry.channels);
+
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glGetTexImage(GL_TEXTURE_2D, 1, format, GL_UNSIGNED_BYTE, level.data());
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, format, w, h, 0, format, GL_UNSIGNED_BYTE, level.data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mip_level_count(w, h) - 1);
+        glGenerateMipmap(GL_TEXTURE_2D);
+
+        resident_ -= entry.bytes;
+        entry.bytes = mip_chain_size(w, h, BytesPerTexel(entry.channels));
+        resident_ += entry.bytes;
+        ++entry.dropped_levels;
+        return true;
+    }
+
+    size_t ResidencyManager::FullBytes(const Entry& entry)
+    {
+        return mip_chain_size(entry.width, entry.height, BytesPerTexel(entry.channels));
+    }
+
+    void ResidencyManager::Restore()
+    {
+        // What the textures this frame did not use would give back, evicted down to their texel
+        size_t reclaimable = 0;
+        for (auto it = lru_.rbegin(); it != lru_.rend() && entries_[*it].last_used_frame < frame_; ++it)
+            reclaimable += entries_[*it].bytes - 4;
+
+        // A trimmed texture of this frame is streamed again only when the frame's textures fit with
+        // its full chain, so Enforce does not trim it right back and every frame read it from disk
+        for (unsigned int texture : lru_)
+        {
+            Entry& entry = entries_[texture];
+            if (entry.last_used_frame < frame_)
+                break;
+            if (entry.evicted || entry.dropped_levels == 0)
+                continue;
+            if (resident_ - reclaimable - entry.bytes + FullBytes(entry) > budget_)
+                continue;
+            if (Stream(texture, entry))
+                ++total_restreams_;
+        }
+    }
+
+    void ResidencyManager::Enforce()
+    {
+        // Textures the current frame has not used go first, least recently used first: their top
+        // mips, then the whole texture. Everything in front of the first one used this frame has
+        // been used in it as well.
+        auto it = lru_.rbegin();
+        while (resident_ > budget_ && it != lru_.rend() && entries_[*it].last_used_frame < frame_)
+        {
+            Entry& entry = entries_[*it];
+            if (DropLevel(*it, entry))
+                continue;
+            if (!entry.evicted)
+                Evict(*it, entry);
+            ++it;
+        }
+
+        // Still over: the frame's own textures lose top mips as well, but stay drawable
+        for (; resident_ > budget_ && it != lru_.rend(); ++it)
+        {
+            Entry& entry = entries_[*it];
+            while (resident_ > budget_ && DropLevel(*it, entry))
+                ;
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef _TEXTURE_RESIDENCY_H
+#define _TEXTURE_RESIDENCY_H
+
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <cstddef>
+
+namespace Utility::texture
+{
+    struct ResidencyStats
+    {
+        size_t budget_bytes = 0;
+        size_t resident_bytes = 0;
+        size_t texture_count = 0;
+        size_t trimmed_count = 0;   // textures currently missing one or more top mips
+        size_t evicted_count = 0;   // textures currently backed by a 1x1 placeholder
+        size_t total_evictions = 0;
+        size_t total_restreams = 0;
+    };
+
+    // Keeps the textures it loads inside a fixed memory budget.
+    // Every texture is tracked with its full mip chain size and ordered by the frame it was last used in.
+    // When the resident set goes over budget the least recently used textures first lose their top mips
+    // and are then evicted entirely. Textures used in the current frame are never evicted; when they
+    // alone exceed the budget they lose up to max_dropped_levels top mips, and whatever is left over
+    // that stays resident above the budget. The GL texture name never changes so it can be bound as
+    // usual; evicted textures are streamed back from disk on their next Use(), trimmed ones at the
+    // end of a frame that used them, once the frame's textures fit in the budget at full quality.
+    // Streaming reads and decodes the image file on the calling thread, so the frame that brings a
+    // texture back stalls for the disk read.
+    class ResidencyManager
+    {
+    public:
+        explicit ResidencyManager(size_t budget_bytes, int max_dropped_levels = 2);
+        ~ResidencyManager();
+
+        ResidencyManager(const ResidencyManager&) = delete;
+        ResidencyManager& operator=(const ResidencyManager&) = delete;
+
+        // Loads the image at the given path and returns its texture object.
+        // Loading the same path twice returns the same texture object.
+        unsigned int Load(const std::string& texture_path);
+
+        // Marks the texture as used by the current frame. Re-streams it if it was evicted.
+        void Use(unsigned int texture);
+
+        // Restores the trimmed textures of the frame that fit, trims the resident set back into the
+        // budget and advances the frame counter.
+        // Call it once per frame after all draws have been submitted.
+        void EndFrame();
+
+        void SetBudget(size_t budget_bytes);
+        size_t Budget() const;
+        size_t ResidentBytes() const;
+        unsigned long long Frame() const;
+        ResidencyStats Stats() const;
+
+    private:
+        struct Entry
+        {
+            std::string path;
+            int width = 0;
+            int height = 0;
+            int channels = 0;
+            int dropped_levels = 0;
+            bool evicted = false;
+            size_t bytes = 0;
+            unsigned long long last_used_frame = 0;
+            std::list<unsigned int>::iterator lru_position;
+        };
+
+        // Loads the full image from disk; levels are only dropped by Enforce, from the GL copy
+        bool Stream(unsigned int texture, Entry& entry);
+        void Evict(unsigned int texture, Entry& entry);
+        // Makes the second level the top of the chain; false when no more levels may be dropped
+        bool DropLevel(unsigned int texture, Entry& entry);
+        static size_t FullBytes(const Entry& entry);
+        void Restore();
+        void Enforce();
+        static int BytesPerTexel(int channels);
+
+    private:
+        size_t budget_ = 0;
+        size_t resident_ = 0;
+        int max_dropped_levels_ = 2;
+        unsigned long long frame_ = 0;
+        size_t total_evictions_ = 0;
+        size_t total_restreams_ = 0;
+
+        std::unordered_map<unsigned int, Entry> entries_;
+        std::unordered_map<std::string, unsigned int> by_path_;
+        // Most recently used texture at the front
+        std::list<unsigned int> lru_;
+    };
+}
+
+#endif // !_TEXTURE_RESIDENCY_H
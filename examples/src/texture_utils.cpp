@@ -1,6 +1,7 @@
 #include "texture_utils.h"
 #include <GL/glew.h> // Include this first
 #include <iostream>
+#include "job_system.h"
 
 //#ifndef STB_IMAGE_IMPLEMENTATION
 //#define STB_IMAGE_IMPLEMENTATION
@@ -11,48 +12,87 @@
 
 namespace Utility::texture
 {
-    unsigned int load(std::string texture_path)
+    unsigned int pixel_format(const std::string& texture_path, int channels)
     {
-        // 1. Load the corresponding image
-        int width, height, nrChannels;
-        unsigned char* data = stbi_load(texture_path.c_str(), &width, &height, &nrChannels, 0);
-        if (!data)
-            std::cerr << "Failed to load texture image!!!" << std::endl;
-
         bool is_png = texture_path.find(".png") != std::string::npos;
 
         GLenum format = GL_RGB;
-        if (nrChannels == 1)
+        if (channels == 1)
             format = GL_RED;
-        else if (nrChannels == 3)
+        else if (channels == 3)
             format = GL_RGB;
-        else if (nrChannels == 4 || is_png)
+        else if (channels == 4 || is_png)
             format = GL_RGBA;
 
-        // 2. Generate the texture object like any other OpenGL object
-        GLuint texture_obj;
-        glGenTextures(1, &texture_obj);
+        return format;
+    }
+
+    int mip_level_count(int width, int height)
+    {
+        int levels = 1;
+        int size = width > height ? width : height;
+        while (size > 1)
+        {
+            size /= 2;
+            ++levels;
+        }
+        return levels;
+    }
+
+    size_t mip_chain_size(int width, int height, int bytes_per_texel)
+    {
+        size_t total = 0;
+        for (int level = 0; level < mip_level_count(width, height); ++level)
+        {
+            int w = width >> level;
+            int h = height >> level;
+            total += (size_t)(w > 0 ? w : 1) * (size_t)(h > 0 ? h : 1) * bytes_per_texel;
+        }
+        return total;
+    }
+
+    namespace
+    {
+        GLuint create_texture(const unsigned char* data, int width, int height, GLenum format)
+        {
+            // 2. Generate the texture object like any other OpenGL object
+            GLuint texture_obj;
+            glGenTextures(1, &texture_obj);
+
+            // 3. Bind it to a specific target. It is GL_TEXTURE_2D here.
+            // RULE: texture_obj should and can NOT be bound to any other target after this point
+            glBindTexture(GL_TEXTURE_2D, texture_obj);
+            // all upcoming GL_TEXTURE_2D operations now have effect on this texture object
+
+            // 4. Set the sampling parameters
+            // Wrapping (edge value sampling)
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+            // Filtering
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-        // 3. Bind it to a specific target. It is GL_TEXTURE_2D here.
-        // RULE: texture_obj should and can NOT be bound to any other target after this point
-        glBindTexture(GL_TEXTURE_2D, texture_obj);
-        // all upcoming GL_TEXTURE_2D operations now have effect on this texture object
+            // 5. Get the storage for the texture
+            // Mutable storage in this case
+            glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
 
-        // 4. Set the sampling parameters
-        // Wrapping (edge value sampling)
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        // Filtering
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            // 6. Storage contents can now be altered after this point.
+            // It is often a good practice to generate a mipmap
+            glGenerateMipmap(GL_TEXTURE_2D);
+
+            return texture_obj;
+        }
+    }
 
-        // 5. Get the storage for the texture
-        // Mutable storage in this case
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+    unsigned int load(std::string texture_path)
+    {
+        // 1. Load the corresponding image
+        int width, height, nrChannels;
+        unsigned char* data = stbi_load(texture_path.c_str(), &width, &height, &nrChannels, 0);
+        if (!data)
+            std::cerr << "Failed to load texture image!!!" << std::endl;
 
-        // 6. Storage contents can now be altered after this point.
-        // It is often a good practice to generate a mipmap
-        glGenerateMipmap(GL_TEXTURE_2D);
+        GLuint texture_obj = create_texture(data, width, height, pixel_format(texture_path, nrChannels));
 
         // 7. You can now free the loaded image data.
         stbi_image_free(data);
@@ -60,4 +100,35 @@ namespace Utility::texture
         return texture_obj;
     }
 
+    std::vector<unsigned int> load(const std::vector<std::string>& texture_paths, JobSystem& jobs)
+    {
+        struct Image
+        {
+            unsigned char* data = nullptr;
+            int width = 0;
+            int height = 0;
+            int channels = 0;
+        };
+
+        // Decoding is most of the cost and needs no context, so it fans out over the workers
+        std::vector<Image> images(texture_paths.size());
+        jobs.ParallelFor(texture_paths.size(), 1, [&texture_paths, &images](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+                images[i].data = stbi_load(texture_paths[i].c_str(), &images[i].width, &images[i].height, &images[i].channels, 0);
+        });
+
+        std::vector<unsigned int> textures(texture_paths.size(), 0);
+        for (size_t i = 0; i < images.size(); ++i)
+        {
+            if (!images[i].data)
+            {
+                std::cerr << "Failed to load texture image!!! " << texture_paths[i] << std::endl;
+                continue;
+            }
+            textures[i] = create_texture(images[i].data, images[i].width, images[i].height, pixel_format(texture_paths[i], images[i].channels));
+            stbi_image_free(images[i].data);
+        }
+        return textures;
+    }
+
 }
\ No newline at end of file
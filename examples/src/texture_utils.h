@@ -2,11 +2,26 @@
 #define _TEXTURE_UTILS_H
 
 #include <string>
+#include <vector>
+#include <cstddef>
 namespace Utility
 {
+	class JobSystem;
+
 	namespace texture
 	{
 		unsigned int load(std::string texture_path);
+		// Decodes the images in parallel on the job system, then creates the textures on the calling thread (the one owning the context); 0 for files that failed
+		std::vector<unsigned int> load(const std::vector<std::string>& texture_paths, JobSystem& jobs);
+
+		// GL pixel format (GL_RED, GL_RGB or GL_RGBA) matching the decoded image
+		unsigned int pixel_format(const std::string& texture_path, int channels);
+
+		// Number of levels in a full mip chain for the given base size
+		int mip_level_count(int width, int height);
+
+		// Bytes occupied by a texture including its full mip chain
+		size_t mip_chain_size(int width, int height, int bytes_per_texel);
 	}
 }
 #endif // !_TEXTURE_UTILS_H
@@ -0,0 +1,332 @@
+#include "transform_soa.h"
+#include <algorithm>
+#include <initializer_list>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define TRANSFORM_SOA_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define TRANSFORM_SOA_AVX_TARGET
+#else
+#include <cpuid.h>
+#define TRANSFORM_SOA_AVX_TARGET __attribute__((target("avx")))
+#endif
+#endif
+
+namespace Utility
+{
+    namespace
+    {
+        const size_t kLanes = 8;
+
+        size_t pad(size_t count)
+        {
+            return (count + kLanes - 1) / kLanes * kLanes;
+        }
+
+        // One matrix, same math as the SIMD paths
+        void compose_scalar(const TransformSoA& t, size_t i, float* m)
+        {
+            float x = t.qx[i], y = t.qy[i], z = t.qz[i], w = t.qw[i];
+            float xx = x * x, yy = y * y, zz = z * z;
+            float xy = x * y, xz = x * z, yz = y * z;
+            float wx = w * x, wy = w * y, wz = w * z;
+
+            m[0] = (1.0f - 2.0f * (yy + zz)) * t.sx[i];
+            m[1] = 2.0f * (xy + wz) * t.sx[i];
+            m[2] = 2.0f * (xz - wy) * t.sx[i];
+            m[3] = 0.0f;
+            m[4] = 2.0f * (xy - wz) * t.sy[i];
+            m[5] = (1.0f - 2.0f * (xx + zz)) * t.sy[i];
+            m[6] = 2.0f * (yz + wx) * t.sy[i];
+            m[7] = 0.0f;
+            m[8] = 2.0f * (xz + wy) * t.sz[i];
+            m[9] = 2.0f * (yz - wx) * t.sz[i];
+            m[10] = (1.0f - 2.0f * (xx + yy)) * t.sz[i];
+            m[11] = 0.0f;
+            m[12] = t.px[i];
+            m[13] = t.py[i];
+            m[14] = t.pz[i];
+            m[15] = 1.0f;
+        }
+
+#if TRANSFORM_SOA_X86
+        // 4 objects per step: 16 registers hold one matrix element each for 4 objects,
+        // four 4x4 transposes turn them into 4 consecutive matrices
+        void compose_sse(const TransformSoA& t, size_t first, size_t count, float* out, bool stream)
+        {
+            const __m128 one = _mm_set1_ps(1.0f), two = _mm_set1_ps(2.0f), zero = _mm_setzero_ps();
+            size_t i = first, end = first + count;
+            for (; i + 4 <= end; i += 4, out += 64)
+            {
+                __m128 x = _mm_loadu_ps(&t.qx[i]), y = _mm_loadu_ps(&t.qy[i]), z = _mm_loadu_ps(&t.qz[i]), w = _mm_loadu_ps(&t.qw[i]);
+                __m128 sx = _mm_loadu_ps(&t.sx[i]), sy = _mm_loadu_ps(&t.sy[i]), sz = _mm_loadu_ps(&t.sz[i]);
+                __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+                __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+                __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+                __m128 c0[4] = {
+                    _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx),
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx),
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx),
+                    zero };
+                __m128 c1[4] = {
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy),
+                    _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy),
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy),
+                    zero };
+                __m128 c2[4] = {
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz),
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz),
+                    _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz),
+                    zero };
+                __m128 c3[4] = { _mm_loadu_ps(&t.px[i]), _mm_loadu_ps(&t.py[i]), _mm_loadu_ps(&t.pz[i]), one };
+
+                _MM_TRANSPOSE4_PS(c0[0], c0[1], c0[2], c0[3]);
+                _MM_TRANSPOSE4_PS(c1[0], c1[1], c1[2], c1[3]);
+                _MM_TRANSPOSE4_PS(c2[0], c2[1], c2[2], c2[3]);
+                _MM_TRANSPOSE4_PS(c3[0], c3[1], c3[2], c3[3]);
+
+                // After the transposes cN[k] is column N of object k
+                for (int k = 0; k < 4; ++k)
+                {
+                    float* m = out + k * 16;
+                    if (stream)
+                    {
+                        _mm_stream_ps(m, c0[k]);
+                        _mm_stream_ps(m + 4, c1[k]);
+                        _mm_stream_ps(m + 8, c2[k]);
+                        _mm_stream_ps(m + 12, c3[k]);
+                    }
+                    else
+                    {
+                        _mm_storeu_ps(m, c0[k]);
+                        _mm_storeu_ps(m + 4, c1[k]);
+                        _mm_storeu_ps(m + 8, c2[k]);
+                        _mm_storeu_ps(m + 12, c3[k]);
+                    }
+                }
+            }
+            for (; i < end; ++i, out += 16)
+                compose_scalar(t, i, out);
+            if (stream)
+                _mm_sfence();
+        }
+
+        // 8x8 transpose: row r of the input holds element r of 8 objects, row k of the output
+        // holds the 8 elements of object k
+        TRANSFORM_SOA_AVX_TARGET void transpose8(__m256 r[8])
+        {
+            __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]), t1 = _mm256_unpackhi_ps(r[0], r[1]);
+            __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]), t3 = _mm256_unpackhi_ps(r[2], r[3]);
+            __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]), t5 = _mm256_unpackhi_ps(r[4], r[5]);
+            __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]), t7 = _mm256_unpackhi_ps(r[6], r[7]);
+            __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)), s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+            __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)), s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+            __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0)), s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+            __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0)), s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+            r[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+            r[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+            r[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+            r[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+            r[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+            r[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+            r[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+            r[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+        }
+
+        // 8 objects per step: the first and last 8 elements of the 8 matrices are two 8x8 transposes
+        TRANSFORM_SOA_AVX_TARGET void compose_avx(const TransformSoA& t, size_t first, size_t count, float* out, bool stream)
+        {
+            const __m256 one = _mm256_set1_ps(1.0f), two = _mm256_set1_ps(2.0f), zero = _mm256_setzero_ps();
+            size_t i = first, end = first + count;
+            for (; i + 8 <= end; i += 8, out += 128)
+            {
+                __m256 x = _mm256_loadu_ps(&t.qx[i]), y = _mm256_loadu_ps(&t.qy[i]), z = _mm256_loadu_ps(&t.qz[i]), w = _mm256_loadu_ps(&t.qw[i]);
+                __m256 sx = _mm256_loadu_ps(&t.sx[i]), sy = _mm256_loadu_ps(&t.sy[i]), sz = _mm256_loadu_ps(&t.sz[i]);
+                __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+                __m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+                __m256 wx = _mm256_mul_ps(w, x), wy = _mm256_mul_ps(w, y), wz = _mm256_mul_ps(w, z);
+
+                // columns 0 and 1
+                __m256 low[8] = {
+                    _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz))), sx),
+                    _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xy, wz)), sx),
+                    _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xz, wy)), sx),
+                    zero,
+                    _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xy, wz)), sy),
+                    _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz))), sy),
+                    _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(yz, wx)), sy),
+                    zero };
+                // columns 2 and 3
+                __m256 high[8] = {
+                    _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xz, wy)), sz),
+                    _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(yz, wx)), sz),
+                    _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy))), sz),
+                    zero,
+                    _mm256_loadu_ps(&t.px[i]),
+                    _mm256_loadu_ps(&t.py[i]),
+                    _mm256_loadu_ps(&t.pz[i]),
+                    one };
+
+                transpose8(low);
+                transpose8(high);
+                for (int k = 0; k < 8; ++k)
+                {
+                    float* m = out + k * 16;
+                    if (stream)
+                    {
+                        _mm256_stream_ps(m, low[k]);
+                        _mm256_stream_ps(m + 8, high[k]);
+                    }
+                    else
+                    {
+                        _mm256_storeu_ps(m, low[k]);
+                        _mm256_storeu_ps(m + 8, high[k]);
+                    }
+                }
+            }
+            if (stream)
+                _mm_sfence();
+            for (; i < end; ++i, out += 16)
+                compose_scalar(t, i, out);
+        }
+
+        bool cpu_has_avx()
+        {
+            // CPU support (CPUID.1:ECX.AVX) and the OS saving the YMM registers (OSXSAVE + XCR0)
+#if defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 1);
+            bool avx = (info[2] & (1 << 28)) != 0, osxsave = (info[2] & (1 << 27)) != 0;
+            return avx && osxsave && (_xgetbv(0) & 6) == 6;
+#else
+            unsigned int eax, ebx, ecx, edx;
+            if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+                return false;
+            bool avx = (ecx & (1u << 28)) != 0, osxsave = (ecx & (1u << 27)) != 0;
+            if (!avx || !osxsave)
+                return false;
+            unsigned int xcr0_low, xcr0_high;
+            __asm__("xgetbv" : "=a"(xcr0_low), "=d"(xcr0_high) : "c"(0));
+            return (xcr0_low & 6) == 6;
+#endif
+        }
+#endif
+    }
+
+    const char* to_string(SimdPath path)
+    {
+        switch (path)
+        {
+        case SimdPath::SSE:
+            return "SSE";
+        case SimdPath::AVX:
+            return "AVX";
+        default:
+            return "scalar";
+        }
+    }
+
+    SimdPath best_simd_path()
+    {
+#if TRANSFORM_SOA_X86
+        static const SimdPath path = cpu_has_avx() ? SimdPath::AVX : SimdPath::SSE;
+        return path;
+#else
+        return SimdPath::Scalar;
+#endif
+    }
+
+    size_t TransformSoA::Add(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale)
+    {
+        size_t index = size_++;
+        if (size_ > px.size())
+            Resize(pad(size_));
+        SetPosition(index, position);
+        SetRotation(index, rotation);
+        SetScale(index, scale);
+        return index;
+    }
+
+    void TransformSoA::Clear()
+    {
+        size_ = 0;
+        Resize(0);
+    }
+
+    void TransformSoA::Reserve(size_t count)
+    {
+        for (Array* array : { &px, &py, &pz, &qx, &qy, &qz, &qw, &sx, &sy, &sz })
+            array->reserve(pad(count));
+    }
+
+    void TransformSoA::SetPosition(size_t index, const glm::vec3& position)
+    {
+        px[index] = position.x;
+        py[index] = position.y;
+        pz[index] = position.z;
+    }
+
+    void TransformSoA::SetRotation(size_t index, const glm::quat& rotation)
+    {
+        qx[index] = rotation.x;
+        qy[index] = rotation.y;
+        qz[index] = rotation.z;
+        qw[index] = rotation.w;
+    }
+
+    void TransformSoA::SetScale(size_t index, const glm::vec3& scale)
+    {
+        sx[index] = scale.x;
+        sy[index] = scale.y;
+        sz[index] = scale.z;
+    }
+
+    glm::vec3 TransformSoA::Position(size_t index) const
+    {
+        return glm::vec3(px[index], py[index], pz[index]);
+    }
+
+    void TransformSoA::ComposeMatrices(void* destination, size_t first, size_t count, SimdPath path) const
+    {
+        if (first >= size_)
+            return;
+        count = std::min(count, size_ - first);
+        float* out = static_cast<float*>(destination);
+
+#if TRANSFORM_SOA_X86
+        if (path == SimdPath::AVX && best_simd_path() == SimdPath::AVX)
+        {
+            compose_avx(*this, first, count, out, (reinterpret_cast<uintptr_t>(out) & 31) == 0);
+            return;
+        }
+        if (path != SimdPath::Scalar)
+        {
+            compose_sse(*this, first, count, out, (reinterpret_cast<uintptr_t>(out) & 15) == 0);
+            return;
+        }
+#endif
+        for (size_t i = first; i < first + count; ++i, out += 16)
+            compose_scalar(*this, i, out);
+    }
+
+    void TransformSoA::ComposeMatrices(void* destination, size_t first, size_t count) const
+    {
+        ComposeMatrices(destination, first, count, best_simd_path());
+    }
+
+    // ===============
+    // PRIVATE
+    // ===============
+    void TransformSoA::Resize(size_t padded)
+    {
+        // padding lanes are identity transforms
+        for (Array* array : { &px, &py, &pz, &qx, &qy, &qz })
+            array->resize(padded, 0.0f);
+        for (Array* array : { &qw, &sx, &sy, &sz })
+            array->resize(padded, 1.0f);
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef _TRANSFORM_SOA_H
+#define _TRANSFORM_SOA_H
+
+#include "aligned_allocator.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <vector>
+#include <cstddef>
+
+namespace Utility
+{
+    enum class SimdPath
+    {
+        Scalar,
+        SSE,    // 4 matrices per step
+        AVX     // 8 matrices per step
+    };
+
+    const char* to_string(SimdPath path);
+    // Widest path the CPU supports (AVX is also checked for OS support)
+    SimdPath best_simd_path();
+
+    // Positions, rotations and scales of many objects in structure of arrays form: one array per
+    // component, so 4 (SSE) or 8 (AVX) objects load into one register per component and their
+    // world matrices (translate * rotate * scale) come out of a single pass with no gathers.
+    // The arrays are padded to a multiple of 8 with identity transforms.
+    class TransformSoA
+    {
+    public:
+        typedef std::vector<float, AlignedAllocator<float, 32>> Array;
+
+        size_t Add(const glm::vec3& position, const glm::quat& rotation = glm::quat(), const glm::vec3& scale = glm::vec3(1.0f));
+        void Clear();
+        void Reserve(size_t count);
+        size_t Size() const { return size_; }
+
+        void SetPosition(size_t index, const glm::vec3& position);
+        void SetRotation(size_t index, const glm::quat& rotation);
+        void SetScale(size_t index, const glm::vec3& scale);
+        glm::vec3 Position(size_t index) const;
+
+        // Writes the column major world matrices of [first, first + count) to destination, 64 bytes
+        // each, e.g. straight into a mapped instance buffer. A 32 byte aligned destination gets
+        // non-temporal stores that bypass the cache, the right thing for write combined GPU memory.
+        void ComposeMatrices(void* destination, size_t first, size_t count, SimdPath path) const;
+        void ComposeMatrices(void* destination, size_t first, size_t count) const;
+
+        // The arrays, for systems that update a component for every object in one pass
+        Array px, py, pz;
+        Array qx, qy, qz, qw;
+        Array sx, sy, sz;
+
+    private:
+        void Resize(size_t padded);
+
+    private:
+        size_t size_ = 0;
+    };
+}
+
+#endif // !_TRANSFORM_SOA_H
@@ -0,0 +1,1129 @@
+#include "benchmarks.h"
+#include "../mesh_library.h"
+#include "../mesh_optimizer.h"
+#include "../vertex_format.h"
+#include "../mesh_import.h"
+#include "../mesh_cooked.h"
+#include "../meshlet.h"
+#include "../frustum.h"
+#include "../buffer_arena.h"
+#include "../transform_soa.h"
+#include "../scene_graph.h"
+#include "../ecs.h"
+#include "../job_system.h"
+#include "../command_buffer.h"
+#include "../frame_pipeline.h"
+#include "../frame_arena.h"
+#include "../allocation_counter.h"
+#include "../clustered_lighting.h"
+#include "../deferred_shading.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <fstream>
+#include <thread>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    double elapsed_ms(const std::function<void()>& work)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        work();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    // Triangles in random order, as they typically come out of an exporter
+    void shuffle_triangles(std::vector<unsigned int>& indices, unsigned int seed)
+    {
+        std::vector<unsigned int> order(indices.size() / 3);
+        for (size_t i = 0; i < order.size(); ++i)
+            order[i] = (unsigned int)i;
+        std::shuffle(order.begin(), order.end(), std::mt19937(seed));
+
+        std::vector<unsigned int> shuffled;
+        shuffled.reserve(indices.size());
+        for (unsigned int t : order)
+            shuffled.insert(shuffled.end(), indices.begin() + t * 3, indices.begin() + t * 3 + 3);
+        indices.swap(shuffled);
+    }
+
+    // Writes the mesh as OBJ with 1-based v/vt/vn face corners
+    bool write_obj(const char* path, const Utility::mesh::MeshData& mesh)
+    {
+        using namespace Utility::mesh;
+
+        FILE* file = std::fopen(path, "wb");
+        if (!file)
+            return false;
+
+        unsigned int stride = vertex_stride(mesh.attributes);
+        for (size_t i = 0; i < mesh.VertexCount(); ++i)
+        {
+            const float* v = &mesh.vertices[i * stride];
+            std::fprintf(file, "v %.6f %.6f %.6f\n", v[0], v[1], v[2]);
+            std::fprintf(file, "vn %.6f %.6f %.6f\n", v[3], v[4], v[5]);
+            std::fprintf(file, "vt %.6f %.6f\n", v[6], v[7]);
+        }
+        for (size_t i = 0; i < mesh.indices.size(); i += 3)
+        {
+            unsigned int a = mesh.indices[i] + 1, b = mesh.indices[i + 1] + 1, c = mesh.indices[i + 2] + 1;
+            std::fprintf(file, "f %u/%u/%u %u/%u/%u %u/%u/%u\n", a, a, a, b, b, b, c, c, c);
+        }
+        std::fclose(file);
+        return true;
+    }
+
+    // Writes the mesh as a single primitive glb with interleaved float attributes and 32-bit indices
+    bool write_glb(const char* path, const Utility::mesh::MeshData& mesh)
+    {
+        size_t vertex_bytes = mesh.vertices.size() * sizeof(float);
+        size_t index_bytes = mesh.indices.size() * sizeof(unsigned int);
+        size_t count = mesh.VertexCount();
+
+        std::string json =
+            "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":" + std::to_string(vertex_bytes + index_bytes) + "}],"
+            "\"bufferViews\":[{\"buffer\":0,\"byteOffset\":0,\"byteLength\":" + std::to_string(vertex_bytes) + ",\"byteStride\":32},"
+            "{\"buffer\":0,\"byteOffset\":" + std::to_string(vertex_bytes) + ",\"byteLength\":" + std::to_string(index_bytes) + "}],"
+            "\"accessors\":["
+            "{\"bufferView\":0,\"byteOffset\":0,\"componentType\":5126,\"count\":" + std::to_string(count) + ",\"type\":\"VEC3\"},"
+            "{\"bufferView\":0,\"byteOffset\":12,\"componentType\":5126,\"count\":" + std::to_string(count) + ",\"type\":\"VEC3\"},"
+            "{\"bufferView\":0,\"byteOffset\":24,\"componentType\":5126,\"count\":" + std::to_string(count) + ",\"type\":\"VEC2\"},"
+            "{\"bufferView\":1,\"componentType\":5125,\"count\":" + std::to_string(mesh.indices.size()) + ",\"type\":\"SCALAR\"}],"
+            "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"TEXCOORD_0\":2},\"indices\":3}]}]}";
+        while (json.size() % 4)
+            json.push_back(' ');
+
+        uint32_t json_chunk[2] = { (uint32_t)json.size(), 0x4E4F534A };
+        uint32_t bin_chunk[2] = { (uint32_t)(vertex_bytes + index_bytes), 0x004E4942 };
+        uint32_t header[3] = { 0x46546C67, 2, (uint32_t)(12 + 8 + json.size() + 8 + vertex_bytes + index_bytes) };
+
+        std::ofstream file(path, std::ios::binary);
+        file.write((const char*)header, sizeof(header));
+        file.write((const char*)json_chunk, sizeof(json_chunk));
+        file.write(json.data(), json.size());
+        file.write((const char*)bin_chunk, sizeof(bin_chunk));
+        file.write((const char*)mesh.vertices.data(), vertex_bytes);
+        file.write((const char*)mesh.indices.data(), index_bytes);
+        return (bool)file;
+    }
+}
+
+namespace tutorials::benchmarks
+{
+    int VertexCache()
+    {
+        using namespace Utility::mesh;
+
+        struct Case { const char* name; MeshData mesh; };
+        Case cases[] = {
+            { "sphere 1024x512", sphere(Position | Normal, 0.5f, 1024, 512) },
+            { "plane 724x724", plane(Position | Normal, 1.0f, 724) }
+        };
+
+        for (Case& test : cases)
+        {
+            MeshData& mesh = test.mesh;
+            size_t vertex_count = mesh.VertexCount();
+            shuffle_triangles(mesh.indices, 42);
+
+            std::cout << "\n" << test.name << ": " << mesh.indices.size() / 3 << " triangles, " << vertex_count << " vertices\n";
+            std::cout << "  input (shuffled)   " << analyze_vertex_cache(mesh.indices, vertex_count) << "\n";
+
+            std::vector<unsigned int> forsyth = mesh.indices;
+            double forsyth_ms = elapsed_ms([&] { optimize_vertex_cache(forsyth, vertex_count); });
+            std::cout << "  forsyth            " << analyze_vertex_cache(forsyth, vertex_count) << " in " << forsyth_ms << " ms\n";
+
+            std::vector<unsigned int> tipsify = mesh.indices;
+            double tipsify_ms = elapsed_ms([&] { optimize_vertex_cache_tipsify(tipsify, vertex_count); });
+            std::cout << "  tipsify            " << analyze_vertex_cache(tipsify, vertex_count) << " in " << tipsify_ms << " ms\n";
+
+            double overdraw_ms = elapsed_ms([&] { optimize_overdraw(forsyth, mesh); });
+            std::cout << "  forsyth + overdraw " << analyze_vertex_cache(forsyth, vertex_count) << " in " << overdraw_ms << " ms\n";
+
+            MeshData optimized = mesh;
+            double all_ms = elapsed_ms([&] { optimize(optimized); });
+            std::cout << "  all passes         " << analyze_vertex_cache(optimized.indices, optimized.VertexCount()) << " in " << all_ms << " ms\n";
+        }
+
+        return 0;
+    }
+
+    int VertexFormats()
+    {
+        using namespace Utility::mesh;
+
+        const unsigned int attributes = Position | Normal | TexCoord;
+        struct Case { const char* name; MeshData mesh; };
+        Case cases[] = {
+            { "cube", cube(attributes) },
+            { "plane 64x64", plane(attributes, 10.0f, 64) },
+            { "sphere 256x128", sphere(attributes, 0.5f, 256, 128) },
+            { "cylinder 256", cylinder(attributes, 0.5f, 2.0f, 256) }
+        };
+        struct Encoding { const char* name; NormalEncoding normals; };
+        Encoding encodings[] = {
+            { "oct16     ", NormalEncoding::Octahedral16 },
+            { "10_10_10_2", NormalEncoding::Packed1010102 }
+        };
+
+        for (const Case& test : cases)
+        {
+            std::cout << "\n" << test.name << ": " << test.mesh.VertexCount() << " vertices\n";
+            for (const Encoding& encoding : encodings)
+            {
+                VertexFormatOptions options;
+                options.normals = encoding.normals;
+                QuantizationReport report;
+                PackedMesh packed = compile_vertex_format(test.mesh, options, &report);
+                std::cout << "  " << encoding.name << " stride " << packed.format.stride << ": " << report << "\n";
+            }
+        }
+
+        // The layout to hand to glVertexAttribPointer / glVertexAttribFormat
+        PackedVertexFormat format = compile_vertex_format(cube(attributes)).format;
+        std::cout << "\npacked layout, stride " << format.stride << "\n";
+        for (const VertexAttributeLayout& attribute : format.layout)
+            std::cout << "  location " << attribute.location << ": " << attribute.components << " x 0x" << std::hex << attribute.type << std::dec
+                      << (attribute.normalized ? " normalized" : "") << " at offset " << attribute.offset << "\n";
+
+        return 0;
+    }
+
+    int MeshImport()
+    {
+        using namespace Utility::mesh;
+
+        MeshData source = sphere(Position | Normal | TexCoord, 0.5f, 1024, 512);
+        const char* obj_path = "benchmark_sphere.obj";
+        const char* glb_path = "benchmark_sphere.glb";
+        if (!write_obj(obj_path, source) || !write_glb(glb_path, source))
+        {
+            std::cerr << "Failed to write the benchmark meshes" << std::endl;
+            return -1;
+        }
+        std::cout << "source: " << source.indices.size() / 3 << " triangles, " << source.VertexCount() << " vertices\n";
+
+        MeshData mesh;
+        ImportReport report;
+        ImportOptions single;
+        single.threads = 1;
+        load_obj(obj_path, mesh, single, &report);
+        std::cout << "  obj, 1 thread  " << report << "\n";
+
+        load_obj(obj_path, mesh, ImportOptions(), &report);
+        std::cout << "  obj, parallel  " << report << "\n";
+
+        std::vector<MeshData> meshes;
+        load_gltf(glb_path, meshes, ImportOptions(), &report);
+        std::cout << "  glb            " << report << "\n";
+
+        ImportOptions raw;
+        raw.weld = false;
+        load_gltf(glb_path, meshes, raw, &report);
+        std::cout << "  glb, no weld   " << report << "\n";
+
+        std::remove(obj_path);
+        std::remove(glb_path);
+        return 0;
+    }
+
+    int CookedMeshLoad()
+    {
+        using namespace Utility::mesh;
+
+        const char* obj_path = "benchmark_sphere.obj";
+        const char* cooked_path = "benchmark_sphere.mesh";
+        if (!write_obj(obj_path, sphere(Position | Normal | TexCoord, 0.5f, 1024, 512)))
+        {
+            std::cerr << "Failed to write the benchmark mesh" << std::endl;
+            return -1;
+        }
+
+        MeshData mesh;
+        ImportReport report;
+        load_obj(obj_path, mesh, ImportOptions(), &report);
+        std::cout << "obj import        " << report.milliseconds << " ms\n";
+
+        CookOptions options;
+        for (bool packed : { false, true })
+        {
+            options.packed = packed;
+            std::vector<CookedMeshSource> sources(1);
+            sources[0].mesh = mesh;
+            double cook_ms = elapsed_ms([&] { write_cooked_meshes(cooked_path, sources, options); });
+
+            // Opening validates the descriptors, the checksum touches every page like a GL upload would
+            uint64_t checksum = 0;
+            double load_ms = elapsed_ms([&] {
+                CookedMeshFile cooked(cooked_path);
+                for (size_t i = 0; i < cooked.MeshCount(); ++i)
+                {
+                    const CookedMeshDesc& desc = cooked.Mesh(i);
+                    const unsigned char* vertices = cooked.VertexData(i);
+                    for (uint64_t b = 0; b < desc.vertex_bytes; b += 64)
+                        checksum += vertices[b];
+                    const unsigned char* indices = cooked.IndexData(i, 0);
+                    for (uint64_t b = 0; b < desc.lods[0].index_count * (desc.index_type == GL_UNSIGNED_SHORT ? 2ull : 4ull); b += 64)
+                        checksum += indices[b];
+                }
+            });
+            std::cout << (packed ? "cooked, packed    " : "cooked, float     ") << "cook " << cook_ms << " ms, load " << load_ms << " ms"
+                      << " (checksum " << checksum << ")\n";
+        }
+
+        std::remove(obj_path);
+        std::remove(cooked_path);
+        return 0;
+    }
+
+    int Meshlets()
+    {
+        using namespace Utility::mesh;
+
+        // No high poly assets ship with the tutorials, a dense generated sphere stands in for one
+        MeshData mesh = sphere(Position | Normal, 0.5f, 1024, 512);
+        optimize_vertex_cache(mesh.indices, mesh.VertexCount());
+
+        MeshletMesh meshlets;
+        double build_ms = elapsed_ms([&] { meshlets = build_meshlets(mesh); });
+        std::cout << mesh.indices.size() / 3 << " triangles -> " << meshlets.meshlets.size() << " meshlets in " << build_ms << " ms, "
+                  << (double)meshlets.vertices.size() / meshlets.meshlets.size() << " vertices and "
+                  << (double)meshlets.TriangleCount() / meshlets.meshlets.size() << " triangles per meshlet\n";
+
+        glm::mat4 projection = glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, 0.1f, 100.0f);
+        struct View { const char* name; glm::vec3 eye; glm::vec3 target; };
+        View views[] = {
+            { "whole mesh in view", glm::vec3(0.0f, 0.0f, 2.0f), glm::vec3(0.0f) },
+            { "close up", glm::vec3(0.0f, 0.0f, 0.8f), glm::vec3(0.0f, 0.0f, 0.5f) },
+            { "grazing", glm::vec3(0.6f, 0.0f, 0.6f), glm::vec3(0.0f, 0.5f, 0.0f) }
+        };
+
+        std::vector<unsigned int> indices;
+        indices.reserve(mesh.indices.size());
+        for (const View& view : views)
+        {
+            Utility::Frustum frustum = Utility::Frustum::FromMatrix(projection * glm::lookAt(view.eye, view.target, glm::vec3(0.0f, 1.0f, 0.0f)));
+            MeshletCullStats stats;
+            const int runs = 20;
+            double cull_ms = elapsed_ms([&] {
+                for (int i = 0; i < runs; ++i)
+                {
+                    indices.clear();
+                    stats = MeshletCullStats();
+                    cull_meshlets(meshlets, glm::mat4(1.0f), frustum, view.eye, indices, &stats);
+                }
+            }) / runs;
+            std::cout << "  " << view.name << ": " << stats << " in " << cull_ms << " ms\n";
+        }
+
+        return 0;
+    }
+
+    int BufferArena()
+    {
+        // Streams mesh sized ranges in and out of one 64 MB vertex buffer the way a level streamer would.
+        // Only the allocator is exercised, the GL side is a single glBufferSubData per range.
+        const uint32_t capacity = 64u << 20;
+        const size_t operations = 1000000;
+        Utility::TlsfAllocator allocator(capacity);
+        std::mt19937 rng(35);
+        std::uniform_int_distribution<uint32_t> vertex_count(24, 16384);
+        std::vector<Utility::TlsfAllocator::Allocation> live;
+        size_t allocations = 0, failures = 0;
+
+        auto report = [&]() {
+            Utility::ArenaReport result;
+            result.buffers = 1;
+            result.capacity = allocator.Capacity();
+            result.used = allocator.UsedBytes();
+            result.largest_free = allocator.LargestFreeBlock();
+            result.free_blocks = allocator.FreeBlockCount();
+            result.allocations = allocator.AllocationCount();
+            return result;
+        };
+
+        double churn_ms = elapsed_ms([&] {
+            for (size_t i = 0; i < operations; ++i)
+            {
+                // Allocate until the buffer is about 85% full, then free and allocate at random
+                bool allocate = live.empty() || (allocator.UsedBytes() < capacity / 100 * 85 ? rng() % 4 != 0 : rng() % 2 == 0);
+                if (allocate)
+                {
+                    uint32_t stride = rng() % 2 ? 24 : 32; // Position|Normal or Position|Normal|TexCoord
+                    Utility::TlsfAllocator::Allocation range = allocator.Allocate(vertex_count(rng) * stride, stride);
+                    if (range.Valid())
+                    {
+                        live.push_back(range);
+                        ++allocations;
+                    }
+                    else
+                        ++failures;
+                }
+                else
+                {
+                    size_t victim = rng() % live.size();
+                    allocator.Free(live[victim]);
+                    live[victim] = live.back();
+                    live.pop_back();
+                }
+            }
+        });
+        std::cout << operations << " allocate/free operations in " << churn_ms << " ms (" << churn_ms * 1e6 / operations << " ns each), "
+                  << allocations << " ranges placed, " << failures << " did not fit\n";
+        std::cout << "after churn: " << report() << "\n";
+
+        for (const Utility::TlsfAllocator::Allocation& range : live)
+            allocator.Free(range);
+        std::cout << "after freeing everything: " << report() << "\n";
+
+        return 0;
+    }
+
+    int TransformCompose()
+    {
+        const size_t count = 100000;
+        const int runs = 20;
+        std::mt19937 rng(39);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+        std::vector<glm::vec3> positions(count), axes(count), scales(count);
+        std::vector<float> angles(count);
+        Utility::TransformSoA transforms;
+        transforms.Reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            positions[i] = glm::vec3(unit(rng), unit(rng), unit(rng)) * 100.0f;
+            axes[i] = glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng)) + glm::vec3(0.0f, 2.0f, 0.0f));
+            angles[i] = unit(rng) * 3.14159265f;
+            scales[i] = glm::vec3(1.0f + 0.5f * unit(rng));
+            transforms.Add(positions[i], glm::angleAxis(angles[i], axes[i]), scales[i]);
+        }
+
+        // The per object loop of the tutorials
+        std::vector<glm::mat4> reference(count);
+        double glm_ms = elapsed_ms([&] {
+            for (int run = 0; run < runs; ++run)
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    glm::mat4 model = glm::translate(glm::mat4(1.0f), positions[i]);
+                    model = glm::rotate(model, angles[i], axes[i]);
+                    reference[i] = glm::scale(model, scales[i]);
+                }
+            }
+        }) / runs;
+        std::cout << "glm per object: " << glm_ms << " ms, " << count / glm_ms / 1000.0 << " M matrices/s\n";
+
+        // 32 byte aligned like a mapped buffer, so the SIMD paths use streaming stores
+        Utility::TransformSoA::Array matrices(count * 16);
+        for (Utility::SimdPath path : { Utility::SimdPath::Scalar, Utility::SimdPath::SSE, Utility::SimdPath::AVX })
+        {
+            if (path == Utility::SimdPath::AVX && Utility::best_simd_path() != Utility::SimdPath::AVX)
+                continue;
+            double ms = elapsed_ms([&] {
+                for (int run = 0; run < runs; ++run)
+                    transforms.ComposeMatrices(matrices.data(), 0, count, path);
+            }) / runs;
+
+            float max_error = 0.0f;
+            for (size_t i = 0; i < count; ++i)
+            {
+                const float* expected = &reference[i][0][0];
+                for (int e = 0; e < 16; ++e)
+                    max_error = std::max(max_error, std::fabs(matrices[i * 16 + e] - expected[e]));
+            }
+            std::cout << "SoA " << Utility::to_string(path) << ": " << ms << " ms, " << count / ms / 1000.0 << " M matrices/s, "
+                      << glm_ms / ms << "x, max difference to glm " << max_error << "\n";
+        }
+
+        return 0;
+    }
+
+    int SceneGraphUpdate()
+    {
+        // 1000 "vehicles": a root with 10 parts of 10 attachments each, 111K nodes
+        const int roots = 1000, parts = 10, attachments = 10;
+        const int frames = 20;
+        std::mt19937 rng(40);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        auto random_rotation = [&]() {
+            return glm::angleAxis(unit(rng) * 3.14159265f, glm::normalize(glm::vec3(unit(rng), 2.0f, unit(rng))));
+        };
+
+        // The same hierarchy as heap allocated nodes with child pointers, recomputed recursively
+        struct PointerNode
+        {
+            glm::vec3 position;
+            glm::quat rotation;
+            glm::mat4 world;
+            std::vector<PointerNode*> children;
+        };
+        std::vector<std::unique_ptr<PointerNode>> pointer_nodes;
+        std::vector<PointerNode*> pointer_roots;
+
+        Utility::SceneGraph graph;
+        graph.Reserve(roots * (1 + parts * (1 + attachments)));
+        std::vector<Utility::SceneGraph::NodeId> root_ids;
+        double build_ms = elapsed_ms([&] {
+            for (int r = 0; r < roots; ++r)
+            {
+                glm::vec3 position(unit(rng) * 500.0f, 0.0f, unit(rng) * 500.0f);
+                Utility::SceneGraph::NodeId root = graph.Create(Utility::SceneGraph::kInvalidNode, position);
+                root_ids.push_back(root);
+                pointer_nodes.emplace_back(new PointerNode{ position, glm::quat(), glm::mat4(1.0f), {} });
+                PointerNode* pointer_root = pointer_nodes.back().get();
+                pointer_roots.push_back(pointer_root);
+
+                for (int p = 0; p < parts; ++p)
+                {
+                    glm::vec3 offset(unit(rng) * 4.0f, unit(rng), unit(rng) * 4.0f);
+                    glm::quat rotation = random_rotation();
+                    Utility::SceneGraph::NodeId part = graph.Create(root, offset, rotation);
+                    pointer_nodes.emplace_back(new PointerNode{ offset, rotation, glm::mat4(1.0f), {} });
+                    PointerNode* pointer_part = pointer_nodes.back().get();
+                    pointer_root->children.push_back(pointer_part);
+
+                    for (int a = 0; a < attachments; ++a)
+                    {
+                        glm::vec3 attachment_offset(unit(rng), unit(rng), unit(rng));
+                        graph.Create(part, attachment_offset);
+                        pointer_nodes.emplace_back(new PointerNode{ attachment_offset, glm::quat(), glm::mat4(1.0f), {} });
+                        pointer_part->children.push_back(pointer_nodes.back().get());
+                    }
+                }
+            }
+        });
+        std::cout << graph.Size() << " nodes built in " << build_ms << " ms\n";
+
+        std::function<void(PointerNode*, const glm::mat4&)> update_pointer = [&](PointerNode* node, const glm::mat4& parent) {
+            node->world = parent * glm::translate(glm::mat4(1.0f), node->position) * glm::mat4_cast(node->rotation);
+            for (PointerNode* child : node->children)
+                update_pointer(child, node->world);
+        };
+        double pointer_ms = elapsed_ms([&] {
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                for (PointerNode* root : pointer_roots)
+                    update_pointer(root, glm::mat4(1.0f));
+            }
+        }) / frames;
+        std::cout << "pointer tree, everything recomputed: " << pointer_ms << " ms per frame\n";
+
+        graph.Update();
+        Utility::SceneUpdateOptions single_thread;
+        single_thread.threads = 1;
+        Utility::SceneUpdateOptions all_threads;
+
+        auto run = [&](const char* name, size_t moving, const Utility::SceneUpdateOptions& options) {
+            Utility::SceneUpdateReport last;
+            double total_ms = 0.0;
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                for (size_t r = 0; r < moving; ++r)
+                    graph.SetRotation(root_ids[r], glm::angleAxis(0.01f * frame, glm::vec3(0.0f, 1.0f, 0.0f)));
+                last = graph.Update(options);
+                total_ms += last.milliseconds;
+            }
+            std::cout << name << ": " << total_ms / frames << " ms per frame (" << last << ")\n";
+        };
+        run("static", 0, all_threads);
+        run("1% of the roots moving", roots / 100, all_threads);
+        run("every root moving, 1 thread", roots, single_thread);
+        run("every root moving, all threads", roots, all_threads);
+
+        // Both paths have to agree; the pointer nodes were created in the same depth first order
+        float max_error = 0.0f;
+        for (int r = 0; r < roots; ++r)
+        {
+            pointer_roots[r]->rotation = graph.Rotation(root_ids[r]);
+            update_pointer(pointer_roots[r], glm::mat4(1.0f));
+        }
+        for (size_t i = 0; i < graph.Size(); ++i)
+        {
+            const float* flat = &graph.WorldMatrices()[i][0][0];
+            const float* pointer = &pointer_nodes[i]->world[0][0];
+            for (int e = 0; e < 16; ++e)
+                max_error = std::max(max_error, std::fabs(flat[e] - pointer[e]));
+        }
+        std::cout << "max difference to the pointer tree " << max_error << "\n";
+
+        return 0;
+    }
+
+    int EntityIteration()
+    {
+        using namespace Utility::ecs;
+
+        const size_t renderables = 100000, lights = 1000;
+        const int frames = 20;
+        std::mt19937 rng(41);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+        // The usual object: every field in one heap allocation, objects created in random order
+        struct GameObject
+        {
+            Transform transform;
+            MeshRef mesh;
+            MaterialRef material;
+            Bounds bounds;
+            bool has_light = false;
+            Light light;
+        };
+        std::vector<std::unique_ptr<GameObject>> objects;
+
+        World world;
+        for (size_t i = 0; i < renderables + lights; ++i)
+        {
+            bool light = i >= renderables;
+            Transform transform;
+            transform.position = glm::vec3(unit(rng), unit(rng) * 0.1f, unit(rng)) * 500.0f;
+            transform.rotation = glm::angleAxis(unit(rng) * 3.14159265f, glm::vec3(0.0f, 1.0f, 0.0f));
+
+            Entity entity = world.Create(light ? TransformComponent | LightComponent
+                                               : TransformComponent | MeshComponent | MaterialComponent | BoundsComponent);
+            *world.Get<Transform>(entity) = transform;
+            std::unique_ptr<GameObject> object(new GameObject());
+            object->transform = transform;
+            if (light)
+            {
+                object->has_light = true;
+            }
+            else
+            {
+                uint32_t mesh = (uint32_t)(rng() % 3), material = (uint32_t)(rng() % 8);
+                world.Get<MeshRef>(entity)->mesh = object->mesh.mesh = mesh;
+                world.Get<MaterialRef>(entity)->material = object->material.material = material;
+                *world.Get<Bounds>(entity) = object->bounds = { glm::vec3(0.0f), 0.87f };
+            }
+            objects.push_back(std::move(object));
+        }
+        std::shuffle(objects.begin(), objects.end(), rng);
+        std::cout << world.Size() << " entities in " << world.ArchetypeCount() << " archetypes, " << world.ChunkCount() << " chunks of "
+                  << Utility::ecs::Chunk::kBytes / 1024 << " KB\n";
+
+        glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 50.0f, 0.0f), glm::vec3(100.0f, 0.0f, -100.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        Utility::Frustum frustum = Utility::Frustum::FromMatrix(projection * view);
+
+        // Same work through the objects
+        std::vector<DrawItem> object_draws;
+        std::vector<LightInstance> object_lights;
+        double objects_ms = elapsed_ms([&] {
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                object_draws.clear();
+                object_lights.clear();
+                for (const std::unique_ptr<GameObject>& object : objects)
+                {
+                    Transform& t = object->transform;
+                    t.world = glm::translate(glm::mat4(1.0f), t.position) * glm::mat4_cast(t.rotation) * glm::scale(glm::mat4(1.0f), t.scale);
+                }
+                for (const std::unique_ptr<GameObject>& object : objects)
+                {
+                    const glm::mat4& model = object->transform.world;
+                    if (object->has_light)
+                    {
+                        object_lights.push_back({ glm::vec3(model[3]), object->light });
+                        continue;
+                    }
+                    glm::vec3 center = glm::vec3(model * glm::vec4(object->bounds.center, 1.0f));
+                    if (frustum.IntersectsSphere(center, object->bounds.radius))
+                        object_draws.push_back({ model, object->mesh.mesh, object->material.material });
+                }
+            }
+        }) / frames;
+        std::cout << "heap objects: " << objects_ms << " ms per frame, " << object_draws.size() << " draws, " << object_lights.size() << " lights\n";
+
+        DrawList draws;
+        std::vector<LightInstance> world_lights;
+        auto run = [&](const char* name, unsigned int threads) {
+            double transform_ms = 0.0, extract_ms = 0.0;
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                transform_ms += elapsed_ms([&] { update_world_transforms(world, threads); });
+                extract_ms += elapsed_ms([&] {
+                    extract_draws(world, frustum, draws, threads);
+                    collect_lights(world, world_lights);
+                });
+            }
+            std::cout << name << ": " << (transform_ms + extract_ms) / frames << " ms per frame (transforms " << transform_ms / frames
+                      << " ms, extraction " << extract_ms / frames << " ms), " << draws.items.size() << " draws, " << world_lights.size() << " lights\n";
+        };
+        run("chunks, 1 thread", 1);
+        run("chunks, all threads", 0);
+
+        return 0;
+    }
+
+    int JobSystemThroughput()
+    {
+        Utility::JobSystem jobs;
+        std::cout << jobs.ThreadCount() << " workers\n";
+
+        // Scheduling cost: empty children of one root, created and submitted from worker 0
+        const size_t empty_jobs = 1000000;
+        const size_t batch = Utility::JobSystem::kJobsPerWorker / 2;
+        std::atomic<size_t> executed{ 0 };
+        double empty_ms = elapsed_ms([&] {
+            for (size_t done = 0; done < empty_jobs; done += batch)
+            {
+                Utility::Job* root = jobs.CreateJob([] {});
+                for (size_t i = 0; i < batch; ++i)
+                    jobs.Submit(jobs.CreateJob([&executed] { executed.fetch_add(1, std::memory_order_relaxed); }, root));
+                jobs.Submit(root);
+                jobs.Wait(root);
+            }
+        });
+        std::cout << executed.load() << " empty jobs in " << empty_ms << " ms, " << empty_ms * 1e6 / executed.load() << " ns per job\n";
+
+        // Dependency chain: every job waits for the previous one
+        const size_t chain = 1000;
+        size_t order_errors = 0, next = 0;
+        double chain_ms = elapsed_ms([&] {
+            Utility::Job* root = jobs.CreateJob([] {});
+            Utility::Job* previous = nullptr;
+            std::vector<Utility::Job*> links;
+            for (size_t i = 0; i < chain; ++i)
+            {
+                Utility::Job* link = jobs.CreateJob([&order_errors, &next, i] {
+                    if (next++ != i)
+                        ++order_errors;
+                }, root);
+                if (previous)
+                    jobs.AddDependency(link, previous);
+                links.push_back(link);
+                previous = link;
+            }
+            for (Utility::Job* link : links)
+                jobs.Submit(link);
+            jobs.Submit(root);
+            jobs.Wait(root);
+        });
+        std::cout << chain << " chained jobs in " << chain_ms << " ms, " << order_errors << " out of order\n";
+
+        // Per frame ECS work: the pool against threads started for every pass
+        using namespace Utility::ecs;
+        World world;
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        for (size_t i = 0; i < 100000; ++i)
+        {
+            Entity entity = world.Create(TransformComponent | MeshComponent | MaterialComponent | BoundsComponent);
+            world.Get<Transform>(entity)->position = glm::vec3(unit(rng), 0.0f, unit(rng)) * 500.0f;
+            world.Get<Bounds>(entity)->radius = 0.87f;
+        }
+        glm::mat4 view_projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 1000.0f) *
+            glm::lookAt(glm::vec3(0.0f, 50.0f, 0.0f), glm::vec3(100.0f, 0.0f, -100.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        Utility::Frustum frustum = Utility::Frustum::FromMatrix(view_projection);
+
+        const int frames = 50;
+        DrawList draws;
+        double threads_ms = elapsed_ms([&] {
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                update_world_transforms(world, jobs.ThreadCount());
+                extract_draws(world, frustum, draws, jobs.ThreadCount());
+            }
+        }) / frames;
+        size_t thread_draws = draws.items.size();
+        double jobs_ms = elapsed_ms([&] {
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                update_world_transforms(world, jobs);
+                extract_draws(world, frustum, draws, jobs);
+            }
+        }) / frames;
+        std::cout << "transforms + draw extraction over " << world.Size() << " entities: threads " << threads_ms << " ms, jobs "
+                  << jobs_ms << " ms per frame (" << thread_draws << " / " << draws.items.size() << " draws)\n";
+
+        return 0;
+    }
+
+    int CommandRecording()
+    {
+        using namespace Utility::render;
+        Utility::JobSystem jobs;
+
+        // The IndirectObjects field: a model matrix, a color, a vertex array and a draw per object
+        const size_t object_count = 128 * 128;
+        struct Object
+        {
+            glm::mat4 model;
+            glm::vec3 color;
+            uint32_t vao;
+            uint32_t index_count;
+        };
+        std::vector<Object> objects(object_count);
+        for (size_t i = 0; i < object_count; ++i)
+        {
+            objects[i].model = glm::translate(glm::mat4(1.0f), glm::vec3((float)(i % 128), 0.0f, (float)(i / 128)));
+            objects[i].color = glm::vec3((float)(i % 8) / 8.0f);
+            objects[i].vao = 1 + (uint32_t)(i % 3);
+            objects[i].index_count = 36;
+        }
+
+        auto record = [&objects](CommandBuffer& commands, size_t begin, size_t end) {
+            commands.UseProgram(1);
+            for (size_t i = begin; i < end; ++i)
+            {
+                commands.SetUniform(0, objects[i].model);
+                commands.SetUniform(1, objects[i].color);
+                commands.BindVertexArray(objects[i].vao);
+                commands.DrawElements(0x0004, objects[i].index_count, 0x1403, 0);
+            }
+        };
+
+        // Replay without a context: walks the commands like the GL executor and counts the draws
+        auto replay = [](const CommandBuffer& commands) {
+            size_t draws = 0;
+            commands.ForEach([&draws](const CommandHeader& header, const void* payload) {
+                if (header.type == CommandType::DrawElements)
+                    draws += ((const DrawElementsCommand*)payload)->instance_count;
+            });
+            return draws;
+        };
+
+        const int frames = 50;
+        CommandBuffer single;
+        record(single, 0, object_count);
+        size_t first_capacity = single.Capacity();
+        double single_ms = elapsed_ms([&] {
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                single.Reset();
+                record(single, 0, object_count);
+            }
+        }) / frames;
+        std::cout << "single thread: " << object_count << " draws, " << single.CommandCount() << " commands, "
+                  << (double)single.Bytes() / object_count << " bytes per draw, " << single_ms << " ms per frame, "
+                  << (single.Capacity() == first_capacity ? "no" : "some") << " growth after the first frame\n";
+
+        // One buffer per bucket of objects, recorded by whichever worker picks the bucket up and
+        // replayed in bucket order, so the result matches the single buffer
+        const size_t buckets = 64;
+        std::vector<CommandBuffer> parallel(buckets);
+        double parallel_ms = elapsed_ms([&] {
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                jobs.ParallelFor(buckets, 1, [&](size_t begin, size_t end) {
+                    for (size_t b = begin; b < end; ++b)
+                    {
+                        parallel[b].Reset();
+                        record(parallel[b], object_count * b / buckets, object_count * (b + 1) / buckets);
+                    }
+                });
+            }
+        }) / frames;
+        std::cout << jobs.ThreadCount() << " workers, " << buckets << " buffers: " << parallel_ms << " ms per frame\n";
+
+        size_t single_draws = 0, parallel_draws = 0;
+        double replay_ms = elapsed_ms([&] {
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                single_draws = replay(single);
+                parallel_draws = 0;
+                for (const CommandBuffer& commands : parallel)
+                    parallel_draws += replay(commands);
+            }
+        }) / frames;
+        std::cout << "replay walk of both: " << replay_ms << " ms per frame (" << single_draws << " / " << parallel_draws << " draws)\n";
+
+        return 0;
+    }
+
+    int FramePipelineLatency()
+    {
+        // Sleeps stand in for the stages: 4 ms of simulation with a 12 ms spike every 25 frames and
+        // 5 ms of submission, so the pipeline overlaps them even on a single core
+        const int frames = 200;
+        auto simulate = [](unsigned long long frame) {
+            std::this_thread::sleep_for(std::chrono::microseconds(frame % 25 == 24 ? 16000 : 4000));
+        };
+        auto render = [] { std::this_thread::sleep_for(std::chrono::microseconds(5000)); };
+
+        Utility::FramePipelineOptions options;
+        options.gpu_fences = false;
+
+        // Both stages on one thread: the loop every tutorial runs
+        {
+            options.snapshots = 1;
+            Utility::FramePipeline pipeline(options);
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                int snapshot = pipeline.BeginSimulation();
+                simulate(pipeline.FrameIndex(snapshot));
+                pipeline.EndSimulation(snapshot);
+                snapshot = pipeline.BeginRender();
+                render();
+                pipeline.EndRender(snapshot);
+            }
+            std::cout << "serial:        " << pipeline.Report() << "\n";
+        }
+
+        for (unsigned int snapshots : { 2u, 3u })
+        {
+            options.snapshots = snapshots;
+            Utility::FramePipeline pipeline(options);
+            std::thread simulation([&pipeline, &simulate] {
+                for (int snapshot; (snapshot = pipeline.BeginSimulation()) >= 0;)
+                {
+                    simulate(pipeline.FrameIndex(snapshot));
+                    pipeline.EndSimulation(snapshot);
+                }
+            });
+            for (int frame = 0; frame < frames; ++frame)
+            {
+                int snapshot = pipeline.BeginRender();
+                render();
+                pipeline.EndRender(snapshot);
+            }
+            pipeline.Stop();
+            simulation.join();
+            std::cout << snapshots << " snapshots:   " << pipeline.Report() << "\n";
+        }
+
+        return 0;
+    }
+
+    int FrameAllocations()
+    {
+        Utility::JobSystem jobs;
+        if (!Utility::debug::allocations_counted())
+            std::cout << "release build: allocations are not counted\n";
+
+        // Per frame transient data as a renderer builds it: every bucket of objects produces a list
+        // of sort keys for its visible draws, the lists are merged and sorted
+        const size_t object_count = 100000;
+        const size_t buckets = 64;
+        std::vector<glm::vec3> positions(object_count);
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        for (glm::vec3& position : positions)
+            position = glm::vec3(unit(rng), unit(rng), unit(rng)) * 100.0f;
+
+        auto visible = [&positions](size_t i, int frame) {
+            return positions[i].x + frame * 0.5f > -50.0f + (float)(i % 7);
+        };
+        auto key = [&positions](size_t i) {
+            return ((uint64_t)(positions[i].z * 100.0f + 1e6f) << 20) | (i & 0xfffff);
+        };
+
+        const int warm_up = 5;
+        const int frames = 50;
+
+        // Fresh standard containers every frame
+        size_t heap_draws = 0;
+        unsigned long long heap_allocations = 0;
+        double heap_ms = 0.0;
+        for (int frame = 0; frame < warm_up + frames; ++frame)
+        {
+            // Counted inside the timed work, the std::function wrapping it allocates
+            unsigned long long allocations = 0;
+            double ms = elapsed_ms([&] {
+                unsigned long long before = Utility::debug::allocation_count();
+                std::vector<std::vector<uint64_t>> lists(buckets);
+                jobs.ParallelFor(buckets, 1, [&](size_t begin, size_t end) {
+                    for (size_t b = begin; b < end; ++b)
+                    {
+                        for (size_t i = object_count * b / buckets; i < object_count * (b + 1) / buckets; ++i)
+                        {
+                            if (visible(i, frame))
+                                lists[b].push_back(key(i));
+                        }
+                    }
+                });
+                size_t total = 0;
+                for (const std::vector<uint64_t>& list : lists)
+                    total += list.size();
+                std::vector<uint64_t> draws;
+                draws.reserve(total);
+                for (const std::vector<uint64_t>& list : lists)
+                    draws.insert(draws.end(), list.begin(), list.end());
+                std::sort(draws.begin(), draws.end());
+                heap_draws = draws.size();
+                allocations = Utility::debug::allocation_count() - before;
+            });
+            if (frame >= warm_up)
+            {
+                heap_ms += ms;
+                heap_allocations += allocations;
+            }
+        }
+
+        // The same containers over a frame arena, reset at the end of every frame
+        Utility::FrameArena arena;
+        size_t arena_draws = 0;
+        unsigned long long arena_allocations = 0;
+        double arena_ms = 0.0;
+        for (int frame = 0; frame < warm_up + frames; ++frame)
+        {
+            unsigned long long allocations = 0;
+            double ms = elapsed_ms([&] {
+                unsigned long long before = Utility::debug::allocation_count();
+                Utility::FrameVector<uint64_t>* lists = arena.Allocate<Utility::FrameVector<uint64_t>>(buckets);
+                for (size_t b = 0; b < buckets; ++b)
+                    new (&lists[b]) Utility::FrameVector<uint64_t>(arena);
+                jobs.ParallelFor(buckets, 1, [&](size_t begin, size_t end) {
+                    for (size_t b = begin; b < end; ++b)
+                    {
+                        for (size_t i = object_count * b / buckets; i < object_count * (b + 1) / buckets; ++i)
+                        {
+                            if (visible(i, frame))
+                                lists[b].push_back(key(i));
+                        }
+                    }
+                });
+                size_t total = 0;
+                for (size_t b = 0; b < buckets; ++b)
+                    total += lists[b].size();
+                Utility::FrameVector<uint64_t> draws(arena);
+                draws.reserve(total);
+                for (size_t b = 0; b < buckets; ++b)
+                    draws.insert(draws.end(), lists[b].begin(), lists[b].end());
+                std::sort(draws.begin(), draws.end());
+                arena_draws = draws.size();
+                allocations = Utility::debug::allocation_count() - before;
+            });
+            arena.Reset();
+            if (frame >= warm_up)
+            {
+                arena_ms += ms;
+                arena_allocations += allocations;
+            }
+        }
+
+        std::cout << jobs.ThreadCount() << " workers, " << buckets << " lists per frame\n";
+        std::cout << "heap:  " << heap_ms / frames << " ms, " << (double)heap_allocations / frames << " allocations per frame ("
+                  << heap_draws << " draws)\n";
+        std::cout << "arena: " << arena_ms / frames << " ms, " << (double)arena_allocations / frames << " allocations per frame ("
+                  << arena_draws << " draws), " << arena.SlabCount() << " slabs, " << arena.Capacity() / 1024 << " KB\n";
+        return 0;
+    }
+
+    int ClusteredLightAssignment()
+    {
+        // 1080p view over a large lit field, lights spread over the ground in front of the camera
+        Utility::render::ClusterGrid grid;
+        const float fov_y = glm::radians(45.0f);
+        const float aspect = 1920.0f / 1080.0f;
+        grid.SetProjection(fov_y, aspect, 0.1f, 500.0f);
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 20.0f, 30.0f), glm::vec3(0.0f, 0.0f, -100.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+        const size_t max_lights = 4096;
+        std::vector<Utility::render::GpuPointLight> lights(max_lights);
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        for (Utility::render::GpuPointLight& light : lights)
+        {
+            light.position = glm::vec3((unit(rng) - 0.5f) * 400.0f, unit(rng) * 10.0f, -unit(rng) * 400.0f);
+            light.radius = 5.0f + unit(rng) * 10.0f;
+            light.color = glm::vec3(1.0f);
+        }
+
+        std::cout << grid.Options().tiles_x << "x" << grid.Options().tiles_y << "x" << grid.Options().slices << " clusters ("
+                  << grid.ClusterCount() << ")\n";
+        std::cout << "lights  assign ms  lights per fragment (forward / clustered)\n";
+        const int runs = 20;
+        for (size_t count = 1; count <= max_lights; count *= 2)
+        {
+            grid.Assign(lights.data(), count, view);
+            double ms = elapsed_ms([&] {
+                for (int run = 0; run < runs; ++run)
+                    grid.Assign(lights.data(), count, view);
+            }) / runs;
+
+            // A forward shader loops over every light for every fragment; a clustered one over the
+            // lights of its cluster, averaged here over the occupied clusters
+            const Utility::render::ClusterStats& stats = grid.Stats();
+            double per_cluster = stats.occupied_clusters ? (double)stats.references / stats.occupied_clusters : 0.0;
+            char line[128];
+            std::snprintf(line, sizeof(line), "%6zu  %9.3f  %7zu / %6.1f  ", count, ms, count, per_cluster);
+            std::cout << line << stats << "\n";
+        }
+        return 0;
+    }
+
+    int GBufferBandwidth()
+    {
+        // Normal precision of the encodings a G-buffer can store, over random unit normals
+        std::mt19937 rng(13);
+        std::normal_distribution<float> gauss(0.0f, 1.0f);
+        std::vector<glm::vec3> normals(1000000);
+        for (glm::vec3& normal : normals)
+            normal = glm::normalize(glm::vec3(gauss(rng), gauss(rng), gauss(rng)));
+
+        auto quantize = [](float value, int bits) {
+            float steps = (float)((1 << bits) - 1);
+            return std::round((value * 0.5f + 0.5f) * steps) / steps * 2.0f - 1.0f;
+        };
+        auto angle_error = [](glm::vec3 a, glm::vec3 b) {
+            return std::acos(std::min(std::max(glm::dot(a, b), -1.0f), 1.0f)) * 57.2957795f;
+        };
+        struct Encoding
+        {
+            const char* name;
+            size_t bytes;
+            std::function<glm::vec3(glm::vec3)> round_trip;
+        };
+        const Encoding encodings[] = {
+            { "xyz RGBA8         ", 4, [&](glm::vec3 n) { return glm::normalize(glm::vec3(quantize(n.x, 8), quantize(n.y, 8), quantize(n.z, 8))); } },
+            { "octahedral RG8    ", 2, [&](glm::vec3 n) { glm::vec2 e = Utility::mesh::oct_encode(n); return Utility::mesh::oct_decode(glm::vec2(quantize(e.x, 8), quantize(e.y, 8))); } },
+            { "octahedral RGB10A2", 4, [&](glm::vec3 n) { glm::vec2 e = Utility::mesh::oct_encode(n); return Utility::mesh::oct_decode(glm::vec2(quantize(e.x, 10), quantize(e.y, 10))); } },
+            { "xyz RGBA16F       ", 8, [&](glm::vec3 n) {
+                using Utility::mesh::half_to_float;
+                using Utility::mesh::float_to_half;
+                return glm::normalize(glm::vec3(half_to_float(float_to_half(n.x)), half_to_float(float_to_half(n.y)), half_to_float(float_to_half(n.z))));
+            } }
+        };
+        std::cout << "normal encoding     bytes  max error  mean error (degrees)\n";
+        for (const Encoding& encoding : encodings)
+        {
+            double sum = 0.0;
+            float max_error = 0.0f;
+            for (const glm::vec3& normal : normals)
+            {
+                float error = angle_error(normal, encoding.round_trip(normal));
+                sum += error;
+                max_error = std::max(max_error, error);
+            }
+            char line[128];
+            std::snprintf(line, sizeof(line), "%s  %5zu  %9.4f  %10.4f\n", encoding.name, encoding.bytes, max_error, sum / normals.size());
+            std::cout << line;
+        }
+
+        // Per resolution, the compact layout against position + normal in RGBA16F. Traffic assumes
+        // 1.5 fragments per pixel in the geometry pass and 8 lights reaching every pixel
+        const int resolutions[][2] = { { 1280, 720 }, { 1920, 1080 }, { 2560, 1440 }, { 3840, 2160 } };
+        const double overdraw = 1.5;
+        const double lights_per_pixel = 8.0;
+        const double frames_per_second = 60.0;
+        std::cout << "\nresolution  layout   MB targets  MB/frame  GB/s at 60 fps\n";
+        for (const int* resolution : resolutions)
+        {
+            for (size_t bytes_per_pixel : { Utility::render::GBuffer::kBytesPerPixel, Utility::render::GBuffer::kWideBytesPerPixel })
+            {
+                Utility::render::GBufferFootprint footprint = Utility::render::GBuffer::Footprint(resolution[0], resolution[1], bytes_per_pixel);
+                double pixels = (double)resolution[0] * resolution[1];
+                footprint.geometry_fragments = (size_t)(pixels * overdraw);
+                footprint.lighting_fragments = (size_t)(pixels * lights_per_pixel);
+                double frame_bytes = footprint.GeometryBytes() + footprint.LightingBytes();
+                char line[128];
+                std::snprintf(line, sizeof(line), "%4dx%-4d   %-7s  %10.1f  %8.1f  %14.2f\n", resolution[0], resolution[1],
+                              bytes_per_pixel == Utility::render::GBuffer::kBytesPerPixel ? "compact" : "wide",
+                              footprint.target_bytes / (1024.0 * 1024.0), frame_bytes / (1024.0 * 1024.0),
+                              frame_bytes * frames_per_second / (1024.0 * 1024.0 * 1024.0));
+                std::cout << line;
+            }
+        }
+        return 0;
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef _BENCHMARKS_H_
+#define _BENCHMARKS_H_
+
+namespace tutorials::benchmarks
+{
+	// Vertex cache (Forsyth/Tipsify), overdraw and vertex fetch optimisation on large generated meshes
+	int VertexCache();
+	// Size and decoding error of the packed vertex formats per mesh
+	int VertexFormats();
+	// OBJ (single vs parallel parsing) and glb import throughput on a generated ~1M triangle mesh
+	int MeshImport();
+	// Start up cost of a cooked (memory mapped) mesh against importing the OBJ it came from
+	int CookedMeshLoad();
+	// Meshlet build and CPU cluster culling (normal cone + frustum) on a 1M triangle mesh
+	int Meshlets();
+	// TLSF sub-allocation throughput, utilization and fragmentation under mesh streaming churn
+	int BufferArena();
+	// World matrices per second: glm translate/rotate/scale per object against the SoA scalar, SSE and AVX paths
+	int TransformCompose();
+	// Scene graph update cost for static, partly and fully animated 100K node hierarchies, flat arrays against a pointer tree
+	int SceneGraphUpdate();
+	// Transform update and culled draw extraction over 100K entities: archetype chunks against heap allocated objects
+	int EntityIteration();
+	// Job system overhead (empty jobs, dependency chains) and per frame ECS work as jobs against threads started every frame
+	int JobSystemThroughput();
+	// Recording 16K draws into linear command buffers on one thread against job system workers, bytes per draw and replay walk cost
+	int CommandRecording();
+	// Frame time, hitches and input to frame latency of a serial loop against the simulation and render stages pipelined over 2 and 3 snapshots
+	int FramePipelineLatency();
+	// Per frame transient lists built on the job system: fresh std::vectors against a frame arena, time and heap allocations per frame
+	int FrameAllocations();
+	// CPU light assignment into a 16x9x24 cluster grid for 1 to 4096 point lights: time, index list size and lights looped per fragment
+	int ClusteredLightAssignment();
+	// Normal precision of the G-buffer encodings and G-buffer memory and traffic per resolution, compact against position + normal targets
+	int GBufferBandwidth();
+}
+
+#endif // !_BENCHMARKS_H_
@@ -18,6 +18,17 @@
 #include <cmath>
 
 #include "../texture_utils.h"
+#include "../texture_residency.h"
+#include "../mesh_library.h"
+#include "../vertex_format.h"
+#include "../deferred_shading.h"
+#include "../shadow_cascades.h"
+#include "../gpu_profiler.h"
+#include "../frustum.h"
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <vector>
 
 const unsigned int SCR_WIDTH = 800;
 const unsigned int SCR_HEIGHT = 600;
@@ -96,208 +107,135 @@ namespace tutorials::lighting
         glEnable(GL_DEPTH_TEST); // enable depth-testing
         //glDepthFunc(GL_LESS);		 // depth-testing interprets a smaller value as "closer"
 
-        // ====================
-        // VBO - VAO GENERATION
-        // ====================
-        // 1. Vertex data for positions, colors and texture coordinates
-        GLfloat vertices[] = {
-            // coords          
-            -0.5f, -0.5f, -0.5f,
-             0.5f, -0.5f, -0.5f,
-             0.5f,  0.5f, -0.5f,
-             0.5f,  0.5f, -0.5f,
-            -0.5f,  0.5f, -0.5f,
-            -0.5f, -0.5f, -0.5f,
-
-            -0.5f, -0.5f,  0.5f,
-             0.5f, -0.5f,  0.5f,
-             0.5f,  0.5f,  0.5f,
-             0.5f,  0.5f,  0.5f,
-            -0.5f,  0.5f,  0.5f,
-            -0.5f, -0.5f,  0.5f,
-
-            -0.5f,  0.5f,  0.5f,
-            -0.5f,  0.5f, -0.5f,
-            -0.5f, -0.5f, -0.5f,
-            -0.5f, -0.5f, -0.5f,
-            -0.5f, -0.5f,  0.5f,
-            -0.5f,  0.5f,  0.5f,
-
-             0.5f,  0.5f,  0.5f,
-             0.5f,  0.5f, -0.5f,
-             0.5f, -0.5f, -0.5f,
-             0.5f, -0.5f, -0.5f,
-             0.5f, -0.5f,  0.5f,
-             0.5f,  0.5f,  0.5f,
-
-            -0.5f, -0.5f, -0.5f,
-             0.5f, -0.5f, -0.5f,
-             0.5f, -0.5f,  0.5f,
-             0.5f, -0.5f,  0.5f,
-            -0.5f, -0.5f,  0.5f,
-            -0.5f, -0.5f, -0.5f,
-
-            -0.5f,  0.5f, -0.5f,
-             0.5f,  0.5f, -0.5f,
-             0.5f,  0.5f,  0.5f,
-             0.5f,  0.5f,  0.5f,
-            -0.5f,  0.5f,  0.5f,
-            -0.5f,  0.5f, -0.5f
-        };
-
-        // VBO for the cube
-        GLuint vbo;
-        glGenBuffers(1, &vbo);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-        // Object cube VAO
-        GLuint object_cube_vao;
-        glGenVertexArrays(1, &object_cube_vao);
-        glBindVertexArray(object_cube_vao);
-
-        // Bind the cube vbo to object cube VAO
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (GLvoid*)0);
-        glEnableVertexAttribArray(0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-        // Light source cube vao
-        GLuint light_source_cube_vao;
-        glGenVertexArrays(1, &light_source_cube_vao);
-        glBindVertexArray(light_source_cube_vao);
-
-        // Bind the cube vbo to light source cube VAO
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (GLvoid*)0);
-        glEnableVertexAttribArray(0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-
-        // ====================
-        //      SHADERS
-        // ====================
-        // object cube shader
-        const char* object_cube_vertex_shader_src =
-            "#version 330 core\n"
-            "layout (location = 0) in vec3 vertex_position;\n"
-            "uniform mat4 model_matrix;\n"
-            "uniform mat4 view_matrix;\n"
-            "uniform mat4 projection_matrix;\n"
-            "void main()\n"
-            "{\n"
-            "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
-            "}\0";
-
-        // 9. Fragment shader setup
-        const char* object_cube_fragment_shader_src =
-            "#version 330 core\n"
-            "uniform vec3 objectColor;\n"
-            "uniform vec3 lightColor;\n"
-            "out vec4 frag_color;\n"
-            "void main()\n"
-            "{\n"
-            "   frag_color = vec4(lightColor * objectColor, 1.0);\n"
-            "}\0";
-
-        auto object_cube_shader = ShaderProgram(object_cube_vertex_shader_src, ShaderSourceType::Text,
-            object_cube_fragment_shader_src, ShaderSourceType::Text);
-
-        // ligth source cube shader
-        const char* light_source_cube_vertex_shader_src =
-            "#version 330 core\n"
-            "layout (location = 0) in vec3 vertex_position;\n"
-            "uniform mat4 model_matrix;\n"
-            "uniform mat4 view_matrix;\n"
-            "uniform mat4 projection_matrix;\n"
-            "void main()\n"
-            "{\n"
-            "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
-            "}\0";
-
-        const char* light_source_cube_fragment_shader_src =
-            "#version 330 core\n"
-            "out vec4 frag_color;\n"
-            "void main()\n"
-            "{\n"
-            "   frag_color = vec4(1.0);\n"
-            "}\0";
-
-        auto light_source_cube_shader = ShaderProgram(light_source_cube_vertex_shader_src, ShaderSourceType::Text,
-            light_source_cube_fragment_shader_src, ShaderSourceType::Text);
-
-
-        // ====================
-        //  TRANSFORMATION SETUP
-        // ====================
-        glm::mat4 identity_matrix = glm::mat4(1.0f);
-        
-
-        // ====================
-        //      MAIN UI LOOP
-        // ====================
-        /* Loop until the user closes the window */
-        while (!glfwWindowShouldClose(window))
+        // Everything owning GL objects lives in this block, so it is destroyed before glfwTerminate()
         {
-            // fps counter
-            Utility::GLFW::update_fps_counter(window);
-
-            // per-frame time logic
-            // --------------------
-            float currentFrame = glfwGetTime();
-            deltaTime = currentFrame - lastFrame;
-            lastFrame = currentFrame;
-
-            // input
-            // -----
-            processInput(window);
-
-            /* Render here */
-            glClearColor(0.1f, 0.1f, 0.1f, 1.0f);// scene background color
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-            glm::mat4 view_matrix = camera.GetViewMatrix();
-            glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
-            glm::mat4 model_matrix = identity_matrix;
-
-            // render object cube
-            object_cube_shader.use();
-            object_cube_shader.setVec3("objectColor", 1.0f, 0.5f, 0.31f);
-            object_cube_shader.setVec3("lightColor", 1.0f, 1.0f, 1.0f);
-
-            object_cube_shader.setMat4("model_matrix", model_matrix);
-            object_cube_shader.setMat4("view_matrix", view_matrix);
-            object_cube_shader.setMat4("projection_matrix", projection_matrix);
-
-            glBindVertexArray(object_cube_vao);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
-
-            // render light source cube
-            light_source_cube_shader.use();
-            light_source_cube_shader.setMat4("view_matrix", view_matrix);
-            light_source_cube_shader.setMat4("projection_matrix", projection_matrix);
-            model_matrix = identity_matrix;
-            glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
-            model_matrix = glm::translate(model_matrix, lightPos);
-            model_matrix = glm::scale(model_matrix, glm::vec3(0.2f)); // a smaller cube
-            light_source_cube_shader.setMat4("model_matrix", model_matrix);
-
-            glBindVertexArray(light_source_cube_vao);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
-
-            /* Swap front and back buffers */
-            /* update other events like input handling */
-            glfwSwapBuffers(window);
-
-            /* Poll for and process events */
-            /* put the stuff we've been drawing onto the display */
-            glfwPollEvents();
+            // ====================
+            //      MESHES
+            // ====================
+            // The object and the light source draw the same cube from the mesh library
+            Utility::mesh::MeshLibrary meshes;
+            Utility::mesh::MeshHandle cube = meshes.Get(Utility::mesh::Primitive::Cube, Utility::mesh::Position);
+
+
+            // ====================
+            //      SHADERS
+            // ====================
+            // object cube shader
+            const char* object_cube_vertex_shader_src =
+                "#version 330 core\n"
+                "layout (location = 0) in vec3 vertex_position;\n"
+                "uniform mat4 model_matrix;\n"
+                "uniform mat4 view_matrix;\n"
+                "uniform mat4 projection_matrix;\n"
+                "void main()\n"
+                "{\n"
+                "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
+                "}\0";
+
+            // 9. Fragment shader setup
+            const char* object_cube_fragment_shader_src =
+                "#version 330 core\n"
+                "uniform vec3 objectColor;\n"
+                "uniform vec3 lightColor;\n"
+                "out vec4 frag_color;\n"
+                "void main()\n"
+                "{\n"
+                "   frag_color = vec4(lightColor * objectColor, 1.0);\n"
+                "}\0";
+
+            auto object_cube_shader = ShaderProgram(object_cube_vertex_shader_src, ShaderSourceType::Text,
+                object_cube_fragment_shader_src, ShaderSourceType::Text);
+
+            // ligth source cube shader
+            const char* light_source_cube_vertex_shader_src =
+                "#version 330 core\n"
+                "layout (location = 0) in vec3 vertex_position;\n"
+                "uniform mat4 model_matrix;\n"
+                "uniform mat4 view_matrix;\n"
+                "uniform mat4 projection_matrix;\n"
+                "void main()\n"
+                "{\n"
+                "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
+                "}\0";
+
+            const char* light_source_cube_fragment_shader_src =
+                "#version 330 core\n"
+                "out vec4 frag_color;\n"
+                "void main()\n"
+                "{\n"
+                "   frag_color = vec4(1.0);\n"
+                "}\0";
+
+            auto light_source_cube_shader = ShaderProgram(light_source_cube_vertex_shader_src, ShaderSourceType::Text,
+                light_source_cube_fragment_shader_src, ShaderSourceType::Text);
+
+
+            // ====================
+            //  TRANSFORMATION SETUP
+            // ====================
+            glm::mat4 identity_matrix = glm::mat4(1.0f);
+
+
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            /* Loop until the user closes the window */
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+
+                // per-frame time logic
+                // --------------------
+                float currentFrame = glfwGetTime();
+                deltaTime = currentFrame - lastFrame;
+                lastFrame = currentFrame;
+
+                // input
+                // -----
+                processInput(window);
+
+                /* Render here */
+                glClearColor(0.1f, 0.1f, 0.1f, 1.0f);// scene background color
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                glm::mat4 view_matrix = camera.GetViewMatrix();
+                glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+                glm::mat4 model_matrix = identity_matrix;
+
+                // render object cube
+                object_cube_shader.use();
+                object_cube_shader.setVec3("objectColor", 1.0f, 0.5f, 0.31f);
+                object_cube_shader.setVec3("lightColor", 1.0f, 1.0f, 1.0f);
+
+                object_cube_shader.setMat4("model_matrix", model_matrix);
+                object_cube_shader.setMat4("view_matrix", view_matrix);
+                object_cube_shader.setMat4("projection_matrix", projection_matrix);
+
+                meshes.Draw(cube);
+
+                // render light source cube
+                light_source_cube_shader.use();
+                light_source_cube_shader.setMat4("view_matrix", view_matrix);
+                light_source_cube_shader.setMat4("projection_matrix", projection_matrix);
+                model_matrix = identity_matrix;
+                glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
+                model_matrix = glm::translate(model_matrix, lightPos);
+                model_matrix = glm::scale(model_matrix, glm::vec3(0.2f)); // a smaller cube
+                light_source_cube_shader.setMat4("model_matrix", model_matrix);
+
+                meshes.Draw(cube);
+
+                /* Swap front and back buffers */
+                /* update other events like input handling */
+                glfwSwapBuffers(window);
+
+                /* Poll for and process events */
+                /* put the stuff we've been drawing onto the display */
+                glfwPollEvents();
+            }
         }
 
-        glDeleteVertexArrays(1, &object_cube_vao);
-        glDeleteVertexArrays(1, &light_source_cube_vao);
-        glDeleteBuffers(1, &vbo);
-
         glfwTerminate();
         return 0;
     }
@@ -319,213 +257,139 @@ namespace tutorials::lighting
         glEnable(GL_DEPTH_TEST); // enable depth-testing
         //glDepthFunc(GL_LESS);		 // depth-testing interprets a smaller value as "closer"
 
-        // ====================
-        // VBO - VAO GENERATION
-        // ====================
-        // 1. Vertex data for positions, colors and texture coordinates
-        GLfloat vertices[] = {
-            // coords          
-            -0.5f, -0.5f, -0.5f,
-             0.5f, -0.5f, -0.5f,
-             0.5f,  0.5f, -0.5f,
-             0.5f,  0.5f, -0.5f,
-            -0.5f,  0.5f, -0.5f,
-            -0.5f, -0.5f, -0.5f,
-
-            -0.5f, -0.5f,  0.5f,
-             0.5f, -0.5f,  0.5f,
-             0.5f,  0.5f,  0.5f,
-             0.5f,  0.5f,  0.5f,
-            -0.5f,  0.5f,  0.5f,
-            -0.5f, -0.5f,  0.5f,
-
-            -0.5f,  0.5f,  0.5f,
-            -0.5f,  0.5f, -0.5f,
-            -0.5f, -0.5f, -0.5f,
-            -0.5f, -0.5f, -0.5f,
-            -0.5f, -0.5f,  0.5f,
-            -0.5f,  0.5f,  0.5f,
-
-             0.5f,  0.5f,  0.5f,
-             0.5f,  0.5f, -0.5f,
-             0.5f, -0.5f, -0.5f,
-             0.5f, -0.5f, -0.5f,
-             0.5f, -0.5f,  0.5f,
-             0.5f,  0.5f,  0.5f,
-
-            -0.5f, -0.5f, -0.5f,
-             0.5f, -0.5f, -0.5f,
-             0.5f, -0.5f,  0.5f,
-             0.5f, -0.5f,  0.5f,
-            -0.5f, -0.5f,  0.5f,
-            -0.5f, -0.5f, -0.5f,
-
-            -0.5f,  0.5f, -0.5f,
-             0.5f,  0.5f, -0.5f,
-             0.5f,  0.5f,  0.5f,
-             0.5f,  0.5f,  0.5f,
-            -0.5f,  0.5f,  0.5f,
-            -0.5f,  0.5f, -0.5f
-        };
-
-        // VBO for the cube
-        GLuint vbo;
-        glGenBuffers(1, &vbo);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-        // Object cube VAO
-        GLuint object_cube_vao;
-        glGenVertexArrays(1, &object_cube_vao);
-        glBindVertexArray(object_cube_vao);
-
-        // Bind the cube vbo to object cube VAO
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (GLvoid*)0);
-        glEnableVertexAttribArray(0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-        // Light source cube vao
-        GLuint light_source_cube_vao;
-        glGenVertexArrays(1, &light_source_cube_vao);
-        glBindVertexArray(light_source_cube_vao);
-
-        // Bind the cube vbo to light source cube VAO
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (GLvoid*)0);
-        glEnableVertexAttribArray(0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-
-        // ====================
-        //      SHADERS
-        // ====================
-        // object cube shader
-        const char* object_cube_vertex_shader_src =
-            "#version 330 core\n"
-            "layout (location = 0) in vec3 vertex_position;\n"
-            "uniform mat4 model_matrix;\n"
-            "uniform mat4 view_matrix;\n"
-            "uniform mat4 projection_matrix;\n"
-            "void main()\n"
-            "{\n"
-            "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
-            "}\0";
-
-        // 9. Fragment shader setup
-        const char* object_cube_fragment_shader_src =
-            "#version 330 core\n"
-            "uniform vec3 objectColor;\n"
-            "uniform vec3 lightColor;\n"
-            "uniform float ambientStrength;\n"
-            "out vec4 frag_color;\n"
-            "void main()\n"
-            "{\n"
-            "   vec3 ambient = ambientStrength * lightColor;\n"
-            "   vec3 result = ambient * objectColor;\n"
-            "   frag_color = vec4(result, 1.0);\n"
-            "}\0";
-
-        auto object_cube_shader = ShaderProgram(object_cube_vertex_shader_src, ShaderSourceType::Text,
-            object_cube_fragment_shader_src, ShaderSourceType::Text);
-
-        // ligth source cube shader
-        const char* light_source_cube_vertex_shader_src =
-            "#version 330 core\n"
-            "layout (location = 0) in vec3 vertex_position;\n"
-            "uniform mat4 model_matrix;\n"
-            "uniform mat4 view_matrix;\n"
-            "uniform mat4 projection_matrix;\n"
-            "void main()\n"
-            "{\n"
-            "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
-            "}\0";
-
-        const char* light_source_cube_fragment_shader_src =
-            "#version 330 core\n"
-            "out vec4 frag_color;\n"
-            "void main()\n"
-            "{\n"
-            "   frag_color = vec4(1.0);\n"
-            "}\0";
-
-        auto light_source_cube_shader = ShaderProgram(light_source_cube_vertex_shader_src, ShaderSourceType::Text,
-            light_source_cube_fragment_shader_src, ShaderSourceType::Text);
-
-
-        // ====================
-        //  TRANSFORMATION SETUP
-        // ====================
-        glm::mat4 identity_matrix = glm::mat4(1.0f);
-
-
-        // ====================
-        //      MAIN UI LOOP
-        // ====================
-        /* Loop until the user closes the window */
-        while (!glfwWindowShouldClose(window))
         {
-            // fps counter
-            Utility::GLFW::update_fps_counter(window);
-
-            // per-frame time logic
-            // --------------------
-            float currentFrame = glfwGetTime();
-            deltaTime = currentFrame - lastFrame;
-            lastFrame = currentFrame;
-
-            // input
-            // -----
-            processInput(window);
-
-            /* Render here */
-            glClearColor(0.1f, 0.1f, 0.1f, 1.0f);// scene background color
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-            glm::mat4 view_matrix = camera.GetViewMatrix();
-            glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
-            glm::mat4 model_matrix = identity_matrix;
-
-            // render object cube
-            object_cube_shader.use();
-            object_cube_shader.setVec3("objectColor", 1.0f, 0.5f, 0.31f);
-            object_cube_shader.setVec3("lightColor", 1.0f, 1.0f, 1.0f);
-            float ambientStrength = dynamic ? currentFrame : 0.3;
-            object_cube_shader.setFloat("ambientStrength", ambientStrength);
-
-            object_cube_shader.setMat4("model_matrix", model_matrix);
-            object_cube_shader.setMat4("view_matrix", view_matrix);
-            object_cube_shader.setMat4("projection_matrix", projection_matrix);
-
-            glBindVertexArray(object_cube_vao);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
-
-            // render light source cube
-            light_source_cube_shader.use();
-            light_source_cube_shader.setMat4("view_matrix", view_matrix);
-            light_source_cube_shader.setMat4("projection_matrix", projection_matrix);
-            model_matrix = identity_matrix;
-            glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
-            model_matrix = glm::translate(model_matrix, lightPos);
-            model_matrix = glm::scale(model_matrix, glm::vec3(0.2f)); // a smaller cube
-            light_source_cube_shader.setMat4("model_matrix", model_matrix);
-
-            glBindVertexArray(light_source_cube_vao);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
-
-            /* Swap front and back buffers */
-            /* update other events like input handling */
-            glfwSwapBuffers(window);
-
-            /* Poll for and process events */
-            /* put the stuff we've been drawing onto the display */
-            glfwPollEvents();
+            // ====================
+            //      MESHES
+            // ====================
+            // The object and the light source draw the same cube from the mesh library
+            Utility::mesh::MeshLibrary meshes;
+            Utility::mesh::MeshHandle cube = meshes.Get(Utility::mesh::Primitive::Cube, Utility::mesh::Position);
+
+
+            // ====================
+            //      SHADERS
+            // ====================
+            // object cube shader
+            const char* object_cube_vertex_shader_src =
+                "#version 330 core\n"
+                "layout (location = 0) in vec3 vertex_position;\n"
+                "uniform mat4 model_matrix;\n"
+                "uniform mat4 view_matrix;\n"
+                "uniform mat4 projection_matrix;\n"
+                "void main()\n"
+                "{\n"
+                "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
+                "}\0";
+
+            // 9. Fragment shader setup
+            const char* object_cube_fragment_shader_src =
+                "#version 330 core\n"
+                "uniform vec3 objectColor;\n"
+                "uniform vec3 lightColor;\n"
+                "uniform float ambientStrength;\n"
+                "out vec4 frag_color;\n"
+                "void main()\n"
+                "{\n"
+                "   vec3 ambient = ambientStrength * lightColor;\n"
+                "   vec3 result = ambient * objectColor;\n"
+                "   frag_color = vec4(result, 1.0);\n"
+                "}\0";
+
+            auto object_cube_shader = ShaderProgram(object_cube_vertex_shader_src, ShaderSourceType::Text,
+                object_cube_fragment_shader_src, ShaderSourceType::Text);
+
+            // ligth source cube shader
+            const char* light_source_cube_vertex_shader_src =
+                "#version 330 core\n"
+                "layout (location = 0) in vec3 vertex_position;\n"
+                "uniform mat4 model_matrix;\n"
+                "uniform mat4 view_matrix;\n"
+                "uniform mat4 projection_matrix;\n"
+                "void main()\n"
+                "{\n"
+                "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
+                "}\0";
+
+            const char* light_source_cube_fragment_shader_src =
+                "#version 330 core\n"
+                "out vec4 frag_color;\n"
+                "void main()\n"
+                "{\n"
+                "   frag_color = vec4(1.0);\n"
+                "}\0";
+
+            auto light_source_cube_shader = ShaderProgram(light_source_cube_vertex_shader_src, ShaderSourceType::Text,
+                light_source_cube_fragment_shader_src, ShaderSourceType::Text);
+
+
+            // ====================
+            //  TRANSFORMATION SETUP
+            // ====================
+            glm::mat4 identity_matrix = glm::mat4(1.0f);
+
+
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            /* Loop until the user closes the window */
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+
+                // per-frame time logic
+                // --------------------
+                float currentFrame = glfwGetTime();
+                deltaTime = currentFrame - lastFrame;
+                lastFrame = currentFrame;
+
+                // input
+                // -----
+                processInput(window);
+
+                /* Render here */
+                glClearColor(0.1f, 0.1f, 0.1f, 1.0f);// scene background color
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                glm::mat4 view_matrix = camera.GetViewMatrix();
+                glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+                glm::mat4 model_matrix = identity_matrix;
+
+                // render object cube
+                object_cube_shader.use();
+                object_cube_shader.setVec3("objectColor", 1.0f, 0.5f, 0.31f);
+                object_cube_shader.setVec3("lightColor", 1.0f, 1.0f, 1.0f);
+                float ambientStrength = dynamic ? currentFrame : 0.3;
+                object_cube_shader.setFloat("ambientStrength", ambientStrength);
+
+                object_cube_shader.setMat4("model_matrix", model_matrix);
+                object_cube_shader.setMat4("view_matrix", view_matrix);
+                object_cube_shader.setMat4("projection_matrix", projection_matrix);
+
+                meshes.Draw(cube);
+
+                // render light source cube
+                light_source_cube_shader.use();
+                light_source_cube_shader.setMat4("view_matrix", view_matrix);
+                light_source_cube_shader.setMat4("projection_matrix", projection_matrix);
+                model_matrix = identity_matrix;
+                glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
+                model_matrix = glm::translate(model_matrix, lightPos);
+                model_matrix = glm::scale(model_matrix, glm::vec3(0.2f)); // a smaller cube
+                light_source_cube_shader.setMat4("model_matrix", model_matrix);
+
+                meshes.Draw(cube);
+
+                /* Swap front and back buffers */
+                /* update other events like input handling */
+                glfwSwapBuffers(window);
+
+                /* Poll for and process events */
+                /* put the stuff we've been drawing onto the display */
+                glfwPollEvents();
+            }
         }
 
-        glDeleteVertexArrays(1, &object_cube_vao);
-        glDeleteVertexArrays(1, &light_source_cube_vao);
-        glDeleteBuffers(1, &vbo);
-
         glfwTerminate();
         return 0;
     }
@@ -547,236 +411,157 @@ namespace tutorials::lighting
         glEnable(GL_DEPTH_TEST); // enable depth-testing
         //glDepthFunc(GL_LESS);		 // depth-testing interprets a smaller value as "closer"
 
-        // ====================
-        // VBO - VAO GENERATION
-        // ====================
-        // 1. Vertex data for positions, colors and texture coordinates
-        GLfloat vertices[] = {
-            // coords             // normals
-            -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-             0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-             0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-             0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-            -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-            -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-
-            -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-             0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-            -0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-            -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-
-            -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,
-            -0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,
-            -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,
-            -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,
-            -0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,
-            -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,
-
-             0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,
-             0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,
-             0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,
-             0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,
-             0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,
-             0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,
-
-            -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,
-             0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,
-             0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,
-             0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,
-            -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,
-            -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,
-
-            -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,
-             0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,
-            -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,
-            -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f
-        };
-
-        // VBO for the cube
-        GLuint vbo;
-        glGenBuffers(1, &vbo);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-        // Object cube VAO
-        GLuint object_cube_vao;
-        glGenVertexArrays(1, &object_cube_vao);
-        glBindVertexArray(object_cube_vao);
-
-        // Bind the cube vbo to object cube VAO
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        // coords
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)0);
-        glEnableVertexAttribArray(0);
-        // normals
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
-        glEnableVertexAttribArray(1);
-        glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-        // Light source cube vao
-        GLuint light_source_cube_vao;
-        glGenVertexArrays(1, &light_source_cube_vao);
-        glBindVertexArray(light_source_cube_vao);
-
-        // Bind the cube vbo to light source cube VAO
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)0);
-        glEnableVertexAttribArray(0);
-        // no need for normals in the light source
-        glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-        // ====================
-        //      SHADERS
-        // ====================
-        // object cube shader
-        const char* object_cube_vertex_shader_src =
-            "#version 330 core\n"
-            "layout (location = 0) in vec3 vertex_position;\n"
-            "layout (location = 1) in vec3 vertex_normal;\n"
-            "uniform mat4 model_matrix;\n"
-            "uniform mat4 view_matrix;\n"
-            "uniform mat4 projection_matrix;\n"
-            "out vec3 frag_position;\n"
-            "out vec3 frag_normal;\n"
-            "void main()\n"
-            "{\n"
-            "   frag_position = vec3(model_matrix * vec4(vertex_position, 1.0));\n"
-            "   frag_normal = vertex_normal;\n"
-            "   gl_Position = projection_matrix * view_matrix * vec4(frag_position, 1.0);\n"
-            "}\0";
-
-        // 9. Fragment shader setup
-        const char* object_cube_fragment_shader_src =
-            "#version 330 core\n"
-            "in vec3 frag_position;\n"
-            "in vec3 frag_normal;\n"
-            "uniform vec3 objectColor;\n"
-            "uniform vec3 lightPos;\n"
-            "uniform vec3 lightColor;\n"
-            "uniform float ambientStrength;\n"
-            "out vec4 frag_color;\n"
-            "void main()\n"
-            "{\n"
-            "   vec3 normalized_frag_normal = normalize(frag_normal);\n"
-            "   vec3 dir_vector_from_light_source_to_fragment = normalize(lightPos - frag_position);\n"
-            "   float cosine_angle = dot(normalized_frag_normal, dir_vector_from_light_source_to_fragment);\n"
-            "   cosine_angle = max(cosine_angle, 0.0);\n"
-            "   vec3 diffuse = cosine_angle * lightColor;\n"
-            "   vec3 ambient = ambientStrength * lightColor;\n"
-            "   vec3 resulting_color = (ambient + diffuse) * objectColor;\n"
-            "   frag_color = vec4(resulting_color, 1.0);\n"
-            "}\0";
-
-        auto object_cube_shader = ShaderProgram(object_cube_vertex_shader_src, ShaderSourceType::Text,
-            object_cube_fragment_shader_src, ShaderSourceType::Text);
-
-        // ligth source cube shader
-        const char* light_source_cube_vertex_shader_src =
-            "#version 330 core\n"
-            "layout (location = 0) in vec3 vertex_position;\n"
-            "uniform mat4 model_matrix;\n"
-            "uniform mat4 view_matrix;\n"
-            "uniform mat4 projection_matrix;\n"
-            "void main()\n"
-            "{\n"
-            "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
-            "}\0";
-
-        const char* light_source_cube_fragment_shader_src =
-            "#version 330 core\n"
-            "out vec4 frag_color;\n"
-            "void main()\n"
-            "{\n"
-            "   frag_color = vec4(1.0);\n"
-            "}\0";
-
-        auto light_source_cube_shader = ShaderProgram(light_source_cube_vertex_shader_src, ShaderSourceType::Text,
-            light_source_cube_fragment_shader_src, ShaderSourceType::Text);
-
-
-        // ====================
-        //  TRANSFORMATION SETUP
-        // ====================
-        glm::mat4 identity_matrix = glm::mat4(1.0f);
-        // ====================
-        //  LIGHTING SETUP
-        // ====================
-        glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
-
-
-        // ====================
-        //      MAIN UI LOOP
-        // ====================
-        /* Loop until the user closes the window */
-        while (!glfwWindowShouldClose(window))
         {
-            // fps counter
-            Utility::GLFW::update_fps_counter(window);
-
-            // per-frame time logic
-            // --------------------
-            float currentFrame = glfwGetTime();
-            deltaTime = currentFrame - lastFrame;
-            lastFrame = currentFrame;
-
-            // input
-            // -----
-            processInput(window);
-
-            /* Render here */
-            glClearColor(0.1f, 0.1f, 0.1f, 1.0f);// scene background color
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-            glm::mat4 view_matrix = camera.GetViewMatrix();
-            glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
-            glm::mat4 model_matrix = identity_matrix;
-
-            // render object cube
-            object_cube_shader.use();
-            object_cube_shader.setVec3("objectColor", 1.0f, 0.5f, 0.31f);
-            object_cube_shader.setVec3("lightColor", 1.0f, 1.0f, 1.0f);
-            object_cube_shader.setVec3("lightPos", lightPos);
-
-            float ambientStrength = dynamic ? currentFrame : 0.1;
-            object_cube_shader.setFloat("ambientStrength", ambientStrength);
-
-            object_cube_shader.setMat4("model_matrix", model_matrix);
-            object_cube_shader.setMat4("view_matrix", view_matrix);
-            object_cube_shader.setMat4("projection_matrix", projection_matrix);
-
-            glBindVertexArray(object_cube_vao);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
-
-            // render light source cube
-            light_source_cube_shader.use();
-            light_source_cube_shader.setMat4("view_matrix", view_matrix);
-            light_source_cube_shader.setMat4("projection_matrix", projection_matrix);
-
-            model_matrix = identity_matrix;            
-            model_matrix = glm::translate(model_matrix, lightPos);
-            model_matrix = glm::scale(model_matrix, glm::vec3(0.2f)); // a smaller cube
-            light_source_cube_shader.setMat4("model_matrix", model_matrix);
-
-            glBindVertexArray(light_source_cube_vao);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
+            // ====================
+            //      MESHES
+            // ====================
+            // The object and the light source draw the same cube from the mesh library
+            Utility::mesh::MeshLibrary meshes;
+            Utility::mesh::MeshHandle cube = meshes.Get(Utility::mesh::Primitive::Cube, Utility::mesh::Position | Utility::mesh::Normal);
+
+            // ====================
+            //      SHADERS
+            // ====================
+            // object cube shader
+            const char* object_cube_vertex_shader_src =
+                "#version 330 core\n"
+                "layout (location = 0) in vec3 vertex_position;\n"
+                "layout (location = 1) in vec3 vertex_normal;\n"
+                "uniform mat4 model_matrix;\n"
+                "uniform mat4 view_matrix;\n"
+                "uniform mat4 projection_matrix;\n"
+                "out vec3 frag_position;\n"
+                "out vec3 frag_normal;\n"
+                "void main()\n"
+                "{\n"
+                "   frag_position = vec3(model_matrix * vec4(vertex_position, 1.0));\n"
+                "   frag_normal = vertex_normal;\n"
+                "   gl_Position = projection_matrix * view_matrix * vec4(frag_position, 1.0);\n"
+                "}\0";
+
+            // 9. Fragment shader setup
+            const char* object_cube_fragment_shader_src =
+                "#version 330 core\n"
+                "in vec3 frag_position;\n"
+                "in vec3 frag_normal;\n"
+                "uniform vec3 objectColor;\n"
+                "uniform vec3 lightPos;\n"
+                "uniform vec3 lightColor;\n"
+                "uniform float ambientStrength;\n"
+                "out vec4 frag_color;\n"
+                "void main()\n"
+                "{\n"
+                "   vec3 normalized_frag_normal = normalize(frag_normal);\n"
+                "   vec3 dir_vector_from_light_source_to_fragment = normalize(lightPos - frag_position);\n"
+                "   float cosine_angle = dot(normalized_frag_normal, dir_vector_from_light_source_to_fragment);\n"
+                "   cosine_angle = max(cosine_angle, 0.0);\n"
+                "   vec3 diffuse = cosine_angle * lightColor;\n"
+                "   vec3 ambient = ambientStrength * lightColor;\n"
+                "   vec3 resulting_color = (ambient + diffuse) * objectColor;\n"
+                "   frag_color = vec4(resulting_color, 1.0);\n"
+                "}\0";
+
+            auto object_cube_shader = ShaderProgram(object_cube_vertex_shader_src, ShaderSourceType::Text,
+                object_cube_fragment_shader_src, ShaderSourceType::Text);
+
+            // ligth source cube shader
+            const char* light_source_cube_vertex_shader_src =
+                "#version 330 core\n"
+                "layout (location = 0) in vec3 vertex_position;\n"
+                "uniform mat4 model_matrix;\n"
+                "uniform mat4 view_matrix;\n"
+                "uniform mat4 projection_matrix;\n"
+                "void main()\n"
+                "{\n"
+                "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
+                "}\0";
+
+            const char* light_source_cube_fragment_shader_src =
+                "#version 330 core\n"
+                "out vec4 frag_color;\n"
+                "void main()\n"
+                "{\n"
+                "   frag_color = vec4(1.0);\n"
+                "}\0";
+
+            auto light_source_cube_shader = ShaderProgram(light_source_cube_vertex_shader_src, ShaderSourceType::Text,
+                light_source_cube_fragment_shader_src, ShaderSourceType::Text);
+
+
+            // ====================
+            //  TRANSFORMATION SETUP
+            // ====================
+            glm::mat4 identity_matrix = glm::mat4(1.0f);
+            // ====================
+            //  LIGHTING SETUP
+            // ====================
+            glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
 
-            /* Swap front and back buffers */
-            /* update other events like input handling */
-            glfwSwapBuffers(window);
 
-            /* Poll for and process events */
-            /* put the stuff we've been drawing onto the display */
-            glfwPollEvents();
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            /* Loop until the user closes the window */
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+
+                // per-frame time logic
+                // --------------------
+                float currentFrame = glfwGetTime();
+                deltaTime = currentFrame - lastFrame;
+                lastFrame = currentFrame;
+
+                // input
+                // -----
+                processInput(window);
+
+                /* Render here */
+                glClearColor(0.1f, 0.1f, 0.1f, 1.0f);// scene background color
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                glm::mat4 view_matrix = camera.GetViewMatrix();
+                glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+                glm::mat4 model_matrix = identity_matrix;
+
+                // render object cube
+                object_cube_shader.use();
+                object_cube_shader.setVec3("objectColor", 1.0f, 0.5f, 0.31f);
+                object_cube_shader.setVec3("lightColor", 1.0f, 1.0f, 1.0f);
+                object_cube_shader.setVec3("lightPos", lightPos);
+
+                float ambientStrength = dynamic ? currentFrame : 0.1;
+                object_cube_shader.setFloat("ambientStrength", ambientStrength);
+
+                object_cube_shader.setMat4("model_matrix", model_matrix);
+                object_cube_shader.setMat4("view_matrix", view_matrix);
+                object_cube_shader.setMat4("projection_matrix", projection_matrix);
+
+                meshes.Draw(cube);
+
+                // render light source cube
+                light_source_cube_shader.use();
+                light_source_cube_shader.setMat4("view_matrix", view_matrix);
+                light_source_cube_shader.setMat4("projection_matrix", projection_matrix);
+
+                model_matrix = identity_matrix;            
+                model_matrix = glm::translate(model_matrix, lightPos);
+                model_matrix = glm::scale(model_matrix, glm::vec3(0.2f)); // a smaller cube
+                light_source_cube_shader.setMat4("model_matrix", model_matrix);
+
+                meshes.Draw(cube);
+
+                /* Swap front and back buffers */
+                /* update other events like input handling */
+                glfwSwapBuffers(window);
+
+                /* Poll for and process events */
+                /* put the stuff we've been drawing onto the display */
+                glfwPollEvents();
+            }
         }
 
-        glDeleteVertexArrays(1, &object_cube_vao);
-        glDeleteVertexArrays(1, &light_source_cube_vao);
-        glDeleteBuffers(1, &vbo);
-
         glfwTerminate();
         return 0;
     }
@@ -798,246 +583,167 @@ namespace tutorials::lighting
         glEnable(GL_DEPTH_TEST); // enable depth-testing
         //glDepthFunc(GL_LESS);		 // depth-testing interprets a smaller value as "closer"
 
-        // ====================
-        // VBO - VAO GENERATION
-        // ====================
-        // 1. Vertex data for positions, colors and texture coordinates
-        GLfloat vertices[] = {
-            // coords             // normals
-            -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-             0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-             0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-             0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-            -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-            -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-
-            -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-             0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-            -0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-            -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-
-            -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,
-            -0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,
-            -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,
-            -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,
-            -0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,
-            -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,
-
-             0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,
-             0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,
-             0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,
-             0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,
-             0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,
-             0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,
-
-            -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,
-             0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,
-             0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,
-             0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,
-            -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,
-            -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,
-
-            -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,
-             0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,
-            -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,
-            -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f
-        };
-
-        // VBO for the cube
-        GLuint vbo;
-        glGenBuffers(1, &vbo);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-        // Object cube VAO
-        GLuint object_cube_vao;
-        glGenVertexArrays(1, &object_cube_vao);
-        glBindVertexArray(object_cube_vao);
-
-        // Bind the cube vbo to object cube VAO
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        // coords
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)0);
-        glEnableVertexAttribArray(0);
-        // normals
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
-        glEnableVertexAttribArray(1);
-        glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-        // Light source cube vao
-        GLuint light_source_cube_vao;
-        glGenVertexArrays(1, &light_source_cube_vao);
-        glBindVertexArray(light_source_cube_vao);
-
-        // Bind the cube vbo to light source cube VAO
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)0);
-        glEnableVertexAttribArray(0);
-        // no need for normals in the light source
-        glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-        // ====================
-        //      SHADERS
-        // ====================
-        // object cube shader
-        const char* object_cube_vertex_shader_src =
-            "#version 330 core\n"
-            "layout (location = 0) in vec3 vertex_position;\n"
-            "layout (location = 1) in vec3 vertex_normal;\n"
-            "uniform mat4 model_matrix;\n"
-            "uniform mat4 view_matrix;\n"
-            "uniform mat4 projection_matrix;\n"
-            "out vec3 frag_position;\n"
-            "out vec3 frag_normal;\n"
-            "void main()\n"
-            "{\n"
-            "   frag_position = vec3(model_matrix * vec4(vertex_position, 1.0));\n"
-            "   frag_normal = mat3(transpose(inverse(model_matrix))) * vertex_normal; \n"
-            "   gl_Position = projection_matrix * view_matrix * vec4(frag_position, 1.0);\n"
-            "}\0";
-
-        // 9. Fragment shader setup
-        const char* object_cube_fragment_shader_src =
-            "#version 330 core\n"
-            "in vec3 frag_position;\n"
-            "in vec3 frag_normal;\n"
-            "uniform vec3 objectColor;\n"
-            "uniform vec3 camera_position;\n"
-            "uniform vec3 lightPos;\n"
-            "uniform vec3 lightColor;\n"
-            "uniform float ambientStrength;\n"
-            "out vec4 frag_color;\n"
-            "void main()\n"
-            "{\n"
-            "   vec3 normalized_frag_normal = normalize(frag_normal);\n"//diffuse
-            "   vec3 dir_vector_from_light_source_to_fragment = normalize(lightPos - frag_position);\n"
-            "   float cosine_angle = dot(normalized_frag_normal, dir_vector_from_light_source_to_fragment);\n"
-            "   cosine_angle = max(cosine_angle, 0.0);\n"
-            "   vec3 diffuse = cosine_angle * lightColor;\n"
-            "   float specularStrength = 0.5;\n" //specular
-            "   vec3 dir_vec_from_camera_pos_to_fragment = normalize(camera_position - frag_position);\n"
-            "   vec3 reflection_vec = reflect(-dir_vector_from_light_source_to_fragment, normalized_frag_normal);\n"
-            "   float cosine_angle2 = dot(dir_vec_from_camera_pos_to_fragment, reflection_vec);\n"
-            "   cosine_angle2 = max(cosine_angle2, 0.0);\n"
-            "   int shininess = 32;\n"
-            "   float specular_scalar = pow(cosine_angle2, shininess);\n"
-            "   vec3 specular = specularStrength * specular_scalar * lightColor;\n"
-            "   vec3 ambient = ambientStrength * lightColor;\n" //ambient
-            "   vec3 resulting_color = (ambient + diffuse + specular) * objectColor;\n"
-            "   frag_color = vec4(resulting_color, 1.0);\n"
-            "}\0";
-
-        auto object_cube_shader = ShaderProgram(object_cube_vertex_shader_src, ShaderSourceType::Text,
-            object_cube_fragment_shader_src, ShaderSourceType::Text);
-
-        // ligth source cube shader
-        const char* light_source_cube_vertex_shader_src =
-            "#version 330 core\n"
-            "layout (location = 0) in vec3 vertex_position;\n"
-            "uniform mat4 model_matrix;\n"
-            "uniform mat4 view_matrix;\n"
-            "uniform mat4 projection_matrix;\n"
-            "void main()\n"
-            "{\n"
-            "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
-            "}\0";
-
-        const char* light_source_cube_fragment_shader_src =
-            "#version 330 core\n"
-            "out vec4 frag_color;\n"
-            "void main()\n"
-            "{\n"
-            "   frag_color = vec4(1.0);\n"
-            "}\0";
-
-        auto light_source_cube_shader = ShaderProgram(light_source_cube_vertex_shader_src, ShaderSourceType::Text,
-            light_source_cube_fragment_shader_src, ShaderSourceType::Text);
-
-
-        // ====================
-        //  TRANSFORMATION SETUP
-        // ====================
-        glm::mat4 identity_matrix = glm::mat4(1.0f);
-        // ====================
-        //  LIGHTING SETUP
-        // ====================
-        glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
-
-
-        // ====================
-        //      MAIN UI LOOP
-        // ====================
-        /* Loop until the user closes the window */
-        while (!glfwWindowShouldClose(window))
         {
-            // fps counter
-            Utility::GLFW::update_fps_counter(window);
-
-            // per-frame time logic
-            // --------------------
-            float currentFrame = glfwGetTime();
-            deltaTime = currentFrame - lastFrame;
-            lastFrame = currentFrame;
-
-            // input
-            // -----
-            processInput(window);
-
-            /* Render here */
-            glClearColor(0.1f, 0.1f, 0.1f, 1.0f);// scene background color
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-            glm::mat4 view_matrix = camera.GetViewMatrix();
-            glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
-            glm::mat4 model_matrix = identity_matrix;
-
-            // render object cube
-            object_cube_shader.use();
-            object_cube_shader.setVec3("objectColor", 1.0f, 0.5f, 0.31f);
-            object_cube_shader.setVec3("lightColor", 1.0f, 1.0f, 1.0f);
-            object_cube_shader.setVec3("lightPos", lightPos);
-            object_cube_shader.setVec3("camera_position", camera.Position);
-
-            float ambientStrength = dynamic ? currentFrame : 0.1;
-            object_cube_shader.setFloat("ambientStrength", ambientStrength);
-
-            object_cube_shader.setMat4("model_matrix", model_matrix);
-            object_cube_shader.setMat4("view_matrix", view_matrix);
-            object_cube_shader.setMat4("projection_matrix", projection_matrix);
-
-            glBindVertexArray(object_cube_vao);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
-
-            // render light source cube
-            light_source_cube_shader.use();
-            light_source_cube_shader.setMat4("view_matrix", view_matrix);
-            light_source_cube_shader.setMat4("projection_matrix", projection_matrix);
-
-            model_matrix = identity_matrix;
-            model_matrix = glm::translate(model_matrix, lightPos);
-            model_matrix = glm::scale(model_matrix, glm::vec3(0.2f)); // a smaller cube
-            light_source_cube_shader.setMat4("model_matrix", model_matrix);
-
-            glBindVertexArray(light_source_cube_vao);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
+            // ====================
+            //      MESHES
+            // ====================
+            // The object and the light source draw the same cube from the mesh library
+            Utility::mesh::MeshLibrary meshes;
+            Utility::mesh::MeshHandle cube = meshes.Get(Utility::mesh::Primitive::Cube, Utility::mesh::Position | Utility::mesh::Normal);
+
+            // ====================
+            //      SHADERS
+            // ====================
+            // object cube shader
+            const char* object_cube_vertex_shader_src =
+                "#version 330 core\n"
+                "layout (location = 0) in vec3 vertex_position;\n"
+                "layout (location = 1) in vec3 vertex_normal;\n"
+                "uniform mat4 model_matrix;\n"
+                "uniform mat4 view_matrix;\n"
+                "uniform mat4 projection_matrix;\n"
+                "out vec3 frag_position;\n"
+                "out vec3 frag_normal;\n"
+                "void main()\n"
+                "{\n"
+                "   frag_position = vec3(model_matrix * vec4(vertex_position, 1.0));\n"
+                "   frag_normal = mat3(transpose(inverse(model_matrix))) * vertex_normal; \n"
+                "   gl_Position = projection_matrix * view_matrix * vec4(frag_position, 1.0);\n"
+                "}\0";
+
+            // 9. Fragment shader setup
+            const char* object_cube_fragment_shader_src =
+                "#version 330 core\n"
+                "in vec3 frag_position;\n"
+                "in vec3 frag_normal;\n"
+                "uniform vec3 objectColor;\n"
+                "uniform vec3 camera_position;\n"
+                "uniform vec3 lightPos;\n"
+                "uniform vec3 lightColor;\n"
+                "uniform float ambientStrength;\n"
+                "out vec4 frag_color;\n"
+                "void main()\n"
+                "{\n"
+                "   vec3 normalized_frag_normal = normalize(frag_normal);\n"//diffuse
+                "   vec3 dir_vector_from_light_source_to_fragment = normalize(lightPos - frag_position);\n"
+                "   float cosine_angle = dot(normalized_frag_normal, dir_vector_from_light_source_to_fragment);\n"
+                "   cosine_angle = max(cosine_angle, 0.0);\n"
+                "   vec3 diffuse = cosine_angle * lightColor;\n"
+                "   float specularStrength = 0.5;\n" //specular
+                "   vec3 dir_vec_from_camera_pos_to_fragment = normalize(camera_position - frag_position);\n"
+                "   vec3 reflection_vec = reflect(-dir_vector_from_light_source_to_fragment, normalized_frag_normal);\n"
+                "   float cosine_angle2 = dot(dir_vec_from_camera_pos_to_fragment, reflection_vec);\n"
+                "   cosine_angle2 = max(cosine_angle2, 0.0);\n"
+                "   int shininess = 32;\n"
+                "   float specular_scalar = pow(cosine_angle2, shininess);\n"
+                "   vec3 specular = specularStrength * specular_scalar * lightColor;\n"
+                "   vec3 ambient = ambientStrength * lightColor;\n" //ambient
+                "   vec3 resulting_color = (ambient + diffuse + specular) * objectColor;\n"
+                "   frag_color = vec4(resulting_color, 1.0);\n"
+                "}\0";
+
+            auto object_cube_shader = ShaderProgram(object_cube_vertex_shader_src, ShaderSourceType::Text,
+                object_cube_fragment_shader_src, ShaderSourceType::Text);
+
+            // ligth source cube shader
+            const char* light_source_cube_vertex_shader_src =
+                "#version 330 core\n"
+                "layout (location = 0) in vec3 vertex_position;\n"
+                "uniform mat4 model_matrix;\n"
+                "uniform mat4 view_matrix;\n"
+                "uniform mat4 projection_matrix;\n"
+                "void main()\n"
+                "{\n"
+                "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
+                "}\0";
+
+            const char* light_source_cube_fragment_shader_src =
+                "#version 330 core\n"
+                "out vec4 frag_color;\n"
+                "void main()\n"
+                "{\n"
+                "   frag_color = vec4(1.0);\n"
+                "}\0";
+
+            auto light_source_cube_shader = ShaderProgram(light_source_cube_vertex_shader_src, ShaderSourceType::Text,
+                light_source_cube_fragment_shader_src, ShaderSourceType::Text);
+
+
+            // ====================
+            //  TRANSFORMATION SETUP
+            // ====================
+            glm::mat4 identity_matrix = glm::mat4(1.0f);
+            // ====================
+            //  LIGHTING SETUP
+            // ====================
+            glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
 
-            /* Swap front and back buffers */
-            /* update other events like input handling */
-            glfwSwapBuffers(window);
 
-            /* Poll for and process events */
-            /* put the stuff we've been drawing onto the display */
-            glfwPollEvents();
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            /* Loop until the user closes the window */
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+
+                // per-frame time logic
+                // --------------------
+                float currentFrame = glfwGetTime();
+                deltaTime = currentFrame - lastFrame;
+                lastFrame = currentFrame;
+
+                // input
+                // -----
+                processInput(window);
+
+                /* Render here */
+                glClearColor(0.1f, 0.1f, 0.1f, 1.0f);// scene background color
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                glm::mat4 view_matrix = camera.GetViewMatrix();
+                glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+                glm::mat4 model_matrix = identity_matrix;
+
+                // render object cube
+                object_cube_shader.use();
+                object_cube_shader.setVec3("objectColor", 1.0f, 0.5f, 0.31f);
+                object_cube_shader.setVec3("lightColor", 1.0f, 1.0f, 1.0f);
+                object_cube_shader.setVec3("lightPos", lightPos);
+                object_cube_shader.setVec3("camera_position", camera.Position);
+
+                float ambientStrength = dynamic ? currentFrame : 0.1;
+                object_cube_shader.setFloat("ambientStrength", ambientStrength);
+
+                object_cube_shader.setMat4("model_matrix", model_matrix);
+                object_cube_shader.setMat4("view_matrix", view_matrix);
+                object_cube_shader.setMat4("projection_matrix", projection_matrix);
+
+                meshes.Draw(cube);
+
+                // render light source cube
+                light_source_cube_shader.use();
+                light_source_cube_shader.setMat4("view_matrix", view_matrix);
+                light_source_cube_shader.setMat4("projection_matrix", projection_matrix);
+
+                model_matrix = identity_matrix;
+                model_matrix = glm::translate(model_matrix, lightPos);
+                model_matrix = glm::scale(model_matrix, glm::vec3(0.2f)); // a smaller cube
+                light_source_cube_shader.setMat4("model_matrix", model_matrix);
+
+                meshes.Draw(cube);
+
+                /* Swap front and back buffers */
+                /* update other events like input handling */
+                glfwSwapBuffers(window);
+
+                /* Poll for and process events */
+                /* put the stuff we've been drawing onto the display */
+                glfwPollEvents();
+            }
         }
 
-        glDeleteVertexArrays(1, &object_cube_vao);
-        glDeleteVertexArrays(1, &light_source_cube_vao);
-        glDeleteBuffers(1, &vbo);
-
         glfwTerminate();
         return 0;
     }
@@ -1059,182 +765,103 @@ namespace tutorials::lighting
         glEnable(GL_DEPTH_TEST); // enable depth-testing
         //glDepthFunc(GL_LESS);		 // depth-testing interprets a smaller value as "closer"
 
-        // ====================
-        // VBO - VAO GENERATION
-        // ====================
-        // 1. Vertex data for positions, colors and texture coordinates
-        GLfloat vertices[] = {
-            // coords             // normals
-            -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-             0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-             0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-             0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-            -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-            -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-
-            -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-             0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-            -0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-            -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-
-            -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,
-            -0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,
-            -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,
-            -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,
-            -0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,
-            -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,
-
-             0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,
-             0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,
-             0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,
-             0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,
-             0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,
-             0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,
-
-            -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,
-             0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,
-             0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,
-             0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,
-            -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,
-            -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,
-
-            -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,
-             0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,
-            -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,
-            -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f
-        };
-
-        // VBO for the cube
-        GLuint vbo;
-        glGenBuffers(1, &vbo);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-        // Object cube VAO
-        GLuint object_cube_vao;
-        glGenVertexArrays(1, &object_cube_vao);
-        glBindVertexArray(object_cube_vao);
-
-        // Bind the cube vbo to object cube VAO
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        // coords
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)0);
-        glEnableVertexAttribArray(0);
-        // normals
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
-        glEnableVertexAttribArray(1);
-        glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-        // Light source cube vao
-        GLuint light_source_cube_vao;
-        glGenVertexArrays(1, &light_source_cube_vao);
-        glBindVertexArray(light_source_cube_vao);
-
-        // Bind the cube vbo to light source cube VAO
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)0);
-        glEnableVertexAttribArray(0);
-        // no need for normals in the light source
-        glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-        // ====================
-        //      SHADERS
-        // ====================
-        auto object_cube_shader = ShaderProgram(
-            "tutorials\\shaders\\lighting_intro_object_vs.glsl",
-            "tutorials\\shaders\\lighting_intro_object_fs.glsl");
-
-        auto light_source_cube_shader = ShaderProgram(
-            "tutorials\\shaders\\lighting_intro_light_source_vs.glsl",
-            "tutorials\\shaders\\lighting_intro_light_source_fs.glsl");
-
-
-        // ====================
-        //  TRANSFORMATION SETUP
-        // ====================
-        glm::mat4 identity_matrix = glm::mat4(1.0f);
-        // ====================
-        //  LIGHTING SETUP
-        // ====================
-        glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
-
-
-        // ====================
-        //      MAIN UI LOOP
-        // ====================
-        /* Loop until the user closes the window */
-        while (!glfwWindowShouldClose(window))
         {
-            // fps counter
-            Utility::GLFW::update_fps_counter(window);
-
-            // per-frame time logic
-            // --------------------
-            float currentFrame = glfwGetTime();
-            deltaTime = currentFrame - lastFrame;
-            lastFrame = currentFrame;
-
-            // input
-            // -----
-            processInput(window);
-
-            /* Render here */
-            glClearColor(0.1f, 0.1f, 0.1f, 1.0f);// scene background color
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            // ====================
+            //      MESHES
+            // ====================
+            // The object and the light source draw the same cube from the mesh library
+            Utility::mesh::MeshLibrary meshes;
+            Utility::mesh::MeshHandle cube = meshes.Get(Utility::mesh::Primitive::Cube, Utility::mesh::Position | Utility::mesh::Normal);
+
+            // ====================
+            //      SHADERS
+            // ====================
+            auto object_cube_shader = ShaderProgram(
+                "tutorials\\shaders\\lighting_intro_object_vs.glsl",
+                "tutorials\\shaders\\lighting_intro_object_fs.glsl");
+
+            auto light_source_cube_shader = ShaderProgram(
+                "tutorials\\shaders\\lighting_intro_light_source_vs.glsl",
+                "tutorials\\shaders\\lighting_intro_light_source_fs.glsl");
+
+
+            // ====================
+            //  TRANSFORMATION SETUP
+            // ====================
+            glm::mat4 identity_matrix = glm::mat4(1.0f);
+            // ====================
+            //  LIGHTING SETUP
+            // ====================
+            glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
 
-            glm::mat4 view_matrix = camera.GetViewMatrix();
-            glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
-            glm::mat4 model_matrix = identity_matrix;
 
-            // render object cube
-            object_cube_shader.use();
-            object_cube_shader.setVec3("the_object.color", 1.0f, 0.5f, 0.31f);
-            object_cube_shader.setFloat("the_object.specular_strength", 0.5f);
-            object_cube_shader.setFloat("the_object.shininess", 32.0f);
-            object_cube_shader.setVec3("light_source.color", 1.0f, 1.0f, 1.0f);
-            object_cube_shader.setVec3("light_source.position", lightPos);
-            object_cube_shader.setVec3("camera_position", camera.Position);
-
-            float ambientStrength = dynamic ? currentFrame : 0.1;
-            object_cube_shader.setFloat("the_object.ambient_strength", ambientStrength);
-
-            object_cube_shader.setMat4("model_matrix", model_matrix);
-            object_cube_shader.setMat4("view_matrix", view_matrix);
-            object_cube_shader.setMat4("projection_matrix", projection_matrix);
-
-            glBindVertexArray(object_cube_vao);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
-
-            // render light source cube
-            light_source_cube_shader.use();
-            light_source_cube_shader.setMat4("view_matrix", view_matrix);
-            light_source_cube_shader.setMat4("projection_matrix", projection_matrix);
-
-            model_matrix = identity_matrix;
-            model_matrix = glm::translate(model_matrix, lightPos);
-            model_matrix = glm::scale(model_matrix, glm::vec3(0.2f)); // a smaller cube
-            light_source_cube_shader.setMat4("model_matrix", model_matrix);
-
-            glBindVertexArray(light_source_cube_vao);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
-
-            /* Swap front and back buffers */
-            /* update other events like input handling */
-            glfwSwapBuffers(window);
-
-            /* Poll for and process events */
-            /* put the stuff we've been drawing onto the display */
-            glfwPollEvents();
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            /* Loop until the user closes the window */
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+
+                // per-frame time logic
+                // --------------------
+                float currentFrame = glfwGetTime();
+                deltaTime = currentFrame - lastFrame;
+                lastFrame = currentFrame;
+
+                // input
+                // -----
+                processInput(window);
+
+                /* Render here */
+                glClearColor(0.1f, 0.1f, 0.1f, 1.0f);// scene background color
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                glm::mat4 view_matrix = camera.GetViewMatrix();
+                glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+                glm::mat4 model_matrix = identity_matrix;
+
+                // render object cube
+                object_cube_shader.use();
+                object_cube_shader.setVec3("the_object.color", 1.0f, 0.5f, 0.31f);
+                object_cube_shader.setFloat("the_object.specular_strength", 0.5f);
+                object_cube_shader.setFloat("the_object.shininess", 32.0f);
+                object_cube_shader.setVec3("light_source.color", 1.0f, 1.0f, 1.0f);
+                object_cube_shader.setVec3("light_source.position", lightPos);
+                object_cube_shader.setVec3("camera_position", camera.Position);
+
+                float ambientStrength = dynamic ? currentFrame : 0.1;
+                object_cube_shader.setFloat("the_object.ambient_strength", ambientStrength);
+
+                object_cube_shader.setMat4("model_matrix", model_matrix);
+                object_cube_shader.setMat4("view_matrix", view_matrix);
+                object_cube_shader.setMat4("projection_matrix", projection_matrix);
+
+                meshes.Draw(cube);
+
+                // render light source cube
+                light_source_cube_shader.use();
+                light_source_cube_shader.setMat4("view_matrix", view_matrix);
+                light_source_cube_shader.setMat4("projection_matrix", projection_matrix);
+
+                model_matrix = identity_matrix;
+                model_matrix = glm::translate(model_matrix, lightPos);
+                model_matrix = glm::scale(model_matrix, glm::vec3(0.2f)); // a smaller cube
+                light_source_cube_shader.setMat4("model_matrix", model_matrix);
+
+                meshes.Draw(cube);
+
+                /* Swap front and back buffers */
+                /* update other events like input handling */
+                glfwSwapBuffers(window);
+
+                /* Poll for and process events */
+                /* put the stuff we've been drawing onto the display */
+                glfwPollEvents();
+            }
         }
 
-        glDeleteVertexArrays(1, &object_cube_vao);
-        glDeleteVertexArrays(1, &light_source_cube_vao);
-        glDeleteBuffers(1, &vbo);
-
         glfwTerminate();
         return 0;
     }
@@ -1261,196 +888,117 @@ namespace tutorials::lighting::material
         glEnable(GL_DEPTH_TEST); // enable depth-testing
         //glDepthFunc(GL_LESS);		 // depth-testing interprets a smaller value as "closer"
 
-        // ====================
-        // VBO - VAO GENERATION
-        // ====================
-        // 1. Vertex data for positions, colors and texture coordinates
-        GLfloat vertices[] = {
-            // coords             // normals
-            -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-             0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-             0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-             0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-            -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-            -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
-
-            -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-             0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-            -0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-            -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
-
-            -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,
-            -0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,
-            -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,
-            -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,
-            -0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,
-            -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,
-
-             0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,
-             0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,
-             0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,
-             0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,
-             0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,
-             0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,
-
-            -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,
-             0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,
-             0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,
-             0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,
-            -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,
-            -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,
-
-            -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,
-             0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,
-            -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,
-            -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f
-        };
-
-        // VBO for the cube
-        GLuint vbo;
-        glGenBuffers(1, &vbo);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-        // Object cube VAO
-        GLuint object_cube_vao;
-        glGenVertexArrays(1, &object_cube_vao);
-        glBindVertexArray(object_cube_vao);
-
-        // Bind the cube vbo to object cube VAO
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        // coords
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)0);
-        glEnableVertexAttribArray(0);
-        // normals
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
-        glEnableVertexAttribArray(1);
-        glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-        // Light source cube vao
-        GLuint light_source_cube_vao;
-        glGenVertexArrays(1, &light_source_cube_vao);
-        glBindVertexArray(light_source_cube_vao);
-
-        // Bind the cube vbo to light source cube VAO
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)0);
-        glEnableVertexAttribArray(0);
-        // no need for normals in the light source
-        glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-        // ====================
-        //      SHADERS
-        // ====================
-        auto object_cube_shader = ShaderProgram(
-            "tutorials\\shaders\\material_intro_object_vs.glsl",
-            "tutorials\\shaders\\material_intro_object_fs.glsl");
-
-        auto light_source_cube_shader = ShaderProgram(
-            "tutorials\\shaders\\material_intro_light_source_vs.glsl",
-            "tutorials\\shaders\\material_intro_light_source_fs.glsl");
-
-
-        // ====================
-        //  TRANSFORMATION SETUP
-        // ====================
-        glm::mat4 identity_matrix = glm::mat4(1.0f);
-        // ====================
-        //  LIGHTING SETUP
-        // ====================
-        glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
-
-
-        // ====================
-        //      MAIN UI LOOP
-        // ====================
-        /* Loop until the user closes the window */
-        while (!glfwWindowShouldClose(window))
         {
-            // fps counter
-            Utility::GLFW::update_fps_counter(window);
-
-            // per-frame time logic
-            // --------------------
-            float currentFrame = glfwGetTime();
-            deltaTime = currentFrame - lastFrame;
-            lastFrame = currentFrame;
-
-            // input
-            // -----
-            processInput(window);
-
-            /* Render here */
-            glClearColor(0.1f, 0.1f, 0.1f, 1.0f);// scene background color
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-            glm::mat4 view_matrix = camera.GetViewMatrix();
-            glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
-            glm::mat4 model_matrix = identity_matrix;
-
-            // render object cube
-            object_cube_shader.use();
-            // vs
-            object_cube_shader.setMat4("model_matrix", model_matrix);
-            object_cube_shader.setMat4("view_matrix", view_matrix);
-            object_cube_shader.setMat4("projection_matrix", projection_matrix);
-            // fs
-                // object
-            float ambientStrength = dynamic ? currentFrame : 0.1;
-            object_cube_shader.setVec3("the_object.ambient", 1.0f, 0.5f, 0.31f);
-            object_cube_shader.setVec3("the_object.diffuse", 1.0f, 0.5f, 0.31f);
-            object_cube_shader.setVec3("the_object.specular", 0.5f, 0.5f, 0.5f); // specular lighting doesn't have full effect on this object's material
-            object_cube_shader.setFloat("the_object.shininess", 32.0f);
-
-                // light
-            glm::vec3 lightColor;
-            lightColor.x = (float)sin(glfwGetTime() * 2.0f);
-            lightColor.y = (float)sin(glfwGetTime() * 0.7f);
-            lightColor.z = (float)sin(glfwGetTime() * 1.3f);
-            glm::vec3 diffuseColor = lightColor * glm::vec3(0.5f); // decrease the influence
-            glm::vec3 ambientColor = diffuseColor * glm::vec3(0.2f); // low influence
-
-            object_cube_shader.setVec3("light_source.position", lightPos);
-            object_cube_shader.setVec3("light_source.ambient", ambientColor);
-            object_cube_shader.setVec3("light_source.diffuse", diffuseColor);
-            object_cube_shader.setVec3("light_source.specular", 1.0f, 1.0f, 1.0f);
-
-                // camera
-            object_cube_shader.setVec3("camera_position", camera.Position);            
-
-            glBindVertexArray(object_cube_vao);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
-
-            // render light source cube
-            light_source_cube_shader.use();
-            light_source_cube_shader.setMat4("view_matrix", view_matrix);
-            light_source_cube_shader.setMat4("projection_matrix", projection_matrix);
-
-            model_matrix = identity_matrix;
-            model_matrix = glm::translate(model_matrix, lightPos);
-            model_matrix = glm::scale(model_matrix, glm::vec3(0.2f)); // a smaller cube
-            light_source_cube_shader.setMat4("model_matrix", model_matrix);
-
-            glBindVertexArray(light_source_cube_vao);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
+            // ====================
+            //      MESHES
+            // ====================
+            // The object and the light source draw the same cube from the mesh library
+            Utility::mesh::MeshLibrary meshes;
+            Utility::mesh::MeshHandle cube = meshes.Get(Utility::mesh::Primitive::Cube, Utility::mesh::Position | Utility::mesh::Normal);
+
+            // ====================
+            //      SHADERS
+            // ====================
+            auto object_cube_shader = ShaderProgram(
+                "tutorials\\shaders\\material_intro_object_vs.glsl",
+                "tutorials\\shaders\\material_intro_object_fs.glsl");
+
+            auto light_source_cube_shader = ShaderProgram(
+                "tutorials\\shaders\\material_intro_light_source_vs.glsl",
+                "tutorials\\shaders\\material_intro_light_source_fs.glsl");
+
+
+            // ====================
+            //  TRANSFORMATION SETUP
+            // ====================
+            glm::mat4 identity_matrix = glm::mat4(1.0f);
+            // ====================
+            //  LIGHTING SETUP
+            // ====================
+            glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
 
-            /* Swap front and back buffers */
-            /* update other events like input handling */
-            glfwSwapBuffers(window);
 
-            /* Poll for and process events */
-            /* put the stuff we've been drawing onto the display */
-            glfwPollEvents();
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            /* Loop until the user closes the window */
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+
+                // per-frame time logic
+                // --------------------
+                float currentFrame = glfwGetTime();
+                deltaTime = currentFrame - lastFrame;
+                lastFrame = currentFrame;
+
+                // input
+                // -----
+                processInput(window);
+
+                /* Render here */
+                glClearColor(0.1f, 0.1f, 0.1f, 1.0f);// scene background color
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                glm::mat4 view_matrix = camera.GetViewMatrix();
+                glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+                glm::mat4 model_matrix = identity_matrix;
+
+                // render object cube
+                object_cube_shader.use();
+                // vs
+                object_cube_shader.setMat4("model_matrix", model_matrix);
+                object_cube_shader.setMat4("view_matrix", view_matrix);
+                object_cube_shader.setMat4("projection_matrix", projection_matrix);
+                // fs
+                    // object
+                float ambientStrength = dynamic ? currentFrame : 0.1;
+                object_cube_shader.setVec3("the_object.ambient", 1.0f, 0.5f, 0.31f);
+                object_cube_shader.setVec3("the_object.diffuse", 1.0f, 0.5f, 0.31f);
+                object_cube_shader.setVec3("the_object.specular", 0.5f, 0.5f, 0.5f); // specular lighting doesn't have full effect on this object's material
+                object_cube_shader.setFloat("the_object.shininess", 32.0f);
+
+                    // light
+                glm::vec3 lightColor;
+                lightColor.x = (float)sin(glfwGetTime() * 2.0f);
+                lightColor.y = (float)sin(glfwGetTime() * 0.7f);
+                lightColor.z = (float)sin(glfwGetTime() * 1.3f);
+                glm::vec3 diffuseColor = lightColor * glm::vec3(0.5f); // decrease the influence
+                glm::vec3 ambientColor = diffuseColor * glm::vec3(0.2f); // low influence
+
+                object_cube_shader.setVec3("light_source.position", lightPos);
+                object_cube_shader.setVec3("light_source.ambient", ambientColor);
+                object_cube_shader.setVec3("light_source.diffuse", diffuseColor);
+                object_cube_shader.setVec3("light_source.specular", 1.0f, 1.0f, 1.0f);
+
+                    // camera
+                object_cube_shader.setVec3("camera_position", camera.Position);            
+
+                meshes.Draw(cube);
+
+                // render light source cube
+                light_source_cube_shader.use();
+                light_source_cube_shader.setMat4("view_matrix", view_matrix);
+                light_source_cube_shader.setMat4("projection_matrix", projection_matrix);
+
+                model_matrix = identity_matrix;
+                model_matrix = glm::translate(model_matrix, lightPos);
+                model_matrix = glm::scale(model_matrix, glm::vec3(0.2f)); // a smaller cube
+                light_source_cube_shader.setMat4("model_matrix", model_matrix);
+
+                meshes.Draw(cube);
+
+                /* Swap front and back buffers */
+                /* update other events like input handling */
+                glfwSwapBuffers(window);
+
+                /* Poll for and process events */
+                /* put the stuff we've been drawing onto the display */
+                glfwPollEvents();
+            }
         }
 
-        glDeleteVertexArrays(1, &object_cube_vao);
-        glDeleteVertexArrays(1, &light_source_cube_vao);
-        glDeleteBuffers(1, &vbo);
-
         glfwTerminate();
         return 0;
     }
@@ -1476,210 +1024,283 @@ namespace tutorials::lighting::lighting_maps
         glEnable(GL_DEPTH_TEST); // enable depth-testing
         //glDepthFunc(GL_LESS);		 // depth-testing interprets a smaller value as "closer"
 
-        // ====================
-        // VBO - VAO GENERATION
-        // ====================
-        // 1. Vertex data for positions, colors and texture coordinates
-        GLfloat vertices[] = {
-            // positions          // normals           // texture coords
-            -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f,  0.0f,
-             0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f,  0.0f,
-             0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f,  1.0f,
-             0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f,  1.0f,
-            -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f,  1.0f,
-            -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f,  0.0f,
-
-            -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f,  0.0f,
-             0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f,  0.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f,  1.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f,  1.0f,
-            -0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f,  1.0f,
-            -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f,  0.0f,
-
-            -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f,  0.0f,
-            -0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  1.0f,  1.0f,
-            -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f,  1.0f,
-            -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f,  1.0f,
-            -0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  0.0f,  0.0f,
-            -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f,  0.0f,
-
-             0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,
-             0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f,  1.0f,
-             0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f,  1.0f,
-             0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f,  1.0f,
-             0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f,  0.0f,
-             0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,
-
-            -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f,  1.0f,
-             0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f,  1.0f,
-             0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f,  0.0f,
-             0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f,  0.0f,
-            -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f,  0.0f,
-            -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f,  1.0f,
-
-            -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f,  1.0f,
-             0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f,  1.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f,  0.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f,  0.0f,
-            -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f,  0.0f,
-            -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f,  1.0f
-        };
-
-        // VBO for the cube
-        GLuint vbo;
-        glGenBuffers(1, &vbo);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-        // Object cube VAO
-        GLuint object_cube_vao;
-        glGenVertexArrays(1, &object_cube_vao);
-        glBindVertexArray(object_cube_vao);
-
-        // Bind the cube vbo to object cube VAO
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        // coords
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (GLvoid*)0);
-        glEnableVertexAttribArray(0);
-        // normals
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
-        glEnableVertexAttribArray(1);
-        // texture
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (GLvoid*)(6 * sizeof(GLfloat)));
-        glEnableVertexAttribArray(2);
-        glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-        // Light source cube vao
-        GLuint light_source_cube_vao;
-        glGenVertexArrays(1, &light_source_cube_vao);
-        glBindVertexArray(light_source_cube_vao);
-
-        // Bind the cube vbo to light source cube VAO
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (GLvoid*)0);
-        glEnableVertexAttribArray(0);
-        // no need for normals in the light source
-        glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-        // ====================
-        //      TEXTURE
-        // ====================
-        GLuint container_diffused_texture = Utility::texture::load("resources\\container2.png");
-
-        // ====================
-        //      SHADERS
-        // ====================
-        auto object_cube_shader = ShaderProgram(
-            "tutorials\\shaders\\lm_diffuse_map_object_vs.glsl",
-            "tutorials\\shaders\\lm_diffuse_map_object_fs.glsl");
-
-        auto light_source_cube_shader = ShaderProgram(
-            "tutorials\\shaders\\lm_diffuse_map_light_source_vs.glsl",
-            "tutorials\\shaders\\lm_diffuse_map_light_source_fs.glsl");
-
-        // ====================
-        //  TRANSFORMATION SETUP
-        // ====================
-        glm::mat4 identity_matrix = glm::mat4(1.0f);
-        // ====================
-        //  LIGHTING SETUP
-        // ====================
-        glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
-        object_cube_shader.use(); 
-        object_cube_shader.setInt("the_object.diffuse", 0);
-
-        // ====================
-        //      MAIN UI LOOP
-        // ====================
-        /* Loop until the user closes the window */
-        while (!glfwWindowShouldClose(window))
         {
-            // fps counter
-            Utility::GLFW::update_fps_counter(window);
+            // ====================
+            //      MESHES
+            // ====================
+            // The object and the light source draw the same cube from the mesh library
+            Utility::mesh::MeshLibrary meshes;
+            Utility::mesh::MeshHandle cube = meshes.Get(Utility::mesh::Primitive::Cube, Utility::mesh::Position | Utility::mesh::Normal | Utility::mesh::TexCoord);
+
+            // ====================
+            //      TEXTURE
+            // ====================
+            // Textures are owned by the residency manager which keeps them inside the given memory budget
+            Utility::texture::ResidencyManager textures(64 * 1024 * 1024);
+            GLuint container_diffused_texture = textures.Load("resources\\container2.png");
+
+            // ====================
+            //      SHADERS
+            // ====================
+            auto object_cube_shader = ShaderProgram(
+                "tutorials\\shaders\\lm_diffuse_map_object_vs.glsl",
+                "tutorials\\shaders\\lm_diffuse_map_object_fs.glsl");
+
+            auto light_source_cube_shader = ShaderProgram(
+                "tutorials\\shaders\\lm_diffuse_map_light_source_vs.glsl",
+                "tutorials\\shaders\\lm_diffuse_map_light_source_fs.glsl");
+
+            // ====================
+            //  TRANSFORMATION SETUP
+            // ====================
+            glm::mat4 identity_matrix = glm::mat4(1.0f);
+            // ====================
+            //  LIGHTING SETUP
+            // ====================
+            glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
+            object_cube_shader.use(); 
+            object_cube_shader.setInt("the_object.diffuse", 0);
+
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            /* Loop until the user closes the window */
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+
+                // per-frame time logic
+                // --------------------
+                float currentFrame = glfwGetTime();
+                deltaTime = currentFrame - lastFrame;
+                lastFrame = currentFrame;
+
+                // input
+                // -----
+                processInput(window);
+
+                /* Render here */
+                glClearColor(0.1f, 0.1f, 0.1f, 1.0f);// scene background color
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                glm::mat4 view_matrix = camera.GetViewMatrix();
+                glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+                glm::mat4 model_matrix = identity_matrix;
+
+                // render object cube
+                object_cube_shader.use();
+                // vs
+                object_cube_shader.setMat4("model_matrix", model_matrix);
+                object_cube_shader.setMat4("view_matrix", view_matrix);
+                object_cube_shader.setMat4("projection_matrix", projection_matrix);
+                // fs
+                    // object
+                object_cube_shader.setVec3("the_object.specular", 0.5f, 0.5f, 0.5f); // specular lighting doesn't have full effect on this object's material
+                object_cube_shader.setFloat("the_object.shininess", 64.0f);
 
-            // per-frame time logic
-            // --------------------
-            float currentFrame = glfwGetTime();
-            deltaTime = currentFrame - lastFrame;
-            lastFrame = currentFrame;
+                // light
+                //glm::vec3 lightColor;
+                //lightColor.x = (float)sin(glfwGetTime() * 2.0f);
+                //lightColor.y = (float)sin(glfwGetTime() * 0.7f);
+                //lightColor.z = (float)sin(glfwGetTime() * 1.3f);
+                //glm::vec3 diffuseColor = lightColor * glm::vec3(0.5f); // decrease the influence
+                //glm::vec3 ambientColor = diffuseColor * glm::vec3(0.2f); // low influence
+
+                object_cube_shader.setVec3("light_source.position", lightPos);
+                object_cube_shader.setVec3("light_source.ambient", 0.2f, 0.2f, 0.2f);
+                object_cube_shader.setVec3("light_source.diffuse", 0.5f, 0.5f, 0.5f);
+                object_cube_shader.setVec3("light_source.specular", 1.0f, 1.0f, 1.0f);
 
-            // input
-            // -----
-            processInput(window);
+                // camera
+                object_cube_shader.setVec3("camera_position", camera.Position);
+
+                // bind diffuse map
+                textures.Use(container_diffused_texture);
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_2D, container_diffused_texture);
+                // render the cube
+                meshes.Draw(cube);
+
+                // render light source cube
+                light_source_cube_shader.use();
+                light_source_cube_shader.setMat4("view_matrix", view_matrix);
+                light_source_cube_shader.setMat4("projection_matrix", projection_matrix);
+
+                model_matrix = identity_matrix;
+                model_matrix = glm::translate(model_matrix, lightPos);
+                model_matrix = glm::scale(model_matrix, glm::vec3(0.2f)); // a smaller cube
+                light_source_cube_shader.setMat4("model_matrix", model_matrix);
+
+                meshes.Draw(cube);
+
+                // trim the textures that were not used this frame back into the budget
+                textures.EndFrame();
+
+                /* Swap front and back buffers */
+                /* update other events like input handling */
+                glfwSwapBuffers(window);
+
+                /* Poll for and process events */
+                /* put the stuff we've been drawing onto the display */
+                glfwPollEvents();
+            }
+        }
 
-            /* Render here */
-            glClearColor(0.1f, 0.1f, 0.1f, 1.0f);// scene background color
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glfwTerminate();
+        return 0;
+    }
 
-            glm::mat4 view_matrix = camera.GetViewMatrix();
-            glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
-            glm::mat4 model_matrix = identity_matrix;
+    int SpecularMap()
+    {
+        // Initialize the glfw & glew
+        GLFWwindow* window = Utility::GLFW::start_glfw();
+        glfwSetCursorPosCallback(window, mouse_callback);
+        glfwSetScrollCallback(window, scroll_callback);
+
+        // tell GLFW to capture our mouse
+        glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+
+        Utility::GLEW::start_glew();
+
+        // Some openGL settings
+        // tell GL to only draw onto a pixel if the shape is closer to the viewer
+        glEnable(GL_DEPTH_TEST); // enable depth-testing
+        //glDepthFunc(GL_LESS);		 // depth-testing interprets a smaller value as "closer"
 
-            // render object cube
+        {
+            // ====================
+            //      MESHES
+            // ====================
+            // The object and the light source draw the same cube from the mesh library
+            Utility::mesh::MeshLibrary meshes;
+            Utility::mesh::MeshHandle cube = meshes.Get(Utility::mesh::Primitive::Cube, Utility::mesh::Position | Utility::mesh::Normal | Utility::mesh::TexCoord);
+
+            // ====================
+            //      TEXTURE
+            // ====================
+            // Textures are owned by the residency manager which keeps them inside the given memory budget
+            Utility::texture::ResidencyManager textures(64 * 1024 * 1024);
+            GLuint container_diffuse_texture = textures.Load("resources\\container2.png");
+            GLuint container_specular_texture = textures.Load("resources\\container2_specular.png");
+
+            // ====================
+            //      SHADERS
+            // ====================
+            auto object_cube_shader = ShaderProgram(
+                "tutorials\\shaders\\lm_specular_map_object_vs.glsl",
+                "tutorials\\shaders\\lm_specular_map_object_fs.glsl");
+
+            auto light_source_cube_shader = ShaderProgram(
+                "tutorials\\shaders\\lm_specular_map_light_source_vs.glsl",
+                "tutorials\\shaders\\lm_specular_map_light_source_fs.glsl");
+
+            // ====================
+            //  TRANSFORMATION SETUP
+            // ====================
+            glm::mat4 identity_matrix = glm::mat4(1.0f);
+            // ====================
+            //  LIGHTING SETUP
+            // ====================
+            glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
             object_cube_shader.use();
-            // vs
-            object_cube_shader.setMat4("model_matrix", model_matrix);
-            object_cube_shader.setMat4("view_matrix", view_matrix);
-            object_cube_shader.setMat4("projection_matrix", projection_matrix);
-            // fs
-                // object
-            object_cube_shader.setVec3("the_object.specular", 0.5f, 0.5f, 0.5f); // specular lighting doesn't have full effect on this object's material
-            object_cube_shader.setFloat("the_object.shininess", 64.0f);
-
-            // light
-            //glm::vec3 lightColor;
-            //lightColor.x = (float)sin(glfwGetTime() * 2.0f);
-            //lightColor.y = (float)sin(glfwGetTime() * 0.7f);
-            //lightColor.z = (float)sin(glfwGetTime() * 1.3f);
-            //glm::vec3 diffuseColor = lightColor * glm::vec3(0.5f); // decrease the influence
-            //glm::vec3 ambientColor = diffuseColor * glm::vec3(0.2f); // low influence
-
-            object_cube_shader.setVec3("light_source.position", lightPos);
-            object_cube_shader.setVec3("light_source.ambient", 0.2f, 0.2f, 0.2f);
-            object_cube_shader.setVec3("light_source.diffuse", 0.5f, 0.5f, 0.5f);
-            object_cube_shader.setVec3("light_source.specular", 1.0f, 1.0f, 1.0f);
-
-            // camera
-            object_cube_shader.setVec3("camera_position", camera.Position);
-
-            // bind diffuse map
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, container_diffused_texture);
-            // render the cube
-            glBindVertexArray(object_cube_vao);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
-
-            // render light source cube
-            light_source_cube_shader.use();
-            light_source_cube_shader.setMat4("view_matrix", view_matrix);
-            light_source_cube_shader.setMat4("projection_matrix", projection_matrix);
-
-            model_matrix = identity_matrix;
-            model_matrix = glm::translate(model_matrix, lightPos);
-            model_matrix = glm::scale(model_matrix, glm::vec3(0.2f)); // a smaller cube
-            light_source_cube_shader.setMat4("model_matrix", model_matrix);
-
-            glBindVertexArray(light_source_cube_vao);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
-
-            /* Swap front and back buffers */
-            /* update other events like input handling */
-            glfwSwapBuffers(window);
-
-            /* Poll for and process events */
-            /* put the stuff we've been drawing onto the display */
-            glfwPollEvents();
-        }
+            object_cube_shader.setInt("the_object.diffuse", 0);
+            object_cube_shader.setInt("the_object.specular", 1);
+
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            /* Loop until the user closes the window */
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+
+                // per-frame time logic
+                // --------------------
+                float currentFrame = glfwGetTime();
+                deltaTime = currentFrame - lastFrame;
+                lastFrame = currentFrame;
+
+                // input
+                // -----
+                processInput(window);
+
+                /* Render here */
+                glClearColor(0.1f, 0.1f, 0.1f, 1.0f);// scene background color
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                glm::mat4 view_matrix = camera.GetViewMatrix();
+                glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+                glm::mat4 model_matrix = identity_matrix;
+
+                // render object cube
+                object_cube_shader.use();
+                // vs
+                object_cube_shader.setMat4("model_matrix", model_matrix);
+                object_cube_shader.setMat4("view_matrix", view_matrix);
+                object_cube_shader.setMat4("projection_matrix", projection_matrix);
+                // fs
+                    // object
+                object_cube_shader.setFloat("the_object.shininess", 64.0f);
+
+                // light
+                //glm::vec3 lightColor;
+                //lightColor.x = (float)sin(glfwGetTime() * 2.0f);
+                //lightColor.y = (float)sin(glfwGetTime() * 0.7f);
+                //lightColor.z = (float)sin(glfwGetTime() * 1.3f);
+                //glm::vec3 diffuseColor = lightColor * glm::vec3(0.5f); // decrease the influence
+                //glm::vec3 ambientColor = diffuseColor * glm::vec3(0.2f); // low influence
+
+                object_cube_shader.setVec3("light_source.position", lightPos);
+                object_cube_shader.setVec3("light_source.ambient", 0.2f, 0.2f, 0.2f);
+                object_cube_shader.setVec3("light_source.diffuse", 0.5f, 0.5f, 0.5f);
+                object_cube_shader.setVec3("light_source.specular", 1.0f, 1.0f, 1.0f);
 
-        glDeleteVertexArrays(1, &object_cube_vao);
-        glDeleteVertexArrays(1, &light_source_cube_vao);
-        glDeleteBuffers(1, &vbo);
+                // camera
+                object_cube_shader.setVec3("camera_position", camera.Position);
+
+                // bind diffuse map
+                textures.Use(container_diffuse_texture);
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_2D, container_diffuse_texture);
+                // bind specular map
+                textures.Use(container_specular_texture);
+                glActiveTexture(GL_TEXTURE1);
+                glBindTexture(GL_TEXTURE_2D, container_specular_texture);
+                // render the cube
+                meshes.Draw(cube);
+
+                // render light source cube
+                light_source_cube_shader.use();
+                light_source_cube_shader.setMat4("view_matrix", view_matrix);
+                light_source_cube_shader.setMat4("projection_matrix", projection_matrix);
+
+                model_matrix = identity_matrix;
+                model_matrix = glm::translate(model_matrix, lightPos);
+                model_matrix = glm::scale(model_matrix, glm::vec3(0.2f)); // a smaller cube
+                light_source_cube_shader.setMat4("model_matrix", model_matrix);
+
+                meshes.Draw(cube);
+
+                // trim the textures that were not used this frame back into the budget
+                textures.EndFrame();
+
+                /* Swap front and back buffers */
+                /* update other events like input handling */
+                glfwSwapBuffers(window);
+
+                /* Poll for and process events */
+                /* put the stuff we've been drawing onto the display */
+                glfwPollEvents();
+            }
+        }
 
         glfwTerminate();
         return 0;
     }
 
-    int SpecularMap()
+    int SpecularMapPacked()
     {
         // Initialize the glfw & glew
         GLFWwindow* window = Utility::GLFW::start_glfw();
@@ -1696,212 +1317,605 @@ namespace tutorials::lighting::lighting_maps
         glEnable(GL_DEPTH_TEST); // enable depth-testing
         //glDepthFunc(GL_LESS);		 // depth-testing interprets a smaller value as "closer"
 
-        // ====================
-        // VBO - VAO GENERATION
-        // ====================
-        // 1. Vertex data for positions, colors and texture coordinates
-        GLfloat vertices[] = {
-            // positions          // normals           // texture coords
-            -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f,  0.0f,
-             0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f,  0.0f,
-             0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f,  1.0f,
-             0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  1.0f,  1.0f,
-            -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f,  1.0f,
-            -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  0.0f,  0.0f,
-
-            -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f,  0.0f,
-             0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f,  0.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f,  1.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  1.0f,  1.0f,
-            -0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f,  1.0f,
-            -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  0.0f,  0.0f,
-
-            -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f,  0.0f,
-            -0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  1.0f,  1.0f,
-            -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f,  1.0f,
-            -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  0.0f,  1.0f,
-            -0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  0.0f,  0.0f,
-            -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  1.0f,  0.0f,
-
-             0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,
-             0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  1.0f,  1.0f,
-             0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f,  1.0f,
-             0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,  0.0f,  1.0f,
-             0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  0.0f,  0.0f,
-             0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,  1.0f,  0.0f,
-
-            -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f,  1.0f,
-             0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  1.0f,  1.0f,
-             0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f,  0.0f,
-             0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  1.0f,  0.0f,
-            -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  0.0f,  0.0f,
-            -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,  0.0f,  1.0f,
-
-            -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f,  1.0f,
-             0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  1.0f,  1.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f,  0.0f,
-             0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  1.0f,  0.0f,
-            -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,  0.0f,  0.0f,
-            -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  0.0f,  1.0f
-        };
-
-        // VBO for the cube
-        GLuint vbo;
-        glGenBuffers(1, &vbo);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-        // Object cube VAO
-        GLuint object_cube_vao;
-        glGenVertexArrays(1, &object_cube_vao);
-        glBindVertexArray(object_cube_vao);
-
-        // Bind the cube vbo to object cube VAO
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        // coords
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (GLvoid*)0);
-        glEnableVertexAttribArray(0);
-        // normals
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
-        glEnableVertexAttribArray(1);
-        // texture
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (GLvoid*)(6 * sizeof(GLfloat)));
-        glEnableVertexAttribArray(2);
-        glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-        // Light source cube vao
-        GLuint light_source_cube_vao;
-        glGenVertexArrays(1, &light_source_cube_vao);
-        glBindVertexArray(light_source_cube_vao);
-
-        // Bind the cube vbo to light source cube VAO
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (GLvoid*)0);
-        glEnableVertexAttribArray(0);
-        // no need for normals in the light source
-        glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-        // ====================
-        //      TEXTURE
-        // ====================
-        GLuint container_diffuse_texture = Utility::texture::load("resources\\container2.png");
-        GLuint container_specular_texture = Utility::texture::load("resources\\container2_specular.png");
-
-        // ====================
-        //      SHADERS
-        // ====================
-        auto object_cube_shader = ShaderProgram(
-            "tutorials\\shaders\\lm_specular_map_object_vs.glsl",
-            "tutorials\\shaders\\lm_specular_map_object_fs.glsl");
-
-        auto light_source_cube_shader = ShaderProgram(
-            "tutorials\\shaders\\lm_specular_map_light_source_vs.glsl",
-            "tutorials\\shaders\\lm_specular_map_light_source_fs.glsl");
-
-        // ====================
-        //  TRANSFORMATION SETUP
-        // ====================
-        glm::mat4 identity_matrix = glm::mat4(1.0f);
-        // ====================
-        //  LIGHTING SETUP
-        // ====================
-        glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
-        object_cube_shader.use();
-        object_cube_shader.setInt("the_object.diffuse", 0);
-        object_cube_shader.setInt("the_object.specular", 1);
-
-        // ====================
-        //      MAIN UI LOOP
-        // ====================
-        /* Loop until the user closes the window */
-        while (!glfwWindowShouldClose(window))
         {
-            // fps counter
-            Utility::GLFW::update_fps_counter(window);
+            // ====================
+            //      MESHES
+            // ====================
+            // The object and the light source draw the same cube from the mesh library
+            Utility::mesh::MeshLibrary meshes;
+            Utility::mesh::MeshHandle cube = meshes.Get(Utility::mesh::Primitive::Cube, Utility::mesh::Position | Utility::mesh::Normal | Utility::mesh::TexCoord);
+
+            // The object cube is drawn from the packed vertex format: 16 bytes per vertex instead of 32
+            Utility::mesh::QuantizationReport packed_report;
+            Utility::mesh::PackedMesh packed_cube = Utility::mesh::compile_vertex_format(
+                Utility::mesh::cube(Utility::mesh::Position | Utility::mesh::Normal | Utility::mesh::TexCoord),
+                Utility::mesh::VertexFormatOptions(), &packed_report);
+            std::cout << "packed cube: " << packed_report << std::endl;
+
+            GLuint packed_vao, packed_vbo, packed_ebo;
+            glGenVertexArrays(1, &packed_vao);
+            glBindVertexArray(packed_vao);
+            glGenBuffers(1, &packed_vbo);
+            glBindBuffer(GL_ARRAY_BUFFER, packed_vbo);
+            glBufferData(GL_ARRAY_BUFFER, packed_cube.vertices.size(), packed_cube.vertices.data(), GL_STATIC_DRAW);
+            glGenBuffers(1, &packed_ebo);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, packed_ebo);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, packed_cube.indices.size() * sizeof(unsigned int), packed_cube.indices.data(), GL_STATIC_DRAW);
+            packed_cube.format.Apply();
+            glBindVertexArray(0);
+
+            // ====================
+            //      TEXTURE
+            // ====================
+            // Textures are owned by the residency manager which keeps them inside the given memory budget
+            Utility::texture::ResidencyManager textures(64 * 1024 * 1024);
+            GLuint container_diffuse_texture = textures.Load("resources\\container2.png");
+            GLuint container_specular_texture = textures.Load("resources\\container2_specular.png");
+
+            // ====================
+            //      SHADERS
+            // ====================
+            auto object_cube_shader = ShaderProgram(
+                "tutorials\\shaders\\lm_specular_map_object_packed_vs.glsl",
+                "tutorials\\shaders\\lm_specular_map_object_fs.glsl");
+
+            auto light_source_cube_shader = ShaderProgram(
+                "tutorials\\shaders\\lm_specular_map_light_source_vs.glsl",
+                "tutorials\\shaders\\lm_specular_map_light_source_fs.glsl");
+
+            // ====================
+            //  TRANSFORMATION SETUP
+            // ====================
+            glm::mat4 identity_matrix = glm::mat4(1.0f);
+            // ====================
+            //  LIGHTING SETUP
+            // ====================
+            glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
+            object_cube_shader.use();
+            object_cube_shader.setInt("the_object.diffuse", 0);
+            object_cube_shader.setInt("the_object.specular", 1);
+            packed_cube.format.SetDecodeUniforms(object_cube_shader);
+
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            /* Loop until the user closes the window */
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+
+                // per-frame time logic
+                // --------------------
+                float currentFrame = glfwGetTime();
+                deltaTime = currentFrame - lastFrame;
+                lastFrame = currentFrame;
+
+                // input
+                // -----
+                processInput(window);
+
+                /* Render here */
+                glClearColor(0.1f, 0.1f, 0.1f, 1.0f);// scene background color
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                glm::mat4 view_matrix = camera.GetViewMatrix();
+                glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+                glm::mat4 model_matrix = identity_matrix;
+
+                // render object cube
+                object_cube_shader.use();
+                // vs
+                object_cube_shader.setMat4("model_matrix", model_matrix);
+                object_cube_shader.setMat4("view_matrix", view_matrix);
+                object_cube_shader.setMat4("projection_matrix", projection_matrix);
+                // fs
+                    // object
+                object_cube_shader.setFloat("the_object.shininess", 64.0f);
+
+                // light
+                //glm::vec3 lightColor;
+                //lightColor.x = (float)sin(glfwGetTime() * 2.0f);
+                //lightColor.y = (float)sin(glfwGetTime() * 0.7f);
+                //lightColor.z = (float)sin(glfwGetTime() * 1.3f);
+                //glm::vec3 diffuseColor = lightColor * glm::vec3(0.5f); // decrease the influence
+                //glm::vec3 ambientColor = diffuseColor * glm::vec3(0.2f); // low influence
+
+                object_cube_shader.setVec3("light_source.position", lightPos);
+                object_cube_shader.setVec3("light_source.ambient", 0.2f, 0.2f, 0.2f);
+                object_cube_shader.setVec3("light_source.diffuse", 0.5f, 0.5f, 0.5f);
+                object_cube_shader.setVec3("light_source.specular", 1.0f, 1.0f, 1.0f);
+
+                // camera
+                object_cube_shader.setVec3("camera_position", camera.Position);
+
+                // bind diffuse map
+                textures.Use(container_diffuse_texture);
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_2D, container_diffuse_texture);
+                // bind specular map
+                textures.Use(container_specular_texture);
+                glActiveTexture(GL_TEXTURE1);
+                glBindTexture(GL_TEXTURE_2D, container_specular_texture);
+                // render the cube
+                glBindVertexArray(packed_vao);
+                glDrawElements(GL_TRIANGLES, (GLsizei)packed_cube.indices.size(), GL_UNSIGNED_INT, 0);
+
+                // render light source cube
+                light_source_cube_shader.use();
+                light_source_cube_shader.setMat4("view_matrix", view_matrix);
+                light_source_cube_shader.setMat4("projection_matrix", projection_matrix);
+
+                model_matrix = identity_matrix;
+                model_matrix = glm::translate(model_matrix, lightPos);
+                model_matrix = glm::scale(model_matrix, glm::vec3(0.2f)); // a smaller cube
+                light_source_cube_shader.setMat4("model_matrix", model_matrix);
+
+                meshes.Draw(cube);
+
+                // trim the textures that were not used this frame back into the budget
+                textures.EndFrame();
+
+                /* Swap front and back buffers */
+                /* update other events like input handling */
+                glfwSwapBuffers(window);
+
+                /* Poll for and process events */
+                /* put the stuff we've been drawing onto the display */
+                glfwPollEvents();
+            }
+
+            glDeleteVertexArrays(1, &packed_vao);
+            glDeleteBuffers(1, &packed_vbo);
+            glDeleteBuffers(1, &packed_ebo);
+        }
+
+        glfwTerminate();
+        return 0;
+    }
 
-            // per-frame time logic
-            // --------------------
-            float currentFrame = glfwGetTime();
-            deltaTime = currentFrame - lastFrame;
-            lastFrame = currentFrame;
 
-            // input
-            // -----
-            processInput(window);
+}
 
-            /* Render here */
-            glClearColor(0.1f, 0.1f, 0.1f, 1.0f);// scene background color
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+namespace tutorials::lighting::deferred
+{
+    int DeferredShading()
+    {
+        using namespace Utility::literals;
 
-            glm::mat4 view_matrix = camera.GetViewMatrix();
-            glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
-            glm::mat4 model_matrix = identity_matrix;
+        // Initialize the glfw & glew
+        GLFWwindow* window = Utility::GLFW::start_glfw();
+        glfwSetCursorPosCallback(window, mouse_callback);
+        glfwSetScrollCallback(window, scroll_callback);
 
-            // render object cube
-            object_cube_shader.use();
-            // vs
-            object_cube_shader.setMat4("model_matrix", model_matrix);
-            object_cube_shader.setMat4("view_matrix", view_matrix);
-            object_cube_shader.setMat4("projection_matrix", projection_matrix);
-            // fs
-                // object
-            object_cube_shader.setFloat("the_object.shininess", 64.0f);
-
-            // light
-            //glm::vec3 lightColor;
-            //lightColor.x = (float)sin(glfwGetTime() * 2.0f);
-            //lightColor.y = (float)sin(glfwGetTime() * 0.7f);
-            //lightColor.z = (float)sin(glfwGetTime() * 1.3f);
-            //glm::vec3 diffuseColor = lightColor * glm::vec3(0.5f); // decrease the influence
-            //glm::vec3 ambientColor = diffuseColor * glm::vec3(0.2f); // low influence
-
-            object_cube_shader.setVec3("light_source.position", lightPos);
-            object_cube_shader.setVec3("light_source.ambient", 0.2f, 0.2f, 0.2f);
-            object_cube_shader.setVec3("light_source.diffuse", 0.5f, 0.5f, 0.5f);
-            object_cube_shader.setVec3("light_source.specular", 1.0f, 1.0f, 1.0f);
-
-            // camera
-            object_cube_shader.setVec3("camera_position", camera.Position);
-
-            // bind diffuse map
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, container_diffuse_texture);
-            // bind specular map
-            glActiveTexture(GL_TEXTURE1);
-            glBindTexture(GL_TEXTURE_2D, container_specular_texture);
-            // render the cube
-            glBindVertexArray(object_cube_vao);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
-
-            // render light source cube
-            light_source_cube_shader.use();
-            light_source_cube_shader.setMat4("view_matrix", view_matrix);
-            light_source_cube_shader.setMat4("projection_matrix", projection_matrix);
-
-            model_matrix = identity_matrix;
-            model_matrix = glm::translate(model_matrix, lightPos);
-            model_matrix = glm::scale(model_matrix, glm::vec3(0.2f)); // a smaller cube
-            light_source_cube_shader.setMat4("model_matrix", model_matrix);
-
-            glBindVertexArray(light_source_cube_vao);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
-
-            /* Swap front and back buffers */
-            /* update other events like input handling */
-            glfwSwapBuffers(window);
-
-            /* Poll for and process events */
-            /* put the stuff we've been drawing onto the display */
-            glfwPollEvents();
-        }
+        // tell GLFW to capture our mouse
+        glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
 
-        glDeleteVertexArrays(1, &object_cube_vao);
-        glDeleteVertexArrays(1, &light_source_cube_vao);
-        glDeleteBuffers(1, &vbo);
+        Utility::GLEW::start_glew();
+        glEnable(GL_DEPTH_TEST);
+
+        {
+            // ====================
+            //      MESHES
+            // ====================
+            const unsigned int attributes = Utility::mesh::Position | Utility::mesh::Normal | Utility::mesh::TexCoord;
+            Utility::mesh::MeshLibrary meshes;
+            Utility::mesh::MeshHandle cube = meshes.Get(Utility::mesh::Primitive::Cube, attributes);
+            Utility::mesh::MeshHandle floor = meshes.Get(Utility::mesh::Primitive::Plane, attributes);
+
+            // ====================
+            //      TEXTURE
+            // ====================
+            Utility::texture::ResidencyManager textures(64 * 1024 * 1024);
+            GLuint container_diffuse_texture = textures.Load("resources\\container2.png");
+            GLuint container_specular_texture = textures.Load("resources\\container2_specular.png");
+
+            // ====================
+            //      SHADERS
+            // ====================
+            // The objects only write the G-buffer; all lighting happens in the renderer's passes
+            auto geometry_shader = ShaderProgram(
+                "tutorials\\shaders\\lm_specular_map_object_vs.glsl",
+                "tutorials\\shaders\\deferred_geometry_fs.glsl");
+            geometry_shader.use();
+            geometry_shader.setInt("diffuse_map", 0);
+            geometry_shader.setInt("specular_map", 1);
+            geometry_shader.setFloat("max_shininess", Utility::render::GBuffer::kMaxShininess);
+
+            int framebuffer_width, framebuffer_height;
+            glfwGetFramebufferSize(window, &framebuffer_width, &framebuffer_height);
+            Utility::render::DeferredRenderer renderer;
+            renderer.Create(framebuffer_width, framebuffer_height);
+
+            // ====================
+            //  OBJECTS
+            // ====================
+            const int grid_size = 24;
+            const float spacing = 3.0f;
+            std::vector<glm::mat4> models;
+            for (int z = 0; z < grid_size; ++z)
+            {
+                for (int x = 0; x < grid_size; ++x)
+                    models.push_back(glm::translate(glm::mat4(1.0f), glm::vec3((x - grid_size / 2) * spacing, 0.5f, -z * spacing)));
+            }
+            glm::mat4 floor_model = glm::translate(glm::mat4(1.0f), glm::vec3(-spacing * 0.5f, 0.0f, -grid_size * spacing * 0.5f));
+            floor_model = glm::scale(floor_model, glm::vec3(grid_size * spacing, 1.0f, grid_size * spacing));
+
+            // ====================
+            //  LIGHTING SETUP
+            // ====================
+            // Each light circles its own point of the field between the cubes
+            const size_t max_lights = 4096;
+            std::vector<glm::vec4> orbits(max_lights);     // center, orbit radius
+            std::vector<Utility::render::GpuPointLight> lights(max_lights);
+            std::mt19937 rng(3);
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+            for (size_t i = 0; i < max_lights; ++i)
+            {
+                orbits[i] = glm::vec4((unit(rng) - 0.5f) * grid_size * spacing, 0.5f + unit(rng) * 2.0f, -unit(rng) * grid_size * spacing, 1.0f + unit(rng) * 2.0f);
+                lights[i].radius = 2.0f + unit(rng) * 4.0f;
+                lights[i].color = glm::vec3(unit(rng), unit(rng), unit(rng)) * 4.0f;
+            }
+            size_t light_count = 256;
+
+            bool keys_down[GLFW_KEY_LAST + 1] = {};
+            auto key_pressed = [&](int key) {
+                bool is_down = glfwGetKey(window, key) == GLFW_PRESS;
+                bool pressed = is_down && !keys_down[key];
+                keys_down[key] = is_down;
+                return pressed;
+            };
+            int frames = 0;
+            double last_report = glfwGetTime();
+            std::cout << "+/- double or halve the lights (1 to " << max_lights << ")" << std::endl;
+
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            /* Loop until the user closes the window */
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+
+                // per-frame time logic
+                // --------------------
+                float currentFrame = glfwGetTime();
+                deltaTime = currentFrame - lastFrame;
+                lastFrame = currentFrame;
+
+                // input
+                // -----
+                processInput(window);
+                if (key_pressed(GLFW_KEY_EQUAL))
+                    light_count = std::min(light_count * 2, max_lights);
+                if (key_pressed(GLFW_KEY_MINUS))
+                    light_count = std::max<size_t>(light_count / 2, 1);
+
+                int width, height;
+                glfwGetFramebufferSize(window, &width, &height);
+                if (width != framebuffer_width || height != framebuffer_height)
+                {
+                    framebuffer_width = width;
+                    framebuffer_height = height;
+                    renderer.Create(framebuffer_width, framebuffer_height);
+                }
+
+                for (size_t i = 0; i < light_count; ++i)
+                {
+                    float angle = currentFrame * 0.7f + (float)i;
+                    lights[i].position = glm::vec3(orbits[i]) + glm::vec3(std::cos(angle), 0.0f, std::sin(angle)) * orbits[i].w;
+                }
+
+                glm::mat4 view_matrix = camera.GetViewMatrix();
+                glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)framebuffer_width / (float)framebuffer_height, 0.1f, 200.0f);
+
+                // geometry pass: every object once, whatever the number of lights
+                renderer.BeginGeometry();
+                geometry_shader.use();
+                geometry_shader.set<"view_matrix"_id>(view_matrix);
+                geometry_shader.set<"projection_matrix"_id>(projection_matrix);
+                geometry_shader.set<"shininess"_id>(64.0f);
+                textures.Use(container_diffuse_texture);
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_2D, container_diffuse_texture);
+                textures.Use(container_specular_texture);
+                glActiveTexture(GL_TEXTURE1);
+                glBindTexture(GL_TEXTURE_2D, container_specular_texture);
+                glActiveTexture(GL_TEXTURE0);
+                for (const glm::mat4& model : models)
+                {
+                    geometry_shader.set<"model_matrix"_id>(model);
+                    meshes.Draw(cube);
+                }
+                geometry_shader.set<"model_matrix"_id>(floor_model);
+                meshes.Draw(floor);
+                renderer.EndGeometry();
+
+                // lighting pass: every light once, over the pixels it reaches
+                renderer.Light(lights.data(), light_count, view_matrix, projection_matrix, camera.Position, glm::vec3(0.05f));
+                renderer.Present(framebuffer_width, framebuffer_height);
+
+                // trim the textures that were not used this frame back into the budget
+                textures.EndFrame();
+                ++frames;
+
+                if (glfwGetTime() - last_report > 1.0)
+                {
+                    double seconds = glfwGetTime() - last_report;
+                    last_report = glfwGetTime();
+                    Utility::render::GBufferFootprint footprint = renderer.Footprint();
+                    std::cout << light_count << " lights, " << footprint << ", "
+                              << (footprint.GeometryBytes() + footprint.LightingBytes()) * frames / seconds / (1024.0 * 1024.0 * 1024.0)
+                              << " GB/s G-buffer traffic at " << frames / seconds << " fps" << std::endl;
+                    frames = 0;
+                }
+
+                /* Swap front and back buffers */
+                glfwSwapBuffers(window);
+
+                /* Poll for and process events */
+                glfwPollEvents();
+            }
+        }
 
         glfwTerminate();
         return 0;
     }
+}
 
+namespace tutorials::lighting::shadows
+{
+    int CascadedShadows()
+    {
+        using namespace Utility::literals;
+
+        // Initialize the glfw & glew
+        GLFWwindow* window = Utility::GLFW::start_glfw();
+        glfwSetCursorPosCallback(window, mouse_callback);
+        glfwSetScrollCallback(window, scroll_callback);
+
+        // tell GLFW to capture our mouse
+        glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
 
-}
\ No newline at end of file
+        Utility::GLEW::start_glew();
+        glEnable(GL_DEPTH_TEST);
+
+        {
+            // ====================
+            //      MESHES
+            // ====================
+            const unsigned int attributes = Utility::mesh::Position | Utility::mesh::Normal | Utility::mesh::TexCoord;
+            Utility::mesh::MeshLibrary meshes;
+            Utility::mesh::MeshHandle cube = meshes.Get(Utility::mesh::Primitive::Cube, attributes);
+            Utility::mesh::MeshHandle floor = meshes.Get(Utility::mesh::Primitive::Plane, attributes);
+
+            // ====================
+            //      TEXTURE
+            // ====================
+            Utility::texture::ResidencyManager textures(64 * 1024 * 1024);
+            GLuint container_diffuse_texture = textures.Load("resources\\container2.png");
+            GLuint container_specular_texture = textures.Load("resources\\container2_specular.png");
+
+            // ====================
+            //      SHADERS
+            // ====================
+            auto object_shader = ShaderProgram(
+                "tutorials\\shaders\\lm_specular_map_object_vs.glsl",
+                "tutorials\\shaders\\shadowed_object_fs.glsl");
+            object_shader.use();
+            object_shader.setInt("diffuse_map", 0);
+            object_shader.setInt("specular_map", 1);
+
+            // The two far cascades keep the static field and are only drawn again when they must
+            Utility::render::CascadedShadowOptions shadow_options;
+            Utility::render::CascadedShadowMap shadows(shadow_options);
+            shadows.Create();
+            const GLuint shadow_unit = 2;
+            const char* cascade_sections[Utility::render::CascadedShadowOptions::kMaxCascades] = {
+                "shadow cascade 0", "shadow cascade 1", "shadow cascade 2", "shadow cascade 3" };
+            Utility::debug::GpuProfiler profiler;
+
+            // ====================
+            //  OBJECTS
+            // ====================
+            // Static containers of varied sizes over the field, with their bounding spheres for culling
+            const float field_size = 240.0f;
+            std::vector<glm::mat4> static_models;
+            std::vector<glm::vec4> static_bounds;     // center, radius
+            std::mt19937 rng(5);
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+            for (int i = 0; i < 2000; ++i)
+            {
+                float size = 0.5f + unit(rng) * unit(rng) * 6.0f;
+                glm::vec3 position((unit(rng) - 0.5f) * field_size, size * 0.5f, (unit(rng) - 0.5f) * field_size);
+                glm::mat4 model = glm::translate(glm::mat4(1.0f), position);
+                model = glm::rotate(model, unit(rng) * glm::pi<float>(), glm::vec3(0.0f, 1.0f, 0.0f));
+                static_models.push_back(glm::scale(model, glm::vec3(size)));
+                static_bounds.push_back(glm::vec4(position, size * 0.87f));
+            }
+            glm::mat4 floor_model = glm::scale(glm::mat4(1.0f), glm::vec3(field_size, 1.0f, field_size));
+            const glm::vec3 scene_min(-field_size * 0.5f, 0.0f, -field_size * 0.5f);
+            const glm::vec3 scene_max(field_size * 0.5f, 8.0f, field_size * 0.5f);
+
+            // A few moving containers near the start; they cast into the near cascades only
+            const int dynamic_count = 8;
+            std::vector<glm::mat4> dynamic_models(dynamic_count);
+            camera.Position = glm::vec3(0.0f, 4.0f, 12.0f);
+
+            bool keys_down[GLFW_KEY_LAST + 1] = {};
+            auto key_pressed = [&](int key) {
+                bool is_down = glfwGetKey(window, key) == GLFW_PRESS;
+                bool pressed = is_down && !keys_down[key];
+                keys_down[key] = is_down;
+                return pressed;
+            };
+            bool animate_light = false;
+            bool show_cascades = false;
+            float light_angle = 0.6f;
+            size_t drawn[Utility::render::CascadedShadowOptions::kMaxCascades] = {};
+            size_t culled[Utility::render::CascadedShadowOptions::kMaxCascades] = {};
+            int frames = 0;
+            double last_report = glfwGetTime();
+            std::cout << "L animates the sun, C shows the cascades, I invalidates the static cascades" << std::endl;
+
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            /* Loop until the user closes the window */
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+
+                // per-frame time logic
+                // --------------------
+                float currentFrame = glfwGetTime();
+                deltaTime = currentFrame - lastFrame;
+                lastFrame = currentFrame;
+
+                // input
+                // -----
+                processInput(window);
+                if (key_pressed(GLFW_KEY_L))
+                    animate_light = !animate_light;
+                if (key_pressed(GLFW_KEY_C))
+                    show_cascades = !show_cascades;
+                if (key_pressed(GLFW_KEY_I))
+                    shadows.InvalidateStatic();
+
+                int framebuffer_width, framebuffer_height;
+                glfwGetFramebufferSize(window, &framebuffer_width, &framebuffer_height);
+
+                if (animate_light)
+                    light_angle += deltaTime * 0.1f;
+                glm::vec3 light_direction = glm::normalize(glm::vec3(std::cos(light_angle), -1.2f, std::sin(light_angle)));
+
+                for (int i = 0; i < dynamic_count; ++i)
+                {
+                    float angle = currentFrame * 0.5f + i * glm::two_pi<float>() / dynamic_count;
+                    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(std::cos(angle) * 6.0f, 1.5f + std::sin(currentFrame + i), std::sin(angle) * 6.0f));
+                    dynamic_models[i] = glm::rotate(model, currentFrame + i, glm::vec3(0.3f, 1.0f, 0.2f));
+                }
+
+                float fov = glm::radians(camera.Zoom);
+                float aspect = (float)framebuffer_width / (float)std::max(framebuffer_height, 1);
+                glm::mat4 view_matrix = camera.GetViewMatrix();
+                glm::mat4 projection_matrix = glm::perspective(fov, aspect, 0.1f, 300.0f);
+
+                // ====================
+                //      SHADOW PASS
+                // ====================
+                profiler.BeginFrame();
+                shadows.Update(view_matrix, fov, aspect, 0.1f, 300.0f, light_direction, scene_min, scene_max);
+                for (unsigned int c = 0; c < shadows.Count(); ++c)
+                {
+                    const Utility::render::ShadowCascade& cascade = shadows.Cascade(c);
+                    if (!cascade.dirty)
+                        continue;
+
+                    profiler.Begin(cascade_sections[c]);
+                    shadows.BeginCascade(c);
+                    ShaderProgram& depth_shader = shadows.DepthShader();
+                    for (size_t i = 0; i < static_models.size(); ++i)
+                    {
+                        if (!cascade.frustum.IntersectsSphere(glm::vec3(static_bounds[i]), static_bounds[i].w))
+                        {
+                            ++culled[c];
+                            continue;
+                        }
+                        depth_shader.set<"model_matrix"_id>(static_models[i]);
+                        meshes.Draw(cube);
+                        ++drawn[c];
+                    }
+                    if (!cascade.cached)
+                    {
+                        for (const glm::mat4& model : dynamic_models)
+                        {
+                            if (!cascade.frustum.IntersectsSphere(glm::vec3(model[3]), 0.87f))
+                            {
+                                ++culled[c];
+                                continue;
+                            }
+                            depth_shader.set<"model_matrix"_id>(model);
+                            meshes.Draw(cube);
+                            ++drawn[c];
+                        }
+                    }
+                    profiler.End();
+                }
+                shadows.EndCascades(framebuffer_width, framebuffer_height);
+
+                // ====================
+                //      SCENE PASS
+                // ====================
+                profiler.Begin("scene");
+                glClearColor(0.45f, 0.6f, 0.8f, 1.0f);
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                object_shader.use();
+                object_shader.set<"view_matrix"_id>(view_matrix);
+                object_shader.set<"projection_matrix"_id>(projection_matrix);
+                object_shader.set<"camera_position"_id>(camera.Position);
+                object_shader.set<"light_direction"_id>(light_direction);
+                object_shader.set<"light_color"_id>(glm::vec3(1.0f, 0.95f, 0.85f));
+                object_shader.set<"ambient_color"_id>(glm::vec3(0.15f, 0.17f, 0.2f));
+                object_shader.set<"shininess"_id>(32.0f);
+                object_shader.set<"show_cascades"_id>(show_cascades);
+                shadows.Bind(object_shader, shadow_unit);
+
+                textures.Use(container_diffuse_texture);
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_2D, container_diffuse_texture);
+                textures.Use(container_specular_texture);
+                glActiveTexture(GL_TEXTURE1);
+                glBindTexture(GL_TEXTURE_2D, container_specular_texture);
+                glActiveTexture(GL_TEXTURE0);
+
+                Utility::Frustum view_frustum = Utility::Frustum::FromMatrix(projection_matrix * view_matrix);
+                for (size_t i = 0; i < static_models.size(); ++i)
+                {
+                    if (!view_frustum.IntersectsSphere(glm::vec3(static_bounds[i]), static_bounds[i].w))
+                        continue;
+                    object_shader.set<"model_matrix"_id>(static_models[i]);
+                    meshes.Draw(cube);
+                }
+                for (const glm::mat4& model : dynamic_models)
+                {
+                    object_shader.set<"model_matrix"_id>(model);
+                    meshes.Draw(cube);
+                }
+                object_shader.set<"model_matrix"_id>(floor_model);
+                meshes.Draw(floor);
+                profiler.End();
+
+                // trim the textures that were not used this frame back into the budget
+                textures.EndFrame();
+                ++frames;
+
+                if (glfwGetTime() - last_report > 1.0)
+                {
+                    last_report = glfwGetTime();
+                    std::cout << "GPU: " << profiler.Report() << std::endl;
+                    std::cout << "casters drawn/culled per frame:";
+                    for (unsigned int c = 0; c < shadows.Count(); ++c)
+                        std::cout << " " << drawn[c] / frames << "/" << culled[c] / frames;
+                    std::cout << ", " << shadows.Stats() << std::endl;
+                    profiler.ResetReport();
+                    std::fill(std::begin(drawn), std::end(drawn), 0);
+                    std::fill(std::begin(culled), std::end(culled), 0);
+                    frames = 0;
+                }
+
+                /* Swap front and back buffers */
+                glfwSwapBuffers(window);
+
+                /* Poll for and process events */
+                glfwPollEvents();
+            }
+        }
+
+        glfwTerminate();
+        return 0;
+    }
+}
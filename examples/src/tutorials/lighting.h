@@ -26,6 +26,20 @@ namespace tutorials::lighting::lighting_maps
 {
 	int DiffuseMap();
 	int SpecularMap();
+	// SpecularMap with the object cube in the packed (quantized) vertex format
+	int SpecularMapPacked();
+}
+
+namespace tutorials::lighting::deferred
+{
+	// Container cubes lit by up to 4096 point lights through a compact G-buffer and light volumes; +/- change the light count
+	int DeferredShading();
+}
+
+namespace tutorials::lighting::shadows
+{
+	// Container field lit by a sun through cascaded shadow maps, the far cascades cached; L animates the sun, C shows the cascades, I invalidates the cache
+	int CascadedShadows();
 }
 
 #endif // !_LIGHTING_H_
@@ -0,0 +1,1732 @@
+#include "rendering.h"
+#include <GLFW/glfw3.h>
+#include "../glfw_utils.h"
+#include "../glew_utils.h"
+#include <iostream>
+#include <chrono>
+#include "../ShaderType.h"
+#include "../ShaderProgram.h"
+#include "../camera.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "../mesh_library.h"
+#include "../mesh_lod.h"
+#include "../meshlet.h"
+#include "../mesh_optimizer.h"
+#include "../ring_buffer.h"
+#include "../indirect_draw.h"
+#include "../gpu_culling.h"
+#include "../transform_soa.h"
+#include "../scene_graph.h"
+#include "../frustum.h"
+#include "../command_buffer.h"
+#include "../job_system.h"
+#include "../frame_pipeline.h"
+#include "../allocation_counter.h"
+#include "../material_system.h"
+#include "../clustered_lighting.h"
+#include "../texture_residency.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <thread>
+
+namespace
+{
+    const unsigned int SCR_WIDTH = 800;
+    const unsigned int SCR_HEIGHT = 600;
+
+    // camera
+    Camera camera(glm::vec3(0.0f, 2.0f, 6.0f));
+    float lastX = SCR_WIDTH / 2.0f;
+    float lastY = SCR_HEIGHT / 2.0f;
+    bool firstMouse = true;
+
+    // timing
+    float deltaTime = 0.0f;
+    float lastFrame = 0.0f;
+
+    void processInput(GLFWwindow* window)
+    {
+        if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+            glfwSetWindowShouldClose(window, true);
+
+        if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
+            camera.ProcessKeyboard(FORWARD, deltaTime);
+        if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
+            camera.ProcessKeyboard(BACKWARD, deltaTime);
+        if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
+            camera.ProcessKeyboard(LEFT, deltaTime);
+        if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
+            camera.ProcessKeyboard(RIGHT, deltaTime);
+    }
+
+    // true once per key press
+    bool key_pressed(GLFWwindow* window, int key)
+    {
+        static bool down[GLFW_KEY_LAST + 1] = {};
+        bool is_down = glfwGetKey(window, key) == GLFW_PRESS;
+        bool pressed = is_down && !down[key];
+        down[key] = is_down;
+        return pressed;
+    }
+
+    void mouse_callback(GLFWwindow* window, double xpos, double ypos)
+    {
+        if (firstMouse)
+        {
+            lastX = xpos;
+            lastY = ypos;
+            firstMouse = false;
+        }
+
+        float xoffset = xpos - lastX;
+        float yoffset = lastY - ypos; // reversed since y-coordinates go from bottom to top
+
+        lastX = xpos;
+        lastY = ypos;
+
+        camera.ProcessMouseMovement(xoffset, yoffset);
+    }
+
+    void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
+    {
+        camera.ProcessMouseScroll(yoffset);
+    }
+
+    GLFWwindow* start_scene()
+    {
+        // Initialize the glfw & glew
+        GLFWwindow* window = Utility::GLFW::start_glfw();
+        glfwSetCursorPosCallback(window, mouse_callback);
+        glfwSetScrollCallback(window, scroll_callback);
+
+        // tell GLFW to capture our mouse
+        glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+
+        Utility::GLEW::start_glew();
+
+        // tell GL to only draw onto a pixel if the shape is closer to the viewer
+        glEnable(GL_DEPTH_TEST);
+        return window;
+    }
+
+    // per-frame time logic
+    void update_frame_time()
+    {
+        float currentFrame = glfwGetTime();
+        deltaTime = currentFrame - lastFrame;
+        lastFrame = currentFrame;
+    }
+}
+
+namespace tutorials::rendering
+{
+    int LodField()
+    {
+        GLFWwindow* window = start_scene();
+
+        // ====================
+        //      MESHES
+        // ====================
+        // Every level indexes the same vertices, so the library keeps one vertex range for all of them
+        Utility::mesh::MeshData sphere = Utility::mesh::sphere(Utility::mesh::Position | Utility::mesh::Normal, 0.5f, 256, 128);
+        std::vector<Utility::mesh::MeshLod> lods = Utility::mesh::generate_lods(sphere, 6);
+
+        std::vector<std::vector<unsigned int>> lod_indices;
+        std::vector<float> lod_errors;
+        for (const Utility::mesh::MeshLod& lod : lods)
+        {
+            lod_indices.push_back(lod.indices);
+            lod_errors.push_back(lod.error);
+            std::cout << "LOD " << lod_indices.size() - 1 << ": " << lod.indices.size() / 3 << " triangles, error " << lod.error << "\n";
+        }
+
+        // Everything owning GL objects lives in this block, so it is destroyed before glfwTerminate()
+        {
+            Utility::mesh::MeshLibrary meshes;
+            std::vector<Utility::mesh::MeshHandle> sphere_lods = meshes.AddLods(sphere, lod_indices);
+            std::cout << "vertex buffers: " << meshes.VertexReport() << "\nindex buffers: " << meshes.IndexReport() << "\n";
+            const float sphere_radius = 0.5f;
+
+            // ====================
+            //      SHADERS
+            // ====================
+            auto object_shader = ShaderProgram(
+                "tutorials\\shaders\\lighting_intro_object_vs.glsl",
+                "tutorials\\shaders\\lighting_intro_object_fs.glsl");
+
+            // ====================
+            //  LOD SETUP
+            // ====================
+            Utility::mesh::LodSelector selector;
+            selector.viewport_height = (float)SCR_HEIGHT;
+            selector.threshold = 1.0f;
+            Utility::mesh::LodStats stats;
+            bool use_lod = true;
+            double last_report = glfwGetTime();
+
+            const int grid_size = 32;
+            const float spacing = 2.0f;
+
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+                update_frame_time();
+                processInput(window);
+                if (key_pressed(window, GLFW_KEY_L))
+                    use_lod = !use_lod;
+
+                glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                glm::mat4 view_matrix = camera.GetViewMatrix();
+                glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 200.0f);
+                selector.fov_y = glm::radians(camera.Zoom);
+
+                object_shader.use();
+                object_shader.setMat4("view_matrix", view_matrix);
+                object_shader.setMat4("projection_matrix", projection_matrix);
+                object_shader.setVec3("the_object.color", 1.0f, 0.5f, 0.31f);
+                object_shader.setFloat("the_object.ambient_strength", 0.1f);
+                object_shader.setFloat("the_object.specular_strength", 0.5f);
+                object_shader.setFloat("the_object.shininess", 32.0f);
+                object_shader.setVec3("light_source.position", 0.0f, 10.0f, 0.0f);
+                object_shader.setVec3("light_source.color", 1.0f, 1.0f, 1.0f);
+                object_shader.setVec3("camera_position", camera.Position);
+
+                stats.Reset();
+                size_t full_triangles = lod_indices[0].size() / 3;
+                for (int z = 0; z < grid_size; ++z)
+                {
+                    for (int x = 0; x < grid_size; ++x)
+                    {
+                        glm::vec3 center((x - grid_size / 2) * spacing, 0.0f, -z * spacing);
+                        unsigned int lod = use_lod ? selector.Select(lod_errors, 1.0f, center, sphere_radius, camera.Position) : 0;
+                        stats.Add(lod, lod_indices[lod].size() / 3, full_triangles);
+
+                        object_shader.setMat4("model_matrix", glm::translate(glm::mat4(1.0f), center));
+                        meshes.Draw(sphere_lods[lod]);
+                    }
+                }
+
+                // triangles per frame, once a second
+                if (glfwGetTime() - last_report > 1.0)
+                {
+                    last_report = glfwGetTime();
+                    std::cout << (use_lod ? "LOD on:  " : "LOD off: ") << stats << std::endl;
+                }
+
+                glfwSwapBuffers(window);
+                glfwPollEvents();
+            }
+        }
+
+        glfwTerminate();
+        return 0;
+    }
+
+    int MeshletCulling()
+    {
+        GLFWwindow* window = start_scene();
+
+        // ====================
+        //      MESHES
+        // ====================
+        Utility::mesh::MeshData sphere = Utility::mesh::sphere(Utility::mesh::Position | Utility::mesh::Normal, 2.0f, 1024, 512);
+        Utility::mesh::optimize_vertex_cache(sphere.indices, sphere.VertexCount());
+        Utility::mesh::MeshletMesh meshlets = Utility::mesh::build_meshlets(sphere);
+        std::cout << meshlets.meshlets.size() << " meshlets for " << sphere.indices.size() / 3 << " triangles\n";
+
+        {
+            // The range owns the full index list, culled index lists are written over its start every frame
+            Utility::mesh::MeshLibrary meshes;
+            Utility::mesh::MeshHandle sphere_range = meshes.AddLods(sphere, { sphere.indices })[0];
+
+            // ====================
+            //      SHADERS
+            // ====================
+            auto object_shader = ShaderProgram(
+                "tutorials\\shaders\\lighting_intro_object_vs.glsl",
+                "tutorials\\shaders\\lighting_intro_object_fs.glsl");
+
+            std::vector<unsigned int> visible_indices;
+            visible_indices.reserve(sphere.indices.size());
+            Utility::mesh::MeshletCullStats stats;
+            bool use_culling = true;
+            double last_report = glfwGetTime();
+            const glm::mat4 model_matrix(1.0f);
+
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+                update_frame_time();
+                processInput(window);
+                if (key_pressed(window, GLFW_KEY_C))
+                {
+                    use_culling = !use_culling;
+                    if (!use_culling)
+                        meshes.UpdateIndices(sphere_range, sphere.indices);
+                }
+
+                glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                glm::mat4 view_matrix = camera.GetViewMatrix();
+                glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 200.0f);
+
+                Utility::mesh::MeshHandle handle = sphere_range;
+                stats = Utility::mesh::MeshletCullStats();
+                if (use_culling)
+                {
+                    visible_indices.clear();
+                    Utility::Frustum frustum = Utility::Frustum::FromMatrix(projection_matrix * view_matrix);
+                    Utility::mesh::cull_meshlets(meshlets, model_matrix, frustum, camera.Position, visible_indices, &stats);
+                    handle = meshes.UpdateIndices(sphere_range, visible_indices);
+                }
+
+                object_shader.use();
+                object_shader.setMat4("model_matrix", model_matrix);
+                object_shader.setMat4("view_matrix", view_matrix);
+                object_shader.setMat4("projection_matrix", projection_matrix);
+                object_shader.setVec3("the_object.color", 1.0f, 0.5f, 0.31f);
+                object_shader.setFloat("the_object.ambient_strength", 0.1f);
+                object_shader.setFloat("the_object.specular_strength", 0.5f);
+                object_shader.setFloat("the_object.shininess", 32.0f);
+                object_shader.setVec3("light_source.position", 0.0f, 10.0f, 10.0f);
+                object_shader.setVec3("light_source.color", 1.0f, 1.0f, 1.0f);
+                object_shader.setVec3("camera_position", camera.Position);
+                meshes.Draw(handle);
+
+                if (glfwGetTime() - last_report > 1.0)
+                {
+                    last_report = glfwGetTime();
+                    if (use_culling)
+                        std::cout << stats << std::endl;
+                    else
+                        std::cout << "culling off: " << sphere.indices.size() / 3 << " triangles" << std::endl;
+                }
+
+                glfwSwapBuffers(window);
+                glfwPollEvents();
+            }
+        }
+
+        glfwTerminate();
+        return 0;
+    }
+
+    int StreamedCubes()
+    {
+        GLFWwindow* window = start_scene();
+
+        {
+            // ====================
+            //      MESHES
+            // ====================
+            Utility::mesh::MeshLibrary meshes;
+            // A vertex array of the cube's own takes the instance matrices at locations 2-5, the block's shared one stays as it is
+            Utility::mesh::MeshHandle cube = meshes.InstanceStream(meshes.Get(Utility::mesh::Primitive::Cube, Utility::mesh::Position | Utility::mesh::Normal));
+
+            // ====================
+            //      SHADERS
+            // ====================
+            auto object_shader = ShaderProgram(
+                "tutorials\\shaders\\streamed_instances_vs.glsl",
+                "tutorials\\shaders\\lighting_intro_object_fs.glsl");
+            const GLuint frame_data_binding = 0;
+            glUniformBlockBinding(object_shader.Id(), glGetUniformBlockIndex(object_shader.Id(), "FrameData"), frame_data_binding);
+
+            // ====================
+            //  RING BUFFER SETUP
+            // ====================
+            // Instance matrices and the frame uniform block share one ring
+            const int grid_size = 64;
+            const int instance_count = grid_size * grid_size;
+            const size_t uniform_alignment = Utility::RingBuffer::UniformAlignment();
+            const size_t frame_bytes = instance_count * sizeof(glm::mat4) + 2 * sizeof(glm::mat4) + uniform_alignment;
+
+            bool force_orphaning = false;
+            Utility::RingBuffer ring;
+            ring.Create(GL_ARRAY_BUFFER, frame_bytes, force_orphaning);
+            double last_report = glfwGetTime();
+
+            // Transforms live in structure of arrays form and are composed with SIMD straight into the ring
+            Utility::TransformSoA transforms;
+            transforms.Reserve(instance_count);
+            for (int z = 0; z < grid_size; ++z)
+            {
+                for (int x = 0; x < grid_size; ++x)
+                    transforms.Add(glm::vec3((x - grid_size / 2) * 1.5f, 0.0f, -z * 1.5f));
+            }
+            const glm::vec3 spin_axis = glm::normalize(glm::vec3(0.5f, 1.0f, 0.0f));
+            std::cout << "composing transforms with " << Utility::to_string(Utility::best_simd_path()) << std::endl;
+
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+                update_frame_time();
+                processInput(window);
+                if (key_pressed(window, GLFW_KEY_O))
+                {
+                    force_orphaning = !force_orphaning;
+                    ring.Create(GL_ARRAY_BUFFER, frame_bytes, force_orphaning);
+                }
+
+                glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                ring.BeginFrame();
+
+                // Frame uniforms
+                glm::mat4 frame_data[2] = {
+                    camera.GetViewMatrix(),
+                    glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 200.0f)
+                };
+                Utility::RingBuffer::Allocation frame_uniforms = ring.Write(frame_data, sizeof(frame_data), uniform_alignment);
+
+                // Every transform is recomputed and written straight into the mapped region
+                Utility::RingBuffer::Allocation instances = ring.Allocate(instance_count * sizeof(glm::mat4), sizeof(glm::mat4));
+                float time = (float)glfwGetTime();
+                for (int z = 0; z < grid_size; ++z)
+                {
+                    for (int x = 0; x < grid_size; ++x)
+                        transforms.SetRotation(z * grid_size + x, glm::angleAxis(time + 0.1f * (x + z), spin_axis));
+                }
+                if (instances.Valid())
+                    transforms.ComposeMatrices(instances.data, 0, instance_count);
+                ring.Flush();
+
+                object_shader.use();
+                object_shader.setVec3("the_object.color", 1.0f, 0.5f, 0.31f);
+                object_shader.setFloat("the_object.ambient_strength", 0.1f);
+                object_shader.setFloat("the_object.specular_strength", 0.5f);
+                object_shader.setFloat("the_object.shininess", 32.0f);
+                object_shader.setVec3("light_source.position", 0.0f, 10.0f, 0.0f);
+                object_shader.setVec3("light_source.color", 1.0f, 1.0f, 1.0f);
+                object_shader.setVec3("camera_position", camera.Position);
+
+                if (frame_uniforms.Valid() && instances.Valid())
+                {
+                    ring.BindRange(GL_UNIFORM_BUFFER, frame_data_binding, frame_uniforms);
+
+                    // The instance attributes move with the region, so they are pointed at it every frame
+                    glBindVertexArray(cube.vao);
+                    glBindBuffer(GL_ARRAY_BUFFER, ring.Buffer());
+                    for (GLuint column = 0; column < 4; ++column)
+                    {
+                        glVertexAttribPointer(2 + column, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (GLvoid*)(instances.offset + column * sizeof(glm::vec4)));
+                        glVertexAttribDivisor(2 + column, 1);
+                        glEnableVertexAttribArray(2 + column);
+                    }
+                    glBindBuffer(GL_ARRAY_BUFFER, 0);
+                    meshes.DrawInstanced(cube, instance_count);
+                }
+
+                ring.EndFrame();
+
+                if (glfwGetTime() - last_report > 1.0)
+                {
+                    last_report = glfwGetTime();
+                    const Utility::RingBuffer::Stats& stats = ring.GetStats();
+                    std::cout << (ring.GetMode() == Utility::RingBuffer::Mode::Persistent ? "persistent" : "orphaning") << ": "
+                              << stats.frames << " frames, " << stats.fence_waits << " fence waits (" << stats.wait_milliseconds << " ms), peak "
+                              << stats.peak_frame_bytes / 1024.0 << " KB per frame" << std::endl;
+                }
+
+                glfwSwapBuffers(window);
+                glfwPollEvents();
+            }
+        }
+
+        glfwTerminate();
+        return 0;
+    }
+
+    int SceneHierarchy()
+    {
+        GLFWwindow* window = start_scene();
+
+        {
+            // ====================
+            //      MESHES
+            // ====================
+            Utility::mesh::MeshLibrary meshes;
+            // Own vertex array for the instance matrices, see StreamedCubes
+            Utility::mesh::MeshHandle cube = meshes.InstanceStream(meshes.Get(Utility::mesh::Primitive::Cube, Utility::mesh::Position | Utility::mesh::Normal));
+
+            // ====================
+            //      SHADERS
+            // ====================
+            auto object_shader = ShaderProgram(
+                "tutorials\\shaders\\streamed_instances_vs.glsl",
+                "tutorials\\shaders\\lighting_intro_object_fs.glsl");
+            const GLuint frame_data_binding = 0;
+            glUniformBlockBinding(object_shader.Id(), glGetUniformBlockIndex(object_shader.Id(), "FrameData"), frame_data_binding);
+
+            // ====================
+            //     SCENE GRAPH
+            // ====================
+            // A static field that is never touched after the first update, and a spinning rig: arms
+            // around a pivot, each carrying a ring of cubes with a small light source cube on top
+            typedef Utility::SceneGraph::NodeId NodeId;
+            Utility::SceneGraph graph;
+            const int field_size = 100;
+            NodeId field = graph.Create();
+            for (int z = 0; z < field_size; ++z)
+            {
+                for (int x = 0; x < field_size; ++x)
+                    graph.Create(field, glm::vec3((x - field_size / 2) * 2.0f, -3.0f, -z * 2.0f), glm::quat(), glm::vec3(0.5f));
+            }
+
+            const int arm_count = 8, cubes_per_arm = 8;
+            NodeId pivot = graph.Create(Utility::SceneGraph::kInvalidNode, glm::vec3(0.0f, 0.0f, -20.0f));
+            std::vector<NodeId> arms, carriers;
+            for (int a = 0; a < arm_count; ++a)
+            {
+                float angle = glm::radians(360.0f / arm_count * a);
+                NodeId arm = graph.Create(pivot, glm::vec3(0.0f), glm::angleAxis(angle, glm::vec3(0.0f, 1.0f, 0.0f)));
+                arms.push_back(arm);
+                for (int c = 0; c < cubes_per_arm; ++c)
+                {
+                    NodeId carrier = graph.Create(arm, glm::vec3(3.0f + c * 1.5f, 0.0f, 0.0f), glm::quat(), glm::vec3(0.6f));
+                    carriers.push_back(carrier);
+                    // The light source follows its carrier instead of being re-translated every frame
+                    graph.Create(carrier, glm::vec3(0.0f, 1.2f, 0.0f), glm::quat(), glm::vec3(0.4f));
+                }
+            }
+            const GLsizei instance_count = (GLsizei)graph.Size();
+
+            // ====================
+            //  RING BUFFER SETUP
+            // ====================
+            const size_t uniform_alignment = Utility::RingBuffer::UniformAlignment();
+            const size_t frame_bytes = instance_count * sizeof(glm::mat4) + 2 * sizeof(glm::mat4) + uniform_alignment;
+            Utility::RingBuffer ring;
+            ring.Create(GL_ARRAY_BUFFER, frame_bytes);
+            bool animate = true;
+            double last_report = glfwGetTime();
+            Utility::SceneUpdateReport report;
+
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+                update_frame_time();
+                processInput(window);
+                if (key_pressed(window, GLFW_KEY_P))
+                    animate = !animate;
+
+                // Only the rig is dirtied, the field costs nothing after the first frame
+                float time = (float)glfwGetTime();
+                if (animate)
+                {
+                    graph.SetRotation(pivot, glm::angleAxis(0.3f * time, glm::vec3(0.0f, 1.0f, 0.0f)));
+                    for (size_t a = 0; a < arms.size(); ++a)
+                        graph.SetPosition(arms[a], glm::vec3(0.0f, std::sin(time + (float)a), 0.0f));
+                    for (size_t c = 0; c < carriers.size(); ++c)
+                        graph.SetRotation(carriers[c], glm::angleAxis(2.0f * time + 0.2f * c, glm::vec3(0.5f, 1.0f, 0.0f)));
+                }
+                Utility::SceneUpdateReport update = graph.Update();
+                if (update.updated_nodes)
+                    report = update;
+
+                glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                ring.BeginFrame();
+                glm::mat4 frame_data[2] = {
+                    camera.GetViewMatrix(),
+                    glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 300.0f)
+                };
+                Utility::RingBuffer::Allocation frame_uniforms = ring.Write(frame_data, sizeof(frame_data), uniform_alignment);
+                // World matrices are contiguous in depth first order: one copy, one instanced draw
+                Utility::RingBuffer::Allocation instances = ring.Write(graph.WorldMatrices().data(), instance_count * sizeof(glm::mat4), sizeof(glm::mat4));
+                ring.Flush();
+
+                object_shader.use();
+                object_shader.setVec3("the_object.color", 1.0f, 0.5f, 0.31f);
+                object_shader.setFloat("the_object.ambient_strength", 0.1f);
+                object_shader.setFloat("the_object.specular_strength", 0.5f);
+                object_shader.setFloat("the_object.shininess", 32.0f);
+                object_shader.setVec3("light_source.position", graph.WorldPosition(pivot) + glm::vec3(0.0f, 10.0f, 0.0f));
+                object_shader.setVec3("light_source.color", 1.0f, 1.0f, 1.0f);
+                object_shader.setVec3("camera_position", camera.Position);
+
+                if (frame_uniforms.Valid() && instances.Valid())
+                {
+                    ring.BindRange(GL_UNIFORM_BUFFER, frame_data_binding, frame_uniforms);
+                    glBindVertexArray(cube.vao);
+                    glBindBuffer(GL_ARRAY_BUFFER, ring.Buffer());
+                    for (GLuint column = 0; column < 4; ++column)
+                    {
+                        glVertexAttribPointer(2 + column, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (GLvoid*)(instances.offset + column * sizeof(glm::vec4)));
+                        glVertexAttribDivisor(2 + column, 1);
+                        glEnableVertexAttribArray(2 + column);
+                    }
+                    glBindBuffer(GL_ARRAY_BUFFER, 0);
+                    meshes.DrawInstanced(cube, instance_count);
+                }
+
+                ring.EndFrame();
+
+                if (glfwGetTime() - last_report > 1.0)
+                {
+                    last_report = glfwGetTime();
+                    std::cout << graph.Size() << " nodes, last update: " << report << std::endl;
+                }
+
+                glfwSwapBuffers(window);
+                glfwPollEvents();
+            }
+        }
+
+        glfwTerminate();
+        return 0;
+    }
+
+    int IndirectObjects()
+    {
+        using namespace Utility::literals;
+        GLFWwindow* window = start_scene();
+
+        {
+            // ====================
+            //      MESHES
+            // ====================
+            const unsigned int attributes = Utility::mesh::Position | Utility::mesh::Normal;
+            Utility::mesh::MeshLibrary meshes;
+            Utility::mesh::MeshHandle shapes[] = {
+                meshes.Get(Utility::mesh::Primitive::Cube, attributes),
+                meshes.Get(Utility::mesh::Primitive::Sphere, attributes),
+                meshes.Get(Utility::mesh::Primitive::Cylinder, attributes)
+            };
+
+            // ====================
+            //      SHADERS
+            // ====================
+            auto loop_shader = ShaderProgram(
+                "tutorials\\shaders\\lighting_intro_object_vs.glsl",
+                "tutorials\\shaders\\lighting_intro_object_fs.glsl");
+            bool draw_parameters = Utility::mesh::IndirectDrawBatch::ShaderDrawParametersSupported();
+            auto indirect_shader = ShaderProgram(
+                draw_parameters ? "tutorials\\shaders\\indirect_draw_params_vs.glsl" : "tutorials\\shaders\\indirect_draw_vs.glsl",
+                "tutorials\\shaders\\indirect_draw_fs.glsl");
+
+            const glm::vec3 material_colors[8] = {
+                { 1.0f, 0.5f, 0.31f }, { 0.3f, 0.7f, 1.0f }, { 0.4f, 0.9f, 0.4f }, { 0.9f, 0.9f, 0.3f },
+                { 0.8f, 0.4f, 0.9f }, { 0.9f, 0.3f, 0.3f }, { 0.6f, 0.6f, 0.6f }, { 0.3f, 0.9f, 0.8f }
+            };
+
+            // ====================
+            //  OBJECTS
+            // ====================
+            const int grid_size = 128;
+            struct Object
+            {
+                glm::mat4 model;
+                unsigned int shape;
+                unsigned int material;
+            };
+            std::vector<Object> objects;
+            for (int z = 0; z < grid_size; ++z)
+            {
+                for (int x = 0; x < grid_size; ++x)
+                {
+                    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3((x - grid_size / 2) * 1.5f, 0.0f, -z * 1.5f));
+                    objects.push_back({ model, (unsigned int)(x + z) % 3, (unsigned int)(x * 3 + z) % 8 });
+                }
+            }
+
+            Utility::mesh::IndirectDrawBatch batch;
+            batch.Create(objects.size());
+            std::cout << "multi draw indirect " << (batch.MultiDrawSupported() ? "supported" : "not supported, replaying commands")
+                      << ", per draw data through " << (draw_parameters ? "gl_BaseInstanceARB" : "the draw id attribute") << std::endl;
+
+            bool use_indirect = true;
+            double submit_ms = 0.0;
+            int frames = 0;
+            double last_report = glfwGetTime();
+            unsigned long long last_allocations = Utility::debug::allocation_count();
+
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+                update_frame_time();
+                processInput(window);
+                if (key_pressed(window, GLFW_KEY_M))
+                    use_indirect = !use_indirect;
+
+                glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                glm::mat4 view_matrix = camera.GetViewMatrix();
+                glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 300.0f);
+
+                // CPU cost of recording and submitting the objects, the part multi draw indirect removes
+                auto submit_start = std::chrono::steady_clock::now();
+                if (use_indirect)
+                {
+                    batch.Clear();
+                    for (const Object& object : objects)
+                        batch.Add(shapes[object.shape], object.model, object.material);
+                    batch.Upload();
+
+                    indirect_shader.use();
+                    indirect_shader.setMat4("view_matrix", view_matrix);
+                    indirect_shader.setMat4("projection_matrix", projection_matrix);
+                    glUniform3fv(indirect_shader.Location("material_colors"), 8, &material_colors[0][0]);
+                    indirect_shader.setVec3("light_source.position", 0.0f, 10.0f, 0.0f);
+                    indirect_shader.setVec3("light_source.color", 1.0f, 1.0f, 1.0f);
+                    indirect_shader.setVec3("camera_position", camera.Position);
+                    indirect_shader.setInt("draw_data", 0);
+                    batch.BindDrawData(0);
+                    batch.Draw();
+                }
+                else
+                {
+                    loop_shader.use();
+                    loop_shader.setMat4("view_matrix", view_matrix);
+                    loop_shader.setMat4("projection_matrix", projection_matrix);
+                    loop_shader.setFloat("the_object.ambient_strength", 0.1f);
+                    loop_shader.setFloat("the_object.specular_strength", 0.5f);
+                    loop_shader.setFloat("the_object.shininess", 32.0f);
+                    loop_shader.setVec3("light_source.position", 0.0f, 10.0f, 0.0f);
+                    loop_shader.setVec3("light_source.color", 1.0f, 1.0f, 1.0f);
+                    loop_shader.setVec3("camera_position", camera.Position);
+                    // Per object uniforms through compile time ids: an index instead of a name lookup
+                    for (const Object& object : objects)
+                    {
+                        loop_shader.set<"model_matrix"_id>(object.model);
+                        loop_shader.set<"the_object.color"_id>(material_colors[object.material]);
+                        meshes.Draw(shapes[object.shape]);
+                    }
+                }
+                submit_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - submit_start).count();
+                ++frames;
+
+                if (glfwGetTime() - last_report > 1.0)
+                {
+                    double seconds = glfwGetTime() - last_report;
+                    last_report = glfwGetTime();
+                    unsigned long long allocations = Utility::debug::allocation_count();
+                    std::cout << (use_indirect ? "indirect: " : "loop:     ") << objects.size() << " draws in "
+                              << (use_indirect ? batch.SubmittedCalls() : objects.size()) << " calls, " << submit_ms / frames << " ms CPU submit, "
+                              << objects.size() * frames / seconds << " draws/s at " << frames / seconds << " fps";
+                    if (Utility::debug::allocations_counted())
+                        std::cout << ", " << (double)(allocations - last_allocations) / frames << " allocations per frame";
+                    std::cout << std::endl;
+                    last_allocations = Utility::debug::allocation_count();
+                    submit_ms = 0.0;
+                    frames = 0;
+                }
+
+                glfwSwapBuffers(window);
+                glfwPollEvents();
+            }
+        }
+
+        glfwTerminate();
+        return 0;
+    }
+
+    int GpuCulledField()
+    {
+        GLFWwindow* window = start_scene();
+        if (!Utility::mesh::GpuCulling::Supported())
+        {
+            std::cerr << "GPU culling needs compute shaders, shader storage buffers and multi draw indirect (GL 4.3)" << std::endl;
+            glfwTerminate();
+            return -1;
+        }
+
+        {
+            // ====================
+            //      MESHES
+            // ====================
+            const unsigned int attributes = Utility::mesh::Position | Utility::mesh::Normal;
+            Utility::mesh::MeshLibrary meshes;
+            std::vector<Utility::mesh::MeshHandle> shapes = {
+                meshes.Get(Utility::mesh::Primitive::Cube, attributes),
+                meshes.Get(Utility::mesh::Primitive::Sphere, attributes)
+            };
+            const float shape_radius[] = { 0.8660254f, 0.5f };
+
+            // ====================
+            //      SHADERS
+            // ====================
+            auto object_shader = ShaderProgram(
+                "tutorials\\shaders\\gpu_culled_vs.glsl",
+                "tutorials\\shaders\\indirect_draw_fs.glsl");
+            auto screen_shader = ShaderProgram(
+                "tutorials\\shaders\\fullscreen_vs.glsl",
+                "tutorials\\shaders\\fullscreen_texture_fs.glsl");
+
+            const glm::vec3 material_colors[8] = {
+                { 1.0f, 0.5f, 0.31f }, { 0.3f, 0.7f, 1.0f }, { 0.4f, 0.9f, 0.4f }, { 0.9f, 0.9f, 0.3f },
+                { 0.8f, 0.4f, 0.9f }, { 0.9f, 0.3f, 0.3f }, { 0.6f, 0.6f, 0.6f }, { 0.3f, 0.9f, 0.8f }
+            };
+
+            // ====================
+            //  INSTANCES
+            // ====================
+            // A 512x512 field with a wall across it every 32 rows for the occlusion test to work with
+            const int grid_size = 512;
+            const float spacing = 1.5f;
+            std::vector<Utility::mesh::GpuInstance> instances;
+            instances.reserve(grid_size * grid_size + grid_size / 32);
+            for (int z = 0; z < grid_size; ++z)
+            {
+                for (int x = 0; x < grid_size; ++x)
+                {
+                    Utility::mesh::GpuInstance instance;
+                    instance.mesh = (x + z) % 2;
+                    instance.material = (x * 3 + z) % 8;
+                    instance.model = glm::translate(glm::mat4(1.0f), glm::vec3((x - grid_size / 2) * spacing, 0.0f, -z * spacing));
+                    instance.bounds = glm::vec4(0.0f, 0.0f, 0.0f, shape_radius[instance.mesh]);
+                    instances.push_back(instance);
+                }
+            }
+            for (int z = 16; z < grid_size; z += 32)
+            {
+                Utility::mesh::GpuInstance wall;
+                wall.mesh = 0;
+                wall.material = 6;
+                wall.model = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 2.0f, -z * spacing)), glm::vec3(grid_size * spacing, 6.0f, 0.5f));
+                wall.bounds = glm::vec4(0.0f, 0.0f, 0.0f, shape_radius[0]);
+                instances.push_back(wall);
+            }
+
+            Utility::mesh::GpuCulling culling;
+            culling.Create(shapes);
+            culling.SetInstances(instances);
+
+            // ====================
+            //  FRAMEBUFFER + HI-Z
+            // ====================
+            // The scene goes into a depth texture the pyramid is built from, then onto the screen
+            GLuint fbo, color_texture, depth_texture;
+            glGenFramebuffers(1, &fbo);
+            glGenTextures(1, &color_texture);
+            glBindTexture(GL_TEXTURE_2D, color_texture);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, SCR_WIDTH, SCR_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glGenTextures(1, &depth_texture);
+            glBindTexture(GL_TEXTURE_2D, depth_texture);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32F, SCR_WIDTH, SCR_HEIGHT, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            glBindTexture(GL_TEXTURE_2D, 0);
+            glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color_texture, 0);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depth_texture, 0);
+            if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+                std::cerr << "ERROR::FRAMEBUFFER:: Framebuffer is not complete!" << std::endl;
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+            Utility::mesh::HiZPyramid hiz;
+            hiz.Create(SCR_WIDTH, SCR_HEIGHT);
+            bool hiz_valid = false;
+            GLuint screen_vao;
+            glGenVertexArrays(1, &screen_vao);
+
+            Utility::mesh::GpuCullingOptions options;
+            glm::mat4 previous_view_projection(1.0f);
+            double last_report = glfwGetTime();
+
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+                update_frame_time();
+                processInput(window);
+                if (key_pressed(window, GLFW_KEY_H))
+                    options.occlusion = !options.occlusion;
+                if (key_pressed(window, GLFW_KEY_F))
+                    options.frustum = !options.frustum;
+
+                glm::mat4 view_matrix = camera.GetViewMatrix();
+                glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 500.0f);
+                glm::mat4 view_projection = projection_matrix * view_matrix;
+
+                // Cull against this frame's frustum and last frame's depth
+                culling.Cull(view_projection, previous_view_projection, hiz_valid ? &hiz : nullptr, options);
+
+                glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+                glViewport(0, 0, SCR_WIDTH, SCR_HEIGHT);
+                glEnable(GL_DEPTH_TEST);
+                glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                object_shader.use();
+                object_shader.setMat4("view_matrix", view_matrix);
+                object_shader.setMat4("projection_matrix", projection_matrix);
+                glUniform3fv(object_shader.Location("material_colors"), 8, &material_colors[0][0]);
+                object_shader.setVec3("light_source.position", 0.0f, 50.0f, 0.0f);
+                object_shader.setVec3("light_source.color", 1.0f, 1.0f, 1.0f);
+                object_shader.setVec3("camera_position", camera.Position);
+                culling.Draw();
+
+                // Pyramid for the next frame
+                hiz.Build(depth_texture);
+                hiz_valid = true;
+                previous_view_projection = view_projection;
+
+                // Present
+                int framebuffer_width, framebuffer_height;
+                glfwGetFramebufferSize(window, &framebuffer_width, &framebuffer_height);
+                glBindFramebuffer(GL_FRAMEBUFFER, 0);
+                glViewport(0, 0, framebuffer_width, framebuffer_height);
+                glDisable(GL_DEPTH_TEST);
+                screen_shader.use();
+                screen_shader.setInt("screen_texture", 0);
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_2D, color_texture);
+                glBindVertexArray(screen_vao);
+                glDrawArrays(GL_TRIANGLES, 0, 3);
+                glBindVertexArray(0);
+
+                if (glfwGetTime() - last_report > 1.0)
+                {
+                    last_report = glfwGetTime();
+                    size_t visible = culling.ReadVisibleCount();
+                    std::cout << visible << "/" << culling.InstanceCount() << " instances drawn (frustum " << (options.frustum ? "on" : "off")
+                              << ", Hi-Z " << (options.occlusion ? "on" : "off") << ")";
+                    // Without occlusion the GPU count has to match the CPU reference exactly
+                    if (options.frustum && !options.occlusion)
+                    {
+                        size_t expected = Utility::mesh::count_visible_instances(instances, Utility::Frustum::FromMatrix(view_projection));
+                        std::cout << (visible == expected ? ", matches" : ", MISMATCH with") << " CPU reference " << expected;
+                    }
+                    std::cout << std::endl;
+                }
+
+                glfwSwapBuffers(window);
+                glfwPollEvents();
+            }
+
+            glDeleteVertexArrays(1, &screen_vao);
+            glDeleteFramebuffers(1, &fbo);
+            glDeleteTextures(1, &color_texture);
+            glDeleteTextures(1, &depth_texture);
+        }
+
+        glfwTerminate();
+        return 0;
+    }
+
+    int RecordedCommands()
+    {
+        GLFWwindow* window = start_scene();
+
+        {
+            // ====================
+            //      MESHES
+            // ====================
+            const unsigned int attributes = Utility::mesh::Position | Utility::mesh::Normal;
+            Utility::mesh::MeshLibrary meshes;
+            Utility::mesh::MeshHandle shapes[] = {
+                meshes.Get(Utility::mesh::Primitive::Cube, attributes),
+                meshes.Get(Utility::mesh::Primitive::Sphere, attributes),
+                meshes.Get(Utility::mesh::Primitive::Cylinder, attributes)
+            };
+
+            // ====================
+            //      SHADERS
+            // ====================
+            auto shader = ShaderProgram(
+                "tutorials\\shaders\\lighting_intro_object_vs.glsl",
+                "tutorials\\shaders\\lighting_intro_object_fs.glsl");
+
+            // Locations are looked up here once: workers record numbers, never names
+            using namespace Utility::literals;
+            struct Locations
+            {
+                GLint model, view, projection, color, ambient, specular, shininess, light_position, light_color, camera_position;
+            } locations;
+            locations.model = shader.Location("model_matrix"_id);
+            locations.view = shader.Location("view_matrix"_id);
+            locations.projection = shader.Location("projection_matrix"_id);
+            locations.color = shader.Location("the_object.color"_id);
+            locations.ambient = shader.Location("the_object.ambient_strength"_id);
+            locations.specular = shader.Location("the_object.specular_strength"_id);
+            locations.shininess = shader.Location("the_object.shininess"_id);
+            locations.light_position = shader.Location("light_source.position"_id);
+            locations.light_color = shader.Location("light_source.color"_id);
+            locations.camera_position = shader.Location("camera_position"_id);
+
+            const glm::vec3 material_colors[8] = {
+                { 1.0f, 0.5f, 0.31f }, { 0.3f, 0.7f, 1.0f }, { 0.4f, 0.9f, 0.4f }, { 0.9f, 0.9f, 0.3f },
+                { 0.8f, 0.4f, 0.9f }, { 0.9f, 0.3f, 0.3f }, { 0.6f, 0.6f, 0.6f }, { 0.3f, 0.9f, 0.8f }
+            };
+
+            // ====================
+            //  OBJECTS
+            // ====================
+            const int grid_size = 128;
+            struct Object
+            {
+                glm::vec3 position;
+                unsigned int shape;
+                unsigned int material;
+            };
+            std::vector<Object> objects;
+            for (int z = 0; z < grid_size; ++z)
+            {
+                for (int x = 0; x < grid_size; ++x)
+                    objects.push_back({ glm::vec3((x - grid_size / 2) * 1.5f, 0.0f, -z * 1.5f), (unsigned int)(x + z) % 3, (unsigned int)(x * 3 + z) % 8 });
+            }
+
+            auto model_at = [](const Object& object, float time) {
+                float height = 0.25f * std::sin(time * 2.0f + object.position.x * 0.3f + object.position.z * 0.2f);
+                return glm::translate(glm::mat4(1.0f), object.position + glm::vec3(0.0f, height, 0.0f));
+            };
+
+            // ====================
+            //  RECORDING
+            // ====================
+            // Two sets of per bucket buffers: the workers record frame N+1 into one while this thread
+            // replays frame N from the other. Buckets are replayed in order, so the submission order
+            // does not depend on which worker recorded what.
+            Utility::JobSystem jobs;
+            const size_t bucket_count = 64;
+            struct FrameCommands
+            {
+                std::vector<Utility::render::CommandBuffer> buckets;
+                Utility::Job* recorded = nullptr;
+                double record_ms = 0.0;
+            };
+            FrameCommands frames_in_flight[2];
+            for (FrameCommands& frame : frames_in_flight)
+                frame.buckets.resize(bucket_count);
+
+            auto record_bucket = [&](FrameCommands& frame, size_t bucket, float time) {
+                Utility::render::CommandBuffer& commands = frame.buckets[bucket];
+                commands.Reset();
+                commands.UseProgram(shader.Id());
+                for (size_t i = objects.size() * bucket / bucket_count; i < objects.size() * (bucket + 1) / bucket_count; ++i)
+                {
+                    const Object& object = objects[i];
+                    const Utility::mesh::MeshHandle& mesh = shapes[object.shape];
+                    commands.SetUniform(locations.model, model_at(object, time));
+                    commands.SetUniform(locations.color, material_colors[object.material]);
+                    commands.BindVertexArray(mesh.vao);
+                    commands.DrawElements(GL_TRIANGLES, mesh.index_count, mesh.index_type, mesh.index_offset, mesh.base_vertex);
+                }
+            };
+            auto start_recording = [&](FrameCommands& frame, float time) {
+                auto start = std::chrono::steady_clock::now();
+                frame.recorded = jobs.CreateJob([] {});
+                for (size_t b = 0; b < bucket_count; ++b)
+                    jobs.Submit(jobs.CreateJob([&record_bucket, &frame, b, time] { record_bucket(frame, b, time); }, frame.recorded));
+                jobs.Submit(frame.recorded);
+                return start;
+            };
+
+            Utility::render::CommandBuffer frame_setup;
+            Utility::render::GLCommandExecutor executor;
+            size_t current = 0;
+            bool pending = false;
+            bool use_commands = true;
+            double submit_ms = 0.0, record_ms = 0.0;
+            int frames = 0;
+            double last_report = glfwGetTime();
+
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+                update_frame_time();
+                processInput(window);
+                if (key_pressed(window, GLFW_KEY_R))
+                    use_commands = !use_commands;
+
+                glm::mat4 view_matrix = camera.GetViewMatrix();
+                glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 300.0f);
+                float time = (float)glfwGetTime();
+
+                auto submit_start = std::chrono::steady_clock::now();
+                if (use_commands)
+                {
+                    if (!pending)
+                    {
+                        // First frame, or back from direct drawing: nothing was recorded ahead
+                        auto start = start_recording(frames_in_flight[current], time);
+                        jobs.Wait(frames_in_flight[current].recorded);
+                        record_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                    }
+
+                    // Next frame's objects are recorded while this one is replayed
+                    FrameCommands& next = frames_in_flight[current ^ 1];
+                    auto record_start = start_recording(next, time + deltaTime);
+
+                    frame_setup.Reset();
+                    frame_setup.Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT, glm::vec4(0.1f, 0.1f, 0.1f, 1.0f));
+                    frame_setup.UseProgram(shader.Id());
+                    frame_setup.SetUniform(locations.view, view_matrix);
+                    frame_setup.SetUniform(locations.projection, projection_matrix);
+                    frame_setup.SetUniform(locations.ambient, 0.1f);
+                    frame_setup.SetUniform(locations.specular, 0.5f);
+                    frame_setup.SetUniform(locations.shininess, 32.0f);
+                    frame_setup.SetUniform(locations.light_position, glm::vec3(0.0f, 10.0f, 0.0f));
+                    frame_setup.SetUniform(locations.light_color, glm::vec3(1.0f, 1.0f, 1.0f));
+                    frame_setup.SetUniform(locations.camera_position, camera.Position);
+
+                    executor.Invalidate();
+                    executor.Execute(frame_setup);
+                    for (const Utility::render::CommandBuffer& commands : frames_in_flight[current].buckets)
+                        executor.Execute(commands);
+
+                    jobs.Wait(next.recorded);
+                    record_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - record_start).count();
+                    current ^= 1;
+                    pending = true;
+                }
+                else
+                {
+                    glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+                    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                    shader.use();
+                    shader.setMat4("view_matrix", view_matrix);
+                    shader.setMat4("projection_matrix", projection_matrix);
+                    shader.setFloat("the_object.ambient_strength", 0.1f);
+                    shader.setFloat("the_object.specular_strength", 0.5f);
+                    shader.setFloat("the_object.shininess", 32.0f);
+                    shader.setVec3("light_source.position", 0.0f, 10.0f, 0.0f);
+                    shader.setVec3("light_source.color", 1.0f, 1.0f, 1.0f);
+                    shader.setVec3("camera_position", camera.Position);
+                    for (const Object& object : objects)
+                    {
+                        shader.set<"model_matrix"_id>(model_at(object, time));
+                        shader.set<"the_object.color"_id>(material_colors[object.material]);
+                        meshes.Draw(shapes[object.shape]);
+                    }
+                    pending = false;
+                }
+                submit_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - submit_start).count();
+                ++frames;
+
+                if (glfwGetTime() - last_report > 1.0)
+                {
+                    double seconds = glfwGetTime() - last_report;
+                    last_report = glfwGetTime();
+                    if (use_commands)
+                    {
+                        const Utility::render::ReplayStats& stats = executor.Stats();
+                        size_t bytes = 0;
+                        for (const Utility::render::CommandBuffer& commands : frames_in_flight[current].buckets)
+                            bytes += commands.Bytes();
+                        std::cout << "recorded: " << stats.commands / frames << " commands, " << stats.redundant / frames << " redundant binds skipped, "
+                                  << bytes / 1024 << " KB, " << record_ms / frames << " ms recording on " << jobs.ThreadCount() << " workers, "
+                                  << submit_ms / frames << " ms frame CPU at " << frames / seconds << " fps" << std::endl;
+                    }
+                    else
+                    {
+                        std::cout << "direct:   " << objects.size() << " draws, " << submit_ms / frames << " ms frame CPU at " << frames / seconds << " fps" << std::endl;
+                    }
+                    executor.ResetStats();
+                    submit_ms = 0.0;
+                    record_ms = 0.0;
+                    frames = 0;
+                }
+
+                glfwSwapBuffers(window);
+                glfwPollEvents();
+            }
+        }
+
+        glfwTerminate();
+        return 0;
+    }
+
+    int PipelinedFrames()
+    {
+        GLFWwindow* window = start_scene();
+
+        {
+            // ====================
+            //      MESHES
+            // ====================
+            Utility::mesh::MeshLibrary meshes;
+            // Own vertex array for the instance matrices, see StreamedCubes
+            Utility::mesh::MeshHandle cube = meshes.InstanceStream(meshes.Get(Utility::mesh::Primitive::Cube, Utility::mesh::Position | Utility::mesh::Normal));
+
+            // ====================
+            //      SHADERS
+            // ====================
+            auto object_shader = ShaderProgram(
+                "tutorials\\shaders\\streamed_instances_vs.glsl",
+                "tutorials\\shaders\\lighting_intro_object_fs.glsl");
+            const GLuint frame_data_binding = 0;
+            glUniformBlockBinding(object_shader.Id(), glGetUniformBlockIndex(object_shader.Id(), "FrameData"), frame_data_binding);
+
+            // ====================
+            //  SIMULATION
+            // ====================
+            // The simulation owns the transforms and writes the composed matrices into a snapshot; the
+            // render thread only ever reads snapshots, so the two never share mutable state
+            const int grid_size = 64;
+            const int instance_count = grid_size * grid_size;
+            Utility::TransformSoA transforms;
+            transforms.Reserve(instance_count);
+            for (int z = 0; z < grid_size; ++z)
+            {
+                for (int x = 0; x < grid_size; ++x)
+                    transforms.Add(glm::vec3((x - grid_size / 2) * 1.5f, 0.0f, -z * 1.5f));
+            }
+            const glm::vec3 spin_axis = glm::normalize(glm::vec3(0.5f, 1.0f, 0.0f));
+
+            struct Snapshot
+            {
+                std::vector<glm::mat4> matrices;
+            };
+            std::vector<Snapshot> snapshots;
+            std::atomic<bool> spikes{ false };
+
+            auto simulate = [&](Snapshot& snapshot, unsigned long long frame) {
+                float time = (float)glfwGetTime();
+                for (int z = 0; z < grid_size; ++z)
+                {
+                    for (int x = 0; x < grid_size; ++x)
+                        transforms.SetRotation(z * grid_size + x, glm::angleAxis(time + 0.1f * (x + z), spin_axis));
+                }
+                snapshot.matrices.resize(instance_count);
+                transforms.ComposeMatrices(snapshot.matrices.data(), 0, instance_count);
+
+                // An update hitch, such as streaming or a physics step catching up
+                if (spikes.load(std::memory_order_relaxed) && frame % 30 == 29)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(25));
+            };
+
+            // ====================
+            //  PIPELINE SETUP
+            // ====================
+            Utility::FramePipelineOptions options;
+            options.snapshots = 3;
+            options.max_frames_in_flight = 2;
+            bool threaded = true;
+            std::unique_ptr<Utility::FramePipeline> pipeline;
+            std::thread simulation;
+
+            auto start_pipeline = [&] {
+                pipeline.reset(new Utility::FramePipeline(options));
+                snapshots.resize(pipeline->SnapshotCount());
+                if (threaded)
+                {
+                    simulation = std::thread([&] {
+                        for (int snapshot; (snapshot = pipeline->BeginSimulation()) >= 0;)
+                        {
+                            simulate(snapshots[snapshot], pipeline->FrameIndex(snapshot));
+                            pipeline->EndSimulation(snapshot);
+                        }
+                    });
+                }
+            };
+            auto stop_pipeline = [&] {
+                pipeline->Stop();
+                if (simulation.joinable())
+                    simulation.join();
+            };
+
+            const size_t uniform_alignment = Utility::RingBuffer::UniformAlignment();
+            Utility::RingBuffer ring;
+            ring.Create(GL_ARRAY_BUFFER, instance_count * sizeof(glm::mat4) + 2 * sizeof(glm::mat4) + uniform_alignment);
+            double last_report = glfwGetTime();
+            unsigned long long last_allocations = Utility::debug::allocation_count();
+            start_pipeline();
+            std::cout << "T toggles the simulation thread, K update spikes, 1-3 the frames in flight" << std::endl;
+
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+                update_frame_time();
+                processInput(window);
+                if (key_pressed(window, GLFW_KEY_K))
+                    spikes = !spikes;
+                bool restart = false;
+                if (key_pressed(window, GLFW_KEY_T))
+                {
+                    threaded = !threaded;
+                    restart = true;
+                }
+                for (unsigned int frames = 1; frames <= 3; ++frames)
+                {
+                    if (key_pressed(window, GLFW_KEY_0 + frames))
+                    {
+                        options.max_frames_in_flight = frames;
+                        restart = true;
+                    }
+                }
+                if (restart)
+                {
+                    stop_pipeline();
+                    start_pipeline();
+                    last_report = glfwGetTime();
+                    last_allocations = Utility::debug::allocation_count();
+                }
+
+                if (!threaded)
+                {
+                    int snapshot = pipeline->BeginSimulation();
+                    simulate(snapshots[snapshot], pipeline->FrameIndex(snapshot));
+                    pipeline->EndSimulation(snapshot);
+                }
+                int snapshot = pipeline->BeginRender();
+                if (snapshot < 0)
+                    break;
+                const Snapshot& scene = snapshots[snapshot];
+
+                glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                // The camera is read on the render thread, as late as possible
+                ring.BeginFrame();
+                glm::mat4 frame_data[2] = {
+                    camera.GetViewMatrix(),
+                    glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 200.0f)
+                };
+                Utility::RingBuffer::Allocation frame_uniforms = ring.Write(frame_data, sizeof(frame_data), uniform_alignment);
+                Utility::RingBuffer::Allocation instances = ring.Write(scene.matrices.data(), instance_count * sizeof(glm::mat4), sizeof(glm::mat4));
+
+                object_shader.use();
+                object_shader.setVec3("the_object.color", 1.0f, 0.5f, 0.31f);
+                object_shader.setFloat("the_object.ambient_strength", 0.1f);
+                object_shader.setFloat("the_object.specular_strength", 0.5f);
+                object_shader.setFloat("the_object.shininess", 32.0f);
+                object_shader.setVec3("light_source.position", 0.0f, 10.0f, 0.0f);
+                object_shader.setVec3("light_source.color", 1.0f, 1.0f, 1.0f);
+                object_shader.setVec3("camera_position", camera.Position);
+
+                if (frame_uniforms.Valid() && instances.Valid())
+                {
+                    ring.BindRange(GL_UNIFORM_BUFFER, frame_data_binding, frame_uniforms);
+                    glBindVertexArray(cube.vao);
+                    glBindBuffer(GL_ARRAY_BUFFER, ring.Buffer());
+                    for (GLuint column = 0; column < 4; ++column)
+                    {
+                        glVertexAttribPointer(2 + column, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (GLvoid*)(instances.offset + column * sizeof(glm::vec4)));
+                        glVertexAttribDivisor(2 + column, 1);
+                        glEnableVertexAttribArray(2 + column);
+                    }
+                    glBindBuffer(GL_ARRAY_BUFFER, 0);
+                    meshes.DrawInstanced(cube, instance_count);
+                }
+                ring.EndFrame();
+
+                glfwSwapBuffers(window);
+                // Fenced after the swap, so the frame counts as finished once it was presented
+                pipeline->EndRender(snapshot);
+                glfwPollEvents();
+
+                if (glfwGetTime() - last_report > 1.0)
+                {
+                    last_report = glfwGetTime();
+                    Utility::FrameLatencyReport report = pipeline->Report();
+                    unsigned long long allocations = Utility::debug::allocation_count();
+                    std::cout << (threaded ? "pipelined" : "serial") << ", " << options.max_frames_in_flight << " in flight"
+                              << (spikes ? ", spikes: " : ": ") << report;
+                    if (Utility::debug::allocations_counted() && report.frames)
+                        std::cout << ", " << (double)(allocations - last_allocations) / report.frames << " allocations per frame";
+                    std::cout << std::endl;
+                    last_allocations = Utility::debug::allocation_count();
+                    pipeline->ResetReport();
+                }
+            }
+
+            stop_pipeline();
+        }
+
+        glfwTerminate();
+        return 0;
+    }
+
+    int MaterialObjects()
+    {
+        using namespace Utility::literals;
+        GLFWwindow* window = start_scene();
+
+        {
+            // ====================
+            //      MESHES
+            // ====================
+            const unsigned int attributes = Utility::mesh::Position | Utility::mesh::Normal | Utility::mesh::TexCoord;
+            Utility::mesh::MeshLibrary meshes;
+            Utility::mesh::MeshHandle shapes[] = {
+                meshes.Get(Utility::mesh::Primitive::Cube, attributes),
+                meshes.Get(Utility::mesh::Primitive::Sphere, attributes)
+            };
+
+            Utility::texture::ResidencyManager textures(64 * 1024 * 1024);
+            GLuint container_diffuse_texture = textures.Load("resources\\container2.png");
+            GLuint container_specular_texture = textures.Load("resources\\container2_specular.png");
+
+            // ====================
+            //      SHADERS
+            // ====================
+            // Two variants of the same lighting, each with its own parameter block
+            auto color_shader = ShaderProgram(
+                "tutorials\\shaders\\lm_specular_map_object_vs.glsl",
+                "tutorials\\shaders\\material_color_fs.glsl");
+            auto textured_shader = ShaderProgram(
+                "tutorials\\shaders\\lm_specular_map_object_vs.glsl",
+                "tutorials\\shaders\\material_textured_fs.glsl");
+
+            // ====================
+            //      MATERIALS
+            // ====================
+            const GLuint material_binding = 1;
+            Utility::render::MaterialLayout color_layout("Material", material_binding);
+            color_layout.Add("color", Utility::render::ParameterType::Vec3)
+                        .Add("ambient_strength", Utility::render::ParameterType::Float)
+                        .Add("specular_color", Utility::render::ParameterType::Vec3)
+                        .Add("shininess", Utility::render::ParameterType::Float);
+            Utility::render::MaterialLayout textured_layout("Material", material_binding);
+            textured_layout.Add("tint", Utility::render::ParameterType::Vec4)
+                           .Add("specular_color", Utility::render::ParameterType::Vec3)
+                           .Add("shininess", Utility::render::ParameterType::Float)
+                           .AddTexture("diffuse_map", 0)
+                           .AddTexture("specular_map", 1);
+            color_layout.Prepare(color_shader.Id());
+            textured_layout.Prepare(textured_shader.Id());
+
+            Utility::render::MaterialSystem materials;
+            Utility::render::MaterialSystem::LayoutId layouts[] = { materials.AddLayout(color_layout), materials.AddLayout(textured_layout) };
+            ShaderProgram* layout_shaders[] = { &color_shader, &textured_shader };
+
+            const int color_materials = 48;
+            const int textured_materials = 16;
+            std::vector<Utility::render::MaterialSystem::MaterialId> palette;
+            for (int i = 0; i < color_materials; ++i)
+            {
+                float hue = (float)i / color_materials;
+                glm::vec3 color(0.5f + 0.5f * std::cos(6.2832f * hue), 0.5f + 0.5f * std::cos(6.2832f * (hue - 0.33f)), 0.5f + 0.5f * std::cos(6.2832f * (hue - 0.67f)));
+                Utility::render::MaterialSystem::MaterialId material = materials.Create(layouts[0]);
+                materials.Set(material, "color"_id, color);
+                materials.Set(material, "ambient_strength"_id, 0.1f);
+                materials.Set(material, "specular_color"_id, glm::vec3(0.5f));
+                materials.Set(material, "shininess"_id, (float)(8 << (i % 5)));
+                palette.push_back(material);
+            }
+            for (int i = 0; i < textured_materials; ++i)
+            {
+                float shade = 0.6f + 0.4f * i / textured_materials;
+                Utility::render::MaterialSystem::MaterialId material = materials.Create(layouts[1]);
+                materials.Set(material, "tint"_id, glm::vec4(shade, 1.0f, 2.0f - shade, 1.0f));
+                materials.Set(material, "specular_color"_id, glm::vec3(1.0f));
+                materials.Set(material, "shininess"_id, (float)(16 << (i % 4)));
+                materials.SetTexture(material, "diffuse_map"_id, container_diffuse_texture);
+                materials.SetTexture(material, "specular_map"_id, container_specular_texture);
+                palette.push_back(material);
+            }
+            materials.Upload();
+            std::cout << materials.MaterialCount() << " materials in " << materials.BufferBytes() << " bytes, records of "
+                      << color_layout.Size() << " and " << textured_layout.Size() << " bytes" << std::endl;
+
+            // ====================
+            //  OBJECTS
+            // ====================
+            const int grid_size = 128;
+            struct Object
+            {
+                glm::mat4 model;
+                unsigned int shape;
+                Utility::render::MaterialSystem::MaterialId material;
+            };
+            std::vector<Object> objects;
+            for (int z = 0; z < grid_size; ++z)
+            {
+                for (int x = 0; x < grid_size; ++x)
+                {
+                    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3((x - grid_size / 2) * 1.5f, 0.0f, -z * 1.5f));
+                    objects.push_back({ model, (unsigned int)(x + z) % 2, palette[(x * 7 + z * 13) % palette.size()] });
+                }
+            }
+
+            // Draw order by layout then material, so programs switch twice and each record binds once
+            std::vector<unsigned int> sorted_order(objects.size());
+            for (unsigned int i = 0; i < sorted_order.size(); ++i)
+                sorted_order[i] = i;
+            std::sort(sorted_order.begin(), sorted_order.end(), [&](unsigned int a, unsigned int b) {
+                return materials.SortKey(objects[a].material) < materials.SortKey(objects[b].material);
+            });
+            std::vector<unsigned int> grid_order(sorted_order.size());
+            for (unsigned int i = 0; i < grid_order.size(); ++i)
+                grid_order[i] = i;
+
+            bool sorted = true;
+            double submit_ms = 0.0;
+            unsigned long long program_switches = 0, material_binds = 0;
+            int frames = 0;
+            double last_report = glfwGetTime();
+            std::cout << "S toggles sorting the draws by material" << std::endl;
+
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+                update_frame_time();
+                processInput(window);
+                if (key_pressed(window, GLFW_KEY_S))
+                    sorted = !sorted;
+
+                glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                glm::mat4 view_matrix = camera.GetViewMatrix();
+                glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 300.0f);
+
+                // Frame uniforms once per variant
+                color_shader.use();
+                color_shader.set<"view_matrix"_id>(view_matrix);
+                color_shader.set<"projection_matrix"_id>(projection_matrix);
+                color_shader.set<"light_source.position"_id>(glm::vec3(0.0f, 10.0f, 0.0f));
+                color_shader.set<"light_source.color"_id>(glm::vec3(1.0f));
+                color_shader.set<"camera_position"_id>(camera.Position);
+                textured_shader.use();
+                textured_shader.set<"view_matrix"_id>(view_matrix);
+                textured_shader.set<"projection_matrix"_id>(projection_matrix);
+                textured_shader.set<"light_source.position"_id>(glm::vec3(0.0f, 10.0f, 0.0f));
+                textured_shader.set<"light_source.ambient"_id>(glm::vec3(0.2f));
+                textured_shader.set<"light_source.diffuse"_id>(glm::vec3(0.5f));
+                textured_shader.set<"light_source.specular"_id>(glm::vec3(1.0f));
+                textured_shader.set<"camera_position"_id>(camera.Position);
+
+                // A material change is a buffer range bind; the program only changes with the layout
+                auto submit_start = std::chrono::steady_clock::now();
+                Utility::render::MaterialSystem::LayoutId bound_layout = ~0u;
+                Utility::render::MaterialSystem::MaterialId bound_material = Utility::render::MaterialSystem::kInvalidMaterial;
+                for (unsigned int index : sorted ? sorted_order : grid_order)
+                {
+                    const Object& object = objects[index];
+                    Utility::render::MaterialSystem::LayoutId layout = materials.LayoutOf(object.material);
+                    if (layout != bound_layout)
+                    {
+                        layout_shaders[layout]->use();
+                        bound_layout = layout;
+                        ++program_switches;
+                    }
+                    if (object.material != bound_material)
+                    {
+                        materials.Bind(object.material);
+                        bound_material = object.material;
+                        ++material_binds;
+                    }
+                    layout_shaders[layout]->set<"model_matrix"_id>(object.model);
+                    meshes.Draw(shapes[object.shape]);
+                }
+                submit_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - submit_start).count();
+                ++frames;
+
+                if (glfwGetTime() - last_report > 1.0)
+                {
+                    last_report = glfwGetTime();
+                    std::cout << (sorted ? "sorted:   " : "unsorted: ") << objects.size() << " draws, " << (double)program_switches / frames
+                              << " program switches, " << (double)material_binds / frames << " material binds, "
+                              << submit_ms / frames << " ms CPU submit" << std::endl;
+                    program_switches = 0;
+                    material_binds = 0;
+                    submit_ms = 0.0;
+                    frames = 0;
+                }
+
+                glfwSwapBuffers(window);
+                glfwPollEvents();
+            }
+        }
+
+        glfwTerminate();
+        return 0;
+    }
+
+    int ClusteredLights()
+    {
+        using namespace Utility::literals;
+        GLFWwindow* window = start_scene();
+
+        {
+            // ====================
+            //      MESHES
+            // ====================
+            const unsigned int attributes = Utility::mesh::Position | Utility::mesh::Normal | Utility::mesh::TexCoord;
+            Utility::mesh::MeshLibrary meshes;
+            Utility::mesh::MeshHandle cube = meshes.Get(Utility::mesh::Primitive::Cube, attributes);
+
+            Utility::texture::ResidencyManager textures(64 * 1024 * 1024);
+            GLuint container_diffuse_texture = textures.Load("resources\\container2.png");
+            GLuint container_specular_texture = textures.Load("resources\\container2_specular.png");
+
+            // ====================
+            //      SHADERS
+            // ====================
+            Utility::render::ClusteredLighting lighting;
+            auto object_shader = ShaderProgram(
+                "tutorials\\shaders\\lm_specular_map_object_vs.glsl",
+                lighting.UsesStorageBuffers() ? "tutorials\\shaders\\clustered_forward_fs.glsl" : "tutorials\\shaders\\clustered_forward_tbo_fs.glsl");
+            std::cout << "cluster light lists in " << (lighting.UsesStorageBuffers() ? "shader storage buffers" : "texture buffers") << std::endl;
+            object_shader.use();
+            object_shader.setInt("diffuse_map", 0);
+            object_shader.setInt("specular_map", 1);
+
+            // ====================
+            //  OBJECTS
+            // ====================
+            const int grid_size = 64;
+            const float spacing = 2.0f;
+            std::vector<glm::mat4> models;
+            for (int z = 0; z < grid_size; ++z)
+            {
+                for (int x = 0; x < grid_size; ++x)
+                {
+                    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3((x - grid_size / 2) * spacing, 0.0f, -z * spacing));
+                    models.push_back(glm::scale(model, glm::vec3(1.0f, 0.25f + 0.75f * ((x * 7 + z * 3) % 4) / 3.0f, 1.0f)));
+                }
+            }
+
+            // ====================
+            //  LIGHTS
+            // ====================
+            // Each light circles its own point of the field just above the cubes
+            const size_t max_lights = 4096;
+            struct LightPath
+            {
+                glm::vec3 center;
+                float orbit;
+                float speed;
+            };
+            std::vector<LightPath> paths(max_lights);
+            std::vector<Utility::render::GpuPointLight> lights(max_lights);
+            std::mt19937 rng(3);
+            std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+            for (size_t i = 0; i < max_lights; ++i)
+            {
+                paths[i].center = glm::vec3((unit(rng) - 0.5f) * grid_size * spacing, 1.0f + unit(rng) * 1.5f, -unit(rng) * grid_size * spacing);
+                paths[i].orbit = 1.0f + unit(rng) * 3.0f;
+                paths[i].speed = 0.5f + unit(rng);
+                lights[i].radius = 3.0f + unit(rng) * 5.0f;
+                lights[i].color = glm::vec3(unit(rng), unit(rng), unit(rng)) * 6.0f;
+            }
+
+            Utility::render::ClusterGrid grid;
+            const float near_plane = 0.1f, far_plane = 150.0f;
+            size_t light_count = 256;
+            bool show_cluster_load = false;
+            double assign_ms = 0.0;
+            int frames = 0;
+            double last_report = glfwGetTime();
+            std::cout << "+/- double or halve the lights (1 to " << max_lights << "), H shows the lights per cluster" << std::endl;
+
+            // ====================
+            //      MAIN UI LOOP
+            // ====================
+            while (!glfwWindowShouldClose(window))
+            {
+                // fps counter
+                Utility::GLFW::update_fps_counter(window);
+                update_frame_time();
+                processInput(window);
+                if (key_pressed(window, GLFW_KEY_EQUAL))
+                    light_count = std::min(light_count * 2, max_lights);
+                if (key_pressed(window, GLFW_KEY_MINUS))
+                    light_count = std::max<size_t>(light_count / 2, 1);
+                if (key_pressed(window, GLFW_KEY_H))
+                    show_cluster_load = !show_cluster_load;
+
+                float time = (float)glfwGetTime();
+                for (size_t i = 0; i < light_count; ++i)
+                {
+                    float angle = time * paths[i].speed + (float)i;
+                    lights[i].position = paths[i].center + glm::vec3(std::cos(angle), 0.0f, std::sin(angle)) * paths[i].orbit;
+                }
+
+                glClearColor(0.02f, 0.02f, 0.02f, 1.0f);
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                glm::mat4 view_matrix = camera.GetViewMatrix();
+                glm::mat4 projection_matrix = glm::perspective(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, near_plane, far_plane);
+
+                // Light assignment on the CPU, then the grid goes to the GPU with the lights
+                auto assign_start = std::chrono::steady_clock::now();
+                grid.SetProjection(glm::radians(camera.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, near_plane, far_plane);
+                grid.Assign(lights.data(), light_count, view_matrix);
+                assign_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - assign_start).count();
+                lighting.Upload(grid, lights.data(), light_count);
+
+                object_shader.use();
+                lighting.Apply(object_shader, grid, SCR_WIDTH, SCR_HEIGHT);
+                object_shader.set<"view_matrix"_id>(view_matrix);
+                object_shader.set<"projection_matrix"_id>(projection_matrix);
+                object_shader.set<"camera_position"_id>(camera.Position);
+                object_shader.set<"ambient_color"_id>(glm::vec3(0.03f));
+                object_shader.set<"shininess"_id>(32.0f);
+                object_shader.set<"show_cluster_load"_id>(show_cluster_load);
+                textures.Use(container_diffuse_texture);
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_2D, container_diffuse_texture);
+                textures.Use(container_specular_texture);
+                glActiveTexture(GL_TEXTURE1);
+                glBindTexture(GL_TEXTURE_2D, container_specular_texture);
+                glActiveTexture(GL_TEXTURE0);
+                for (const glm::mat4& model : models)
+                {
+                    object_shader.set<"model_matrix"_id>(model);
+                    meshes.Draw(cube);
+                }
+                ++frames;
+
+                if (glfwGetTime() - last_report > 1.0)
+                {
+                    double seconds = glfwGetTime() - last_report;
+                    last_report = glfwGetTime();
+                    std::cout << light_count << " lights: " << assign_ms / frames << " ms assignment, " << grid.Stats()
+                              << ", " << frames / seconds << " fps" << std::endl;
+                    assign_ms = 0.0;
+                    frames = 0;
+                }
+
+                glfwSwapBuffers(window);
+                glfwPollEvents();
+            }
+        }
+
+        glfwTerminate();
+        return 0;
+    }
+}
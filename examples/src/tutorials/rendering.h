@@ -0,0 +1,33 @@
+#ifndef _RENDERING_H_
+#define _RENDERING_H_
+
+#include <GL/glew.h>
+
+struct GLFWwindow;
+
+// Larger scenes for the rendering techniques built on top of the mesh library
+namespace tutorials::rendering
+{
+	// Field of high poly spheres drawn with per instance LOD selection; L toggles LOD
+	int LodField();
+	// High poly sphere drawn from its meshlets culled on the CPU every frame; C toggles culling
+	int MeshletCulling();
+	// Thousands of spinning cubes whose transforms and frame uniforms are streamed through a ring buffer; O toggles orphaning
+	int StreamedCubes();
+	// Static field and an animated rig with attached light cubes in a flat scene graph; P pauses the animation
+	int SceneHierarchy();
+	// 16K mixed meshes drawn one call per object or with multi draw indirect; M toggles, draws/s printed every second
+	int IndirectObjects();
+	// 256K instances culled on the GPU against the frustum and last frame's Hi-Z; H and F toggle the tests
+	int GpuCulledField();
+	// 16K bobbing objects recorded into command buffers by job system workers a frame ahead and replayed in order; R toggles direct GL calls
+	int RecordedCommands();
+	// Spinning cubes simulated on their own thread into snapshots while the main thread renders; T toggles the thread, K update spikes, 1-3 frames in flight
+	int PipelinedFrames();
+	// 16K objects using 64 materials of two shader variants packed into one uniform buffer; S toggles sorting draws by material
+	int MaterialObjects();
+	// Textured cube field lit by up to 4096 moving point lights through clustered forward shading; +/- change the light count, H shows lights per cluster
+	int ClusteredLights();
+}
+
+#endif // !_RENDERING_H_
@@ -0,0 +1,68 @@
+#version 330 core
+
+in vec3 frag_position;
+in vec3 frag_normal;
+in vec2 frag_texture_coords;
+
+// Texture buffer views of ClusteredLighting's buffers, for contexts without storage buffers
+uniform samplerBuffer light_data;			// 2 texels per light: position, radius; color
+uniform usamplerBuffer cluster_data;		// offset, count
+uniform usamplerBuffer light_index_data;
+
+uniform uvec3 cluster_grid;			// tiles x, tiles y, slices
+uniform vec2 cluster_tile_pixels;
+uniform float cluster_slice_scale;
+uniform float cluster_slice_bias;
+
+uniform sampler2D diffuse_map;
+uniform sampler2D specular_map;
+uniform float shininess;
+uniform vec3 ambient_color;
+uniform mat4 view_matrix;
+uniform vec3 camera_position;
+uniform bool show_cluster_load;
+
+out vec4 frag_color;
+
+void main()
+{
+	// cluster of the fragment: screen tile and exponential depth slice
+	float view_depth = -(view_matrix * vec4(frag_position, 1.0)).z;
+	uint slice = uint(clamp(log(view_depth) * cluster_slice_scale + cluster_slice_bias, 0.0, float(cluster_grid.z - 1u)));
+	uvec2 tile = min(uvec2(gl_FragCoord.xy / cluster_tile_pixels), cluster_grid.xy - 1u);
+	uvec2 cluster = texelFetch(cluster_data, int(tile.x + cluster_grid.x * (tile.y + cluster_grid.y * slice))).xy;
+
+	if (show_cluster_load)
+	{
+		float load = float(cluster.y) / 32.0;
+		frag_color = vec4(load, 1.0 - abs(load - 0.5) * 2.0, 1.0 - load, 1.0);
+		return;
+	}
+
+	vec3 albedo = texture(diffuse_map, frag_texture_coords).rgb;
+	vec3 specular_mask = texture(specular_map, frag_texture_coords).rgb;
+	vec3 normalized_frag_normal = normalize(frag_normal);
+	vec3 dir_vec_from_camera_pos_to_fragment = normalize(camera_position - frag_position);
+
+	vec3 resulting_color = ambient_color * albedo;
+	for (uint i = 0u; i < cluster.y; ++i)
+	{
+		int light = int(texelFetch(light_index_data, int(cluster.x + i)).x) * 2;
+		vec4 position_radius = texelFetch(light_data, light);
+		vec3 light_color = texelFetch(light_data, light + 1).rgb;
+		vec3 to_light = position_radius.xyz - frag_position;
+		float light_distance = length(to_light);
+		vec3 dir_vector_from_light_source_to_fragment = to_light / light_distance;
+
+		// smooth window to zero at the light's radius, so clipping it at the cluster bounds is invisible
+		float falloff = clamp(1.0 - pow(light_distance / position_radius.w, 4.0), 0.0, 1.0);
+		float attenuation = falloff * falloff / (light_distance * light_distance + 1.0);
+
+		float cosine_angle = max(dot(normalized_frag_normal, dir_vector_from_light_source_to_fragment), 0.0);
+		vec3 reflection_vec = reflect(-dir_vector_from_light_source_to_fragment, normalized_frag_normal);
+		float specular_scalar = pow(max(dot(dir_vec_from_camera_pos_to_fragment, reflection_vec), 0.0), shininess);
+
+		resulting_color += light_color * attenuation * (cosine_angle * albedo + specular_scalar * specular_mask);
+	}
+	frag_color = vec4(resulting_color, 1.0);
+}
\ No newline at end of file
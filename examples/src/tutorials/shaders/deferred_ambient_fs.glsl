@@ -0,0 +1,13 @@
+#version 330 core
+
+in vec2 tex_coords;
+
+uniform sampler2D albedo_map;
+uniform vec3 ambient_color;
+
+out vec4 frag_color;
+
+void main()
+{
+	frag_color = vec4(ambient_color * texture(albedo_map, tex_coords).rgb, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#version 330 core
+
+in vec3 frag_position;
+in vec3 frag_normal;
+in vec2 frag_texture_coords;
+
+uniform sampler2D diffuse_map;
+uniform sampler2D specular_map;
+uniform float shininess;
+uniform float max_shininess;
+
+// G-buffer layout of Utility::render::GBuffer
+layout (location = 0) out vec4 albedo_specular;		// RGBA8
+layout (location = 1) out vec4 normal_shininess;	// RGB10_A2
+
+// octahedral mapping of a unit vector onto the [-1, 1] square
+vec2 oct_encode(vec3 n)
+{
+	n /= abs(n.x) + abs(n.y) + abs(n.z);
+	if (n.z < 0.0)
+		n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+	return n.xy;
+}
+
+void main()
+{
+	albedo_specular = vec4(texture(diffuse_map, frag_texture_coords).rgb, texture(specular_map, frag_texture_coords).r);
+	normal_shininess = vec4(oct_encode(normalize(frag_normal)) * 0.5 + 0.5, shininess / max_shininess, 0.0);
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#version 330 core
+
+flat in vec4 frag_light_position_radius;
+flat in vec3 frag_light_color;
+
+uniform sampler2D albedo_map;		// albedo, specular intensity
+uniform sampler2D normal_map;		// octahedral normal, shininess
+uniform sampler2D depth_map;
+uniform mat4 inverse_view_projection;
+uniform vec2 screen_size;
+uniform vec3 camera_position;
+uniform float max_shininess;
+
+out vec4 frag_color;
+
+vec3 oct_decode(vec2 e)
+{
+	vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+	float t = max(-n.z, 0.0);
+	n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+	return normalize(n);
+}
+
+void main()
+{
+	// world position from the depth buffer instead of a position target
+	vec2 uv = gl_FragCoord.xy / screen_size;
+	float depth = texture(depth_map, uv).r;
+	vec4 world = inverse_view_projection * vec4(vec3(uv, depth) * 2.0 - 1.0, 1.0);
+	vec3 frag_position = world.xyz / world.w;
+
+	vec4 albedo_specular = texture(albedo_map, uv);
+	vec4 normal_shininess = texture(normal_map, uv);
+	vec3 normalized_frag_normal = oct_decode(normal_shininess.xy * 2.0 - 1.0);
+	float shininess = max(normal_shininess.z * max_shininess, 1.0);
+
+	vec3 to_light = frag_light_position_radius.xyz - frag_position;
+	float light_distance = length(to_light);
+	vec3 dir_vector_from_light_source_to_fragment = to_light / light_distance;
+
+	// smooth window to zero at the light's radius, where the volume ends
+	float falloff = clamp(1.0 - pow(light_distance / frag_light_position_radius.w, 4.0), 0.0, 1.0);
+	float attenuation = falloff * falloff / (light_distance * light_distance + 1.0);
+
+	float cosine_angle = max(dot(normalized_frag_normal, dir_vector_from_light_source_to_fragment), 0.0);
+	vec3 dir_vec_from_camera_pos_to_fragment = normalize(camera_position - frag_position);
+	vec3 reflection_vec = reflect(-dir_vector_from_light_source_to_fragment, normalized_frag_normal);
+	float specular_scalar = pow(max(dot(dir_vec_from_camera_pos_to_fragment, reflection_vec), 0.0), shininess);
+
+	vec3 resulting_color = frag_light_color * attenuation * (cosine_angle * albedo_specular.rgb + specular_scalar * albedo_specular.a);
+	frag_color = vec4(resulting_color, 0.0);
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#version 330 core
+
+layout (location = 0) in vec3 vertex_position;
+// one instance per light: position and radius, then color
+layout (location = 3) in vec4 light_position_radius;
+layout (location = 4) in vec4 light_color;
+
+uniform mat4 view_projection;
+uniform float volume_scale;
+
+flat out vec4 frag_light_position_radius;
+flat out vec3 frag_light_color;
+
+void main()
+{
+   frag_light_position_radius = light_position_radius;
+   frag_light_color = light_color.rgb;
+   vec3 position = light_position_radius.xyz + vertex_position * light_position_radius.w * volume_scale;
+   gl_Position = view_projection * vec4(position, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#version 430 core
+
+layout (local_size_x = 64) in;
+
+struct Instance
+{
+   mat4 model;
+   vec4 bounds;      // object space sphere
+   uvec4 ids;        // x: mesh, y: material
+};
+
+struct Command
+{
+   uint count;
+   uint instance_count;
+   uint first_index;
+   int base_vertex;
+   uint base_instance;
+};
+
+layout (std430, binding = 0) readonly buffer Instances { Instance instances[]; };
+layout (std430, binding = 1) buffer Commands { Command commands[]; };
+layout (std430, binding = 2) writeonly buffer Visible { uint visible[]; };
+
+uniform int instance_count;
+uniform bool use_frustum;
+uniform vec4 frustum_planes[6];   // world space, normalized
+
+// max depth pyramid of the previous frame
+uniform bool use_hiz;
+uniform mat4 previous_view_projection;
+uniform sampler2D hiz;
+uniform vec2 hiz_size;
+uniform int hiz_levels;
+
+bool inside_frustum(vec3 center, float radius)
+{
+   for (int i = 0; i < 6; ++i)
+   {
+      if (dot(frustum_planes[i].xyz, center) + frustum_planes[i].w < -radius)
+         return false;
+   }
+   return true;
+}
+
+bool occluded(vec3 center, float radius)
+{
+   // Screen rectangle and nearest depth of the sphere's box in the previous frame
+   vec3 rect_min = vec3(1.0);
+   vec3 rect_max = vec3(0.0);
+   for (int i = 0; i < 8; ++i)
+   {
+      vec3 corner = center + radius * vec3((i & 1) != 0 ? 1.0 : -1.0, (i & 2) != 0 ? 1.0 : -1.0, (i & 4) != 0 ? 1.0 : -1.0);
+      vec4 clip = previous_view_projection * vec4(corner, 1.0);
+      if (clip.w <= 0.0)
+         return false;   // crosses the camera plane, keep it
+      vec3 window = clip.xyz / clip.w * 0.5 + 0.5;
+      rect_min = min(rect_min, window);
+      rect_max = max(rect_max, window);
+   }
+   rect_min.xy = clamp(rect_min.xy, 0.0, 1.0);
+   rect_max.xy = clamp(rect_max.xy, 0.0, 1.0);
+
+   // Level 0 texels the rectangle touches. Each level halves the texel coordinates, with an odd
+   // last row / column folded into the last texel, so a level 0 texel lands in texel
+   // min(texel >> level, level_size - 1). Normalized coordinates would not match that fold
+   // when the size is not a power of two.
+   ivec2 last = ivec2(hiz_size) - 1;
+   ivec2 texel_min = min(ivec2(rect_min.xy * hiz_size), last);
+   ivec2 texel_max = min(ivec2(rect_max.xy * hiz_size), last);
+
+   // The level where the rectangle spans at most 2 x 2 texels
+   ivec2 extent = texel_max - texel_min;
+   int level = clamp(int(ceil(log2(float(max(max(extent.x, extent.y), 1))))), 0, hiz_levels - 1);
+   ivec2 level_last = max(ivec2(hiz_size) >> level, 1) - 1;   // sizes as glTexStorage2D made them
+   ivec2 a = min(texel_min >> level, level_last);
+   ivec2 b = min(texel_max >> level, level_last);
+
+   float farthest = texelFetch(hiz, a, level).r;
+   farthest = max(farthest, texelFetch(hiz, ivec2(b.x, a.y), level).r);
+   farthest = max(farthest, texelFetch(hiz, ivec2(a.x, b.y), level).r);
+   farthest = max(farthest, texelFetch(hiz, b, level).r);
+   return rect_min.z > farthest;
+}
+
+void main()
+{
+   uint index = gl_GlobalInvocationID.x;
+   if (index >= uint(instance_count))
+      return;
+
+   Instance instance = instances[index];
+   vec3 center = vec3(instance.model * vec4(instance.bounds.xyz, 1.0));
+   float scale = max(length(instance.model[0].xyz), max(length(instance.model[1].xyz), length(instance.model[2].xyz)));
+   float radius = instance.bounds.w * scale;
+
+   if (use_frustum && !inside_frustum(center, radius))
+      return;
+   if (use_hiz && occluded(center, radius))
+      return;
+
+   uint mesh = instance.ids.x;
+   if (mesh >= uint(commands.length()))
+      return;   // no command for this mesh, nowhere to draw it
+   uint slot = atomicAdd(commands[mesh].instance_count, 1u);
+   visible[commands[mesh].base_instance + slot] = index;
+}
@@ -0,0 +1,32 @@
+#version 430 core
+
+layout (location = 0) in vec3 vertex_position;
+layout (location = 1) in vec3 vertex_normal;
+// index of the instance, read from the compacted visible list starting at the command's base instance
+layout (location = 7) in uint instance_id;
+
+struct Instance
+{
+   mat4 model;
+   vec4 bounds;
+   uvec4 ids;        // x: mesh, y: material
+};
+
+layout (std430, binding = 0) readonly buffer Instances { Instance instances[]; };
+
+uniform mat4 view_matrix;
+uniform mat4 projection_matrix;
+uniform vec3 material_colors[8];
+
+out vec3 frag_position;
+out vec3 frag_normal;
+flat out vec3 frag_albedo;
+
+void main()
+{
+   Instance instance = instances[instance_id];
+   frag_position = vec3(instance.model * vec4(vertex_position, 1.0));
+   frag_normal = mat3(instance.model) * vertex_normal;
+   frag_albedo = material_colors[instance.ids.y % 8u];
+   gl_Position = projection_matrix * view_matrix * vec4(frag_position, 1.0);
+}
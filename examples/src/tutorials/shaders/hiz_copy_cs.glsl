@@ -0,0 +1,14 @@
+#version 430 core
+
+layout (local_size_x = 8, local_size_y = 8) in;
+
+uniform sampler2D depth;
+layout (r32f, binding = 0) writeonly uniform image2D pyramid_level0;
+
+void main()
+{
+   ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+   if (any(greaterThanEqual(texel, imageSize(pyramid_level0))))
+      return;
+   imageStore(pyramid_level0, texel, vec4(texelFetch(depth, texel, 0).r));
+}
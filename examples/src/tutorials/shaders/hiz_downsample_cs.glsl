@@ -0,0 +1,27 @@
+#version 430 core
+
+layout (local_size_x = 8, local_size_y = 8) in;
+
+layout (r32f, binding = 0) readonly uniform image2D source_level;
+layout (r32f, binding = 1) writeonly uniform image2D target_level;
+
+void main()
+{
+   ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+   ivec2 target_size = imageSize(target_level);
+   if (any(greaterThanEqual(texel, target_size)))
+      return;
+
+   // Odd source sizes fold the last row / column into the last target texel
+   ivec2 source_size = imageSize(source_level);
+   ivec2 last = source_size - 1;
+   ivec2 span = ivec2(2) + ivec2(equal(texel, target_size - 1)) * (source_size & 1);
+
+   float farthest = 0.0;
+   for (int y = 0; y < span.y; ++y)
+   {
+      for (int x = 0; x < span.x; ++x)
+         farthest = max(farthest, imageLoad(source_level, min(texel * 2 + ivec2(x, y), last)).r);
+   }
+   imageStore(target_level, texel, vec4(farthest));
+}
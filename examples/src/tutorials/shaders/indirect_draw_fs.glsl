@@ -0,0 +1,31 @@
+#version 330 core
+
+in vec3 frag_position;
+in vec3 frag_normal;
+flat in vec3 frag_albedo;
+
+struct Light
+{
+	vec3 position;
+	vec3 color;
+};
+
+uniform Light light_source;
+uniform vec3 camera_position;
+
+out vec4 frag_color;
+
+void main()
+{
+	vec3 ambient = 0.1 * light_source.color;
+
+	vec3 normal = normalize(frag_normal);
+	vec3 to_light = normalize(light_source.position - frag_position);
+	vec3 diffuse = max(dot(normal, to_light), 0.0) * light_source.color;
+
+	vec3 to_camera = normalize(camera_position - frag_position);
+	vec3 reflection = reflect(-to_light, normal);
+	vec3 specular = 0.5 * pow(max(dot(to_camera, reflection), 0.0), 32.0) * light_source.color;
+
+	frag_color = vec4((ambient + diffuse + specular) * frag_albedo, 1.0);
+}
@@ -0,0 +1,30 @@
+#version 330 core
+#extension GL_ARB_shader_draw_parameters : require
+
+layout (location = 0) in vec3 vertex_position;
+layout (location = 1) in vec3 vertex_normal;
+
+// 5 texels per draw: the model matrix columns, then the material index in x.
+// The batch stores the draw index as base instance, gl_DrawIDARB would restart at 0 in every
+// glMultiDrawElementsIndirect call of the batch.
+uniform samplerBuffer draw_data;
+uniform mat4 view_matrix;
+uniform mat4 projection_matrix;
+uniform vec3 material_colors[8];
+
+out vec3 frag_position;
+out vec3 frag_normal;
+flat out vec3 frag_albedo;
+
+void main()
+{
+   int base = gl_BaseInstanceARB * 5;
+   mat4 model_matrix = mat4(texelFetch(draw_data, base), texelFetch(draw_data, base + 1),
+                            texelFetch(draw_data, base + 2), texelFetch(draw_data, base + 3));
+   int material = int(texelFetch(draw_data, base + 4).x);
+
+   frag_position = vec3(model_matrix * vec4(vertex_position, 1.0));
+   frag_normal = mat3(model_matrix) * vertex_normal;
+   frag_albedo = material_colors[material % 8];
+   gl_Position = projection_matrix * view_matrix * vec4(frag_position, 1.0);
+}
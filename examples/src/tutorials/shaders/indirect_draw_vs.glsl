@@ -0,0 +1,29 @@
+#version 330 core
+
+layout (location = 0) in vec3 vertex_position;
+layout (location = 1) in vec3 vertex_normal;
+// index of the draw in the batch, an instanced attribute that starts at the command's base instance
+layout (location = 7) in uint draw_id;
+
+// 5 texels per draw: the model matrix columns, then the material index in x
+uniform samplerBuffer draw_data;
+uniform mat4 view_matrix;
+uniform mat4 projection_matrix;
+uniform vec3 material_colors[8];
+
+out vec3 frag_position;
+out vec3 frag_normal;
+flat out vec3 frag_albedo;
+
+void main()
+{
+   int base = int(draw_id) * 5;
+   mat4 model_matrix = mat4(texelFetch(draw_data, base), texelFetch(draw_data, base + 1),
+                            texelFetch(draw_data, base + 2), texelFetch(draw_data, base + 3));
+   int material = int(texelFetch(draw_data, base + 4).x);
+
+   frag_position = vec3(model_matrix * vec4(vertex_position, 1.0));
+   frag_normal = mat3(model_matrix) * vertex_normal;
+   frag_albedo = material_colors[material % 8];
+   gl_Position = projection_matrix * view_matrix * vec4(frag_position, 1.0);
+}
@@ -0,0 +1,36 @@
+#version 330 core
+
+// Packed layout from Utility::mesh::compile_vertex_format: unorm16 positions relative to the
+// mesh bounds, octahedral snorm16 normals and half float texture coordinates
+layout (location = 0) in vec3 vertex_position;
+layout (location = 1) in vec2 vertex_normal;
+layout (location = 2) in vec2 vertex_texture_coords;
+
+uniform mat4 model_matrix;
+uniform mat4 view_matrix;
+uniform mat4 projection_matrix;
+
+uniform vec3 position_offset;
+uniform vec3 position_scale;
+
+out vec3 frag_position;
+out vec3 frag_normal;
+out vec2 frag_texture_coords;
+
+vec3 oct_decode(vec2 e)
+{
+   vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+   float t = max(-n.z, 0.0);
+   n.x += n.x >= 0.0 ? -t : t;
+   n.y += n.y >= 0.0 ? -t : t;
+   return normalize(n);
+}
+
+void main()
+{
+   vec3 position = position_offset + vertex_position * position_scale;
+   frag_position = vec3(model_matrix * vec4(position, 1.0));
+   frag_normal = mat3(transpose(inverse(model_matrix))) * oct_decode(vertex_normal);
+   frag_texture_coords = vertex_texture_coords;
+   gl_Position = projection_matrix * view_matrix * vec4(frag_position, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,6 @@
+#version 330 core
+
+// depth only, the framebuffer has no color target
+void main()
+{
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+#version 330 core
+
+layout (location = 0) in vec3 vertex_position;
+
+uniform mat4 model_matrix;
+uniform mat4 light_view_projection;
+
+void main()
+{
+	gl_Position = light_view_projection * model_matrix * vec4(vertex_position, 1.0);
+}
\ No newline at end of file
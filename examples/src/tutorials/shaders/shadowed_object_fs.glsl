@@ -0,0 +1,79 @@
+#version 330 core
+
+#define MAX_CASCADES 4
+
+in vec3 frag_position;
+in vec3 frag_normal;
+in vec2 frag_texture_coords;
+
+uniform sampler2D diffuse_map;
+uniform sampler2D specular_map;
+uniform float shininess;
+
+uniform vec3 light_direction;		// from the light toward the scene
+uniform vec3 light_color;
+uniform vec3 ambient_color;
+uniform vec3 camera_position;
+uniform mat4 view_matrix;
+
+// Utility::render::CascadedShadowMap
+uniform sampler2DArrayShadow shadow_map;
+uniform int cascade_count;
+uniform float cascade_splits[MAX_CASCADES];		// far view depth of each cascade
+uniform mat4 cascade_matrices[MAX_CASCADES];
+uniform float cascade_texel_sizes[MAX_CASCADES];	// world size of a shadow texel
+uniform bool show_cascades;
+
+out vec4 frag_color;
+
+const vec3 cascade_tints[MAX_CASCADES] = vec3[](vec3(1.0, 0.4, 0.4), vec3(0.4, 1.0, 0.4), vec3(0.4, 0.4, 1.0), vec3(1.0, 1.0, 0.4));
+
+// 1 lit, 0 in shadow
+float shadow_factor(int cascade, vec3 normal, float cosine_angle)
+{
+	// push the lookup off the surface by about a texel, more at grazing angles, against acne
+	float offset = cascade_texel_sizes[cascade] * (1.0 + 2.0 * (1.0 - cosine_angle));
+	vec4 light_clip = cascade_matrices[cascade] * vec4(frag_position + normal * offset, 1.0);
+	vec3 coords = light_clip.xyz / light_clip.w * 0.5 + 0.5;
+	if (coords.z > 1.0)
+		return 1.0;
+
+	// 3x3 PCF; each tap is itself a bilinear 2x2 comparison through the LINEAR filtered sampler
+	vec2 texel = 1.0 / vec2(textureSize(shadow_map, 0).xy);
+	float lit = 0.0;
+	for (int y = -1; y <= 1; ++y)
+	{
+		for (int x = -1; x <= 1; ++x)
+			lit += texture(shadow_map, vec4(coords.xy + vec2(x, y) * texel, float(cascade), coords.z));
+	}
+	return lit / 9.0;
+}
+
+void main()
+{
+	vec3 albedo = texture(diffuse_map, frag_texture_coords).rgb;
+	vec3 normal = normalize(frag_normal);
+	vec3 to_light = -normalize(light_direction);
+	float cosine_angle = max(dot(normal, to_light), 0.0);
+
+	vec3 to_camera = normalize(camera_position - frag_position);
+	vec3 reflection_vec = reflect(-to_light, normal);
+	float specular_scalar = pow(max(dot(to_camera, reflection_vec), 0.0), shininess);
+
+	// the first cascade whose slice reaches this depth; beyond the last one there are no shadows
+	float view_depth = -(view_matrix * vec4(frag_position, 1.0)).z;
+	int cascade = cascade_count;
+	for (int i = cascade_count - 1; i >= 0; --i)
+	{
+		if (view_depth < cascade_splits[i])
+			cascade = i;
+	}
+	float lit = cascade < cascade_count && cosine_angle > 0.0 ? shadow_factor(cascade, normal, cosine_angle) : 1.0;
+
+	vec3 diffuse = light_color * cosine_angle * albedo;
+	vec3 specular = light_color * specular_scalar * texture(specular_map, frag_texture_coords).r;
+	vec3 resulting_color = ambient_color * albedo + lit * (diffuse + specular);
+	if (show_cascades && cascade < cascade_count)
+		resulting_color *= cascade_tints[cascade];
+	frag_color = vec4(resulting_color, 1.0);
+}
\ No newline at end of file
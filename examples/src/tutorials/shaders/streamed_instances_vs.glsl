@@ -0,0 +1,23 @@
+#version 330 core
+
+layout (location = 0) in vec3 vertex_position;
+layout (location = 1) in vec3 vertex_normal;
+// per instance, streamed through the ring buffer every frame
+layout (location = 2) in mat4 instance_model_matrix;
+
+layout (std140) uniform FrameData
+{
+   mat4 view_matrix;
+   mat4 projection_matrix;
+};
+
+out vec3 frag_position;
+out vec3 frag_normal;
+
+void main()
+{
+   frag_position = vec3(instance_model_matrix * vec4(vertex_position, 1.0));
+   // rotation and uniform scale only, so the normal matrix is the model matrix itself
+   frag_normal = mat3(instance_model_matrix) * vertex_normal;
+   gl_Position = projection_matrix * view_matrix * vec4(frag_position, 1.0);
+}
@@ -5,6 +5,7 @@
 #include <iostream>
 #include "../ShaderType.h"
 #include "../ShaderProgram.h"
+#include "../mesh_library.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -2789,639 +2790,213 @@ namespace tutorials
             // ====================
             // VBO - VAO GENERATION
             // ====================
-            // 1. Vertex data for positions, colors and texture coordinates
-            GLfloat vertices[] = {
-                // coords             // texture
-                -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
-                 0.5f, -0.5f, -0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
-
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
-                -0.5f,  0.5f,  0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-
-                -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                -0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f, -0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-
-                -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                -0.5f,  0.5f,  0.5f,  0.0f, 0.0f,
-                -0.5f,  0.5f, -0.5f,  0.0f, 1.0f
-            };
-
-
-            // Generate tightly-packed VBO and then the Indexed VBO
-            // 2,3 & 4
-            GLuint vbo;
-            glGenBuffers(1, &vbo);
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
-            glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-            // 5. Generate and bind VAO
-            GLuint vao;
-            glGenVertexArrays(1, &vao);
-            glBindVertexArray(vao);
-
-            // 6. Define and associate the vertex attributes to the vbo
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
-            //positions
-            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid*)0);
-            glEnableVertexAttribArray(0);
-            //textures
-            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
-            glEnableVertexAttribArray(1);
-
-            glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-            // ====================
-            //    TEXTURE SETUP
-            // ====================
-
-            // texture 1
-            // ---------
-
-            // 1. Load the corresponding image
-            std::string image_file_path("resources\\container.jpg");
-            bool is_png = image_file_path.find(".png") != std::string::npos;
-
-            int width, height, nrChannels;
-            unsigned char* data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
-            if (!data)
-                std::cerr << "Failed to load texture image!!!" << std::endl;
-
-            // 2. Generate the texture object like any other OpenGL object
-            GLuint texture_obj;
-            glGenTextures(1, &texture_obj);
-
-            // 3. Bind it to a specific target. It is GL_TEXTURE_2D here.
-            // RULE: texture_obj should and can NOT be bound to any other target after this point
-            glBindTexture(GL_TEXTURE_2D, texture_obj);
-            // all upcoming GL_TEXTURE_2D operations now have effect on this texture object
-
-            // 4. Set the sampling parameters
-            // Wrapping (edge value sampling)
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            // Filtering
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-            // 5. Get the storage for the texture
-            // Mutable storage in this case
-            if (is_png)
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-            else
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-
-            // 6. Storage contents can now be altered after this point.
-            // It is often a good practice to generate a mipmap
-            glGenerateMipmap(GL_TEXTURE_2D);
-
-            // 7. You can now free the loaded image data.
-            stbi_image_free(data);
-
-            // texture 2
-            // ---------
-            // Repeat steps 1-7 for the second texture
-
-            image_file_path = "resources\\awesomeface.png";
-            is_png = image_file_path.find(".png") != std::string::npos;
-            stbi_set_flip_vertically_on_load(true); // tell stb_image.h to flip loaded texture's on the y-axis.
-            data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
-            if (!data)
-                std::cerr << "Failed to load texture image!!!" << std::endl;
-
-            // Texture object
-            GLuint texture_obj2;
-            glGenTextures(1, &texture_obj2);
-            glBindTexture(GL_TEXTURE_2D, texture_obj2);
-
-            // Sampling parameters
-            // wrapping parameters
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            // texture filtering parameters
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-            // Storage
-            if (is_png)
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-            else
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-
-            // Mipmap setup
-            glGenerateMipmap(GL_TEXTURE_2D);
-
-            // free raw data
-            stbi_image_free(data);
-
-            // ====================
-            //      SHADERS
-            // ====================
-            // 8. Define the sources for the vertex and fragment shader
-            const char* vertex_shader_source_str =
-                "#version 330 core\n"
-                "layout (location = 0) in vec3 vertex_position;\n"
-                "layout (location = 1) in vec2 vertex_texture_position;\n"
-                "out vec2 textureCoord;\n"
-                "uniform mat4 model_matrix;\n"
-                "uniform mat4 view_matrix;\n"
-                "uniform mat4 projection_matrix;\n"
-                "void main()\n"
-                "{\n"
-                "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
-                "   textureCoord = vec2(vertex_texture_position.x, vertex_texture_position.y);\n"
-                "}\0";
-
-            // 9. Fragment shader setup
-            const char* fragment_shader_source_str =
-                "#version 330 core\n"
-                "in vec2 textureCoord;\n"
-                "out vec4 frag_color;\n"
-                "uniform sampler2D texture1;\n" // texture sampler
-                "uniform sampler2D texture2;\n"
-                "void main()\n"
-                "{\n"
-                "   frag_color = mix(texture(texture1, textureCoord), texture(texture2, textureCoord), 0.2);\n"
-                "}\0";
-
-            // 10-a. Create the vertex shader
-            GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
-
-            // 10-b. Attach the source string to the shader & compile
-            const GLchar* vertex_shader_source = (const GLchar*)vertex_shader_source_str;
-            glShaderSource(vertex_shader, 1, &vertex_shader_source, NULL);
-            glCompileShader(vertex_shader);
-
-            // 10-c. Check for the errors
-            int success = -1;
-            glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &success);
-            if (GL_TRUE != success)
-            {
-                char infoLog[512];
-                glGetShaderInfoLog(vertex_shader, 512, NULL, infoLog);
-                std::cerr << "Shader can not compile: " << infoLog << "\n";
-                return -1; // or exit or something
-            }
-
-            // 10-d REpeat steps 10-a, b and c for the fragment shader
-            GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
-            const GLchar* fragment_shader_source = (const GLchar*)fragment_shader_source_str;
-            glShaderSource(fragment_shader, 1, &fragment_shader_source, NULL);
-            glCompileShader(fragment_shader);
-            // error check
-            success = -1;
-            glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &success);
-            if (GL_TRUE != success)
-            {
-                char infoLog[512];
-                glGetShaderInfoLog(fragment_shader, 512, NULL, infoLog);
-                std::cerr << "Shader can not compile: " << infoLog << "\n";
-                return -1; // or exit or something
-            }
-
-            // 10-e. Create the program to attach defined shaders
-            GLuint shader_programme = glCreateProgram();
-
-            // 10-f. Attach & link the shaders to the program
-            glAttachShader(shader_programme, vertex_shader);
-            glAttachShader(shader_programme, fragment_shader);
-            glLinkProgram(shader_programme);
-
-            // 10-g. Check against the linking errors
-            success = -1;
-            glGetProgramiv(shader_programme, GL_LINK_STATUS, &success);
-            if (GL_TRUE != success)
-            {
-                char infoLog[512];
-                glGetProgramInfoLog(shader_programme, 512, NULL, infoLog);
-                std::cerr << "ERROR: Shader programme linking failed: " << infoLog << std::endl;
-                return -1;
-            }
-
-            // ====================
-            //  TEXTURE UNIT SETUP
-            // ====================
-            // Has to be done once
-
-            // Since we make a modification on the shader, call glUseProgram for the shader programme
-            glUseProgram(shader_programme);
-
-            // Tell the shader what shader belongs to which texture object
-            // get the location of the sampler variable named "texture1" and 
-            // set the value of that sampler to the corresponding value of the texture image unit
-            glUniform1i(glGetUniformLocation(shader_programme, "texture1"), 0);
-            glUniform1i(glGetUniformLocation(shader_programme, "texture2"), 1);
-
-            // NOTE: Make sure you activate the correct texture image unit for the related texture.
-
-
-            // ====================
-            //  TRANSFORMATION SETUP
-            // ====================
-            glm::mat4 identity_matrix = glm::mat4(1.0f);
-
-            // Setup the transformation matrices
-            // Rotation around X axis
-            glm::vec3 x_axis_unit_vec = glm::vec3(1.0f, 0.0f, 0.0f);
-            // rotation by 90 degrees around x axis - time dependent
-            glm::mat4 model_matrix = glm::rotate(identity_matrix, glm::radians(-55.0f), x_axis_unit_vec);
-            glm::mat4 view_matrix = glm::translate(identity_matrix, glm::vec3(0.0f, 0.0f, -3.0f));
-            glm::mat4 projection_matrix = glm::perspective(glm::radians(45.0f), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
-
-            // we need to pass this info to the shader so call use
-            glUseProgram(shader_programme);
-            // Get the locations in the shaders
-            GLuint model_mat_loc = glGetUniformLocation(shader_programme, "model_matrix");
-            GLuint view_mat_loc = glGetUniformLocation(shader_programme, "view_matrix");
-            GLuint projection_mat_loc = glGetUniformLocation(shader_programme, "projection_matrix");
-            // Set the data for them (two different ways: pointer or [0][0] syntax)
-            glUniformMatrix4fv(model_mat_loc, 1, GL_FALSE, glm::value_ptr(model_matrix));
-            glUniformMatrix4fv(view_mat_loc, 1, GL_FALSE, &view_matrix[0][0]);
-            glUniformMatrix4fv(projection_mat_loc, 1, GL_FALSE, glm::value_ptr(projection_matrix));
-
-            // 10-h. Deleting shader at this point does not hurt
-            glDeleteShader(vertex_shader);
-            glDeleteShader(fragment_shader);
-
-            // ====================
-            //      MAIN UI LOOP
-            // ====================
-            /* Loop until the user closes the window */
-            while (!glfwWindowShouldClose(window))
-            {
-                // fps counter
-                Utility::GLFW::update_fps_counter(window);
-
-                /* Render here */
-                glClearColor(0.2f, 0.3f, 0.3f, 1.0f);// scene background color
-                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-                // Activate the texture image units and bind the associated textures
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, texture_obj);
-                glActiveTexture(GL_TEXTURE1);
-                glBindTexture(GL_TEXTURE_2D, texture_obj2);
-
-                // render
-                glUseProgram(shader_programme);
-                glBindVertexArray(vao);
-                glDrawArrays(GL_TRIANGLES, 0, 36);
-
-                /* Swap front and back buffers */
-                /* update other events like input handling */
-                glfwSwapBuffers(window);
-
-                /* Poll for and process events */
-                /* put the stuff we've been drawing onto the display */
-                glfwPollEvents();
-            }
-
-            glDeleteVertexArrays(1, &vao);
-            glDeleteBuffers(1, &vbo);
-            glDeleteProgram(shader_programme);
-
-            glfwTerminate();
-            return 0;
-        }
-
-        int RotateCubeContinously()
-        {
-            // Initialize the glfw & glew
-            GLFWwindow* window = Utility::GLFW::start_glfw();
-            Utility::GLEW::start_glew();
-
-            // Some openGL settings
-            // tell GL to only draw onto a pixel if the shape is closer to the viewer
-            glEnable(GL_DEPTH_TEST); // enable depth-testing
-            //glDepthFunc(GL_LESS);		 // depth-testing interprets a smaller value as "closer"
-
-            // ====================
-            // VBO - VAO GENERATION
-            // ====================
-            // 1. Vertex data for positions, colors and texture coordinates
-            GLfloat vertices[] = {
-                // coords             // texture
-                -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
-                 0.5f, -0.5f, -0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
-
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
-                -0.5f,  0.5f,  0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-
-                -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                -0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f, -0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-
-                -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                -0.5f,  0.5f,  0.5f,  0.0f, 0.0f,
-                -0.5f,  0.5f, -0.5f,  0.0f, 1.0f
-            };
-
-
-            // Generate tightly-packed VBO and then the Indexed VBO
-            // 2,3 & 4
-            GLuint vbo;
-            glGenBuffers(1, &vbo);
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
-            glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-            // 5. Generate and bind VAO
-            GLuint vao;
-            glGenVertexArrays(1, &vao);
-            glBindVertexArray(vao);
-
-            // 6. Define and associate the vertex attributes to the vbo
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
-            //positions
-            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid*)0);
-            glEnableVertexAttribArray(0);
-            //textures
-            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
-            glEnableVertexAttribArray(1);
-
-            glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-            // ====================
-            //    TEXTURE SETUP
-            // ====================
-
-            // texture 1
-            // ---------
-
-            // 1. Load the corresponding image
-            std::string image_file_path("resources\\container.jpg");
-            bool is_png = image_file_path.find(".png") != std::string::npos;
-
-            int width, height, nrChannels;
-            unsigned char* data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
-            if (!data)
-                std::cerr << "Failed to load texture image!!!" << std::endl;
-
-            // 2. Generate the texture object like any other OpenGL object
-            GLuint texture_obj;
-            glGenTextures(1, &texture_obj);
-
-            // 3. Bind it to a specific target. It is GL_TEXTURE_2D here.
-            // RULE: texture_obj should and can NOT be bound to any other target after this point
-            glBindTexture(GL_TEXTURE_2D, texture_obj);
-            // all upcoming GL_TEXTURE_2D operations now have effect on this texture object
-
-            // 4. Set the sampling parameters
-            // Wrapping (edge value sampling)
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            // Filtering
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-            // 5. Get the storage for the texture
-            // Mutable storage in this case
-            if (is_png)
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-            else
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-
-            // 6. Storage contents can now be altered after this point.
-            // It is often a good practice to generate a mipmap
-            glGenerateMipmap(GL_TEXTURE_2D);
-
-            // 7. You can now free the loaded image data.
-            stbi_image_free(data);
-
-            // texture 2
-            // ---------
-            // Repeat steps 1-7 for the second texture
 
-            image_file_path = "resources\\awesomeface.png";
-            is_png = image_file_path.find(".png") != std::string::npos;
-            stbi_set_flip_vertically_on_load(true); // tell stb_image.h to flip loaded texture's on the y-axis.
-            data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
-            if (!data)
-                std::cerr << "Failed to load texture image!!!" << std::endl;
 
-            // Texture object
-            GLuint texture_obj2;
-            glGenTextures(1, &texture_obj2);
-            glBindTexture(GL_TEXTURE_2D, texture_obj2);
+            // Everything owning GL objects lives in this block, so it is destroyed before glfwTerminate()
+            {
+                // Positions and texture coordinates of the cube come from the mesh library
+                Utility::mesh::MeshLibrary meshes;
+                Utility::mesh::MeshHandle cube = meshes.Get(Utility::mesh::Primitive::Cube, Utility::mesh::Position | Utility::mesh::TexCoord);
 
-            // Sampling parameters
-            // wrapping parameters
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            // texture filtering parameters
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                // ====================
+                //    TEXTURE SETUP
+                // ====================
 
-            // Storage
-            if (is_png)
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-            else
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+                // texture 1
+                // ---------
 
-            // Mipmap setup
-            glGenerateMipmap(GL_TEXTURE_2D);
+                // 1. Load the corresponding image
+                std::string image_file_path("resources\\container.jpg");
+                bool is_png = image_file_path.find(".png") != std::string::npos;
 
-            // free raw data
-            stbi_image_free(data);
+                int width, height, nrChannels;
+                unsigned char* data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
+                if (!data)
+                    std::cerr << "Failed to load texture image!!!" << std::endl;
 
-            // ====================
-            //      SHADERS
-            // ====================
-            // 8. Define the sources for the vertex and fragment shader
-            const char* vertex_shader_source_str =
-                "#version 330 core\n"
-                "layout (location = 0) in vec3 vertex_position;\n"
-                "layout (location = 1) in vec2 vertex_texture_position;\n"
-                "out vec2 textureCoord;\n"
-                "uniform mat4 model_matrix;\n"
-                "uniform mat4 view_matrix;\n"
-                "uniform mat4 projection_matrix;\n"
-                "void main()\n"
-                "{\n"
-                "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
-                "   textureCoord = vec2(vertex_texture_position.x, vertex_texture_position.y);\n"
-                "}\0";
+                // 2. Generate the texture object like any other OpenGL object
+                GLuint texture_obj;
+                glGenTextures(1, &texture_obj);
 
-            // 9. Fragment shader setup
-            const char* fragment_shader_source_str =
-                "#version 330 core\n"
-                "in vec2 textureCoord;\n"
-                "out vec4 frag_color;\n"
-                "uniform sampler2D texture1;\n" // texture sampler
-                "uniform sampler2D texture2;\n"
-                "void main()\n"
-                "{\n"
-                "   frag_color = mix(texture(texture1, textureCoord), texture(texture2, textureCoord), 0.2);\n"
-                "}\0";
+                // 3. Bind it to a specific target. It is GL_TEXTURE_2D here.
+                // RULE: texture_obj should and can NOT be bound to any other target after this point
+                glBindTexture(GL_TEXTURE_2D, texture_obj);
+                // all upcoming GL_TEXTURE_2D operations now have effect on this texture object
+
+                // 4. Set the sampling parameters
+                // Wrapping (edge value sampling)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+                // Filtering
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+                // 5. Get the storage for the texture
+                // Mutable storage in this case
+                if (is_png)
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+                else
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
 
-            // 10-a. Create the vertex shader
-            GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
+                // 6. Storage contents can now be altered after this point.
+                // It is often a good practice to generate a mipmap
+                glGenerateMipmap(GL_TEXTURE_2D);
 
-            // 10-b. Attach the source string to the shader & compile
-            const GLchar* vertex_shader_source = (const GLchar*)vertex_shader_source_str;
-            glShaderSource(vertex_shader, 1, &vertex_shader_source, NULL);
-            glCompileShader(vertex_shader);
+                // 7. You can now free the loaded image data.
+                stbi_image_free(data);
 
-            // 10-c. Check for the errors
-            int success = -1;
-            glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &success);
-            if (GL_TRUE != success)
-            {
-                char infoLog[512];
-                glGetShaderInfoLog(vertex_shader, 512, NULL, infoLog);
-                std::cerr << "Shader can not compile: " << infoLog << "\n";
-                return -1; // or exit or something
-            }
+                // texture 2
+                // ---------
+                // Repeat steps 1-7 for the second texture
 
-            // 10-d REpeat steps 10-a, b and c for the fragment shader
-            GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
-            const GLchar* fragment_shader_source = (const GLchar*)fragment_shader_source_str;
-            glShaderSource(fragment_shader, 1, &fragment_shader_source, NULL);
-            glCompileShader(fragment_shader);
-            // error check
-            success = -1;
-            glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &success);
-            if (GL_TRUE != success)
-            {
-                char infoLog[512];
-                glGetShaderInfoLog(fragment_shader, 512, NULL, infoLog);
-                std::cerr << "Shader can not compile: " << infoLog << "\n";
-                return -1; // or exit or something
-            }
+                image_file_path = "resources\\awesomeface.png";
+                is_png = image_file_path.find(".png") != std::string::npos;
+                stbi_set_flip_vertically_on_load(true); // tell stb_image.h to flip loaded texture's on the y-axis.
+                data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
+                if (!data)
+                    std::cerr << "Failed to load texture image!!!" << std::endl;
 
-            // 10-e. Create the program to attach defined shaders
-            GLuint shader_programme = glCreateProgram();
+                // Texture object
+                GLuint texture_obj2;
+                glGenTextures(1, &texture_obj2);
+                glBindTexture(GL_TEXTURE_2D, texture_obj2);
 
-            // 10-f. Attach & link the shaders to the program
-            glAttachShader(shader_programme, vertex_shader);
-            glAttachShader(shader_programme, fragment_shader);
-            glLinkProgram(shader_programme);
+                // Sampling parameters
+                // wrapping parameters
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+                // texture filtering parameters
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+                // Storage
+                if (is_png)
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+                else
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
 
-            // 10-g. Check against the linking errors
-            success = -1;
-            glGetProgramiv(shader_programme, GL_LINK_STATUS, &success);
-            if (GL_TRUE != success)
-            {
-                char infoLog[512];
-                glGetProgramInfoLog(shader_programme, 512, NULL, infoLog);
-                std::cerr << "ERROR: Shader programme linking failed: " << infoLog << std::endl;
-                return -1;
-            }
+                // Mipmap setup
+                glGenerateMipmap(GL_TEXTURE_2D);
 
-            // ====================
-            //  TEXTURE UNIT SETUP
-            // ====================
-            // Has to be done once
+                // free raw data
+                stbi_image_free(data);
+
+                // ====================
+                //      SHADERS
+                // ====================
+                // 8. Define the sources for the vertex and fragment shader
+                const char* vertex_shader_source_str =
+                    "#version 330 core\n"
+                    "layout (location = 0) in vec3 vertex_position;\n"
+                    "layout (location = 1) in vec2 vertex_texture_position;\n"
+                    "out vec2 textureCoord;\n"
+                    "uniform mat4 model_matrix;\n"
+                    "uniform mat4 view_matrix;\n"
+                    "uniform mat4 projection_matrix;\n"
+                    "void main()\n"
+                    "{\n"
+                    "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
+                    "   textureCoord = vec2(vertex_texture_position.x, vertex_texture_position.y);\n"
+                    "}\0";
+
+                // 9. Fragment shader setup
+                const char* fragment_shader_source_str =
+                    "#version 330 core\n"
+                    "in vec2 textureCoord;\n"
+                    "out vec4 frag_color;\n"
+                    "uniform sampler2D texture1;\n" // texture sampler
+                    "uniform sampler2D texture2;\n"
+                    "void main()\n"
+                    "{\n"
+                    "   frag_color = mix(texture(texture1, textureCoord), texture(texture2, textureCoord), 0.2);\n"
+                    "}\0";
+
+                // 10-a. Create the vertex shader
+                GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
+
+                // 10-b. Attach the source string to the shader & compile
+                const GLchar* vertex_shader_source = (const GLchar*)vertex_shader_source_str;
+                glShaderSource(vertex_shader, 1, &vertex_shader_source, NULL);
+                glCompileShader(vertex_shader);
+
+                // 10-c. Check for the errors
+                int success = -1;
+                glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &success);
+                if (GL_TRUE != success)
+                {
+                    char infoLog[512];
+                    glGetShaderInfoLog(vertex_shader, 512, NULL, infoLog);
+                    std::cerr << "Shader can not compile: " << infoLog << "\n";
+                    return -1; // or exit or something
+                }
 
-            // Since we make a modification on the shader, call glUseProgram for the shader programme
-            glUseProgram(shader_programme);
+                // 10-d REpeat steps 10-a, b and c for the fragment shader
+                GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
+                const GLchar* fragment_shader_source = (const GLchar*)fragment_shader_source_str;
+                glShaderSource(fragment_shader, 1, &fragment_shader_source, NULL);
+                glCompileShader(fragment_shader);
+                // error check
+                success = -1;
+                glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &success);
+                if (GL_TRUE != success)
+                {
+                    char infoLog[512];
+                    glGetShaderInfoLog(fragment_shader, 512, NULL, infoLog);
+                    std::cerr << "Shader can not compile: " << infoLog << "\n";
+                    return -1; // or exit or something
+                }
 
-            // Tell the shader what shader belongs to which texture object
-            // get the location of the sampler variable named "texture1" and 
-            // set the value of that sampler to the corresponding value of the texture image unit
-            glUniform1i(glGetUniformLocation(shader_programme, "texture1"), 0);
-            glUniform1i(glGetUniformLocation(shader_programme, "texture2"), 1);
+                // 10-e. Create the program to attach defined shaders
+                GLuint shader_programme = glCreateProgram();
 
-            // NOTE: Make sure you activate the correct texture image unit for the related texture.
+                // 10-f. Attach & link the shaders to the program
+                glAttachShader(shader_programme, vertex_shader);
+                glAttachShader(shader_programme, fragment_shader);
+                glLinkProgram(shader_programme);
+
+                // 10-g. Check against the linking errors
+                success = -1;
+                glGetProgramiv(shader_programme, GL_LINK_STATUS, &success);
+                if (GL_TRUE != success)
+                {
+                    char infoLog[512];
+                    glGetProgramInfoLog(shader_programme, 512, NULL, infoLog);
+                    std::cerr << "ERROR: Shader programme linking failed: " << infoLog << std::endl;
+                    return -1;
+                }
 
+                // ====================
+                //  TEXTURE UNIT SETUP
+                // ====================
+                // Has to be done once
 
-            // ====================
-            //  TRANSFORMATION SETUP
-            // ====================
-            glm::mat4 identity_matrix = glm::mat4(1.0f);
-            // Rotation axis
-            glm::vec3 rotation_axis_vec = glm::vec3(1.0f, 0.0f, 0.0f);
-            // since these are non changing vectors, it's better to keep them 
-            // out of the main loop
-            
+                // Since we make a modification on the shader, call glUseProgram for the shader programme
+                glUseProgram(shader_programme);
 
-            // 10-h. Deleting shader at this point does not hurt
-            glDeleteShader(vertex_shader);
-            glDeleteShader(fragment_shader);
+                // Tell the shader what shader belongs to which texture object
+                // get the location of the sampler variable named "texture1" and 
+                // set the value of that sampler to the corresponding value of the texture image unit
+                glUniform1i(glGetUniformLocation(shader_programme, "texture1"), 0);
+                glUniform1i(glGetUniformLocation(shader_programme, "texture2"), 1);
 
-            // ====================
-            //      MAIN UI LOOP
-            // ====================
-            /* Loop until the user closes the window */
-            while (!glfwWindowShouldClose(window))
-            {
-                // fps counter
-                Utility::GLFW::update_fps_counter(window);
+                // NOTE: Make sure you activate the correct texture image unit for the related texture.
 
-                /* Render here */
-                glClearColor(0.2f, 0.3f, 0.3f, 1.0f);// scene background color
-                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-                // Activate the texture image units and bind the associated textures
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, texture_obj);
-                glActiveTexture(GL_TEXTURE1);
-                glBindTexture(GL_TEXTURE_2D, texture_obj2);
+                // ====================
+                //  TRANSFORMATION SETUP
+                // ====================
+                glm::mat4 identity_matrix = glm::mat4(1.0f);
 
-                // Transformation setup
-                // continuous rotation around the rotation axis vector
-                glm::mat4 model_matrix = glm::rotate(identity_matrix, (float)glfwGetTime(), rotation_axis_vec);
+                // Setup the transformation matrices
+                // Rotation around X axis
+                glm::vec3 x_axis_unit_vec = glm::vec3(1.0f, 0.0f, 0.0f);
+                // rotation by 90 degrees around x axis - time dependent
+                glm::mat4 model_matrix = glm::rotate(identity_matrix, glm::radians(-55.0f), x_axis_unit_vec);
                 glm::mat4 view_matrix = glm::translate(identity_matrix, glm::vec3(0.0f, 0.0f, -3.0f));
                 glm::mat4 projection_matrix = glm::perspective(glm::radians(45.0f), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
 
                 // we need to pass this info to the shader so call use
                 glUseProgram(shader_programme);
-
                 // Get the locations in the shaders
                 GLuint model_mat_loc = glGetUniformLocation(shader_programme, "model_matrix");
                 GLuint view_mat_loc = glGetUniformLocation(shader_programme, "view_matrix");
@@ -3431,409 +3006,324 @@ namespace tutorials
                 glUniformMatrix4fv(view_mat_loc, 1, GL_FALSE, &view_matrix[0][0]);
                 glUniformMatrix4fv(projection_mat_loc, 1, GL_FALSE, glm::value_ptr(projection_matrix));
 
-                glBindVertexArray(vao);
-                glDrawArrays(GL_TRIANGLES, 0, 36);
-
-                /* Swap front and back buffers */
-                /* update other events like input handling */
-                glfwSwapBuffers(window);
-
-                /* Poll for and process events */
-                /* put the stuff we've been drawing onto the display */
-                glfwPollEvents();
-            }
-
-            glDeleteVertexArrays(1, &vao);
-            glDeleteBuffers(1, &vbo);
-            glDeleteProgram(shader_programme);
-
-            glfwTerminate();
-            return 0;
-        }
-
-        int MultipleCubes(bool rotate)
-        {
-            // Initialize the glfw & glew
-            GLFWwindow* window = Utility::GLFW::start_glfw();
-            Utility::GLEW::start_glew();
-
-            // Some openGL settings
-            // tell GL to only draw onto a pixel if the shape is closer to the viewer
-            glEnable(GL_DEPTH_TEST); // enable depth-testing
-            //glDepthFunc(GL_LESS);		 // depth-testing interprets a smaller value as "closer"
-
-            // ====================
-            // VBO - VAO GENERATION
-            // ====================
-            // 1. Vertex data for positions, colors and texture coordinates
-            GLfloat vertices[] = {
-                // coords             // texture
-                -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
-                 0.5f, -0.5f, -0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
-
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
-                -0.5f,  0.5f,  0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-
-                -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                -0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f, -0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-
-                -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                -0.5f,  0.5f,  0.5f,  0.0f, 0.0f,
-                -0.5f,  0.5f, -0.5f,  0.0f, 1.0f
-            };
-
-            // world space positions of our cubes
-            glm::vec3 cubePositions[] = {
-                glm::vec3( 0.0f,  0.0f,  0.0f),
-                glm::vec3( 2.0f,  5.0f, -15.0f),
-                glm::vec3(-1.5f, -2.2f, -2.5f),
-                glm::vec3(-3.8f, -2.0f, -12.3f),
-                glm::vec3( 2.4f, -0.4f, -3.5f),
-                glm::vec3(-1.7f,  3.0f, -7.5f),
-                glm::vec3( 1.3f, -2.0f, -2.5f),
-                glm::vec3( 1.5f,  2.0f, -2.5f),
-                glm::vec3( 1.5f,  0.2f, -1.5f),
-                glm::vec3(-1.3f,  1.0f, -1.5f)
-            };
-
-
-            // Generate tightly-packed VBO and then the Indexed VBO
-            // 2,3 & 4
-            GLuint vbo;
-            glGenBuffers(1, &vbo);
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
-            glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-            // 5. Generate and bind VAO
-            GLuint vao;
-            glGenVertexArrays(1, &vao);
-            glBindVertexArray(vao);
-
-            // 6. Define and associate the vertex attributes to the vbo
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
-            //positions
-            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid*)0);
-            glEnableVertexAttribArray(0);
-            //textures
-            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
-            glEnableVertexAttribArray(1);
-
-            glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-            // ====================
-            //    TEXTURE SETUP
-            // ====================
-
-            // texture 1
-            // ---------
-
-            // 1. Load the corresponding image
-            std::string image_file_path("resources\\container.jpg");
-            bool is_png = image_file_path.find(".png") != std::string::npos;
-
-            int width, height, nrChannels;
-            unsigned char* data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
-            if (!data)
-                std::cerr << "Failed to load texture image!!!" << std::endl;
-
-            // 2. Generate the texture object like any other OpenGL object
-            GLuint texture_obj;
-            glGenTextures(1, &texture_obj);
-
-            // 3. Bind it to a specific target. It is GL_TEXTURE_2D here.
-            // RULE: texture_obj should and can NOT be bound to any other target after this point
-            glBindTexture(GL_TEXTURE_2D, texture_obj);
-            // all upcoming GL_TEXTURE_2D operations now have effect on this texture object
-
-            // 4. Set the sampling parameters
-            // Wrapping (edge value sampling)
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            // Filtering
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                // 10-h. Deleting shader at this point does not hurt
+                glDeleteShader(vertex_shader);
+                glDeleteShader(fragment_shader);
 
-            // 5. Get the storage for the texture
-            // Mutable storage in this case
-            if (is_png)
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-            else
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+                // ====================
+                //      MAIN UI LOOP
+                // ====================
+                /* Loop until the user closes the window */
+                while (!glfwWindowShouldClose(window))
+                {
+                    // fps counter
+                    Utility::GLFW::update_fps_counter(window);
 
-            // 6. Storage contents can now be altered after this point.
-            // It is often a good practice to generate a mipmap
-            glGenerateMipmap(GL_TEXTURE_2D);
+                    /* Render here */
+                    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);// scene background color
+                    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-            // 7. You can now free the loaded image data.
-            stbi_image_free(data);
+                    // Activate the texture image units and bind the associated textures
+                    glActiveTexture(GL_TEXTURE0);
+                    glBindTexture(GL_TEXTURE_2D, texture_obj);
+                    glActiveTexture(GL_TEXTURE1);
+                    glBindTexture(GL_TEXTURE_2D, texture_obj2);
 
-            // texture 2
-            // ---------
-            // Repeat steps 1-7 for the second texture
+                    // render
+                    glUseProgram(shader_programme);
+                    meshes.Draw(cube);
 
-            image_file_path = "resources\\awesomeface.png";
-            is_png = image_file_path.find(".png") != std::string::npos;
-            stbi_set_flip_vertically_on_load(true); // tell stb_image.h to flip loaded texture's on the y-axis.
-            data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
-            if (!data)
-                std::cerr << "Failed to load texture image!!!" << std::endl;
+                    /* Swap front and back buffers */
+                    /* update other events like input handling */
+                    glfwSwapBuffers(window);
 
-            // Texture object
-            GLuint texture_obj2;
-            glGenTextures(1, &texture_obj2);
-            glBindTexture(GL_TEXTURE_2D, texture_obj2);
+                    /* Poll for and process events */
+                    /* put the stuff we've been drawing onto the display */
+                    glfwPollEvents();
+                }
 
-            // Sampling parameters
-            // wrapping parameters
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            // texture filtering parameters
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                glDeleteProgram(shader_programme);
+            }
 
-            // Storage
-            if (is_png)
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-            else
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+            glfwTerminate();
+            return 0;
+        }
 
-            // Mipmap setup
-            glGenerateMipmap(GL_TEXTURE_2D);
+        int RotateCubeContinously()
+        {
+            // Initialize the glfw & glew
+            GLFWwindow* window = Utility::GLFW::start_glfw();
+            Utility::GLEW::start_glew();
 
-            // free raw data
-            stbi_image_free(data);
+            // Some openGL settings
+            // tell GL to only draw onto a pixel if the shape is closer to the viewer
+            glEnable(GL_DEPTH_TEST); // enable depth-testing
+            //glDepthFunc(GL_LESS);		 // depth-testing interprets a smaller value as "closer"
 
             // ====================
-            //      SHADERS
+            // VBO - VAO GENERATION
             // ====================
-            // 8. Define the sources for the vertex and fragment shader
-            const char* vertex_shader_source_str =
-                "#version 330 core\n"
-                "layout (location = 0) in vec3 vertex_position;\n"
-                "layout (location = 1) in vec2 vertex_texture_position;\n"
-                "out vec2 textureCoord;\n"
-                "uniform mat4 model_matrix;\n"
-                "uniform mat4 view_matrix;\n"
-                "uniform mat4 projection_matrix;\n"
-                "void main()\n"
-                "{\n"
-                "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
-                "   textureCoord = vec2(vertex_texture_position.x, vertex_texture_position.y);\n"
-                "}\0";
 
-            // 9. Fragment shader setup
-            const char* fragment_shader_source_str =
-                "#version 330 core\n"
-                "in vec2 textureCoord;\n"
-                "out vec4 frag_color;\n"
-                "uniform sampler2D texture1;\n" // texture sampler
-                "uniform sampler2D texture2;\n"
-                "void main()\n"
-                "{\n"
-                "   frag_color = mix(texture(texture1, textureCoord), texture(texture2, textureCoord), 0.2);\n"
-                "}\0";
 
-            // 10-a. Create the vertex shader
-            GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
+            {
+                // Positions and texture coordinates of the cube come from the mesh library
+                Utility::mesh::MeshLibrary meshes;
+                Utility::mesh::MeshHandle cube = meshes.Get(Utility::mesh::Primitive::Cube, Utility::mesh::Position | Utility::mesh::TexCoord);
 
-            // 10-b. Attach the source string to the shader & compile
-            const GLchar* vertex_shader_source = (const GLchar*)vertex_shader_source_str;
-            glShaderSource(vertex_shader, 1, &vertex_shader_source, NULL);
-            glCompileShader(vertex_shader);
+                // ====================
+                //    TEXTURE SETUP
+                // ====================
 
-            // 10-c. Check for the errors
-            int success = -1;
-            glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &success);
-            if (GL_TRUE != success)
-            {
-                char infoLog[512];
-                glGetShaderInfoLog(vertex_shader, 512, NULL, infoLog);
-                std::cerr << "Shader can not compile: " << infoLog << "\n";
-                return -1; // or exit or something
-            }
+                // texture 1
+                // ---------
 
-            // 10-d REpeat steps 10-a, b and c for the fragment shader
-            GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
-            const GLchar* fragment_shader_source = (const GLchar*)fragment_shader_source_str;
-            glShaderSource(fragment_shader, 1, &fragment_shader_source, NULL);
-            glCompileShader(fragment_shader);
-            // error check
-            success = -1;
-            glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &success);
-            if (GL_TRUE != success)
-            {
-                char infoLog[512];
-                glGetShaderInfoLog(fragment_shader, 512, NULL, infoLog);
-                std::cerr << "Shader can not compile: " << infoLog << "\n";
-                return -1; // or exit or something
-            }
+                // 1. Load the corresponding image
+                std::string image_file_path("resources\\container.jpg");
+                bool is_png = image_file_path.find(".png") != std::string::npos;
 
-            // 10-e. Create the program to attach defined shaders
-            GLuint shader_programme = glCreateProgram();
+                int width, height, nrChannels;
+                unsigned char* data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
+                if (!data)
+                    std::cerr << "Failed to load texture image!!!" << std::endl;
 
-            // 10-f. Attach & link the shaders to the program
-            glAttachShader(shader_programme, vertex_shader);
-            glAttachShader(shader_programme, fragment_shader);
-            glLinkProgram(shader_programme);
+                // 2. Generate the texture object like any other OpenGL object
+                GLuint texture_obj;
+                glGenTextures(1, &texture_obj);
 
-            // 10-g. Check against the linking errors
-            success = -1;
-            glGetProgramiv(shader_programme, GL_LINK_STATUS, &success);
-            if (GL_TRUE != success)
-            {
-                char infoLog[512];
-                glGetProgramInfoLog(shader_programme, 512, NULL, infoLog);
-                std::cerr << "ERROR: Shader programme linking failed: " << infoLog << std::endl;
-                return -1;
-            }
+                // 3. Bind it to a specific target. It is GL_TEXTURE_2D here.
+                // RULE: texture_obj should and can NOT be bound to any other target after this point
+                glBindTexture(GL_TEXTURE_2D, texture_obj);
+                // all upcoming GL_TEXTURE_2D operations now have effect on this texture object
+
+                // 4. Set the sampling parameters
+                // Wrapping (edge value sampling)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+                // Filtering
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+                // 5. Get the storage for the texture
+                // Mutable storage in this case
+                if (is_png)
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+                else
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
 
-            // ====================
-            //  TEXTURE UNIT SETUP
-            // ====================
-            // Has to be done once
+                // 6. Storage contents can now be altered after this point.
+                // It is often a good practice to generate a mipmap
+                glGenerateMipmap(GL_TEXTURE_2D);
 
-            // Since we make a modification on the shader, call glUseProgram for the shader programme
-            glUseProgram(shader_programme);
+                // 7. You can now free the loaded image data.
+                stbi_image_free(data);
 
-            // Tell the shader what shader belongs to which texture object
-            // get the location of the sampler variable named "texture1" and 
-            // set the value of that sampler to the corresponding value of the texture image unit
-            glUniform1i(glGetUniformLocation(shader_programme, "texture1"), 0);
-            glUniform1i(glGetUniformLocation(shader_programme, "texture2"), 1);
+                // texture 2
+                // ---------
+                // Repeat steps 1-7 for the second texture
 
-            // NOTE: Make sure you activate the correct texture image unit for the related texture.
+                image_file_path = "resources\\awesomeface.png";
+                is_png = image_file_path.find(".png") != std::string::npos;
+                stbi_set_flip_vertically_on_load(true); // tell stb_image.h to flip loaded texture's on the y-axis.
+                data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
+                if (!data)
+                    std::cerr << "Failed to load texture image!!!" << std::endl;
 
+                // Texture object
+                GLuint texture_obj2;
+                glGenTextures(1, &texture_obj2);
+                glBindTexture(GL_TEXTURE_2D, texture_obj2);
 
-            // ====================
-            //  TRANSFORMATION SETUP
-            // ====================
-            glm::mat4 identity_matrix = glm::mat4(1.0f);
-            // Rotation axis
-            glm::vec3 rotation_axis_vec = glm::vec3(1.0f, 0.0f, 0.0f);
-            // since these are non changing vectors, it's better to keep them 
-            // out of the main loop
-            glm::mat4 view_matrix = glm::translate(identity_matrix, glm::vec3(0.0f, 0.0f, -3.0f));
-            glm::mat4 projection_matrix = glm::perspective(glm::radians(45.0f), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+                // Sampling parameters
+                // wrapping parameters
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+                // texture filtering parameters
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+                // Storage
+                if (is_png)
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+                else
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
 
-            // we need to pass this info to the shader so call use
-            glUseProgram(shader_programme);
+                // Mipmap setup
+                glGenerateMipmap(GL_TEXTURE_2D);
 
-            // Get the locations in the shaders                
-            GLuint view_mat_loc = glGetUniformLocation(shader_programme, "view_matrix");
-            GLuint projection_mat_loc = glGetUniformLocation(shader_programme, "projection_matrix");
-            // Set the data for them (two different ways: pointer or [0][0] syntax)
-            glUniformMatrix4fv(view_mat_loc, 1, GL_FALSE, &view_matrix[0][0]);
-            glUniformMatrix4fv(projection_mat_loc, 1, GL_FALSE, glm::value_ptr(projection_matrix));
+                // free raw data
+                stbi_image_free(data);
+
+                // ====================
+                //      SHADERS
+                // ====================
+                // 8. Define the sources for the vertex and fragment shader
+                const char* vertex_shader_source_str =
+                    "#version 330 core\n"
+                    "layout (location = 0) in vec3 vertex_position;\n"
+                    "layout (location = 1) in vec2 vertex_texture_position;\n"
+                    "out vec2 textureCoord;\n"
+                    "uniform mat4 model_matrix;\n"
+                    "uniform mat4 view_matrix;\n"
+                    "uniform mat4 projection_matrix;\n"
+                    "void main()\n"
+                    "{\n"
+                    "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
+                    "   textureCoord = vec2(vertex_texture_position.x, vertex_texture_position.y);\n"
+                    "}\0";
+
+                // 9. Fragment shader setup
+                const char* fragment_shader_source_str =
+                    "#version 330 core\n"
+                    "in vec2 textureCoord;\n"
+                    "out vec4 frag_color;\n"
+                    "uniform sampler2D texture1;\n" // texture sampler
+                    "uniform sampler2D texture2;\n"
+                    "void main()\n"
+                    "{\n"
+                    "   frag_color = mix(texture(texture1, textureCoord), texture(texture2, textureCoord), 0.2);\n"
+                    "}\0";
+
+                // 10-a. Create the vertex shader
+                GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
+
+                // 10-b. Attach the source string to the shader & compile
+                const GLchar* vertex_shader_source = (const GLchar*)vertex_shader_source_str;
+                glShaderSource(vertex_shader, 1, &vertex_shader_source, NULL);
+                glCompileShader(vertex_shader);
+
+                // 10-c. Check for the errors
+                int success = -1;
+                glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &success);
+                if (GL_TRUE != success)
+                {
+                    char infoLog[512];
+                    glGetShaderInfoLog(vertex_shader, 512, NULL, infoLog);
+                    std::cerr << "Shader can not compile: " << infoLog << "\n";
+                    return -1; // or exit or something
+                }
 
-            // 10-h. Deleting shader at this point does not hurt
-            glDeleteShader(vertex_shader);
-            glDeleteShader(fragment_shader);
+                // 10-d REpeat steps 10-a, b and c for the fragment shader
+                GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
+                const GLchar* fragment_shader_source = (const GLchar*)fragment_shader_source_str;
+                glShaderSource(fragment_shader, 1, &fragment_shader_source, NULL);
+                glCompileShader(fragment_shader);
+                // error check
+                success = -1;
+                glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &success);
+                if (GL_TRUE != success)
+                {
+                    char infoLog[512];
+                    glGetShaderInfoLog(fragment_shader, 512, NULL, infoLog);
+                    std::cerr << "Shader can not compile: " << infoLog << "\n";
+                    return -1; // or exit or something
+                }
 
-            // ====================
-            //      MAIN UI LOOP
-            // ====================
-            /* Loop until the user closes the window */
-            while (!glfwWindowShouldClose(window))
-            {
-                // fps counter
-                Utility::GLFW::update_fps_counter(window);
+                // 10-e. Create the program to attach defined shaders
+                GLuint shader_programme = glCreateProgram();
 
-                /* Render here */
-                glClearColor(0.2f, 0.3f, 0.3f, 1.0f);// scene background color
-                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                // 10-f. Attach & link the shaders to the program
+                glAttachShader(shader_programme, vertex_shader);
+                glAttachShader(shader_programme, fragment_shader);
+                glLinkProgram(shader_programme);
 
-                // Activate the texture image units and bind the associated textures
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, texture_obj);
-                glActiveTexture(GL_TEXTURE1);
-                glBindTexture(GL_TEXTURE_2D, texture_obj2);
+                // 10-g. Check against the linking errors
+                success = -1;
+                glGetProgramiv(shader_programme, GL_LINK_STATUS, &success);
+                if (GL_TRUE != success)
+                {
+                    char infoLog[512];
+                    glGetProgramInfoLog(shader_programme, 512, NULL, infoLog);
+                    std::cerr << "ERROR: Shader programme linking failed: " << infoLog << std::endl;
+                    return -1;
+                }
+
+                // ====================
+                //  TEXTURE UNIT SETUP
+                // ====================
+                // Has to be done once
 
-                // render each box
+                // Since we make a modification on the shader, call glUseProgram for the shader programme
                 glUseProgram(shader_programme);
-                glBindVertexArray(vao);
-                for (unsigned int i = 0; i < 10; i++)
+
+                // Tell the shader what shader belongs to which texture object
+                // get the location of the sampler variable named "texture1" and 
+                // set the value of that sampler to the corresponding value of the texture image unit
+                glUniform1i(glGetUniformLocation(shader_programme, "texture1"), 0);
+                glUniform1i(glGetUniformLocation(shader_programme, "texture2"), 1);
+
+                // NOTE: Make sure you activate the correct texture image unit for the related texture.
+
+
+                // ====================
+                //  TRANSFORMATION SETUP
+                // ====================
+                glm::mat4 identity_matrix = glm::mat4(1.0f);
+                // Rotation axis
+                glm::vec3 rotation_axis_vec = glm::vec3(1.0f, 0.0f, 0.0f);
+                // since these are non changing vectors, it's better to keep them 
+                // out of the main loop
+
+
+                // 10-h. Deleting shader at this point does not hurt
+                glDeleteShader(vertex_shader);
+                glDeleteShader(fragment_shader);
+
+                // ====================
+                //      MAIN UI LOOP
+                // ====================
+                /* Loop until the user closes the window */
+                while (!glfwWindowShouldClose(window))
                 {
-                    // calculate the model matrix for each object and pass it to shader before drawing
-                    glm::mat4 model_matrix = glm::translate(identity_matrix, cubePositions[i]);
-                    float angle = 20.0f * i;
-                    if (rotate && i % 3 == 0)  // every 3rd iteration (including the first) we set the angle using GLFW's time function.
-                        angle = glfwGetTime() * 25.0f;
+                    // fps counter
+                    Utility::GLFW::update_fps_counter(window);
 
-                    model_matrix = glm::rotate(model_matrix, glm::radians(angle), glm::vec3(1.0f, 0.3f, 0.5f));
+                    /* Render here */
+                    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);// scene background color
+                    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-                    GLuint model_mat_loc = glGetUniformLocation(shader_programme, "model_matrix");
-                    glUniformMatrix4fv(model_mat_loc, 1, GL_FALSE, glm::value_ptr(model_matrix));
-                    glDrawArrays(GL_TRIANGLES, 0, 36);
-                }
+                    // Activate the texture image units and bind the associated textures
+                    glActiveTexture(GL_TEXTURE0);
+                    glBindTexture(GL_TEXTURE_2D, texture_obj);
+                    glActiveTexture(GL_TEXTURE1);
+                    glBindTexture(GL_TEXTURE_2D, texture_obj2);
 
-                /* Swap front and back buffers */
-                /* update other events like input handling */
-                glfwSwapBuffers(window);
+                    // Transformation setup
+                    // continuous rotation around the rotation axis vector
+                    glm::mat4 model_matrix = glm::rotate(identity_matrix, (float)glfwGetTime(), rotation_axis_vec);
+                    glm::mat4 view_matrix = glm::translate(identity_matrix, glm::vec3(0.0f, 0.0f, -3.0f));
+                    glm::mat4 projection_matrix = glm::perspective(glm::radians(45.0f), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
 
-                /* Poll for and process events */
-                /* put the stuff we've been drawing onto the display */
-                glfwPollEvents();
-            }
+                    // we need to pass this info to the shader so call use
+                    glUseProgram(shader_programme);
 
-            glDeleteVertexArrays(1, &vao);
-            glDeleteBuffers(1, &vbo);
-            glDeleteProgram(shader_programme);
+                    // Get the locations in the shaders
+                    GLuint model_mat_loc = glGetUniformLocation(shader_programme, "model_matrix");
+                    GLuint view_mat_loc = glGetUniformLocation(shader_programme, "view_matrix");
+                    GLuint projection_mat_loc = glGetUniformLocation(shader_programme, "projection_matrix");
+                    // Set the data for them (two different ways: pointer or [0][0] syntax)
+                    glUniformMatrix4fv(model_mat_loc, 1, GL_FALSE, glm::value_ptr(model_matrix));
+                    glUniformMatrix4fv(view_mat_loc, 1, GL_FALSE, &view_matrix[0][0]);
+                    glUniformMatrix4fv(projection_mat_loc, 1, GL_FALSE, glm::value_ptr(projection_matrix));
 
-            glfwTerminate();
-            return 0;
-        }
+                    meshes.Draw(cube);
 
-    }
+                    /* Swap front and back buffers */
+                    /* update other events like input handling */
+                    glfwSwapBuffers(window);
 
-    namespace getting_started::camera
-    {
-        void TestVectors()
-        {
-            glm::vec3 cameraPos = glm::vec3(0.0f, 0.0f, 3.0f);
-            glm::vec3 cameraTarget = glm::vec3(0.0f, 0.0f, 0.0f);
-            glm::vec3 beforeNormalze = cameraPos - cameraTarget;
-            // Normalize to its unit vector
-            glm::vec3 cameraDirection = glm::normalize(beforeNormalze);
+                    /* Poll for and process events */
+                    /* put the stuff we've been drawing onto the display */
+                    glfwPollEvents();
+                }
 
-            std::cout << "beforeNormalze: " << beforeNormalze.x << ", "
-                << beforeNormalze.y << ", "
-                << beforeNormalze.z << "\n";
+                glDeleteProgram(shader_programme);
+            }
 
-            std::cout << "CameraDir: " << cameraDirection.x << ", "
-                << cameraDirection.y << ", "
-                << cameraDirection.z << "\n";
+            glfwTerminate();
+            return 0;
         }
 
-        int MultipleCubeCameraRotatesAroundTheScene()
+        int MultipleCubes(bool rotate)
         {
             // Initialize the glfw & glew
             GLFWwindow* window = Utility::GLFW::start_glfw();
@@ -3847,358 +3337,310 @@ namespace tutorials
             // ====================
             // VBO - VAO GENERATION
             // ====================
-            // 1. Vertex data for positions, colors and texture coordinates
-            GLfloat vertices[] = {
-                // coords             // texture
-                -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
-                 0.5f, -0.5f, -0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
-
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
-                -0.5f,  0.5f,  0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-
-                -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                -0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f, -0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-
-                -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                -0.5f,  0.5f,  0.5f,  0.0f, 0.0f,
-                -0.5f,  0.5f, -0.5f,  0.0f, 1.0f
-            };
 
             // world space positions of our cubes
             glm::vec3 cubePositions[] = {
-                glm::vec3(0.0f,  0.0f,  0.0f),
-                glm::vec3(2.0f,  5.0f, -15.0f),
+                glm::vec3( 0.0f,  0.0f,  0.0f),
+                glm::vec3( 2.0f,  5.0f, -15.0f),
                 glm::vec3(-1.5f, -2.2f, -2.5f),
                 glm::vec3(-3.8f, -2.0f, -12.3f),
-                glm::vec3(2.4f, -0.4f, -3.5f),
+                glm::vec3( 2.4f, -0.4f, -3.5f),
                 glm::vec3(-1.7f,  3.0f, -7.5f),
-                glm::vec3(1.3f, -2.0f, -2.5f),
-                glm::vec3(1.5f,  2.0f, -2.5f),
-                glm::vec3(1.5f,  0.2f, -1.5f),
+                glm::vec3( 1.3f, -2.0f, -2.5f),
+                glm::vec3( 1.5f,  2.0f, -2.5f),
+                glm::vec3( 1.5f,  0.2f, -1.5f),
                 glm::vec3(-1.3f,  1.0f, -1.5f)
             };
 
 
-            // Generate tightly-packed VBO and then the Indexed VBO
-            // 2,3 & 4
-            GLuint vbo;
-            glGenBuffers(1, &vbo);
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
-            glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-            // 5. Generate and bind VAO
-            GLuint vao;
-            glGenVertexArrays(1, &vao);
-            glBindVertexArray(vao);
-
-            // 6. Define and associate the vertex attributes to the vbo
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
-            //positions
-            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid*)0);
-            glEnableVertexAttribArray(0);
-            //textures
-            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
-            glEnableVertexAttribArray(1);
-
-            glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-            // ====================
-            //    TEXTURE SETUP
-            // ====================
-
-            // texture 1
-            // ---------
-
-            // 1. Load the corresponding image
-            std::string image_file_path("resources\\container.jpg");
-            bool is_png = image_file_path.find(".png") != std::string::npos;
-
-            int width, height, nrChannels;
-            unsigned char* data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
-            if (!data)
-                std::cerr << "Failed to load texture image!!!" << std::endl;
-
-            // 2. Generate the texture object like any other OpenGL object
-            GLuint texture_obj;
-            glGenTextures(1, &texture_obj);
-
-            // 3. Bind it to a specific target. It is GL_TEXTURE_2D here.
-            // RULE: texture_obj should and can NOT be bound to any other target after this point
-            glBindTexture(GL_TEXTURE_2D, texture_obj);
-            // all upcoming GL_TEXTURE_2D operations now have effect on this texture object
-
-            // 4. Set the sampling parameters
-            // Wrapping (edge value sampling)
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            // Filtering
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-            // 5. Get the storage for the texture
-            // Mutable storage in this case
-            if (is_png)
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-            else
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-
-            // 6. Storage contents can now be altered after this point.
-            // It is often a good practice to generate a mipmap
-            glGenerateMipmap(GL_TEXTURE_2D);
-
-            // 7. You can now free the loaded image data.
-            stbi_image_free(data);
-
-            // texture 2
-            // ---------
-            // Repeat steps 1-7 for the second texture
-
-            image_file_path = "resources\\awesomeface.png";
-            is_png = image_file_path.find(".png") != std::string::npos;
-            stbi_set_flip_vertically_on_load(true); // tell stb_image.h to flip loaded texture's on the y-axis.
-            data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
-            if (!data)
-                std::cerr << "Failed to load texture image!!!" << std::endl;
-
-            // Texture object
-            GLuint texture_obj2;
-            glGenTextures(1, &texture_obj2);
-            glBindTexture(GL_TEXTURE_2D, texture_obj2);
+            {
+                // Positions and texture coordinates of the cube come from the mesh library
+                Utility::mesh::MeshLibrary meshes;
+                Utility::mesh::MeshHandle cube = meshes.Get(Utility::mesh::Primitive::Cube, Utility::mesh::Position | Utility::mesh::TexCoord);
 
-            // Sampling parameters
-            // wrapping parameters
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            // texture filtering parameters
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                // ====================
+                //    TEXTURE SETUP
+                // ====================
 
-            // Storage
-            if (is_png)
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-            else
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+                // texture 1
+                // ---------
 
-            // Mipmap setup
-            glGenerateMipmap(GL_TEXTURE_2D);
+                // 1. Load the corresponding image
+                std::string image_file_path("resources\\container.jpg");
+                bool is_png = image_file_path.find(".png") != std::string::npos;
 
-            // free raw data
-            stbi_image_free(data);
+                int width, height, nrChannels;
+                unsigned char* data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
+                if (!data)
+                    std::cerr << "Failed to load texture image!!!" << std::endl;
 
-            // ====================
-            //      SHADERS
-            // ====================
-            // 8. Define the sources for the vertex and fragment shader
-            const char* vertex_shader_source_str =
-                "#version 330 core\n"
-                "layout (location = 0) in vec3 vertex_position;\n"
-                "layout (location = 1) in vec2 vertex_texture_position;\n"
-                "out vec2 textureCoord;\n"
-                "uniform mat4 model_matrix;\n"
-                "uniform mat4 view_matrix;\n"
-                "uniform mat4 projection_matrix;\n"
-                "void main()\n"
-                "{\n"
-                "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
-                "   textureCoord = vec2(vertex_texture_position.x, vertex_texture_position.y);\n"
-                "}\0";
+                // 2. Generate the texture object like any other OpenGL object
+                GLuint texture_obj;
+                glGenTextures(1, &texture_obj);
 
-            // 9. Fragment shader setup
-            const char* fragment_shader_source_str =
-                "#version 330 core\n"
-                "in vec2 textureCoord;\n"
-                "out vec4 frag_color;\n"
-                "uniform sampler2D texture1;\n" // texture sampler
-                "uniform sampler2D texture2;\n"
-                "void main()\n"
-                "{\n"
-                "   frag_color = mix(texture(texture1, textureCoord), texture(texture2, textureCoord), 0.2);\n"
-                "}\0";
+                // 3. Bind it to a specific target. It is GL_TEXTURE_2D here.
+                // RULE: texture_obj should and can NOT be bound to any other target after this point
+                glBindTexture(GL_TEXTURE_2D, texture_obj);
+                // all upcoming GL_TEXTURE_2D operations now have effect on this texture object
+
+                // 4. Set the sampling parameters
+                // Wrapping (edge value sampling)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+                // Filtering
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+                // 5. Get the storage for the texture
+                // Mutable storage in this case
+                if (is_png)
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+                else
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
 
-            // 10-a. Create the vertex shader
-            GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
+                // 6. Storage contents can now be altered after this point.
+                // It is often a good practice to generate a mipmap
+                glGenerateMipmap(GL_TEXTURE_2D);
 
-            // 10-b. Attach the source string to the shader & compile
-            const GLchar* vertex_shader_source = (const GLchar*)vertex_shader_source_str;
-            glShaderSource(vertex_shader, 1, &vertex_shader_source, NULL);
-            glCompileShader(vertex_shader);
+                // 7. You can now free the loaded image data.
+                stbi_image_free(data);
 
-            // 10-c. Check for the errors
-            int success = -1;
-            glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &success);
-            if (GL_TRUE != success)
-            {
-                char infoLog[512];
-                glGetShaderInfoLog(vertex_shader, 512, NULL, infoLog);
-                std::cerr << "Shader can not compile: " << infoLog << "\n";
-                return -1; // or exit or something
-            }
+                // texture 2
+                // ---------
+                // Repeat steps 1-7 for the second texture
 
-            // 10-d REpeat steps 10-a, b and c for the fragment shader
-            GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
-            const GLchar* fragment_shader_source = (const GLchar*)fragment_shader_source_str;
-            glShaderSource(fragment_shader, 1, &fragment_shader_source, NULL);
-            glCompileShader(fragment_shader);
-            // error check
-            success = -1;
-            glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &success);
-            if (GL_TRUE != success)
-            {
-                char infoLog[512];
-                glGetShaderInfoLog(fragment_shader, 512, NULL, infoLog);
-                std::cerr << "Shader can not compile: " << infoLog << "\n";
-                return -1; // or exit or something
-            }
+                image_file_path = "resources\\awesomeface.png";
+                is_png = image_file_path.find(".png") != std::string::npos;
+                stbi_set_flip_vertically_on_load(true); // tell stb_image.h to flip loaded texture's on the y-axis.
+                data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
+                if (!data)
+                    std::cerr << "Failed to load texture image!!!" << std::endl;
 
-            // 10-e. Create the program to attach defined shaders
-            GLuint shader_programme = glCreateProgram();
+                // Texture object
+                GLuint texture_obj2;
+                glGenTextures(1, &texture_obj2);
+                glBindTexture(GL_TEXTURE_2D, texture_obj2);
 
-            // 10-f. Attach & link the shaders to the program
-            glAttachShader(shader_programme, vertex_shader);
-            glAttachShader(shader_programme, fragment_shader);
-            glLinkProgram(shader_programme);
+                // Sampling parameters
+                // wrapping parameters
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+                // texture filtering parameters
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+                // Storage
+                if (is_png)
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+                else
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
 
-            // 10-g. Check against the linking errors
-            success = -1;
-            glGetProgramiv(shader_programme, GL_LINK_STATUS, &success);
-            if (GL_TRUE != success)
-            {
-                char infoLog[512];
-                glGetProgramInfoLog(shader_programme, 512, NULL, infoLog);
-                std::cerr << "ERROR: Shader programme linking failed: " << infoLog << std::endl;
-                return -1;
-            }
+                // Mipmap setup
+                glGenerateMipmap(GL_TEXTURE_2D);
 
-            // ====================
-            //  TEXTURE UNIT SETUP
-            // ====================
-            // Has to be done once
+                // free raw data
+                stbi_image_free(data);
+
+                // ====================
+                //      SHADERS
+                // ====================
+                // 8. Define the sources for the vertex and fragment shader
+                const char* vertex_shader_source_str =
+                    "#version 330 core\n"
+                    "layout (location = 0) in vec3 vertex_position;\n"
+                    "layout (location = 1) in vec2 vertex_texture_position;\n"
+                    "out vec2 textureCoord;\n"
+                    "uniform mat4 model_matrix;\n"
+                    "uniform mat4 view_matrix;\n"
+                    "uniform mat4 projection_matrix;\n"
+                    "void main()\n"
+                    "{\n"
+                    "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
+                    "   textureCoord = vec2(vertex_texture_position.x, vertex_texture_position.y);\n"
+                    "}\0";
+
+                // 9. Fragment shader setup
+                const char* fragment_shader_source_str =
+                    "#version 330 core\n"
+                    "in vec2 textureCoord;\n"
+                    "out vec4 frag_color;\n"
+                    "uniform sampler2D texture1;\n" // texture sampler
+                    "uniform sampler2D texture2;\n"
+                    "void main()\n"
+                    "{\n"
+                    "   frag_color = mix(texture(texture1, textureCoord), texture(texture2, textureCoord), 0.2);\n"
+                    "}\0";
+
+                // 10-a. Create the vertex shader
+                GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
+
+                // 10-b. Attach the source string to the shader & compile
+                const GLchar* vertex_shader_source = (const GLchar*)vertex_shader_source_str;
+                glShaderSource(vertex_shader, 1, &vertex_shader_source, NULL);
+                glCompileShader(vertex_shader);
+
+                // 10-c. Check for the errors
+                int success = -1;
+                glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &success);
+                if (GL_TRUE != success)
+                {
+                    char infoLog[512];
+                    glGetShaderInfoLog(vertex_shader, 512, NULL, infoLog);
+                    std::cerr << "Shader can not compile: " << infoLog << "\n";
+                    return -1; // or exit or something
+                }
 
-            // Since we make a modification on the shader, call glUseProgram for the shader programme
-            glUseProgram(shader_programme);
+                // 10-d REpeat steps 10-a, b and c for the fragment shader
+                GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
+                const GLchar* fragment_shader_source = (const GLchar*)fragment_shader_source_str;
+                glShaderSource(fragment_shader, 1, &fragment_shader_source, NULL);
+                glCompileShader(fragment_shader);
+                // error check
+                success = -1;
+                glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &success);
+                if (GL_TRUE != success)
+                {
+                    char infoLog[512];
+                    glGetShaderInfoLog(fragment_shader, 512, NULL, infoLog);
+                    std::cerr << "Shader can not compile: " << infoLog << "\n";
+                    return -1; // or exit or something
+                }
 
-            // Tell the shader what shader belongs to which texture object
-            // get the location of the sampler variable named "texture1" and 
-            // set the value of that sampler to the corresponding value of the texture image unit
-            glUniform1i(glGetUniformLocation(shader_programme, "texture1"), 0);
-            glUniform1i(glGetUniformLocation(shader_programme, "texture2"), 1);
+                // 10-e. Create the program to attach defined shaders
+                GLuint shader_programme = glCreateProgram();
 
-            // NOTE: Make sure you activate the correct texture image unit for the related texture.
+                // 10-f. Attach & link the shaders to the program
+                glAttachShader(shader_programme, vertex_shader);
+                glAttachShader(shader_programme, fragment_shader);
+                glLinkProgram(shader_programme);
 
+                // 10-g. Check against the linking errors
+                success = -1;
+                glGetProgramiv(shader_programme, GL_LINK_STATUS, &success);
+                if (GL_TRUE != success)
+                {
+                    char infoLog[512];
+                    glGetProgramInfoLog(shader_programme, 512, NULL, infoLog);
+                    std::cerr << "ERROR: Shader programme linking failed: " << infoLog << std::endl;
+                    return -1;
+                }
 
-            // ====================
-            //  TRANSFORMATION SETUP
-            // ====================
-            glm::mat4 identity_matrix = glm::mat4(1.0f);
-            glm::mat4 projection_matrix = glm::perspective(glm::radians(45.0f), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+                // ====================
+                //  TEXTURE UNIT SETUP
+                // ====================
+                // Has to be done once
 
-            // we need to pass this info to the shader so call use
-            glUseProgram(shader_programme);
+                // Since we make a modification on the shader, call glUseProgram for the shader programme
+                glUseProgram(shader_programme);
 
-            // Get the locations in the shaders                
-            GLuint projection_mat_loc = glGetUniformLocation(shader_programme, "projection_matrix");
-            // Set the data for them (two different ways: pointer or [0][0] syntax)
-            glUniformMatrix4fv(projection_mat_loc, 1, GL_FALSE, glm::value_ptr(projection_matrix));
+                // Tell the shader what shader belongs to which texture object
+                // get the location of the sampler variable named "texture1" and 
+                // set the value of that sampler to the corresponding value of the texture image unit
+                glUniform1i(glGetUniformLocation(shader_programme, "texture1"), 0);
+                glUniform1i(glGetUniformLocation(shader_programme, "texture2"), 1);
 
-            
-            // 10-h. Deleting shader at this point does not hurt
-            glDeleteShader(vertex_shader);
-            glDeleteShader(fragment_shader);
+                // NOTE: Make sure you activate the correct texture image unit for the related texture.
 
-            // ====================
-            //      MAIN UI LOOP
-            // ====================
-            /* Loop until the user closes the window */
-            while (!glfwWindowShouldClose(window))
-            {
-                // fps counter
-                Utility::GLFW::update_fps_counter(window);
 
-                /* Render here */
-                glClearColor(0.2f, 0.3f, 0.3f, 1.0f);// scene background color
-                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                // ====================
+                //  TRANSFORMATION SETUP
+                // ====================
+                glm::mat4 identity_matrix = glm::mat4(1.0f);
+                // Rotation axis
+                glm::vec3 rotation_axis_vec = glm::vec3(1.0f, 0.0f, 0.0f);
+                // since these are non changing vectors, it's better to keep them 
+                // out of the main loop
+                glm::mat4 view_matrix = glm::translate(identity_matrix, glm::vec3(0.0f, 0.0f, -3.0f));
+                glm::mat4 projection_matrix = glm::perspective(glm::radians(45.0f), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
 
-                // Activate the texture image units and bind the associated textures
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, texture_obj);
-                glActiveTexture(GL_TEXTURE1);
-                glBindTexture(GL_TEXTURE_2D, texture_obj2);
-                
-                // Activate the shader programme
+                // we need to pass this info to the shader so call use
                 glUseProgram(shader_programme);
 
-                // camera/view transformation
-                glm::mat4 view_matrix = identity_matrix;
-                float radius = 10.0f;
-                float camX = sin(glfwGetTime()) * radius;
-                float camZ = cos(glfwGetTime()) * radius;
-                view_matrix = glm::lookAt(glm::vec3(camX, 0.0f, camZ), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
                 // Get the locations in the shaders                
                 GLuint view_mat_loc = glGetUniformLocation(shader_programme, "view_matrix");
+                GLuint projection_mat_loc = glGetUniformLocation(shader_programme, "projection_matrix");
                 // Set the data for them (two different ways: pointer or [0][0] syntax)
                 glUniformMatrix4fv(view_mat_loc, 1, GL_FALSE, &view_matrix[0][0]);
+                glUniformMatrix4fv(projection_mat_loc, 1, GL_FALSE, glm::value_ptr(projection_matrix));
 
-                // render each box
-                glBindVertexArray(vao);
-                for (unsigned int i = 0; i < 10; i++)
+                // 10-h. Deleting shader at this point does not hurt
+                glDeleteShader(vertex_shader);
+                glDeleteShader(fragment_shader);
+
+                // ====================
+                //      MAIN UI LOOP
+                // ====================
+                /* Loop until the user closes the window */
+                while (!glfwWindowShouldClose(window))
                 {
-                    // calculate the model matrix for each object and pass it to shader before drawing
-                    glm::mat4 model_matrix = glm::translate(identity_matrix, cubePositions[i]);
-                    float angle = 20.0f * i;
-                    model_matrix = glm::rotate(model_matrix, glm::radians(angle), glm::vec3(1.0f, 0.3f, 0.5f));
+                    // fps counter
+                    Utility::GLFW::update_fps_counter(window);
 
-                    GLuint model_mat_loc = glGetUniformLocation(shader_programme, "model_matrix");
-                    glUniformMatrix4fv(model_mat_loc, 1, GL_FALSE, glm::value_ptr(model_matrix));
-                    glDrawArrays(GL_TRIANGLES, 0, 36);
-                }
+                    /* Render here */
+                    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);// scene background color
+                    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-                /* Swap front and back buffers */
-                /* update other events like input handling */
-                glfwSwapBuffers(window);
+                    // Activate the texture image units and bind the associated textures
+                    glActiveTexture(GL_TEXTURE0);
+                    glBindTexture(GL_TEXTURE_2D, texture_obj);
+                    glActiveTexture(GL_TEXTURE1);
+                    glBindTexture(GL_TEXTURE_2D, texture_obj2);
 
-                /* Poll for and process events */
-                /* put the stuff we've been drawing onto the display */
-                glfwPollEvents();
-            }
+                    // render each box
+                    glUseProgram(shader_programme);
+                    for (unsigned int i = 0; i < 10; i++)
+                    {
+                        // calculate the model matrix for each object and pass it to shader before drawing
+                        glm::mat4 model_matrix = glm::translate(identity_matrix, cubePositions[i]);
+                        float angle = 20.0f * i;
+                        if (rotate && i % 3 == 0)  // every 3rd iteration (including the first) we set the angle using GLFW's time function.
+                            angle = glfwGetTime() * 25.0f;
 
-            glDeleteVertexArrays(1, &vao);
-            glDeleteBuffers(1, &vbo);
-            glDeleteProgram(shader_programme);
+                        model_matrix = glm::rotate(model_matrix, glm::radians(angle), glm::vec3(1.0f, 0.3f, 0.5f));
+
+                        GLuint model_mat_loc = glGetUniformLocation(shader_programme, "model_matrix");
+                        glUniformMatrix4fv(model_mat_loc, 1, GL_FALSE, glm::value_ptr(model_matrix));
+                        meshes.Draw(cube);
+                    }
+
+                    /* Swap front and back buffers */
+                    /* update other events like input handling */
+                    glfwSwapBuffers(window);
+
+                    /* Poll for and process events */
+                    /* put the stuff we've been drawing onto the display */
+                    glfwPollEvents();
+                }
+
+                glDeleteProgram(shader_programme);
+            }
 
             glfwTerminate();
             return 0;
         }
 
-        int WalkAroundMultipleCubesWithUserInput()
+    }
+
+    namespace getting_started::camera
+    {
+        void TestVectors()
+        {
+            glm::vec3 cameraPos = glm::vec3(0.0f, 0.0f, 3.0f);
+            glm::vec3 cameraTarget = glm::vec3(0.0f, 0.0f, 0.0f);
+            glm::vec3 beforeNormalze = cameraPos - cameraTarget;
+            // Normalize to its unit vector
+            glm::vec3 cameraDirection = glm::normalize(beforeNormalze);
+
+            std::cout << "beforeNormalze: " << beforeNormalze.x << ", "
+                << beforeNormalze.y << ", "
+                << beforeNormalze.z << "\n";
+
+            std::cout << "CameraDir: " << cameraDirection.x << ", "
+                << cameraDirection.y << ", "
+                << cameraDirection.z << "\n";
+        }
+
+        int MultipleCubeCameraRotatesAroundTheScene()
         {
             // Initialize the glfw & glew
             GLFWwindow* window = Utility::GLFW::start_glfw();
@@ -4212,51 +3654,6 @@ namespace tutorials
             // ====================
             // VBO - VAO GENERATION
             // ====================
-            // 1. Vertex data for positions, colors and texture coordinates
-            GLfloat vertices[] = {
-                // coords             // texture
-                -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
-                 0.5f, -0.5f, -0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
-
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
-                -0.5f,  0.5f,  0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-
-                -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                -0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f, -0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-
-                -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                -0.5f,  0.5f,  0.5f,  0.0f, 0.0f,
-                -0.5f,  0.5f, -0.5f,  0.0f, 1.0f
-            };
 
             // world space positions of our cubes
             glm::vec3 cubePositions[] = {
@@ -4273,321 +3670,601 @@ namespace tutorials
             };
 
 
-            // Generate tightly-packed VBO and then the Indexed VBO
-            // 2,3 & 4
-            GLuint vbo;
-            glGenBuffers(1, &vbo);
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
-            glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+            {
+                // Positions and texture coordinates of the cube come from the mesh library
+                Utility::mesh::MeshLibrary meshes;
+                Utility::mesh::MeshHandle cube = meshes.Get(Utility::mesh::Primitive::Cube, Utility::mesh::Position | Utility::mesh::TexCoord);
 
-            // 5. Generate and bind VAO
-            GLuint vao;
-            glGenVertexArrays(1, &vao);
-            glBindVertexArray(vao);
+                // ====================
+                //    TEXTURE SETUP
+                // ====================
 
-            // 6. Define and associate the vertex attributes to the vbo
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
-            //positions
-            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid*)0);
-            glEnableVertexAttribArray(0);
-            //textures
-            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
-            glEnableVertexAttribArray(1);
+                // texture 1
+                // ---------
 
-            glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
+                // 1. Load the corresponding image
+                std::string image_file_path("resources\\container.jpg");
+                bool is_png = image_file_path.find(".png") != std::string::npos;
 
-            // ====================
-            //    TEXTURE SETUP
-            // ====================
+                int width, height, nrChannels;
+                unsigned char* data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
+                if (!data)
+                    std::cerr << "Failed to load texture image!!!" << std::endl;
 
-            // texture 1
-            // ---------
+                // 2. Generate the texture object like any other OpenGL object
+                GLuint texture_obj;
+                glGenTextures(1, &texture_obj);
 
-            // 1. Load the corresponding image
-            std::string image_file_path("resources\\container.jpg");
-            bool is_png = image_file_path.find(".png") != std::string::npos;
+                // 3. Bind it to a specific target. It is GL_TEXTURE_2D here.
+                // RULE: texture_obj should and can NOT be bound to any other target after this point
+                glBindTexture(GL_TEXTURE_2D, texture_obj);
+                // all upcoming GL_TEXTURE_2D operations now have effect on this texture object
+
+                // 4. Set the sampling parameters
+                // Wrapping (edge value sampling)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+                // Filtering
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+                // 5. Get the storage for the texture
+                // Mutable storage in this case
+                if (is_png)
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+                else
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
 
-            int width, height, nrChannels;
-            unsigned char* data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
-            if (!data)
-                std::cerr << "Failed to load texture image!!!" << std::endl;
+                // 6. Storage contents can now be altered after this point.
+                // It is often a good practice to generate a mipmap
+                glGenerateMipmap(GL_TEXTURE_2D);
 
-            // 2. Generate the texture object like any other OpenGL object
-            GLuint texture_obj;
-            glGenTextures(1, &texture_obj);
+                // 7. You can now free the loaded image data.
+                stbi_image_free(data);
 
-            // 3. Bind it to a specific target. It is GL_TEXTURE_2D here.
-            // RULE: texture_obj should and can NOT be bound to any other target after this point
-            glBindTexture(GL_TEXTURE_2D, texture_obj);
-            // all upcoming GL_TEXTURE_2D operations now have effect on this texture object
+                // texture 2
+                // ---------
+                // Repeat steps 1-7 for the second texture
 
-            // 4. Set the sampling parameters
-            // Wrapping (edge value sampling)
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            // Filtering
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                image_file_path = "resources\\awesomeface.png";
+                is_png = image_file_path.find(".png") != std::string::npos;
+                stbi_set_flip_vertically_on_load(true); // tell stb_image.h to flip loaded texture's on the y-axis.
+                data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
+                if (!data)
+                    std::cerr << "Failed to load texture image!!!" << std::endl;
 
-            // 5. Get the storage for the texture
-            // Mutable storage in this case
-            if (is_png)
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-            else
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+                // Texture object
+                GLuint texture_obj2;
+                glGenTextures(1, &texture_obj2);
+                glBindTexture(GL_TEXTURE_2D, texture_obj2);
 
-            // 6. Storage contents can now be altered after this point.
-            // It is often a good practice to generate a mipmap
-            glGenerateMipmap(GL_TEXTURE_2D);
+                // Sampling parameters
+                // wrapping parameters
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+                // texture filtering parameters
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+                // Storage
+                if (is_png)
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+                else
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
 
-            // 7. You can now free the loaded image data.
-            stbi_image_free(data);
+                // Mipmap setup
+                glGenerateMipmap(GL_TEXTURE_2D);
 
-            // texture 2
-            // ---------
-            // Repeat steps 1-7 for the second texture
+                // free raw data
+                stbi_image_free(data);
+
+                // ====================
+                //      SHADERS
+                // ====================
+                // 8. Define the sources for the vertex and fragment shader
+                const char* vertex_shader_source_str =
+                    "#version 330 core\n"
+                    "layout (location = 0) in vec3 vertex_position;\n"
+                    "layout (location = 1) in vec2 vertex_texture_position;\n"
+                    "out vec2 textureCoord;\n"
+                    "uniform mat4 model_matrix;\n"
+                    "uniform mat4 view_matrix;\n"
+                    "uniform mat4 projection_matrix;\n"
+                    "void main()\n"
+                    "{\n"
+                    "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
+                    "   textureCoord = vec2(vertex_texture_position.x, vertex_texture_position.y);\n"
+                    "}\0";
+
+                // 9. Fragment shader setup
+                const char* fragment_shader_source_str =
+                    "#version 330 core\n"
+                    "in vec2 textureCoord;\n"
+                    "out vec4 frag_color;\n"
+                    "uniform sampler2D texture1;\n" // texture sampler
+                    "uniform sampler2D texture2;\n"
+                    "void main()\n"
+                    "{\n"
+                    "   frag_color = mix(texture(texture1, textureCoord), texture(texture2, textureCoord), 0.2);\n"
+                    "}\0";
+
+                // 10-a. Create the vertex shader
+                GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
+
+                // 10-b. Attach the source string to the shader & compile
+                const GLchar* vertex_shader_source = (const GLchar*)vertex_shader_source_str;
+                glShaderSource(vertex_shader, 1, &vertex_shader_source, NULL);
+                glCompileShader(vertex_shader);
+
+                // 10-c. Check for the errors
+                int success = -1;
+                glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &success);
+                if (GL_TRUE != success)
+                {
+                    char infoLog[512];
+                    glGetShaderInfoLog(vertex_shader, 512, NULL, infoLog);
+                    std::cerr << "Shader can not compile: " << infoLog << "\n";
+                    return -1; // or exit or something
+                }
 
-            image_file_path = "resources\\awesomeface.png";
-            is_png = image_file_path.find(".png") != std::string::npos;
-            stbi_set_flip_vertically_on_load(true); // tell stb_image.h to flip loaded texture's on the y-axis.
-            data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
-            if (!data)
-                std::cerr << "Failed to load texture image!!!" << std::endl;
+                // 10-d REpeat steps 10-a, b and c for the fragment shader
+                GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
+                const GLchar* fragment_shader_source = (const GLchar*)fragment_shader_source_str;
+                glShaderSource(fragment_shader, 1, &fragment_shader_source, NULL);
+                glCompileShader(fragment_shader);
+                // error check
+                success = -1;
+                glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &success);
+                if (GL_TRUE != success)
+                {
+                    char infoLog[512];
+                    glGetShaderInfoLog(fragment_shader, 512, NULL, infoLog);
+                    std::cerr << "Shader can not compile: " << infoLog << "\n";
+                    return -1; // or exit or something
+                }
 
-            // Texture object
-            GLuint texture_obj2;
-            glGenTextures(1, &texture_obj2);
-            glBindTexture(GL_TEXTURE_2D, texture_obj2);
+                // 10-e. Create the program to attach defined shaders
+                GLuint shader_programme = glCreateProgram();
 
-            // Sampling parameters
-            // wrapping parameters
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            // texture filtering parameters
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                // 10-f. Attach & link the shaders to the program
+                glAttachShader(shader_programme, vertex_shader);
+                glAttachShader(shader_programme, fragment_shader);
+                glLinkProgram(shader_programme);
 
-            // Storage
-            if (is_png)
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-            else
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+                // 10-g. Check against the linking errors
+                success = -1;
+                glGetProgramiv(shader_programme, GL_LINK_STATUS, &success);
+                if (GL_TRUE != success)
+                {
+                    char infoLog[512];
+                    glGetProgramInfoLog(shader_programme, 512, NULL, infoLog);
+                    std::cerr << "ERROR: Shader programme linking failed: " << infoLog << std::endl;
+                    return -1;
+                }
 
-            // Mipmap setup
-            glGenerateMipmap(GL_TEXTURE_2D);
+                // ====================
+                //  TEXTURE UNIT SETUP
+                // ====================
+                // Has to be done once
 
-            // free raw data
-            stbi_image_free(data);
+                // Since we make a modification on the shader, call glUseProgram for the shader programme
+                glUseProgram(shader_programme);
+
+                // Tell the shader what shader belongs to which texture object
+                // get the location of the sampler variable named "texture1" and 
+                // set the value of that sampler to the corresponding value of the texture image unit
+                glUniform1i(glGetUniformLocation(shader_programme, "texture1"), 0);
+                glUniform1i(glGetUniformLocation(shader_programme, "texture2"), 1);
+
+                // NOTE: Make sure you activate the correct texture image unit for the related texture.
+
+
+                // ====================
+                //  TRANSFORMATION SETUP
+                // ====================
+                glm::mat4 identity_matrix = glm::mat4(1.0f);
+                glm::mat4 projection_matrix = glm::perspective(glm::radians(45.0f), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+
+                // we need to pass this info to the shader so call use
+                glUseProgram(shader_programme);
+
+                // Get the locations in the shaders                
+                GLuint projection_mat_loc = glGetUniformLocation(shader_programme, "projection_matrix");
+                // Set the data for them (two different ways: pointer or [0][0] syntax)
+                glUniformMatrix4fv(projection_mat_loc, 1, GL_FALSE, glm::value_ptr(projection_matrix));
+
+
+                // 10-h. Deleting shader at this point does not hurt
+                glDeleteShader(vertex_shader);
+                glDeleteShader(fragment_shader);
+
+                // ====================
+                //      MAIN UI LOOP
+                // ====================
+                /* Loop until the user closes the window */
+                while (!glfwWindowShouldClose(window))
+                {
+                    // fps counter
+                    Utility::GLFW::update_fps_counter(window);
+
+                    /* Render here */
+                    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);// scene background color
+                    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                    // Activate the texture image units and bind the associated textures
+                    glActiveTexture(GL_TEXTURE0);
+                    glBindTexture(GL_TEXTURE_2D, texture_obj);
+                    glActiveTexture(GL_TEXTURE1);
+                    glBindTexture(GL_TEXTURE_2D, texture_obj2);
+
+                    // Activate the shader programme
+                    glUseProgram(shader_programme);
+
+                    // camera/view transformation
+                    glm::mat4 view_matrix = identity_matrix;
+                    float radius = 10.0f;
+                    float camX = sin(glfwGetTime()) * radius;
+                    float camZ = cos(glfwGetTime()) * radius;
+                    view_matrix = glm::lookAt(glm::vec3(camX, 0.0f, camZ), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+                    // Get the locations in the shaders                
+                    GLuint view_mat_loc = glGetUniformLocation(shader_programme, "view_matrix");
+                    // Set the data for them (two different ways: pointer or [0][0] syntax)
+                    glUniformMatrix4fv(view_mat_loc, 1, GL_FALSE, &view_matrix[0][0]);
+
+                    // render each box
+                    for (unsigned int i = 0; i < 10; i++)
+                    {
+                        // calculate the model matrix for each object and pass it to shader before drawing
+                        glm::mat4 model_matrix = glm::translate(identity_matrix, cubePositions[i]);
+                        float angle = 20.0f * i;
+                        model_matrix = glm::rotate(model_matrix, glm::radians(angle), glm::vec3(1.0f, 0.3f, 0.5f));
+
+                        GLuint model_mat_loc = glGetUniformLocation(shader_programme, "model_matrix");
+                        glUniformMatrix4fv(model_mat_loc, 1, GL_FALSE, glm::value_ptr(model_matrix));
+                        meshes.Draw(cube);
+                    }
+
+                    /* Swap front and back buffers */
+                    /* update other events like input handling */
+                    glfwSwapBuffers(window);
+
+                    /* Poll for and process events */
+                    /* put the stuff we've been drawing onto the display */
+                    glfwPollEvents();
+                }
+
+                glDeleteProgram(shader_programme);
+            }
+
+            glfwTerminate();
+            return 0;
+        }
+
+        int WalkAroundMultipleCubesWithUserInput()
+        {
+            // Initialize the glfw & glew
+            GLFWwindow* window = Utility::GLFW::start_glfw();
+            Utility::GLEW::start_glew();
+
+            // Some openGL settings
+            // tell GL to only draw onto a pixel if the shape is closer to the viewer
+            glEnable(GL_DEPTH_TEST); // enable depth-testing
+            //glDepthFunc(GL_LESS);		 // depth-testing interprets a smaller value as "closer"
 
             // ====================
-            //      SHADERS
+            // VBO - VAO GENERATION
             // ====================
-            // 8. Define the sources for the vertex and fragment shader
-            const char* vertex_shader_source_str =
-                "#version 330 core\n"
-                "layout (location = 0) in vec3 vertex_position;\n"
-                "layout (location = 1) in vec2 vertex_texture_position;\n"
-                "out vec2 textureCoord;\n"
-                "uniform mat4 model_matrix;\n"
-                "uniform mat4 view_matrix;\n"
-                "uniform mat4 projection_matrix;\n"
-                "void main()\n"
-                "{\n"
-                "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
-                "   textureCoord = vec2(vertex_texture_position.x, vertex_texture_position.y);\n"
-                "}\0";
 
-            // 9. Fragment shader setup
-            const char* fragment_shader_source_str =
-                "#version 330 core\n"
-                "in vec2 textureCoord;\n"
-                "out vec4 frag_color;\n"
-                "uniform sampler2D texture1;\n" // texture sampler
-                "uniform sampler2D texture2;\n"
-                "void main()\n"
-                "{\n"
-                "   frag_color = mix(texture(texture1, textureCoord), texture(texture2, textureCoord), 0.2);\n"
-                "}\0";
+            // world space positions of our cubes
+            glm::vec3 cubePositions[] = {
+                glm::vec3(0.0f,  0.0f,  0.0f),
+                glm::vec3(2.0f,  5.0f, -15.0f),
+                glm::vec3(-1.5f, -2.2f, -2.5f),
+                glm::vec3(-3.8f, -2.0f, -12.3f),
+                glm::vec3(2.4f, -0.4f, -3.5f),
+                glm::vec3(-1.7f,  3.0f, -7.5f),
+                glm::vec3(1.3f, -2.0f, -2.5f),
+                glm::vec3(1.5f,  2.0f, -2.5f),
+                glm::vec3(1.5f,  0.2f, -1.5f),
+                glm::vec3(-1.3f,  1.0f, -1.5f)
+            };
+
 
-            // 10-a. Create the vertex shader
-            GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
+            {
+                // Positions and texture coordinates of the cube come from the mesh library
+                Utility::mesh::MeshLibrary meshes;
+                Utility::mesh::MeshHandle cube = meshes.Get(Utility::mesh::Primitive::Cube, Utility::mesh::Position | Utility::mesh::TexCoord);
 
-            // 10-b. Attach the source string to the shader & compile
-            const GLchar* vertex_shader_source = (const GLchar*)vertex_shader_source_str;
-            glShaderSource(vertex_shader, 1, &vertex_shader_source, NULL);
-            glCompileShader(vertex_shader);
+                // ====================
+                //    TEXTURE SETUP
+                // ====================
 
-            // 10-c. Check for the errors
-            int success = -1;
-            glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &success);
-            if (GL_TRUE != success)
-            {
-                char infoLog[512];
-                glGetShaderInfoLog(vertex_shader, 512, NULL, infoLog);
-                std::cerr << "Shader can not compile: " << infoLog << "\n";
-                return -1; // or exit or something
-            }
+                // texture 1
+                // ---------
 
-            // 10-d REpeat steps 10-a, b and c for the fragment shader
-            GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
-            const GLchar* fragment_shader_source = (const GLchar*)fragment_shader_source_str;
-            glShaderSource(fragment_shader, 1, &fragment_shader_source, NULL);
-            glCompileShader(fragment_shader);
-            // error check
-            success = -1;
-            glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &success);
-            if (GL_TRUE != success)
-            {
-                char infoLog[512];
-                glGetShaderInfoLog(fragment_shader, 512, NULL, infoLog);
-                std::cerr << "Shader can not compile: " << infoLog << "\n";
-                return -1; // or exit or something
-            }
+                // 1. Load the corresponding image
+                std::string image_file_path("resources\\container.jpg");
+                bool is_png = image_file_path.find(".png") != std::string::npos;
 
-            // 10-e. Create the program to attach defined shaders
-            GLuint shader_programme = glCreateProgram();
+                int width, height, nrChannels;
+                unsigned char* data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
+                if (!data)
+                    std::cerr << "Failed to load texture image!!!" << std::endl;
 
-            // 10-f. Attach & link the shaders to the program
-            glAttachShader(shader_programme, vertex_shader);
-            glAttachShader(shader_programme, fragment_shader);
-            glLinkProgram(shader_programme);
+                // 2. Generate the texture object like any other OpenGL object
+                GLuint texture_obj;
+                glGenTextures(1, &texture_obj);
 
-            // 10-g. Check against the linking errors
-            success = -1;
-            glGetProgramiv(shader_programme, GL_LINK_STATUS, &success);
-            if (GL_TRUE != success)
-            {
-                char infoLog[512];
-                glGetProgramInfoLog(shader_programme, 512, NULL, infoLog);
-                std::cerr << "ERROR: Shader programme linking failed: " << infoLog << std::endl;
-                return -1;
-            }
+                // 3. Bind it to a specific target. It is GL_TEXTURE_2D here.
+                // RULE: texture_obj should and can NOT be bound to any other target after this point
+                glBindTexture(GL_TEXTURE_2D, texture_obj);
+                // all upcoming GL_TEXTURE_2D operations now have effect on this texture object
+
+                // 4. Set the sampling parameters
+                // Wrapping (edge value sampling)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+                // Filtering
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+                // 5. Get the storage for the texture
+                // Mutable storage in this case
+                if (is_png)
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+                else
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
 
-            // ====================
-            //  TEXTURE UNIT SETUP
-            // ====================
-            // Has to be done once
+                // 6. Storage contents can now be altered after this point.
+                // It is often a good practice to generate a mipmap
+                glGenerateMipmap(GL_TEXTURE_2D);
 
-            // Since we make a modification on the shader, call glUseProgram for the shader programme
-            glUseProgram(shader_programme);
+                // 7. You can now free the loaded image data.
+                stbi_image_free(data);
 
-            // Tell the shader what shader belongs to which texture object
-            // get the location of the sampler variable named "texture1" and 
-            // set the value of that sampler to the corresponding value of the texture image unit
-            glUniform1i(glGetUniformLocation(shader_programme, "texture1"), 0);
-            glUniform1i(glGetUniformLocation(shader_programme, "texture2"), 1);
+                // texture 2
+                // ---------
+                // Repeat steps 1-7 for the second texture
 
-            // NOTE: Make sure you activate the correct texture image unit for the related texture.
+                image_file_path = "resources\\awesomeface.png";
+                is_png = image_file_path.find(".png") != std::string::npos;
+                stbi_set_flip_vertically_on_load(true); // tell stb_image.h to flip loaded texture's on the y-axis.
+                data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
+                if (!data)
+                    std::cerr << "Failed to load texture image!!!" << std::endl;
 
+                // Texture object
+                GLuint texture_obj2;
+                glGenTextures(1, &texture_obj2);
+                glBindTexture(GL_TEXTURE_2D, texture_obj2);
 
-            // ====================
-            //  TRANSFORMATION SETUP
-            // ====================
-            glm::mat4 identity_matrix = glm::mat4(1.0f);
-            glm::mat4 projection_matrix = glm::perspective(glm::radians(45.0f), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+                // Sampling parameters
+                // wrapping parameters
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+                // texture filtering parameters
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+                // Storage
+                if (is_png)
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+                else
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
 
-            // we need to pass this info to the shader so call use
-            glUseProgram(shader_programme);
+                // Mipmap setup
+                glGenerateMipmap(GL_TEXTURE_2D);
 
-            // Get the locations in the shaders                
-            GLuint projection_mat_loc = glGetUniformLocation(shader_programme, "projection_matrix");
-            // Set the data for them (two different ways: pointer or [0][0] syntax)
-            glUniformMatrix4fv(projection_mat_loc, 1, GL_FALSE, glm::value_ptr(projection_matrix));
+                // free raw data
+                stbi_image_free(data);
+
+                // ====================
+                //      SHADERS
+                // ====================
+                // 8. Define the sources for the vertex and fragment shader
+                const char* vertex_shader_source_str =
+                    "#version 330 core\n"
+                    "layout (location = 0) in vec3 vertex_position;\n"
+                    "layout (location = 1) in vec2 vertex_texture_position;\n"
+                    "out vec2 textureCoord;\n"
+                    "uniform mat4 model_matrix;\n"
+                    "uniform mat4 view_matrix;\n"
+                    "uniform mat4 projection_matrix;\n"
+                    "void main()\n"
+                    "{\n"
+                    "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
+                    "   textureCoord = vec2(vertex_texture_position.x, vertex_texture_position.y);\n"
+                    "}\0";
+
+                // 9. Fragment shader setup
+                const char* fragment_shader_source_str =
+                    "#version 330 core\n"
+                    "in vec2 textureCoord;\n"
+                    "out vec4 frag_color;\n"
+                    "uniform sampler2D texture1;\n" // texture sampler
+                    "uniform sampler2D texture2;\n"
+                    "void main()\n"
+                    "{\n"
+                    "   frag_color = mix(texture(texture1, textureCoord), texture(texture2, textureCoord), 0.2);\n"
+                    "}\0";
+
+                // 10-a. Create the vertex shader
+                GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
+
+                // 10-b. Attach the source string to the shader & compile
+                const GLchar* vertex_shader_source = (const GLchar*)vertex_shader_source_str;
+                glShaderSource(vertex_shader, 1, &vertex_shader_source, NULL);
+                glCompileShader(vertex_shader);
+
+                // 10-c. Check for the errors
+                int success = -1;
+                glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &success);
+                if (GL_TRUE != success)
+                {
+                    char infoLog[512];
+                    glGetShaderInfoLog(vertex_shader, 512, NULL, infoLog);
+                    std::cerr << "Shader can not compile: " << infoLog << "\n";
+                    return -1; // or exit or something
+                }
 
-            // Camera setup
-            glm::vec3 cameraPos = glm::vec3(0.0f, 0.0f, 3.0f);
-            glm::vec3 cameraFront = glm::vec3(0.0f, 0.0f, -1.0f);
-            glm::vec3 cameraUp = glm::vec3(0.0f, 1.0f, 0.0f);
+                // 10-d REpeat steps 10-a, b and c for the fragment shader
+                GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
+                const GLchar* fragment_shader_source = (const GLchar*)fragment_shader_source_str;
+                glShaderSource(fragment_shader, 1, &fragment_shader_source, NULL);
+                glCompileShader(fragment_shader);
+                // error check
+                success = -1;
+                glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &success);
+                if (GL_TRUE != success)
+                {
+                    char infoLog[512];
+                    glGetShaderInfoLog(fragment_shader, 512, NULL, infoLog);
+                    std::cerr << "Shader can not compile: " << infoLog << "\n";
+                    return -1; // or exit or something
+                }
 
-            float deltaTime = 0.0f;	// time between current frame and last frame
-            float lastFrame = 0.0f; // time of last frame
+                // 10-e. Create the program to attach defined shaders
+                GLuint shader_programme = glCreateProgram();
 
-            // 10-h. Deleting shader at this point does not hurt
-            glDeleteShader(vertex_shader);
-            glDeleteShader(fragment_shader);
+                // 10-f. Attach & link the shaders to the program
+                glAttachShader(shader_programme, vertex_shader);
+                glAttachShader(shader_programme, fragment_shader);
+                glLinkProgram(shader_programme);
 
-            // Lambda for processing input
-            auto processInput = [&](GLFWwindow* window)
-            {
-                if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-                    glfwSetWindowShouldClose(window, true);
+                // 10-g. Check against the linking errors
+                success = -1;
+                glGetProgramiv(shader_programme, GL_LINK_STATUS, &success);
+                if (GL_TRUE != success)
+                {
+                    char infoLog[512];
+                    glGetProgramInfoLog(shader_programme, 512, NULL, infoLog);
+                    std::cerr << "ERROR: Shader programme linking failed: " << infoLog << std::endl;
+                    return -1;
+                }
 
-                float cameraSpeed = 2.5 * deltaTime;
-                if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-                    cameraPos += cameraSpeed * cameraFront;
-                if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-                    cameraPos -= cameraSpeed * cameraFront;
-                if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-                    cameraPos -= glm::normalize(glm::cross(cameraFront, cameraUp)) * cameraSpeed;
-                if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-                    cameraPos += glm::normalize(glm::cross(cameraFront, cameraUp)) * cameraSpeed;
-            };
+                // ====================
+                //  TEXTURE UNIT SETUP
+                // ====================
+                // Has to be done once
 
-            // ====================
-            //      MAIN UI LOOP
-            // ====================
-            /* Loop until the user closes the window */
-            while (!glfwWindowShouldClose(window))
-            {
-                // fps counter
-                Utility::GLFW::update_fps_counter(window);
+                // Since we make a modification on the shader, call glUseProgram for the shader programme
+                glUseProgram(shader_programme);
 
-                // per-frame time logic
-                // --------------------
-                float currentFrame = glfwGetTime();
-                deltaTime = currentFrame - lastFrame;
-                lastFrame = currentFrame;
+                // Tell the shader what shader belongs to which texture object
+                // get the location of the sampler variable named "texture1" and 
+                // set the value of that sampler to the corresponding value of the texture image unit
+                glUniform1i(glGetUniformLocation(shader_programme, "texture1"), 0);
+                glUniform1i(glGetUniformLocation(shader_programme, "texture2"), 1);
 
-                // input
-                // -----
-                processInput(window);
+                // NOTE: Make sure you activate the correct texture image unit for the related texture.
 
-                /* Render here */
-                glClearColor(0.2f, 0.3f, 0.3f, 1.0f);// scene background color
-                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-                // Activate the texture image units and bind the associated textures
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, texture_obj);
-                glActiveTexture(GL_TEXTURE1);
-                glBindTexture(GL_TEXTURE_2D, texture_obj2);
+                // ====================
+                //  TRANSFORMATION SETUP
+                // ====================
+                glm::mat4 identity_matrix = glm::mat4(1.0f);
+                glm::mat4 projection_matrix = glm::perspective(glm::radians(45.0f), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
 
-                // Activate the shader programme
+                // we need to pass this info to the shader so call use
                 glUseProgram(shader_programme);
 
-                // camera/view transformation
-                glm::mat4 view_matrix = glm::lookAt(cameraPos, cameraPos + cameraFront, cameraUp);
                 // Get the locations in the shaders                
-                GLuint view_mat_loc = glGetUniformLocation(shader_programme, "view_matrix");
+                GLuint projection_mat_loc = glGetUniformLocation(shader_programme, "projection_matrix");
                 // Set the data for them (two different ways: pointer or [0][0] syntax)
-                glUniformMatrix4fv(view_mat_loc, 1, GL_FALSE, &view_matrix[0][0]);
+                glUniformMatrix4fv(projection_mat_loc, 1, GL_FALSE, glm::value_ptr(projection_matrix));
 
-                // render each box
-                glBindVertexArray(vao);
-                for (unsigned int i = 0; i < 10; i++)
+                // Camera setup
+                glm::vec3 cameraPos = glm::vec3(0.0f, 0.0f, 3.0f);
+                glm::vec3 cameraFront = glm::vec3(0.0f, 0.0f, -1.0f);
+                glm::vec3 cameraUp = glm::vec3(0.0f, 1.0f, 0.0f);
+
+                float deltaTime = 0.0f;	// time between current frame and last frame
+                float lastFrame = 0.0f; // time of last frame
+
+                // 10-h. Deleting shader at this point does not hurt
+                glDeleteShader(vertex_shader);
+                glDeleteShader(fragment_shader);
+
+                // Lambda for processing input
+                auto processInput = [&](GLFWwindow* window)
                 {
-                    // calculate the model matrix for each object and pass it to shader before drawing
-                    glm::mat4 model_matrix = glm::translate(identity_matrix, cubePositions[i]);
-                    float angle = 20.0f * i;
-                    model_matrix = glm::rotate(model_matrix, glm::radians(angle), glm::vec3(1.0f, 0.3f, 0.5f));
+                    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+                        glfwSetWindowShouldClose(window, true);
 
-                    GLuint model_mat_loc = glGetUniformLocation(shader_programme, "model_matrix");
-                    glUniformMatrix4fv(model_mat_loc, 1, GL_FALSE, glm::value_ptr(model_matrix));
-                    glDrawArrays(GL_TRIANGLES, 0, 36);
-                }
+                    float cameraSpeed = 2.5 * deltaTime;
+                    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
+                        cameraPos += cameraSpeed * cameraFront;
+                    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
+                        cameraPos -= cameraSpeed * cameraFront;
+                    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
+                        cameraPos -= glm::normalize(glm::cross(cameraFront, cameraUp)) * cameraSpeed;
+                    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
+                        cameraPos += glm::normalize(glm::cross(cameraFront, cameraUp)) * cameraSpeed;
+                };
+
+                // ====================
+                //      MAIN UI LOOP
+                // ====================
+                /* Loop until the user closes the window */
+                while (!glfwWindowShouldClose(window))
+                {
+                    // fps counter
+                    Utility::GLFW::update_fps_counter(window);
 
-                /* Swap front and back buffers */
-                /* update other events like input handling */
-                glfwSwapBuffers(window);
+                    // per-frame time logic
+                    // --------------------
+                    float currentFrame = glfwGetTime();
+                    deltaTime = currentFrame - lastFrame;
+                    lastFrame = currentFrame;
 
-                /* Poll for and process events */
-                /* put the stuff we've been drawing onto the display */
-                glfwPollEvents();
-            }
+                    // input
+                    // -----
+                    processInput(window);
 
-            glDeleteVertexArrays(1, &vao);
-            glDeleteBuffers(1, &vbo);
-            glDeleteProgram(shader_programme);
+                    /* Render here */
+                    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);// scene background color
+                    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+                    // Activate the texture image units and bind the associated textures
+                    glActiveTexture(GL_TEXTURE0);
+                    glBindTexture(GL_TEXTURE_2D, texture_obj);
+                    glActiveTexture(GL_TEXTURE1);
+                    glBindTexture(GL_TEXTURE_2D, texture_obj2);
+
+                    // Activate the shader programme
+                    glUseProgram(shader_programme);
+
+                    // camera/view transformation
+                    glm::mat4 view_matrix = glm::lookAt(cameraPos, cameraPos + cameraFront, cameraUp);
+                    // Get the locations in the shaders                
+                    GLuint view_mat_loc = glGetUniformLocation(shader_programme, "view_matrix");
+                    // Set the data for them (two different ways: pointer or [0][0] syntax)
+                    glUniformMatrix4fv(view_mat_loc, 1, GL_FALSE, &view_matrix[0][0]);
+
+                    // render each box
+                    for (unsigned int i = 0; i < 10; i++)
+                    {
+                        // calculate the model matrix for each object and pass it to shader before drawing
+                        glm::mat4 model_matrix = glm::translate(identity_matrix, cubePositions[i]);
+                        float angle = 20.0f * i;
+                        model_matrix = glm::rotate(model_matrix, glm::radians(angle), glm::vec3(1.0f, 0.3f, 0.5f));
+
+                        GLuint model_mat_loc = glGetUniformLocation(shader_programme, "model_matrix");
+                        glUniformMatrix4fv(model_mat_loc, 1, GL_FALSE, glm::value_ptr(model_matrix));
+                        meshes.Draw(cube);
+                    }
+
+                    /* Swap front and back buffers */
+                    /* update other events like input handling */
+                    glfwSwapBuffers(window);
+
+                    /* Poll for and process events */
+                    /* put the stuff we've been drawing onto the display */
+                    glfwPollEvents();
+                }
+
+                glDeleteProgram(shader_programme);
+            }
 
             glfwTerminate();
             return 0;
@@ -4642,405 +4319,340 @@ namespace tutorials
         {
             fov -= (float)yoffset;
             if (fov < 1.0f)
-                fov = 1.0f;
-            if (fov > 45.0f)
-                fov = 45.0f;
-        }
-
-        int WalkAroundWithKeyboardLookAroundWithMouse()
-        {
-            // Initialize the glfw & glew
-            GLFWwindow* window = Utility::GLFW::start_glfw();
-            glfwSetCursorPosCallback(window, mouse_callback); // required for mouse
-            // tell GLFW to capture our mouse
-            glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-            glfwSetScrollCallback(window, scroll_callback);
-
-            Utility::GLEW::start_glew();
-
-            // Some openGL settings
-            // tell GL to only draw onto a pixel if the shape is closer to the viewer
-            glEnable(GL_DEPTH_TEST); // enable depth-testing
-            //glDepthFunc(GL_LESS);		 // depth-testing interprets a smaller value as "closer"
-
-            // ====================
-            // VBO - VAO GENERATION
-            // ====================
-            // 1. Vertex data for positions, colors and texture coordinates
-            GLfloat vertices[] = {
-                // coords             // texture
-                -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
-                 0.5f, -0.5f, -0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
-
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
-                -0.5f,  0.5f,  0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-
-                -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                -0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                -0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f, -0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
-                -0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
-                -0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
-
-                -0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
-                 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
-                -0.5f,  0.5f,  0.5f,  0.0f, 0.0f,
-                -0.5f,  0.5f, -0.5f,  0.0f, 1.0f
-            };
-
-            // world space positions of our cubes
-            glm::vec3 cubePositions[] = {
-                glm::vec3(0.0f,  0.0f,  0.0f),
-                glm::vec3(2.0f,  5.0f, -15.0f),
-                glm::vec3(-1.5f, -2.2f, -2.5f),
-                glm::vec3(-3.8f, -2.0f, -12.3f),
-                glm::vec3(2.4f, -0.4f, -3.5f),
-                glm::vec3(-1.7f,  3.0f, -7.5f),
-                glm::vec3(1.3f, -2.0f, -2.5f),
-                glm::vec3(1.5f,  2.0f, -2.5f),
-                glm::vec3(1.5f,  0.2f, -1.5f),
-                glm::vec3(-1.3f,  1.0f, -1.5f)
-            };
-
-
-            // Generate tightly-packed VBO and then the Indexed VBO
-            // 2,3 & 4
-            GLuint vbo;
-            glGenBuffers(1, &vbo);
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
-            glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-            // 5. Generate and bind VAO
-            GLuint vao;
-            glGenVertexArrays(1, &vao);
-            glBindVertexArray(vao);
-
-            // 6. Define and associate the vertex attributes to the vbo
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
-            //positions
-            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid*)0);
-            glEnableVertexAttribArray(0);
-            //textures
-            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
-            glEnableVertexAttribArray(1);
-
-            glBindBuffer(GL_ARRAY_BUFFER, 0); // not required
-
-            // ====================
-            //    TEXTURE SETUP
-            // ====================
-
-            // texture 1
-            // ---------
-
-            // 1. Load the corresponding image
-            std::string image_file_path("resources\\container.jpg");
-            bool is_png = image_file_path.find(".png") != std::string::npos;
-
-            int width, height, nrChannels;
-            unsigned char* data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
-            if (!data)
-                std::cerr << "Failed to load texture image!!!" << std::endl;
-
-            // 2. Generate the texture object like any other OpenGL object
-            GLuint texture_obj;
-            glGenTextures(1, &texture_obj);
+                fov = 1.0f;
+            if (fov > 45.0f)
+                fov = 45.0f;
+        }
 
-            // 3. Bind it to a specific target. It is GL_TEXTURE_2D here.
-            // RULE: texture_obj should and can NOT be bound to any other target after this point
-            glBindTexture(GL_TEXTURE_2D, texture_obj);
-            // all upcoming GL_TEXTURE_2D operations now have effect on this texture object
+        int WalkAroundWithKeyboardLookAroundWithMouse()
+        {
+            // Initialize the glfw & glew
+            GLFWwindow* window = Utility::GLFW::start_glfw();
+            glfwSetCursorPosCallback(window, mouse_callback); // required for mouse
+            // tell GLFW to capture our mouse
+            glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+            glfwSetScrollCallback(window, scroll_callback);
 
-            // 4. Set the sampling parameters
-            // Wrapping (edge value sampling)
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            // Filtering
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            Utility::GLEW::start_glew();
 
-            // 5. Get the storage for the texture
-            // Mutable storage in this case
-            if (is_png)
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-            else
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+            // Some openGL settings
+            // tell GL to only draw onto a pixel if the shape is closer to the viewer
+            glEnable(GL_DEPTH_TEST); // enable depth-testing
+            //glDepthFunc(GL_LESS);		 // depth-testing interprets a smaller value as "closer"
 
-            // 6. Storage contents can now be altered after this point.
-            // It is often a good practice to generate a mipmap
-            glGenerateMipmap(GL_TEXTURE_2D);
+            // ====================
+            // VBO - VAO GENERATION
+            // ====================
 
-            // 7. You can now free the loaded image data.
-            stbi_image_free(data);
+            // world space positions of our cubes
+            glm::vec3 cubePositions[] = {
+                glm::vec3(0.0f,  0.0f,  0.0f),
+                glm::vec3(2.0f,  5.0f, -15.0f),
+                glm::vec3(-1.5f, -2.2f, -2.5f),
+                glm::vec3(-3.8f, -2.0f, -12.3f),
+                glm::vec3(2.4f, -0.4f, -3.5f),
+                glm::vec3(-1.7f,  3.0f, -7.5f),
+                glm::vec3(1.3f, -2.0f, -2.5f),
+                glm::vec3(1.5f,  2.0f, -2.5f),
+                glm::vec3(1.5f,  0.2f, -1.5f),
+                glm::vec3(-1.3f,  1.0f, -1.5f)
+            };
 
-            // texture 2
-            // ---------
-            // Repeat steps 1-7 for the second texture
 
-            image_file_path = "resources\\awesomeface.png";
-            is_png = image_file_path.find(".png") != std::string::npos;
-            stbi_set_flip_vertically_on_load(true); // tell stb_image.h to flip loaded texture's on the y-axis.
-            data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
-            if (!data)
-                std::cerr << "Failed to load texture image!!!" << std::endl;
+            {
+                // Positions and texture coordinates of the cube come from the mesh library
+                Utility::mesh::MeshLibrary meshes;
+                Utility::mesh::MeshHandle cube = meshes.Get(Utility::mesh::Primitive::Cube, Utility::mesh::Position | Utility::mesh::TexCoord);
 
-            // Texture object
-            GLuint texture_obj2;
-            glGenTextures(1, &texture_obj2);
-            glBindTexture(GL_TEXTURE_2D, texture_obj2);
+                // ====================
+                //    TEXTURE SETUP
+                // ====================
 
-            // Sampling parameters
-            // wrapping parameters
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            // texture filtering parameters
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+                // texture 1
+                // ---------
 
-            // Storage
-            if (is_png)
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-            else
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+                // 1. Load the corresponding image
+                std::string image_file_path("resources\\container.jpg");
+                bool is_png = image_file_path.find(".png") != std::string::npos;
 
-            // Mipmap setup
-            glGenerateMipmap(GL_TEXTURE_2D);
+                int width, height, nrChannels;
+                unsigned char* data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
+                if (!data)
+                    std::cerr << "Failed to load texture image!!!" << std::endl;
 
-            // free raw data
-            stbi_image_free(data);
+                // 2. Generate the texture object like any other OpenGL object
+                GLuint texture_obj;
+                glGenTextures(1, &texture_obj);
 
-            // ====================
-            //      SHADERS
-            // ====================
-            // 8. Define the sources for the vertex and fragment shader
-            const char* vertex_shader_source_str =
-                "#version 330 core\n"
-                "layout (location = 0) in vec3 vertex_position;\n"
-                "layout (location = 1) in vec2 vertex_texture_position;\n"
-                "out vec2 textureCoord;\n"
-                "uniform mat4 model_matrix;\n"
-                "uniform mat4 view_matrix;\n"
-                "uniform mat4 projection_matrix;\n"
-                "void main()\n"
-                "{\n"
-                "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
-                "   textureCoord = vec2(vertex_texture_position.x, vertex_texture_position.y);\n"
-                "}\0";
+                // 3. Bind it to a specific target. It is GL_TEXTURE_2D here.
+                // RULE: texture_obj should and can NOT be bound to any other target after this point
+                glBindTexture(GL_TEXTURE_2D, texture_obj);
+                // all upcoming GL_TEXTURE_2D operations now have effect on this texture object
+
+                // 4. Set the sampling parameters
+                // Wrapping (edge value sampling)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+                // Filtering
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+                // 5. Get the storage for the texture
+                // Mutable storage in this case
+                if (is_png)
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+                else
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
 
-            // 9. Fragment shader setup
-            const char* fragment_shader_source_str =
-                "#version 330 core\n"
-                "in vec2 textureCoord;\n"
-                "out vec4 frag_color;\n"
-                "uniform sampler2D texture1;\n" // texture sampler
-                "uniform sampler2D texture2;\n"
-                "void main()\n"
-                "{\n"
-                "   frag_color = mix(texture(texture1, textureCoord), texture(texture2, textureCoord), 0.2);\n"
-                "}\0";
+                // 6. Storage contents can now be altered after this point.
+                // It is often a good practice to generate a mipmap
+                glGenerateMipmap(GL_TEXTURE_2D);
 
-            // 10-a. Create the vertex shader
-            GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
+                // 7. You can now free the loaded image data.
+                stbi_image_free(data);
 
-            // 10-b. Attach the source string to the shader & compile
-            const GLchar* vertex_shader_source = (const GLchar*)vertex_shader_source_str;
-            glShaderSource(vertex_shader, 1, &vertex_shader_source, NULL);
-            glCompileShader(vertex_shader);
+                // texture 2
+                // ---------
+                // Repeat steps 1-7 for the second texture
 
-            // 10-c. Check for the errors
-            int success = -1;
-            glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &success);
-            if (GL_TRUE != success)
-            {
-                char infoLog[512];
-                glGetShaderInfoLog(vertex_shader, 512, NULL, infoLog);
-                std::cerr << "Shader can not compile: " << infoLog << "\n";
-                return -1; // or exit or something
-            }
+                image_file_path = "resources\\awesomeface.png";
+                is_png = image_file_path.find(".png") != std::string::npos;
+                stbi_set_flip_vertically_on_load(true); // tell stb_image.h to flip loaded texture's on the y-axis.
+                data = stbi_load(image_file_path.c_str(), &width, &height, &nrChannels, 0);
+                if (!data)
+                    std::cerr << "Failed to load texture image!!!" << std::endl;
 
-            // 10-d REpeat steps 10-a, b and c for the fragment shader
-            GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
-            const GLchar* fragment_shader_source = (const GLchar*)fragment_shader_source_str;
-            glShaderSource(fragment_shader, 1, &fragment_shader_source, NULL);
-            glCompileShader(fragment_shader);
-            // error check
-            success = -1;
-            glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &success);
-            if (GL_TRUE != success)
-            {
-                char infoLog[512];
-                glGetShaderInfoLog(fragment_shader, 512, NULL, infoLog);
-                std::cerr << "Shader can not compile: " << infoLog << "\n";
-                return -1; // or exit or something
-            }
+                // Texture object
+                GLuint texture_obj2;
+                glGenTextures(1, &texture_obj2);
+                glBindTexture(GL_TEXTURE_2D, texture_obj2);
 
-            // 10-e. Create the program to attach defined shaders
-            GLuint shader_programme = glCreateProgram();
+                // Sampling parameters
+                // wrapping parameters
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	// set texture wrapping to GL_REPEAT (default wrapping method)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+                // texture filtering parameters
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+                // Storage
+                if (is_png)
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+                else
+                    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
 
-            // 10-f. Attach & link the shaders to the program
-            glAttachShader(shader_programme, vertex_shader);
-            glAttachShader(shader_programme, fragment_shader);
-            glLinkProgram(shader_programme);
+                // Mipmap setup
+                glGenerateMipmap(GL_TEXTURE_2D);
 
-            // 10-g. Check against the linking errors
-            success = -1;
-            glGetProgramiv(shader_programme, GL_LINK_STATUS, &success);
-            if (GL_TRUE != success)
-            {
-                char infoLog[512];
-                glGetProgramInfoLog(shader_programme, 512, NULL, infoLog);
-                std::cerr << "ERROR: Shader programme linking failed: " << infoLog << std::endl;
-                return -1;
-            }
+                // free raw data
+                stbi_image_free(data);
+
+                // ====================
+                //      SHADERS
+                // ====================
+                // 8. Define the sources for the vertex and fragment shader
+                const char* vertex_shader_source_str =
+                    "#version 330 core\n"
+                    "layout (location = 0) in vec3 vertex_position;\n"
+                    "layout (location = 1) in vec2 vertex_texture_position;\n"
+                    "out vec2 textureCoord;\n"
+                    "uniform mat4 model_matrix;\n"
+                    "uniform mat4 view_matrix;\n"
+                    "uniform mat4 projection_matrix;\n"
+                    "void main()\n"
+                    "{\n"
+                    "   gl_Position = projection_matrix * view_matrix * model_matrix * vec4(vertex_position, 1.0);\n"
+                    "   textureCoord = vec2(vertex_texture_position.x, vertex_texture_position.y);\n"
+                    "}\0";
+
+                // 9. Fragment shader setup
+                const char* fragment_shader_source_str =
+                    "#version 330 core\n"
+                    "in vec2 textureCoord;\n"
+                    "out vec4 frag_color;\n"
+                    "uniform sampler2D texture1;\n" // texture sampler
+                    "uniform sampler2D texture2;\n"
+                    "void main()\n"
+                    "{\n"
+                    "   frag_color = mix(texture(texture1, textureCoord), texture(texture2, textureCoord), 0.2);\n"
+                    "}\0";
+
+                // 10-a. Create the vertex shader
+                GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
+
+                // 10-b. Attach the source string to the shader & compile
+                const GLchar* vertex_shader_source = (const GLchar*)vertex_shader_source_str;
+                glShaderSource(vertex_shader, 1, &vertex_shader_source, NULL);
+                glCompileShader(vertex_shader);
+
+                // 10-c. Check for the errors
+                int success = -1;
+                glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &success);
+                if (GL_TRUE != success)
+                {
+                    char infoLog[512];
+                    glGetShaderInfoLog(vertex_shader, 512, NULL, infoLog);
+                    std::cerr << "Shader can not compile: " << infoLog << "\n";
+                    return -1; // or exit or something
+                }
 
-            // ====================
-            //  TEXTURE UNIT SETUP
-            // ====================
-            // Has to be done once
+                // 10-d REpeat steps 10-a, b and c for the fragment shader
+                GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
+                const GLchar* fragment_shader_source = (const GLchar*)fragment_shader_source_str;
+                glShaderSource(fragment_shader, 1, &fragment_shader_source, NULL);
+                glCompileShader(fragment_shader);
+                // error check
+                success = -1;
+                glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &success);
+                if (GL_TRUE != success)
+                {
+                    char infoLog[512];
+                    glGetShaderInfoLog(fragment_shader, 512, NULL, infoLog);
+                    std::cerr << "Shader can not compile: " << infoLog << "\n";
+                    return -1; // or exit or something
+                }
 
-            // Since we make a modification on the shader, call glUseProgram for the shader programme
-            glUseProgram(shader_programme);
+                // 10-e. Create the program to attach defined shaders
+                GLuint shader_programme = glCreateProgram();
 
-            // Tell the shader what shader belongs to which texture object
-            // get the location of the sampler variable named "texture1" and 
-            // set the value of that sampler to the corresponding value of the texture image unit
-            glUniform1i(glGetUniformLocation(shader_programme, "texture1"), 0);
-            glUniform1i(glGetUniformLocation(shader_programme, "texture2"), 1);
+                // 10-f. Attach & link the shaders to the program
+                glAttachShader(shader_programme, vertex_shader);
+                glAttachShader(shader_programme, fragment_shader);
+                glLinkProgram(shader_programme);
 
-            // NOTE: Make sure you activate the correct texture image unit for the related texture.
+                // 10-g. Check against the linking errors
+                success = -1;
+                glGetProgramiv(shader_programme, GL_LINK_STATUS, &success);
+                if (GL_TRUE != success)
+                {
+                    char infoLog[512];
+                    glGetProgramInfoLog(shader_programme, 512, NULL, infoLog);
+                    std::cerr << "ERROR: Shader programme linking failed: " << infoLog << std::endl;
+                    return -1;
+                }
 
+                // ====================
+                //  TEXTURE UNIT SETUP
+                // ====================
+                // Has to be done once
 
-            // ====================
-            //  TRANSFORMATION SETUP
-            // ====================
-            glm::mat4 identity_matrix = glm::mat4(1.0f);            
+                // Since we make a modification on the shader, call glUseProgram for the shader programme
+                glUseProgram(shader_programme);
 
-            //  Walk around
-            // ====================
-            glm::vec3 cameraPos = glm::vec3(0.0f, 0.0f, 3.0f);
-            // cameraFront is moved up to be global variable to be used in mouse_callback
-            //glm::vec3 cameraFront = glm::vec3(0.0f, 0.0f, -1.0f);
-            glm::vec3 cameraUp = glm::vec3(0.0f, 1.0f, 0.0f);
+                // Tell the shader what shader belongs to which texture object
+                // get the location of the sampler variable named "texture1" and 
+                // set the value of that sampler to the corresponding value of the texture image unit
+                glUniform1i(glGetUniformLocation(shader_programme, "texture1"), 0);
+                glUniform1i(glGetUniformLocation(shader_programme, "texture2"), 1);
 
-            float deltaTime = 0.0f;	// time between current frame and last frame
-            float lastFrame = 0.0f; // time of last frame
+                // NOTE: Make sure you activate the correct texture image unit for the related texture.
 
-            // Lambda for processing input
-            auto processInput = [&](GLFWwindow* window)
-            {
-                if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-                    glfwSetWindowShouldClose(window, true);
 
-                float cameraSpeed = 2.5 * deltaTime;
-                if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-                    cameraPos += cameraSpeed * cameraFront;
-                if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-                    cameraPos -= cameraSpeed * cameraFront;
-                if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-                    cameraPos -= glm::normalize(glm::cross(cameraFront, cameraUp)) * cameraSpeed;
-                if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-                    cameraPos += glm::normalize(glm::cross(cameraFront, cameraUp)) * cameraSpeed;
-            };
+                // ====================
+                //  TRANSFORMATION SETUP
+                // ====================
+                glm::mat4 identity_matrix = glm::mat4(1.0f);            
 
-            // 10-h. Deleting shader at this point does not hurt
-            glDeleteShader(vertex_shader);
-            glDeleteShader(fragment_shader);           
+                //  Walk around
+                // ====================
+                glm::vec3 cameraPos = glm::vec3(0.0f, 0.0f, 3.0f);
+                // cameraFront is moved up to be global variable to be used in mouse_callback
+                //glm::vec3 cameraFront = glm::vec3(0.0f, 0.0f, -1.0f);
+                glm::vec3 cameraUp = glm::vec3(0.0f, 1.0f, 0.0f);
 
-            // ====================
-            //      MAIN UI LOOP
-            // ====================
-            /* Loop until the user closes the window */
-            while (!glfwWindowShouldClose(window))
-            {
-                // fps counter
-                Utility::GLFW::update_fps_counter(window);
+                float deltaTime = 0.0f;	// time between current frame and last frame
+                float lastFrame = 0.0f; // time of last frame
 
-                // per-frame time logic
-                // --------------------
-                float currentFrame = glfwGetTime();
-                deltaTime = currentFrame - lastFrame;
-                lastFrame = currentFrame;
+                // Lambda for processing input
+                auto processInput = [&](GLFWwindow* window)
+                {
+                    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+                        glfwSetWindowShouldClose(window, true);
 
-                // input
-                // -----
-                processInput(window);
+                    float cameraSpeed = 2.5 * deltaTime;
+                    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
+                        cameraPos += cameraSpeed * cameraFront;
+                    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
+                        cameraPos -= cameraSpeed * cameraFront;
+                    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
+                        cameraPos -= glm::normalize(glm::cross(cameraFront, cameraUp)) * cameraSpeed;
+                    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
+                        cameraPos += glm::normalize(glm::cross(cameraFront, cameraUp)) * cameraSpeed;
+                };
+
+                // 10-h. Deleting shader at this point does not hurt
+                glDeleteShader(vertex_shader);
+                glDeleteShader(fragment_shader);           
+
+                // ====================
+                //      MAIN UI LOOP
+                // ====================
+                /* Loop until the user closes the window */
+                while (!glfwWindowShouldClose(window))
+                {
+                    // fps counter
+                    Utility::GLFW::update_fps_counter(window);
 
-                /* Render here */
-                glClearColor(0.2f, 0.3f, 0.3f, 1.0f);// scene background color
-                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                    // per-frame time logic
+                    // --------------------
+                    float currentFrame = glfwGetTime();
+                    deltaTime = currentFrame - lastFrame;
+                    lastFrame = currentFrame;
 
-                // Activate the texture image units and bind the associated textures
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, texture_obj);
-                glActiveTexture(GL_TEXTURE1);
-                glBindTexture(GL_TEXTURE_2D, texture_obj2);
+                    // input
+                    // -----
+                    processInput(window);
 
-                // Activate the shader programme
-                glUseProgram(shader_programme);
-                // pass projection matrix to shader (note that in this case it could change every frame)
-                glm::mat4 projection_matrix = glm::perspective(glm::radians(fov), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
-                // we need to pass this info to the shader so call use               
-                GLuint projection_mat_loc = glGetUniformLocation(shader_programme, "projection_matrix");
-                glUniformMatrix4fv(projection_mat_loc, 1, GL_FALSE, glm::value_ptr(projection_matrix));
+                    /* Render here */
+                    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);// scene background color
+                    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-                // camera/view transformation
-                glm::mat4 view_matrix = glm::lookAt(cameraPos, cameraPos + cameraFront, cameraUp);
-                // Get the locations in the shaders                
-                GLuint view_mat_loc = glGetUniformLocation(shader_programme, "view_matrix");
-                // Set the data for them (two different ways: pointer or [0][0] syntax)
-                glUniformMatrix4fv(view_mat_loc, 1, GL_FALSE, &view_matrix[0][0]);
+                    // Activate the texture image units and bind the associated textures
+                    glActiveTexture(GL_TEXTURE0);
+                    glBindTexture(GL_TEXTURE_2D, texture_obj);
+                    glActiveTexture(GL_TEXTURE1);
+                    glBindTexture(GL_TEXTURE_2D, texture_obj2);
+
+                    // Activate the shader programme
+                    glUseProgram(shader_programme);
+                    // pass projection matrix to shader (note that in this case it could change every frame)
+                    glm::mat4 projection_matrix = glm::perspective(glm::radians(fov), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+                    // we need to pass this info to the shader so call use               
+                    GLuint projection_mat_loc = glGetUniformLocation(shader_programme, "projection_matrix");
+                    glUniformMatrix4fv(projection_mat_loc, 1, GL_FALSE, glm::value_ptr(projection_matrix));
+
+                    // camera/view transformation
+                    glm::mat4 view_matrix = glm::lookAt(cameraPos, cameraPos + cameraFront, cameraUp);
+                    // Get the locations in the shaders                
+                    GLuint view_mat_loc = glGetUniformLocation(shader_programme, "view_matrix");
+                    // Set the data for them (two different ways: pointer or [0][0] syntax)
+                    glUniformMatrix4fv(view_mat_loc, 1, GL_FALSE, &view_matrix[0][0]);
+
+                    // render each box
+                    for (unsigned int i = 0; i < 10; i++)
+                    {
+                        // calculate the model matrix for each object and pass it to shader before drawing
+                        glm::mat4 model_matrix = glm::translate(identity_matrix, cubePositions[i]);
+                        float angle = 20.0f * i;
+                        model_matrix = glm::rotate(model_matrix, glm::radians(angle), glm::vec3(1.0f, 0.3f, 0.5f));
+
+                        GLuint model_mat_loc = glGetUniformLocation(shader_programme, "model_matrix");
+                        glUniformMatrix4fv(model_mat_loc, 1, GL_FALSE, glm::value_ptr(model_matrix));
+                        meshes.Draw(cube);
+                    }
 
-                // render each box
-                glBindVertexArray(vao);
-                for (unsigned int i = 0; i < 10; i++)
-                {
-                    // calculate the model matrix for each object and pass it to shader before drawing
-                    glm::mat4 model_matrix = glm::translate(identity_matrix, cubePositions[i]);
-                    float angle = 20.0f * i;
-                    model_matrix = glm::rotate(model_matrix, glm::radians(angle), glm::vec3(1.0f, 0.3f, 0.5f));
+                    /* Swap front and back buffers */
+                    /* update other events like input handling */
+                    glfwSwapBuffers(window);
 
-                    GLuint model_mat_loc = glGetUniformLocation(shader_programme, "model_matrix");
-                    glUniformMatrix4fv(model_mat_loc, 1, GL_FALSE, glm::value_ptr(model_matrix));
-                    glDrawArrays(GL_TRIANGLES, 0, 36);
+                    /* Poll for and process events */
+                    /* put the stuff we've been drawing onto the display */
+                    glfwPollEvents();
                 }
 
-                /* Swap front and back buffers */
-                /* update other events like input handling */
-                glfwSwapBuffers(window);
-
-                /* Poll for and process events */
-                /* put the stuff we've been drawing onto the display */
-                glfwPollEvents();
+                glDeleteProgram(shader_programme);
             }
 
-            glDeleteVertexArrays(1, &vao);
-            glDeleteBuffers(1, &vbo);
-            glDeleteProgram(shader_programme);
-
             glfwTerminate();
             return 0;
         }       
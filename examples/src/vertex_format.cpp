@@ -0,0 +1,363 @@
+#include "vertex_format.h"
+#include "ShaderProgram.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Utility::mesh
+{
+    namespace
+    {
+        unsigned short quantize_unorm16(float value)
+        {
+            value = std::min(std::max(value, 0.0f), 1.0f);
+            return (unsigned short)std::lround(value * 65535.0f);
+        }
+
+        short quantize_snorm16(float value)
+        {
+            value = std::min(std::max(value, -1.0f), 1.0f);
+            return (short)std::lround(value * 32767.0f);
+        }
+
+        float decode_snorm16(short value)
+        {
+            return std::max(value / 32767.0f, -1.0f);
+        }
+
+        int quantize_snorm10(float value)
+        {
+            value = std::min(std::max(value, -1.0f), 1.0f);
+            return (int)std::lround(value * 511.0f);
+        }
+
+        float decode_snorm10(int value)
+        {
+            return std::max(value / 511.0f, -1.0f);
+        }
+
+        float sign_not_zero(float value)
+        {
+            return value >= 0.0f ? 1.0f : -1.0f;
+        }
+
+        float angle_degrees(glm::vec3 a, glm::vec3 b)
+        {
+            float cosine = std::min(std::max(glm::dot(a, b), -1.0f), 1.0f);
+            return std::acos(cosine) * 57.2957795f;
+        }
+    }
+
+    glm::vec2 oct_encode(glm::vec3 n)
+    {
+        n = n / (std::fabs(n.x) + std::fabs(n.y) + std::fabs(n.z));
+        if (n.z >= 0.0f)
+            return glm::vec2(n.x, n.y);
+        return glm::vec2((1.0f - std::fabs(n.y)) * sign_not_zero(n.x), (1.0f - std::fabs(n.x)) * sign_not_zero(n.y));
+    }
+
+    glm::vec3 oct_decode(glm::vec2 p)
+    {
+        glm::vec3 n(p.x, p.y, 1.0f - std::fabs(p.x) - std::fabs(p.y));
+        float t = std::max(-n.z, 0.0f);
+        n.x += n.x >= 0.0f ? -t : t;
+        n.y += n.y >= 0.0f ? -t : t;
+        return glm::normalize(n);
+    }
+
+    unsigned short float_to_half(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        uint32_t sign = (bits >> 16) & 0x8000;
+        uint32_t raw_exponent = (bits >> 23) & 0xFF;
+        int exponent = (int)raw_exponent - 127 + 15;
+        uint32_t mantissa = bits & 0x7FFFFF;
+
+        if (raw_exponent == 0xFF)
+            return (unsigned short)(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+        if (exponent >= 31)
+            return (unsigned short)(sign | 0x7C00);
+
+        if (exponent <= 0)
+        {
+            // subnormal half
+            if (exponent < -10)
+                return (unsigned short)sign;
+            mantissa |= 0x800000;
+            int shift = 14 - exponent;
+            uint32_t half = mantissa >> shift;
+            uint32_t rest = mantissa & ((1u << shift) - 1);
+            uint32_t halfway = 1u << (shift - 1);
+            if (rest > halfway || (rest == halfway && (half & 1)))
+                ++half;
+            return (unsigned short)(sign | half);
+        }
+
+        // round to nearest even, a carry correctly bumps the exponent
+        uint32_t half = sign | ((uint32_t)exponent << 10) | (mantissa >> 13);
+        uint32_t rest = mantissa & 0x1FFF;
+        if (rest > 0x1000 || (rest == 0x1000 && (half & 1)))
+            ++half;
+        return (unsigned short)half;
+    }
+
+    float half_to_float(unsigned short value)
+    {
+        uint32_t sign = (uint32_t)(value & 0x8000) << 16;
+        uint32_t exponent = (value >> 10) & 0x1F;
+        uint32_t mantissa = value & 0x3FF;
+
+        if (exponent == 0)
+        {
+            float magnitude = std::ldexp((float)mantissa, -24);
+            return sign ? -magnitude : magnitude;
+        }
+
+        uint32_t bits;
+        if (exponent == 31)
+            bits = sign | 0x7F800000 | (mantissa << 13);
+        else
+            bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    void PackedVertexFormat::Apply(size_t buffer_offset) const
+    {
+        for (const VertexAttributeLayout& attribute : layout)
+        {
+            glVertexAttribPointer(attribute.location, attribute.components, attribute.type, attribute.normalized,
+                stride, (GLvoid*)(buffer_offset + attribute.offset));
+            glEnableVertexAttribArray(attribute.location);
+        }
+    }
+
+    void PackedVertexFormat::ApplyFormat(GLuint binding) const
+    {
+        for (const VertexAttributeLayout& attribute : layout)
+        {
+            glVertexAttribFormat(attribute.location, attribute.components, attribute.type, attribute.normalized, attribute.offset);
+            glVertexAttribBinding(attribute.location, binding);
+            glEnableVertexAttribArray(attribute.location);
+        }
+    }
+
+    void PackedVertexFormat::SetDecodeUniforms(const ShaderProgram& shader) const
+    {
+        shader.setVec3("position_offset", position_offset);
+        shader.setVec3("position_scale", position_scale);
+    }
+
+    size_t PackedMesh::VertexCount() const
+    {
+        return format.stride ? vertices.size() / format.stride : 0;
+    }
+
+    std::ostream& operator<<(std::ostream& os, const QuantizationReport& report)
+    {
+        os << report.source_bytes << " -> " << report.packed_bytes << " vertex bytes";
+        if (report.source_bytes)
+            os << " (" << 100.0f * report.packed_bytes / report.source_bytes << "%)";
+        os << ", position error max " << report.max_position_error << " mean " << report.mean_position_error
+           << ", normal error max " << report.max_normal_error << " deg mean " << report.mean_normal_error << " deg"
+           << ", uv error max " << report.max_uv_error;
+        return os;
+    }
+
+    PackedMesh compile_vertex_format(const MeshData& mesh, const VertexFormatOptions& options, QuantizationReport* report)
+    {
+        PackedMesh packed;
+        PackedVertexFormat& format = packed.format;
+        format.attributes = mesh.attributes;
+        format.normals = (mesh.attributes & Normal) ? options.normals : NormalEncoding::Float3;
+
+        // ====================
+        //       LAYOUT
+        // ====================
+        GLuint location = 0;
+        GLuint offset = 0;
+        GLuint position_offset = 0, normal_offset = 0, uv_offset = 0;
+        if (mesh.attributes & Position)
+        {
+            position_offset = offset;
+            if (options.quantize_positions)
+            {
+                format.layout.push_back({ location++, 3, GL_UNSIGNED_SHORT, GL_TRUE, offset });
+                offset += 8; // 6 bytes padded to keep the next attribute 4 byte aligned
+            }
+            else
+            {
+                format.layout.push_back({ location++, 3, GL_FLOAT, GL_FALSE, offset });
+                offset += 12;
+            }
+        }
+        if (mesh.attributes & Normal)
+        {
+            normal_offset = offset;
+            switch (format.normals)
+            {
+            case NormalEncoding::Octahedral16:
+                format.layout.push_back({ location++, 2, GL_SHORT, GL_TRUE, offset });
+                offset += 4;
+                break;
+            case NormalEncoding::Packed1010102:
+                format.layout.push_back({ location++, 4, GL_INT_2_10_10_10_REV, GL_TRUE, offset });
+                offset += 4;
+                break;
+            case NormalEncoding::Float3:
+                format.layout.push_back({ location++, 3, GL_FLOAT, GL_FALSE, offset });
+                offset += 12;
+                break;
+            }
+        }
+        if (mesh.attributes & TexCoord)
+        {
+            uv_offset = offset;
+            if (options.half_uvs)
+            {
+                format.layout.push_back({ location++, 2, GL_HALF_FLOAT, GL_FALSE, offset });
+                offset += 4;
+            }
+            else
+            {
+                format.layout.push_back({ location++, 2, GL_FLOAT, GL_FALSE, offset });
+                offset += 8;
+            }
+        }
+        format.stride = offset;
+
+        // ====================
+        //       BOUNDS
+        // ====================
+        unsigned int stride = vertex_stride(mesh.attributes);
+        size_t vertex_count = mesh.VertexCount();
+        glm::vec3 min_bound(0.0f), max_bound(0.0f);
+        // The position leads the vertex when there is one; without it the bounds stay empty
+        for (size_t i = 0; (mesh.attributes & Position) && i < vertex_count; ++i)
+        {
+            glm::vec3 p(mesh.vertices[i * stride], mesh.vertices[i * stride + 1], mesh.vertices[i * stride + 2]);
+            min_bound = i == 0 ? p : glm::min(min_bound, p);
+            max_bound = i == 0 ? p : glm::max(max_bound, p);
+        }
+        if (options.quantize_positions)
+        {
+            format.position_offset = min_bound;
+            format.position_scale = max_bound - min_bound;
+        }
+
+        // ====================
+        //       ENCODE
+        // ====================
+        packed.indices = mesh.indices;
+        packed.vertices.assign(vertex_count * format.stride, 0);
+
+        QuantizationReport local;
+        size_t normal_samples = 0;
+
+        for (size_t i = 0; i < vertex_count; ++i)
+        {
+            const float* source = &mesh.vertices[i * stride];
+            unsigned char* target = &packed.vertices[i * format.stride];
+            const float* attribute = source;
+
+            if (mesh.attributes & Position)
+            {
+                glm::vec3 p(attribute[0], attribute[1], attribute[2]);
+                glm::vec3 decoded = p;
+                if (options.quantize_positions)
+                {
+                    unsigned short q[3];
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        float extent = format.position_scale[c];
+                        q[c] = quantize_unorm16(extent > 0.0f ? (p[c] - min_bound[c]) / extent : 0.0f);
+                        decoded[c] = format.position_offset[c] + q[c] / 65535.0f * extent;
+                    }
+                    std::memcpy(target + position_offset, q, sizeof(q));
+                }
+                else
+                {
+                    std::memcpy(target + position_offset, attribute, 3 * sizeof(float));
+                }
+
+                float error = glm::length(decoded - p);
+                local.max_position_error = std::max(local.max_position_error, error);
+                local.mean_position_error += error;
+                attribute += 3;
+            }
+
+            if (mesh.attributes & Normal)
+            {
+                glm::vec3 n(attribute[0], attribute[1], attribute[2]);
+                float length = glm::length(n);
+                glm::vec3 unit = length > 0.0f ? n / length : glm::vec3(0.0f, 0.0f, 1.0f);
+                glm::vec3 decoded = unit;
+
+                switch (format.normals)
+                {
+                case NormalEncoding::Octahedral16:
+                {
+                    glm::vec2 e = oct_encode(unit);
+                    short q[2] = { quantize_snorm16(e.x), quantize_snorm16(e.y) };
+                    std::memcpy(target + normal_offset, q, sizeof(q));
+                    decoded = oct_decode(glm::vec2(decode_snorm16(q[0]), decode_snorm16(q[1])));
+                    break;
+                }
+                case NormalEncoding::Packed1010102:
+                {
+                    int x = quantize_snorm10(unit.x), y = quantize_snorm10(unit.y), z = quantize_snorm10(unit.z);
+                    uint32_t bits = ((uint32_t)x & 0x3FF) | (((uint32_t)y & 0x3FF) << 10) | (((uint32_t)z & 0x3FF) << 20);
+                    std::memcpy(target + normal_offset, &bits, sizeof(bits));
+                    decoded = glm::normalize(glm::vec3(decode_snorm10(x), decode_snorm10(y), decode_snorm10(z)));
+                    break;
+                }
+                case NormalEncoding::Float3:
+                    std::memcpy(target + normal_offset, attribute, 3 * sizeof(float));
+                    break;
+                }
+
+                if (length > 0.0f)
+                {
+                    float error = angle_degrees(unit, decoded);
+                    local.max_normal_error = std::max(local.max_normal_error, error);
+                    local.mean_normal_error += error;
+                    ++normal_samples;
+                }
+                attribute += 3;
+            }
+
+            if (mesh.attributes & TexCoord)
+            {
+                if (options.half_uvs)
+                {
+                    unsigned short q[2] = { float_to_half(attribute[0]), float_to_half(attribute[1]) };
+                    std::memcpy(target + uv_offset, q, sizeof(q));
+                    local.max_uv_error = std::max(local.max_uv_error, std::fabs(half_to_float(q[0]) - attribute[0]));
+                    local.max_uv_error = std::max(local.max_uv_error, std::fabs(half_to_float(q[1]) - attribute[1]));
+                }
+                else
+                {
+                    std::memcpy(target + uv_offset, attribute, 2 * sizeof(float));
+                }
+                attribute += 2;
+            }
+        }
+
+        if (report)
+        {
+            if (vertex_count)
+                local.mean_position_error /= vertex_count;
+            if (normal_samples)
+                local.mean_normal_error /= normal_samples;
+            local.source_bytes = mesh.vertices.size() * sizeof(float);
+            local.packed_bytes = packed.vertices.size();
+            *report = local;
+        }
+
+        return packed;
+    }
+}
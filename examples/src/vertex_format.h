@@ -0,0 +1,90 @@
+#ifndef _VERTEX_FORMAT_H
+#define _VERTEX_FORMAT_H
+
+#include "mesh_library.h"
+#include <glm/glm.hpp>
+#include <ostream>
+
+class ShaderProgram;
+
+namespace Utility::mesh
+{
+    enum class NormalEncoding
+    {
+        Float3,         // 3 x 32-bit float, 12 bytes
+        Octahedral16,   // octahedral mapping in 2 x 16-bit snorm, 4 bytes, decoded in the vertex shader
+        Packed1010102   // xyz in GL_INT_2_10_10_10_REV snorm, 4 bytes, usable as a plain vec3
+    };
+
+    struct VertexFormatOptions
+    {
+        bool quantize_positions = true;   // 16-bit unorm relative to the mesh bounds
+        NormalEncoding normals = NormalEncoding::Octahedral16;
+        bool half_uvs = true;             // 2 x 16-bit half float
+    };
+
+    // One entry per enabled attribute, locations follow the same order as MeshData
+    struct VertexAttributeLayout
+    {
+        GLuint location;
+        GLint components;
+        GLenum type;
+        GLboolean normalized;
+        GLuint offset;
+    };
+
+    struct PackedVertexFormat
+    {
+        unsigned int attributes = Position;
+        NormalEncoding normals = NormalEncoding::Float3;
+        GLsizei stride = 0;
+        std::vector<VertexAttributeLayout> layout;
+
+        // Quantized positions decode as position_offset + vertex_position * position_scale
+        glm::vec3 position_offset = glm::vec3(0.0f);
+        glm::vec3 position_scale = glm::vec3(1.0f);
+
+        // Describes the vertices in the currently bound GL_ARRAY_BUFFER to the currently bound VAO
+        void Apply(size_t buffer_offset = 0) const;
+        // Separate attribute format path (GL 4.3 / ARB_vertex_attrib_binding); the buffer is attached
+        // with glBindVertexBuffer(binding, vbo, offset, stride)
+        void ApplyFormat(GLuint binding = 0) const;
+        // Uploads position_offset/position_scale to the shader that decodes this format
+        void SetDecodeUniforms(const ShaderProgram& shader) const;
+    };
+
+    struct PackedMesh
+    {
+        PackedVertexFormat format;
+        std::vector<unsigned char> vertices;
+        std::vector<unsigned int> indices;
+
+        size_t VertexCount() const;
+    };
+
+    // Decoding error of a packed mesh against its float source
+    struct QuantizationReport
+    {
+        size_t source_bytes = 0;
+        size_t packed_bytes = 0;
+        float max_position_error = 0.0f;     // in model units
+        float mean_position_error = 0.0f;
+        float max_normal_error = 0.0f;       // in degrees
+        float mean_normal_error = 0.0f;
+        float max_uv_error = 0.0f;
+    };
+
+    std::ostream& operator<<(std::ostream& os, const QuantizationReport& report);
+
+    // Converts a float mesh into the packed format described by the options
+    PackedMesh compile_vertex_format(const MeshData& mesh, const VertexFormatOptions& options = VertexFormatOptions(), QuantizationReport* report = nullptr);
+
+    // Octahedral mapping of a unit vector onto the [-1, 1] square and back
+    glm::vec2 oct_encode(glm::vec3 n);
+    glm::vec3 oct_decode(glm::vec2 p);
+
+    unsigned short float_to_half(float value);
+    float half_to_float(unsigned short value);
+}
+
+#endif // !_VERTEX_FORMAT_H
@@ -0,0 +1,96 @@
+// Offline cooker: imports OBJ/glTF meshes and writes them as a cooked mesh file that the
+// examples memory map at start up (Utility::mesh::CookedMeshFile).
+//
+// Build it from the examples sources together with mesh_import, mesh_cooked, mesh_lod, mesh_utils,
+// mesh_optimizer, mesh_library, vertex_format and mapped_file.
+//
+// usage: mesh_cooker <input.obj|gltf|glb> <output.mesh> [--packed] [--no-optimize] [--threads N] [--lods N]
+
+#include "../src/mesh_import.h"
+#include "../src/mesh_cooked.h"
+#include "../src/mesh_lod.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+namespace
+{
+    int usage()
+    {
+        std::cerr << "usage: mesh_cooker <input.obj|gltf|glb> <output.mesh> [--packed] [--no-optimize] [--threads N] [--lods N]\n"
+                  << "  --packed       quantized positions, octahedral normals and half float uvs\n"
+                  << "  --no-optimize  keep the imported triangle and vertex order\n"
+                  << "  --threads N    OBJ parser threads (default: all)\n"
+                  << "  --lods N       levels of detail per mesh including the full one (default: 1, at most 8)\n";
+        return 1;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace Utility::mesh;
+
+    if (argc < 3)
+        return usage();
+
+    const char* input = argv[1];
+    const char* output = argv[2];
+    ImportOptions import_options;
+    CookOptions cook_options;
+    unsigned int lod_count = 1;
+    for (int i = 3; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--packed") == 0)
+            cook_options.packed = true;
+        else if (std::strcmp(argv[i], "--no-optimize") == 0)
+            cook_options.optimize = false;
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            import_options.threads = (unsigned int)std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--lods") == 0 && i + 1 < argc)
+            lod_count = (unsigned int)std::max(1, std::min(std::atoi(argv[++i]), (int)kCookedMaxLods));
+        else
+            return usage();
+    }
+
+    std::vector<MeshData> meshes;
+    ImportReport report;
+    if (!load_mesh(input, meshes, import_options, &report))
+    {
+        std::cerr << "Failed to import " << input << std::endl;
+        return 1;
+    }
+    std::cout << "imported " << report << "\n";
+
+    std::vector<CookedMeshSource> sources(meshes.size());
+    for (size_t i = 0; i < meshes.size(); ++i)
+    {
+        std::vector<MeshLod> lods = generate_lods(meshes[i], lod_count);
+        for (size_t l = 1; l < lods.size(); ++l)
+        {
+            sources[i].lods.push_back(std::move(lods[l].indices));
+            sources[i].lod_errors.push_back(lods[l].error);
+        }
+        sources[i].mesh = std::move(meshes[i]);
+    }
+
+    if (!write_cooked_meshes(output, sources, cook_options))
+        return 1;
+
+    CookedMeshFile cooked(output);
+    if (!cooked.Valid())
+        return 1;
+
+    for (size_t i = 0; i < cooked.MeshCount(); ++i)
+    {
+        const CookedMeshDesc& desc = cooked.Mesh(i);
+        std::cout << "mesh " << i << ": " << desc.vertex_count << " vertices x " << desc.vertex_stride << " bytes, "
+                  << desc.lods[0].index_count / 3 << " triangles, " << (desc.index_type == GL_UNSIGNED_SHORT ? 16 : 32) << "-bit indices, radius "
+                  << desc.radius << "\n";
+        for (uint32_t l = 1; l < desc.lod_count; ++l)
+            std::cout << "  LOD " << l << ": " << desc.lods[l].index_count / 3 << " triangles, error " << desc.lods[l].error << "\n";
+    }
+    return 0;
+}